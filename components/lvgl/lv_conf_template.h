@@ -59,6 +59,16 @@
         #undef LV_MEM_POOL_ALLOC
     #endif
 
+    /*1: Serve the small allocations (<= 96 bytes) from pages of fixed size slots in a reserved area of the heap.
+     *It keeps the many small objects created and deleted on screen changes away from the larger blocks
+     *and so reduces the fragmentation.*/
+    #define LV_MEM_SLAB 0
+    #if LV_MEM_SLAB
+        /*Reserved for the slabs from `LV_MEM_SIZE`. If it's full the small allocations go to the TLSF heap*/
+        #define LV_MEM_SLAB_SIZE (16U * 1024U)    /*[bytes]*/
+        #define LV_MEM_SLAB_PAGE_SIZE 512         /*[bytes] Must be a power of 2*/
+    #endif
+
 #else       /*LV_MEM_CUSTOM*/
     #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
     #define LV_MEM_CUSTOM_ALLOC   malloc
@@ -70,6 +80,11 @@
  *You will see an error log message if there wasn't enough buffers. */
 #define LV_MEM_BUF_MAX_NUM 16
 
+/*Size of a static arena for the temporary buffers of `lv_mem_buf_get()` (e.g. mask lines and label buffers while rendering).
+ *The buffers are taken from it like from a stack, so getting and releasing them needs no heap allocations.
+ *The buffers which don't fit into it are allocated on the heap into the `LV_MEM_BUF_MAX_NUM` slots. 0: not used*/
+#define LV_MEM_BUF_ARENA_SIZE 0    /*[bytes]*/
+
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #define LV_MEMCPY_MEMSET_STD 0
 
@@ -146,6 +161,33 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE 0
 
+/*Maximal total size of the decoded images kept in the image cache [bytes].
+ *The least valuable images (large, fast to open and not used recently) are closed first to stay in the limit.
+ *0: only the number of images (LV_IMG_CACHE_DEF_SIZE) is limited*/
+#define LV_IMG_CACHE_MEM_SIZE 0
+
+/*Maximal number of images in the image cache which keep their file open to read it line by line (e.g. SJPG).
+ *Keep it below the number of files the file system can open at once.
+ *0: not limited*/
+#define LV_IMG_CACHE_FILE_MAX 0
+
+/*1: Allocate the decoded images with custom functions, e.g. in PSRAM or in a separate heap instead of `LV_MEM_SIZE`
+ *The image decoders use these through `lv_img_cache_mem_alloc()` and `lv_img_cache_mem_free()`*/
+#define LV_IMG_CACHE_MEM_CUSTOM 0
+#if LV_IMG_CACHE_MEM_CUSTOM
+    #define LV_IMG_CACHE_MEM_CUSTOM_INCLUDE <stdlib.h>  /*Header for the memory functions*/
+    #define LV_IMG_CACHE_MEM_CUSTOM_ALLOC   malloc
+    #define LV_IMG_CACHE_MEM_CUSTOM_FREE    free
+#endif
+
+/*1: `lv_img_set_async(img, true)` makes an image widget decode its file in the background,
+ *in short steps between the display refreshes, instead of blocking the refresh. Requires LV_IMG_CACHE_DEF_SIZE > 0*/
+#define LV_IMG_ASYNC 0
+#if LV_IMG_ASYNC
+    #define LV_IMG_ASYNC_STEP_TIME 5    /*[ms] Decode the images for this long in one step*/
+#endif
+
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS 2
@@ -294,6 +336,30 @@
 /*1: Draw random colored rectangles over the redrawn areas*/
 #define LV_USE_REFR_DEBUG 0
 
+/*1: Cache the resolved style properties of the objects to make `lv_obj_get_style_...()` O(1) while drawing.
+ *The cache is a shared table of (object, part, property) -> value entries, invalidated by every style change.
+ *It costs `LV_OBJ_STYLE_CACHE_SIZE * (sizeof(void *) + sizeof(lv_style_value_t) + 8)` bytes of static RAM*/
+#define LV_OBJ_STYLE_CACHE 0
+#if LV_OBJ_STYLE_CACHE
+    #define LV_OBJ_STYLE_CACHE_SIZE 256     /*Number of cached values. Must be a power of 2*/
+#endif
+
+/*1: Make `lv_obj_enable_spatial_index()` available to index the children of an object by their position.
+ *Hit testing, redrawing and the scroll range calculation check only the children close to the point or area
+ *instead of all of them. Useful for objects with hundreds of children, e.g. long lists.
+ *It costs about 16 bytes (24 with `LV_USE_LARGE_COORD`) per child in the objects using it*/
+#define LV_OBJ_SPATIAL_INDEX 0
+
+/*1: Make `LV_OBJ_FLAG_CACHE_BITMAP` work. The objects with this flag are rendered with their children
+ *once into an image which is drawn until the object or one of its children is invalidated.
+ *Useful for rarely changing, but expensive objects (shadows, rounded corners, texts) which are moved or redrawn often.
+ *The images take `w * h * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes (`sizeof(lv_color_t)` if fully opaque) from `lv_mem`*/
+#define LV_OBJ_BITMAP_CACHE 0
+#if LV_OBJ_BITMAP_CACHE
+    #define LV_OBJ_BITMAP_CACHE_SIZE (32 * 1024U)   /*[bytes] Total size of the cached images. The least recently used are freed above it*/
+#endif
+
+
 /*Change the built in (v)snprintf functions*/
 #define LV_SPRINTF_CUSTOM 0
 #if LV_SPRINTF_CUSTOM
@@ -419,6 +485,10 @@
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
+/*Keep the glyph ID and width of the printable ASCII characters of the built-in fonts in RAM (~380 bytes per font)
+ *to measure and wrap texts faster*/
+#define LV_FONT_FMT_TXT_ASCII_CACHE 1
+
 /*=================
  *  TEXT SETTINGS
  *=================*/
@@ -491,6 +561,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LINE_CACHE 1     /*Cache the start and width of the lines of long texts to not wrap them again on every draw*/
 #endif
 
 #define LV_USE_LINE       1
@@ -624,6 +695,16 @@
     #define LV_FS_POSIX_CACHE_SIZE 0    /*>0 to cache this number of bytes in lv_fs_read()*/
 #endif
 
+/*API for open, read, etc with a block cache shared by the files. Useful for slow storages, e.g. SD cards.*/
+#define LV_USE_FS_CACHED 0
+#if LV_USE_FS_CACHED
+    #define LV_FS_CACHED_LETTER '\0'        /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
+    #define LV_FS_CACHED_PATH ""            /*Set the working directory. File/directory paths will be appended to it.*/
+    #define LV_FS_CACHED_BLOCK_SIZE 4096    /*Size of a cached block. Use the sector or cluster size of the storage.*/
+    #define LV_FS_CACHED_SIZE (32 * 1024)   /*Total size of the cached blocks*/
+    #define LV_FS_CACHED_READ_AHEAD 2       /*Number of blocks to read in advance when a file is read sequentially*/
+#endif
+
 /*API for CreateFile, ReadFile, etc*/
 #define LV_USE_FS_WIN32 0
 #if LV_USE_FS_WIN32
@@ -659,6 +740,10 @@
 /*GIF decoder library*/
 #define LV_USE_GIF 0
 
+/*RLZ decoder library: RLE + LZ compressed RGB565 images with optional 4 bit alpha for UI assets.
+ *Make them with scripts/lv_img_rlz.py or lv_rlz_encode()*/
+#define LV_USE_RLZ 0
+
 /*QR code library*/
 #define LV_USE_QRCODE 0
 
@@ -684,6 +769,9 @@
 #if LV_USE_TINY_TTF
     /*Load TTF data from files*/
     #define LV_TINY_TTF_FILE_SUPPORT 0
+    /*Memory used by the glyph atlas shared by all Tiny TTF fonts [bytes].
+     *It's allocated in pages of 16 kB (128x128 px) when needed. 0: don't cache the glyphs*/
+    #define LV_TINY_TTF_CACHE_SIZE (16 * 1024)
 #endif
 
 /*Rlottie library*/
@@ -737,6 +825,18 @@
     #endif // LV_IME_PINYIN_USE_K9_MODE
 #endif
 
+/*1: Enable thumbnail generation and thumbnail pack files*/
+/*JPG thumbnails require LV_USE_SJPG and PNG thumbnails LV_USE_PNG*/
+#define LV_USE_THUMB 0
+
+/*1: Enable asset packs: pre-converted images and other files in one memory mapped blob (e.g. a flash partition)*/
+/*Make the packs with scripts/lv_asset_pack.py*/
+#define LV_USE_ASSET_PACK 0
+#if LV_USE_ASSET_PACK
+    /*Set an upper cased letter to read the assets with lv_fs too (e.g. to load fonts), '\0' to disable*/
+    #define LV_ASSET_PACK_LETTER '\0'
+#endif
+
 /*==================
 * EXAMPLES
 *==================*/
@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+##################################################################
+# Asset pack generator for lv_asset_pack
+# Dependencies: (PYTHON-3)
+##################################################################
+"""
+Make an asset pack for `lv_asset_pack` from PNG images and other files (e.g. fonts).
+
+The PNGs are converted to LVGL's pixel format of the given color depth
+(LV_IMG_CF_TRUE_COLOR or LV_IMG_CF_TRUE_COLOR_ALPHA if they have transparent pixels).
+With --rle they are compressed row by row if it makes them smaller.
+The other files are stored as they are.
+
+Directories are added recursively and the names of their assets are relative to the directory,
+e.g. `icons/wifi.png`.
+
+usage:
+    python3 lv_asset_pack.py -o assets.pack --depth 16 --swap --rle icons/ fonts/montserrat_14.fnt
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+PACK_MAGIC = 0x5041564C     # "LVAP"
+PACK_VERSION = 1
+PACK_FLAG_16_SWAP = 0x01
+IMG_MAGIC = 0x4941564C      # "LVAI"
+
+LV_IMG_CF_TRUE_COLOR = 4
+LV_IMG_CF_TRUE_COLOR_ALPHA = 5
+
+COMP_NONE = 0
+COMP_RLE = 1
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h ^= b
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def png_decode(data):
+    """Decode an 8 bit, not interlaced PNG to a list of RGBA rows"""
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('not a PNG file')
+
+    pos = 8
+    idat = b''
+    palette = []
+    trns = b''
+    while pos < len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b'IHDR':
+            w, h, depth, color_type, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif kind == b'PLTE':
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b'tRNS':
+            trns = chunk
+        elif kind == b'IDAT':
+            idat += chunk
+        elif kind == b'IEND':
+            break
+
+    if depth != 8 or interlace:
+        raise ValueError('only 8 bit, not interlaced PNGs are supported')
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    raw = zlib.decompress(idat)
+    stride = w * channels
+    rows = []
+    prev = bytearray(stride)
+    for y in range(h):
+        ft = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if ft == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ft == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ft == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ft == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xFF
+        prev = line
+
+        row = []
+        for x in range(w):
+            px = line[x * channels:(x + 1) * channels]
+            if color_type == 0:
+                row.append((px[0], px[0], px[0], 255))
+            elif color_type == 2:
+                row.append((px[0], px[1], px[2], 255))
+            elif color_type == 3:
+                a = trns[px[0]] if px[0] < len(trns) else 255
+                row.append(palette[px[0]] + (a,))
+            elif color_type == 4:
+                row.append((px[0], px[0], px[0], px[1]))
+            else:
+                row.append(tuple(px))
+        rows.append(row)
+
+    return w, h, rows
+
+
+def px_bytes(px, depth, swap, alpha):
+    """Convert an RGBA pixel to LVGL's format"""
+    r, g, b, a = px
+    if depth == 32:
+        return bytes((b, g, r, a if alpha else 255))
+
+    v = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+    out = struct.pack('>H' if swap else '<H', v)
+    if alpha:
+        out += bytes((a,))
+    return out
+
+
+def rle_encode_row(pixels):
+    """A literal packet is `n - 1` and n pixels, a repeat packet is `0x80 | (n - 2)` and one pixel"""
+    out = bytearray()
+    i = 0
+    literal = []
+    while i < len(pixels):
+        run = 1
+        while i + run < len(pixels) and run < 129 and pixels[i + run] == pixels[i]:
+            run += 1
+
+        if run >= 2:
+            if literal:
+                out.append(len(literal) - 1)
+                out += b''.join(literal)
+                literal = []
+            out.append(0x80 | (run - 2))
+            out += pixels[i]
+            i += run
+        else:
+            literal.append(pixels[i])
+            if len(literal) == 128:
+                out.append(127)
+                out += b''.join(literal)
+                literal = []
+            i += 1
+
+    if literal:
+        out.append(len(literal) - 1)
+        out += b''.join(literal)
+    return bytes(out)
+
+
+def img_convert(data, depth, swap, rle):
+    w, h, rows = png_decode(data)
+    alpha = any(px[3] != 255 for row in rows for px in row)
+    cf = LV_IMG_CF_TRUE_COLOR_ALPHA if alpha else LV_IMG_CF_TRUE_COLOR
+    px_rows = [[px_bytes(px, depth, swap, alpha) for px in row] for row in rows]
+
+    raw = b''.join(b''.join(row) for row in px_rows)
+    comp = COMP_NONE
+    body = raw
+    if rle:
+        rle_rows = [rle_encode_row(row) for row in px_rows]
+        table = bytearray()
+        ofs = 0
+        for r in rle_rows:
+            table += struct.pack('<I', ofs)
+            ofs += len(r)
+        rle_body = bytes(table) + b''.join(rle_rows)
+        if len(rle_body) < len(raw):
+            comp = COMP_RLE
+            body = rle_body
+
+    header = struct.pack('<IBBHHH', IMG_MAGIC, cf, comp, w, h, 0)
+    return header + body, len(raw), comp
+
+
+def collect(paths):
+    assets = []
+    for path in paths:
+        if os.path.isdir(path):
+            for root, dirs, files in os.walk(path):
+                dirs.sort()
+                for f in sorted(files):
+                    full = os.path.join(root, f)
+                    assets.append((os.path.relpath(full, path).replace(os.sep, '/'), full))
+        else:
+            assets.append((os.path.basename(path), path))
+    return assets
+
+
+def align4(b):
+    return b + bytes(-len(b) % 4)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Make an asset pack for lv_asset_pack')
+    parser.add_argument('-o', '--output', required=True, help='the pack file to write')
+    parser.add_argument('--depth', type=int, choices=(16, 32), default=16, help='LV_COLOR_DEPTH of the target')
+    parser.add_argument('--swap', action='store_true', help='LV_COLOR_16_SWAP is enabled on the target')
+    parser.add_argument('--rle', action='store_true', help='compress the images if they get smaller')
+    parser.add_argument('inputs', nargs='+', help='files and directories to add')
+    args = parser.parse_args()
+
+    entries = []
+    for name, path in collect(args.inputs):
+        with open(path, 'rb') as f:
+            data = f.read()
+        if name.lower().endswith('.png'):
+            data, raw_size, comp = img_convert(data, args.depth, args.swap, args.rle)
+            print('%-40s %7d -> %7d bytes%s' % (name, raw_size, len(data), ' (RLE)' if comp else ''))
+        else:
+            print('%-40s %7d bytes' % (name, len(data)))
+        entries.append((fnv1a(name.encode()), name, data))
+
+    entries.sort(key=lambda e: (e[0], e[1]))
+
+    # Header, names, data and the index at the end
+    header_size = 16
+    body = bytearray()
+    index = bytearray()
+    for h, name, data in entries:
+        name_ofs = header_size + len(body)
+        body += name.encode() + b'\0'
+        body = bytearray(align4(body))
+        data_ofs = header_size + len(body)
+        body += data
+        body = bytearray(align4(body))
+        index += struct.pack('<IIII', h, name_ofs, data_ofs, len(data))
+
+    index_ofs = header_size + len(body)
+    flags = PACK_FLAG_16_SWAP if args.swap and args.depth == 16 else 0
+    header = struct.pack('<IHBBII', PACK_MAGIC, PACK_VERSION, args.depth, flags, len(entries), index_ofs)
+
+    with open(args.output, 'wb') as f:
+        f.write(header + body + index)
+
+    print('%d assets, %d bytes' % (len(entries), index_ofs + len(index)))
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+##################################################################
+# RLZ image encoder for lv_rlz
+# Dependencies: (PYTHON-3)
+##################################################################
+"""
+Compress PNG images to the RLZ format of `lv_rlz` (LV_USE_RLZ):
+RGB565 colors and 4 bit alpha, compressed row by row with runs and short copies.
+The alpha channel is stored only if the image has not fully opaque pixels.
+
+The output is a C file with an `lv_img_dsc_t` (default) or a binary `.rlz` file to open with lv_fs.
+
+usage:
+    python3 lv_img_rlz.py icons/wifi.png icons/battery.png -o src/assets
+    python3 lv_img_rlz.py --bin icons/wifi.png
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+from lv_asset_pack import png_decode
+
+RLZ_MAGIC = 0x5A4C524C      # "LRLZ"
+RLZ_VERSION = 1
+FLAG_ALPHA = 0x01
+FLAG_OFS_32 = 0x02
+
+LITERAL_MAX = 64
+RUN_MAX = 65
+COPY_MAX = 129
+COPY_DIST_MAX = 256
+A_RUN_MAX = 2048
+A_LITERAL_MAX = 128
+
+
+def color_literal(px):
+    return bytes((len(px) - 1,)) + b''.join(struct.pack('<H', c) for c in px)
+
+
+def color_row_encode(px):
+    """The same greedy compression as `color_row_encode()` in lv_rlz.c"""
+    out = bytearray()
+    lit = []
+    w = len(px)
+    i = 0
+    while i < w:
+        run = 1
+        while i + run < w and run < RUN_MAX and px[i + run] == px[i]:
+            run += 1
+
+        copy_len = 0
+        copy_dist = 0
+        l_max = min(w - i, COPY_MAX)
+        for d in range(1, min(i, COPY_DIST_MAX) + 1):
+            if copy_len >= l_max:
+                break
+            l = 0
+            while l < l_max and px[i + l - d] == px[i + l]:
+                l += 1
+            if l > copy_len:
+                copy_len = l
+                copy_dist = d
+
+        if run >= 2 and run >= copy_len:
+            if lit:
+                out += color_literal(lit)
+                lit = []
+            out += struct.pack('<BH', 0x40 | (run - 2), px[i])
+            i += run
+        elif copy_len >= 2:
+            if lit:
+                out += color_literal(lit)
+                lit = []
+            out += bytes((0x80 | (copy_len - 2), copy_dist - 1))
+            i += copy_len
+        else:
+            lit.append(px[i])
+            i += 1
+            if len(lit) == LITERAL_MAX:
+                out += color_literal(lit)
+                lit = []
+
+    if lit:
+        out += color_literal(lit)
+    return bytes(out)
+
+
+def alpha_literal(a):
+    out = bytearray((0x80 | (len(a) - 1),))
+    for i in range(0, len(a), 2):
+        out.append((a[i] << 4) | (a[i + 1] if i + 1 < len(a) else 0))
+    return bytes(out)
+
+
+def alpha_row_encode(a):
+    """The same compression as `alpha_row_encode()` in lv_rlz.c"""
+    out = bytearray()
+    lit = []
+    w = len(a)
+    i = 0
+    while i < w:
+        run = 1
+        while i + run < w and run < A_RUN_MAX and a[i + run] == a[i]:
+            run += 1
+
+        if run >= 3:
+            if lit:
+                out += alpha_literal(lit)
+                lit = []
+            out += bytes(((((run - 1) >> 8) << 4) | a[i], (run - 1) & 0xFF))
+            i += run
+        else:
+            lit.append(a[i])
+            i += 1
+            if len(lit) == A_LITERAL_MAX:
+                out += alpha_literal(lit)
+                lit = []
+
+    if lit:
+        out += alpha_literal(lit)
+    return bytes(out)
+
+
+def rlz_encode(w, h, rows):
+    """Compress RGBA rows to an RLZ image"""
+    alphas = [[(px[3] * 15 + 127) // 255 for px in row] for row in rows]
+    alpha = any(a < 15 for row in alphas for a in row)
+
+    streams = bytearray()
+    color_ofs = []
+    alpha_ofs = []
+    for row, row_a in zip(rows, alphas):
+        colors = []
+        prev = 0
+        for px, a in zip(row, row_a):
+            # The color of the transparent pixels doesn't matter, so continue the runs with them
+            if alpha and a == 0:
+                c = prev
+            else:
+                c = ((px[0] >> 3) << 11) | ((px[1] >> 2) << 5) | (px[2] >> 3)
+            colors.append(c)
+            prev = c
+
+        color_ofs.append(len(streams))
+        streams += color_row_encode(colors)
+        if alpha:
+            alpha_ofs.append(len(streams))
+            streams += alpha_row_encode(row_a)
+
+    flags = (FLAG_ALPHA if alpha else 0) | (FLAG_OFS_32 if len(streams) > 0xFFFF else 0)
+    ofs_fmt = '<I' if flags & FLAG_OFS_32 else '<H'
+    out = bytearray(struct.pack('<IBBHHH', RLZ_MAGIC, RLZ_VERSION, flags, w, h, 0))
+    for o in color_ofs + alpha_ofs:
+        out += struct.pack(ofs_fmt, o)
+    out += streams
+    return bytes(out), alpha
+
+
+C_TEMPLATE = '''#ifdef __has_include
+    #if __has_include("lvgl.h")
+        #ifndef LV_LVGL_H_INCLUDE_SIMPLE
+            #define LV_LVGL_H_INCLUDE_SIMPLE
+        #endif
+    #endif
+#endif
+
+#if defined(LV_LVGL_H_INCLUDE_SIMPLE)
+    #include "lvgl.h"
+#else
+    #include "lvgl/lvgl.h"
+#endif
+
+#ifndef LV_ATTRIBUTE_MEM_ALIGN
+#define LV_ATTRIBUTE_MEM_ALIGN
+#endif
+
+#ifndef LV_ATTRIBUTE_IMG_{NAME_UPPER}
+#define LV_ATTRIBUTE_IMG_{NAME_UPPER}
+#endif
+
+/*RLZ compressed, {W}x{H} px, RGB565{ALPHA}*/
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_{NAME_UPPER} uint8_t {NAME}_map[] = {{
+{DATA}
+}};
+
+const lv_img_dsc_t {NAME} = {{
+  .header.always_zero = 0,
+  .header.w = {W},
+  .header.h = {H},
+  .data_size = {SIZE},
+  .header.cf = LV_RLZ_CF,
+  .data = {NAME}_map,
+}};
+'''
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append('  ' + ' '.join('0x%02x,' % b for b in data[i:i + 16]))
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compress PNG images to the RLZ format of lv_rlz')
+    parser.add_argument('-o', '--output', default='.', help='directory of the output files')
+    parser.add_argument('--bin', action='store_true', help='write binary .rlz files instead of C files')
+    parser.add_argument('inputs', nargs='+', help='PNG files (8 bit, not interlaced)')
+    args = parser.parse_args()
+
+    for path in args.inputs:
+        with open(path, 'rb') as f:
+            w, h, rows = png_decode(f.read())
+        data, alpha = rlz_encode(w, h, rows)
+
+        name = os.path.splitext(os.path.basename(path))[0]
+        if args.bin:
+            out_path = os.path.join(args.output, name + '.rlz')
+            with open(out_path, 'wb') as f:
+                f.write(data)
+        else:
+            name = ''.join(c if c.isalnum() else '_' for c in name)
+            out_path = os.path.join(args.output, name + '.c')
+            with open(out_path, 'w') as f:
+                f.write(C_TEMPLATE.format(NAME=name, NAME_UPPER=name.upper(), W=w, H=h, SIZE=len(data),
+                                          ALPHA=' + A4' if alpha else '', DATA=c_array(data)))
+
+        raw_size = w * h * (3 if alpha else 2)
+        print('%-40s %7d -> %7d bytes (%.0f%%)' % (out_path, raw_size, len(data), 100.0 * len(data) / raw_size))
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -7,6 +7,8 @@ CSRCS += lv_obj_class.c
 CSRCS += lv_obj_draw.c
 CSRCS += lv_obj_pos.c
 CSRCS += lv_obj_scroll.c
+CSRCS += lv_obj_spatial.c
+CSRCS += lv_obj_bitmap_cache.c
 CSRCS += lv_obj_style.c
 CSRCS += lv_obj_style_gen.c
 CSRCS += lv_obj_tree.c
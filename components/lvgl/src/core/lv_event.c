@@ -29,12 +29,16 @@ typedef struct _lv_event_dsc_t {
 static lv_event_dsc_t * lv_obj_get_event_dsc(const lv_obj_t * obj, uint32_t id);
 static lv_res_t event_send_core(lv_event_t * e);
 static bool event_is_bubbled(lv_event_t * e);
+static uint64_t class_event_mask(const lv_obj_class_t * class_p);
+static uint64_t filter_event_mask(lv_event_code_t filter);
+static void obj_event_mask_update(lv_obj_t * obj);
 
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static lv_event_t * event_head;
+static lv_event_monitor_t event_mon;
 
 /**********************
  *      MACROS
@@ -65,6 +69,8 @@ lv_res_t lv_event_send(lv_obj_t * obj, lv_event_code_t event_code, void * param)
     e.stop_bubbling = 0;
     e.stop_processing = 0;
 
+    event_mon.send_cnt++;
+
     /*Build a simple linked list from the objects used in the events
      *It's important to know if this object was deleted by a nested event
      *called from this `event_cb`.*/
@@ -173,6 +179,7 @@ struct _lv_event_dsc_t * lv_obj_add_event_cb(lv_obj_t * obj, lv_event_cb_t event
     obj->spec_attr->event_dsc[obj->spec_attr->event_dsc_cnt - 1].cb = event_cb;
     obj->spec_attr->event_dsc[obj->spec_attr->event_dsc_cnt - 1].filter = filter;
     obj->spec_attr->event_dsc[obj->spec_attr->event_dsc_cnt - 1].user_data = user_data;
+    obj->spec_attr->event_mask |= filter_event_mask(filter);
 
     return &obj->spec_attr->event_dsc[obj->spec_attr->event_dsc_cnt - 1];
 }
@@ -193,6 +200,7 @@ bool lv_obj_remove_event_cb(lv_obj_t * obj, lv_event_cb_t event_cb)
             obj->spec_attr->event_dsc = lv_mem_realloc(obj->spec_attr->event_dsc,
                                                        obj->spec_attr->event_dsc_cnt * sizeof(lv_event_dsc_t));
             LV_ASSERT_MALLOC(obj->spec_attr->event_dsc);
+            obj_event_mask_update(obj);
             return true;
         }
     }
@@ -218,6 +226,7 @@ bool lv_obj_remove_event_cb_with_user_data(lv_obj_t * obj, lv_event_cb_t event_c
             obj->spec_attr->event_dsc = lv_mem_realloc(obj->spec_attr->event_dsc,
                                                        obj->spec_attr->event_dsc_cnt * sizeof(lv_event_dsc_t));
             LV_ASSERT_MALLOC(obj->spec_attr->event_dsc);
+            obj_event_mask_update(obj);
             return true;
         }
     }
@@ -243,6 +252,7 @@ bool lv_obj_remove_event_dsc(lv_obj_t * obj, struct _lv_event_dsc_t * event_dsc)
             obj->spec_attr->event_dsc = lv_mem_realloc(obj->spec_attr->event_dsc,
                                                        obj->spec_attr->event_dsc_cnt * sizeof(lv_event_dsc_t));
             LV_ASSERT_MALLOC(obj->spec_attr->event_dsc);
+            obj_event_mask_update(obj);
             return true;
         }
     }
@@ -251,6 +261,16 @@ bool lv_obj_remove_event_dsc(lv_obj_t * obj, struct _lv_event_dsc_t * event_dsc)
     return false;
 }
 
+void lv_event_monitor(lv_event_monitor_t * mon_p)
+{
+    *mon_p = event_mon;
+}
+
+void lv_event_monitor_reset(void)
+{
+    lv_memset_00(&event_mon, sizeof(event_mon));
+}
+
 void * lv_obj_get_event_user_data(struct _lv_obj_t * obj, lv_event_cb_t event_cb)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -426,6 +446,7 @@ static lv_event_dsc_t * lv_obj_get_event_dsc(const lv_obj_t * obj, uint32_t id)
 static lv_res_t event_send_core(lv_event_t * e)
 {
     EVENT_TRACE("Sending event %d to %p with %p param", e->code, (void *)e->current_target, e->param);
+    event_mon.dispatch_cnt++;
 
     /*Call the input device's feedback callback if set*/
     lv_indev_t * indev_act = lv_indev_get_act();
@@ -435,8 +456,15 @@ static lv_res_t event_send_core(lv_event_t * e)
         if(e->deleted) return LV_RES_INV;
     }
 
+    /*Look for handlers only if the object has callbacks or its class handles this code*/
+    uint64_t code_bit = LV_EVENT_BIT(e->code);
+    lv_obj_t * obj = e->current_target;
+    bool cb_interested = obj->spec_attr && (obj->spec_attr->event_mask & code_bit);
+    bool class_interested = (class_event_mask(obj->class_p) & code_bit) != 0;
+    if(!cb_interested && !class_interested) event_mon.skip_cnt++;
+
     lv_res_t res = LV_RES_OK;
-    lv_event_dsc_t * event_dsc = lv_obj_get_event_dsc(e->current_target, 0);
+    lv_event_dsc_t * event_dsc = cb_interested ? lv_obj_get_event_dsc(e->current_target, 0) : NULL;
 
     uint32_t i = 0;
     while(event_dsc && res == LV_RES_OK) {
@@ -455,9 +483,11 @@ static lv_res_t event_send_core(lv_event_t * e)
         event_dsc = lv_obj_get_event_dsc(e->current_target, i);
     }
 
-    res = lv_obj_event_base(NULL, e);
+    if(class_interested) res = lv_obj_event_base(NULL, e);
 
-    event_dsc = res == LV_RES_INV ? NULL : lv_obj_get_event_dsc(e->current_target, 0);
+    /*The class might have added callbacks, check the mask again*/
+    cb_interested = res == LV_RES_OK && obj->spec_attr && (obj->spec_attr->event_mask & code_bit);
+    event_dsc = cb_interested ? lv_obj_get_event_dsc(e->current_target, 0) : NULL;
 
     i = 0;
     while(event_dsc && res == LV_RES_OK) {
@@ -525,3 +555,41 @@ static bool event_is_bubbled(lv_event_t * e)
             return true;
     }
 }
+
+/**
+ * Collect the codes handled by the event function of a class and its ancestors
+ * @param class_p   pointer to a class
+ * @return          the `LV_EVENT_BIT()`s of the handled codes
+ */
+static uint64_t class_event_mask(const lv_obj_class_t * class_p)
+{
+    uint64_t mask = 0;
+    while(class_p) {
+        if(class_p->event_cb) {
+            /*The class didn't tell which codes it handles, assume all of them*/
+            if(class_p->event_mask == 0) return UINT64_MAX;
+            mask |= class_p->event_mask;
+        }
+        class_p = class_p->base_class;
+    }
+
+    return mask;
+}
+
+static uint64_t filter_event_mask(lv_event_code_t filter)
+{
+    filter &= ~LV_EVENT_PREPROCESS;
+    if(filter == LV_EVENT_ALL) return UINT64_MAX;
+    else return LV_EVENT_BIT(filter);
+}
+
+static void obj_event_mask_update(lv_obj_t * obj)
+{
+    uint64_t mask = 0;
+    uint32_t i;
+    for(i = 0; i < obj->spec_attr->event_dsc_cnt; i++) {
+        mask |= filter_event_mask(obj->spec_attr->event_dsc[i].filter);
+    }
+
+    obj->spec_attr->event_mask = mask;
+}
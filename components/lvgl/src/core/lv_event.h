@@ -19,6 +19,12 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/**
+ * Bit of an event code in the event masks of the classes and objects.
+ * The codes from 63 (e.g. the registered ones) share the last bit.
+ */
+#define LV_EVENT_BIT(code)  ((uint64_t)1 << ((code) < 63 ? (code) : 63))
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -132,6 +138,15 @@ typedef struct {
     const lv_area_t * area;
 } lv_cover_check_info_t;
 
+/**
+ * Statistics of the event dispatching, see `lv_event_monitor()`
+ */
+typedef struct {
+    uint32_t send_cnt;          /**< Number of `lv_event_send` calls*/
+    uint32_t dispatch_cnt;      /**< Number of objects the events were dispatched to (target and bubbling)*/
+    uint32_t skip_cnt;          /**< Dispatches where neither the class nor an event callback handled the code*/
+} lv_event_monitor_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -272,6 +287,17 @@ bool lv_obj_remove_event_dsc(struct _lv_obj_t * obj, struct _lv_event_dsc_t * ev
  */
 void * lv_obj_get_event_user_data(struct _lv_obj_t * obj, lv_event_cb_t event_cb);
 
+/**
+ * Get the statistics of the event dispatching since the start or the last `lv_event_monitor_reset()`
+ * @param mon_p     the result will be stored here
+ */
+void lv_event_monitor(lv_event_monitor_t * mon_p);
+
+/**
+ * Reset the statistics of the event dispatching
+ */
+void lv_event_monitor_reset(void);
+
 /**
  * Get the input device passed as parameter to indev related events.
  * @param e     pointer to an event
@@ -44,14 +44,15 @@ static lv_group_t * default_group;
 
 void _lv_group_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_group_ll), sizeof(lv_group_t));
+    lv_ilist_init(&LV_GC_ROOT(_lv_group_list));
 }
 
 lv_group_t * lv_group_create(void)
 {
-    lv_group_t * group = _lv_ll_ins_head(&LV_GC_ROOT(_lv_group_ll));
+    lv_group_t * group = lv_mem_alloc(sizeof(lv_group_t));
     LV_ASSERT_MALLOC(group);
     if(group == NULL) return NULL;
+    lv_ilist_ins_head(&LV_GC_ROOT(_lv_group_list), &group->node);
     _lv_ll_init(&group->obj_ll, sizeof(lv_obj_t *));
 
     group->obj_focus      = NULL;
@@ -94,7 +95,7 @@ void lv_group_del(lv_group_t * group)
 
     if(default_group == group) default_group = NULL;
     _lv_ll_clear(&(group->obj_ll));
-    _lv_ll_remove(&LV_GC_ROOT(_lv_group_ll), group);
+    lv_ilist_remove(&LV_GC_ROOT(_lv_group_list), &group->node);
     lv_mem_free(group);
 }
 
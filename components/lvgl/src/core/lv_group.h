@@ -19,6 +19,7 @@ extern "C" {
 #include <stdint.h>
 #include <stdbool.h>
 #include "../misc/lv_ll.h"
+#include "../misc/lv_ilist.h"
 #include "../misc/lv_types.h"
 
 /*********************
@@ -57,6 +58,7 @@ typedef void (*lv_group_edge_cb_t)(struct _lv_group_t *, bool);
  * They are NOT for laying out objects on a screen (try layouts for that).
  */
 typedef struct _lv_group_t {
+    lv_ilist_node_t node;  /**< Links the groups to each other (keep it the first member)*/
     lv_ll_t obj_ll;        /**< Linked list to store the objects in the group*/
     struct _lv_obj_t ** obj_focus; /**< The object in focus*/
 
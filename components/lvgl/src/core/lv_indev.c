@@ -311,15 +311,34 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
 
     /*If the point is on this object or has overflow visible check its children too*/
     if(_lv_area_is_point_on(&obj->coords, &p_trans, 0) || lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
-        int32_t i;
-        uint32_t child_cnt = lv_obj_get_child_cnt(obj);
-
-        /*If a child matches use it*/
-        for(i = child_cnt - 1; i >= 0; i--) {
-            lv_obj_t * child = obj->spec_attr->children[i];
-            found_p = lv_indev_search_obj(child, &p_trans);
+        lv_area_t point_area = {p_trans.x, p_trans.y, p_trans.x, p_trans.y};
+        _lv_obj_spatial_iter_t it;
+        if(_lv_obj_spatial_iter_init(obj, &point_area, &it)) {
+            /*The children close to the point come in any order so use the top most (last) match*/
+            lv_obj_t * child;
+            uint32_t id;
+            uint32_t found_id = 0;
+            while((child = _lv_obj_spatial_iter_next(&it, &id)) != NULL) {
+                if(found_p && id < found_id) continue;
+                lv_obj_t * found_child_p = lv_indev_search_obj(child, &p_trans);
+                if(found_child_p) {
+                    found_p = found_child_p;
+                    found_id = id;
+                }
+            }
             if(found_p) return found_p;
         }
+        else {
+            int32_t i;
+            uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+
+            /*If a child matches use it*/
+            for(i = child_cnt - 1; i >= 0; i--) {
+                lv_obj_t * child = obj->spec_attr->children[i];
+                found_p = lv_indev_search_obj(child, &p_trans);
+                if(found_p) return found_p;
+            }
+        }
     }
 
     /*If not return earlier for a clicked child and this obj's hittest was ok use it
@@ -50,6 +50,9 @@
 #define LV_OBJ_DEF_HEIGHT   (LV_DPX(50))
 #define STYLE_TRANSITION_MAX 32
 
+/*Flags which decide how the parent's spatial index handles an object*/
+#define SPATIAL_FLAGS       (LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING | LV_OBJ_FLAG_OVERFLOW_VISIBLE)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -74,6 +77,14 @@ const lv_obj_class_t lv_obj_class = {
     .constructor_cb = lv_obj_constructor,
     .destructor_cb = lv_obj_destructor,
     .event_cb = lv_obj_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_CHILD_CHANGED) | LV_EVENT_BIT(LV_EVENT_CHILD_DELETED) |
+                  LV_EVENT_BIT(LV_EVENT_COVER_CHECK) | LV_EVENT_BIT(LV_EVENT_DEFOCUSED) |
+                  LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) | LV_EVENT_BIT(LV_EVENT_DRAW_POST) | LV_EVENT_BIT(LV_EVENT_FOCUSED) |
+                  LV_EVENT_BIT(LV_EVENT_KEY) | LV_EVENT_BIT(LV_EVENT_PRESSED) | LV_EVENT_BIT(LV_EVENT_PRESS_LOST) |
+                  LV_EVENT_BIT(LV_EVENT_REFR_EXT_DRAW_SIZE) | LV_EVENT_BIT(LV_EVENT_RELEASED) |
+                  LV_EVENT_BIT(LV_EVENT_SCROLL_BEGIN) | LV_EVENT_BIT(LV_EVENT_SCROLL_END) |
+                  LV_EVENT_BIT(LV_EVENT_SIZE_CHANGED) | LV_EVENT_BIT(LV_EVENT_STYLE_CHANGED) |
+                  LV_EVENT_BIT(LV_EVENT_VALUE_CHANGED),
     .width_def = LV_DPI_DEF,
     .height_def = LV_DPI_DEF,
     .editable = LV_OBJ_CLASS_EDITABLE_FALSE,
@@ -138,6 +149,7 @@ void lv_init(void)
 #endif
 
     _lv_obj_style_init();
+    _lv_obj_bitmap_cache_init();
     _lv_ll_init(&LV_GC_ROOT(_lv_disp_ll), sizeof(lv_disp_t));
     _lv_ll_init(&LV_GC_ROOT(_lv_indev_ll), sizeof(lv_indev_t));
 
@@ -235,6 +247,7 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
     /* We must invalidate the area occupied by the object before we hide it as calls to invalidate hidden objects are ignored */
     if(f & LV_OBJ_FLAG_HIDDEN) lv_obj_invalidate(obj);
 
+    if(~obj->flags & f & SPATIAL_FLAGS) _lv_obj_spatial_invalidate(lv_obj_get_parent(obj));
     obj->flags |= f;
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
@@ -251,7 +264,7 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
     }
 
     if((was_on_layout != lv_obj_is_layout_positioned(obj)) || (f & (LV_OBJ_FLAG_LAYOUT_1 |  LV_OBJ_FLAG_LAYOUT_2))) {
-        lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
+        lv_obj_mark_parent_layout_as_dirty(obj);
         lv_obj_mark_layout_as_dirty(obj);
     }
 
@@ -275,18 +288,20 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_invalidate_area(obj, &ver_area);
     }
 
+    if(obj->flags & f & SPATIAL_FLAGS) _lv_obj_spatial_invalidate(lv_obj_get_parent(obj));
+    if(f & LV_OBJ_FLAG_CACHE_BITMAP) _lv_obj_bitmap_cache_free(obj);
     obj->flags &= (~f);
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
         if(lv_obj_is_layout_positioned(obj)) {
-            lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
+            lv_obj_mark_parent_layout_as_dirty(obj);
             lv_obj_mark_layout_as_dirty(obj);
         }
     }
 
     if((was_on_layout != lv_obj_is_layout_positioned(obj)) || (f & (LV_OBJ_FLAG_LAYOUT_1 |  LV_OBJ_FLAG_LAYOUT_2))) {
-        lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
+        lv_obj_mark_parent_layout_as_dirty(obj);
     }
 
 }
@@ -452,6 +467,7 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     LV_UNUSED(class_p);
 
     _lv_event_mark_deleted(obj);
+    _lv_style_cache_invalidate();
 
     /*Remove all style*/
     lv_obj_enable_style_refresh(false); /*No need to refresh the style because the object will be deleted*/
@@ -474,6 +490,8 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
             lv_mem_free(obj->spec_attr->event_dsc);
             obj->spec_attr->event_dsc = NULL;
         }
+        _lv_obj_spatial_free(obj);
+        _lv_obj_bitmap_cache_free(obj);
 
         lv_mem_free(obj->spec_attr);
         obj->spec_attr = NULL;
@@ -859,12 +877,19 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
         lv_coord_t align = lv_obj_get_style_align(obj, LV_PART_MAIN);
         uint16_t layout = lv_obj_get_style_layout(obj, LV_PART_MAIN);
         if(layout || align || w == LV_SIZE_CONTENT || h == LV_SIZE_CONTENT) {
-            lv_obj_mark_layout_as_dirty(obj);
+            /*If the child is known only the children after it need to be repositioned*/
+            lv_obj_t * child = lv_event_get_param(e);
+            if(child && lv_obj_get_parent(child) == obj) lv_obj_mark_parent_layout_as_dirty(child);
+            /*A child was deleted or moved to an other index: the clean children are already limited*/
+            else if(child == NULL) _lv_obj_mark_layout_as_dirty_keep_clean(obj);
+            else lv_obj_mark_layout_as_dirty(obj);
         }
     }
     else if(code == LV_EVENT_CHILD_DELETED) {
         obj->readjust_scroll_after_layout = 1;
-        lv_obj_mark_layout_as_dirty(obj);
+        /*Only the children after the removed one need to be repositioned.
+         *The clean children were limited when it was removed from the list.*/
+        _lv_obj_mark_layout_as_dirty_keep_clean(obj);
     }
     else if(code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
         lv_coord_t d = lv_obj_calculate_ext_draw_size(obj, LV_PART_MAIN);
@@ -889,6 +914,7 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
 
     lv_state_t prev_state = obj->state;
     obj->state = new_state;
+    _lv_style_cache_invalidate();
 
     _lv_style_state_cmp_t cmp_res = _lv_obj_style_state_compare(obj, prev_state, new_state);
     /*If there is no difference in styles there is nothing else to do*/
@@ -108,6 +108,7 @@ enum {
     LV_OBJ_FLAG_IGNORE_LAYOUT   = (1L << 17), /**< Make the object position-able by the layouts*/
     LV_OBJ_FLAG_FLOATING        = (1L << 18), /**< Do not scroll the object when the parent scrolls and ignore layout*/
     LV_OBJ_FLAG_OVERFLOW_VISIBLE = (1L << 19), /**< Do not clip the children's content to the parent's boundary*/
+    LV_OBJ_FLAG_CACHE_BITMAP    = (1L << 20), /**< Render the object with its children into an image and draw it until they are invalidated. Needs `LV_OBJ_BITMAP_CACHE`*/
 
     LV_OBJ_FLAG_LAYOUT_1        = (1L << 23), /**< Custom flag, free to use by layouts*/
     LV_OBJ_FLAG_LAYOUT_2        = (1L << 24), /**< Custom flag, free to use by layouts*/
@@ -137,8 +138,10 @@ typedef enum {
 #include "lv_obj_tree.h"
 #include "lv_obj_pos.h"
 #include "lv_obj_scroll.h"
+#include "lv_obj_spatial.h"
 #include "lv_obj_style.h"
 #include "lv_obj_draw.h"
+#include "lv_obj_bitmap_cache.h"
 #include "lv_obj_class.h"
 #include "lv_event.h"
 #include "lv_group.h"
@@ -155,9 +158,17 @@ extern const lv_obj_class_t lv_obj_class;
 typedef struct {
     struct _lv_obj_t ** children;       /**< Store the pointer of the children in an array.*/
     uint32_t child_cnt;                 /**< Number of children*/
+    uint32_t layout_clean_cnt;          /**< Number of leading children whose position the layout can reuse*/
     lv_group_t * group_p;
+#if LV_OBJ_SPATIAL_INDEX
+    struct _lv_obj_spatial_t * spatial; /**< Spatial index of the children, NULL if not enabled*/
+#endif
+#if LV_OBJ_BITMAP_CACHE
+    struct _lv_obj_bitmap_cache_t * bitmap_cache;   /**< The object rendered as an image, NULL if not cached*/
+#endif
 
     struct _lv_event_dsc_t * event_dsc; /**< Dynamically allocated event callback and user data array*/
+    uint64_t event_mask;                /**< `LV_EVENT_BIT()` of the codes `event_dsc` has callbacks for*/
     lv_point_t scroll;                  /**< The current X/Y scroll offset*/
 
     lv_coord_t ext_click_pad;           /**< Extra click padding in all direction*/
@@ -190,6 +201,7 @@ typedef struct _lv_obj_t {
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
     uint16_t being_deleted   : 1;
+    uint16_t child_layout_inv : 1;  /**< A descendant has `layout_inv` or `readjust_scroll_after_layout` set*/
 } lv_obj_t;
 
 
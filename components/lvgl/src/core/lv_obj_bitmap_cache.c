@@ -0,0 +1,387 @@
+/**
+ * @file lv_obj_bitmap_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+#include "lv_disp.h"
+#include "lv_refr.h"
+#include "../misc/lv_gc.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &lv_obj_class
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_OBJ_BITMAP_CACHE
+static lv_res_t bitmap_render(lv_obj_t * obj, const lv_area_t * coords);
+static void bitmap_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, _lv_obj_bitmap_cache_t * bc,
+                        const lv_area_t * coords, lv_opa_t opa);
+static void entry_free(_lv_obj_bitmap_cache_t * bc);
+static void cache_shrink(uint32_t mem_max);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_OBJ_BITMAP_CACHE
+static lv_obj_bitmap_cache_stats_t stats;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_obj_bitmap_cache_set_size(uint32_t size)
+{
+#if LV_OBJ_BITMAP_CACHE
+    stats.mem_budget = size;
+    cache_shrink(size);
+#else
+    LV_UNUSED(size);
+#endif
+}
+
+void lv_obj_bitmap_cache_get_stats(lv_obj_bitmap_cache_stats_t * s)
+{
+#if LV_OBJ_BITMAP_CACHE
+    *s = stats;
+#else
+    lv_memset_00(s, sizeof(lv_obj_bitmap_cache_stats_t));
+#endif
+}
+
+void lv_obj_bitmap_cache_reset_stats(void)
+{
+#if LV_OBJ_BITMAP_CACHE
+    stats.hit_cnt = 0;
+    stats.miss_cnt = 0;
+    stats.evict_cnt = 0;
+    stats.uncached_cnt = 0;
+#endif
+}
+
+#if LV_OBJ_BITMAP_CACHE
+
+void _lv_obj_bitmap_cache_init(void)
+{
+    lv_ilist_init(&LV_GC_ROOT(_lv_obj_bitmap_cache_list));
+    lv_memset_00(&stats, sizeof(stats));
+    stats.mem_budget = LV_OBJ_BITMAP_CACHE_SIZE;
+}
+
+void _lv_obj_bitmap_cache_free(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->bitmap_cache == NULL) return;
+    entry_free(obj->spec_attr->bitmap_cache);
+}
+
+void _lv_obj_bitmap_cache_invalidate(const lv_obj_t * obj)
+{
+    if(stats.entry_cnt == 0) return;
+
+    while(obj) {
+        if(obj->spec_attr && obj->spec_attr->bitmap_cache) obj->spec_attr->bitmap_cache->valid = 0;
+        obj = obj->parent;
+    }
+}
+
+void _lv_obj_bitmap_cache_invalidate_children(const lv_obj_t * obj)
+{
+    /*There are typically much less cached objects than children so check the cached objects*/
+    lv_ilist_node_t * node;
+    _LV_ILIST_READ(&LV_GC_ROOT(_lv_obj_bitmap_cache_list), node) {
+        _lv_obj_bitmap_cache_t * bc = lv_ilist_entry(node, _lv_obj_bitmap_cache_t, node);
+        const lv_obj_t * parent = bc->obj->parent;
+        while(parent && parent != obj) parent = parent->parent;
+        if(parent) bc->valid = 0;
+    }
+}
+
+bool _lv_obj_bitmap_cache_is_valid(const lv_obj_t * obj)
+{
+    return obj->spec_attr && obj->spec_attr->bitmap_cache && obj->spec_attr->bitmap_cache->valid;
+}
+
+void _lv_obj_bitmap_cache_set_valid(lv_obj_t * obj)
+{
+    if(obj->spec_attr && obj->spec_attr->bitmap_cache && obj->spec_attr->bitmap_cache->img.data) {
+        obj->spec_attr->bitmap_cache->valid = 1;
+    }
+}
+
+bool _lv_obj_bitmap_cache_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    lv_opa_t opa = lv_obj_get_style_opa_layered(obj, 0);
+    if(opa < LV_OPA_MIN) return true;
+
+    lv_area_t coords;
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, &coords);
+    lv_area_increase(&coords, ext_draw_size, ext_draw_size);
+
+    /*Don't render the objects which are not visible on the clip area*/
+    lv_area_t tranf_coords = coords;
+    lv_obj_get_transformed_area(obj, &tranf_coords, false, false);
+    if(!_lv_area_is_on(&tranf_coords, draw_ctx->clip_area)) return true;
+
+    /*The children use the opacity of the parents too. Render them only with opaque parents
+     *and apply the opacity of the parents on the whole bitmap. This way fading doesn't render it in every frame.*/
+    lv_opa_t parent_opa = obj->parent ? lv_obj_get_style_opa_recursive(obj->parent, LV_PART_MAIN) : LV_OPA_COVER;
+    if(parent_opa < LV_OPA_MIN) return true;
+
+    _lv_obj_bitmap_cache_t * bc = obj->spec_attr ? obj->spec_attr->bitmap_cache : NULL;
+    if(bc && (bc->img.header.w != lv_area_get_width(&coords) || bc->img.header.h != lv_area_get_height(&coords))) {
+        bc->valid = 0;
+    }
+
+    if(bc && bc->valid) {
+        stats.hit_cnt++;
+    }
+    else {
+        if(parent_opa < LV_OPA_MAX || stats.mem_budget == 0) return false;
+        if(bitmap_render(obj, &coords) != LV_RES_OK) {
+            stats.uncached_cnt++;
+            return false;
+        }
+        stats.miss_cnt++;
+        bc = obj->spec_attr->bitmap_cache;
+    }
+
+    /*Keep the most recently drawn bitmaps at the head and free from the tail*/
+    lv_ilist_t * list = &LV_GC_ROOT(_lv_obj_bitmap_cache_list);
+    if(lv_ilist_get_head(list) != &bc->node) {
+        lv_ilist_remove(list, &bc->node);
+        lv_ilist_ins_head(list, &bc->node);
+    }
+
+    if(parent_opa < LV_OPA_MAX) opa = ((uint32_t)opa * parent_opa) >> 8;
+    bitmap_draw(draw_ctx, obj, bc, &coords, opa);
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Render an object with its children into its bitmap. Create the bitmap if it doesn't exist.
+ * @param obj       pointer to an object
+ * @param coords    the area to render: the object's coordinates increased by its extra draw size
+ * @return          LV_RES_OK: the bitmap is rendered; LV_RES_INV: the bitmap doesn't fit into the cache (it's freed)
+ */
+static lv_res_t bitmap_render(lv_obj_t * obj, const lv_area_t * coords)
+{
+    /*Opaque objects without shadow, outline, etc don't need an alpha channel*/
+    lv_img_cf_t cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    if(_lv_obj_get_ext_draw_size(obj) == 0) {
+        lv_cover_check_info_t info;
+        info.res = LV_COVER_RES_COVER;
+        info.area = coords;
+        lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+        if(info.res == LV_COVER_RES_COVER) cf = LV_IMG_CF_TRUE_COLOR;
+    }
+
+    lv_coord_t w = lv_area_get_width(coords);
+    lv_coord_t h = lv_area_get_height(coords);
+    uint32_t px_size = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    uint32_t size = (uint32_t)w * h * px_size;
+    if(size > stats.mem_budget) {
+        _lv_obj_bitmap_cache_free(obj);
+        return LV_RES_INV;
+    }
+
+    lv_obj_allocate_spec_attr(obj);
+    _lv_obj_bitmap_cache_t * bc = obj->spec_attr->bitmap_cache;
+    if(bc == NULL) {
+        bc = lv_mem_alloc(sizeof(_lv_obj_bitmap_cache_t));
+        LV_ASSERT_MALLOC(bc);
+        if(bc == NULL) return LV_RES_INV;
+        lv_memset_00(bc, sizeof(_lv_obj_bitmap_cache_t));
+        bc->obj = obj;
+        lv_ilist_ins_head(&LV_GC_ROOT(_lv_obj_bitmap_cache_list), &bc->node);
+        obj->spec_attr->bitmap_cache = bc;
+        stats.entry_cnt++;
+    }
+
+    /*The image cache might have the previous size and color format*/
+    if(bc->img.data) lv_img_cache_invalidate_src(&bc->img);
+
+    if(size != bc->buf_size) {
+        /*Free the old buffer first to leave room for the new one*/
+        if(bc->img.data) {
+            lv_mem_free((void *)bc->img.data);
+            stats.mem_used -= bc->buf_size;
+            bc->img.data = NULL;
+            bc->buf_size = 0;
+        }
+
+        bc->rendering = 1;
+        if(stats.mem_used + size > stats.mem_budget) cache_shrink(stats.mem_budget - size);
+        bc->rendering = 0;
+
+        /*Running out of memory is not an error, the object is drawn normally*/
+        uint8_t * buf = lv_mem_alloc(size);
+        if(buf == NULL) {
+            LV_LOG_WARN("Couldn't allocate %"LV_PRIu32" bytes to cache an object", size);
+            entry_free(bc);
+            return LV_RES_INV;
+        }
+        bc->img.data = buf;
+        bc->buf_size = size;
+        stats.mem_used += size;
+    }
+
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    lv_draw_ctx_t * draw_ctx = lv_mem_alloc(disp->driver->draw_ctx_size);
+    LV_ASSERT_MALLOC(draw_ctx);
+    if(draw_ctx == NULL) {
+        entry_free(bc);
+        return LV_RES_INV;
+    }
+
+    bc->valid = 0;
+    bc->rendering = 1;
+    lv_memset_00((void *)bc->img.data, size);
+
+    /*Render like `lv_snapshot` does, on a display which has the bitmap as its draw buffer*/
+    lv_disp_drv_t driver;
+    lv_disp_drv_init(&driver);
+    driver.hor_res = lv_disp_get_hor_res(disp);
+    driver.ver_res = lv_disp_get_ver_res(disp);
+    driver.antialiasing = disp->driver->antialiasing;
+#if LV_COLOR_SCREEN_TRANSP
+    driver.screen_transp = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? 1 : 0;
+#else
+    lv_disp_drv_use_generic_set_px_cb(&driver, cf);
+#endif
+
+    lv_disp_t fake_disp;
+    lv_memset_00(&fake_disp, sizeof(lv_disp_t));
+    fake_disp.driver = &driver;
+
+    disp->driver->draw_ctx_init(&driver, draw_ctx);
+    draw_ctx->clip_area = coords;
+    draw_ctx->buf_area = coords;
+    draw_ctx->buf = (void *)bc->img.data;
+    driver.draw_ctx = draw_ctx;
+
+#if LV_DRAW_COMPLEX
+    /*The masks of the parents are applied when the bitmap is drawn, not to the bitmap*/
+    _lv_draw_mask_saved_arr_t masks;
+    lv_memcpy(masks, LV_GC_ROOT(_lv_draw_mask_list), sizeof(masks));
+    lv_memset_00(LV_GC_ROOT(_lv_draw_mask_list), sizeof(masks));
+#endif
+
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&fake_disp);
+
+    lv_obj_redraw(draw_ctx, obj);
+    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+    _lv_refr_set_disp_refreshing(refr_ori);
+
+#if LV_DRAW_COMPLEX
+    lv_memcpy(LV_GC_ROOT(_lv_draw_mask_list), masks, sizeof(masks));
+#endif
+
+    disp->driver->draw_ctx_deinit(&driver, draw_ctx);
+    lv_mem_free(draw_ctx);
+
+    bc->img.header.always_zero = 0;
+    bc->img.header.w = w;
+    bc->img.header.h = h;
+    bc->img.header.cf = cf;
+    bc->img.data_size = size;
+    bc->rendering = 0;
+    bc->valid = 1;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Draw the bitmap of an object with the opacity and transformation of the object's layer
+ * @param draw_ctx  pointer to the draw context
+ * @param obj       pointer to an object
+ * @param bc        the bitmap of the object
+ * @param coords    the area of the bitmap
+ * @param opa       opacity of the bitmap
+ */
+static void bitmap_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, _lv_obj_bitmap_cache_t * bc,
+                        const lv_area_t * coords, lv_opa_t opa)
+{
+    lv_draw_img_dsc_t draw_dsc;
+    lv_draw_img_dsc_init(&draw_dsc);
+    draw_dsc.opa = opa;
+    draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
+    draw_dsc.antialias = _lv_refr_get_disp_refreshing()->driver->antialiasing;
+
+    if(_lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM) {
+        draw_dsc.angle = lv_obj_get_style_transform_angle(obj, 0);
+        if(draw_dsc.angle > 3600) draw_dsc.angle -= 3600;
+        else if(draw_dsc.angle < 0) draw_dsc.angle += 3600;
+        draw_dsc.zoom = lv_obj_get_style_transform_zoom(obj, 0);
+
+        /*The pivot is relative to the bitmap*/
+        lv_coord_t pivot_x = lv_obj_get_style_transform_pivot_x(obj, 0);
+        lv_coord_t pivot_y = lv_obj_get_style_transform_pivot_y(obj, 0);
+        if(LV_COORD_IS_PCT(pivot_x)) pivot_x = (LV_COORD_GET_PCT(pivot_x) * lv_obj_get_width(obj)) / 100;
+        if(LV_COORD_IS_PCT(pivot_y)) pivot_y = (LV_COORD_GET_PCT(pivot_y) * lv_obj_get_height(obj)) / 100;
+        draw_dsc.pivot.x = obj->coords.x1 - coords->x1 + pivot_x;
+        draw_dsc.pivot.y = obj->coords.y1 - coords->y1 + pivot_y;
+    }
+
+    lv_draw_img(draw_ctx, &draw_dsc, coords, &bc->img);
+}
+
+/**
+ * Free a bitmap and remove it from its object
+ * @param bc        pointer to a bitmap which is not being rendered
+ */
+static void entry_free(_lv_obj_bitmap_cache_t * bc)
+{
+    if(bc->img.data) {
+        lv_img_cache_invalidate_src(&bc->img);
+        lv_mem_free((void *)bc->img.data);
+        stats.mem_used -= bc->buf_size;
+    }
+
+    lv_ilist_remove(&LV_GC_ROOT(_lv_obj_bitmap_cache_list), &bc->node);
+    bc->obj->spec_attr->bitmap_cache = NULL;
+    stats.entry_cnt--;
+    lv_mem_free(bc);
+}
+
+/**
+ * Free the least recently drawn bitmaps until the size of all bitmaps is not larger than a limit
+ * @param mem_max   the maximal size in bytes
+ */
+static void cache_shrink(uint32_t mem_max)
+{
+    lv_ilist_node_t * node = lv_ilist_get_tail(&LV_GC_ROOT(_lv_obj_bitmap_cache_list));
+    while(node && stats.mem_used > mem_max) {
+        lv_ilist_node_t * prev = lv_ilist_get_prev(node);
+        _lv_obj_bitmap_cache_t * bc = lv_ilist_entry(node, _lv_obj_bitmap_cache_t, node);
+        if(!bc->rendering && bc->buf_size) {
+            entry_free(bc);
+            stats.evict_cnt++;
+        }
+        node = prev;
+    }
+}
+
+#endif /*LV_OBJ_BITMAP_CACHE*/
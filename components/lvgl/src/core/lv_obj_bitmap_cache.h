@@ -0,0 +1,177 @@
+/**
+ * @file lv_obj_bitmap_cache.h
+ *
+ */
+
+#ifndef LV_OBJ_BITMAP_CACHE_H
+#define LV_OBJ_BITMAP_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_ilist.h"
+#include "../misc/lv_types.h"
+#include "../draw/lv_draw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Can't include lv_obj.h because it includes this header file*/
+struct _lv_obj_t;
+
+/**
+ * An object with `LV_OBJ_FLAG_CACHE_BITMAP` rendered with its children as an image
+ */
+typedef struct _lv_obj_bitmap_cache_t {
+    lv_ilist_node_t node;       /**< Node in the list of the bitmaps, the most recently drawn is the head*/
+    struct _lv_obj_t * obj;     /**< The cached object*/
+    lv_img_dsc_t img;           /**< The object and the area of its extra draw size. `data` is NULL if not rendered yet*/
+    uint32_t buf_size;          /**< Size of `img.data` in bytes*/
+    uint8_t valid : 1;          /**< 1: `img` shows the current look of the object*/
+    uint8_t rendering : 1;      /**< 1: the object is being rendered into `img`, it can't be freed now*/
+} _lv_obj_bitmap_cache_t;
+
+/**
+ * Statistics of the bitmap cache
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of times a cached bitmap was drawn*/
+    uint32_t miss_cnt;      /**< Number of times an object was rendered into its bitmap*/
+    uint32_t evict_cnt;     /**< Number of bitmaps freed to make room for other bitmaps*/
+    uint32_t uncached_cnt;  /**< Number of times an object was drawn normally because its bitmap didn't fit*/
+    uint32_t entry_cnt;     /**< Number of objects with a bitmap (valid or not)*/
+    uint32_t mem_used;      /**< Size of the bitmaps in bytes*/
+    uint32_t mem_budget;    /**< Maximal size of the bitmaps in bytes*/
+} lv_obj_bitmap_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the total size of the cached bitmaps.
+ * The least recently drawn bitmaps are freed until they fit.
+ * @param size      the new size in bytes. 0: free all the bitmaps and don't cache
+ */
+void lv_obj_bitmap_cache_set_size(uint32_t size);
+
+/**
+ * Get the statistics of the bitmap cache
+ * @param stats     store the statistics here
+ */
+void lv_obj_bitmap_cache_get_stats(lv_obj_bitmap_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss, evict and uncached counters of the bitmap cache
+ */
+void lv_obj_bitmap_cache_reset_stats(void);
+
+#if LV_OBJ_BITMAP_CACHE
+
+/**
+ * Initialize the bitmap cache. Called by `lv_init()`.
+ */
+void _lv_obj_bitmap_cache_init(void);
+
+/**
+ * Free the cached bitmap of an object
+ * @param obj       pointer to an object
+ */
+void _lv_obj_bitmap_cache_free(struct _lv_obj_t * obj);
+
+/**
+ * Render the cached bitmaps of an object and its parents again on their next draw
+ * because the object has changed.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_bitmap_cache_invalidate(const struct _lv_obj_t * obj);
+
+/**
+ * Render the cached bitmaps of an object's children again on their next draw,
+ * e.g. because an inherited style property of the object has changed.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_bitmap_cache_invalidate_children(const struct _lv_obj_t * obj);
+
+/**
+ * Tell whether the cached bitmap of an object can be drawn without rendering the object again
+ * @param obj       pointer to an object
+ * @return          true: the object has a valid bitmap
+ */
+bool _lv_obj_bitmap_cache_is_valid(const struct _lv_obj_t * obj);
+
+/**
+ * Mark the bitmap of an object valid again, e.g. because it was only moved since it was valid
+ * @param obj       pointer to an object which has a rendered bitmap
+ */
+void _lv_obj_bitmap_cache_set_valid(struct _lv_obj_t * obj);
+
+/**
+ * Draw an object with `LV_OBJ_FLAG_CACHE_BITMAP` from its bitmap. Render the bitmap first if it's not valid.
+ * The opacity and transformation of the object's layer is applied while drawing the bitmap.
+ * @param draw_ctx  pointer to the draw context
+ * @param obj       pointer to an object
+ * @return          true: the object is drawn (or it's not visible on the clip area);
+ *                  false: the bitmap can't be used, draw the object normally
+ */
+bool _lv_obj_bitmap_cache_draw(lv_draw_ctx_t * draw_ctx, struct _lv_obj_t * obj);
+
+#else
+
+static inline void _lv_obj_bitmap_cache_init(void)
+{
+}
+
+static inline void _lv_obj_bitmap_cache_free(struct _lv_obj_t * obj)
+{
+    LV_UNUSED(obj);
+}
+
+static inline void _lv_obj_bitmap_cache_invalidate(const struct _lv_obj_t * obj)
+{
+    LV_UNUSED(obj);
+}
+
+static inline void _lv_obj_bitmap_cache_invalidate_children(const struct _lv_obj_t * obj)
+{
+    LV_UNUSED(obj);
+}
+
+static inline bool _lv_obj_bitmap_cache_is_valid(const struct _lv_obj_t * obj)
+{
+    LV_UNUSED(obj);
+    return false;
+}
+
+static inline void _lv_obj_bitmap_cache_set_valid(struct _lv_obj_t * obj)
+{
+    LV_UNUSED(obj);
+}
+
+static inline bool _lv_obj_bitmap_cache_draw(lv_draw_ctx_t * draw_ctx, struct _lv_obj_t * obj)
+{
+    LV_UNUSED(draw_ctx);
+    LV_UNUSED(obj);
+    return false;
+}
+
+#endif /*LV_OBJ_BITMAP_CACHE*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_BITMAP_CACHE_H*/
@@ -55,6 +55,7 @@ typedef struct _lv_obj_class_t {
 #endif
     void (*event_cb)(const struct _lv_obj_class_t * class_p,
                      struct _lv_event_t * e);  /**< Widget type specific event function*/
+    uint64_t event_mask;    /**< `LV_EVENT_BIT()` of the codes handled by `event_cb`. 0: `event_cb` gets every code*/
     lv_coord_t width_def;
     lv_coord_t height_def;
     uint32_t editable : 2;             /**< Value from ::lv_obj_class_editable_t*/
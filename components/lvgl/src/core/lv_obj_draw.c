@@ -377,7 +377,10 @@ void lv_obj_refresh_ext_draw_size(lv_obj_t * obj)
         obj->spec_attr->ext_draw_size = s_new;
     }
 
-    if(s_new != s_old) lv_obj_invalidate(obj);
+    if(s_new != s_old) {
+        lv_obj_invalidate(obj);
+        _lv_obj_spatial_child_moved(obj, &obj->coords);
+    }
 }
 
 lv_coord_t _lv_obj_get_ext_draw_size(const lv_obj_t * obj)
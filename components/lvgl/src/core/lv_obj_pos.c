@@ -26,6 +26,8 @@
 static lv_coord_t calc_content_width(lv_obj_t * obj);
 static lv_coord_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static void layout_mark_dirty_core(lv_obj_t * obj);
+static void layout_mark_ancestors(lv_obj_t * obj);
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv);
 
 /**********************
@@ -190,6 +192,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     else {
         obj->coords.x2 = obj->coords.x1 + w - 1;
     }
+    _lv_obj_spatial_child_moved(obj, &ori);
 
     /*Call the ancestor's event handler to the object with its new coordinates*/
     lv_event_send(obj, LV_EVENT_SIZE_CHANGED, &ori);
@@ -201,6 +204,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_obj_invalidate(obj);
 
     obj->readjust_scroll_after_layout = 1;
+    layout_mark_ancestors(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -287,15 +291,33 @@ bool lv_obj_is_layout_positioned(const lv_obj_t * obj)
 
 void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
-    obj->layout_inv = 1;
+    /*The position of all the children might be different*/
+    if(obj->spec_attr) obj->spec_attr->layout_clean_cnt = 0;
 
-    /*Mark the screen as dirty too to mark that there is something to do on this screen*/
-    lv_obj_t * scr = lv_obj_get_screen(obj);
-    scr->scr_layout_inv = 1;
+    layout_mark_dirty_core(obj);
+}
 
-    /*Make the display refreshing*/
-    lv_disp_t * disp = lv_obj_get_disp(scr);
-    if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+void _lv_obj_mark_layout_as_dirty_keep_clean(lv_obj_t * obj)
+{
+    layout_mark_dirty_core(obj);
+}
+
+void lv_obj_mark_parent_layout_as_dirty(lv_obj_t * obj)
+{
+    lv_obj_t * parent = obj->parent;
+    if(parent == NULL) return;
+
+    /*The children before `obj` are not affected so keep them clean.
+     *Search from the end because usually the last (e.g. just created) children change.*/
+    _lv_obj_spec_attr_t * spec_attr = parent->spec_attr;
+    int32_t i;
+    for(i = (int32_t)spec_attr->child_cnt - 1; i >= 0; i--) {
+        if(spec_attr->children[i] == obj) break;
+    }
+    if(i < 0) spec_attr->layout_clean_cnt = 0;
+    else if((uint32_t)i < spec_attr->layout_clean_cnt) spec_attr->layout_clean_cnt = i;
+
+    layout_mark_dirty_core(parent);
 }
 
 void lv_obj_update_layout(const lv_obj_t * obj)
@@ -739,6 +761,9 @@ void lv_obj_move_to(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
      *occur without position change*/
     if(diff.x == 0 && diff.y == 0) return;
 
+    /*Only the position changes so the cached bitmap of the object remains valid*/
+    bool bitmap_valid = _lv_obj_bitmap_cache_is_valid(obj);
+
     /*Invalidate the original area*/
     lv_obj_invalidate(obj);
 
@@ -762,6 +787,7 @@ void lv_obj_move_to(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     obj->coords.y1 += diff.y;
     obj->coords.x2 += diff.x;
     obj->coords.y2 += diff.y;
+    _lv_obj_spatial_child_moved(obj, &ori);
 
     lv_obj_move_children_by(obj, diff.x, diff.y, false);
 
@@ -770,6 +796,7 @@ void lv_obj_move_to(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
 
     /*Invalidate the new area*/
     lv_obj_invalidate(obj);
+    if(bitmap_valid) _lv_obj_bitmap_cache_set_valid(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the srollbars*/
@@ -781,6 +808,9 @@ void lv_obj_move_to(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
 
 void lv_obj_move_children_by(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff, bool ignore_floating)
 {
+    /*The floating children are not in the spatial index so it can be simply shifted*/
+    _lv_obj_spatial_children_moved(obj, x_diff, y_diff);
+
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_cnt(obj);
     for(i = 0; i < child_cnt; i++) {
@@ -838,6 +868,9 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The cached bitmaps need to be rendered again even if the object is not visible now*/
+    _lv_obj_bitmap_cache_invalidate(obj);
+
     lv_disp_t * disp   = lv_obj_get_disp(obj);
     if(!lv_disp_is_invalidation_enabled(disp)) return;
 
@@ -937,6 +970,7 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t size)
 
     lv_obj_allocate_spec_attr(obj);
     obj->spec_attr->ext_click_pad = size;
+    _lv_obj_spatial_child_moved(obj, &obj->coords);
 }
 
 void lv_obj_get_click_area(const lv_obj_t * obj, lv_area_t * area)
@@ -1132,9 +1166,17 @@ static void layout_update_core(lv_obj_t * obj)
 {
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_cnt(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+
+    /*Visit only the children which are or have dirty descendants.
+     *Clear the flag first so that if a child is marked again meanwhile it's not lost.*/
+    if(obj->child_layout_inv) {
+        obj->child_layout_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->child_layout_inv || child->readjust_scroll_after_layout) {
+                layout_update_core(child);
+            }
+        }
     }
 
     if(obj->layout_inv) {
@@ -1157,6 +1199,33 @@ static void layout_update_core(lv_obj_t * obj)
     }
 }
 
+static void layout_mark_dirty_core(lv_obj_t * obj)
+{
+    obj->layout_inv = 1;
+    layout_mark_ancestors(obj);
+
+    /*Mark the screen as dirty too to mark that there is something to do on this screen*/
+    lv_obj_t * scr = lv_obj_get_screen(obj);
+    scr->scr_layout_inv = 1;
+
+    /*Make the display refreshing*/
+    lv_disp_t * disp = lv_obj_get_disp(scr);
+    if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+}
+
+/**
+ * Mark the ancestors of an object to tell `layout_update_core` that it needs to visit their children.
+ * If an ancestor is marked already all the higher ones are marked too, so stop there.
+ */
+static void layout_mark_ancestors(lv_obj_t * obj)
+{
+    lv_obj_t * parent = obj->parent;
+    while(parent && !parent->child_layout_inv) {
+        parent->child_layout_inv = 1;
+        parent = parent->parent;
+    }
+}
+
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv)
 {
     int16_t angle = lv_obj_get_style_transform_angle(obj, 0);
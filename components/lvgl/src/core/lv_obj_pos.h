@@ -146,6 +146,21 @@ bool lv_obj_is_layout_positioned(const struct _lv_obj_t * obj);
  */
 void lv_obj_mark_layout_as_dirty(struct _lv_obj_t * obj);
 
+/**
+ * Mark the parent of an object for layout update because the size, a layout related style property
+ * or a flag of the object has changed. The layout can reuse the position of the children before `obj`.
+ * @param obj      pointer to an object whose parent needs to be updated
+ */
+void lv_obj_mark_parent_layout_as_dirty(struct _lv_obj_t * obj);
+
+/**
+ * Mark the object for layout update but let the layout reuse the position of the first
+ * `layout_clean_cnt` children. Used when children were removed or reordered and the function doing it
+ * has already limited `layout_clean_cnt` to the children before the first changed index.
+ * @param obj      pointer to an object whose children needs to be updated
+ */
+void _lv_obj_mark_layout_as_dirty_keep_clean(struct _lv_obj_t * obj);
+
 /**
  * Update the layout of an object.
  * @param obj      pointer to an object whose children needs to be updated
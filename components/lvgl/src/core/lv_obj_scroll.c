@@ -36,6 +36,7 @@ static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_anim_ready_cb(lv_anim_t * a);
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en);
+static void get_children_bounds(lv_obj_t * obj, lv_area_t * bounds);
 
 /**********************
  *  STATIC VARIABLES
@@ -135,14 +136,9 @@ lv_coord_t lv_obj_get_scroll_bottom(lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
-    lv_coord_t child_res = LV_COORD_MIN;
-    uint32_t i;
-    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        if(lv_obj_has_flag_any(child,  LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-        child_res = LV_MAX(child_res, child->coords.y2);
-    }
+    lv_area_t bounds;
+    get_children_bounds(obj, &bounds);
+    lv_coord_t child_res = bounds.y2;
 
     lv_coord_t pad_top = lv_obj_get_style_pad_top(obj, LV_PART_MAIN);
     lv_coord_t pad_bottom = lv_obj_get_style_pad_bottom(obj, LV_PART_MAIN);
@@ -176,15 +172,9 @@ lv_coord_t lv_obj_get_scroll_left(lv_obj_t * obj)
 
     lv_coord_t child_res = 0;
 
-    uint32_t i;
-    lv_coord_t x1 = LV_COORD_MAX;
-    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        if(lv_obj_has_flag_any(child,  LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-        x1 = LV_MIN(x1, child->coords.x1);
-
-    }
+    lv_area_t bounds;
+    get_children_bounds(obj, &bounds);
+    lv_coord_t x1 = bounds.x1;
 
     if(x1 != LV_COORD_MAX) {
         child_res = x1;
@@ -213,14 +203,9 @@ lv_coord_t lv_obj_get_scroll_right(lv_obj_t * obj)
     }
 
     /*With other base direction (LTR) scrolling to the right is normal so find the right most coordinate*/
-    lv_coord_t child_res = LV_COORD_MIN;
-    uint32_t i;
-    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        if(lv_obj_has_flag_any(child,  LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-        child_res = LV_MAX(child_res, child->coords.x2);
-    }
+    lv_area_t bounds;
+    get_children_bounds(obj, &bounds);
+    lv_coord_t child_res = bounds.x2;
 
     lv_coord_t pad_right = lv_obj_get_style_pad_right(obj, LV_PART_MAIN);
     lv_coord_t pad_left = lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
@@ -798,3 +783,29 @@ static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_p
     scroll_value->y += anim_en == LV_ANIM_OFF ? 0 : y_scroll;
     lv_obj_scroll_by(parent, x_scroll, y_scroll, anim_en);
 }
+
+/**
+ * Get the bounding box of the not hidden and not floating children
+ * @param obj       pointer to an object
+ * @param bounds    store the result here. `x1/y1` is `LV_COORD_MAX` and `x2/y2` is `LV_COORD_MIN` if there are no children.
+ */
+static void get_children_bounds(lv_obj_t * obj, lv_area_t * bounds)
+{
+    if(_lv_obj_spatial_get_bounds(obj, bounds)) return;
+
+    bounds->x1 = LV_COORD_MAX;
+    bounds->y1 = LV_COORD_MAX;
+    bounds->x2 = LV_COORD_MIN;
+    bounds->y2 = LV_COORD_MIN;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(lv_obj_has_flag_any(child,  LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
+        bounds->x1 = LV_MIN(bounds->x1, child->coords.x1);
+        bounds->y1 = LV_MIN(bounds->y1, child->coords.y1);
+        bounds->x2 = LV_MAX(bounds->x2, child->coords.x2);
+        bounds->y2 = LV_MAX(bounds->y2, child->coords.y2);
+    }
+}
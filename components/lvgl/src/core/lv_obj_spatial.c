@@ -0,0 +1,567 @@
+/**
+ * @file lv_obj_spatial.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &lv_obj_class
+
+/*Children with these flags can be drawn or clicked out of their coordinates so they are checked always*/
+#define OUTLIER_FLAGS   (LV_OBJ_FLAG_FLOATING | LV_OBJ_FLAG_OVERFLOW_VISIBLE)
+
+/*Returned by `entries_insert_sort` if the entries are too far from their sorted position*/
+#define SORT_GAVE_UP    UINT32_MAX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    CHILD_SKIP,         /*Hidden, not visible and can't be clicked*/
+    CHILD_INDEXED,
+    CHILD_OUTLIER,
+} child_type_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_OBJ_SPATIAL_INDEX
+static void spatial_update(lv_obj_t * obj, _lv_obj_spatial_t * sp);
+static void spatial_rebuild(lv_obj_t * obj, _lv_obj_spatial_t * sp);
+static void spatial_normalize(_lv_obj_spatial_t * sp);
+static child_type_t get_child_type(const lv_obj_t * child);
+static void entry_read(_lv_obj_spatial_t * sp, _lv_obj_spatial_entry_t * e, const lv_obj_t * child);
+static uint32_t entries_upper_bound(const _lv_obj_spatial_entry_t * e, uint32_t cnt, int32_t lo);
+static uint32_t entries_insert_sort(_lv_obj_spatial_entry_t * e, uint32_t start, uint32_t cnt, uint32_t budget);
+static bool entries_merge_sort(_lv_obj_spatial_entry_t * e, uint32_t cnt);
+static void entries_refr_hi_max(_lv_obj_spatial_entry_t * e, uint32_t start, uint32_t cnt);
+static void entries_refr_cross(_lv_obj_spatial_t * sp);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_obj_enable_spatial_index(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+#if LV_OBJ_SPATIAL_INDEX
+    if(!en) {
+        _lv_obj_spatial_free(obj);
+        return;
+    }
+
+    lv_obj_allocate_spec_attr(obj);
+    if(obj->spec_attr->spatial) return;
+
+    _lv_obj_spatial_t * sp = lv_mem_alloc(sizeof(_lv_obj_spatial_t));
+    LV_ASSERT_MALLOC(sp);
+    if(sp == NULL) return;
+
+    lv_memset_00(sp, sizeof(_lv_obj_spatial_t));
+    lv_vec_init(&sp->entries, sizeof(_lv_obj_spatial_entry_t));
+    lv_vec_init(&sp->outliers, sizeof(uint32_t));
+    sp->rebuild = 1;
+    obj->spec_attr->spatial = sp;
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(en);
+    LV_LOG_WARN("LV_OBJ_SPATIAL_INDEX is not enabled");
+#endif
+}
+
+bool lv_obj_is_spatial_index_enabled(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+#if LV_OBJ_SPATIAL_INDEX
+    return obj->spec_attr && obj->spec_attr->spatial;
+#else
+    LV_UNUSED(obj);
+    return false;
+#endif
+}
+
+#if LV_OBJ_SPATIAL_INDEX
+
+void _lv_obj_spatial_free(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->spatial == NULL) return;
+
+    _lv_obj_spatial_t * sp = obj->spec_attr->spatial;
+    lv_vec_clear(&sp->entries);
+    lv_vec_clear(&sp->outliers);
+    lv_mem_free(sp);
+    obj->spec_attr->spatial = NULL;
+}
+
+void _lv_obj_spatial_invalidate(lv_obj_t * obj)
+{
+    if(obj == NULL || obj->spec_attr == NULL || obj->spec_attr->spatial == NULL) return;
+
+    _lv_obj_spatial_t * sp = obj->spec_attr->spatial;
+    sp->rebuild = 1;
+    lv_vec_reset(&sp->entries);
+    lv_vec_reset(&sp->outliers);
+}
+
+void _lv_obj_spatial_child_added(lv_obj_t * obj)
+{
+    _lv_obj_spatial_t * sp = obj->spec_attr->spatial;
+    if(sp == NULL || sp->rebuild) return;
+
+    /*Add it as a dirty entry. It's read from the child and sorted on the next use.*/
+    _lv_obj_spatial_entry_t * e = lv_vec_push(&sp->entries);
+    if(e == NULL) {
+        _lv_obj_spatial_invalidate(obj);
+        return;
+    }
+
+    e->id = obj->spec_attr->child_cnt - 1;
+    e->cross_lo = LV_COORD_MAX;
+    e->cross_hi = LV_COORD_MIN;
+    sp->dirty_pos = LV_MIN(sp->dirty_pos, sp->entries.cnt - 1);
+}
+
+void _lv_obj_spatial_child_removed(lv_obj_t * obj, uint32_t id)
+{
+    _lv_obj_spatial_t * sp = obj->spec_attr->spatial;
+    if(sp == NULL || sp->rebuild) return;
+
+    /*Remove the entry of the child and shift the index of the next children*/
+    _lv_obj_spatial_entry_t * e = (_lv_obj_spatial_entry_t *)sp->entries.data;
+    uint32_t cnt = sp->entries.cnt;
+    uint32_t pos = cnt;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        if(e[i].id > id) e[i].id--;
+        else if(e[i].id == id) pos = i;
+    }
+
+    if(pos < cnt) {
+        if(e[pos].cross_lo == sp->cross_min || e[pos].cross_hi == sp->cross_max) sp->cross_inv = 1;
+        lv_vec_remove(&sp->entries, pos);
+        if(pos < sp->dirty_pos) {
+            sp->dirty_pos--;
+            entries_refr_hi_max(e, pos, sp->dirty_pos);
+        }
+        return;
+    }
+
+    uint32_t * outliers = (uint32_t *)sp->outliers.data;
+    pos = sp->outliers.cnt;
+    for(i = 0; i < sp->outliers.cnt; i++) {
+        if(outliers[i] > id) outliers[i]--;
+        else if(outliers[i] == id) pos = i;
+    }
+    if(pos < sp->outliers.cnt) lv_vec_remove(&sp->outliers, pos);
+}
+
+void _lv_obj_spatial_child_moved(lv_obj_t * obj, const lv_area_t * ori)
+{
+    lv_obj_t * parent = obj->parent;
+    if(parent == NULL || parent->spec_attr == NULL) return;
+
+    _lv_obj_spatial_t * sp = parent->spec_attr->spatial;
+    if(sp == NULL || sp->rebuild) return;
+
+    /*Find the entry of the child by its original position among the up-to-date entries.
+     *If it's not there it's already dirty or not indexed.*/
+    _lv_obj_spatial_entry_t * e = (_lv_obj_spatial_entry_t *)sp->entries.data;
+    int32_t lo = sp->hor ? ori->x1 - sp->ofs_x : ori->y1 - sp->ofs_y;
+    uint32_t pos = entries_upper_bound(e, sp->dirty_pos, lo - 1);
+    for(; pos < sp->dirty_pos && e[pos].lo == lo; pos++) {
+        if(parent->spec_attr->children[e[pos].id] == obj) {
+            sp->dirty_pos = pos;
+            return;
+        }
+    }
+}
+
+void _lv_obj_spatial_children_moved(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->spatial == NULL) return;
+
+    obj->spec_attr->spatial->ofs_x += x_diff;
+    obj->spec_attr->spatial->ofs_y += y_diff;
+}
+
+bool _lv_obj_spatial_iter_init(lv_obj_t * obj, const lv_area_t * area, _lv_obj_spatial_iter_t * it)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->spatial == NULL) return false;
+
+    _lv_obj_spatial_t * sp = obj->spec_attr->spatial;
+    spatial_update(obj, sp);
+    if(sp->rebuild) return false;   /*Out of memory*/
+
+    /*Convert the area to the frame of the entries and increase it to find the children
+     *whose ext. click or draw area is on it*/
+    int32_t ofs_main = sp->hor ? sp->ofs_x : sp->ofs_y;
+    int32_t ofs_cross = sp->hor ? sp->ofs_y : sp->ofs_x;
+    it->obj = obj;
+    it->lo = (sp->hor ? area->x1 : area->y1) - ofs_main - sp->ext;
+    it->hi = (sp->hor ? area->x2 : area->y2) - ofs_main + sp->ext;
+    it->cross_lo = (sp->hor ? area->y1 : area->x1) - ofs_cross - sp->ext;
+    it->cross_hi = (sp->hor ? area->y2 : area->x2) - ofs_cross + sp->ext;
+
+    /*Start from the last entry which starts before the end of the area and go backward*/
+    it->pos = entries_upper_bound((_lv_obj_spatial_entry_t *)sp->entries.data, sp->entries.cnt, it->hi);
+    it->outlier_pos = 0;
+    return true;
+}
+
+lv_obj_t * _lv_obj_spatial_iter_next(_lv_obj_spatial_iter_t * it, uint32_t * id)
+{
+    _lv_obj_spatial_t * sp = it->obj->spec_attr->spatial;
+    lv_obj_t ** children = it->obj->spec_attr->children;
+    _lv_obj_spatial_entry_t * e = (_lv_obj_spatial_entry_t *)sp->entries.data;
+
+    while(it->pos > 0) {
+        it->pos--;
+        /*This and the previous entries all end before the area*/
+        if(e[it->pos].hi_max < it->lo) {
+            it->pos = 0;
+            break;
+        }
+
+        if(e[it->pos].hi < it->lo) continue;
+        if(e[it->pos].cross_hi < it->cross_lo || e[it->pos].cross_lo > it->cross_hi) continue;
+
+        *id = e[it->pos].id;
+        return children[*id];
+    }
+
+    if(it->outlier_pos < sp->outliers.cnt) {
+        *id = ((uint32_t *)sp->outliers.data)[it->outlier_pos];
+        it->outlier_pos++;
+        return children[*id];
+    }
+
+    return NULL;
+}
+
+bool _lv_obj_spatial_get_bounds(lv_obj_t * obj, lv_area_t * bounds)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->spatial == NULL) return false;
+
+    _lv_obj_spatial_t * sp = obj->spec_attr->spatial;
+    spatial_update(obj, sp);
+    if(sp->rebuild) return false;   /*Out of memory*/
+
+    bounds->x1 = LV_COORD_MAX;
+    bounds->y1 = LV_COORD_MAX;
+    bounds->x2 = LV_COORD_MIN;
+    bounds->y2 = LV_COORD_MIN;
+
+    uint32_t cnt = sp->entries.cnt;
+    if(cnt) {
+        _lv_obj_spatial_entry_t * e = (_lv_obj_spatial_entry_t *)sp->entries.data;
+        if(sp->hor) {
+            bounds->x1 = e[0].lo + sp->ofs_x;
+            bounds->x2 = e[cnt - 1].hi_max + sp->ofs_x;
+            bounds->y1 = sp->cross_min + sp->ofs_y;
+            bounds->y2 = sp->cross_max + sp->ofs_y;
+        }
+        else {
+            bounds->y1 = e[0].lo + sp->ofs_y;
+            bounds->y2 = e[cnt - 1].hi_max + sp->ofs_y;
+            bounds->x1 = sp->cross_min + sp->ofs_x;
+            bounds->x2 = sp->cross_max + sp->ofs_x;
+        }
+    }
+
+    uint32_t i;
+    for(i = 0; i < sp->outliers.cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[((uint32_t *)sp->outliers.data)[i]];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) continue;
+        bounds->x1 = LV_MIN(bounds->x1, child->coords.x1);
+        bounds->y1 = LV_MIN(bounds->y1, child->coords.y1);
+        bounds->x2 = LV_MAX(bounds->x2, child->coords.x2);
+        bounds->y2 = LV_MAX(bounds->y2, child->coords.y2);
+    }
+
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Bring the entries up to date: read the dirty entries from their child and sort them into place
+ */
+static void spatial_update(lv_obj_t * obj, _lv_obj_spatial_t * sp)
+{
+    if(sp->rebuild) {
+        spatial_rebuild(obj, sp);
+        return;
+    }
+
+    if(LV_ABS(sp->ofs_x) > LV_COORD_MAX || LV_ABS(sp->ofs_y) > LV_COORD_MAX) spatial_normalize(sp);
+
+    uint32_t cnt = sp->entries.cnt;
+    uint32_t start = sp->dirty_pos;
+    if(start >= cnt) return;
+
+    _lv_obj_spatial_entry_t * e = (_lv_obj_spatial_entry_t *)sp->entries.data;
+    lv_obj_t ** children = obj->spec_attr->children;
+    uint32_t i;
+    for(i = start; i < cnt; i++) {
+        lv_obj_t * child = children[e[i].id];
+        /*E.g. a new child's flags were set directly*/
+        if(get_child_type(child) != CHILD_INDEXED) {
+            spatial_rebuild(obj, sp);
+            return;
+        }
+
+        /*If the child was on the edge the cross bounds might shrink*/
+        if(e[i].cross_lo == sp->cross_min || e[i].cross_hi == sp->cross_max) sp->cross_inv = 1;
+        entry_read(sp, &e[i], child);
+        if(!sp->cross_inv) {
+            sp->cross_min = LV_MIN(sp->cross_min, e[i].cross_lo);
+            sp->cross_max = LV_MAX(sp->cross_max, e[i].cross_hi);
+        }
+    }
+
+    /*Typically the children move together and only a few entries needs to be moved.
+     *If the order changed a lot sort all the entries instead.*/
+    uint32_t first = entries_insert_sort(e, start, cnt, 8 * (cnt - start) + 64);
+    if(first == SORT_GAVE_UP) {
+        if(!entries_merge_sort(e, cnt)) entries_insert_sort(e, 0, cnt, UINT32_MAX);
+        first = 0;
+    }
+
+    entries_refr_hi_max(e, first, cnt);
+    if(sp->cross_inv) entries_refr_cross(sp);
+    sp->dirty_pos = cnt;
+}
+
+/**
+ * Create all the entries from the children of the object
+ */
+static void spatial_rebuild(lv_obj_t * obj, _lv_obj_spatial_t * sp)
+{
+    lv_vec_reset(&sp->entries);
+    lv_vec_reset(&sp->outliers);
+    sp->ofs_x = 0;
+    sp->ofs_y = 0;
+    sp->ext = 0;
+    sp->rebuild = 1;
+
+    /*Index along the axis on which the children are spread more*/
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    uint32_t indexed_cnt = 0;
+    uint32_t outlier_cnt = 0;
+    lv_area_t bounds = {LV_COORD_MAX, LV_COORD_MAX, LV_COORD_MIN, LV_COORD_MIN};
+    uint32_t i;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        child_type_t type = get_child_type(child);
+        if(type == CHILD_OUTLIER) outlier_cnt++;
+        if(type != CHILD_INDEXED) continue;
+
+        indexed_cnt++;
+        bounds.x1 = LV_MIN(bounds.x1, child->coords.x1);
+        bounds.y1 = LV_MIN(bounds.y1, child->coords.y1);
+        bounds.x2 = LV_MAX(bounds.x2, child->coords.x2);
+        bounds.y2 = LV_MAX(bounds.y2, child->coords.y2);
+    }
+    sp->hor = indexed_cnt && lv_area_get_width(&bounds) > lv_area_get_height(&bounds);
+
+    if(!lv_vec_reserve(&sp->entries, indexed_cnt)) return;
+    if(!lv_vec_reserve(&sp->outliers, outlier_cnt)) return;
+
+    bool sorted = true;
+    _lv_obj_spatial_entry_t * e = (_lv_obj_spatial_entry_t *)sp->entries.data;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        child_type_t type = get_child_type(child);
+        if(type == CHILD_OUTLIER) {
+            *(uint32_t *)lv_vec_push(&sp->outliers) = i;
+        }
+        else if(type == CHILD_INDEXED) {
+            uint32_t pos = sp->entries.cnt;
+            lv_vec_push(&sp->entries);
+            e[pos].id = i;
+            entry_read(sp, &e[pos], child);
+            if(pos > 0 && e[pos - 1].lo > e[pos].lo) sorted = false;
+        }
+    }
+
+    if(!sorted && !entries_merge_sort(e, indexed_cnt)) entries_insert_sort(e, 0, indexed_cnt, UINT32_MAX);
+
+    entries_refr_hi_max(e, 0, indexed_cnt);
+    entries_refr_cross(sp);
+    sp->dirty_pos = indexed_cnt;
+    sp->rebuild = 0;
+}
+
+/**
+ * Add the offset to the entries to keep them in the range of `lv_coord_t` if the children were scrolled a lot
+ */
+static void spatial_normalize(_lv_obj_spatial_t * sp)
+{
+    int32_t ofs_main = sp->hor ? sp->ofs_x : sp->ofs_y;
+    int32_t ofs_cross = sp->hor ? sp->ofs_y : sp->ofs_x;
+    _lv_obj_spatial_entry_t * e = (_lv_obj_spatial_entry_t *)sp->entries.data;
+    uint32_t i;
+    for(i = 0; i < sp->entries.cnt; i++) {
+        e[i].lo += ofs_main;
+        e[i].hi += ofs_main;
+        e[i].hi_max += ofs_main;
+        e[i].cross_lo += ofs_cross;
+        e[i].cross_hi += ofs_cross;
+    }
+    sp->cross_min += ofs_cross;
+    sp->cross_max += ofs_cross;
+    sp->ofs_x = 0;
+    sp->ofs_y = 0;
+}
+
+static child_type_t get_child_type(const lv_obj_t * child)
+{
+    if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) return CHILD_SKIP;
+    if(lv_obj_has_flag_any(child, OUTLIER_FLAGS)) return CHILD_OUTLIER;
+    if(_lv_obj_get_layer_type(child) == LV_LAYER_TYPE_TRANSFORM) return CHILD_OUTLIER;
+    return CHILD_INDEXED;
+}
+
+static void entry_read(_lv_obj_spatial_t * sp, _lv_obj_spatial_entry_t * e, const lv_obj_t * child)
+{
+    const lv_area_t * a = &child->coords;
+    if(sp->hor) {
+        e->lo = a->x1 - sp->ofs_x;
+        e->hi = a->x2 - sp->ofs_x;
+        e->cross_lo = a->y1 - sp->ofs_y;
+        e->cross_hi = a->y2 - sp->ofs_y;
+    }
+    else {
+        e->lo = a->y1 - sp->ofs_y;
+        e->hi = a->y2 - sp->ofs_y;
+        e->cross_lo = a->x1 - sp->ofs_x;
+        e->cross_hi = a->x2 - sp->ofs_x;
+    }
+
+    if(child->spec_attr) {
+        sp->ext = LV_MAX(sp->ext, child->spec_attr->ext_draw_size);
+        sp->ext = LV_MAX(sp->ext, child->spec_attr->ext_click_pad);
+    }
+}
+
+/**
+ * Get the position of the first entry whose `lo` is greater than a value
+ */
+static uint32_t entries_upper_bound(const _lv_obj_spatial_entry_t * e, uint32_t cnt, int32_t lo)
+{
+    uint32_t min = 0;
+    uint32_t max = cnt;
+    while(min < max) {
+        uint32_t mid = (min + max) / 2;
+        if(e[mid].lo <= lo) min = mid + 1;
+        else max = mid;
+    }
+    return min;
+}
+
+/**
+ * Insert the entries from `start` into their place among the sorted previous entries
+ * @return the first position which was changed or `SORT_GAVE_UP` if more than `budget` entries were moved.
+ *         The entries are still valid but not sorted in this case.
+ */
+static uint32_t entries_insert_sort(_lv_obj_spatial_entry_t * e, uint32_t start, uint32_t cnt, uint32_t budget)
+{
+    uint32_t first = start;
+    uint32_t moved = 0;
+    uint32_t i;
+    for(i = LV_MAX(start, 1); i < cnt; i++) {
+        if(e[i - 1].lo <= e[i].lo) continue;
+
+        _lv_obj_spatial_entry_t tmp = e[i];
+        uint32_t j = i;
+        while(j > 0 && e[j - 1].lo > tmp.lo) {
+            e[j] = e[j - 1];
+            j--;
+        }
+        e[j] = tmp;
+
+        first = LV_MIN(first, j);
+        moved += i - j;
+        if(moved > budget) return SORT_GAVE_UP;
+    }
+
+    return first;
+}
+
+/**
+ * Sort the entries by `lo` with a bottom-up merge sort
+ * @return false: out of memory, nothing happened
+ */
+static bool entries_merge_sort(_lv_obj_spatial_entry_t * e, uint32_t cnt)
+{
+    _lv_obj_spatial_entry_t * tmp = lv_mem_alloc(cnt * sizeof(_lv_obj_spatial_entry_t));
+    if(tmp == NULL) return false;
+
+    _lv_obj_spatial_entry_t * src = e;
+    _lv_obj_spatial_entry_t * dst = tmp;
+    uint32_t w;
+    for(w = 1; w < cnt; w *= 2) {
+        uint32_t start;
+        for(start = 0; start < cnt; start += 2 * w) {
+            uint32_t mid = LV_MIN(start + w, cnt);
+            uint32_t end = LV_MIN(start + 2 * w, cnt);
+            uint32_t a = start;
+            uint32_t b = mid;
+            uint32_t d = start;
+            while(a < mid && b < end) dst[d++] = src[b].lo < src[a].lo ? src[b++] : src[a++];
+            while(a < mid) dst[d++] = src[a++];
+            while(b < end) dst[d++] = src[b++];
+        }
+        _lv_obj_spatial_entry_t * t = src;
+        src = dst;
+        dst = t;
+    }
+
+    if(src != e) lv_memcpy(e, src, cnt * sizeof(_lv_obj_spatial_entry_t));
+    lv_mem_free(tmp);
+    return true;
+}
+
+static void entries_refr_hi_max(_lv_obj_spatial_entry_t * e, uint32_t start, uint32_t cnt)
+{
+    lv_coord_t hi_max = start > 0 ? e[start - 1].hi_max : LV_COORD_MIN;
+    uint32_t i;
+    for(i = start; i < cnt; i++) {
+        hi_max = LV_MAX(hi_max, e[i].hi);
+        e[i].hi_max = hi_max;
+    }
+}
+
+static void entries_refr_cross(_lv_obj_spatial_t * sp)
+{
+    _lv_obj_spatial_entry_t * e = (_lv_obj_spatial_entry_t *)sp->entries.data;
+    sp->cross_min = LV_COORD_MAX;
+    sp->cross_max = LV_COORD_MIN;
+    uint32_t i;
+    for(i = 0; i < sp->entries.cnt; i++) {
+        sp->cross_min = LV_MIN(sp->cross_min, e[i].cross_lo);
+        sp->cross_max = LV_MAX(sp->cross_max, e[i].cross_hi);
+    }
+    sp->cross_inv = 0;
+}
+
+#endif /*LV_OBJ_SPATIAL_INDEX*/
@@ -0,0 +1,240 @@
+/**
+ * @file lv_obj_spatial.h
+ *
+ */
+
+#ifndef LV_OBJ_SPATIAL_H
+#define LV_OBJ_SPATIAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../misc/lv_area.h"
+#include "../misc/lv_types.h"
+#include "../misc/lv_vec.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Can't include lv_obj.h because it includes this header file*/
+struct _lv_obj_t;
+
+/**
+ * A child in the spatial index. The coordinates are stored on the main and cross axis of the index,
+ * relative to the `ofs_x/y` of the index.
+ */
+typedef struct {
+    lv_coord_t lo;          /**< Start of the child on the main axis*/
+    lv_coord_t hi;          /**< End of the child on the main axis*/
+    lv_coord_t hi_max;      /**< The largest `hi` of this and all the previous entries*/
+    lv_coord_t cross_lo;    /**< Start of the child on the cross axis*/
+    lv_coord_t cross_hi;    /**< End of the child on the cross axis*/
+    uint32_t id;            /**< Index of the child in its parent*/
+} _lv_obj_spatial_entry_t;
+
+/**
+ * Spatial index of the children of an object.
+ * The children are sorted by their start coordinate on the main axis (Y or X), so the children on an area
+ * can be found by binary search instead of checking all of them.
+ */
+typedef struct _lv_obj_spatial_t {
+    lv_vec_t entries;           /**< `_lv_obj_spatial_entry_t`s sorted by `lo`*/
+    lv_vec_t outliers;          /**< Index (`uint32_t`) of the children which can't be indexed and are checked always*/
+    int32_t ofs_x;              /**< The children were moved by this much since the entries were updated*/
+    int32_t ofs_y;
+    lv_coord_t ext;             /**< The largest extra click or draw size of the indexed children*/
+    lv_coord_t cross_min;       /**< The smallest `cross_lo` of the entries*/
+    lv_coord_t cross_max;       /**< The largest `cross_hi` of the entries*/
+    uint32_t dirty_pos;         /**< The entries from this position have to be updated from their child*/
+    uint8_t hor : 1;            /**< 1: the main axis is X; 0: Y*/
+    uint8_t rebuild : 1;        /**< 1: the entries have to be created again*/
+    uint8_t cross_inv : 1;      /**< 1: `cross_min/max` have to be calculated again*/
+} _lv_obj_spatial_t;
+
+/**
+ * Iterator over the children which might be on an area
+ */
+typedef struct {
+    struct _lv_obj_t * obj;
+    int32_t lo;
+    int32_t hi;
+    int32_t cross_lo;
+    int32_t cross_hi;
+    uint32_t pos;
+    uint32_t outlier_pos;
+} _lv_obj_spatial_iter_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Enable or disable the spatial index of an object's children.
+ * With the index hit testing, redrawing and the scroll range calculation check only
+ * the children which are close to the given point or area instead of all the children.
+ * It's useful for objects with hundreds of children, e.g. long lists.
+ * The index is updated when the children are moved, resized, added, deleted or hidden.
+ * @param obj       pointer to an object
+ * @param en        true: enable the index; false: disable it and free its memory
+ */
+void lv_obj_enable_spatial_index(struct _lv_obj_t * obj, bool en);
+
+/**
+ * Tell whether the children of an object are in a spatial index
+ * @param obj       pointer to an object
+ * @return          true: the spatial index is enabled
+ */
+bool lv_obj_is_spatial_index_enabled(const struct _lv_obj_t * obj);
+
+#if LV_OBJ_SPATIAL_INDEX
+
+/**
+ * Free the spatial index of an object
+ * @param obj       pointer to an object
+ */
+void _lv_obj_spatial_free(struct _lv_obj_t * obj);
+
+/**
+ * Create the spatial index of an object again on the next use,
+ * e.g. because the order of the children changed or a child was hidden.
+ * @param obj       pointer to an object or NULL
+ */
+void _lv_obj_spatial_invalidate(struct _lv_obj_t * obj);
+
+/**
+ * Add the last child of an object to its spatial index
+ * @param obj       pointer to an object
+ */
+void _lv_obj_spatial_child_added(struct _lv_obj_t * obj);
+
+/**
+ * Remove a child from the spatial index of an object.
+ * Call it when the child is already removed from `children` of the object.
+ * @param obj       pointer to an object
+ * @param id        index of the removed child
+ */
+void _lv_obj_spatial_child_removed(struct _lv_obj_t * obj, uint32_t id);
+
+/**
+ * Update the spatial index of the parent when an object's coordinates, extra click or draw size changed.
+ * Moving all the children of an object together is handled by `_lv_obj_spatial_children_moved`.
+ * @param obj       pointer to an object
+ * @param ori       the coordinates of the object before the change
+ */
+void _lv_obj_spatial_child_moved(struct _lv_obj_t * obj, const lv_area_t * ori);
+
+/**
+ * Update the spatial index of an object when all its children are moved by the same amount (e.g. scrolled)
+ * @param obj       pointer to an object
+ * @param x_diff    horizontal movement
+ * @param y_diff    vertical movement
+ */
+void _lv_obj_spatial_children_moved(struct _lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff);
+
+/**
+ * Start iterating over the not hidden children of an object which might be on an area.
+ * @param obj       pointer to an object
+ * @param area      the area in absolute coordinates
+ * @param it        pointer to an iterator to initialize
+ * @return          true: the iterator can be used;
+ *                  false: the object has no spatial index so all of its children should be checked
+ */
+bool _lv_obj_spatial_iter_init(struct _lv_obj_t * obj, const lv_area_t * area, _lv_obj_spatial_iter_t * it);
+
+/**
+ * Get the next child of an iterator. The children are NOT returned in the order of their index.
+ * Hidden children are skipped, the returned children still need to be checked precisely.
+ * @param it        pointer to an iterator
+ * @param id        store the index of the child here
+ * @return          the next child or NULL if there are no more children
+ */
+struct _lv_obj_t * _lv_obj_spatial_iter_next(_lv_obj_spatial_iter_t * it, uint32_t * id);
+
+/**
+ * Get the bounding box of the not hidden and not floating children of an object
+ * @param obj       pointer to an object
+ * @param bounds    store the bounding box here.
+ *                  If there are no such children `x1/y1` will be `LV_COORD_MAX` and `x2/y2` `LV_COORD_MIN`.
+ * @return          true: `bounds` is set; false: the object has no spatial index
+ */
+bool _lv_obj_spatial_get_bounds(struct _lv_obj_t * obj, lv_area_t * bounds);
+
+#else
+
+static inline void _lv_obj_spatial_free(struct _lv_obj_t * obj)
+{
+    LV_UNUSED(obj);
+}
+
+static inline void _lv_obj_spatial_invalidate(struct _lv_obj_t * obj)
+{
+    LV_UNUSED(obj);
+}
+
+static inline void _lv_obj_spatial_child_added(struct _lv_obj_t * obj)
+{
+    LV_UNUSED(obj);
+}
+
+static inline void _lv_obj_spatial_child_removed(struct _lv_obj_t * obj, uint32_t id)
+{
+    LV_UNUSED(obj);
+    LV_UNUSED(id);
+}
+
+static inline void _lv_obj_spatial_child_moved(struct _lv_obj_t * obj, const lv_area_t * ori)
+{
+    LV_UNUSED(obj);
+    LV_UNUSED(ori);
+}
+
+static inline void _lv_obj_spatial_children_moved(struct _lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff)
+{
+    LV_UNUSED(obj);
+    LV_UNUSED(x_diff);
+    LV_UNUSED(y_diff);
+}
+
+static inline bool _lv_obj_spatial_iter_init(struct _lv_obj_t * obj, const lv_area_t * area,
+                                             _lv_obj_spatial_iter_t * it)
+{
+    LV_UNUSED(obj);
+    LV_UNUSED(area);
+    LV_UNUSED(it);
+    return false;
+}
+
+static inline struct _lv_obj_t * _lv_obj_spatial_iter_next(_lv_obj_spatial_iter_t * it, uint32_t * id)
+{
+    LV_UNUSED(it);
+    LV_UNUSED(id);
+    return NULL;
+}
+
+static inline bool _lv_obj_spatial_get_bounds(struct _lv_obj_t * obj, lv_area_t * bounds)
+{
+    LV_UNUSED(obj);
+    LV_UNUSED(bounds);
+    return false;
+}
+
+#endif /*LV_OBJ_SPATIAL_INDEX*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_SPATIAL_H*/
@@ -35,6 +35,16 @@ typedef enum {
     CACHE_NEED_CHECK = 4,
 } cache_t;
 
+#if LV_OBJ_STYLE_CACHE
+typedef struct {
+    const lv_obj_t * obj;
+    lv_style_value_t value;
+    uint32_t gen;           /*The `_lv_style_cache_gen` when the value was stored. Older values are invalid*/
+    lv_style_prop_t prop;
+    uint8_t part;           /*The part shifted to the [0..255] range*/
+} style_cache_entry_t;
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -44,7 +54,11 @@ typedef enum {
  **********************/
 static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
 static _lv_obj_style_t * get_trans_style(lv_obj_t * obj, uint32_t part);
+static lv_style_value_t get_prop_resolved(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
+#if LV_OBJ_STYLE_CACHE
+static style_cache_entry_t * style_cache_get_entry(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
+#endif
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
@@ -60,6 +74,10 @@ static void fade_in_anim_ready(lv_anim_t * a);
  **********************/
 static bool style_refr = true;
 
+#if LV_OBJ_STYLE_CACHE
+static style_cache_entry_t style_cache[LV_OBJ_STYLE_CACHE_SIZE];
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -71,6 +89,7 @@ static bool style_refr = true;
 void _lv_obj_style_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_trans_ll), sizeof(trans_t));
+    _lv_style_cache_invalidate();
 }
 
 void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector)
@@ -100,6 +119,7 @@ void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t se
     obj->styles[i].style = style;
     obj->styles[i].selector = selector;
 
+    _lv_style_cache_invalidate();
     lv_obj_refresh_style(obj, selector, LV_STYLE_PROP_ANY);
 }
 
@@ -142,6 +162,7 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
         obj->styles = lv_mem_realloc(obj->styles, obj->style_cnt * sizeof(_lv_obj_style_t));
 
         deleted = true;
+        _lv_style_cache_invalidate();
         /*The style from the current `i` index is removed, so `i` points to the next style.
          *Therefore it doesn't needs to be incremented*/
     }
@@ -152,6 +173,7 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+    _lv_style_cache_invalidate();
     if(!style_refr) return;
     lv_disp_t * d = lv_disp_get_next(NULL);
 
@@ -168,10 +190,9 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    _lv_style_cache_invalidate();
     if(!style_refr) return;
 
-    lv_obj_invalidate(obj);
-
     lv_part_t part = lv_obj_style_get_selector_part(selector);
 
     bool is_layout_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_LAYOUT_REFR);
@@ -179,6 +200,18 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
     bool is_layer_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_LAYER_REFR);
 
+    /*The opacity and transformation of the layer are applied when the cached bitmap is drawn
+     *and the position doesn't change the look*/
+    bool bitmap_valid = false;
+    if((part == LV_PART_ANY || part == LV_PART_MAIN) && _lv_obj_bitmap_cache_is_valid(obj)) {
+        bitmap_valid = (prop != LV_STYLE_PROP_ANY && is_layer_refr) ||
+                       prop == LV_STYLE_X || prop == LV_STYLE_Y || prop == LV_STYLE_ALIGN ||
+                       prop == LV_STYLE_TRANSLATE_X || prop == LV_STYLE_TRANSLATE_Y ||
+                       prop == LV_STYLE_TRANSFORM_PIVOT_X || prop == LV_STYLE_TRANSFORM_PIVOT_Y;
+    }
+
+    lv_obj_invalidate(obj);
+
     if(is_layout_refr) {
         if(part == LV_PART_ANY ||
            part == LV_PART_MAIN ||
@@ -189,13 +222,16 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
         }
     }
     if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop == LV_STYLE_PROP_ANY || is_layout_refr)) {
-        lv_obj_t * parent = lv_obj_get_parent(obj);
-        if(parent) lv_obj_mark_layout_as_dirty(parent);
+        lv_obj_mark_parent_layout_as_dirty(obj);
     }
 
     /*Cache the layer type*/
     if((part == LV_PART_ANY || part == LV_PART_MAIN) && is_layer_refr) {
         lv_layer_type_t layer_type = calculate_layer_type(obj);
+        /*Transformed children are not in the spatial index of the parent*/
+        if((layer_type == LV_LAYER_TYPE_TRANSFORM) != (_lv_obj_get_layer_type(obj) == LV_LAYER_TYPE_TRANSFORM)) {
+            _lv_obj_spatial_invalidate(lv_obj_get_parent(obj));
+        }
         if(obj->spec_attr) obj->spec_attr->layer_type = layer_type;
         else if(layer_type != LV_LAYER_TYPE_NONE) {
             lv_obj_allocate_spec_attr(obj);
@@ -213,6 +249,10 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
             refresh_children_style(obj);
         }
     }
+
+    /*The children might use the inherited value in their cached bitmaps*/
+    if(prop == LV_STYLE_PROP_ANY || is_inheritable) _lv_obj_bitmap_cache_invalidate_children(obj);
+    if(bitmap_valid) _lv_obj_bitmap_cache_set_valid(obj);
 }
 
 void lv_obj_enable_style_refresh(bool en)
@@ -222,49 +262,23 @@ void lv_obj_enable_style_refresh(bool en)
 
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
-    lv_style_value_t value_act;
-    bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
-    lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
-    while(obj) {
-        found = get_prop_core(obj, part, prop, &value_act);
-        if(found == LV_STYLE_RES_FOUND) break;
-        if(!inheritable) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(found != LV_STYLE_RES_INHERIT && part != LV_PART_MAIN) {
-            part = LV_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        obj = lv_obj_get_parent(obj);
-    }
-
-    if(found != LV_STYLE_RES_FOUND) {
-        if(part == LV_PART_MAIN && (prop == LV_STYLE_WIDTH || prop == LV_STYLE_HEIGHT)) {
-            const lv_obj_class_t * cls = obj->class_p;
-            while(cls) {
-                if(prop == LV_STYLE_WIDTH) {
-                    if(cls->width_def != 0) break;
-                }
-                else {
-                    if(cls->height_def != 0) break;
-                }
-                cls = cls->base_class;
-            }
-
-            if(cls) {
-                value_act.num = prop == LV_STYLE_WIDTH ? cls->width_def : cls->height_def;
-            }
-            else {
-                value_act.num = 0;
-            }
-        }
-        else {
-            value_act = lv_style_prop_get_default(prop);
-        }
-    }
-    return value_act;
+#if LV_OBJ_STYLE_CACHE
+    /*The transitions are skipped and `part` has state bits only temporarily so don't cache these values*/
+    if(obj->skip_trans || part != lv_obj_style_get_selector_part(part)) return get_prop_resolved(obj, part, prop);
+
+    extern uint32_t _lv_style_cache_gen;
+    style_cache_entry_t * entry = style_cache_get_entry(obj, part, prop);
+    if(entry->obj != obj || entry->prop != prop || entry->part != (part >> 16) || entry->gen != _lv_style_cache_gen) {
+        entry->value = get_prop_resolved(obj, part, prop);
+        entry->obj = obj;
+        entry->prop = prop;
+        entry->part = part >> 16;
+        entry->gen = _lv_style_cache_gen;
+    }
+    return entry->value;
+#else
+    return get_prop_resolved(obj, part, prop);
+#endif
 }
 
 void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_value_t value,
@@ -339,6 +353,7 @@ void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t
     obj->state = prev_state;
     v1 = lv_obj_get_style_prop(obj, part, tr_dsc->prop);
     obj->state = new_state;
+    _lv_style_cache_invalidate();   /*`v1` was cached with the previous state*/
 
     _lv_obj_style_t * style_trans = get_trans_style(obj, part);
     lv_style_set_prop(style_trans->style, tr_dsc->prop, v1);   /*Be sure `trans_style` has a valid value*/
@@ -603,6 +618,61 @@ static _lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t se
 }
 
 
+/**
+ * Get the value of a style property from the styles of the object, considering the inheritance and
+ * the default values too.
+ * @param obj   pointer to an object
+ * @param part  a part of the object
+ * @param prop  the property to get
+ * @return      the resolved value of the property
+ */
+static lv_style_value_t get_prop_resolved(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    lv_style_value_t value_act;
+    bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
+    lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
+    while(obj) {
+        found = get_prop_core(obj, part, prop, &value_act);
+        if(found == LV_STYLE_RES_FOUND) break;
+        if(!inheritable) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(found != LV_STYLE_RES_INHERIT && part != LV_PART_MAIN) {
+            part = LV_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        obj = lv_obj_get_parent(obj);
+    }
+
+    if(found != LV_STYLE_RES_FOUND) {
+        if(part == LV_PART_MAIN && (prop == LV_STYLE_WIDTH || prop == LV_STYLE_HEIGHT)) {
+            const lv_obj_class_t * cls = obj->class_p;
+            while(cls) {
+                if(prop == LV_STYLE_WIDTH) {
+                    if(cls->width_def != 0) break;
+                }
+                else {
+                    if(cls->height_def != 0) break;
+                }
+                cls = cls->base_class;
+            }
+
+            if(cls) {
+                value_act.num = prop == LV_STYLE_WIDTH ? cls->width_def : cls->height_def;
+            }
+            else {
+                value_act.num = 0;
+            }
+        }
+        else {
+            value_act = lv_style_prop_get_default(prop);
+        }
+    }
+    return value_act;
+}
+
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v)
 {
     uint8_t group = 1 << _lv_style_get_prop_group(prop);
@@ -670,6 +740,23 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_sty
     else return LV_STYLE_RES_NOT_FOUND;
 }
 
+#if LV_OBJ_STYLE_CACHE
+/**
+ * Get the slot of the style cache for an object's part and property.
+ * @param obj   pointer to an object
+ * @param part  a part of the object
+ * @param prop  a style property
+ * @return      the slot where the value is or should be stored.
+ *              Check its `obj`, `part`, `prop` and `gen` fields.
+ */
+static style_cache_entry_t * style_cache_get_entry(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    uint32_t h = (uint32_t)((lv_uintptr_t)obj >> 3) ^ ((uint32_t)prop << 5) ^ (part >> 16);
+    h *= 0x9E3779B1;    /*Fibonacci hashing to mix the bits*/
+    return &style_cache[(h >> 16) & (LV_OBJ_STYLE_CACHE_SIZE - 1)];
+}
+#endif
+
 /**
  * Refresh the style of all children of an object. (Called recursively)
  * @param style refresh objects only with this
@@ -84,6 +84,9 @@ void lv_obj_clean(lv_obj_t * obj)
 
     lv_obj_invalidate(obj);
 
+    /*Don't update the spatial index for each deleted child*/
+    _lv_obj_spatial_invalidate(obj);
+
     lv_obj_t * child = lv_obj_get_child(obj, 0);
     while(child) {
         obj_del_core(child);
@@ -145,11 +148,14 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     lv_obj_t * old_parent = obj->parent;
     /*Remove the object from the old parent's child list*/
+    int32_t old_id = lv_obj_get_index(obj);
     int32_t i;
-    for(i = lv_obj_get_index(obj); i <= (int32_t)lv_obj_get_child_cnt(old_parent) - 2; i++) {
+    for(i = old_id; i <= (int32_t)lv_obj_get_child_cnt(old_parent) - 2; i++) {
         old_parent->spec_attr->children[i] = old_parent->spec_attr->children[i + 1];
     }
     old_parent->spec_attr->child_cnt--;
+    _lv_obj_spatial_child_removed(old_parent, old_id);
+    if(old_parent->spec_attr->layout_clean_cnt > (uint32_t)old_id) old_parent->spec_attr->layout_clean_cnt = old_id;
     if(old_parent->spec_attr->child_cnt) {
         old_parent->spec_attr->children = lv_mem_realloc(old_parent->spec_attr->children,
                                                          old_parent->spec_attr->child_cnt * (sizeof(lv_obj_t *)));
@@ -164,8 +170,10 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     parent->spec_attr->children = lv_mem_realloc(parent->spec_attr->children,
                                                  parent->spec_attr->child_cnt * (sizeof(lv_obj_t *)));
     parent->spec_attr->children[lv_obj_get_child_cnt(parent) - 1] = obj;
+    _lv_obj_spatial_child_added(parent);
 
     obj->parent = parent;
+    _lv_style_cache_invalidate();   /*The inherited style properties might be different*/
 
     /*Notify the original parent because one of its children is lost*/
     lv_obj_scrollbar_invalidate(old_parent);
@@ -212,6 +220,10 @@ void lv_obj_move_to_index(lv_obj_t * obj, int32_t index)
     }
 
     parent->spec_attr->children[index] = obj;
+    _lv_obj_spatial_invalidate(parent);
+    /*The children from the lower index are at a new place*/
+    uint32_t changed_id = LV_MIN(index, old_index);
+    if(parent->spec_attr->layout_clean_cnt > changed_id) parent->spec_attr->layout_clean_cnt = changed_id;
     lv_event_send(parent, LV_EVENT_CHILD_CHANGED, NULL);
     lv_obj_invalidate(parent);
 }
@@ -232,6 +244,8 @@ void lv_obj_swap(lv_obj_t * obj1, lv_obj_t * obj2)
 
     parent->spec_attr->children[index1] = obj2;
     parent2->spec_attr->children[index2] = obj1;
+    _lv_obj_spatial_invalidate(parent);
+    _lv_obj_spatial_invalidate(parent2);
 
     lv_event_send(parent, LV_EVENT_CHILD_CHANGED, obj2);
     lv_event_send(parent, LV_EVENT_CHILD_CREATED, obj2);
@@ -355,6 +369,7 @@ static void obj_del_core(lv_obj_t * obj)
     if(res == LV_RES_INV) return;
 
     obj->being_deleted = 1;
+    _lv_obj_spatial_invalidate(obj);    /*Not to update it for each deleted child*/
 
     /*Recursively delete the children*/
     lv_obj_t * child = lv_obj_get_child(obj, 0);
@@ -408,6 +423,10 @@ static void obj_del_core(lv_obj_t * obj)
             obj->parent->spec_attr->children[i] = obj->parent->spec_attr->children[i + 1];
         }
         obj->parent->spec_attr->child_cnt--;
+        _lv_obj_spatial_child_removed(obj->parent, id);
+
+        /*The next children are shifted so the layout can't reuse their position*/
+        if(obj->parent->spec_attr->layout_clean_cnt > id) obj->parent->spec_attr->layout_clean_cnt = id;
         obj->parent->spec_attr->children = lv_mem_realloc(obj->parent->spec_attr->children,
                                                           obj->parent->spec_attr->child_cnt * sizeof(lv_obj_t *));
     }
@@ -59,6 +59,7 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
+static void refr_children_from(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, uint32_t start);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
 static void draw_buf_flush(lv_disp_t * disp);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
@@ -175,12 +176,7 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 
     if(refr_children) {
         draw_ctx->clip_area = &clip_coords_for_children;
-        uint32_t i;
-        uint32_t child_cnt = lv_obj_get_child_cnt(obj);
-        for(i = 0; i < child_cnt; i++) {
-            lv_obj_t * child = obj->spec_attr->children[i];
-            refr_obj(draw_ctx, child);
-        }
+        refr_children_from(draw_ctx, obj, 0);
     }
 
     /*If the object was visible on the clip area call the post draw events too*/
@@ -305,6 +301,9 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr = lv_disp_get_default();
     }
 
+    /*Don't let the images of this refresh close each other in the image cache*/
+    _lv_img_cache_next_frame();
+
     /*Refresh the screen's layout if required*/
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
@@ -819,15 +818,32 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
     lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
     if(info.res == LV_COVER_RES_MASKED) return NULL;
 
-    int32_t i;
-    int32_t child_cnt = lv_obj_get_child_cnt(obj);
-    for(i = child_cnt - 1; i >= 0; i--) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        found_p = lv_refr_get_top_obj(area_p, child);
+    _lv_obj_spatial_iter_t it;
+    if(_lv_obj_spatial_iter_init(obj, area_p, &it)) {
+        /*The children on the area come in any order so use the top most (last) match*/
+        lv_obj_t * child;
+        uint32_t id;
+        uint32_t found_id = 0;
+        while((child = _lv_obj_spatial_iter_next(&it, &id)) != NULL) {
+            if(found_p && id < found_id) continue;
+            lv_obj_t * found_child_p = lv_refr_get_top_obj(area_p, child);
+            if(found_child_p) {
+                found_p = found_child_p;
+                found_id = id;
+            }
+        }
+    }
+    else {
+        int32_t i;
+        int32_t child_cnt = lv_obj_get_child_cnt(obj);
+        for(i = child_cnt - 1; i >= 0; i--) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            found_p = lv_refr_get_top_obj(area_p, child);
 
-        /*If a children is ok then break*/
-        if(found_p != NULL) {
-            break;
+            /*If a children is ok then break*/
+            if(found_p != NULL) {
+                break;
+            }
         }
     }
 
@@ -863,19 +879,7 @@ static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj)
 
     /*Do until not reach the screen*/
     while(parent != NULL) {
-        bool go = false;
-        uint32_t i;
-        uint32_t child_cnt = lv_obj_get_child_cnt(parent);
-        for(i = 0; i < child_cnt; i++) {
-            lv_obj_t * child = parent->spec_attr->children[i];
-            if(!go) {
-                if(child == border_p) go = true;
-            }
-            else {
-                /*Refresh the objects*/
-                refr_obj(draw_ctx, child);
-            }
-        }
+        refr_children_from(draw_ctx, parent, lv_obj_get_index(border_p) + 1);
 
         /*Call the post draw draw function of the parents of the to object*/
         lv_event_send(parent, LV_EVENT_DRAW_POST_BEGIN, (void *)draw_ctx);
@@ -969,6 +973,10 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 {
     /*Do not refresh hidden objects*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    /*Draw the cached bitmap of the object if it can be used*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_BITMAP) && _lv_obj_bitmap_cache_draw(draw_ctx, obj)) return;
+
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
         lv_obj_redraw(draw_ctx, obj);
@@ -1050,6 +1058,58 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     }
 }
 
+/**
+ * Draw the children of an object from a given index.
+ * With a spatial index only the children on the clip area are visited, still in the order of their index.
+ * @param draw_ctx  pointer to the draw context
+ * @param obj       pointer to an object
+ * @param start     index of the first child to draw
+ */
+static void refr_children_from(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, uint32_t start)
+{
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    if(start >= child_cnt) return;
+
+    _lv_obj_spatial_iter_t it;
+    if(_lv_obj_spatial_iter_init(obj, draw_ctx->clip_area, &it)) {
+        uint32_t id;
+        uint32_t cnt = 0;
+        while(_lv_obj_spatial_iter_next(&it, &id)) {
+            if(id >= start) cnt++;
+        }
+        if(cnt == 0) return;
+
+        uint32_t * ids = lv_mem_buf_get(cnt * sizeof(uint32_t));
+        if(ids) {
+            /*Sort the indices from the end as the children come typically in descending order*/
+            uint32_t i = cnt;
+            _lv_obj_spatial_iter_init(obj, draw_ctx->clip_area, &it);
+            while(_lv_obj_spatial_iter_next(&it, &id)) {
+                if(id < start) continue;
+                i--;
+                uint32_t j = i;
+                while(j + 1 < cnt && ids[j + 1] < id) {
+                    ids[j] = ids[j + 1];
+                    j++;
+                }
+                ids[j] = id;
+            }
+
+            for(i = 0; i < cnt; i++) {
+                refr_obj(draw_ctx, obj->spec_attr->children[ids[i]]);
+            }
+            lv_mem_buf_release(ids);
+            return;
+        }
+    }
+
+    uint32_t i;
+    for(i = start; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        refr_obj(draw_ctx, child);
+    }
+}
+
 
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h)
 {
@@ -17,6 +17,8 @@
 /*********************
  *      DEFINES
  *********************/
+/*Max. size of the buffer used for decoders which can read areas*/
+#define READ_AREA_BUF_SIZE  (16 * 1024)
 
 /**********************
  *      TYPEDEFS
@@ -28,6 +30,44 @@
 static lv_res_t /* LV_ATTRIBUTE_FAST_MEM */ decode_and_draw(lv_draw_ctx_t * draw_ctx,
                                                             const lv_draw_img_dsc_t * draw_dsc,
                                                             const lv_area_t * coords, const void * src);
+static lv_res_t read_and_draw_areas(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
+                                    lv_img_decoder_dsc_t * dec_dsc, const lv_area_t * coords,
+                                    const lv_area_t * mask_com, lv_img_cf_t cf);
+static lv_res_t read_and_draw_areas(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
+                                    lv_img_decoder_dsc_t * dec_dsc, const lv_area_t * coords,
+                                    const lv_area_t * mask_com, lv_img_cf_t cf)
+{
+    int32_t width = lv_area_get_width(mask_com);
+    uint32_t px_size = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    int32_t band_h = READ_AREA_BUF_SIZE / (width * px_size);
+    if(band_h < 1) band_h = 1;
+    if(band_h > lv_area_get_height(mask_com)) band_h = lv_area_get_height(mask_com);
+
+    uint8_t * buf = lv_mem_buf_get(width * band_h * px_size);
+    if(buf == NULL) return LV_RES_INV;
+
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    lv_res_t res = LV_RES_OK;
+    lv_area_t band;
+    band.x1 = mask_com->x1;
+    band.x2 = mask_com->x2;
+    for(band.y1 = mask_com->y1; band.y1 <= mask_com->y2; band.y1 += band_h) {
+        band.y2 = LV_MIN(band.y1 + band_h - 1, mask_com->y2);
+
+        /*The area to read in image coordinates*/
+        lv_area_t img_area = band;
+        lv_area_move(&img_area, -coords->x1, -coords->y1);
+        res = lv_img_decoder_read_area(dec_dsc, &img_area, buf);
+        if(res != LV_RES_OK) break;
+
+        draw_ctx->clip_area = &band;
+        lv_draw_img_decoded(draw_ctx, draw_dsc, &band, buf, cf);
+    }
+
+    draw_ctx->clip_area = clip_area_ori;
+    lv_mem_buf_release(buf);
+    return res;
+}
 
 static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const char * msg);
 static void draw_cleanup(_lv_img_cache_entry_t * cache);
@@ -309,6 +349,19 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
             return LV_RES_OK;
         }
 
+        /*Decoders which can read areas get as many lines at once as fit into a buffer*/
+        if(cdsc->dec_dsc.decoder->read_area_cb &&
+           (cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED || cf == LV_IMG_CF_TRUE_COLOR_ALPHA)) {
+            lv_res_t res = read_and_draw_areas(draw_ctx, draw_dsc, &cdsc->dec_dsc, coords, &mask_com, cf);
+            draw_cleanup(cdsc);
+            if(res != LV_RES_OK) {
+                LV_LOG_WARN("Image draw can't read the area");
+                /*Don't keep the broken image in the cache*/
+                lv_img_cache_invalidate_src(src);
+            }
+            return res;
+        }
+
         int32_t width = lv_area_get_width(&mask_com);
 
         uint8_t  * buf = lv_mem_buf_get(lv_area_get_width(&mask_com) *
@@ -329,10 +382,11 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
 
             read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf);
             if(read_res != LV_RES_OK) {
-                lv_img_decoder_close(&cdsc->dec_dsc);
                 LV_LOG_WARN("Image draw can't read the line");
                 lv_mem_buf_release(buf);
                 draw_cleanup(cdsc);
+                /*Don't keep the broken image in the cache*/
+                lv_img_cache_invalidate_src(src);
                 draw_ctx->clip_area = clip_area_ori;
                 return LV_RES_INV;
             }
@@ -367,9 +421,5 @@ static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const
 static void draw_cleanup(_lv_img_cache_entry_t * cache)
 {
     /*Automatically close images with no caching*/
-#if LV_IMG_CACHE_DEF_SIZE == 0
-    lv_img_decoder_close(&cache->dec_dsc);
-#else
-    LV_UNUSED(cache);
-#endif
+    _lv_img_cache_release(cache);
 }
@@ -106,8 +106,11 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 
     lv_bidi_calculate_align(&align, &base_dir, txt);
 
-    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
-        /*Normally use the label's width as width*/
+    const lv_draw_label_line_t * lines = hint ? hint->lines : NULL;
+    uint32_t line_i = 0;
+
+    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0 || lines) {
+        /*Normally use the label's width as width. The already wrapped lines don't need it.*/
         w = lv_area_get_width(coords);
     }
     else {
@@ -134,52 +137,76 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_end;
     int32_t last_line_start = -1;
 
-    /*Check the hint to use the cached info*/
-    if(hint && y_ofs == 0 && coords->y1 < 0) {
-        /*If the label changed too much recalculate the hint.*/
-        if(LV_ABS(hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
-            hint->line_start = -1;
+    if(lines) {
+        /*Jump to the first visible line*/
+        if(line_height > 0 && pos.y + line_height_font < draw_ctx->clip_area->y1) {
+            line_i = (draw_ctx->clip_area->y1 - pos.y - line_height_font + line_height - 1) / line_height;
+            if(line_i >= hint->line_cnt) return;
+            pos.y += line_i * line_height;
         }
-        last_line_start = hint->line_start;
-    }
 
-    /*Use the hint if it's valid*/
-    if(hint && last_line_start >= 0) {
-        line_start = last_line_start;
-        pos.y += hint->y;
+        /*E.g. negative line space*/
+        while(pos.y + line_height_font < draw_ctx->clip_area->y1) {
+            line_i++;
+            pos.y += line_height;
+            if(line_i >= hint->line_cnt) return;
+        }
+
+        if(line_i >= hint->line_cnt) return;
+        line_start = lines[line_i].start;
+        line_end = lines[line_i + 1].start;
     }
+    else {
+        /*Check the hint to use the cached info*/
+        if(hint && y_ofs == 0 && coords->y1 < 0) {
+            /*If the label changed too much recalculate the hint.*/
+            if(LV_ABS(hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
+                hint->line_start = -1;
+            }
+            last_line_start = hint->line_start;
+        }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        /*Use the hint if it's valid*/
+        if(hint && last_line_start >= 0) {
+            line_start = last_line_start;
+            pos.y += hint->y;
+        }
 
-    /*Go the first visible line*/
-    while(pos.y + line_height_font < draw_ctx->clip_area->y1) {
-        /*Go to next line*/
-        line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
-        pos.y += line_height;
+        line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
 
-        /*Save at the threshold coordinate*/
-        if(hint && pos.y >= -LV_LABEL_HINT_UPDATE_TH && hint->line_start < 0) {
-            hint->line_start = line_start;
-            hint->y          = pos.y - coords->y1;
-            hint->coord_y    = coords->y1;
-        }
+        /*Go the first visible line*/
+        while(pos.y + line_height_font < draw_ctx->clip_area->y1) {
+            /*Go to next line*/
+            line_start = line_end;
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+            pos.y += line_height;
+
+            /*Save at the threshold coordinate*/
+            if(hint && pos.y >= -LV_LABEL_HINT_UPDATE_TH && hint->line_start < 0) {
+                hint->line_start = line_start;
+                hint->y          = pos.y - coords->y1;
+                hint->coord_y    = coords->y1;
+            }
 
-        if(txt[line_start] == '\0') return;
+            if(txt[line_start] == '\0') return;
+        }
     }
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = lines ? lines[line_i].w :
+                     lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = lines ? lines[line_i].w :
+                     lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
         pos.x += lv_area_get_width(coords) - line_width;
     }
     uint32_t sel_start = dsc->sel_start;
@@ -334,21 +361,28 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        if(lines) {
+            line_i++;
+            if(line_i >= hint->line_cnt) break;
+            line_end = lines[line_i + 1].start;
+        }
+        else {
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = lines ? lines[line_i].w :
+                         lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = lines ? lines[line_i].w :
+                         lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
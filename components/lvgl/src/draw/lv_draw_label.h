@@ -46,6 +46,12 @@ typedef struct {
     lv_blend_mode_t blend_mode: 3;
 } lv_draw_label_dsc_t;
 
+/** Start and width of a wrapped line of a text*/
+typedef struct {
+    uint32_t start;     /**< Byte index of the first character of the line*/
+    lv_coord_t w;       /**< Width of the line in pixels*/
+} lv_draw_label_line_t;
+
 /** Store some info to speed up drawing of very large texts
  * It takes a lot of time to get the first visible character because
  * all the previous characters needs to be checked to calculate the positions.
@@ -61,6 +67,14 @@ typedef struct _lv_draw_label_hint_t {
     /** The 'y1' coordinate of the label when the hint was saved.
      * Used to invalidate the hint if the label has moved too much.*/
     int32_t coord_y;
+
+    /** If not NULL, the already wrapped lines of the text with the same font, letter space, width and flags.
+     * `line_cnt + 1` items where the last item's `start` is the length of the text.
+     * The drawing jumps directly to the first visible line and the other fields are not used.*/
+    const lv_draw_label_line_t * lines;
+
+    /** Number of lines in `lines`*/
+    uint32_t line_cnt;
 } lv_draw_label_hint_t;
 
 struct _lv_draw_ctx_t;
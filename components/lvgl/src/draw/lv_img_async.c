@@ -0,0 +1,348 @@
+/**
+ * @file lv_img_async.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_img_async.h"
+#if LV_IMG_ASYNC
+
+#include "lv_img_cache.h"
+#include "lv_img_decoder.h"
+#include "../core/lv_obj.h"
+#include "../hal/lv_hal_tick.h"
+#include "../misc/lv_gc.h"
+#include "../misc/lv_timer.h"
+#include "../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * An image being decoded in the background
+ */
+typedef struct {
+    char * src;                 /*Copy of the path*/
+    lv_color_t color;
+    lv_vec_t objs;              /*The objects waiting for the image. NULL if deleted while finishing.*/
+    lv_img_decoder_dsc_t dsc;
+    uint8_t * buf;              /*The decoded pixels*/
+    uint32_t row;               /*The next row to decode*/
+    uint32_t time;              /*Time spent with decoding [ms]*/
+    uint8_t opened : 1;
+} async_job_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_vec_t * get_jobs(void);
+static void async_timer_cb(lv_timer_t * t);
+static uint32_t job_pick(void);
+static bool job_step(async_job_t * job, uint32_t t_start, lv_res_t * res);
+static lv_res_t job_open(async_job_t * job);
+static lv_res_t job_cache(async_job_t * job);
+static void job_finish(async_job_t * job, lv_res_t res);
+static void job_free(async_job_t * job);
+static void decoded_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_timer_t * async_timer;
+static async_job_t * finishing_job;
+
+/*Closes the images decoded line by line into a buffer*/
+static lv_img_decoder_t decoded_decoder = {
+    .close_cb = decoded_close
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_img_async_request(lv_obj_t * obj, const void * src, lv_color_t color)
+{
+    lv_vec_t * jobs = get_jobs();
+    uint32_t i;
+    for(i = 0; i < lv_vec_get_cnt(jobs); i++) {
+        async_job_t * job = *(async_job_t **)lv_vec_at(jobs, i);
+        if(job->color.full != color.full || strcmp(job->src, src) != 0) continue;
+
+        uint32_t j;
+        for(j = 0; j < lv_vec_get_cnt(&job->objs); j++) {
+            if(*(lv_obj_t **)lv_vec_at(&job->objs, j) == obj) return;
+        }
+
+        lv_obj_t ** obj_p = lv_vec_push(&job->objs);
+        LV_ASSERT_MALLOC(obj_p);
+        if(obj_p) *obj_p = obj;
+        return;
+    }
+
+    async_job_t * job = lv_mem_alloc(sizeof(async_job_t));
+    LV_ASSERT_MALLOC(job);
+    if(job == NULL) return;
+    lv_memset_00(job, sizeof(async_job_t));
+
+    size_t len = strlen(src) + 1;
+    job->src = lv_mem_alloc(len);
+    LV_ASSERT_MALLOC(job->src);
+    job->color = color;
+    lv_vec_init(&job->objs, sizeof(lv_obj_t *));
+    lv_obj_t ** obj_p = lv_vec_push(&job->objs);
+    async_job_t ** job_p = lv_vec_push(jobs);
+    if(job->src == NULL || obj_p == NULL || job_p == NULL) {
+        if(job_p) lv_vec_remove(jobs, lv_vec_get_cnt(jobs) - 1);
+        job_free(job);
+        return;
+    }
+
+    lv_memcpy(job->src, src, len);
+    *obj_p = obj;
+    *job_p = job;
+
+    if(async_timer == NULL) async_timer = lv_timer_create(async_timer_cb, 0, NULL);
+    else lv_timer_resume(async_timer);
+}
+
+void _lv_img_async_cancel(lv_obj_t * obj)
+{
+    /*The job which is being finished was already removed from the list*/
+    if(finishing_job) {
+        uint32_t j;
+        for(j = 0; j < lv_vec_get_cnt(&finishing_job->objs); j++) {
+            lv_obj_t ** obj_p = lv_vec_at(&finishing_job->objs, j);
+            if(*obj_p == obj) *obj_p = NULL;
+        }
+    }
+
+    lv_vec_t * jobs = get_jobs();
+    uint32_t i = lv_vec_get_cnt(jobs);
+    while(i > 0) {
+        i--;
+        async_job_t * job = *(async_job_t **)lv_vec_at(jobs, i);
+        uint32_t j;
+        for(j = 0; j < lv_vec_get_cnt(&job->objs); j++) {
+            if(*(lv_obj_t **)lv_vec_at(&job->objs, j) == obj) {
+                lv_vec_remove_swap(&job->objs, j);
+                break;
+            }
+        }
+
+        if(lv_vec_get_cnt(&job->objs) == 0) {
+            lv_vec_remove(jobs, i);
+            job_free(job);
+        }
+    }
+}
+
+bool _lv_img_async_is_pending(const lv_obj_t * obj)
+{
+    lv_vec_t * jobs = get_jobs();
+    uint32_t i;
+    for(i = 0; i < lv_vec_get_cnt(jobs); i++) {
+        async_job_t * job = *(async_job_t **)lv_vec_at(jobs, i);
+        uint32_t j;
+        for(j = 0; j < lv_vec_get_cnt(&job->objs); j++) {
+            if(*(lv_obj_t **)lv_vec_at(&job->objs, j) == obj) return true;
+        }
+    }
+
+    return false;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_vec_t * get_jobs(void)
+{
+    lv_vec_t * jobs = &LV_GC_ROOT(_lv_img_async_jobs);
+    if(jobs->elem_size == 0) lv_vec_init(jobs, sizeof(async_job_t *));
+    return jobs;
+}
+
+/**
+ * Decode the images for `LV_IMG_ASYNC_STEP_TIME` ms
+ */
+static void async_timer_cb(lv_timer_t * t)
+{
+    lv_vec_t * jobs = get_jobs();
+    uint32_t t_start = lv_tick_get();
+    while(lv_vec_get_cnt(jobs)) {
+        uint32_t idx = job_pick();
+        async_job_t * job = *(async_job_t **)lv_vec_at(jobs, idx);
+        lv_res_t res;
+        if(job_step(job, t_start, &res)) {
+            lv_vec_remove(jobs, idx);
+            job_finish(job, res);
+        }
+
+        if(lv_tick_elaps(t_start) >= LV_IMG_ASYNC_STEP_TIME) break;
+    }
+
+    if(lv_vec_get_cnt(jobs) == 0) lv_timer_pause(t);
+}
+
+/**
+ * Select the next job: the oldest one which has a visible object or simply the oldest one
+ */
+static uint32_t job_pick(void)
+{
+    lv_vec_t * jobs = get_jobs();
+    uint32_t i;
+    for(i = 0; i < lv_vec_get_cnt(jobs); i++) {
+        async_job_t * job = *(async_job_t **)lv_vec_at(jobs, i);
+        uint32_t j;
+        for(j = 0; j < lv_vec_get_cnt(&job->objs); j++) {
+            if(lv_obj_is_visible(*(lv_obj_t **)lv_vec_at(&job->objs, j))) return i;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Decode rows of an image until the time of the step is over
+ * @return true: the job is finished and `res` is set
+ */
+static bool job_step(async_job_t * job, uint32_t t_start, lv_res_t * res)
+{
+    if(!job->opened) {
+        *res = job_open(job);
+        if(*res != LV_RES_OK) return true;
+
+        /*The decoder has decoded the whole image while opening it*/
+        if(job->dsc.img_data) {
+            *res = job_cache(job);
+            return true;
+        }
+
+        if(lv_tick_elaps(t_start) >= LV_IMG_ASYNC_STEP_TIME) return false;
+    }
+
+    uint32_t w = job->dsc.header.w;
+    uint32_t h = job->dsc.header.h;
+    uint32_t row_size = w * (lv_img_cf_get_px_size(job->dsc.header.cf) >> 3);
+    uint32_t t = lv_tick_get();
+    while(job->row < h) {
+        if(lv_img_decoder_read_line(&job->dsc, 0, job->row, w, job->buf + job->row * row_size) != LV_RES_OK) {
+            *res = LV_RES_INV;
+            return true;
+        }
+
+        job->row++;
+        if(lv_tick_elaps(t_start) >= LV_IMG_ASYNC_STEP_TIME) break;
+    }
+    job->time += lv_tick_elaps(t);
+
+    if(job->row < h) return false;
+
+    /*Close the line reading and keep only the pixels*/
+    if(job->dsc.decoder->close_cb) job->dsc.decoder->close_cb(job->dsc.decoder, &job->dsc);
+    job->dsc.decoder = &decoded_decoder;
+    job->dsc.img_data = job->buf;
+    job->dsc.user_data = NULL;
+    job->dsc.error_msg = NULL;
+    job->buf = NULL;
+
+    *res = job_cache(job);
+    return true;
+}
+
+/**
+ * Open the image and allocate a buffer for the pixels if it needs to be read line by line
+ */
+static lv_res_t job_open(async_job_t * job)
+{
+    /*Don't decode an image which couldn't be cached (e.g. the budget was lowered since the request)*/
+    lv_img_header_t header;
+    if(lv_img_decoder_get_info(job->src, &header) != LV_RES_OK) return LV_RES_INV;
+    if(!_lv_img_cache_can_fit(lv_img_buf_get_img_size(header.w, header.h, header.cf))) {
+        LV_LOG_INFO("the image doesn't fit into the image cache");
+        return LV_RES_INV;
+    }
+
+    uint32_t t = lv_tick_get();
+    lv_res_t res = lv_img_decoder_open(&job->dsc, job->src, job->color, 0);
+    job->time += lv_tick_elaps(t);
+    if(res != LV_RES_OK) return LV_RES_INV;
+    job->opened = 1;
+    if(job->dsc.img_data) return LV_RES_OK;
+
+    lv_img_cf_t cf = job->dsc.header.cf;
+    if(job->dsc.decoder->read_line_cb == NULL ||
+       (cf != LV_IMG_CF_TRUE_COLOR && cf != LV_IMG_CF_TRUE_COLOR_ALPHA && cf != LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED)) {
+        LV_LOG_INFO("the image can't be decoded in the background");
+        return LV_RES_INV;
+    }
+
+    job->buf = lv_img_cache_mem_alloc(lv_img_buf_get_img_size(job->dsc.header.w, job->dsc.header.h, cf));
+    if(job->buf == NULL) {
+        LV_LOG_WARN("couldn't allocate the decoded image");
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Pass the decoded image to the image cache
+ */
+static lv_res_t job_cache(async_job_t * job)
+{
+    job->dsc.time_to_open = LV_MAX(job->time, 1);
+    job->opened = 0;
+    if(_lv_img_cache_add(&job->dsc) == LV_RES_OK) return LV_RES_OK;
+
+    LV_LOG_WARN("the decoded image doesn't fit into the image cache");
+    lv_img_decoder_close(&job->dsc);
+    return LV_RES_INV;
+}
+
+/**
+ * Notify the objects and free the job
+ */
+static void job_finish(async_job_t * job, lv_res_t res)
+{
+    finishing_job = job;
+    uint32_t i;
+    for(i = 0; i < lv_vec_get_cnt(&job->objs); i++) {
+        lv_obj_t * obj = *(lv_obj_t **)lv_vec_at(&job->objs, i);
+        if(obj == NULL) continue;
+        lv_obj_invalidate(obj);
+        lv_event_send(obj, LV_EVENT_READY, &res);
+    }
+    finishing_job = NULL;
+
+    job_free(job);
+}
+
+static void job_free(async_job_t * job)
+{
+    if(job->opened) lv_img_decoder_close(&job->dsc);
+    if(job->buf) lv_img_cache_mem_free(job->buf);
+    lv_mem_free(job->src);
+    lv_vec_clear(&job->objs);
+    lv_mem_free(job);
+}
+
+static void decoded_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    lv_img_cache_mem_free((void *)dsc->img_data);
+    dsc->img_data = NULL;
+}
+
+#endif /*LV_IMG_ASYNC*/
@@ -0,0 +1,77 @@
+/**
+ * @file lv_img_async.h
+ *
+ */
+
+#ifndef LV_IMG_ASYNC_H
+#define LV_IMG_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdbool.h>
+#include "../lv_conf_internal.h"
+#include "../misc/lv_color.h"
+#include "../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_IMG_ASYNC && LV_IMG_CACHE_DEF_SIZE == 0
+    #error "LV_IMG_ASYNC requires the image cache (LV_IMG_CACHE_DEF_SIZE > 0)"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_obj_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_IMG_ASYNC
+
+/**
+ * Decode an image file into the image cache in the background, in `LV_IMG_ASYNC_STEP_TIME` long steps
+ * between the display refreshes. The images of visible objects are decoded first.
+ * When the image is cached (or it couldn't be decoded) the object is invalidated and `LV_EVENT_READY`
+ * is sent to it with a pointer to an `lv_res_t` parameter:
+ * `LV_RES_OK` if the image is in the cache, `LV_RES_INV` if it has to be opened while drawing.
+ * Requesting the same image again (also from an other object) doesn't start a new decoding.
+ * Images larger than the memory budget of the image cache are not decoded.
+ * @param obj       the object which needs the image
+ * @param src       path of an image file
+ * @param color     the color of the image with `LV_IMG_CF_ALPHA_...` (as passed to the image cache)
+ */
+void _lv_img_async_request(struct _lv_obj_t * obj, const void * src, lv_color_t color);
+
+/**
+ * Cancel the requests of an object. The decoding is stopped if no other object needs the image.
+ * @param obj       pointer to an object
+ */
+void _lv_img_async_cancel(struct _lv_obj_t * obj);
+
+/**
+ * Check if an object waits for an image
+ * @param obj       pointer to an object
+ * @return          true: the image of the object is being decoded
+ */
+bool _lv_img_async_is_pending(const struct _lv_obj_t * obj);
+
+#endif /*LV_IMG_ASYNC*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMG_ASYNC_H*/
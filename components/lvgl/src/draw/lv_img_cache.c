@@ -13,35 +13,70 @@
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
 
+#if LV_IMG_CACHE_MEM_CUSTOM
+    #include LV_IMG_CACHE_MEM_CUSTOM_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value on every open*/
-#define LV_IMG_CACHE_AGING 1
+/*Don't let the time to open to be greater than this limit [ms] because
+ *the images would live in the cache for very long time*/
+#define LV_IMG_CACHE_TIME_LIMIT 1000
 
-/*Boost life by this factor (multiply time_to_open with this value)*/
-#define LV_IMG_CACHE_LIFE_GAIN 1
+/*Renormalize the priorities when the clock reaches this value to avoid overflow*/
+#define LV_IMG_CACHE_CLOCK_LIMIT 0x80000000
 
-/*Don't let life to be greater than this limit because it would require a lot of time to
- * "die" from very high values*/
-#define LV_IMG_CACHE_LIFE_LIMIT 1000
+/*An unused slot of the hash table*/
+#define TABLE_EMPTY 0xFFFF
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_IMG_CACHE_DEF_SIZE
+typedef struct {
+    void * src;             /*Copy of the file path or pointer to the `lv_img_dsc_t` variable*/
+    uint32_t src_hash;
+    uint32_t cnt;
+} img_cache_pin_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
+    static uint32_t src_hash_get(const void * src);
+    static uint32_t key_hash_get(uint32_t src_hash, lv_color_t color, int32_t frame_id);
+    static int32_t table_find(uint32_t hash, const void * src, lv_color_t color, int32_t frame_id);
+    static uint32_t table_find_entry(uint32_t idx);
+    static void table_insert(uint32_t idx);
+    static void table_remove(uint32_t pos);
+    static _lv_img_cache_entry_t * entry_add(const _lv_img_cache_entry_t * tmp);
+    static void entry_remove(uint32_t idx);
+    static void entry_touch(_lv_img_cache_entry_t * entry);
+    static uint32_t entry_get_size(const _lv_img_cache_entry_t * entry);
+    static bool make_room(uint32_t size, bool file_open);
+    static lv_vec_t * get_pins(void);
+    static int32_t pin_find(uint32_t src_hash, const void * src);
+    static void entries_set_pinned(uint32_t src_hash, const void * src, bool pinned);
 #endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
-    static uint16_t entry_cnt;
+    static uint16_t entry_cnt;      /*Maximal number of entries*/
+    static uint16_t used_cnt;       /*The first `used_cnt` entries are used*/
+    static uint16_t * table;        /*Open addressing hash table of entry indices, after the entries*/
+    static uint32_t table_mask;
+    static uint32_t mem_used;
+    static uint32_t mem_budget = LV_IMG_CACHE_MEM_SIZE;
+    static uint16_t file_cnt;       /*Number of entries which keep their file open*/
+    static uint16_t file_max = LV_IMG_CACHE_FILE_MAX;
+    static uint32_t prio_clock;
+    static uint32_t frame_act;
+    static lv_img_cache_stats_t stats;
 #endif
 
 /**********************
@@ -62,82 +97,135 @@
  */
 _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, int32_t frame_id)
 {
-    /*Is the image cached?*/
-    _lv_img_cache_entry_t * cached_src = NULL;
-
 #if LV_IMG_CACHE_DEF_SIZE
-    if(entry_cnt == 0) {
-        LV_LOG_WARN("lv_img_cache_open: the cache size is 0");
-        return NULL;
+    uint32_t src_hash = 0;
+    uint32_t hash = 0;
+    if(entry_cnt) {
+        src_hash = src_hash_get(src);
+        hash = key_hash_get(src_hash, color, frame_id);
+        int32_t pos = table_find(hash, src, color, frame_id);
+        if(pos >= 0) {
+            _lv_img_cache_entry_t * cached_src = &LV_GC_ROOT(_lv_img_cache_array)[table[pos]];
+            entry_touch(cached_src);
+            stats.hit_cnt++;
+            LV_LOG_TRACE("image source found in the cache");
+            return cached_src;
+        }
+        stats.miss_cnt++;
     }
+#endif
 
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    /*Open the image into the temporary entry and measure the time to open*/
+    _lv_img_cache_entry_t * tmp = &LV_GC_ROOT(_lv_img_cache_single);
+    lv_memset_00(tmp, sizeof(_lv_img_cache_entry_t));
 
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
+    uint32_t t_start  = lv_tick_get();
+    lv_res_t open_res = lv_img_decoder_open(&tmp->dec_dsc, src, color, frame_id);
+    if(open_res == LV_RES_INV) {
+        LV_LOG_WARN("Image draw cannot open the image resource");
+        lv_memset_00(tmp, sizeof(_lv_img_cache_entry_t));
+        return NULL;
     }
 
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           frame_id == cache[i].dec_dsc.frame_id &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /*If opened increment its life.
-             *Image difficult to open should live longer to keep avoid frequent their recaching.
-             *Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image source found in the cache");
-            break;
-        }
+    /*If `time_to_open` was not set in the open function set it here*/
+    if(tmp->dec_dsc.time_to_open == 0) {
+        tmp->dec_dsc.time_to_open = lv_tick_elaps(t_start);
     }
 
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
+    if(tmp->dec_dsc.time_to_open == 0) tmp->dec_dsc.time_to_open = 1;
 
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
-    }
+#if LV_IMG_CACHE_DEF_SIZE
+    if(entry_cnt == 0) return tmp;
 
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
-        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
-    }
-    else {
-        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
+    tmp->hash = hash;
+    tmp->src_hash = src_hash;
+    tmp->size = entry_get_size(tmp);
+    if(make_room(tmp->size, tmp->dec_dsc.file_open) == false) {
+        LV_LOG_INFO("image draw: cache miss, the image doesn't fit into the cache");
+        stats.uncached_cnt++;
+        return tmp;
     }
+
+    LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
+    _lv_img_cache_entry_t * cached_src = entry_add(tmp);
+    lv_memset_00(tmp, sizeof(_lv_img_cache_entry_t));
+    return cached_src;
 #else
-    cached_src = &LV_GC_ROOT(_lv_img_cache_single);
+    return tmp;
 #endif
-    /*Open the image and measure the time to open*/
-    uint32_t t_start  = lv_tick_get();
-    lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color, frame_id);
-    if(open_res == LV_RES_INV) {
-        LV_LOG_WARN("Image draw cannot open the image resource");
-        lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its us*/
-        return NULL;
-    }
+}
 
-    cached_src->life = 0;
+_lv_img_cache_entry_t * _lv_img_cache_find(const void * src, lv_color_t color, int32_t frame_id)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    if(entry_cnt == 0) return NULL;
 
-    /*If `time_to_open` was not set in the open function set it here*/
-    if(cached_src->dec_dsc.time_to_open == 0) {
-        cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+    uint32_t hash = key_hash_get(src_hash_get(src), color, frame_id);
+    int32_t pos = table_find(hash, src, color, frame_id);
+    return pos >= 0 ? &LV_GC_ROOT(_lv_img_cache_array)[table[pos]] : NULL;
+#else
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+    LV_UNUSED(frame_id);
+    return NULL;
+#endif
+}
+
+lv_res_t _lv_img_cache_add(const lv_img_decoder_dsc_t * dsc)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    if(entry_cnt == 0) return LV_RES_INV;
+
+    /*Replace the entry of the same image (e.g. opened for reading line by line)*/
+    uint32_t src_hash = src_hash_get(dsc->src);
+    uint32_t hash = key_hash_get(src_hash, dsc->color, dsc->frame_id);
+    int32_t pos = table_find(hash, dsc->src, dsc->color, dsc->frame_id);
+    if(pos >= 0) entry_remove(table[pos]);
+
+    _lv_img_cache_entry_t tmp;
+    lv_memset_00(&tmp, sizeof(tmp));
+    tmp.dec_dsc = *dsc;
+    tmp.hash = hash;
+    tmp.src_hash = src_hash;
+    tmp.size = entry_get_size(&tmp);
+    if(tmp.dec_dsc.time_to_open == 0) tmp.dec_dsc.time_to_open = 1;
+    if(make_room(tmp.size, tmp.dec_dsc.file_open) == false) {
+        stats.uncached_cnt++;
+        return LV_RES_INV;
     }
 
-    if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
+    entry_add(&tmp);
+    return LV_RES_OK;
+#else
+    LV_UNUSED(dsc);
+    return LV_RES_INV;
+#endif
+}
+
+bool _lv_img_cache_can_fit(uint32_t size)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    return entry_cnt && (mem_budget == 0 || size <= mem_budget);
+#else
+    LV_UNUSED(size);
+    return false;
+#endif
+}
+
+void _lv_img_cache_release(_lv_img_cache_entry_t * entry)
+{
+    /*Close the images which were not cached*/
+    if(entry->cached) return;
 
-    return cached_src;
+    lv_img_decoder_close(&entry->dec_dsc);
+    lv_memset_00(entry, sizeof(_lv_img_cache_entry_t));
+}
+
+void _lv_img_cache_next_frame(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    frame_act++;
+#endif
 }
 
 /**
@@ -158,17 +246,53 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
     }
 
+    LV_GC_ROOT(_lv_img_cache_array) = NULL;
+    entry_cnt = 0;
+    used_cnt = 0;
+    mem_used = 0;
+    file_cnt = 0;
+    table = NULL;
+    if(new_entry_cnt == 0) return;
+
+    /*Keep the hash table at most half full*/
+    uint32_t table_size = 4;
+    while(table_size < 2 * (uint32_t)new_entry_cnt) table_size <<= 1;
+
     /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt);
+    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt +
+                                                   sizeof(uint16_t) * table_size);
     LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_array));
-    if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
-        entry_cnt = 0;
-        return;
-    }
+    if(LV_GC_ROOT(_lv_img_cache_array) == NULL) return;
+
     entry_cnt = new_entry_cnt;
+    table = (uint16_t *)&LV_GC_ROOT(_lv_img_cache_array)[entry_cnt];
+    table_mask = table_size - 1;
 
     /*Clean the cache*/
     lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(_lv_img_cache_entry_t));
+    lv_memset_ff(table, table_size * sizeof(uint16_t));
+#endif
+}
+
+void lv_img_cache_set_mem_budget(uint32_t size)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(size);
+    LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    mem_budget = size;
+    if(mem_budget && mem_used > mem_budget) make_room(0, false);
+#endif
+}
+
+void lv_img_cache_set_file_max(uint16_t cnt)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(cnt);
+    LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    file_max = cnt;
+    if(file_max && file_cnt > file_max) make_room(0, false);
 #endif
 }
 
@@ -182,20 +306,131 @@ void lv_img_cache_invalidate_src(const void * src)
     LV_UNUSED(src);
 #if LV_IMG_CACHE_DEF_SIZE
     _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint32_t src_hash = src ? src_hash_get(src) : 0;
 
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
-
-            lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
+    /*The last entry is moved to the place of the removed one so check the same index again*/
+    uint32_t i = 0;
+    while(i < used_cnt) {
+        if(src == NULL || (cache[i].src_hash == src_hash && lv_img_cache_match(src, cache[i].dec_dsc.src))) {
+            entry_remove(i);
+        }
+        else {
+            i++;
         }
     }
 #endif
 }
 
+void lv_img_cache_pin(const void * src)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type != LV_IMG_SRC_FILE && src_type != LV_IMG_SRC_VARIABLE) {
+        LV_LOG_WARN("lv_img_cache_pin: only files and variables can be pinned");
+        return;
+    }
+
+    lv_vec_t * pins = get_pins();
+    uint32_t src_hash = src_hash_get(src);
+    int32_t idx = pin_find(src_hash, src);
+    if(idx >= 0) {
+        img_cache_pin_t * pin = lv_vec_at(pins, idx);
+        pin->cnt++;
+        return;
+    }
+
+    void * src_copy = (void *)src;
+    if(src_type == LV_IMG_SRC_FILE) {
+        size_t len = strlen(src) + 1;
+        src_copy = lv_mem_alloc(len);
+        LV_ASSERT_MALLOC(src_copy);
+        if(src_copy == NULL) return;
+        lv_memcpy(src_copy, src, len);
+    }
+
+    img_cache_pin_t * pin = lv_vec_push(pins);
+    LV_ASSERT_MALLOC(pin);
+    if(pin == NULL) {
+        if(src_copy != src) lv_mem_free(src_copy);
+        return;
+    }
+
+    pin->src = src_copy;
+    pin->src_hash = src_hash;
+    pin->cnt = 1;
+    entries_set_pinned(src_hash, src, true);
+#else
+    LV_UNUSED(src);
+#endif
+}
+
+void lv_img_cache_unpin(const void * src)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_vec_t * pins = get_pins();
+    uint32_t src_hash = src_hash_get(src);
+    int32_t idx = pin_find(src_hash, src);
+    if(idx < 0) {
+        LV_LOG_WARN("lv_img_cache_unpin: the image source is not pinned");
+        return;
+    }
+
+    img_cache_pin_t * pin = lv_vec_at(pins, idx);
+    pin->cnt--;
+    if(pin->cnt) return;
+
+    if(lv_img_src_get_type(pin->src) == LV_IMG_SRC_FILE) lv_mem_free(pin->src);
+    lv_vec_remove_swap(pins, idx);
+    entries_set_pinned(src_hash, src, false);
+#else
+    LV_UNUSED(src);
+#endif
+}
+
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats_p)
+{
+    lv_memset_00(stats_p, sizeof(lv_img_cache_stats_t));
+#if LV_IMG_CACHE_DEF_SIZE
+    *stats_p = stats;
+    stats_p->entry_cnt = used_cnt;
+    stats_p->entry_max = entry_cnt;
+    stats_p->mem_used = mem_used;
+    stats_p->mem_budget = mem_budget;
+    stats_p->file_cnt = file_cnt;
+
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint32_t i;
+    for(i = 0; i < used_cnt; i++) {
+        if(cache[i].pinned) stats_p->pinned_cnt++;
+    }
+#endif
+}
+
+void lv_img_cache_reset_stats(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_memset_00(&stats, sizeof(stats));
+#endif
+}
+
+void * lv_img_cache_mem_alloc(size_t size)
+{
+#if LV_IMG_CACHE_MEM_CUSTOM
+    return LV_IMG_CACHE_MEM_CUSTOM_ALLOC(size);
+#else
+    return lv_mem_alloc(size);
+#endif
+}
+
+void lv_img_cache_mem_free(void * data)
+{
+#if LV_IMG_CACHE_MEM_CUSTOM
+    LV_IMG_CACHE_MEM_CUSTOM_FREE(data);
+#else
+    lv_mem_free(data);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -212,4 +447,229 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+static uint32_t src_hash_get(const void * src)
+{
+    /*FNV-1a of the path or a mix of the pointer*/
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
+        uint32_t hash = 2166136261u;
+        const uint8_t * p;
+        for(p = src; *p; p++) hash = (hash ^ *p) * 16777619u;
+        return hash;
+    }
+
+    uint32_t hash = (uint32_t)(lv_uintptr_t)src;
+    hash ^= hash >> 16;
+    return hash * 0x9E3779B1u;
+}
+
+static uint32_t key_hash_get(uint32_t src_hash, lv_color_t color, int32_t frame_id)
+{
+    uint32_t hash = src_hash ^ (lv_color_to32(color) * 0x85EBCA77u) ^ ((uint32_t)frame_id * 0xC2B2AE3Du);
+    return hash ^ (hash >> 15);
+}
+
+/**
+ * Find an image in the hash table
+ * @return position in the table or -1 if not found
+ */
+static int32_t table_find(uint32_t hash, const void * src, lv_color_t color, int32_t frame_id)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint32_t pos = hash & table_mask;
+    while(table[pos] != TABLE_EMPTY) {
+        _lv_img_cache_entry_t * entry = &cache[table[pos]];
+        if(entry->hash == hash && color.full == entry->dec_dsc.color.full && frame_id == entry->dec_dsc.frame_id &&
+           lv_img_cache_match(src, entry->dec_dsc.src)) {
+            return pos;
+        }
+        pos = (pos + 1) & table_mask;
+    }
+
+    return -1;
+}
+
+/**
+ * Get the position of an entry in the hash table
+ */
+static uint32_t table_find_entry(uint32_t idx)
+{
+    uint32_t pos = LV_GC_ROOT(_lv_img_cache_array)[idx].hash & table_mask;
+    while(table[pos] != idx) pos = (pos + 1) & table_mask;
+    return pos;
+}
+
+static void table_insert(uint32_t idx)
+{
+    uint32_t pos = LV_GC_ROOT(_lv_img_cache_array)[idx].hash & table_mask;
+    while(table[pos] != TABLE_EMPTY) pos = (pos + 1) & table_mask;
+    table[pos] = idx;
+}
+
+/**
+ * Remove a position from the hash table and move back the next elements of its probe sequence
+ */
+static void table_remove(uint32_t pos)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint32_t next = pos;
+    while(1) {
+        next = (next + 1) & table_mask;
+        if(table[next] == TABLE_EMPTY) break;
+
+        /*Skip the element if its home position is (cyclically) between the freed and its current position*/
+        uint32_t home = cache[table[next]].hash & table_mask;
+        bool stay = pos <= next ? (pos < home && home <= next) : (pos < home || home <= next);
+        if(stay) continue;
+
+        table[pos] = table[next];
+        pos = next;
+    }
+
+    table[pos] = TABLE_EMPTY;
+}
+
+/**
+ * Store an opened image in the next free entry. There must be room for it.
+ */
+static _lv_img_cache_entry_t * entry_add(const _lv_img_cache_entry_t * tmp)
+{
+    uint32_t idx = used_cnt;
+    used_cnt++;
+    _lv_img_cache_entry_t * entry = &LV_GC_ROOT(_lv_img_cache_array)[idx];
+    *entry = *tmp;
+
+    entry->cached = 1;
+    entry->pinned = pin_find(entry->src_hash, entry->dec_dsc.src) >= 0;
+    entry_touch(entry);
+    mem_used += entry->size;
+    if(entry->dec_dsc.file_open) file_cnt++;
+    table_insert(idx);
+    return entry;
+}
+
+/**
+ * Close an entry and move the last entry to its place
+ */
+static void entry_remove(uint32_t idx)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    if(cache[idx].dec_dsc.file_open) file_cnt--;
+    lv_img_decoder_close(&cache[idx].dec_dsc);
+    mem_used -= cache[idx].size;
+    table_remove(table_find_entry(idx));
+
+    uint32_t last = used_cnt - 1;
+    if(idx != last) {
+        table[table_find_entry(last)] = idx;
+        cache[idx] = cache[last];
+    }
+
+    lv_memset_00(&cache[last], sizeof(_lv_img_cache_entry_t));
+    used_cnt--;
+}
+
+/**
+ * Set the priority of an entry when it's used.
+ * Images difficult to open and small images should live longer, so add time to open per kB to the clock.
+ */
+static void entry_touch(_lv_img_cache_entry_t * entry)
+{
+    if(prio_clock >= LV_IMG_CACHE_CLOCK_LIMIT) {
+        _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+        uint32_t i;
+        for(i = 0; i < used_cnt; i++) {
+            cache[i].prio = cache[i].prio > prio_clock ? cache[i].prio - prio_clock : 0;
+        }
+        prio_clock = 0;
+    }
+
+    uint32_t time_to_open = LV_MIN(entry->dec_dsc.time_to_open, LV_IMG_CACHE_TIME_LIMIT);
+    entry->prio = prio_clock + (time_to_open << 10) / ((entry->size >> 10) + 1);
+    entry->frame = frame_act;
+}
+
+/**
+ * Get the RAM used by an opened image: the decoded image and what the decoder keeps to read it line by line
+ */
+static uint32_t entry_get_size(const _lv_img_cache_entry_t * entry)
+{
+    const lv_img_decoder_dsc_t * dsc = &entry->dec_dsc;
+    if(dsc->img_data == NULL) return dsc->mem_size;
+
+    /*The variables are drawn from their own data*/
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && dsc->img_data == ((const lv_img_dsc_t *)dsc->src)->data) {
+        return dsc->mem_size;
+    }
+
+    return lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf) + dsc->mem_size;
+}
+
+/**
+ * Close the entries with the lowest priority until an image with the given size fits.
+ * The pinned entries and the entries used in the current refresh are not closed.
+ * @param size the size of the new image
+ * @param file_open true: the new image keeps its file open, so an other file might need to be closed
+ * @return true: the image fits; false: not enough entries could be closed
+ */
+static bool make_room(uint32_t size, bool file_open)
+{
+    if(mem_budget && size > mem_budget) return false;
+
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    while(1) {
+        bool file_full = file_max && file_cnt + (file_open ? 1 : 0) > file_max;
+        if(!file_full && used_cnt < entry_cnt && (mem_budget == 0 || mem_used + size <= mem_budget)) break;
+
+        int32_t victim = -1;
+        uint32_t i;
+        for(i = 0; i < used_cnt; i++) {
+            if(cache[i].pinned || cache[i].frame == frame_act) continue;
+            if(file_full && !cache[i].dec_dsc.file_open) continue;
+            if(victim < 0 || cache[i].prio < cache[victim].prio ||
+               (cache[i].prio == cache[victim].prio && cache[i].frame < cache[victim].frame)) {
+                victim = i;
+            }
+        }
+
+        if(victim < 0) return false;
+
+        if(cache[victim].prio > prio_clock) prio_clock = cache[victim].prio;
+        LV_LOG_INFO("image draw: close a cached image to free space");
+        entry_remove(victim);
+        stats.evict_cnt++;
+    }
+
+    return true;
+}
+
+static lv_vec_t * get_pins(void)
+{
+    lv_vec_t * pins = &LV_GC_ROOT(_lv_img_cache_pins);
+    if(pins->elem_size == 0) lv_vec_init(pins, sizeof(img_cache_pin_t));
+    return pins;
+}
+
+static int32_t pin_find(uint32_t src_hash, const void * src)
+{
+    lv_vec_t * pins = get_pins();
+    uint32_t i;
+    for(i = 0; i < lv_vec_get_cnt(pins); i++) {
+        img_cache_pin_t * pin = lv_vec_at(pins, i);
+        if(pin->src_hash == src_hash && lv_img_cache_match(src, pin->src)) return i;
+    }
+
+    return -1;
+}
+
+static void entries_set_pinned(uint32_t src_hash, const void * src, bool pinned)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint32_t i;
+    for(i = 0; i < used_cnt; i++) {
+        if(cache[i].src_hash == src_hash && lv_img_cache_match(src, cache[i].dec_dsc.src)) {
+            cache[i].pinned = pinned;
+        }
+    }
+}
 #endif
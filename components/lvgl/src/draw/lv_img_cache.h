@@ -31,12 +31,36 @@ extern "C" {
 typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information*/
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused*/
-    int32_t life;
+    uint32_t hash;          /**< Hash of the source, color and frame to find the entry quickly*/
+    uint32_t src_hash;      /**< Hash of the source only*/
+    uint32_t size;          /**< RAM used by the opened image in bytes (the decoded image or the decoder's buffers)*/
+
+    /** Entries with the lowest priority are closed first when the cache is full.
+     * When the entry is used it's set to the current "clock" of the cache + time to open / size.
+     * Evicting an entry moves the clock to the evicted entry's priority.
+     * This way the slow to open, small and recently used images live longer.*/
+    uint32_t prio;
+    uint32_t frame;         /**< The last display refresh where the entry was used*/
+    uint8_t pinned : 1;     /**< 1: the entry is not closed to free space for other images*/
+    uint8_t cached : 1;     /**< 0: a temporary entry which is closed after drawing*/
 } _lv_img_cache_entry_t;
 
+/**
+ * Statistics of the image cache
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of opens served from the cache*/
+    uint32_t miss_cnt;      /**< Number of opens which needed to open the image*/
+    uint32_t evict_cnt;     /**< Number of entries closed to free space for other images*/
+    uint32_t uncached_cnt;  /**< Number of opened images which couldn't be cached because they didn't fit*/
+    uint32_t entry_cnt;     /**< Number of images in the cache*/
+    uint32_t entry_max;     /**< Maximal number of images in the cache*/
+    uint32_t pinned_cnt;    /**< Number of pinned images in the cache*/
+    uint32_t mem_used;      /**< Size of the decoded images and the decoders' buffers in the cache in bytes*/
+    uint32_t mem_budget;    /**< Maximal size of the decoded images in the cache in bytes (0: not limited)*/
+    uint32_t file_cnt;      /**< Number of images in the cache which keep their file open*/
+} lv_img_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -45,6 +69,7 @@ typedef struct {
  * Open an image using the image decoder interface and cache it.
  * The image will be left open meaning if the image decoder open callback allocated memory then it will remain.
  * The image is closed if a new image is opened and the new image takes its place in the cache.
+ * Call `_lv_img_cache_release` when the returned entry is not used anymore.
  * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
  * @param color The color of the image with `LV_IMG_CF_ALPHA_...`
  * @param frame_id the index of the frame. Used only with animated images, set 0 for normal images
@@ -52,6 +77,45 @@ typedef struct {
  */
 _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, int32_t frame_id);
 
+/**
+ * Release an entry returned by `_lv_img_cache_open`.
+ * The image is closed if it couldn't be cached.
+ * @param entry pointer to a cache entry
+ */
+void _lv_img_cache_release(_lv_img_cache_entry_t * entry);
+
+/**
+ * Find an image in the cache without opening it.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color The color of the image with `LV_IMG_CF_ALPHA_...`
+ * @param frame_id the index of the frame
+ * @return pointer to the cache entry or NULL if the image is not cached
+ */
+_lv_img_cache_entry_t * _lv_img_cache_find(const void * src, lv_color_t color, int32_t frame_id);
+
+/**
+ * Add an image which was opened without `_lv_img_cache_open` (e.g. decoded in the background) to the cache.
+ * An entry of the same image is replaced. The cache takes the ownership of the image and closes it
+ * with `lv_img_decoder_close` when the entry is removed.
+ * @param dsc the opened image. `src` has to be allocated as `lv_img_decoder_open` does for files.
+ * @return LV_RES_OK: the image is cached; LV_RES_INV: the image doesn't fit, it's not closed
+ */
+lv_res_t _lv_img_cache_add(const lv_img_decoder_dsc_t * dsc);
+
+/**
+ * Check if an image can be cached at all, i.e. the cache is enabled and the image is not larger than the memory budget.
+ * @param size size of the decoded image in bytes
+ * @return true: the image can be cached (maybe by closing other images)
+ */
+bool _lv_img_cache_can_fit(uint32_t size);
+
+/**
+ * Tell the cache that a new display refresh is started.
+ * The images used in the current refresh are not closed to free space for an other image of the same refresh,
+ * rather the new image is not cached.
+ */
+void _lv_img_cache_next_frame(void);
+
 /**
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
@@ -60,13 +124,71 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Limit the total size of the decoded images in the cache. The buffers of the decoders which read the images
+ * line by line are counted too.
+ * If a new image doesn't fit the least valuable images are closed. Images larger than the limit are not cached.
+ * @param size the limit in bytes. 0: only the number of images is limited
+ */
+void lv_img_cache_set_mem_budget(uint32_t size);
+
+/**
+ * Limit the number of cached images which keep their file open to read it line by line (e.g. SJPG, `.bin` files).
+ * Useful if the file system can open only a few files at once. If a new image would exceed the limit
+ * an other such image is closed, or the new image is not cached.
+ * @param cnt the maximal number of open files. 0: not limited
+ */
+void lv_img_cache_set_file_max(uint16_t cnt);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
  * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ *            NULL to invalidate all the images.
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+/**
+ * Pin an image source in the cache. Pinned images are not closed to free space for other images,
+ * e.g. pin the icons of a screen while it's loaded. Pins are counted so `lv_img_cache_unpin` has to be called
+ * as many times as `lv_img_cache_pin` was called. The source can be pinned before the image is opened.
+ * Pinned images still count in the memory budget and can be closed by `lv_img_cache_invalidate_src`.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ *            Paths are copied.
+ */
+void lv_img_cache_pin(const void * src);
+
+/**
+ * Remove a pin of an image source
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ */
+void lv_img_cache_unpin(const void * src);
+
+/**
+ * Get the statistics of the image cache
+ * @param stats store the statistics here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss, evict and uncached counters of the image cache
+ */
+void lv_img_cache_reset_stats(void);
+
+/**
+ * Allocate memory for a decoded image. Image decoders should allocate the decoded pixels with it
+ * so that they can be stored in a separate heap (e.g. in PSRAM) if `LV_IMG_CACHE_MEM_CUSTOM` is enabled.
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the allocated memory or NULL on error
+ */
+void * lv_img_cache_mem_alloc(size_t size);
+
+/**
+ * Free a memory allocated by `lv_img_cache_mem_alloc`
+ * @param data pointer to the memory to free
+ */
+void lv_img_cache_mem_free(void * data);
+
 /**********************
  *      MACROS
  **********************/
@@ -55,7 +55,7 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
  */
 void _lv_img_decoder_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_img_decoder_ll), sizeof(lv_img_decoder_t));
+    lv_vec_init(&LV_GC_ROOT(_lv_img_decoder_list), sizeof(lv_img_decoder_t *));
 
     lv_img_decoder_t * decoder;
 
@@ -93,8 +93,10 @@ lv_res_t lv_img_decoder_get_info(const void * src, lv_img_header_t * header)
     }
 
     lv_res_t res = LV_RES_INV;
-    lv_img_decoder_t * d;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_img_decoder_ll), d) {
+    const lv_vec_t * list = &LV_GC_ROOT(_lv_img_decoder_list);
+    uint32_t i;
+    for(i = list->cnt; i > 0; i--) {
+        lv_img_decoder_t * d = *(lv_img_decoder_t **)lv_vec_at(list, i - 1);
         if(d->info_cb) {
             res = d->info_cb(d, src, header);
             if(res == LV_RES_OK) break;
@@ -135,8 +137,10 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
 
     lv_res_t res = LV_RES_INV;
 
-    lv_img_decoder_t * decoder;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_img_decoder_ll), decoder) {
+    const lv_vec_t * list = &LV_GC_ROOT(_lv_img_decoder_list);
+    uint32_t i;
+    for(i = list->cnt; i > 0; i--) {
+        lv_img_decoder_t * decoder = *(lv_img_decoder_t **)lv_vec_at(list, i - 1);
         /*Info and Open callbacks are required*/
         if(decoder->info_cb == NULL || decoder->open_cb == NULL) continue;
 
@@ -156,6 +160,8 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
         dsc->img_data  = NULL;
         dsc->user_data = NULL;
         dsc->time_to_open = 0;
+        dsc->mem_size = 0;
+        dsc->file_open = 0;
     }
 
     if(dsc->src_type == LV_IMG_SRC_FILE)
@@ -181,6 +187,31 @@ lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_c
     return res;
 }
 
+/**
+ * Read an area from an opened image.
+ * Uses the `read_area_cb` of the decoder if set, else reads the area line by line.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param area the area to read in image coordinates
+ * @param buf store the data here, `lv_area_get_width(area)` pixels per line
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred
+ */
+lv_res_t lv_img_decoder_read_area(lv_img_decoder_dsc_t * dsc, const lv_area_t * area, uint8_t * buf)
+{
+    if(dsc->decoder->read_area_cb) return dsc->decoder->read_area_cb(dsc->decoder, dsc, area, buf);
+
+    lv_coord_t w = lv_area_get_width(area);
+    uint32_t px_size = lv_img_cf_has_alpha(dsc->header.cf) ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    uint32_t line_size = w * px_size;
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_res_t res = lv_img_decoder_read_line(dsc, area->x1, y, w, buf);
+        if(res != LV_RES_OK) return res;
+        buf += line_size;
+    }
+
+    return LV_RES_OK;
+}
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -203,12 +234,19 @@ void lv_img_decoder_close(lv_img_decoder_dsc_t * dsc)
  */
 lv_img_decoder_t * lv_img_decoder_create(void)
 {
-    lv_img_decoder_t * decoder;
-    decoder = _lv_ll_ins_head(&LV_GC_ROOT(_lv_img_decoder_ll));
+    lv_img_decoder_t * decoder = lv_mem_alloc(sizeof(lv_img_decoder_t));
     LV_ASSERT_MALLOC(decoder);
     if(decoder == NULL) return NULL;
 
+    /*The decoders are tried from the last one so the new decoder comes first*/
+    lv_img_decoder_t ** decoder_p = lv_vec_push(&LV_GC_ROOT(_lv_img_decoder_list));
+    if(decoder_p == NULL) {
+        lv_mem_free(decoder);
+        return NULL;
+    }
+
     lv_memset_00(decoder, sizeof(lv_img_decoder_t));
+    *decoder_p = decoder;
 
     return decoder;
 }
@@ -219,10 +257,38 @@ lv_img_decoder_t * lv_img_decoder_create(void)
  */
 void lv_img_decoder_delete(lv_img_decoder_t * decoder)
 {
-    _lv_ll_remove(&LV_GC_ROOT(_lv_img_decoder_ll), decoder);
+    lv_vec_t * list = &LV_GC_ROOT(_lv_img_decoder_list);
+    uint32_t i;
+    for(i = 0; i < list->cnt; i++) {
+        if(*(lv_img_decoder_t **)lv_vec_at(list, i) == decoder) {
+            lv_vec_remove(list, i);
+            break;
+        }
+    }
     lv_mem_free(decoder);
 }
 
+/**
+ * Iterate through the image decoders in the order they are tried (the newest first)
+ * @param decoder NULL to start iteration or the previous return value to get the next decoder
+ * @return the next decoder or NULL if there are no more decoders
+ */
+lv_img_decoder_t * lv_img_decoder_get_next(lv_img_decoder_t * decoder)
+{
+    const lv_vec_t * list = &LV_GC_ROOT(_lv_img_decoder_list);
+    lv_img_decoder_t ** decoders = (lv_img_decoder_t **)list->data;
+    uint32_t i = list->cnt;
+
+    /*The last decoders are the most likely to be passed back, search from there*/
+    if(decoder) {
+        while(i > 0 && decoders[i - 1] != decoder) i--;
+        if(i == 0) return NULL;
+        i--;
+    }
+
+    return i > 0 ? decoders[i - 1] : NULL;
+}
+
 /**
  * Set a callback to get information about the image
  * @param decoder pointer to an image decoder
@@ -253,6 +319,16 @@ void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_
     decoder->read_line_cb = read_line_cb;
 }
 
+/**
+ * Set a callback to decode an area of an image
+ * @param decoder pointer to an image decoder
+ * @param read_area_cb a function to read an area of an image
+ */
+void lv_img_decoder_set_read_area_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_area_f_t read_area_cb)
+{
+    decoder->read_area_cb = read_area_cb;
+}
+
 /**
  * Set a callback to close a decoding session. E.g. close files and free other resources.
  * @param decoder pointer to an image decoder
@@ -351,6 +427,8 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 
         lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
         lv_memcpy_small(&user_data->f, &f, sizeof(f));
+        dsc->mem_size = sizeof(lv_img_decoder_built_in_data_t);
+        dsc->file_open = 1;
     }
     else if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         /*The variables should have valid data*/
@@ -427,6 +505,7 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             lv_img_decoder_built_in_close(decoder, dsc);
             return LV_RES_INV;
         }
+        dsc->mem_size = sizeof(lv_img_decoder_built_in_data_t) + palette_size * (sizeof(lv_color_t) + sizeof(lv_opa_t));
 
         if(dsc->src_type == LV_IMG_SRC_FILE) {
             /*Read the palette from file*/
@@ -75,6 +75,20 @@ typedef lv_res_t (*lv_img_decoder_open_f_t)(struct _lv_img_decoder_t * decoder,
 typedef lv_res_t (*lv_img_decoder_read_line_f_t)(struct _lv_img_decoder_t * decoder, struct _lv_img_decoder_dsc_t * dsc,
                                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
 
+/**
+ * Decode the pixels of an area of the image and store them in `buf` line by line.
+ * Optional. Useful for decoders which work in blocks (e.g. JPEG) and can skip the parts outside of the area.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the area to decode in image coordinates
+ * @param buf a buffer to store the decoded pixels. It has the same pixel format as the lines of `read_line`
+ *            (`lv_color_t` or `LV_IMG_PX_SIZE_ALPHA_BYTE` bytes if the image has alpha)
+ *            and `lv_area_get_width(area)` pixels in each line.
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+typedef lv_res_t (*lv_img_decoder_read_area_f_t)(struct _lv_img_decoder_t * decoder, struct _lv_img_decoder_dsc_t * dsc,
+                                                 const lv_area_t * area, uint8_t * buf);
+
 /**
  * Close the pending decoding. Free resources etc.
  * @param decoder pointer to the decoder the function associated with
@@ -87,6 +101,7 @@ typedef struct _lv_img_decoder_t {
     lv_img_decoder_info_f_t info_cb;
     lv_img_decoder_open_f_t open_cb;
     lv_img_decoder_read_line_f_t read_line_cb;
+    lv_img_decoder_read_area_f_t read_area_cb;
     lv_img_decoder_close_f_t close_cb;
 
 #if LV_USE_USER_DATA
@@ -119,6 +134,13 @@ typedef struct _lv_img_decoder_dsc_t {
      *  MUST be set in `open` function*/
     const uint8_t * img_data;
 
+    /** RAM kept by the decoder while the image is open besides `img_data` (e.g. line buffers, palette) [bytes].
+     *  Can be set in `open` function to count it in the memory budget of the image cache*/
+    uint32_t mem_size;
+
+    /** 1: the decoder keeps the file open until the image is closed. Can be set in `open` function*/
+    uint8_t file_open : 1;
+
     /** How much time did it take to open the image. [ms]
      *  If not set `lv_img_cache` will measure and set the time to open*/
     uint32_t time_to_open;
@@ -179,6 +201,16 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
 lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
                                   uint8_t * buf);
 
+/**
+ * Read an area from an opened image.
+ * Uses the `read_area_cb` of the decoder if set, else reads the area line by line.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param area the area to read in image coordinates
+ * @param buf store the data here, `lv_area_get_width(area)` pixels per line
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred
+ */
+lv_res_t lv_img_decoder_read_area(lv_img_decoder_dsc_t * dsc, const lv_area_t * area, uint8_t * buf);
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -197,6 +229,13 @@ lv_img_decoder_t * lv_img_decoder_create(void);
  */
 void lv_img_decoder_delete(lv_img_decoder_t * decoder);
 
+/**
+ * Iterate through the image decoders in the order they are tried (the newest first)
+ * @param decoder NULL to start iteration or the previous return value to get the next decoder
+ * @return the next decoder or NULL if there are no more decoders
+ */
+lv_img_decoder_t * lv_img_decoder_get_next(lv_img_decoder_t * decoder);
+
 /**
  * Set a callback to get information about the image
  * @param decoder pointer to an image decoder
@@ -218,6 +257,13 @@ void lv_img_decoder_set_open_cb(lv_img_decoder_t * decoder, lv_img_decoder_open_
  */
 void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_line_f_t read_line_cb);
 
+/**
+ * Set a callback to decode an area of an image
+ * @param decoder pointer to an image decoder
+ * @param read_area_cb a function to read an area of an image
+ */
+void lv_img_decoder_set_read_area_cb(lv_img_decoder_t * decoder, lv_img_decoder_read_area_f_t read_area_cb);
+
 /**
  * Set a callback to close a decoding session. E.g. close files and free other resources.
  * @param decoder pointer to an image decoder
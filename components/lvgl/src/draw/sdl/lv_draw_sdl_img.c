@@ -205,6 +205,7 @@ bool lv_draw_sdl_img_load_texture(lv_draw_sdl_ctx_t * ctx, lv_draw_sdl_cache_key
     lv_draw_sdl_cache_flag_t tex_flags = 0;
     SDL_Rect rect;
     SDL_memset(&rect, 0, sizeof(SDL_Rect));
+    lv_img_header_t img_header;
     if(cdsc) {
         lv_img_decoder_dsc_t * dsc = &cdsc->dec_dsc;
         if(dsc->user_data && SDL_memcmp(dsc->user_data, LV_DRAW_SDL_DEC_DSC_TEXTURE_HEAD, 8) == 0) {
@@ -219,13 +220,12 @@ bool lv_draw_sdl_img_load_texture(lv_draw_sdl_ctx_t * ctx, lv_draw_sdl_cache_key
         else {
             *texture = upload_img_texture(ctx->renderer, dsc);
         }
-#if LV_IMG_CACHE_DEF_SIZE == 0
-        lv_img_decoder_close(dsc);
-#endif
+        img_header = dsc->header;
+        _lv_img_cache_release(cdsc);
     }
     if(texture && cdsc) {
         *header = lv_mem_alloc(sizeof(lv_draw_sdl_img_header_t));
-        SDL_memcpy(&(*header)->base, &cdsc->dec_dsc.header, sizeof(lv_img_header_t));
+        SDL_memcpy(&(*header)->base, &img_header, sizeof(lv_img_header_t));
         (*header)->rect = rect;
         (*header)->managed = (tex_flags & LV_DRAW_SDL_CACHE_FLAG_MANAGED) != 0;
         *texture_in_cache = lv_draw_sdl_texture_cache_put_advanced(ctx, key, key_size, *texture, *header, SDL_free,
@@ -54,13 +54,18 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 static void flex_update(lv_obj_t * cont, void * user_data);
+static void flex_update_finish(lv_obj_t * cont, lv_coord_t w_set, lv_coord_t h_set);
 static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id, lv_coord_t max_main_size,
                               lv_coord_t item_gap, track_t * t);
 static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, int32_t item_last_id, lv_coord_t abs_x,
                            lv_coord_t abs_y, lv_coord_t max_main_size, lv_coord_t item_gap, track_t * t);
+static bool children_repos_from(lv_obj_t * cont, flex_t * f, uint32_t item_first_id, lv_coord_t abs_x, lv_coord_t abs_y,
+                                lv_coord_t item_gap);
 static void place_content(lv_flex_align_t place, lv_coord_t max_size, lv_coord_t content_size, lv_coord_t item_cnt,
                           lv_coord_t * start_pos, lv_coord_t * gap);
 static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id);
+static void item_move_to(lv_obj_t * item, lv_coord_t x, lv_coord_t y);
+static lv_coord_t get_item_translate(lv_obj_t * item, bool row);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -118,7 +123,7 @@ void lv_obj_set_flex_align(lv_obj_t * obj, lv_flex_align_t main_place, lv_flex_a
 void lv_obj_set_flex_grow(lv_obj_t * obj, uint8_t grow)
 {
     lv_obj_set_style_flex_grow(obj, grow, 0);
-    lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
+    lv_obj_mark_parent_layout_as_dirty(obj);
 }
 
 
@@ -250,9 +255,32 @@ static void flex_update(lv_obj_t * cont, void * user_data)
         else if(track_cross_place == LV_FLEX_ALIGN_END) track_cross_place = LV_FLEX_ALIGN_START;
     }
 
+    /*Can't wrap if the size if auto (i.e. the size depends on the children)*/
+    if(f.wrap && ((f.row && w_set == LV_SIZE_CONTENT) || (!f.row && h_set == LV_SIZE_CONTENT))) {
+        f.wrap = 0;
+    }
+
+    /*With a single track, `START` placements and without grow items the position of an item depends
+     *only on the items before it. In this case the clean children (the ones before the first changed child)
+     *are left where they are and only the rest is positioned.*/
+    bool incremental = !f.wrap && !f.rev && !rtl &&
+                       f.main_place == LV_FLEX_ALIGN_START && f.cross_place == LV_FLEX_ALIGN_START &&
+                       track_cross_place == LV_FLEX_ALIGN_START;
+    uint32_t clean_cnt = cont->spec_attr->layout_clean_cnt;
+    cont->spec_attr->layout_clean_cnt = 0;
+
+    if(incremental && clean_cnt > 0 && clean_cnt <= cont->spec_attr->child_cnt) {
+        if(children_repos_from(cont, &f, clean_cnt, abs_x, abs_y, item_gap)) {
+            flex_update_finish(cont, w_set, h_set);
+            return;
+        }
+    }
+
     lv_coord_t total_track_cross_size = 0;
     lv_coord_t gap = 0;
     uint32_t track_cnt = 0;
+    uint32_t repos_track_cnt = 0;
+    bool has_grow = false;
     int32_t track_first_item;
     int32_t next_track_first_item;
 
@@ -291,6 +319,8 @@ static void flex_update(lv_obj_t * cont, void * user_data)
             *cross_pos -= t.track_cross_size;
         }
         children_repos(cont, &f, track_first_item, next_track_first_item, abs_x, abs_y, max_main_size, item_gap, &t);
+        if(t.grow_item_cnt) has_grow = true;
+        repos_track_cnt++;
         track_first_item = next_track_first_item;
         lv_mem_buf_release(t.grow_dsc);
         t.grow_dsc = NULL;
@@ -303,6 +333,16 @@ static void flex_update(lv_obj_t * cont, void * user_data)
     }
     LV_ASSERT_MEM_INTEGRITY();
 
+    /*The next update can start from the first changed child*/
+    if(incremental && !has_grow && repos_track_cnt <= 1) {
+        cont->spec_attr->layout_clean_cnt = cont->spec_attr->child_cnt;
+    }
+
+    flex_update_finish(cont, w_set, h_set);
+}
+
+static void flex_update_finish(lv_obj_t * cont, lv_coord_t w_set, lv_coord_t h_set)
+{
     if(w_set == LV_SIZE_CONTENT || h_set == LV_SIZE_CONTENT) {
         lv_obj_refr_size(cont);
     }
@@ -318,13 +358,6 @@ static void flex_update(lv_obj_t * cont, void * user_data)
 static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id, lv_coord_t max_main_size,
                               lv_coord_t item_gap, track_t * t)
 {
-    lv_coord_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
-    lv_coord_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
-
-    /*Can't wrap if the size if auto (i.e. the size depends on the children)*/
-    if(f->wrap && ((f->row && w_set == LV_SIZE_CONTENT) || (!f->row && h_set == LV_SIZE_CONTENT))) {
-        f->wrap = false;
-    }
     lv_coord_t(*get_main_size)(const lv_obj_t *) = (f->row ? lv_obj_get_width : lv_obj_get_height);
     lv_coord_t(*get_cross_size)(const lv_obj_t *) = (!f->row ? lv_obj_get_width : lv_obj_get_height);
 
@@ -461,7 +494,7 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
             item = get_next_item(cont, f->rev, &item_first_id);
             continue;
         }
-        lv_coord_t grow_size = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
+        lv_coord_t grow_size = t->grow_item_cnt ? lv_obj_get_style_flex_grow(item, LV_PART_MAIN) : 0;
         if(grow_size) {
             lv_coord_t s = 0;
             for(i = 0; i < t->grow_item_cnt; i++) {
@@ -486,6 +519,7 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
                 lv_area_t old_coords;
                 lv_area_copy(&old_coords, &item->coords);
                 area_set_main_size(&item->coords, s);
+                _lv_obj_spatial_child_moved(item, &old_coords);
                 lv_event_send(item, LV_EVENT_SIZE_CHANGED, &old_coords);
                 lv_event_send(lv_obj_get_parent(item), LV_EVENT_CHILD_CHANGED, item);
                 lv_obj_invalidate(item);
@@ -514,27 +548,9 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
 
 
         /*Handle percentage value of translate*/
-        lv_coord_t tr_x = lv_obj_get_style_translate_x(item, LV_PART_MAIN);
-        lv_coord_t tr_y = lv_obj_get_style_translate_y(item, LV_PART_MAIN);
-        lv_coord_t w = lv_obj_get_width(item);
-        lv_coord_t h = lv_obj_get_height(item);
-        if(LV_COORD_IS_PCT(tr_x)) tr_x = (w * LV_COORD_GET_PCT(tr_x)) / 100;
-        if(LV_COORD_IS_PCT(tr_y)) tr_y = (h * LV_COORD_GET_PCT(tr_y)) / 100;
-
-        lv_coord_t diff_x = abs_x - item->coords.x1 + tr_x;
-        lv_coord_t diff_y = abs_y - item->coords.y1 + tr_y;
-        diff_x += f->row ? main_pos : cross_pos;
-        diff_y += f->row ? cross_pos : main_pos;
-
-        if(diff_x || diff_y) {
-            lv_obj_invalidate(item);
-            item->coords.x1 += diff_x;
-            item->coords.x2 += diff_x;
-            item->coords.y1 += diff_y;
-            item->coords.y2 += diff_y;
-            lv_obj_invalidate(item);
-            lv_obj_move_children_by(item, diff_x, diff_y, false);
-        }
+        lv_coord_t tr_x = get_item_translate(item, true);
+        lv_coord_t tr_y = get_item_translate(item, false);
+        item_move_to(item, abs_x + tr_x + (f->row ? main_pos : cross_pos), abs_y + tr_y + (f->row ? cross_pos : main_pos));
 
         if(!(f->row && rtl)) main_pos += area_get_main_size(&item->coords) + item_gap + place_gap;
         else main_pos -= item_gap + place_gap;
@@ -543,6 +559,90 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
     }
 }
 
+/**
+ * Position the items from `item_first_id` after the clean items before it. Only for a single track
+ * with `START` placements. It stops if a grow or new track item is found, as then all the items
+ * need to be positioned normally.
+ * @return true: the items are positioned; false: not possible
+ */
+static bool children_repos_from(lv_obj_t * cont, flex_t * f, uint32_t item_first_id, lv_coord_t abs_x, lv_coord_t abs_y,
+                                lv_coord_t item_gap)
+{
+    lv_coord_t (*area_get_main_size)(const lv_area_t *) = (f->row ? lv_area_get_width : lv_area_get_height);
+    const lv_obj_flag_t skip_flags = LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING;
+
+    /*Continue after the last positioned clean item*/
+    lv_coord_t main_pos = 0;
+    int32_t i;
+    for(i = (int32_t)item_first_id - 1; i >= 0; i--) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+        if(lv_obj_has_flag_any(item, skip_flags)) continue;
+
+        lv_coord_t item_main_pos = f->row ? item->coords.x1 - abs_x : item->coords.y1 - abs_y;
+        main_pos = item_main_pos - get_item_translate(item, f->row) + area_get_main_size(&item->coords) + item_gap;
+        break;
+    }
+
+    uint32_t child_cnt = cont->spec_attr->child_cnt;
+    uint32_t id;
+    for(id = item_first_id; id < child_cnt; id++) {
+        lv_obj_t * item = cont->spec_attr->children[id];
+        if(lv_obj_has_flag(item, LV_OBJ_FLAG_FLEX_IN_NEW_TRACK)) return false;
+        if(lv_obj_has_flag_any(item, skip_flags)) continue;
+        if(lv_obj_get_style_flex_grow(item, LV_PART_MAIN)) return false;
+
+        item->w_layout = 0;
+        item->h_layout = 0;
+
+        lv_coord_t tr_x = get_item_translate(item, true);
+        lv_coord_t tr_y = get_item_translate(item, false);
+        item_move_to(item, abs_x + tr_x + (f->row ? main_pos : 0), abs_y + tr_y + (f->row ? 0 : main_pos));
+
+        main_pos += area_get_main_size(&item->coords) + item_gap;
+    }
+
+    cont->spec_attr->layout_clean_cnt = child_cnt;
+    return true;
+}
+
+/**
+ * Move an item and its children to a new position if it's different from the current one
+ */
+static void item_move_to(lv_obj_t * item, lv_coord_t x, lv_coord_t y)
+{
+    lv_coord_t diff_x = x - item->coords.x1;
+    lv_coord_t diff_y = y - item->coords.y1;
+    if(diff_x == 0 && diff_y == 0) return;
+
+    /*Moving doesn't change the look of the item*/
+    bool bitmap_valid = _lv_obj_bitmap_cache_is_valid(item);
+    lv_obj_invalidate(item);
+    lv_area_t ori;
+    lv_area_copy(&ori, &item->coords);
+    item->coords.x1 += diff_x;
+    item->coords.x2 += diff_x;
+    item->coords.y1 += diff_y;
+    item->coords.y2 += diff_y;
+    _lv_obj_spatial_child_moved(item, &ori);
+    lv_obj_invalidate(item);
+    if(bitmap_valid) _lv_obj_bitmap_cache_set_valid(item);
+    lv_obj_move_children_by(item, diff_x, diff_y, false);
+}
+
+/**
+ * Get the horizontal or vertical translation of an item with resolved percentage
+ */
+static lv_coord_t get_item_translate(lv_obj_t * item, bool hor)
+{
+    lv_coord_t tr = hor ? lv_obj_get_style_translate_x(item, LV_PART_MAIN) : lv_obj_get_style_translate_y(item,
+                                                                                                          LV_PART_MAIN);
+    if(LV_COORD_IS_PCT(tr)) {
+        lv_coord_t size = hor ? lv_obj_get_width(item) : lv_obj_get_height(item);
+        tr = (size * LV_COORD_GET_PCT(tr)) / 100;
+    }
+    return tr;
+}
+
 /**
  * Tell a start coordinate and gap for a placement type.
  */
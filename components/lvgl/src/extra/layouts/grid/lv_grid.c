@@ -169,7 +169,7 @@ void lv_obj_set_grid_cell(lv_obj_t * obj, lv_grid_align_t x_align, uint8_t col_p
     lv_obj_set_style_grid_cell_row_span(obj, row_span, 0);
     lv_obj_set_style_grid_cell_y_align(obj, y_align, 0);
 
-    lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
+    lv_obj_mark_parent_layout_as_dirty(obj);
 }
 
 
@@ -661,6 +661,7 @@ static void item_repos(lv_obj_t * item, _lv_grid_calc_t * c, item_repos_hint_t *
         lv_obj_invalidate(item);
         lv_area_set_width(&item->coords, item_w);
         lv_area_set_height(&item->coords, item_h);
+        _lv_obj_spatial_child_moved(item, &old_coords);
         lv_obj_invalidate(item);
         lv_event_send(item, LV_EVENT_SIZE_CHANGED, &old_coords);
         lv_event_send(lv_obj_get_parent(item), LV_EVENT_CHILD_CHANGED, item);
@@ -681,12 +682,18 @@ static void item_repos(lv_obj_t * item, _lv_grid_calc_t * c, item_repos_hint_t *
     lv_coord_t diff_x = hint->grid_abs.x + x - item->coords.x1;
     lv_coord_t diff_y = hint->grid_abs.y + y - item->coords.y1;
     if(diff_x || diff_y) {
+        /*Moving doesn't change the look of the item*/
+        bool bitmap_valid = _lv_obj_bitmap_cache_is_valid(item);
         lv_obj_invalidate(item);
+        lv_area_t ori;
+        lv_area_copy(&ori, &item->coords);
         item->coords.x1 += diff_x;
         item->coords.x2 += diff_x;
         item->coords.y1 += diff_y;
         item->coords.y2 += diff_y;
+        _lv_obj_spatial_child_moved(item, &ori);
         lv_obj_invalidate(item);
+        if(bitmap_valid) _lv_obj_bitmap_cache_set_valid(item);
         lv_obj_move_children_by(item, diff_x, diff_y, false);
     }
 }
@@ -179,6 +179,8 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
         memcpy(dsc->user_data, &b, sizeof(b));
 
         dsc->img_data = NULL;
+        dsc->mem_size = sizeof(bmp_dsc_t);
+        dsc->file_open = 1;
         return LV_RES_OK;
     }
     /* BMP file as data not supported for simplicity.
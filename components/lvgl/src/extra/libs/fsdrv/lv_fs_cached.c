@@ -0,0 +1,714 @@
+/**
+ * @file lv_fs_cached.c
+ *
+ */
+
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_FS_CACHED
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if LV_FS_CACHED_LETTER == '\0'
+    #error "LV_FS_CACHED_LETTER must be an upper case ASCII letter"
+#endif
+
+#define BLOCK_SIZE  LV_FS_CACHED_BLOCK_SIZE
+#define BLOCK_CNT   (LV_FS_CACHED_SIZE / LV_FS_CACHED_BLOCK_SIZE)
+
+#if BLOCK_CNT < 2
+    #error "LV_FS_CACHED_SIZE must be at least 2 * LV_FS_CACHED_BLOCK_SIZE"
+#endif
+
+/*Keep at least one block for the data which was requested*/
+#define READ_AHEAD  LV_MIN(LV_FS_CACHED_READ_AHEAD, BLOCK_CNT - 1)
+
+#define NO_READ     UINT32_MAX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A file which has open handles or cached blocks.
+ * The blocks are bound to the path so they survive closing and reopening the file.
+ */
+typedef struct _file_rec_t {
+    struct _file_rec_t * next;
+    uint32_t size;              /*Size of the file*/
+    time_t mtime;               /*Modification time of the file when it was opened*/
+    uint16_t ref_cnt;           /*Number of open handles*/
+    uint16_t block_cnt;         /*Number of cached blocks*/
+    char path[];
+} file_rec_t;
+
+typedef struct _block_t {
+    struct _block_t * hash_next;
+    struct _block_t * prev;     /*Towards the most recently used block*/
+    struct _block_t * next;     /*Towards the least recently used block*/
+    file_rec_t * rec;           /*NULL if the block is free*/
+    uint32_t index;             /*Index of the block in the file*/
+    uint32_t len;               /*Valid bytes. Less than `BLOCK_SIZE` only at the end of the file.*/
+    uint8_t * data;
+} block_t;
+
+typedef struct {
+    int fd;
+    file_rec_t * rec;
+    uint32_t pos;               /*Position of lv_fs_read/write*/
+    uint32_t fd_pos;            /*Position of the OS file. Seek only if it differs from the needed position.*/
+    uint32_t read_end;          /*End of the last read. A read from here is sequential.*/
+    uint8_t written : 1;
+} cached_file_t;
+
+typedef struct {
+    block_t * blocks;
+    block_t ** hash;
+    uint32_t hash_mask;
+    block_t * lru_head;         /*The most recently used block*/
+    block_t * lru_tail;         /*The least recently used or a free block*/
+    file_rec_t * recs;
+} block_cache_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn);
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
+
+static lv_res_t cache_init(void);
+static file_rec_t * rec_get(const char * path, const struct stat * st);
+static void rec_release(file_rec_t * rec);
+static void rec_free(file_rec_t * rec);
+static block_t * block_find(const file_rec_t * rec, uint32_t index);
+static block_t * block_load(cached_file_t * f, uint32_t index, lv_fs_res_t * res);
+static void block_drop(block_t * b);
+static void drop_blocks(const file_rec_t * rec, uint32_t first, uint32_t last);
+static void lru_touch(block_t * b);
+static lv_fs_res_t dev_read(cached_file_t * f, uint32_t pos, void * buf, uint32_t len, uint32_t * got);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static block_cache_t cache;
+static lv_fs_cached_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Register a driver for the File system interface
+ */
+void lv_fs_cached_init(void)
+{
+    /*---------------------------------------------------
+     * Register the file system interface in LVGL
+     *--------------------------------------------------*/
+
+    /*Add a simple drive to open images*/
+    static lv_fs_drv_t fs_drv; /*A driver descriptor*/
+    lv_fs_drv_init(&fs_drv);
+
+    /*Set up fields...*/
+    fs_drv.letter = LV_FS_CACHED_LETTER;
+    fs_drv.cache_size = 0;  /*The blocks are cached by the driver*/
+
+    fs_drv.open_cb = fs_open;
+    fs_drv.close_cb = fs_close;
+    fs_drv.read_cb = fs_read;
+    fs_drv.write_cb = fs_write;
+    fs_drv.seek_cb = fs_seek;
+    fs_drv.tell_cb = fs_tell;
+
+    fs_drv.dir_close_cb = fs_dir_close;
+    fs_drv.dir_open_cb = fs_dir_open;
+    fs_drv.dir_read_cb = fs_dir_read;
+
+    lv_fs_drv_register(&fs_drv);
+}
+
+/**
+ * Get the statistics of the accesses since the start or the last `lv_fs_cached_reset_stats()`
+ * @param stats_p   store the statistics here
+ */
+void lv_fs_cached_get_stats(lv_fs_cached_stats_t * stats_p)
+{
+    *stats_p = stats;
+}
+
+/**
+ * Reset the statistics
+ */
+void lv_fs_cached_reset_stats(void)
+{
+    lv_memset_00(&stats, sizeof(stats));
+}
+
+/**
+ * Drop the cached blocks of a file. Needed if the file is changed bypassing the driver
+ * and its size and modification time might remain the same.
+ * @param path      path of the file as passed to the driver (without the driver letter), NULL to drop all blocks
+ */
+void lv_fs_cached_invalidate(const char * path)
+{
+    if(cache.blocks == NULL) return;
+
+    char buf[256];
+    if(path) lv_snprintf(buf, sizeof(buf), LV_FS_CACHED_PATH "%s", path);
+
+    uint32_t i;
+    for(i = 0; i < BLOCK_CNT; i++) {
+        block_t * b = &cache.blocks[i];
+        if(b->rec && (path == NULL || strcmp(b->rec->path, buf) == 0)) block_drop(b);
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Open a file
+ * @param drv pointer to a driver where this function belongs
+ * @param path path to the file beginning with the driver letter (e.g. S:/folder/file.txt)
+ * @param mode read: FS_MODE_RD, write: FS_MODE_WR, both: FS_MODE_RD | FS_MODE_WR
+ * @return a file handle or NULL in case of fail
+ */
+static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+
+    if(cache.blocks == NULL && cache_init() != LV_RES_OK) return NULL;
+
+    uint32_t flags = 0;
+    if(mode == LV_FS_MODE_WR) flags = O_WRONLY | O_CREAT | O_TRUNC;  /*Like `fopen(path, "wb")` to save files*/
+    else if(mode == LV_FS_MODE_RD) flags = O_RDONLY;
+    else if(mode == (LV_FS_MODE_WR | LV_FS_MODE_RD)) flags = O_RDWR | O_CREAT;
+
+    /*Make the path relative to the current directory (the projects root folder)*/
+    char buf[256];
+    lv_snprintf(buf, sizeof(buf), LV_FS_CACHED_PATH "%s", path);
+
+    cached_file_t * f = lv_mem_alloc(sizeof(cached_file_t));
+    if(f == NULL) return NULL;
+
+    f->fd = open(buf, flags, 0666);
+    struct stat st;
+    if(f->fd < 0 || fstat(f->fd, &st) != 0) {
+        if(f->fd >= 0) close(f->fd);
+        lv_mem_free(f);
+        return NULL;
+    }
+
+    f->rec = rec_get(buf, &st);
+    if(f->rec == NULL) {
+        close(f->fd);
+        lv_mem_free(f);
+        return NULL;
+    }
+
+    f->pos = 0;
+    f->fd_pos = 0;
+    f->read_end = NO_READ;
+    f->written = 0;
+    return f;
+}
+
+/**
+ * Close an opened file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle. (opened with fs_open)
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    cached_file_t * f = file_p;
+    close(f->fd);
+
+    /*The modification time is updated on close. Save it to keep the cached blocks on the next open.*/
+    if(f->written) {
+        struct stat st;
+        if(stat(f->rec->path, &st) == 0) {
+            f->rec->size = st.st_size;
+            f->rec->mtime = st.st_mtime;
+        }
+        else {
+            drop_blocks(f->rec, 0, UINT32_MAX);
+        }
+    }
+
+    rec_release(f->rec);
+    lv_mem_free(f);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read data from an opened file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable.
+ * @param buf pointer to a memory block where to store the read data
+ * @param btr number of Bytes To Read
+ * @param br the real number of read bytes (Byte Read)
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+    cached_file_t * f = file_p;
+    uint8_t * out = buf;
+    lv_fs_res_t res = LV_FS_RES_OK;
+    *br = 0;
+
+    stats.read_cnt++;
+    bool seq = f->pos == f->read_end;
+    if(seq) stats.seq_read_cnt++;
+
+    while(btr > 0 && f->pos < f->rec->size) {
+        uint32_t index = f->pos / BLOCK_SIZE;
+        uint32_t ofs = f->pos % BLOCK_SIZE;
+        block_t * b = block_find(f->rec, index);
+
+        /*Read whole blocks which are not cached directly into the destination*/
+        if(b == NULL && ofs == 0 && btr >= BLOCK_SIZE) {
+            uint32_t n = 1;
+            while((n + 1) * BLOCK_SIZE <= btr && block_find(f->rec, index + n) == NULL) n++;
+
+            uint32_t got;
+            res = dev_read(f, f->pos, out, n * BLOCK_SIZE, &got);
+            if(res != LV_FS_RES_OK) break;
+            stats.miss_cnt += n;
+            f->pos += got;
+            out += got;
+            btr -= got;
+            *br += got;
+            if(got < n * BLOCK_SIZE) break;
+            continue;
+        }
+
+        if(b) {
+            stats.hit_cnt++;
+        }
+        else {
+            stats.miss_cnt++;
+            b = block_load(f, index, &res);
+            if(b == NULL) break;
+
+            /*Sequential reading will probably continue with the next blocks.
+             *Load them now as the OS file is already there.*/
+            if(seq) {
+                uint32_t i;
+                for(i = 1; i <= READ_AHEAD; i++) {
+                    if((index + i) * BLOCK_SIZE >= f->rec->size) break;
+                    if(block_find(f->rec, index + i)) break;
+                    lv_fs_res_t ra_res;
+                    if(block_load(f, index + i, &ra_res) == NULL) break;
+                    stats.read_ahead_cnt++;
+                }
+            }
+        }
+        lru_touch(b);
+
+        if(ofs >= b->len) break;    /*The file is shorter than expected*/
+        uint32_t n = LV_MIN(btr, b->len - ofs);
+        lv_memcpy(out, b->data + ofs, n);
+        f->pos += n;
+        out += n;
+        btr -= n;
+        *br += n;
+    }
+
+    f->read_end = f->pos;
+    return res;
+}
+
+/**
+ * Write into a file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable
+ * @param buf pointer to a buffer with the bytes to write
+ * @param btw Bytes To Write
+ * @param bw the number of real written bytes (Bytes Written). NULL if unused.
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw)
+{
+    LV_UNUSED(drv);
+    cached_file_t * f = file_p;
+    *bw = 0;
+    if(btw == 0) return LV_FS_RES_OK;
+
+    if(f->fd_pos != f->pos) {
+        if(lseek(f->fd, f->pos, SEEK_SET) < 0) return LV_FS_RES_FS_ERR;
+        stats.dev_seek_cnt++;
+        f->fd_pos = f->pos;
+    }
+
+    /*Write through and drop the overwritten blocks and the last, partial block*/
+    drop_blocks(f->rec, f->pos / BLOCK_SIZE, (f->pos + btw - 1) / BLOCK_SIZE);
+    drop_blocks(f->rec, f->rec->size / BLOCK_SIZE, f->rec->size / BLOCK_SIZE);
+    f->written = 1;
+
+    ssize_t n = write(f->fd, buf, btw);
+    if(n < 0) return LV_FS_RES_UNKNOWN;
+
+    *bw = n;
+    f->pos += n;
+    f->fd_pos = f->pos;
+    if(f->pos > f->rec->size) f->rec->size = f->pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Set the read write pointer. The OS file is seeked only when it's really read or written.
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable. (opened with fs_open )
+ * @param pos the new position of read write pointer
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    cached_file_t * f = file_p;
+
+    uint32_t new_pos;
+    switch(whence) {
+        case LV_FS_SEEK_SET:
+            new_pos = pos;
+            break;
+        case LV_FS_SEEK_CUR:
+            new_pos = f->pos + pos;
+            break;
+        case LV_FS_SEEK_END:
+            new_pos = f->rec->size + pos;
+            break;
+        default:
+            return LV_FS_RES_INV_PARAM;
+    }
+
+    stats.seek_cnt++;
+    if(new_pos < f->pos) stats.seek_back_cnt++;
+    if(LV_ABS((int64_t)new_pos - f->pos) >= BLOCK_SIZE) stats.seek_far_cnt++;
+
+    f->pos = new_pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the position of the read write pointer
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p a file handle variable.
+ * @param pos_p pointer to to store the result
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+    cached_file_t * f = file_p;
+    *pos_p = f->pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Initialize a 'DIR' variable for directory reading
+ * @param drv pointer to a driver where this function belongs
+ * @param path path to a directory
+ * @return pointer to an initialized 'DIR' variable
+ */
+static void * fs_dir_open(lv_fs_drv_t * drv, const char * path)
+{
+    LV_UNUSED(drv);
+
+    /*Make the path relative to the current directory (the projects root folder)*/
+    char buf[256];
+    lv_snprintf(buf, sizeof(buf), LV_FS_CACHED_PATH "%s", path);
+    return opendir(buf);
+}
+
+/**
+ * Read the next filename from a directory.
+ * The name of the directories will begin with '/'
+ * @param drv pointer to a driver where this function belongs
+ * @param dir_p pointer to an initialized 'DIR' variable
+ * @param fn pointer to a buffer to store the filename
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn)
+{
+    LV_UNUSED(drv);
+
+    struct dirent * entry;
+    do {
+        entry = readdir(dir_p);
+        if(entry) {
+            if(entry->d_type == DT_DIR) sprintf(fn, "/%s", entry->d_name);
+            else strcpy(fn, entry->d_name);
+        }
+        else {
+            strcpy(fn, "");
+        }
+    } while(strcmp(fn, "/.") == 0 || strcmp(fn, "/..") == 0);
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Close the directory reading
+ * @param drv pointer to a driver where this function belongs
+ * @param dir_p pointer to an initialized 'DIR' variable
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p)
+{
+    LV_UNUSED(drv);
+    closedir(dir_p);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Allocate the blocks and the hash table on the first use
+ */
+static lv_res_t cache_init(void)
+{
+    uint32_t hash_size = 1;
+    while(hash_size < BLOCK_CNT) hash_size <<= 1;
+
+    cache.blocks = lv_mem_alloc(sizeof(block_t) * BLOCK_CNT);
+    cache.hash = lv_mem_alloc(sizeof(block_t *) * hash_size);
+    uint8_t * data = lv_mem_alloc(BLOCK_CNT * BLOCK_SIZE);
+    if(cache.blocks == NULL || cache.hash == NULL || data == NULL) {
+        LV_LOG_WARN("lv_fs_cached: couldn't allocate %d bytes for the cache", BLOCK_CNT * BLOCK_SIZE);
+        lv_mem_free(cache.blocks);
+        lv_mem_free(cache.hash);
+        lv_mem_free(data);
+        cache.blocks = NULL;
+        cache.hash = NULL;
+        return LV_RES_INV;
+    }
+
+    lv_memset_00(cache.hash, sizeof(block_t *) * hash_size);
+    cache.hash_mask = hash_size - 1;
+
+    uint32_t i;
+    for(i = 0; i < BLOCK_CNT; i++) {
+        block_t * b = &cache.blocks[i];
+        b->hash_next = NULL;
+        b->prev = i > 0 ? &cache.blocks[i - 1] : NULL;
+        b->next = i < BLOCK_CNT - 1 ? &cache.blocks[i + 1] : NULL;
+        b->rec = NULL;
+        b->index = 0;
+        b->len = 0;
+        b->data = data + i * BLOCK_SIZE;
+    }
+    cache.lru_head = &cache.blocks[0];
+    cache.lru_tail = &cache.blocks[BLOCK_CNT - 1];
+
+    return LV_RES_OK;
+}
+
+static inline uint32_t hash_key(const file_rec_t * rec, uint32_t index)
+{
+    return (((lv_uintptr_t)rec >> 4) ^ (index * 2654435761u)) & cache.hash_mask;
+}
+
+/**
+ * Get the record of a file and increment its reference count.
+ * If the file was changed since its blocks were cached the blocks are dropped.
+ */
+static file_rec_t * rec_get(const char * path, const struct stat * st)
+{
+    file_rec_t * rec;
+    for(rec = cache.recs; rec; rec = rec->next) {
+        if(strcmp(rec->path, path) == 0) break;
+    }
+
+    if(rec == NULL) {
+        size_t len = strlen(path);
+        rec = lv_mem_alloc(sizeof(file_rec_t) + len + 1);
+        if(rec == NULL) return NULL;
+        lv_memcpy(rec->path, path, len + 1);
+        rec->ref_cnt = 0;
+        rec->block_cnt = 0;
+        rec->size = st->st_size;
+        rec->mtime = st->st_mtime;
+        rec->next = cache.recs;
+        cache.recs = rec;
+    }
+
+    rec->ref_cnt++;
+    if(rec->size != (uint32_t)st->st_size || rec->mtime != st->st_mtime) {
+        drop_blocks(rec, 0, UINT32_MAX);
+    }
+
+    rec->size = st->st_size;
+    rec->mtime = st->st_mtime;
+    return rec;
+}
+
+/**
+ * Decrement the reference count of a record and free it if it's not used anymore
+ */
+static void rec_release(file_rec_t * rec)
+{
+    rec->ref_cnt--;
+    if(rec->ref_cnt == 0 && rec->block_cnt == 0) rec_free(rec);
+}
+
+static void rec_free(file_rec_t * rec)
+{
+    file_rec_t ** prev = &cache.recs;
+    while(*prev != rec) prev = &(*prev)->next;
+    *prev = rec->next;
+    lv_mem_free(rec);
+}
+
+static block_t * block_find(const file_rec_t * rec, uint32_t index)
+{
+    block_t * b;
+    for(b = cache.hash[hash_key(rec, index)]; b; b = b->hash_next) {
+        if(b->rec == rec && b->index == index) return b;
+    }
+    return NULL;
+}
+
+/**
+ * Read a block of a file into the least recently used block
+ */
+static block_t * block_load(cached_file_t * f, uint32_t index, lv_fs_res_t * res)
+{
+    block_t * b = cache.lru_tail;
+    if(b->rec) block_drop(b);
+
+    uint32_t got;
+    *res = dev_read(f, index * BLOCK_SIZE, b->data, BLOCK_SIZE, &got);
+    if(*res != LV_FS_RES_OK) return NULL;
+
+    b->rec = f->rec;
+    b->index = index;
+    b->len = got;
+    f->rec->block_cnt++;
+
+    uint32_t h = hash_key(b->rec, index);
+    b->hash_next = cache.hash[h];
+    cache.hash[h] = b;
+
+    lru_touch(b);
+    return b;
+}
+
+/**
+ * Free a block and move it to the end of the LRU list to be reused first
+ */
+static void block_drop(block_t * b)
+{
+    file_rec_t * rec = b->rec;
+
+    block_t ** prev = &cache.hash[hash_key(rec, b->index)];
+    while(*prev != b) prev = &(*prev)->hash_next;
+    *prev = b->hash_next;
+    b->hash_next = NULL;
+    b->rec = NULL;
+
+    if(b != cache.lru_tail) {
+        if(b->prev) b->prev->next = b->next;
+        else cache.lru_head = b->next;
+        b->next->prev = b->prev;
+
+        b->prev = cache.lru_tail;
+        b->next = NULL;
+        cache.lru_tail->next = b;
+        cache.lru_tail = b;
+    }
+
+    rec->block_cnt--;
+    if(rec->block_cnt == 0 && rec->ref_cnt == 0) rec_free(rec);
+}
+
+/**
+ * Drop the cached blocks of a file in a range of block indices
+ */
+static void drop_blocks(const file_rec_t * rec, uint32_t first, uint32_t last)
+{
+    if(rec->block_cnt == 0) return;
+
+    uint32_t i;
+    for(i = 0; i < BLOCK_CNT; i++) {
+        block_t * b = &cache.blocks[i];
+        if(b->rec == rec && b->index >= first && b->index <= last) block_drop(b);
+    }
+}
+
+/**
+ * Make a block the most recently used one
+ */
+static void lru_touch(block_t * b)
+{
+    if(b == cache.lru_head) return;
+
+    b->prev->next = b->next;
+    if(b->next) b->next->prev = b->prev;
+    else cache.lru_tail = b->prev;
+
+    b->prev = NULL;
+    b->next = cache.lru_head;
+    cache.lru_head->prev = b;
+    cache.lru_head = b;
+}
+
+/**
+ * Read from the OS file. Seek only if the OS file is not at the required position.
+ */
+static lv_fs_res_t dev_read(cached_file_t * f, uint32_t pos, void * buf, uint32_t len, uint32_t * got)
+{
+    *got = 0;
+    if(f->fd_pos != pos) {
+        if(lseek(f->fd, pos, SEEK_SET) < 0) return LV_FS_RES_FS_ERR;
+        stats.dev_seek_cnt++;
+        f->fd_pos = pos;
+    }
+
+    ssize_t n = read(f->fd, buf, len);
+    stats.dev_read_cnt++;
+    if(n < 0) return LV_FS_RES_UNKNOWN;
+
+    stats.dev_read_bytes += n;
+    f->fd_pos += n;
+    *got = n;
+    return LV_FS_RES_OK;
+}
+
+#else /*LV_USE_FS_CACHED == 0*/
+
+#if defined(LV_FS_CACHED_LETTER) && LV_FS_CACHED_LETTER != '\0'
+    #warning "LV_USE_FS_CACHED is not enabled but LV_FS_CACHED_LETTER is set"
+#endif
+
+#endif /*LV_USE_FS_CACHED*/
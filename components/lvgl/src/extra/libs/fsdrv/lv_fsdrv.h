@@ -23,6 +23,25 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_FS_CACHED != '\0'
+/**
+ * Access statistics of the block cached driver
+ */
+typedef struct {
+    uint32_t read_cnt;          /*Number of lv_fs_read() calls*/
+    uint32_t seq_read_cnt;      /*Reads which started where the previous read ended*/
+    uint32_t seek_cnt;          /*Number of lv_fs_seek() calls*/
+    uint32_t seek_back_cnt;     /*Seeks to an earlier position*/
+    uint32_t seek_far_cnt;      /*Seeks by at least a block*/
+    uint32_t hit_cnt;           /*Blocks found in the cache*/
+    uint32_t miss_cnt;          /*Blocks which needed to be read from the file*/
+    uint32_t read_ahead_cnt;    /*Blocks read in advance for sequential reads*/
+    uint32_t dev_read_cnt;      /*Reads from the OS file*/
+    uint32_t dev_seek_cnt;      /*Seeks in the OS file*/
+    uint32_t dev_read_bytes;    /*Bytes read from the OS file*/
+} lv_fs_cached_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -44,6 +63,13 @@ void lv_fs_stdio_init(void);
 void lv_fs_posix_init(void);
 #endif
 
+#if LV_USE_FS_CACHED != '\0'
+void lv_fs_cached_init(void);
+void lv_fs_cached_get_stats(lv_fs_cached_stats_t * stats_p);
+void lv_fs_cached_reset_stats(void);
+void lv_fs_cached_invalidate(const char * path);
+#endif
+
 #if LV_USE_FS_WIN32 != '\0'
 void lv_fs_win32_init(void);
 #endif
@@ -11,6 +11,8 @@
 #define MIN(A, B) ((A) < (B) ? (A) : (B))
 #define MAX(A, B) ((A) > (B) ? (A) : (B))
 
+#define PX_SIZE LV_IMG_PX_SIZE_ALPHA_BYTE
+
 typedef struct Entry {
     uint16_t length;
     uint16_t prefix;
@@ -23,12 +25,38 @@ typedef struct Table {
     Entry *entries;
 } Table;
 
+/* Where the decoded pixels of a frame go on the canvas */
+typedef struct Cursor {
+    uint8_t *row;   /* Canvas at the frame's left edge or NULL if out of the canvas */
+    int x, y;       /* y is the index of the decoded row */
+    int cw;         /* Width of the frame clipped to the canvas */
+    int interlace;
+    int tindex;     /* Transparent color index or -1 */
+} Cursor;
+
 static gd_GIF *  gif_open(gd_GIF * gif);
 static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file);
 static void f_gif_read(gd_GIF * gif, void * buf, size_t len);
 static int f_gif_seek(gd_GIF * gif, size_t pos, int k);
 static void f_gif_close(gd_GIF * gif);
 
+static inline uint8_t
+f_gif_getc(gd_GIF * gif)
+{
+    uint8_t c;
+
+    if (gif->is_file) {
+        uint32_t ofs = gif->f_rw_p - gif->f_buf_start;
+        if (ofs < gif->f_buf_len) {
+            gif->f_rw_p++;
+            return gif->f_buf[ofs];
+        }
+        f_gif_read(gif, &c, 1);
+        return c;
+    }
+    return (uint8_t) gif->data[gif->f_rw_p++];
+}
+
 static uint16_t
 read_num(gd_GIF * gif)
 {
@@ -43,26 +71,70 @@ read_num(gd_GIF * gif)
 gd_GIF *
 gd_open_gif_file(const char *fname)
 {
-    gd_GIF gif_base;
-    memset(&gif_base, 0, sizeof(gif_base));
-
-    bool res = f_gif_open(&gif_base, fname, true);
-    if(!res) return NULL;
+    gd_GIF *gif_base = lv_mem_alloc(sizeof(gd_GIF));
+    if(!gif_base) return NULL;
+    memset(gif_base, 0, sizeof(gd_GIF));
+
+    bool res = f_gif_open(gif_base, fname, true);
+    if(!res) {
+        lv_mem_free(gif_base);
+        return NULL;
+    }
 
-    return gif_open(&gif_base);
+    return gif_open(gif_base);
 }
 
 
 gd_GIF *
 gd_open_gif_data(const void *data)
 {
-    gd_GIF gif_base;
-    memset(&gif_base, 0, sizeof(gif_base));
+    gd_GIF *gif_base = lv_mem_alloc(sizeof(gd_GIF));
+    if(!gif_base) return NULL;
+    memset(gif_base, 0, sizeof(gd_GIF));
+
+    bool res = f_gif_open(gif_base, data, false);
+    if(!res) {
+        lv_mem_free(gif_base);
+        return NULL;
+    }
+
+    return gif_open(gif_base);
+}
+
+/* Convert the current palette to the canvas' pixel format. */
+static void
+update_lut(gd_GIF *gif)
+{
+    int i;
+    uint8_t *color, *px;
 
-    bool res = f_gif_open(&gif_base, data, false);
-    if(!res) return NULL;
+    /* The GCT doesn't change */
+    if (gif->palette == &gif->gct && gif->lut_palette == &gif->gct) return;
 
-    return gif_open(&gif_base);
+    for (i = 0; i < gif->palette->size; i++) {
+        color = &gif->palette->colors[i*3];
+        px = &gif->lut[i*PX_SIZE];
+#if LV_COLOR_DEPTH == 32
+        px[0] = *(color + 2);
+        px[1] = *(color + 1);
+        px[2] = *(color + 0);
+        px[3] = 0xff;
+#elif LV_COLOR_DEPTH == 16
+        lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
+        px[0] = c.full & 0xff;
+        px[1] = (c.full >> 8) & 0xff;
+        px[2] = 0xff;
+#elif LV_COLOR_DEPTH == 8
+        lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
+        px[0] = c.full;
+        px[1] = 0xff;
+#elif LV_COLOR_DEPTH == 1
+        uint8_t b = (*(color + 0)) | (*(color + 1)) | (*(color + 2));
+        px[0] = b > 128 ? 1 : 0;
+        px[1] = 0xff;
+#endif
+    }
+    gif->lut_palette = gif->palette;
 }
 
 static gd_GIF * gif_open(gd_GIF * gif_base)
@@ -73,7 +145,7 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     int i;
     uint8_t *bgcolor;
     int gct_sz;
-    gd_GIF *gif = NULL;
+    gd_GIF *gif;
 
     /* Header */
     f_gif_read(gif_base, sigver, 3);
@@ -106,17 +178,9 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     f_gif_read(gif_base, &bgidx, 1);
     /* Aspect Ratio */
     f_gif_read(gif_base, &aspect, 1);
-    /* Create gd_GIF Structure. */
-#if LV_COLOR_DEPTH == 32
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 5 * width * height);
-#elif LV_COLOR_DEPTH == 16
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 4 * width * height);
-#elif LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 3 * width * height);
-#endif
-
+    /* Add the canvas to the gd_GIF Structure. */
+    gif = lv_mem_realloc(gif_base, sizeof(gd_GIF) + PX_SIZE * width * height);
     if (!gif) goto fail;
-    memcpy(gif, gif_base, sizeof(gd_GIF));
     gif->width  = width;
     gif->height = height;
     gif->depth  = depth;
@@ -126,46 +190,19 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     gif->palette = &gif->gct;
     gif->bgindex = bgidx;
     gif->canvas = (uint8_t *) &gif[1];
-#if LV_COLOR_DEPTH == 32
-    gif->frame = &gif->canvas[4 * width * height];
-#elif LV_COLOR_DEPTH == 16
-    gif->frame = &gif->canvas[3 * width * height];
-#elif LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-    gif->frame = &gif->canvas[2 * width * height];
-#endif
-    if (gif->bgindex) {
-        memset(gif->frame, gif->bgindex, gif->width * gif->height);
-    }
-    bgcolor = &gif->palette->colors[gif->bgindex*3];
+    update_lut(gif);
+    bgcolor = &gif->lut[gif->bgindex*PX_SIZE];
 
     for (i = 0; i < gif->width * gif->height; i++) {
-#if LV_COLOR_DEPTH == 32
-        gif->canvas[i*4 + 0] = *(bgcolor + 2);
-        gif->canvas[i*4 + 1] = *(bgcolor + 1);
-        gif->canvas[i*4 + 2] = *(bgcolor + 0);
-        gif->canvas[i*4 + 3] = 0xff;
-#elif LV_COLOR_DEPTH == 16
-        lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-        gif->canvas[i*3 + 0] = c.full & 0xff;
-        gif->canvas[i*3 + 1] = (c.full >> 8) & 0xff;
-        gif->canvas[i*3 + 2] = 0xff;
-#elif LV_COLOR_DEPTH == 8
-        lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-        gif->canvas[i*2 + 0] = c.full;
-        gif->canvas[i*2 + 1] = 0xff;
-#elif LV_COLOR_DEPTH == 1
-        lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-        gif->canvas[i*2 + 0] = c.ch.red > 128 ? 1 : 0;
-        gif->canvas[i*2 + 1] = 0xff;
-#endif
+        memcpy(&gif->canvas[i*PX_SIZE], bgcolor, PX_SIZE);
     }
     gif->anim_start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     gif->loop_count = -1;
-    goto ok;
+    return gif;
 fail:
     f_gif_close(gif_base);
-ok:
-    return gif;
+    lv_mem_free(gif_base);
+    return NULL;
 }
 
 static void
@@ -174,7 +211,7 @@ discard_sub_blocks(gd_GIF *gif)
     uint8_t size;
 
     do {
-        f_gif_read(gif, &size, 1);
+        size = f_gif_getc(gif);
         f_gif_seek(gif, size, LV_FS_SEEK_CUR);
     } while (size);
 }
@@ -348,10 +385,10 @@ get_key(gd_GIF *gif, int key_size, uint8_t *sub_len, uint8_t *shift, uint8_t *by
         if (rpad == 0) {
             /* Update byte. */
             if (*sub_len == 0) {
-                f_gif_read(gif, sub_len, 1); /* Must be nonzero! */
+                *sub_len = f_gif_getc(gif); /* Must be nonzero! */
                 if (*sub_len == 0) return 0x1000;
             }
-            f_gif_read(gif, byte, 1);
+            *byte = f_gif_getc(gif);
             (*sub_len)--;
         }
         frag_size = MIN(key_size - bits_read, 8 - rpad);
@@ -385,29 +422,110 @@ interlaced_line_index(int h, int y)
     return y * 2 + 1;
 }
 
-/* Decompress image pixels.
+/* Area of the current frame clipped to the canvas. Return 0 if it's empty. */
+static int
+frame_area(gd_GIF *gif, gd_Rect *r)
+{
+    if (gif->fx >= gif->width || gif->fy >= gif->height) return 0;
+    r->x = gif->fx;
+    r->y = gif->fy;
+    r->w = MIN(gif->fw, gif->width - gif->fx);
+    r->h = MIN(gif->fh, gif->height - gif->fy);
+    return r->w && r->h;
+}
+
+static void
+dirty_add(gd_GIF *gif, const gd_Rect *r)
+{
+    uint16_t x2, y2;
+
+    if (gif->dirty.w == 0 || gif->dirty.h == 0) {
+        gif->dirty = *r;
+        return;
+    }
+    x2 = MAX(gif->dirty.x + gif->dirty.w, r->x + r->w);
+    y2 = MAX(gif->dirty.y + gif->dirty.h, r->y + r->h);
+    gif->dirty.x = MIN(gif->dirty.x, r->x);
+    gif->dirty.y = MIN(gif->dirty.y, r->y);
+    gif->dirty.w = x2 - gif->dirty.x;
+    gif->dirty.h = y2 - gif->dirty.y;
+}
+
+static void
+cursor_set_row(gd_GIF *gif, Cursor *cur)
+{
+    int y = cur->y;
+
+    if (cur->interlace)
+        y = interlaced_line_index((int) gif->fh, y);
+    y += gif->fy;
+    if (cur->cw > 0 && y < gif->height)
+        cur->row = &gif->canvas[(y * gif->width + gif->fx) * PX_SIZE];
+    else
+        cur->row = NULL;
+}
+
+/* Draw the next decoded pixels of the frame on the canvas. */
+static void
+put_pixels(gd_GIF *gif, Cursor *cur, const uint8_t *str, int len)
+{
+    int i, n, end;
+    uint8_t index;
+
+    while (len > 0 && cur->y < gif->fh) {
+        n = MIN(len, gif->fw - cur->x);
+        if (cur->row) {
+            end = MIN(cur->x + n, cur->cw);
+            for (i = cur->x; i < end; i++) {
+                index = str[i - cur->x];
+                if (index != cur->tindex)
+                    memcpy(&cur->row[i*PX_SIZE], &gif->lut[index*PX_SIZE], PX_SIZE);
+            }
+        }
+        str += n;
+        len -= n;
+        cur->x += n;
+        if (cur->x == gif->fw) {
+            cur->x = 0;
+            cur->y++;
+            if (cur->y < gif->fh) cursor_set_row(gif, cur);
+        }
+    }
+}
+
+/* Decompress image pixels directly to the canvas.
  * Return 0 on success or -1 on out-of-memory (w.r.t. LZW code table). */
 static int
 read_image_data(gd_GIF *gif, int interlace)
 {
     uint8_t sub_len, shift, byte;
     int init_key_size, key_size, table_is_full=0;
-    int frm_off, frm_size, str_len=0, i, p, x, y;
+    int frm_off, frm_size, str_len=0, i;
     uint16_t key, clear, stop;
     int ret;
     Table *table;
+    uint8_t *str;
     Entry entry = {0};
-    size_t start, end;
+    Cursor cur;
 
-    f_gif_read(gif, &byte, 1);
+    byte = f_gif_getc(gif);
     key_size = (int) byte;
-    start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
-    discard_sub_blocks(gif);
-    end = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
-    f_gif_seek(gif, start, LV_FS_SEEK_SET);
+    if (key_size < 1 || key_size > 11) return -1;
     clear = 1 << key_size;
     stop = clear + 1;
     table = new_table(key_size);
+    /* The decoded string of a key, the longest is as long as the table */
+    str = lv_mem_alloc(0x1000);
+    if (!table || !str) {
+        lv_mem_free(table);
+        lv_mem_free(str);
+        return -1;
+    }
+    cur.x = cur.y = 0;
+    cur.cw = gif->fx < gif->width ? MIN(gif->fw, gif->width - gif->fx) : 0;
+    cur.interlace = interlace;
+    cur.tindex = gif->gce.transparency ? gif->gce.tindex : -1;
+    cursor_set_row(gif, &cur);
     key_size++;
     init_key_size = key_size;
     sub_len = shift = 0;
@@ -424,6 +542,7 @@ read_image_data(gd_GIF *gif, int interlace)
             ret = add_entry(&table, str_len + 1, key, entry.suffix);
             if (ret == -1) {
                 lv_mem_free(table);
+                lv_mem_free(str);
                 return -1;
             }
             if (table->nentries == 0x1000) {
@@ -435,27 +554,53 @@ read_image_data(gd_GIF *gif, int interlace)
         if (key == clear) continue;
         if (key == stop || key == 0x1000) break;
         if (ret == 1) key_size++;
+        if (key >= table->nentries) break; /* Invalid key */
         entry = table->entries[key];
         str_len = entry.length;
-        for (i = 0; i < str_len; i++) {
-            p = frm_off + entry.length - 1;
-            x = p % gif->fw;
-            y = p / gif->fw;
-            if (interlace)
-                y = interlaced_line_index((int) gif->fh, y);
-            gif->frame[(gif->fy + y) * gif->width + gif->fx + x] = entry.suffix;
+        /* The string is stored backwards in the table */
+        for (i = str_len - 1; i >= 0; i--) {
+            str[i] = entry.suffix;
             if (entry.prefix == 0xFFF)
                 break;
             else
                 entry = table->entries[entry.prefix];
         }
+        put_pixels(gif, &cur, str, str_len);
         frm_off += str_len;
         if (key < table->nentries - 1 && !table_is_full)
             table->entries[table->nentries - 1].suffix = entry.suffix;
     }
     lv_mem_free(table);
-    if (key == stop) f_gif_read(gif, &sub_len, 1); /* Must be zero! */
-    f_gif_seek(gif, end, LV_FS_SEEK_SET);
+    lv_mem_free(str);
+    /* Skip the rest of the sub-blocks unless the terminator is already read. */
+    if (key != 0x1000) {
+        f_gif_seek(gif, sub_len, LV_FS_SEEK_CUR);
+        discard_sub_blocks(gif);
+    }
+    return 0;
+}
+
+/* Save the canvas under the current frame to restore it at disposal.
+ * Return 0 on success or -1 on out-of-memory. */
+static int
+backup_frame(gd_GIF *gif)
+{
+    int j;
+    gd_Rect r;
+    uint32_t size;
+
+    if (!frame_area(gif, &r)) return 0;
+    size = r.w * r.h * PX_SIZE;
+    if (size > gif->backup_size) {
+        uint8_t *backup = lv_mem_realloc(gif->backup, size);
+        if (!backup) return -1;
+        gif->backup = backup;
+        gif->backup_size = size;
+    }
+    for (j = 0; j < r.h; j++) {
+        memcpy(&gif->backup[j * r.w * PX_SIZE],
+               &gif->canvas[((r.y + j) * gif->width + r.x) * PX_SIZE], r.w * PX_SIZE);
+    }
     return 0;
 }
 
@@ -466,6 +611,7 @@ read_image(gd_GIF *gif)
 {
     uint8_t fisrz;
     int interlace;
+    gd_Rect r;
 
     /* Image Descriptor. */
     gif->fx = read_num(gif);
@@ -483,99 +629,61 @@ read_image(gd_GIF *gif)
         gif->palette = &gif->lct;
     } else
         gif->palette = &gif->gct;
+    update_lut(gif);
+    if (gif->gce.disposal == 3 && backup_frame(gif) == -1)
+        return -1;
+    if (frame_area(gif, &r))
+        dirty_add(gif, &r);
     /* Image Data. */
     return read_image_data(gif, interlace);
 }
 
+/* Dispose the previous frame before drawing the next one. */
 static void
-render_frame_rect(gd_GIF *gif, uint8_t *buffer)
-{
-    int i, j, k;
-    uint8_t index, *color;
-    i = gif->fy * gif->width + gif->fx;
-    for (j = 0; j < gif->fh; j++) {
-        for (k = 0; k < gif->fw; k++) {
-            index = gif->frame[(gif->fy + j) * gif->width + gif->fx + k];
-            color = &gif->palette->colors[index*3];
-            if (!gif->gce.transparency || index != gif->gce.tindex) {
-#if LV_COLOR_DEPTH == 32
-                buffer[(i+k)*4 + 0] = *(color + 2);
-                buffer[(i+k)*4 + 1] = *(color + 1);
-                buffer[(i+k)*4 + 2] = *(color + 0);
-                buffer[(i+k)*4 + 3] = 0xFF;
-#elif LV_COLOR_DEPTH == 16
-                lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
-                buffer[(i+k)*3 + 0] = c.full & 0xff;
-                buffer[(i+k)*3 + 1] = (c.full >> 8) & 0xff;
-                buffer[(i+k)*3 + 2] = 0xff;
-#elif LV_COLOR_DEPTH == 8
-                lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
-                buffer[(i+k)*2 + 0] = c.full;
-                buffer[(i+k)*2 + 1] = 0xff;
-#elif LV_COLOR_DEPTH == 1
-                uint8_t b = (*(color + 0)) | (*(color + 1)) | (*(color + 2));
-                buffer[(i+k)*2 + 0] = b > 128 ? 1 : 0;
-                buffer[(i+k)*2 + 1] = 0xff;
-#endif
-            }
-        }
-        i += gif->width;
-    }
-}
-
-static void
-dispose(gd_GIF *gif)
+dispose(gd_GIF *gif, const gd_GCE *gce)
 {
-    int i, j, k;
-    uint8_t *bgcolor;
-    switch (gif->gce.disposal) {
-    case 2: /* Restore to background color. */
-        bgcolor = &gif->palette->colors[gif->bgindex*3];
-
-        uint8_t opa = 0xff;
-        if(gif->gce.transparency) opa = 0x00;
+    int j, k;
+    uint8_t bgcolor[PX_SIZE];
+    uint8_t *row;
+    gd_Rect r;
 
-        i = gif->fy * gif->width + gif->fx;
-        for (j = 0; j < gif->fh; j++) {
-            for (k = 0; k < gif->fw; k++) {
-#if LV_COLOR_DEPTH == 32
-                gif->canvas[(i+k)*4 + 0] = *(bgcolor + 2);
-                gif->canvas[(i+k)*4 + 1] = *(bgcolor + 1);
-                gif->canvas[(i+k)*4 + 2] = *(bgcolor + 0);
-                gif->canvas[(i+k)*4 + 3] = opa;
-#elif LV_COLOR_DEPTH == 16
-                lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-                gif->canvas[(i+k)*3 + 0] = c.full & 0xff;
-                gif->canvas[(i+k)*3 + 1] = (c.full >> 8) & 0xff;
-                gif->canvas[(i+k)*3 + 2] = opa;
-#elif LV_COLOR_DEPTH == 8
-                lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-                gif->canvas[(i+k)*2 + 0] = c.full;
-                gif->canvas[(i+k)*2 + 1] = opa;
-#elif LV_COLOR_DEPTH == 1
-                uint8_t b = (*(bgcolor + 0)) | (*(bgcolor + 1)) | (*(bgcolor + 2));
-                gif->canvas[(i+k)*2 + 0] = b > 128 ? 1 : 0;
-                gif->canvas[(i+k)*2 + 1] = opa;
-#endif
+    if (!frame_area(gif, &r)) return;
+    switch (gce->disposal) {
+    case 2: /* Restore to background color. */
+        memcpy(bgcolor, &gif->lut[gif->bgindex*PX_SIZE], PX_SIZE);
+        bgcolor[PX_SIZE - 1] = gce->transparency ? 0x00 : 0xff;
+        for (j = 0; j < r.h; j++) {
+            row = &gif->canvas[((r.y + j) * gif->width + r.x) * PX_SIZE];
+            for (k = 0; k < r.w; k++) {
+                memcpy(&row[k*PX_SIZE], bgcolor, PX_SIZE);
             }
-            i += gif->width;
         }
         break;
-    case 3: /* Restore to previous, i.e., don't update canvas.*/
+    case 3: /* Restore to previous, i.e. the canvas before the frame. */
+        if (!gif->backup) return;
+        for (j = 0; j < r.h; j++) {
+            memcpy(&gif->canvas[((r.y + j) * gif->width + r.x) * PX_SIZE],
+                   &gif->backup[j * r.w * PX_SIZE], r.w * PX_SIZE);
+        }
         break;
     default:
-        /* Add frame non-transparent pixels to canvas. */
-        render_frame_rect(gif, gif->canvas);
+        /* Leave the frame on the canvas. */
+        return;
     }
+    dirty_add(gif, &r);
 }
 
-/* Return 1 if got a frame; 0 if got GIF trailer; -1 if error. */
+/* Return 1 if got a frame; 0 if got GIF trailer; -1 if error.
+ * `gif->dirty` is the area of the canvas changed by the disposal of the
+ * previous frame and the new frame. */
 int
 gd_get_frame(gd_GIF *gif)
 {
     char sep;
+    /* The extensions of the next frame overwrite it */
+    gd_GCE gce = gif->gce;
 
-    dispose(gif);
+    gif->dirty.w = gif->dirty.h = 0;
     f_gif_read(gif, &sep, 1);
     while (sep != ',') {
         if (sep == ';') {
@@ -592,26 +700,12 @@ gd_get_frame(gd_GIF *gif)
         else return -1;
         f_gif_read(gif, &sep, 1);
     }
+    dispose(gif, &gce);
     if (read_image(gif) == -1)
         return -1;
     return 1;
 }
 
-void
-gd_render_frame(gd_GIF *gif, uint8_t *buffer)
-{
-//    uint32_t i;
-//    uint32_t j;
-//    for(i = 0, j = 0; i < gif->width * gif->height * 3; i+= 3, j+=4) {
-//        buffer[j + 0] = gif->canvas[i + 2];
-//        buffer[j + 1] = gif->canvas[i + 1];
-//        buffer[j + 2] = gif->canvas[i + 0];
-//        buffer[j + 3] = 0xFF;
-//    }
-//    memcpy(buffer, gif->canvas, gif->width * gif->height * 3);
-    render_frame_rect(gif, buffer);
-}
-
 void
 gd_rewind(gd_GIF *gif)
 {
@@ -623,12 +717,15 @@ void
 gd_close_gif(gd_GIF *gif)
 {
     f_gif_close(gif);
+    lv_mem_free(gif->backup);
     lv_mem_free(gif);
 }
 
 static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file)
 {
     gif->f_rw_p = 0;
+    gif->f_buf_start = 0;
+    gif->f_buf_len = 0;
     gif->data = NULL;
     gif->is_file = is_file;
 
@@ -642,10 +739,40 @@ static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file)
     }
 }
 
+/* Read the file from `f_rw_p` to the buffer. Return false at the end of the file. */
+static bool f_gif_fill(gd_GIF * gif)
+{
+    uint32_t rn = 0;
+
+    /* After a read the file is at the end of the buffer */
+    if(gif->f_rw_p != gif->f_buf_start + gif->f_buf_len) {
+        lv_fs_seek(&gif->fd, gif->f_rw_p, LV_FS_SEEK_SET);
+    }
+    lv_fs_read(&gif->fd, gif->f_buf, GD_READ_BUF_SIZE, &rn);
+    gif->f_buf_start = gif->f_rw_p;
+    gif->f_buf_len = rn;
+    return rn > 0;
+}
+
 static void f_gif_read(gd_GIF * gif, void * buf, size_t len)
 {
     if(gif->is_file) {
-        lv_fs_read(&gif->fd, buf, len, NULL);
+        uint8_t * dst = buf;
+        while(len) {
+            uint32_t ofs = gif->f_rw_p - gif->f_buf_start;
+            if(ofs >= gif->f_buf_len) {
+                if(!f_gif_fill(gif)) {
+                    memset(dst, 0, len);
+                    return;
+                }
+                ofs = 0;
+            }
+            uint32_t n = MIN(len, gif->f_buf_len - ofs);
+            memcpy(dst, &gif->f_buf[ofs], n);
+            dst += n;
+            len -= n;
+            gif->f_rw_p += n;
+        }
     } else
     {
         memcpy(buf, &gif->data[gif->f_rw_p], len);
@@ -653,18 +780,12 @@ static void f_gif_read(gd_GIF * gif, void * buf, size_t len)
     }
 }
 
+/* Only `f_rw_p` changes, the file is seeked when the buffer is refilled. */
 static int f_gif_seek(gd_GIF * gif, size_t pos, int k)
 {
-    if(gif->is_file) {
-        lv_fs_seek(&gif->fd, pos, k);
-        uint32_t x;
-        lv_fs_tell(&gif->fd, &x);
-        return x;
-    } else {
-        if(k == LV_FS_SEEK_CUR) gif->f_rw_p += pos;
-        else if(k == LV_FS_SEEK_SET) gif->f_rw_p = pos;
-        return gif->f_rw_p;
-    }
+    if(k == LV_FS_SEEK_CUR) gif->f_rw_p += pos;
+    else if(k == LV_FS_SEEK_SET) gif->f_rw_p = pos;
+    return gif->f_rw_p;
 }
 
 static void f_gif_close(gd_GIF * gif)
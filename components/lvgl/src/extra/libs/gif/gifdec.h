@@ -3,9 +3,13 @@
 
 #include <stdint.h>
 #include "../../../misc/lv_fs.h"
+#include "../../../draw/lv_img_buf.h"
 
 #if LV_USE_GIF
 
+/* Bytes read from a file at once */
+#define GD_READ_BUF_SIZE 256
+
 typedef struct gd_Palette {
     int size;
     uint8_t colors[0x100 * 3];
@@ -19,6 +23,9 @@ typedef struct gd_GCE {
     int transparency;
 } gd_GCE;
 
+typedef struct gd_Rect {
+    uint16_t x, y, w, h;
+} gd_Rect;
 
 
 typedef struct gd_GIF {
@@ -26,6 +33,9 @@ typedef struct gd_GIF {
     const char * data;
     uint8_t is_file;
     uint32_t f_rw_p;
+    uint32_t f_buf_start;
+    uint32_t f_buf_len;
+    uint8_t f_buf[GD_READ_BUF_SIZE];
     int32_t anim_start;
     uint16_t width, height;
     uint16_t depth;
@@ -33,6 +43,9 @@ typedef struct gd_GIF {
     gd_GCE gce;
     gd_Palette *palette;
     gd_Palette lct, gct;
+    /* The palette converted to the canvas' pixel format */
+    uint8_t lut[0x100 * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    gd_Palette *lut_palette;
     void (*plain_text)(
         struct gd_GIF *gif, uint16_t tx, uint16_t ty,
         uint16_t tw, uint16_t th, uint8_t cw, uint8_t ch,
@@ -42,15 +55,19 @@ typedef struct gd_GIF {
     void (*application)(struct gd_GIF *gif, char id[8], char auth[3]);
     uint16_t fx, fy, fw, fh;
     uint8_t bgindex;
-    uint8_t *canvas, *frame;
+    /* LV_IMG_CF_TRUE_COLOR_ALPHA pixels */
+    uint8_t *canvas;
+    /* Area of the canvas changed by the last gd_get_frame() */
+    gd_Rect dirty;
+    /* The canvas under the current frame for "restore to previous" disposal */
+    uint8_t *backup;
+    uint32_t backup_size;
 } gd_GIF;
 
 gd_GIF * gd_open_gif_file(const char *fname);
 
 gd_GIF * gd_open_gif_data(const void *data);
 
-void gd_render_frame(gd_GIF *gif, uint8_t *buffer);
-
 int gd_get_frame(gd_GIF *gif);
 void gd_rewind(gd_GIF *gif);
 void gd_close_gif(gd_GIF *gif);
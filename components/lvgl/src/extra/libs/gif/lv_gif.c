@@ -27,6 +27,7 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static void invalidate_changed_area(lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
@@ -145,10 +146,34 @@ static void next_frame_task_cb(lv_timer_t * t)
         if(res != LV_FS_RES_OK) return;
     }
 
-    gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
-
     lv_img_cache_invalidate_src(lv_img_get_src(obj));
-    lv_obj_invalidate(obj);
+    invalidate_changed_area(obj);
+}
+
+/**
+ * Invalidate only the changed area of the canvas if the image is drawn 1:1,
+ * else the whole widget.
+ */
+static void invalidate_changed_area(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    const gd_Rect * dirty = &gifobj->gif->dirty;
+    if(dirty->w == 0 || dirty->h == 0) return;
+
+    lv_img_t * img = &gifobj->img;
+    lv_area_t a;
+    lv_obj_get_content_coords(obj, &a);
+    if(img->angle != 0 || img->zoom != LV_IMG_ZOOM_NONE || img->offset.x != 0 || img->offset.y != 0 ||
+       lv_area_get_width(&a) != img->w || lv_area_get_height(&a) != img->h) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    a.x1 += dirty->x;
+    a.y1 += dirty->y;
+    a.x2 = a.x1 + dirty->w - 1;
+    a.y2 = a.y1 + dirty->h - 1;
+    lv_obj_invalidate_area(obj, &a);
 }
 
 #endif /*LV_USE_GIF*/
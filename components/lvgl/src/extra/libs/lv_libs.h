@@ -17,6 +17,7 @@ extern "C" {
 #include "fsdrv/lv_fsdrv.h"
 #include "png/lv_png.h"
 #include "gif/lv_gif.h"
+#include "rlz/lv_rlz.h"
 #include "qrcode/lv_qrcode.h"
 #include "sjpg/lv_sjpg.h"
 #include "freetype/lv_freetype.h"
@@ -10,6 +10,7 @@
 #if LV_USE_PNG
 
 #include "lv_png.h"
+#include "lv_png_stream.h"
 #include "lodepng.h"
 #include <stdlib.h>
 
@@ -26,8 +27,14 @@
  **********************/
 static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
 static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf);
+static lv_res_t decoder_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                  uint8_t * buf);
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
+static lv_png_stream_t * stream_open(const void * src);
 static void convert_color_depth(uint8_t * img, uint32_t px_cnt);
+static uint8_t * move_to_cache_mem(uint8_t * img, uint32_t px_cnt);
 
 /**********************
  *  STATIC VARIABLES
@@ -50,6 +57,8 @@ void lv_png_init(void)
     lv_img_decoder_set_info_cb(dec, decoder_info);
     lv_img_decoder_set_open_cb(dec, decoder_open);
     lv_img_decoder_set_close_cb(dec, decoder_close);
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+    lv_img_decoder_set_read_area_cb(dec, decoder_read_area);
 }
 
 /**********************
@@ -138,7 +147,8 @@ static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * sr
 
 
 /**
- * Open a PNG image and return the decided image
+ * Open a PNG image. Non-interlaced images are decoded row by row when they are read,
+ * interlaced images are decoded in one go.
  * @param src can be file name or pointer to a C array
  * @param style style of the image object (unused now but certain formats might use it)
  * @return pointer to the decoded image or `LV_IMG_DECODER_OPEN_FAIL` if failed
@@ -155,6 +165,8 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
     if(dsc->src_type == LV_IMG_SRC_FILE) {
         const char * fn = dsc->src;
         if(strcmp(lv_fs_get_ext(fn), "png") == 0) {              /*Check the extension*/
+            dsc->user_data = stream_open(fn);
+            if(dsc->user_data) return LV_RES_OK;
 
             /*Load the PNG file into buffer. It's still compressed (not decoded)*/
             unsigned char * png_data;      /*Pointer to the loaded data. Same as the original file just loaded into the RAM*/
@@ -183,13 +195,17 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
 
             /*Convert the image to the system's color depth*/
             convert_color_depth(img_data,  png_width * png_height);
-            dsc->img_data = img_data;
+            dsc->img_data = move_to_cache_mem(img_data, png_width * png_height);
+            if(dsc->img_data == NULL) return LV_RES_INV;
             return LV_RES_OK;     /*The image is fully decoded. Return with its pointer*/
         }
     }
     /*If it's a PNG file in a  C array...*/
     else if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         const lv_img_dsc_t * img_dsc = dsc->src;
+        dsc->user_data = stream_open(img_dsc);
+        if(dsc->user_data) return LV_RES_OK;
+
         unsigned png_width;             /*No used, just required by he decoder*/
         unsigned png_height;            /*No used, just required by he decoder*/
 
@@ -206,25 +222,81 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
         /*Convert the image to the system's color depth*/
         convert_color_depth(img_data,  png_width * png_height);
 
-        dsc->img_data = img_data;
+        dsc->img_data = move_to_cache_mem(img_data, png_width * png_height);
+        if(dsc->img_data == NULL) return LV_RES_INV;
         return LV_RES_OK;     /*Return with its pointer*/
     }
 
     return LV_RES_INV;    /*If not returned earlier then it failed*/
 }
 
+/**
+ * Read a line of a PNG decoded row by row
+ */
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    lv_png_stream_t * stream = dsc->user_data;
+    if(stream == NULL || x < 0 || len <= 0 || (uint32_t)(x + len) > stream->w) return LV_RES_INV;
+    if(y < 0 || lv_png_stream_read_row(stream, y) != LV_RES_OK) return LV_RES_INV;
+
+    lv_png_stream_get_color(stream, x, len, buf);
+    return LV_RES_OK;
+}
+
+/**
+ * Read an area of a PNG decoded row by row
+ */
+static lv_res_t decoder_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                  uint8_t * buf)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        if(decoder_read_line(decoder, dsc, area->x1, y, w, buf) != LV_RES_OK) return LV_RES_INV;
+        buf += w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+
+    return LV_RES_OK;
+}
+
 /**
  * Free the allocated resources
  */
 static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
 {
     LV_UNUSED(decoder); /*Unused*/
+    if(dsc->user_data) {
+        lv_png_stream_close(dsc->user_data);
+        lv_mem_free(dsc->user_data);
+        dsc->user_data = NULL;
+    }
     if(dsc->img_data) {
-        lv_mem_free((uint8_t *)dsc->img_data);
+        lv_img_cache_mem_free((uint8_t *)dsc->img_data);
         dsc->img_data = NULL;
     }
 }
 
+/**
+ * Open a PNG for decoding row by row
+ * @param src file name or pointer to a C array
+ * @return the stream or NULL if it's not possible (e.g. interlaced image)
+ */
+static lv_png_stream_t * stream_open(const void * src)
+{
+    lv_png_stream_t * stream = lv_mem_alloc(sizeof(lv_png_stream_t));
+    LV_ASSERT_MALLOC(stream);
+    if(stream == NULL) return NULL;
+
+    if(lv_png_stream_open(stream, src) != LV_RES_OK) {
+        lv_mem_free(stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
 /**
  * If the display is not in 32 bit format (ARGB888) then covert the image to the current color depth
  * @param img the ARGB888 image
@@ -273,6 +345,26 @@ static void convert_color_depth(uint8_t * img, uint32_t px_cnt)
 #endif
 }
 
-#endif /*LV_USE_PNG*/
+/**
+ * Copy the converted image to a buffer of `lv_img_cache_mem_alloc` which can be in a separate heap.
+ * The converted image is also smaller than the ARGB8888 buffer of the decoder if the color depth is not 32.
+ * @param img the converted image, it will be freed
+ * @param px_cnt number of pixels in `img`
+ * @return the new buffer or NULL on error
+ */
+static uint8_t * move_to_cache_mem(uint8_t * img, uint32_t px_cnt)
+{
+#if LV_IMG_CACHE_MEM_CUSTOM == 0 && LV_COLOR_DEPTH == 32
+    LV_UNUSED(px_cnt);
+    return img;
+#else
+    uint8_t * img_cache = lv_img_cache_mem_alloc(px_cnt * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    LV_ASSERT_MALLOC(img_cache);
+    if(img_cache) lv_memcpy(img_cache, img, px_cnt * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    lv_mem_free(img);
+    return img_cache;
+#endif
+}
 
+#endif /*LV_USE_PNG*/
 
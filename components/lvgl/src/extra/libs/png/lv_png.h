@@ -14,6 +14,7 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "../../../lv_conf_internal.h"
+#include "lv_png_stream.h"
 #if LV_USE_PNG
 
 /*********************
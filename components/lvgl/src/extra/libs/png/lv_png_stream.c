@@ -0,0 +1,835 @@
+/**
+ * @file lv_png_stream.c
+ *
+ * Decode PNG images row by row with an incremental inflater.
+ * The deflate stream is pulled on demand: decoding a row inflates only the bytes of that row
+ * and the back references are resolved from a sliding window of the last decompressed bytes.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_png_stream.h"
+#if LV_USE_PNG
+
+#include <string.h>
+#include "../../../misc/lv_mem.h"
+#include "../../../misc/lv_assert.h"
+#include "../../../misc/lv_log.h"
+#include "../../../misc/lv_math.h"
+#include "../../../misc/lv_color.h"
+#include "../../../draw/lv_img_buf.h"
+#include "../../../draw/lv_draw_img.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define FAST_MASK           ((1 << LV_PNG_STREAM_FAST_BITS) - 1)
+#define BLOCK_STORED        0
+#define BLOCK_NEW           3
+#define MAX_OVERRUN         4       /*The Adler-32 checksum follows the data so no more bytes can be missing*/
+#define COLOR_TMP_PX        64      /*Pixels converted at once through RGBA8888*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t src_read(lv_png_stream_t * s, void * buf, uint32_t len);
+static lv_res_t src_seek(lv_png_stream_t * s, uint32_t pos);
+static lv_res_t read_header(lv_png_stream_t * s);
+static lv_res_t stream_rewind(lv_png_stream_t * s);
+static bool input_fill(lv_png_stream_t * s);
+static uint32_t get_bits(lv_png_stream_t * s, uint32_t n);
+static lv_res_t huffman_build(lv_png_huffman_t * h, const uint8_t * lens, uint32_t n);
+static int32_t huffman_decode(lv_png_stream_t * s, const lv_png_huffman_t * h);
+static lv_res_t block_start(lv_png_stream_t * s);
+static lv_res_t dynamic_codes_read(lv_png_stream_t * s);
+static lv_res_t inflate_read(lv_png_stream_t * s, uint8_t * out, uint32_t n);
+static lv_res_t row_decode(lv_png_stream_t * s);
+static void unfilter(uint8_t type, uint8_t * row, const uint8_t * prev, uint32_t size, uint32_t bpp);
+static uint32_t get_u32_be(const uint8_t * p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint16_t len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+    4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+static const uint8_t code_len_order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_res_t lv_png_stream_open(lv_png_stream_t * s, const void * src)
+{
+    LV_ASSERT_NULL(s);
+    lv_memset_00(s, sizeof(lv_png_stream_t));
+
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type == LV_IMG_SRC_FILE) {
+        if(lv_fs_open(&s->file, src, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+        s->file_opened = 1;
+    }
+    else if(src_type == LV_IMG_SRC_VARIABLE) {
+        const lv_img_dsc_t * img_dsc = src;
+        s->data = img_dsc->data;
+        s->data_size = img_dsc->data_size;
+    }
+    else {
+        return LV_RES_INV;
+    }
+
+    if(read_header(s) != LV_RES_OK) {
+        lv_png_stream_close(s);
+        return LV_RES_INV;
+    }
+
+    /*The rows with their filter type byte*/
+    s->row = lv_mem_alloc((s->row_size + 1) * 2);
+    LV_ASSERT_MALLOC(s->row);
+    if(s->row == NULL) {
+        lv_png_stream_close(s);
+        return LV_RES_INV;
+    }
+    s->prev_row = s->row + s->row_size + 1;
+
+    /*Read the zlib header and allocate the window*/
+    if(stream_rewind(s) != LV_RES_OK) {
+        lv_png_stream_close(s);
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_png_stream_read_row(lv_png_stream_t * s, uint32_t y)
+{
+    LV_ASSERT_NULL(s);
+    if(y >= s->h) return LV_RES_INV;
+    if(y + 1 == s->next_y) return LV_RES_OK;
+
+    if(y < s->next_y) {
+        if(stream_rewind(s) != LV_RES_OK) return LV_RES_INV;
+    }
+
+    while(s->next_y <= y) {
+        if(row_decode(s) != LV_RES_OK) {
+            /*Start again at the next read*/
+            s->next_y = s->h + 1;
+            return LV_RES_INV;
+        }
+    }
+
+    return LV_RES_OK;
+}
+
+void lv_png_stream_get_rgba(const lv_png_stream_t * s, uint32_t x, uint32_t len, uint8_t * buf)
+{
+    LV_ASSERT_NULL(s);
+    const uint8_t * p = s->row + 1;
+    uint32_t i;
+
+    switch(s->color_type) {
+        case 6:     /*RGBA*/
+            if(s->bit_depth == 8) {
+                lv_memcpy(buf, p + x * 4, len * 4);
+            }
+            else {
+                p += x * 8;
+                for(i = 0; i < len * 4; i++) buf[i] = p[i * 2];
+            }
+            break;
+        case 2:     /*RGB*/
+            if(s->bit_depth == 8) {
+                p += x * 3;
+                for(i = 0; i < len; i++) {
+                    buf[0] = p[0];
+                    buf[1] = p[1];
+                    buf[2] = p[2];
+                    buf[3] = (s->has_trns && p[0] == s->trns_key[0] && p[1] == s->trns_key[1] &&
+                              p[2] == s->trns_key[2]) ? 0 : 255;
+                    p += 3;
+                    buf += 4;
+                }
+            }
+            else {
+                p += x * 6;
+                for(i = 0; i < len; i++) {
+                    buf[0] = p[0];
+                    buf[1] = p[2];
+                    buf[2] = p[4];
+                    bool key = s->has_trns && ((p[0] << 8) | p[1]) == s->trns_key[0] &&
+                               ((p[2] << 8) | p[3]) == s->trns_key[1] && ((p[4] << 8) | p[5]) == s->trns_key[2];
+                    buf[3] = key ? 0 : 255;
+                    p += 6;
+                    buf += 4;
+                }
+            }
+            break;
+        case 4:     /*Gray with alpha*/
+            p += x * 2 * (s->bit_depth / 8);
+            for(i = 0; i < len; i++) {
+                buf[0] = p[0];
+                buf[1] = p[0];
+                buf[2] = p[0];
+                buf[3] = s->bit_depth == 8 ? p[1] : p[2];
+                p += s->bit_depth == 8 ? 2 : 4;
+                buf += 4;
+            }
+            break;
+        case 0:     /*Gray*/
+        case 3: {   /*Indexed*/
+                uint32_t bd = s->bit_depth;
+                uint32_t mask = bd >= 8 ? 0xFF : (1 << bd) - 1;
+                uint32_t scale = bd >= 8 ? 1 : 255 / mask;
+                for(i = 0; i < len; i++) {
+                    uint32_t px = x + i;
+                    uint32_t v;
+                    if(bd == 16) v = (p[px * 2] << 8) | p[px * 2 + 1];
+                    else if(bd == 8) v = p[px];
+                    else v = (p[(px * bd) >> 3] >> (8 - bd - ((px * bd) & 7))) & mask;
+
+                    if(s->color_type == 3) {
+                        if(v < s->palette_cnt) lv_memcpy(buf, s->palette[v], 4);
+                        else {
+                            buf[0] = 0;
+                            buf[1] = 0;
+                            buf[2] = 0;
+                            buf[3] = 255;
+                        }
+                    }
+                    else {
+                        uint8_t g = bd == 16 ? v >> 8 : v * scale;
+                        buf[0] = g;
+                        buf[1] = g;
+                        buf[2] = g;
+                        buf[3] = s->has_trns && v == s->trns_key[0] ? 0 : 255;
+                    }
+                    buf += 4;
+                }
+                break;
+            }
+        default:
+            break;
+    }
+}
+
+void lv_png_stream_get_color(const lv_png_stream_t * s, uint32_t x, uint32_t len, uint8_t * buf)
+{
+    LV_ASSERT_NULL(s);
+    uint8_t rgba[COLOR_TMP_PX * 4];
+
+    while(len) {
+        uint32_t cnt = LV_MIN(len, COLOR_TMP_PX);
+        const uint8_t * px;
+        /*8 bit RGBA is converted right from the row*/
+        if(s->color_type == 6 && s->bit_depth == 8) {
+            px = s->row + 1 + x * 4;
+        }
+        else {
+            lv_png_stream_get_rgba(s, x, cnt, rgba);
+            px = rgba;
+        }
+
+        uint32_t i;
+        for(i = 0; i < cnt; i++) {
+#if LV_COLOR_DEPTH == 32
+            buf[0] = px[2];
+            buf[1] = px[1];
+            buf[2] = px[0];
+            buf[3] = px[3];
+#elif LV_COLOR_DEPTH == 16
+            lv_color_t c = lv_color_make(px[0], px[1], px[2]);
+            buf[0] = c.full & 0xFF;
+            buf[1] = c.full >> 8;
+            buf[2] = px[3];
+#elif LV_COLOR_DEPTH == 8
+            lv_color_t c = lv_color_make(px[0], px[1], px[2]);
+            buf[0] = c.full;
+            buf[1] = px[3];
+#elif LV_COLOR_DEPTH == 1
+            buf[0] = (px[0] | px[1] | px[2]) > 128 ? 1 : 0;
+            buf[1] = px[3];
+#endif
+            px += 4;
+            buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+
+        x += cnt;
+        len -= cnt;
+    }
+}
+
+void lv_png_stream_close(lv_png_stream_t * s)
+{
+    LV_ASSERT_NULL(s);
+    if(s->file_opened) lv_fs_close(&s->file);
+    s->file_opened = 0;
+    lv_mem_free(s->palette);
+    lv_mem_free(s->row < s->prev_row ? s->row : s->prev_row);    /*They are swapped but allocated together*/
+    lv_mem_free(s->window);
+    s->palette = NULL;
+    s->row = NULL;
+    s->prev_row = NULL;
+    s->window = NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t src_read(lv_png_stream_t * s, void * buf, uint32_t len)
+{
+    if(s->data) {
+        len = LV_MIN(len, s->data_size - LV_MIN(s->src_pos, s->data_size));
+        lv_memcpy(buf, s->data + s->src_pos, len);
+        s->src_pos += len;
+        return len;
+    }
+
+    uint32_t br = 0;
+    lv_fs_read(&s->file, buf, len, &br);
+    s->src_pos += br;
+    return br;
+}
+
+static lv_res_t src_seek(lv_png_stream_t * s, uint32_t pos)
+{
+    s->src_pos = pos;
+    if(s->data) return pos <= s->data_size ? LV_RES_OK : LV_RES_INV;
+    return lv_fs_seek(&s->file, pos, LV_FS_SEEK_SET) == LV_FS_RES_OK ? LV_RES_OK : LV_RES_INV;
+}
+
+/**
+ * Read the chunks until the first IDAT: the size, the format, the palette and the transparent color
+ */
+static lv_res_t read_header(lv_png_stream_t * s)
+{
+    static const uint8_t magic[8] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+    uint8_t buf[13];
+    if(src_read(s, buf, 8) != 8 || memcmp(buf, magic, 8) != 0) return LV_RES_INV;
+
+    bool ihdr = false;
+    while(1) {
+        uint8_t head[8];
+        if(src_read(s, head, 8) != 8) return LV_RES_INV;
+        uint32_t len = get_u32_be(head);
+        const uint8_t * type = &head[4];
+        uint32_t next_pos = s->src_pos + len + 4;     /*Skip the CRC too*/
+
+        if(memcmp(type, "IHDR", 4) == 0) {
+            if(len != 13 || src_read(s, buf, 13) != 13) return LV_RES_INV;
+            s->w = get_u32_be(&buf[0]);
+            s->h = get_u32_be(&buf[4]);
+            s->bit_depth = buf[8];
+            s->color_type = buf[9];
+            /*Compression, filter method and interlace*/
+            if(buf[10] != 0 || buf[11] != 0) return LV_RES_INV;
+            if(buf[12] != 0) {
+                LV_LOG_INFO("Interlaced PNGs can't be decoded row by row");
+                return LV_RES_INV;
+            }
+            if(s->w == 0 || s->h == 0 || s->w > 0xFFFF || s->h > 0xFFFF) return LV_RES_INV;
+
+            uint32_t channels;
+            uint32_t bd = s->bit_depth;
+            switch(s->color_type) {
+                case 0:
+                    channels = 1;
+                    if(bd != 1 && bd != 2 && bd != 4 && bd != 8 && bd != 16) return LV_RES_INV;
+                    break;
+                case 3:
+                    channels = 1;
+                    if(bd != 1 && bd != 2 && bd != 4 && bd != 8) return LV_RES_INV;
+                    break;
+                case 2:
+                    channels = 3;
+                    if(bd != 8 && bd != 16) return LV_RES_INV;
+                    break;
+                case 4:
+                    channels = 2;
+                    if(bd != 8 && bd != 16) return LV_RES_INV;
+                    break;
+                case 6:
+                    channels = 4;
+                    if(bd != 8 && bd != 16) return LV_RES_INV;
+                    break;
+                default:
+                    return LV_RES_INV;
+            }
+            uint32_t px_bits = channels * bd;
+            s->row_size = (s->w * px_bits + 7) >> 3;
+            s->filter_bpp = LV_MAX(px_bits >> 3, 1);
+            ihdr = true;
+        }
+        else if(!ihdr) {
+            return LV_RES_INV;
+        }
+        else if(memcmp(type, "PLTE", 4) == 0) {
+            if(s->color_type == 3) {
+                if(len % 3 || len > 256 * 3 || s->palette) return LV_RES_INV;
+                s->palette_cnt = len / 3;
+                s->palette = lv_mem_alloc(256 * 4);
+                LV_ASSERT_MALLOC(s->palette);
+                if(s->palette == NULL) return LV_RES_INV;
+                uint32_t i;
+                for(i = 0; i < s->palette_cnt; i++) {
+                    if(src_read(s, s->palette[i], 3) != 3) return LV_RES_INV;
+                    s->palette[i][3] = 0xFF;
+                }
+            }
+        }
+        else if(memcmp(type, "tRNS", 4) == 0) {
+            if(s->color_type == 3) {
+                /*Alpha of the first palette entries*/
+                if(s->palette == NULL || len > s->palette_cnt) return LV_RES_INV;
+                uint32_t i;
+                for(i = 0; i < len; i++) {
+                    if(src_read(s, &s->palette[i][3], 1) != 1) return LV_RES_INV;
+                }
+            }
+            else if(s->color_type == 0 || s->color_type == 2) {
+                uint32_t cnt = s->color_type == 0 ? 1 : 3;
+                if(len != cnt * 2 || src_read(s, buf, len) != len) return LV_RES_INV;
+                uint32_t i;
+                for(i = 0; i < cnt; i++) s->trns_key[i] = (buf[i * 2] << 8) | buf[i * 2 + 1];
+                s->has_trns = 1;
+            }
+        }
+        else if(memcmp(type, "IDAT", 4) == 0) {
+            if(s->color_type == 3 && s->palette == NULL) return LV_RES_INV;
+            s->idat_pos = s->src_pos - 8;
+            return LV_RES_OK;
+        }
+        else if(memcmp(type, "IEND", 4) == 0) {
+            return LV_RES_INV;
+        }
+
+        if(src_seek(s, next_pos) != LV_RES_OK) return LV_RES_INV;
+    }
+}
+
+/**
+ * Go back to the first row: reset the inflater and read the zlib header
+ */
+static lv_res_t stream_rewind(lv_png_stream_t * s)
+{
+    if(src_seek(s, s->idat_pos) != LV_RES_OK) return LV_RES_INV;
+    uint8_t head[8];
+    if(src_read(s, head, 8) != 8) return LV_RES_INV;
+    s->chunk_left = get_u32_be(head);
+    s->in_left = 0;
+    s->bit_buf = 0;
+    s->bit_cnt = 0;
+    s->in_overrun = 0;
+    s->block_type = BLOCK_NEW;
+    s->last_block = 0;
+    s->copy_len = 0;
+    s->stored_left = 0;
+    s->window_pos = 0;
+    s->next_y = 0;
+    /*It becomes the previous row of the first row*/
+    lv_memset_00(s->row, s->row_size + 1);
+
+    uint32_t cmf = get_bits(s, 8);
+    uint32_t flg = get_bits(s, 8);
+    if((cmf & 0x0F) != 8 || (cmf >> 4) > 7 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20)) {
+        LV_LOG_WARN("Invalid zlib header in a PNG");
+        return LV_RES_INV;
+    }
+
+    if(s->window == NULL) {
+        /*No distance can be larger than the whole image data*/
+        uint32_t size = 1 << ((cmf >> 4) + 8);
+        uint64_t raw_size = (uint64_t)s->h * (s->row_size + 1);
+        while(size > 256 && (size >> 1) >= raw_size) size >>= 1;
+
+        s->window = lv_mem_alloc(size);
+        LV_ASSERT_MALLOC(s->window);
+        if(s->window == NULL) return LV_RES_INV;
+        s->window_mask = size - 1;
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Make the next bytes of the IDAT chunks available in `s->in`
+ * @return false: no more IDAT data
+ */
+static bool input_fill(lv_png_stream_t * s)
+{
+    while(s->chunk_left == 0) {
+        /*Skip the CRC and read the header of the next chunk*/
+        uint8_t head[12];
+        if(src_read(s, head, 12) != 12 || memcmp(&head[8], "IDAT", 4) != 0) return false;
+        s->chunk_left = get_u32_be(&head[4]);
+    }
+
+    uint32_t n;
+    if(s->data) {
+        n = LV_MIN(s->chunk_left, s->data_size - LV_MIN(s->src_pos, s->data_size));
+        s->in = s->data + s->src_pos;
+        s->src_pos += n;
+    }
+    else {
+        n = src_read(s, s->in_buf, LV_MIN(s->chunk_left, LV_PNG_STREAM_IN_BUF_SIZE));
+        s->in = s->in_buf;
+    }
+    if(n == 0) return false;
+
+    s->chunk_left -= n;
+    s->in_left = n;
+    return true;
+}
+
+static inline void bits_fill(lv_png_stream_t * s)
+{
+    while(s->bit_cnt <= 24) {
+        uint32_t b;
+        if(s->in_left || input_fill(s)) {
+            b = *s->in++;
+            s->in_left--;
+        }
+        else {
+            /*Feed zeros at the end. It's an error only if they are really used.*/
+            b = 0;
+            if(s->in_overrun < 0xFF) s->in_overrun++;
+        }
+        s->bit_buf |= b << s->bit_cnt;
+        s->bit_cnt += 8;
+    }
+}
+
+static uint32_t get_bits(lv_png_stream_t * s, uint32_t n)
+{
+    if(s->bit_cnt < n) bits_fill(s);
+    uint32_t v = s->bit_buf & ((1UL << n) - 1);
+    s->bit_buf >>= n;
+    s->bit_cnt -= n;
+    return v;
+}
+
+/**
+ * Build a canonical Huffman code from code lengths
+ */
+static lv_res_t huffman_build(lv_png_huffman_t * h, const uint8_t * lens, uint32_t n)
+{
+    uint16_t offs[16];
+    uint32_t i;
+    uint32_t len;
+
+    lv_memset_00(h->count, sizeof(h->count));
+    for(i = 0; i < n; i++) h->count[lens[i]]++;
+    h->count[0] = 0;
+
+    /*Over-subscribed codes are invalid. Incomplete codes are allowed (e.g. a single distance code).*/
+    int32_t left = 1;
+    for(len = 1; len < 16; len++) {
+        left <<= 1;
+        left -= h->count[len];
+        if(left < 0) return LV_RES_INV;
+    }
+
+    offs[1] = 0;
+    for(len = 1; len < 15; len++) offs[len + 1] = offs[len] + h->count[len];
+    for(i = 0; i < n; i++) {
+        if(lens[i]) h->symbol[offs[lens[i]]++] = i;
+    }
+
+    /*Fill the lookup table of the short codes. The codes are stored bit reversed in the stream.*/
+    lv_memset_00(h->fast, sizeof(h->fast));
+    uint32_t code = 0;
+    uint32_t index = 0;
+    for(len = 1; len <= LV_PNG_STREAM_FAST_BITS; len++) {
+        uint32_t k;
+        for(k = 0; k < h->count[len]; k++) {
+            uint32_t rev = 0;
+            uint32_t b;
+            for(b = 0; b < len; b++) rev |= ((code >> b) & 1) << (len - 1 - b);
+            uint16_t entry = (len << 9) | h->symbol[index];
+            uint32_t j;
+            for(j = rev; j <= FAST_MASK; j += 1 << len) h->fast[j] = entry;
+            code++;
+            index++;
+        }
+        code <<= 1;
+    }
+
+    return LV_RES_OK;
+}
+
+static int32_t huffman_decode(lv_png_stream_t * s, const lv_png_huffman_t * h)
+{
+    if(s->bit_cnt < 16) bits_fill(s);
+
+    uint32_t entry = h->fast[s->bit_buf & FAST_MASK];
+    if(entry) {
+        uint32_t len = entry >> 9;
+        s->bit_buf >>= len;
+        s->bit_cnt -= len;
+        return entry & 0x1FF;
+    }
+
+    /*A longer code: walk the canonical code bit by bit*/
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    uint32_t len;
+    for(len = 1; len < 16; len++) {
+        code |= s->bit_buf & 1;
+        s->bit_buf >>= 1;
+        s->bit_cnt--;
+        int32_t count = h->count[len];
+        if(code - first < count) return h->symbol[index + (code - first)];
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    return -1;
+}
+
+static lv_res_t block_start(lv_png_stream_t * s)
+{
+    if(s->last_block) return LV_RES_INV;     /*More data is needed than the stream has*/
+
+    s->last_block = get_bits(s, 1);
+    uint32_t type = get_bits(s, 2);
+
+    if(type == 0) {
+        /*Stored: skip to the byte boundary and read LEN and NLEN*/
+        get_bits(s, s->bit_cnt & 7);
+        uint32_t len = get_bits(s, 16);
+        uint32_t nlen = get_bits(s, 16);
+        if((len ^ 0xFFFF) != nlen) return LV_RES_INV;
+        s->stored_left = len;
+        s->block_type = BLOCK_STORED;
+    }
+    else if(type == 1) {
+        if(!s->fixed_ready) {
+            uint8_t lens[288];
+            lv_memset(lens, 8, 144);
+            lv_memset(lens + 144, 9, 112);
+            lv_memset(lens + 256, 7, 24);
+            lv_memset(lens + 280, 8, 8);
+            huffman_build(&s->lit, lens, 288);
+            lv_memset(lens, 5, 30);
+            huffman_build(&s->dist, lens, 30);
+            s->fixed_ready = 1;
+        }
+        s->block_type = 1;
+    }
+    else if(type == 2) {
+        s->fixed_ready = 0;
+        if(dynamic_codes_read(s) != LV_RES_OK) return LV_RES_INV;
+        s->block_type = 2;
+    }
+    else {
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+static lv_res_t dynamic_codes_read(lv_png_stream_t * s)
+{
+    uint8_t lens[288 + 32];
+    uint32_t hlit = get_bits(s, 5) + 257;
+    uint32_t hdist = get_bits(s, 5) + 1;
+    uint32_t hclen = get_bits(s, 4) + 4;
+    if(hlit > 286 || hdist > 30) return LV_RES_INV;
+
+    /*The code of the code lengths is built temporarily in `dist`*/
+    uint8_t cl_lens[19];
+    lv_memset_00(cl_lens, sizeof(cl_lens));
+    uint32_t i;
+    for(i = 0; i < hclen; i++) cl_lens[code_len_order[i]] = get_bits(s, 3);
+    if(huffman_build(&s->dist, cl_lens, 19) != LV_RES_OK) return LV_RES_INV;
+
+    i = 0;
+    while(i < hlit + hdist) {
+        int32_t sym = huffman_decode(s, &s->dist);
+        if(sym < 0) return LV_RES_INV;
+        if(sym < 16) {
+            lens[i++] = sym;
+            continue;
+        }
+
+        uint32_t rep;
+        uint8_t v = 0;
+        if(sym == 16) {
+            if(i == 0) return LV_RES_INV;
+            v = lens[i - 1];
+            rep = 3 + get_bits(s, 2);
+        }
+        else if(sym == 17) {
+            rep = 3 + get_bits(s, 3);
+        }
+        else {
+            rep = 11 + get_bits(s, 7);
+        }
+        if(i + rep > hlit + hdist) return LV_RES_INV;
+        lv_memset(lens + i, v, rep);
+        i += rep;
+    }
+
+    /*The end of block code is required*/
+    if(lens[256] == 0) return LV_RES_INV;
+    if(huffman_build(&s->lit, lens, hlit) != LV_RES_OK) return LV_RES_INV;
+    if(huffman_build(&s->dist, lens + hlit, hdist) != LV_RES_OK) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Inflate exactly `n` bytes
+ */
+static lv_res_t inflate_read(lv_png_stream_t * s, uint8_t * out, uint32_t n)
+{
+    uint8_t * win = s->window;
+    uint32_t mask = s->window_mask;
+
+    while(n) {
+        if(s->copy_len) {
+            /*Continue the current match*/
+            uint32_t cnt = LV_MIN(s->copy_len, n);
+            uint32_t from = s->window_pos - s->copy_dist;
+            uint32_t pos = s->window_pos;
+            s->copy_len -= cnt;
+            s->window_pos += cnt;
+            n -= cnt;
+            while(cnt--) {
+                uint8_t b = win[from++ & mask];
+                win[pos++ & mask] = b;
+                *out++ = b;
+            }
+        }
+        else if(s->block_type == BLOCK_NEW) {
+            if(block_start(s) != LV_RES_OK) return LV_RES_INV;
+        }
+        else if(s->block_type == BLOCK_STORED) {
+            if(s->stored_left == 0) {
+                s->block_type = BLOCK_NEW;
+                continue;
+            }
+            uint8_t b;
+            if(s->bit_cnt) {
+                /*The bytes already in the bit buffer come first*/
+                b = get_bits(s, 8);
+            }
+            else {
+                if(s->in_left == 0 && !input_fill(s)) return LV_RES_INV;
+                b = *s->in++;
+                s->in_left--;
+            }
+            win[s->window_pos++ & mask] = b;
+            *out++ = b;
+            s->stored_left--;
+            n--;
+        }
+        else {
+            int32_t sym = huffman_decode(s, &s->lit);
+            if(sym < 256) {
+                if(sym < 0) return LV_RES_INV;
+                win[s->window_pos++ & mask] = sym;
+                *out++ = sym;
+                n--;
+            }
+            else if(sym == 256) {
+                s->block_type = BLOCK_NEW;
+            }
+            else {
+                sym -= 257;
+                if(sym >= 29) return LV_RES_INV;
+                uint32_t len = len_base[sym] + get_bits(s, len_extra[sym]);
+                int32_t dsym = huffman_decode(s, &s->dist);
+                if(dsym < 0 || dsym >= 30) return LV_RES_INV;
+                uint32_t dist = dist_base[dsym] + get_bits(s, dist_extra[dsym]);
+                if(dist > s->window_pos || dist > mask + 1) return LV_RES_INV;
+                s->copy_len = len;
+                s->copy_dist = dist;
+            }
+        }
+
+        if(s->in_overrun > MAX_OVERRUN) return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Inflate and unfilter the next row
+ */
+static lv_res_t row_decode(lv_png_stream_t * s)
+{
+    uint8_t * tmp = s->prev_row;
+    s->prev_row = s->row;
+    s->row = tmp;
+
+    if(inflate_read(s, s->row, s->row_size + 1) != LV_RES_OK) return LV_RES_INV;
+    if(s->row[0] > 4) return LV_RES_INV;
+
+    unfilter(s->row[0], s->row + 1, s->prev_row + 1, s->row_size, s->filter_bpp);
+    s->next_y++;
+    return LV_RES_OK;
+}
+
+static void unfilter(uint8_t type, uint8_t * row, const uint8_t * prev, uint32_t size, uint32_t bpp)
+{
+    uint32_t i;
+    switch(type) {
+        case 1:     /*Sub*/
+            for(i = bpp; i < size; i++) row[i] += row[i - bpp];
+            break;
+        case 2:     /*Up*/
+            for(i = 0; i < size; i++) row[i] += prev[i];
+            break;
+        case 3:     /*Average*/
+            for(i = 0; i < bpp; i++) row[i] += prev[i] >> 1;
+            for(; i < size; i++) row[i] += (row[i - bpp] + prev[i]) >> 1;
+            break;
+        case 4:     /*Paeth*/
+            for(i = 0; i < bpp; i++) row[i] += prev[i];
+            for(; i < size; i++) {
+                int32_t a = row[i - bpp];
+                int32_t b = prev[i];
+                int32_t c = prev[i - bpp];
+                int32_t pa = LV_ABS(b - c);
+                int32_t pb = LV_ABS(a - c);
+                int32_t pc = LV_ABS(a + b - 2 * c);
+                if(pa <= pb && pa <= pc) row[i] += a;
+                else if(pb <= pc) row[i] += b;
+                else row[i] += c;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static uint32_t get_u32_be(const uint8_t * p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+#endif /*LV_USE_PNG*/
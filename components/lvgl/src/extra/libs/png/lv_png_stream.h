@@ -0,0 +1,148 @@
+/**
+ * @file lv_png_stream.h
+ *
+ */
+
+#ifndef LV_PNG_STREAM_H
+#define LV_PNG_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lv_conf_internal.h"
+#if LV_USE_PNG
+
+#include "../../../misc/lv_fs.h"
+#include "../../../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_PNG_STREAM_IN_BUF_SIZE   512     /*Bytes read from a file at once*/
+#define LV_PNG_STREAM_FAST_BITS     9       /*Huffman codes up to this length are decoded with one table lookup*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A canonical Huffman code of the deflate stream
+ */
+typedef struct {
+    uint16_t fast[1 << LV_PNG_STREAM_FAST_BITS];    /*(code length << 9) | symbol; 0: longer code*/
+    uint16_t count[16];                             /*Number of codes of each length*/
+    uint16_t symbol[288];                           /*Symbols ordered by their codes*/
+} lv_png_huffman_t;
+
+/**
+ * Decode a PNG image row by row.
+ * Only the zlib window (at most 32 kB, less for small images) and two rows are kept in the RAM.
+ */
+typedef struct {
+    /*Source*/
+    lv_fs_file_t file;
+    const uint8_t * data;       /*The PNG file in the memory or NULL if read from `file`*/
+    uint32_t data_size;
+    uint32_t src_pos;           /*Position of the next chunk data in the source*/
+    uint32_t idat_pos;          /*Position of the first IDAT chunk*/
+    uint32_t chunk_left;        /*Bytes of the current IDAT chunk which are not read yet*/
+    const uint8_t * in;         /*The next input bytes of the inflater*/
+    uint32_t in_left;
+    uint8_t in_buf[LV_PNG_STREAM_IN_BUF_SIZE];
+
+    /*Header*/
+    uint32_t w;
+    uint32_t h;
+    uint32_t row_size;          /*Bytes in a row without the filter type*/
+    uint8_t bit_depth;
+    uint8_t color_type;
+    uint8_t filter_bpp;         /*Bytes per pixel for the filters (at least 1)*/
+    uint8_t has_trns : 1;       /*A transparent color is set for gray or RGB images*/
+    uint8_t file_opened : 1;
+    uint16_t trns_key[3];
+    uint16_t palette_cnt;
+    uint8_t (*palette)[4];      /*RGBA colors of the palette, allocated only for indexed images*/
+
+    /*Rows*/
+    uint8_t * row;              /*The current row (the filter type and `row_size` bytes)*/
+    uint8_t * prev_row;
+    uint32_t next_y;            /*The row which will be decoded next*/
+
+    /*Inflater*/
+    uint32_t bit_buf;
+    uint8_t bit_cnt;
+    uint8_t block_type;         /*0: stored, 1..2: compressed, 3: read a new block header*/
+    uint8_t last_block : 1;
+    uint8_t fixed_ready : 1;    /*The fixed Huffman codes are built in `lit` and `dist`*/
+    uint8_t in_overrun;         /*Zero bytes fed after the end of the data*/
+    uint32_t stored_left;
+    uint32_t copy_len;          /*The remaining length of the current match*/
+    uint32_t copy_dist;
+    uint8_t * window;           /*The last decompressed bytes*/
+    uint32_t window_mask;       /*Size of the window - 1*/
+    uint32_t window_pos;
+    uint32_t out_total;
+    lv_png_huffman_t lit;
+    lv_png_huffman_t dist;
+} lv_png_stream_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Open a PNG image for decoding row by row. Interlaced images are not supported.
+ * @param s         pointer to a stream (it's large, usually allocated)
+ * @param src       path of a PNG file or pointer to an `lv_img_dsc_t` with a PNG file in `data`
+ * @return          LV_RES_OK: the image can be decoded; LV_RES_INV: invalid or unsupported image
+ */
+lv_res_t lv_png_stream_open(lv_png_stream_t * s, const void * src);
+
+/**
+ * Decode a row into `s->row`. Reading the rows from top to bottom is the fastest,
+ * reading an earlier row restarts the decoding from the first row.
+ * @param s         pointer to an opened stream
+ * @param y         the row to decode
+ * @return          LV_RES_OK: ok; LV_RES_INV: decoding error
+ */
+lv_res_t lv_png_stream_read_row(lv_png_stream_t * s, uint32_t y);
+
+/**
+ * Convert pixels of the last decoded row to RGBA8888 (R, G, B, A bytes)
+ * @param s         pointer to a stream
+ * @param x         the first pixel
+ * @param len       number of pixels
+ * @param buf       store the pixels here (`len * 4` bytes)
+ */
+void lv_png_stream_get_rgba(const lv_png_stream_t * s, uint32_t x, uint32_t len, uint8_t * buf);
+
+/**
+ * Convert pixels of the last decoded row to the format of `LV_IMG_CF_TRUE_COLOR_ALPHA`
+ * @param s         pointer to a stream
+ * @param x         the first pixel
+ * @param len       number of pixels
+ * @param buf       store the pixels here (`len * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes)
+ */
+void lv_png_stream_get_color(const lv_png_stream_t * s, uint32_t x, uint32_t len, uint8_t * buf);
+
+/**
+ * Close the source and free the buffers of a stream
+ * @param s         pointer to a stream
+ */
+void lv_png_stream_close(lv_png_stream_t * s);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_PNG*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PNG_STREAM_H*/
@@ -0,0 +1,638 @@
+/**
+ * @file lv_rlz.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#if LV_USE_RLZ
+
+/*********************
+ *      DEFINES
+ *********************/
+#define RLZ_MAGIC       0x5A4C524C  /*"LRLZ"*/
+#define RLZ_VERSION     1
+#define FLAG_ALPHA      0x01        /*The image has a 4 bit alpha channel*/
+#define FLAG_OFS_32     0x02        /*The row offsets are 32 bit, else 16 bit*/
+
+/*Packets of the color streams. The colors are RGB565, little endian.
+ *0x00..0x3F: (c & 0x3F) + 1 literal colors follow
+ *0x40..0x7F: a color follows which is repeated (c & 0x3F) + 2 times
+ *0x80..0xFF: (c & 0x7F) + 2 colors are copied from `d + 1` colors back, `d` is the next byte*/
+#define LITERAL_MAX     64
+#define RUN_MAX         65
+#define COPY_MAX        129
+#define COPY_DIST_MAX   256
+
+/*Packets of the alpha streams
+ *0x00..0x7F: an alpha of (c & 0x0F) is repeated (((c & 0x70) << 4) | next byte) + 1 times
+ *0x80..0xFF: (c & 0x7F) + 1 alpha values follow, 2 in a byte, high nibble first*/
+#define A_RUN_MAX       2048
+#define A_LITERAL_MAX   128
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The compressed image is:
+ * - `rlz_header_t`
+ * - the offsets of the color streams of the rows
+ * - the offsets of the alpha streams of the rows if the image has alpha
+ * - the streams. The offsets are relative to the first stream.
+ *The rows are compressed separately, so any row can be decoded without the others.*/
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t flags;
+    uint16_t w;
+    uint16_t h;
+    uint16_t reserved;
+} rlz_header_t;
+
+typedef struct {
+    const uint8_t * data;       /*The compressed image*/
+    uint32_t data_size;
+    uint8_t * file_buf;         /*The loaded file or NULL for variables*/
+    rlz_header_t header;
+    const uint8_t * streams;
+    uint32_t streams_size;
+    uint16_t * row;             /*The colors of `row_y` decoded until `row_len`*/
+    int32_t row_y;
+    uint32_t row_len;
+    uint32_t row_pos;           /*Offset of the next packet of `row_y`*/
+} rlz_dsc_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
+static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf);
+static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static lv_res_t header_check(const uint8_t * data, uint32_t size, rlz_header_t * header);
+static uint32_t ofs_size_get(const rlz_header_t * header);
+static uint32_t ofs_get(const rlz_dsc_t * d, uint32_t i);
+static lv_res_t color_row_decode(rlz_dsc_t * d, uint32_t x_end);
+static lv_res_t alpha_row_decode(const rlz_dsc_t * d, uint32_t y, uint32_t x, uint32_t len, uint8_t * out);
+static uint8_t * color_literal_flush(uint8_t * o, const uint16_t * px, uint32_t cnt);
+static uint32_t color_row_encode(const uint16_t * px, uint32_t w, uint8_t * out);
+static uint8_t * alpha_literal_flush(uint8_t * o, const uint8_t * a, uint32_t cnt);
+static uint32_t alpha_row_encode(const uint8_t * a, uint32_t w, uint8_t * out);
+static inline lv_color_t color_from_565(uint16_t v);
+static inline uint16_t color_to_565(lv_color_t c);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_rlz_init(void)
+{
+    lv_img_decoder_t * dec = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(dec, decoder_info);
+    lv_img_decoder_set_open_cb(dec, decoder_open);
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+    lv_img_decoder_set_close_cb(dec, decoder_close);
+}
+
+lv_img_dsc_t * lv_rlz_encode(const lv_img_dsc_t * img)
+{
+    lv_img_cf_t cf = img->header.cf;
+    if(cf != LV_IMG_CF_TRUE_COLOR && cf != LV_IMG_CF_TRUE_COLOR_ALPHA) {
+        LV_LOG_WARN("only true color images can be compressed");
+        return NULL;
+    }
+
+    uint32_t w = img->header.w;
+    uint32_t h = img->header.h;
+    uint32_t px_size = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    if(w == 0 || h == 0 || (img->data_size != 0 && img->data_size < w * h * px_size)) return NULL;
+
+    /*Store the alpha channel only if there are not fully opaque pixels*/
+    bool alpha = false;
+    uint32_t i;
+    if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+        for(i = 0; i < w * h && !alpha; i++) {
+            uint8_t a = img->data[i * px_size + LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            if((a * 15 + 127) / 255 < 15) alpha = true;
+        }
+    }
+
+    /*A packet is at most 3 bytes per color and 2 bytes per alpha*/
+    uint32_t row_max = w * 3 + (alpha ? w * 2 : 0);
+    uint8_t * streams = lv_mem_alloc(row_max * h);
+    uint32_t * ofs = lv_mem_alloc(h * 2 * sizeof(uint32_t));
+    uint16_t * colors = lv_mem_alloc(w * sizeof(uint16_t));
+    uint8_t * alphas = lv_mem_alloc(w);
+    lv_img_dsc_t * res = NULL;
+    if(streams == NULL || ofs == NULL || colors == NULL || alphas == NULL) {
+        LV_LOG_WARN("out of memory");
+        goto end;
+    }
+
+    uint32_t pos = 0;
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        const uint8_t * src = img->data + y * w * px_size;
+        uint16_t prev = 0;
+        uint32_t x;
+        for(x = 0; x < w; x++) {
+            lv_color_t c;
+            lv_memcpy_small(&c, src, sizeof(lv_color_t));
+            uint8_t a = 15;
+            if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) a = (src[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] * 15 + 127) / 255;
+            alphas[x] = a;
+
+            /*The color of the transparent pixels doesn't matter, so continue the runs with them*/
+            if(alpha && a == 0) colors[x] = prev;
+            else colors[x] = color_to_565(c);
+            prev = colors[x];
+            src += px_size;
+        }
+
+        ofs[y] = pos;
+        pos += color_row_encode(colors, w, streams + pos);
+        if(alpha) {
+            ofs[h + y] = pos;
+            pos += alpha_row_encode(alphas, w, streams + pos);
+        }
+    }
+
+    rlz_header_t header;
+    lv_memset_00(&header, sizeof(header));
+    header.magic = RLZ_MAGIC;
+    header.version = RLZ_VERSION;
+    header.flags = (alpha ? FLAG_ALPHA : 0) | (pos > 0xFFFF ? FLAG_OFS_32 : 0);
+    header.w = (uint16_t)w;
+    header.h = (uint16_t)h;
+
+    uint32_t ofs_size = ofs_size_get(&header);
+    uint32_t ofs_cnt = alpha ? h * 2 : h;
+    uint32_t data_size = sizeof(rlz_header_t) + ofs_cnt * ofs_size + pos;
+    res = lv_mem_alloc(sizeof(lv_img_dsc_t) + data_size);
+    LV_ASSERT_MALLOC(res);
+    if(res == NULL) goto end;
+
+    uint8_t * data = (uint8_t *)(res + 1);
+    lv_memcpy(data, &header, sizeof(header));
+    uint8_t * p = data + sizeof(header);
+    for(i = 0; i < ofs_cnt; i++) {
+        uint32_t o = ofs[i];
+        uint32_t k;
+        for(k = 0; k < ofs_size; k++) *p++ = (o >> (k * 8)) & 0xFF;
+    }
+    lv_memcpy(p, streams, pos);
+
+    res->header.always_zero = 0;
+    res->header.reserved = 0;
+    res->header.cf = LV_RLZ_CF;
+    res->header.w = w;
+    res->header.h = h;
+    res->data_size = data_size;
+    res->data = data;
+
+end:
+    lv_mem_free(streams);
+    lv_mem_free(ofs);
+    lv_mem_free(colors);
+    lv_mem_free(alphas);
+    return res;
+}
+
+void lv_rlz_free(lv_img_dsc_t * img)
+{
+    if(img == NULL) return;
+    lv_img_cache_invalidate_src(img);
+    lv_mem_free(img);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    rlz_header_t rlz;
+
+    if(src_type == LV_IMG_SRC_VARIABLE) {
+        const lv_img_dsc_t * img_dsc = src;
+        if(img_dsc->header.cf != LV_RLZ_CF) return LV_RES_INV;
+        if(header_check(img_dsc->data, img_dsc->data_size, &rlz) != LV_RES_OK) return LV_RES_INV;
+    }
+    else if(src_type == LV_IMG_SRC_FILE) {
+        if(strcmp(lv_fs_get_ext(src), "rlz") != 0) return LV_RES_INV;
+
+        lv_fs_file_t f;
+        if(lv_fs_open(&f, src, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+        uint32_t rn = 0;
+        lv_fs_read(&f, &rlz, sizeof(rlz), &rn);
+        lv_fs_close(&f);
+        if(rn != sizeof(rlz) || rlz.magic != RLZ_MAGIC || rlz.version != RLZ_VERSION) return LV_RES_INV;
+    }
+    else {
+        return LV_RES_INV;
+    }
+
+    header->always_zero = 0;
+    header->cf = rlz.flags & FLAG_ALPHA ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+    header->w = rlz.w;
+    header->h = rlz.h;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    if(decoder_info(decoder, dsc->src, &dsc->header) != LV_RES_OK) return LV_RES_INV;
+
+    rlz_dsc_t * d = lv_mem_alloc(sizeof(rlz_dsc_t));
+    LV_ASSERT_MALLOC(d);
+    if(d == NULL) return LV_RES_INV;
+    lv_memset_00(d, sizeof(rlz_dsc_t));
+
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
+        const lv_img_dsc_t * img_dsc = dsc->src;
+        d->data = img_dsc->data;
+        d->data_size = img_dsc->data_size;
+    }
+    else {
+        /*The compressed images are small, so load the whole file*/
+        lv_fs_file_t f;
+        uint32_t size = 0;
+        if(lv_fs_open(&f, dsc->src, LV_FS_MODE_RD) == LV_FS_RES_OK) {
+            lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+            lv_fs_tell(&f, &size);
+            lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+            d->file_buf = lv_mem_alloc(size);
+            uint32_t rn = 0;
+            if(d->file_buf) lv_fs_read(&f, d->file_buf, size, &rn);
+            lv_fs_close(&f);
+            if(rn != size) size = 0;
+        }
+        d->data = d->file_buf;
+        d->data_size = size;
+    }
+
+    if(d->data == NULL || header_check(d->data, d->data_size, &d->header) != LV_RES_OK) {
+        LV_LOG_WARN("invalid RLZ image");
+        lv_mem_free(d->file_buf);
+        lv_mem_free(d);
+        return LV_RES_INV;
+    }
+
+    uint32_t ofs_cnt = d->header.flags & FLAG_ALPHA ? d->header.h * 2 : d->header.h;
+    d->streams = d->data + sizeof(rlz_header_t) + ofs_cnt * ofs_size_get(&d->header);
+    d->streams_size = d->data_size - (d->streams - d->data);
+    d->row = lv_mem_alloc(d->header.w * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(d->row);
+    if(d->row == NULL) {
+        lv_mem_free(d->file_buf);
+        lv_mem_free(d);
+        return LV_RES_INV;
+    }
+    d->row_y = -1;
+
+    dsc->user_data = d;
+
+    /*Decoded line by line*/
+    dsc->img_data = NULL;
+    dsc->mem_size = sizeof(rlz_dsc_t) + d->header.w * sizeof(uint16_t) + (d->file_buf ? d->data_size : 0);
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    rlz_dsc_t * d = dsc->user_data;
+    if(x < 0 || y < 0 || len <= 0 || x + len > d->header.w || y >= d->header.h) return LV_RES_INV;
+
+    /*Continue the last row if possible, e.g. when the image is drawn in parts*/
+    if(d->row_y != y) {
+        d->row_y = y;
+        d->row_len = 0;
+        d->row_pos = ofs_get(d, y);
+    }
+
+    if(color_row_decode(d, x + len) != LV_RES_OK) {
+        d->row_y = -1;
+        return LV_RES_INV;
+    }
+
+    const uint16_t * row = &d->row[x];
+    lv_coord_t i;
+    if((d->header.flags & FLAG_ALPHA) == 0) {
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+        lv_memcpy(buf, row, len * sizeof(uint16_t));
+#else
+        for(i = 0; i < len; i++) {
+            lv_color_t c = color_from_565(row[i]);
+            lv_memcpy_small(buf + i * sizeof(lv_color_t), &c, sizeof(lv_color_t));
+        }
+#endif
+        return LV_RES_OK;
+    }
+
+    for(i = 0; i < len; i++) {
+        lv_color_t c = color_from_565(row[i]);
+        lv_memcpy_small(buf + i * LV_IMG_PX_SIZE_ALPHA_BYTE, &c, sizeof(lv_color_t));
+    }
+
+    return alpha_row_decode(d, y, x, len, buf + LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+}
+
+static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    rlz_dsc_t * d = dsc->user_data;
+    if(d == NULL) return;
+
+    lv_mem_free(d->row);
+    lv_mem_free(d->file_buf);
+    lv_mem_free(d);
+    dsc->user_data = NULL;
+}
+
+/**
+ * Check the header and the offset tables
+ */
+static lv_res_t header_check(const uint8_t * data, uint32_t size, rlz_header_t * header)
+{
+    if(data == NULL || size < sizeof(rlz_header_t)) return LV_RES_INV;
+    lv_memcpy_small(header, data, sizeof(rlz_header_t));
+    if(header->magic != RLZ_MAGIC || header->version != RLZ_VERSION) return LV_RES_INV;
+    if(header->w == 0 || header->h == 0) return LV_RES_INV;
+
+    uint32_t ofs_cnt = header->flags & FLAG_ALPHA ? header->h * 2 : header->h;
+    if(size - sizeof(rlz_header_t) < ofs_cnt * ofs_size_get(header)) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+
+static uint32_t ofs_size_get(const rlz_header_t * header)
+{
+    return header->flags & FLAG_OFS_32 ? 4 : 2;
+}
+
+/**
+ * Get the `i`th offset: the color streams are `0..h-1` and the alpha streams are `h..2h-1`
+ */
+static uint32_t ofs_get(const rlz_dsc_t * d, uint32_t i)
+{
+    const uint8_t * p = d->data + sizeof(rlz_header_t);
+    if(d->header.flags & FLAG_OFS_32) {
+        p += i * 4;
+        return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    p += i * 2;
+    return p[0] | (p[1] << 8);
+}
+
+/**
+ * Decode the colors of `row_y` until at least `x_end`
+ */
+static lv_res_t color_row_decode(rlz_dsc_t * d, uint32_t x_end)
+{
+    uint32_t w = d->header.w;
+    uint16_t * row = d->row;
+    uint32_t len = d->row_len;
+    if(d->row_pos > d->streams_size) return LV_RES_INV;
+
+    const uint8_t * p = d->streams + d->row_pos;
+    const uint8_t * end = d->streams + d->streams_size;
+    while(len < x_end) {
+        if(p >= end) return LV_RES_INV;
+        uint8_t c = *p++;
+        uint32_t n;
+        uint32_t i;
+        if(c < 0x40) {
+            n = c + 1;
+            if(n > w - len || (uint32_t)(end - p) < n * 2) return LV_RES_INV;
+            for(i = 0; i < n; i++) {
+                row[len++] = p[0] | (p[1] << 8);
+                p += 2;
+            }
+        }
+        else if(c < 0x80) {
+            n = (c & 0x3F) + 2;
+            if(n > w - len || end - p < 2) return LV_RES_INV;
+            uint16_t v = p[0] | (p[1] << 8);
+            p += 2;
+            for(i = 0; i < n; i++) row[len++] = v;
+        }
+        else {
+            n = (c & 0x7F) + 2;
+            if(n > w - len || p >= end) return LV_RES_INV;
+            uint32_t dist = *p++ + 1;
+            if(dist > len) return LV_RES_INV;
+
+            /*Copy forward, the source and the destination can overlap*/
+            const uint16_t * s = &row[len - dist];
+            for(i = 0; i < n; i++) row[len + i] = s[i];
+            len += n;
+        }
+    }
+
+    d->row_len = len;
+    d->row_pos = p - d->streams;
+    return LV_RES_OK;
+}
+
+/**
+ * Decode the alpha of `x..x + len - 1` in row `y` into every `LV_IMG_PX_SIZE_ALPHA_BYTE`th byte of `out`
+ */
+static lv_res_t alpha_row_decode(const rlz_dsc_t * d, uint32_t y, uint32_t x, uint32_t len, uint8_t * out)
+{
+    uint32_t ofs = ofs_get(d, d->header.h + y);
+    if(ofs > d->streams_size) return LV_RES_INV;
+
+    const uint8_t * p = d->streams + ofs;
+    const uint8_t * end = d->streams + d->streams_size;
+    uint32_t x_end = x + len;
+    uint32_t px = 0;
+    while(px < x_end) {
+        if(p >= end) return LV_RES_INV;
+        uint8_t c = *p++;
+        uint32_t n;
+        uint32_t i;
+        if(c < 0x80) {
+            if(p >= end) return LV_RES_INV;
+            n = ((((uint32_t)c & 0x70) << 4) | *p++) + 1;
+            uint8_t a = (c & 0x0F) * 17;
+            uint32_t s = LV_MAX(px, x);
+            uint32_t e = LV_MIN(px + n, x_end);
+            for(i = s; i < e; i++) out[(i - x) * LV_IMG_PX_SIZE_ALPHA_BYTE] = a;
+        }
+        else {
+            n = (c & 0x7F) + 1;
+            if((uint32_t)(end - p) < (n + 1) / 2) return LV_RES_INV;
+            uint32_t s = LV_MAX(px, x);
+            uint32_t e = LV_MIN(px + n, x_end);
+            for(i = s; i < e; i++) {
+                uint32_t k = i - px;
+                uint8_t b = p[k >> 1];
+                out[(i - x) * LV_IMG_PX_SIZE_ALPHA_BYTE] = (k & 1 ? b & 0x0F : b >> 4) * 17;
+            }
+            p += (n + 1) / 2;
+        }
+        px += n;
+    }
+
+    return LV_RES_OK;
+}
+
+static uint8_t * color_literal_flush(uint8_t * o, const uint16_t * px, uint32_t cnt)
+{
+    if(cnt == 0) return o;
+    *o++ = cnt - 1;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        *o++ = px[i] & 0xFF;
+        *o++ = px[i] >> 8;
+    }
+    return o;
+}
+
+/**
+ * Compress a row of colors greedily: the longer of a run and a copy is used if it covers at least 2 colors
+ * @return the size of the compressed row
+ */
+static uint32_t color_row_encode(const uint16_t * px, uint32_t w, uint8_t * out)
+{
+    uint8_t * o = out;
+    uint32_t lit_start = 0;
+    uint32_t lit_cnt = 0;
+    uint32_t i = 0;
+    while(i < w) {
+        uint32_t run = 1;
+        while(i + run < w && run < RUN_MAX && px[i + run] == px[i]) run++;
+
+        uint32_t copy_len = 0;
+        uint32_t copy_dist = 0;
+        uint32_t l_max = LV_MIN(w - i, COPY_MAX);
+        uint32_t d_max = LV_MIN(i, COPY_DIST_MAX);
+        uint32_t d;
+        for(d = 1; d <= d_max && copy_len < l_max; d++) {
+            uint32_t l = 0;
+            while(l < l_max && px[i + l - d] == px[i + l]) l++;
+            if(l > copy_len) {
+                copy_len = l;
+                copy_dist = d;
+            }
+        }
+
+        if(run >= 2 && run >= copy_len) {
+            o = color_literal_flush(o, px + lit_start, lit_cnt);
+            lit_cnt = 0;
+            *o++ = 0x40 | (run - 2);
+            *o++ = px[i] & 0xFF;
+            *o++ = px[i] >> 8;
+            i += run;
+        }
+        else if(copy_len >= 2) {
+            o = color_literal_flush(o, px + lit_start, lit_cnt);
+            lit_cnt = 0;
+            *o++ = 0x80 | (copy_len - 2);
+            *o++ = copy_dist - 1;
+            i += copy_len;
+        }
+        else {
+            if(lit_cnt == 0) lit_start = i;
+            lit_cnt++;
+            i++;
+            if(lit_cnt == LITERAL_MAX) {
+                o = color_literal_flush(o, px + lit_start, lit_cnt);
+                lit_cnt = 0;
+            }
+        }
+    }
+
+    o = color_literal_flush(o, px + lit_start, lit_cnt);
+    return o - out;
+}
+
+static uint8_t * alpha_literal_flush(uint8_t * o, const uint8_t * a, uint32_t cnt)
+{
+    if(cnt == 0) return o;
+    *o++ = 0x80 | (cnt - 1);
+    uint32_t i;
+    for(i = 0; i < cnt; i += 2) {
+        *o++ = (a[i] << 4) | (i + 1 < cnt ? a[i + 1] : 0);
+    }
+    return o;
+}
+
+/**
+ * Compress a row of 4 bit alpha values: runs of at least 3 values and literals
+ * @return the size of the compressed row
+ */
+static uint32_t alpha_row_encode(const uint8_t * a, uint32_t w, uint8_t * out)
+{
+    uint8_t * o = out;
+    uint32_t lit_start = 0;
+    uint32_t lit_cnt = 0;
+    uint32_t i = 0;
+    while(i < w) {
+        uint32_t run = 1;
+        while(i + run < w && run < A_RUN_MAX && a[i + run] == a[i]) run++;
+
+        if(run >= 3) {
+            o = alpha_literal_flush(o, a + lit_start, lit_cnt);
+            lit_cnt = 0;
+            *o++ = (((run - 1) >> 8) << 4) | a[i];
+            *o++ = (run - 1) & 0xFF;
+            i += run;
+        }
+        else {
+            if(lit_cnt == 0) lit_start = i;
+            lit_cnt++;
+            i++;
+            if(lit_cnt == A_LITERAL_MAX) {
+                o = alpha_literal_flush(o, a + lit_start, lit_cnt);
+                lit_cnt = 0;
+            }
+        }
+    }
+
+    o = alpha_literal_flush(o, a + lit_start, lit_cnt);
+    return o - out;
+}
+
+static inline lv_color_t color_from_565(uint16_t v)
+{
+#if LV_COLOR_DEPTH == 16
+    lv_color_t c;
+#if LV_COLOR_16_SWAP
+    c.full = (uint16_t)((v >> 8) | (v << 8));
+#else
+    c.full = v;
+#endif
+    return c;
+#else
+    uint32_t r = v >> 11;
+    uint32_t g = (v >> 5) & 0x3F;
+    uint32_t b = v & 0x1F;
+    return lv_color_make((r * 263 + 7) >> 5, (g * 259 + 3) >> 6, (b * 263 + 7) >> 5);
+#endif
+}
+
+static inline uint16_t color_to_565(lv_color_t c)
+{
+    lv_color32_t c32;
+    c32.full = lv_color_to32(c);
+    return (uint16_t)(((c32.ch.red >> 3) << 11) | ((c32.ch.green >> 2) << 5) | (c32.ch.blue >> 3));
+}
+
+#endif /*LV_USE_RLZ*/
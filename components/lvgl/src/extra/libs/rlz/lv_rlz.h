@@ -0,0 +1,66 @@
+/**
+ * @file lv_rlz.h
+ *
+ */
+
+#ifndef LV_RLZ_H
+#define LV_RLZ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lv_conf_internal.h"
+#include "../../../draw/lv_img_buf.h"
+
+#if LV_USE_RLZ
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Color format of the RLZ compressed images*/
+#define LV_RLZ_CF   LV_IMG_CF_USER_ENCODED_1
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Register the RLZ image decoder.
+ * It decodes `lv_img_dsc_t` variables with `LV_RLZ_CF` color format and `.rlz` files.
+ */
+void lv_rlz_init(void);
+
+/**
+ * Compress an image.
+ * The colors are stored as RGB565 and the opacity with 4 bits.
+ * @param img   an image with `LV_IMG_CF_TRUE_COLOR` or `LV_IMG_CF_TRUE_COLOR_ALPHA` color format
+ * @return      the compressed image with `LV_RLZ_CF` color format or NULL on error. Free it with `lv_rlz_free()`.
+ */
+lv_img_dsc_t * lv_rlz_encode(const lv_img_dsc_t * img);
+
+/**
+ * Free an image compressed by `lv_rlz_encode()`
+ * @param img   pointer to the compressed image
+ */
+void lv_rlz_free(lv_img_dsc_t * img);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_RLZ*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_RLZ_H*/
@@ -37,8 +37,13 @@
 /                   JPEG DECODER
 /                   ------------
 /   We are using TJpgDec - Tiny JPEG Decompressor library from ELM-CHAN for decoding each split-jpeg fragments.
-/   The tjpgd.c and tjpgd.h is not modified and those are used as it is. So if any update comes for the tiny-jpeg,
-/   just replace those files with updated files.
+/   The tjpgd.c and tjpgd.h is modified only by the functions marked as "LVGL extension" which decode the image
+/   MCU row by MCU row and save/restore the state of the decoder at the start of the MCU rows.
+/   So if any update comes for the tiny-jpeg, replace those files with updated files and port the extensions.
+/
+/   Only the MCU rows and columns which are read are decoded (columns before them are only parsed). The decoded MCU rows
+/   are kept in a small LRU cache and the state of the decoder is saved at each MCU row. So reading a clipped or scrolled
+/   part of a large JPG continues from the closest saved row instead of decoding the image from the beginning.
 /---------------------------------------------------------------------------------------------------------------------------------*/
 
 /*********************
@@ -56,6 +61,7 @@
  *      DEFINES
  *********************/
 #define TJPGD_WORKBUFF_SIZE             4096    //Recommended by TJPGD libray
+#define SJPEG_ROW_CACHE_CNT             3       //Number of decoded MCU rows to keep
 
 //NEVER EDIT THESE OFFSET VALUES
 #define SJPEG_VERSION_OFFSET            8
@@ -79,12 +85,26 @@ typedef struct {
     lv_fs_file_t lv_file;
     uint8_t * img_cache_buff;
     int img_cache_x_res;
-    int img_cache_y_res;
+    int img_cache_y_ofs;                  //Line of the fragment at the top of img_cache_buff
     uint8_t * raw_sjpg_data;              //Used when type==SJPEG_IO_SOURCE_C_ARRAY.
     uint32_t raw_sjpg_data_size;          //Num bytes pointed to by raw_sjpg_data.
     uint32_t raw_sjpg_data_next_read_pos; //Used for all types.
 } io_source_t;
 
+/*A decoded MCU row*/
+typedef struct {
+    int row;                            //Index of the MCU row in the image
+    int x1;                             //The decoded columns
+    int x2;
+    uint32_t last_use;
+    lv_color_t * buf;                   //sjpeg_x_res * mcu_h pixels, NULL: unused
+} sjpeg_row_t;
+
+typedef struct {
+    JSTATE state;                       //State of the decoder at the start of the MCU row
+    bool valid;
+} sjpeg_row_state_t;
+
 
 typedef struct {
     uint8_t * sjpeg_data;
@@ -93,10 +113,16 @@ typedef struct {
     int sjpeg_y_res;
     int sjpeg_total_frames;
     int sjpeg_single_frame_height;
-    int sjpeg_cache_frame_index;
+    int mcu_w;                          //Size of the MCUs, 0 until the first frame is prepared
+    int mcu_h;
+    int rows_per_frame;                 //Number of MCU rows in a frame
+    int prepared_frame;                 //The frame the decoder is prepared for, -1: none
+    int next_row;                       //The MCU row of the prepared frame the decoder is at
+    sjpeg_row_state_t * row_states;     //rows_per_frame * sjpeg_total_frames saved decoder states
+    sjpeg_row_t row_cache[SJPEG_ROW_CACHE_CNT];
+    uint32_t row_use_cnt;
     uint8_t ** frame_base_array;        //to save base address of each split frames upto sjpeg_total_frames.
     int * frame_base_offset;            //to save base offset for fseek
-    uint8_t * frame_cache;
     uint8_t * workb;                    //JPG work buffer for jpeg library
     JDEC * tjpeg_jd;
     io_source_t io;
@@ -109,9 +135,15 @@ static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_im
 static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
 static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                   lv_coord_t len, uint8_t * buf);
+static lv_res_t decoder_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                  uint8_t * buf);
 static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
 static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data, size_t len);
+static lv_res_t sjpeg_seek_row(SJPEG * sjpeg, int frame, int row);
+static sjpeg_row_t * sjpeg_get_row(SJPEG * sjpeg, int frame, int row, int x1, int x2);
+static void sjpeg_save_row_state(SJPEG * sjpeg);
+static uint32_t sjpeg_get_mem_size(const SJPEG * sjpeg);
 static void lv_sjpg_cleanup(SJPEG * sjpeg);
 static void lv_sjpg_free(SJPEG * sjpeg);
 
@@ -133,6 +165,7 @@ void lv_split_jpeg_init(void)
     lv_img_decoder_set_open_cb(dec, decoder_open);
     lv_img_decoder_set_close_cb(dec, decoder_close);
     lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+    lv_img_decoder_set_read_area_cb(dec, decoder_read_area);
 }
 
 /**********************
@@ -283,17 +316,17 @@ end:
 static int img_data_cb(JDEC * jd, void * data, JRECT * rect)
 {
     io_source_t * io = jd->device;
-    uint8_t * cache = io->img_cache_buff;
+    lv_color_t * cache = (lv_color_t *)io->img_cache_buff;
     const int xres = io->img_cache_x_res;
-    uint8_t * buf = data;
-    const int INPUT_PIXEL_SIZE = 3;
-    const int row_width = rect->right - rect->left + 1; // Row width in pixels.
-    const int row_size = row_width * INPUT_PIXEL_SIZE;  // Row size (bytes).
+    const uint8_t * rgb = data;
 
     for(int y = rect->top; y <= rect->bottom; y++) {
-        int row_offset = y * xres * INPUT_PIXEL_SIZE + rect->left * INPUT_PIXEL_SIZE;
-        memcpy(cache + row_offset, buf, row_size);
-        buf += row_size;
+        lv_color_t * dst = cache + (y - io->img_cache_y_ofs) * xres + rect->left;
+        for(int x = rect->left; x <= rect->right; x++) {
+            *dst = lv_color_make(rgb[0], rgb[1], rgb[2]);
+            dst++;
+            rgb += 3;
+        }
     }
 
     return 1;
@@ -323,12 +356,12 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
         if(buff) {
             uint32_t rn = 0;
             lv_fs_read(lv_file_p, buff, (uint32_t)ndata, &rn);
+            io->raw_sjpg_data_next_read_pos += rn;
             return rn;
         }
         else {
-            uint32_t pos;
-            lv_fs_tell(lv_file_p, &pos);
-            lv_fs_seek(lv_file_p, (uint32_t)(ndata + pos),  LV_FS_SEEK_SET);
+            io->raw_sjpg_data_next_read_pos += (uint32_t)ndata;
+            lv_fs_seek(lv_file_p, io->raw_sjpg_data_next_read_pos,  LV_FS_SEEK_SET);
             return ndata;
         }
     }
@@ -395,15 +428,7 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 offset |= *data++ << 8;
                 sjpeg->frame_base_array[i] = sjpeg->frame_base_array[i - 1] + offset;
             }
-            sjpeg->sjpeg_cache_frame_index = -1;
-            sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3/*2*/);
-            if(! sjpeg->frame_cache) {
-                lv_sjpg_cleanup(sjpeg);
-                sjpeg = NULL;
-                return LV_RES_INV;
-            }
-            sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-            sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
+            sjpeg->prepared_frame = -1;
             sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
             if(! sjpeg->workb) {
                 lv_sjpg_cleanup(sjpeg);
@@ -420,6 +445,7 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
             sjpeg->io.type = SJPEG_IO_SOURCE_C_ARRAY;
             sjpeg->io.lv_file.file_d = NULL;
             dsc->img_data = NULL;
+            dsc->mem_size = sjpeg_get_mem_size(sjpeg);
             return lv_ret;
         }
         else if(is_jpg(sjpeg->sjpeg_data, raw_sjpeg_data_size) == true) {
@@ -458,16 +484,7 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 uint8_t * img_frame_base = sjpeg->sjpeg_data;
                 sjpeg->frame_base_array[0] = img_frame_base;
 
-                sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_sjpg_cleanup(sjpeg);
-                    sjpeg = NULL;
-                    return LV_RES_INV;
-                }
-
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
+                sjpeg->prepared_frame = -1;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
                     lv_sjpg_cleanup(sjpeg);
@@ -485,6 +502,7 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 sjpeg->io.type = SJPEG_IO_SOURCE_C_ARRAY;
                 sjpeg->io.lv_file.file_d = NULL;
                 dsc->img_data = NULL;
+                dsc->mem_size = sjpeg_get_mem_size(sjpeg);
                 return lv_ret;
             }
             else {
@@ -577,15 +595,7 @@ end:
                     sjpeg->frame_base_offset[i] = sjpeg->frame_base_offset[i - 1] + offset;
                 }
 
-                sjpeg->sjpeg_cache_frame_index = -1; //INVALID AT BEGINNING for a forced compare mismatch at first time.
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
+                sjpeg->prepared_frame = -1;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
                     lv_fs_close(&lv_file);
@@ -603,6 +613,8 @@ end:
                 sjpeg->io.type = SJPEG_IO_SOURCE_DISK;
                 sjpeg->io.lv_file = lv_file;
                 dsc->img_data = NULL;
+                dsc->mem_size = sjpeg_get_mem_size(sjpeg);
+                dsc->file_open = 1;
                 return LV_RES_OK;
             }
         }
@@ -665,16 +677,7 @@ end:
                 int img_frame_start_offset = 0;
                 sjpeg->frame_base_offset[0] = img_frame_start_offset;
 
-                sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
-                sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
+                sjpeg->prepared_frame = -1;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
                     lv_fs_close(&lv_file);
@@ -692,6 +695,8 @@ end:
                 sjpeg->io.type = SJPEG_IO_SOURCE_DISK;
                 sjpeg->io.lv_file = lv_file;
                 dsc->img_data = NULL;
+                dsc->mem_size = sjpeg_get_mem_size(sjpeg);
+                dsc->file_open = 1;
                 return LV_RES_OK;
 
             }
@@ -721,144 +726,56 @@ end:
 static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                   lv_coord_t len, uint8_t * buf)
 {
-    LV_UNUSED(decoder);
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[ sjpeg_req_frame_index ];
-            if(sjpeg_req_frame_index == (sjpeg->sjpeg_total_frames - 1)) {
-                /*This is the last frame. */
-                const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
-                sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
-            }
-            else {
-                sjpeg->io.raw_sjpg_data_size =
-                    (uint32_t)(sjpeg->frame_base_array[sjpeg_req_frame_index + 1] - sjpeg->io.raw_sjpg_data);
-            }
-            sjpeg->io.raw_sjpg_data_next_read_pos = 0;
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
-
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if  LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
-
-#elif  LV_COLOR_DEPTH == 16
-
-        for(int i = 0; i < len; i++) {
-            uint16_t col_16bit = (*cache++ & 0xf8) << 8;
-            col_16bit |= (*cache++ & 0xFC) << 3;
-            col_16bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_16bit >> 8;
-            buf[offset++] = col_16bit & 0xff;
-#else
-            buf[offset++] = col_16bit & 0xff;
-            buf[offset++] = col_16bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
-        }
-
-#elif  LV_COLOR_DEPTH == 8
-
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-#else
-#error Unsupported LV_COLOR_DEPTH
-
+    lv_area_t area;
+    area.x1 = x;
+    area.y1 = y;
+    area.x2 = x + len - 1;
+    area.y2 = y;
+    return decoder_read_area(decoder, dsc, &area, buf);
+}
 
-#endif // LV_COLOR_DEPTH
-        return LV_RES_OK;
+/**
+ * Decode an area of the image and store it in `buf` line by line.
+ * Only the MCU rows and columns of the area are decoded.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param area the area to decode in image coordinates
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+static lv_res_t decoder_read_area(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, const lv_area_t * area,
+                                  uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    SJPEG * sjpeg = (SJPEG *) dsc->user_data;
+    if(sjpeg == NULL) return LV_RES_INV;
+    if(area->x1 < 0 || area->y1 < 0 || area->x2 >= sjpeg->sjpeg_x_res || area->y2 >= sjpeg->sjpeg_y_res) {
+        return LV_RES_INV;
     }
-    else if(dsc->src_type == LV_IMG_SRC_FILE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        lv_fs_file_t * lv_file_p = &(sjpeg->io.lv_file);
-        if(!lv_file_p) goto end;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset [ sjpeg_req_frame_index ]);
-            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
-
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
 
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
+    /*Prepare the first frame to get the size of the MCUs*/
+    if(sjpeg->mcu_h == 0 && sjpeg_seek_row(sjpeg, 0, 0) != LV_RES_OK) return LV_RES_INV;
+
+    const int frame_h = sjpeg->sjpeg_single_frame_height;
+    const lv_coord_t w = lv_area_get_width(area);
+    lv_color_t * dst = (lv_color_t *)buf;
+    lv_coord_t y = area->y1;
+    while(y <= area->y2) {
+        int frame = y / frame_h;
+        int row = (y % frame_h) / sjpeg->mcu_h;
+        sjpeg_row_t * r = sjpeg_get_row(sjpeg, frame, row, area->x1, area->x2);
+        if(r == NULL) return LV_RES_INV;
+
+        lv_coord_t row_y1 = frame * frame_h + row * sjpeg->mcu_h;
+        lv_coord_t row_y2 = LV_MIN(row_y1 + sjpeg->mcu_h, (frame + 1) * frame_h) - 1;
+        if(row_y2 > area->y2) row_y2 = area->y2;
+        for(; y <= row_y2; y++) {
+            lv_memcpy(dst, r->buf + (y - row_y1) * sjpeg->sjpeg_x_res + area->x1, w * sizeof(lv_color_t));
+            dst += w;
         }
-
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
-#elif  LV_COLOR_DEPTH == 16
-
-        for(int i = 0; i < len; i++) {
-            uint16_t col_8bit = (*cache++ & 0xf8) << 8;
-            col_8bit |= (*cache++ & 0xFC) << 3;
-            col_8bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_8bit >> 8;
-            buf[offset++] = col_8bit & 0xff;
-#else
-            buf[offset++] = col_8bit & 0xff;
-            buf[offset++] = col_8bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
-        }
-
-#elif  LV_COLOR_DEPTH == 8
-
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-
-#else
-#error Unsupported LV_COLOR_DEPTH
-
-
-#endif // LV_COLOR_DEPTH
-
-        return LV_RES_OK;
     }
-end:
-    return LV_RES_INV;
+
+    return LV_RES_OK;
 }
 
 /**
@@ -890,6 +807,196 @@ static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc
     }
 }
 
+/**
+ * Get a decoded MCU row from the cache or decode it.
+ * @param sjpeg pointer to the SJPEG session
+ * @param frame index of the frame
+ * @param row index of the MCU row in the frame
+ * @param x1 first column which is required
+ * @param x2 last column which is required
+ * @return the decoded row or NULL on error
+ */
+static sjpeg_row_t * sjpeg_get_row(SJPEG * sjpeg, int frame, int row, int x1, int x2)
+{
+    int idx = frame * sjpeg->rows_per_frame + row;
+    sjpeg_row_t * slot = NULL;
+    uint32_t i;
+    for(i = 0; i < SJPEG_ROW_CACHE_CNT; i++) {
+        sjpeg_row_t * r = &sjpeg->row_cache[i];
+        if(r->buf == NULL || r->row != idx) continue;
+
+        if(r->x1 <= x1 && r->x2 >= x2) {
+            r->last_use = ++sjpeg->row_use_cnt;
+            return r;
+        }
+
+        /*Some columns are missing. Decode the row again with the union of the columns*/
+        x1 = LV_MIN(x1, r->x1);
+        x2 = LV_MAX(x2, r->x2);
+        slot = r;
+        break;
+    }
+
+    /*Else reuse the least recently used row (the unused rows have `last_use == 0`)*/
+    if(slot == NULL) {
+        slot = &sjpeg->row_cache[0];
+        for(i = 1; i < SJPEG_ROW_CACHE_CNT; i++) {
+            if(sjpeg->row_cache[i].last_use < slot->last_use) slot = &sjpeg->row_cache[i];
+        }
+    }
+
+    if(slot->buf == NULL) {
+        slot->buf = lv_mem_alloc(sizeof(lv_color_t) * sjpeg->sjpeg_x_res * sjpeg->mcu_h);
+        LV_ASSERT_MALLOC(slot->buf);
+        if(slot->buf == NULL) return NULL;
+    }
+
+    if(sjpeg_seek_row(sjpeg, frame, row) != LV_RES_OK) return NULL;
+
+    slot->row = -1;
+    slot->last_use = 0;
+    sjpeg->io.img_cache_buff = (uint8_t *)slot->buf;
+    sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
+    sjpeg->io.img_cache_y_ofs = row * sjpeg->mcu_h;
+    JRESULT rc = jd_decomp_row(sjpeg->tjpeg_jd, img_data_cb, row * sjpeg->mcu_h, x1, x2);
+    if(rc != JDR_OK) {
+        sjpeg->prepared_frame = -1;
+        return NULL;
+    }
+    sjpeg->next_row++;
+    sjpeg_save_row_state(sjpeg);
+
+    /*The MCUs are decoded as a whole*/
+    slot->row = idx;
+    slot->x1 = x1 - x1 % sjpeg->mcu_w;
+    slot->x2 = LV_MIN(x2 - x2 % sjpeg->mcu_w + sjpeg->mcu_w - 1, sjpeg->sjpeg_x_res - 1);
+    slot->last_use = ++sjpeg->row_use_cnt;
+    return slot;
+}
+
+/**
+ * Move the decoder to the start of an MCU row. Prepare the frame if required and continue from the current position,
+ * from the closest saved row state or from the start of the frame. The skipped rows are only parsed.
+ * @param sjpeg pointer to the SJPEG session
+ * @param frame index of the frame
+ * @param row index of the MCU row in the frame
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+static lv_res_t sjpeg_seek_row(SJPEG * sjpeg, int frame, int row)
+{
+    JDEC * jd = sjpeg->tjpeg_jd;
+    JRESULT rc;
+
+    if(sjpeg->prepared_frame != frame) {
+        if(sjpeg->io.type == SJPEG_IO_SOURCE_C_ARRAY) {
+            sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[frame];
+            if(frame == (sjpeg->sjpeg_total_frames - 1)) {
+                /*This is the last frame. */
+                const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
+                sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
+            }
+            else {
+                sjpeg->io.raw_sjpg_data_size = (uint32_t)(sjpeg->frame_base_array[frame + 1] - sjpeg->io.raw_sjpg_data);
+            }
+            sjpeg->io.raw_sjpg_data_next_read_pos = 0;
+        }
+        else {
+            sjpeg->io.raw_sjpg_data_next_read_pos = sjpeg->frame_base_offset[frame];
+            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
+        }
+
+        sjpeg->prepared_frame = -1;
+        rc = jd_prepare(jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
+        if(rc != JDR_OK) return LV_RES_INV;
+
+        if(sjpeg->mcu_h == 0) {
+            sjpeg->mcu_w = jd->msx * 8;
+            sjpeg->mcu_h = jd->msy * 8;
+            sjpeg->rows_per_frame = (sjpeg->sjpeg_single_frame_height + sjpeg->mcu_h - 1) / sjpeg->mcu_h;
+            uint32_t states_size = sizeof(sjpeg_row_state_t) * sjpeg->rows_per_frame * sjpeg->sjpeg_total_frames;
+            sjpeg->row_states = lv_mem_alloc(states_size);
+            LV_ASSERT_MALLOC(sjpeg->row_states);
+            if(sjpeg->row_states == NULL) {
+                sjpeg->mcu_h = 0;
+                return LV_RES_INV;
+            }
+            lv_memset_00(sjpeg->row_states, states_size);
+        }
+        /*The rows are indexed by the MCU size of the first frame*/
+        else if(sjpeg->mcu_w != jd->msx * 8 || sjpeg->mcu_h != jd->msy * 8) {
+            LV_LOG_WARN("The frames of the SJPG have different MCU sizes");
+            return LV_RES_INV;
+        }
+
+        sjpeg->prepared_frame = frame;
+        sjpeg->next_row = 0;
+        sjpeg_save_row_state(sjpeg);
+    }
+
+    if(sjpeg->next_row == row) return LV_RES_OK;
+
+    /*Find the closest saved state before the row (row 0 is saved when the frame is prepared)*/
+    sjpeg_row_state_t * states = &sjpeg->row_states[frame * sjpeg->rows_per_frame];
+    int start = row;
+    while(start > 0 && !states[start].valid) start--;
+
+    /*Restore the saved state if the decoder is not between it and the row*/
+    if(sjpeg->next_row > row || sjpeg->next_row < start) {
+        sjpeg->io.raw_sjpg_data_next_read_pos = states[start].state.ofs;
+        if(sjpeg->io.type == SJPEG_IO_SOURCE_DISK) {
+            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
+        }
+        rc = jd_restore_state(jd, &states[start].state);
+        if(rc != JDR_OK) {
+            sjpeg->prepared_frame = -1;
+            return LV_RES_INV;
+        }
+        sjpeg->next_row = start;
+    }
+
+    /*Only parse the rows before the required one*/
+    while(sjpeg->next_row < row) {
+        rc = jd_decomp_row(jd, img_data_cb, sjpeg->next_row * sjpeg->mcu_h, 1, 0);
+        if(rc != JDR_OK) {
+            sjpeg->prepared_frame = -1;
+            return LV_RES_INV;
+        }
+        sjpeg->next_row++;
+        sjpeg_save_row_state(sjpeg);
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Save the state of the decoder at its current MCU row if it's not saved yet
+ * @param sjpeg pointer to the SJPEG session
+ */
+static void sjpeg_save_row_state(SJPEG * sjpeg)
+{
+    if(sjpeg->next_row >= sjpeg->rows_per_frame) return;
+
+    sjpeg_row_state_t * s = &sjpeg->row_states[sjpeg->prepared_frame * sjpeg->rows_per_frame + sjpeg->next_row];
+    if(s->valid) return;
+
+    jd_save_state(sjpeg->tjpeg_jd, &s->state, sjpeg->io.raw_sjpg_data_next_read_pos);
+    s->valid = true;
+}
+
+/**
+ * Get the RAM the decoder needs while the image is open. The row cache and the saved row states
+ * are allocated on the first read, so count them with the largest MCU (16 px) and the most rows (8 px MCUs).
+ * @param sjpeg pointer to the SJPEG session
+ * @return the size in bytes
+ */
+static uint32_t sjpeg_get_mem_size(const SJPEG * sjpeg)
+{
+    uint32_t row_cnt = (sjpeg->sjpeg_single_frame_height + 7) / 8 * sjpeg->sjpeg_total_frames;
+    return sizeof(SJPEG) + sizeof(JDEC) + TJPGD_WORKBUFF_SIZE + sjpeg->sjpeg_total_frames * sizeof(void *) +
+           SJPEG_ROW_CACHE_CNT * sizeof(lv_color_t) * sjpeg->sjpeg_x_res * 16 +
+           row_cnt * sizeof(sjpeg_row_state_t);
+}
+
 static int is_jpg(const uint8_t * raw_data, size_t len)
 {
     const uint8_t jpg_signature[] = {0xFF, 0xD8, 0xFF,  0xE0,  0x00,  0x10, 0x4A,  0x46, 0x49, 0x46};
@@ -899,7 +1006,11 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
 
 static void lv_sjpg_free(SJPEG * sjpeg)
 {
-    if(sjpeg->frame_cache) lv_mem_free(sjpeg->frame_cache);
+    uint32_t i;
+    for(i = 0; i < SJPEG_ROW_CACHE_CNT; i++) {
+        if(sjpeg->row_cache[i].buf) lv_mem_free(sjpeg->row_cache[i].buf);
+    }
+    if(sjpeg->row_states) lv_mem_free(sjpeg->row_states);
     if(sjpeg->frame_base_array) lv_mem_free(sjpeg->frame_base_array);
     if(sjpeg->frame_base_offset) lv_mem_free(sjpeg->frame_base_offset);
     if(sjpeg->tjpeg_jd) lv_mem_free(sjpeg->tjpeg_jd);
@@ -700,7 +700,8 @@ static void block_idct (
 /*-----------------------------------------------------------------------*/
 
 static JRESULT mcu_load (
-	JDEC* jd		/* Pointer to the decompressor object */
+	JDEC* jd,		/* Pointer to the decompressor object */
+	int skip		/* 1: Only parse the MCU, it won't be output (LVGL extension) */
 )
 {
 	int32_t *tmp = (int32_t*)jd->workbuf;	/* Block working buffer for de-quantize and IDCT */
@@ -739,7 +740,7 @@ static JRESULT mcu_load (
 			tmp[0] = d * dqf[0] >> 8;				/* De-quantize, apply scale factor of Arai algorithm and descale 8 bits */
 
 			/* Extract following 63 AC elements from input stream */
-			memset(&tmp[1], 0, 63 * sizeof (int32_t));	/* Initialize all AC elements */
+			if (!skip) memset(&tmp[1], 0, 63 * sizeof (int32_t));	/* Initialize all AC elements */
 			z = 1;		/* Top of the AC elements (in zigzag-order) */
 			do {
 				d = huffext(jd, id, 1);				/* Extract a huffman coded value (zero runs and bit length) */
@@ -758,7 +759,7 @@ static JRESULT mcu_load (
 				}
 			} while (++z < 64);		/* Next AC element */
 
-			if (JD_FORMAT != 2 || !cmp) {	/* C components may not be processed if in grayscale output */
+			if (!skip && (JD_FORMAT != 2 || !cmp)) {	/* C components may not be processed if in grayscale output */
 				if (z == 1 || (JD_USE_SCALE && jd->scale == 3)) {	/* If no AC element or scale ratio is 1/8, IDCT can be ommited and the block is filled with DC value */
 					d = (jd_yuv_t)((*tmp / 256) + 128);
 					if (JD_FASTDECODE >= 1) {
@@ -1142,7 +1143,7 @@ JRESULT jd_decomp (
 				if (rc != JDR_OK) return rc;
 				rst = 1;
 			}
-			rc = mcu_load(jd);					/* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
+			rc = mcu_load(jd, 0);				/* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
 			if (rc != JDR_OK) return rc;
 			rc = mcu_output(jd, outfunc, x, y);	/* Output the MCU (YCbCr to RGB, scaling and output) */
 			if (rc != JDR_OK) return rc;
@@ -1152,4 +1153,110 @@ JRESULT jd_decomp (
 	return rc;
 }
 
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Decompress an MCU row of the JPEG picture (LVGL extension)            */
+/* The output is scaled by jd->scale (0 after jd_prepare)                */
+/*-----------------------------------------------------------------------*/
+
+JRESULT jd_decomp_row (
+	JDEC* jd,								/* Initialized decompression object */
+	int (*outfunc)(JDEC*, void*, JRECT*),	/* RGB output function */
+	unsigned int y,							/* Top of the MCU row. The stream has to be at this row. */
+	unsigned int left,						/* The MCUs outside of left..right are parsed but not output */
+	unsigned int right						/* (left > right: only parse the row) */
+)
+{
+	unsigned int x, mx;
+	int skip;
+	JRESULT rc;
+
+
+	mx = jd->msx * 8;							/* Width of the MCU (pixel) */
+
+	if (y == 0) {								/* First row: initialize DC values and restart counters */
+		jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;
+		jd->rst = jd->rsc = 0;
+	}
+
+	for (x = 0; x < jd->width; x += mx) {	/* Horizontal loop of MCUs */
+		if (jd->nrst && jd->rst++ == jd->nrst) {	/* Process restart interval if enabled */
+			rc = restart(jd, jd->rsc++);
+			if (rc != JDR_OK) return rc;
+			jd->rst = 1;
+		}
+		skip = left > right || x + mx <= left || x > right;
+		rc = mcu_load(jd, skip);				/* Load an MCU (only decode the huffman coded stream if skipped) */
+		if (rc != JDR_OK) return rc;
+		if (!skip) {
+			rc = mcu_output(jd, outfunc, x, y);	/* Output the MCU (YCbCr to RGB, scaling and output) */
+			if (rc != JDR_OK) return rc;
+		}
+	}
+
+	return JDR_OK;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Save the state of the decompressor between two MCU rows (LVGL ext.)   */
+/*-----------------------------------------------------------------------*/
+
+void jd_save_state (
+	JDEC* jd,		/* Pointer to the decompressor object */
+	JSTATE* st,		/* Store the state here */
+	uint32_t inpos	/* Number of bytes returned by the input function so far */
+)
+{
+#if JD_FASTDECODE == 0
+	st->ofs = inpos - (uint32_t)jd->dctr - 1;	/* The read pointer is on the last used byte */
+	st->cur = jd->dbit ? *jd->dptr : 0;
+#else
+	st->ofs = inpos - (uint32_t)jd->dctr;		/* The read pointer is on the next byte */
+	st->cur = 0;
+	st->wreg = jd->wreg;
+	st->marker = jd->marker;
+#endif
+	st->dbit = jd->dbit;
+	st->dcv[0] = jd->dcv[0]; st->dcv[1] = jd->dcv[1]; st->dcv[2] = jd->dcv[2];
+	st->rst = jd->rst; st->rsc = jd->rsc;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Restore a saved state of the decompressor (LVGL extension)            */
+/*-----------------------------------------------------------------------*/
+
+JRESULT jd_restore_state (
+	JDEC* jd,			/* Pointer to the decompressor object prepared for the same stream */
+	const JSTATE* st	/* The saved state. The input function has to continue from st->ofs. */
+)
+{
+	size_t dc;
+
+
+	dc = jd->infunc(jd, jd->inbuf, JD_SZBUF);	/* Re-fill the input buffer from the saved offset */
+	if (!dc) return JDR_INP;
+	jd->dptr = jd->inbuf;
+#if JD_FASTDECODE == 0
+	jd->dctr = dc - 1;
+	jd->inbuf[0] = st->cur;
+#else
+	jd->dctr = dc;
+	jd->wreg = st->wreg;
+	jd->marker = st->marker;
+#endif
+	jd->dbit = st->dbit;
+	jd->dcv[0] = st->dcv[0]; jd->dcv[1] = st->dcv[1]; jd->dcv[2] = st->dcv[2];
+	jd->rst = st->rst; jd->rsc = st->rsc;
+
+	return JDR_OK;
+}
+
 #endif /*LV_USE_SJPG*/
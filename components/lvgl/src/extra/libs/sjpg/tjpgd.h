@@ -76,14 +76,33 @@ struct JDEC {
 	size_t sz_pool;				/* Size of momory pool (bytes available) */
 	size_t (*infunc)(JDEC*, uint8_t*, size_t);	/* Pointer to jpeg stream input function */
 	void* device;				/* Pointer to I/O device identifiler for the session */
+	uint16_t rst, rsc;			/* Restart interval counters of jd_decomp_row (LVGL extension) */
 };
 
+/* State of the decompressor at the start of an MCU row (LVGL extension) */
+typedef struct {
+	uint32_t ofs;				/* Stream offset of the byte under the read pointer */
+	int16_t dcv[3];				/* Previous DC element of each component */
+	uint16_t rst, rsc;			/* Restart interval counters */
+	uint8_t dbit;				/* Number of bits availavble in wreg or reading bit mask */
+	uint8_t cur;				/* The byte under the read pointer (it can be modified in the input buffer) */
+#if JD_FASTDECODE >= 1
+	uint32_t wreg;				/* Working shift register */
+	uint8_t marker;				/* Detected marker (0:None) */
+#endif
+} JSTATE;
+
 
 
 /* TJpgDec API functions */
 JRESULT jd_prepare (JDEC* jd, size_t (*infunc)(JDEC*,uint8_t*,size_t), void* pool, size_t sz_pool, void* dev);
 JRESULT jd_decomp (JDEC* jd, int (*outfunc)(JDEC*,void*,JRECT*), uint8_t scale);
 
+/* LVGL extension: decompress the image MCU row by MCU row and resume the decompression at a saved row */
+JRESULT jd_decomp_row (JDEC* jd, int (*outfunc)(JDEC*,void*,JRECT*), unsigned int y, unsigned int left, unsigned int right);
+void jd_save_state (JDEC* jd, JSTATE* st, uint32_t inpos);
+JRESULT jd_restore_state (JDEC* jd, const JSTATE* st);
+
 #endif /*LV_USE_SJPG*/
 
 #ifdef __cplusplus
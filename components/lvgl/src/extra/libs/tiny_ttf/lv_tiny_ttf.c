@@ -2,7 +2,6 @@
 
 #if LV_USE_TINY_TTF
 #include <stdio.h>
-#include "../../../misc/lv_lru.h"
 
 #define STB_RECT_PACK_IMPLEMENTATION
 #define STBRP_STATIC
@@ -63,6 +62,67 @@ static void ttf_cb_stream_seek(ttf_cb_stream_t * stream, size_t position)
 #include "stb_rect_pack.h"
 #include "stb_truetype_htcw.h"
 
+/*The glyph atlas is made of pages of ATLAS_PAGE_SIZE x ATLAS_PAGE_SIZE pixels with 8 bpp.
+ *Larger glyphs are rendered every time they are drawn.*/
+#define ATLAS_PAGE_SIZE 128
+#define ATLAS_PAGE_CNT (LV_TINY_TTF_CACHE_SIZE / (ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE))
+#define ATLAS_GLYPHS_PER_PAGE 128   /*Size of the glyph index of the atlas for a page*/
+#define ATLAS_PROBE_CNT 4           /*Number of slots to check in the glyph index*/
+#define ATLAS_PAGE_NONE 0xFF
+
+#if ATLAS_PAGE_CNT >= ATLAS_PAGE_NONE
+#error "LV_TINY_TTF_CACHE_SIZE is too large"
+#endif
+
+/*A page of the atlas. The glyphs are placed by stb_rect_pack's skyline packer.*/
+typedef struct {
+    uint8_t * bitmap;
+    stbrp_context packer;
+    stbrp_node nodes[ATLAS_PAGE_SIZE];
+    uint32_t generation;    /*Incremented when the page is cleared. Invalidates the glyphs on the page*/
+    uint32_t last_used;
+} ttf_atlas_page_t;
+
+/*The place of a rendered glyph in the atlas*/
+typedef struct {
+    uint32_t generation;    /*Valid if it's the same as the generation of the page*/
+    uint32_t font_id;
+    uint16_t font_size;
+    uint16_t glyph;
+    uint8_t x;
+    uint8_t y;
+    uint8_t page;
+} ttf_atlas_glyph_t;
+
+/*The glyph atlas shared by all fonts and font sizes*/
+typedef struct {
+    ttf_atlas_page_t * pages;
+    ttf_atlas_glyph_t * glyphs;
+    uint32_t glyph_cnt;     /*Power of 2*/
+    uint32_t ref_cnt;       /*Number of fonts using the atlas*/
+    uint32_t use_cnt;
+    uint32_t next_font_id;
+    uint8_t * buf;          /*The bitmap of the last glyph without the stride of the atlas page*/
+    uint32_t buf_size;
+} ttf_atlas_t;
+
+/*The metrics of a glyph. The box is scaled to the current size of the font.*/
+typedef struct {
+    uint32_t unicode_letter;
+    uint16_t glyph;         /*0: the font has no glyph for the letter*/
+    uint16_t adv_w;         /*In font units*/
+    int16_t x1;
+    int16_t y2;
+    uint16_t box_w;
+    uint16_t box_h;
+} ttf_glyph_metrics_t;
+
+typedef struct {
+    uint16_t glyph1;        /*0: empty*/
+    uint16_t glyph2;
+    int16_t advance;        /*In font units*/
+} ttf_kern_pair_t;
+
 typedef struct ttf_font_desc {
     lv_fs_file_t file;
 #if LV_TINY_TTF_FILE_SUPPORT
@@ -74,13 +134,50 @@ typedef struct ttf_font_desc {
     float scale;
     int ascent;
     int descent;
-    lv_lru_t * bitmap_cache;
+    uint32_t font_id;
+    uint16_t font_size;
+    ttf_glyph_metrics_t * metrics_cache;
+    uint32_t metrics_cache_mask;
+    ttf_kern_pair_t * kern_cache;   /*NULL if the font has no kerning*/
+    uint32_t kern_cache_mask;
 } ttf_font_desc_t;
 
-typedef struct ttf_bitmap_cache_key {
-    uint32_t unicode_letter;
-    lv_coord_t line_height;
-} ttf_bitmap_cache_key_t;
+static ttf_atlas_t atlas;
+
+/*Get the metrics of a glyph from the cache or from the font*/
+static const ttf_glyph_metrics_t * get_glyph_metrics(ttf_font_desc_t * dsc, uint32_t unicode_letter)
+{
+    ttf_glyph_metrics_t * m = &dsc->metrics_cache[unicode_letter & dsc->metrics_cache_mask];
+    if(m->unicode_letter == unicode_letter) return m;
+
+    m->unicode_letter = unicode_letter;
+    m->glyph = (uint16_t)stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter);
+    if(m->glyph == 0) return m;
+
+    int advw, lsb;
+    stbtt_GetGlyphHMetrics(&dsc->info, m->glyph, &advw, &lsb);
+    int x1, y1, x2, y2;
+    stbtt_GetGlyphBitmapBox(&dsc->info, m->glyph, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
+    m->adv_w = (uint16_t)advw;
+    m->x1 = (int16_t)x1;
+    m->y2 = (int16_t)y2;
+    m->box_w = (uint16_t)(x2 - x1 + 1);
+    m->box_h = (uint16_t)(y2 - y1 + 1);
+    return m;
+}
+
+static int get_kern_advance(ttf_font_desc_t * dsc, uint16_t glyph1, uint16_t glyph2)
+{
+    if(dsc->kern_cache == NULL) return 0;
+
+    ttf_kern_pair_t * k = &dsc->kern_cache[(glyph1 * 31 + glyph2) & dsc->kern_cache_mask];
+    if(k->glyph1 != glyph1 || k->glyph2 != glyph2) {
+        k->glyph1 = glyph1;
+        k->glyph2 = glyph2;
+        k->advance = (int16_t)stbtt_GetGlyphKernAdvance(&dsc->info, glyph1, glyph2);
+    }
+    return k->advance;
+}
 
 static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                  uint32_t unicode_letter_next)
@@ -98,77 +195,216 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
         return true;
     }
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    int g1 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter);
-    if(g1 == 0) {
+    const ttf_glyph_metrics_t * m = get_glyph_metrics(dsc, unicode_letter);
+    if(m->glyph == 0) {
         /* Glyph not found */
         return false;
     }
-    int x1, y1, x2, y2;
 
-    stbtt_GetGlyphBitmapBox(&dsc->info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
-    int g2 = 0;
-    if(unicode_letter_next != 0) {
-        g2 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter_next);
-    }
-    int advw, lsb;
-    stbtt_GetGlyphHMetrics(&dsc->info, g1, &advw, &lsb);
-    int k = stbtt_GetGlyphKernAdvance(&dsc->info, g1, g2);
-    dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
-                                     0.5f); /*Horizontal space required by the glyph in [px]*/
+    /*Get the kerning pair first as it can replace `m` in the cache*/
+    uint16_t g1 = m->glyph;
+    int advw = m->adv_w;
+    dsc_out->box_w = m->box_w;      /*width of the bitmap in [px]*/
+    dsc_out->box_h = m->box_h;      /*height of the bitmap in [px]*/
+    dsc_out->ofs_x = m->x1;         /*X offset of the bitmap in [pf]*/
+    dsc_out->ofs_y = -m->y2;        /*Y offset of the bitmap measured from the as line*/
 
+    int k = 0;
+    if(unicode_letter_next != 0 && dsc->kern_cache) {
+        uint16_t g2 = get_glyph_metrics(dsc, unicode_letter_next)->glyph;
+        k = get_kern_advance(dsc, g1, g2);
+    }
     dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
                                      0.5f); /*Horizontal space required by the glyph in [px]*/
-    dsc_out->box_w = (x2 - x1 + 1);         /*width of the bitmap in [px]*/
-    dsc_out->box_h = (y2 - y1 + 1);         /*height of the bitmap in [px]*/
-    dsc_out->ofs_x = x1;                    /*X offset of the bitmap in [pf]*/
-    dsc_out->ofs_y = -y2;                   /*Y offset of the bitmap measured from the as line*/
-    dsc_out->bpp = 8;                       /*Bits per pixel: 1/2/4/8*/
+    dsc_out->bpp = 8;               /*Bits per pixel: 1/2/4/8*/
     dsc_out->is_placeholder = false;
     return true; /*true: glyph found; false: glyph was not found*/
 }
 
+/*Get a buffer for the bitmap of a glyph. Valid until the next glyph is drawn.*/
+static uint8_t * get_atlas_buf(uint32_t size)
+{
+    if(atlas.buf_size < size) {
+        uint8_t * tmp = lv_mem_realloc(atlas.buf, size);
+        LV_ASSERT_MALLOC(tmp);
+        if(tmp == NULL) return NULL;
+        atlas.buf = tmp;
+        atlas.buf_size = size;
+    }
+    return atlas.buf;
+}
+
+static uint32_t atlas_hash(uint32_t font_id, uint16_t font_size, uint16_t glyph)
+{
+    uint32_t h = (font_id * 31 + font_size) * 0x9E3779B1u;
+    h ^= glyph * 0x85EBCA6Bu;
+    return (h ^ (h >> 15)) & (atlas.glyph_cnt - 1);
+}
+
+static bool atlas_glyph_is_valid(const ttf_atlas_glyph_t * g)
+{
+    return g->page != ATLAS_PAGE_NONE && g->generation == atlas.pages[g->page].generation;
+}
+
+/*Place a rectangle on a page. Clear the least recently used page if it doesn't fit anywhere.*/
+static ttf_atlas_page_t * atlas_pack(stbrp_rect * rect)
+{
+    ttf_atlas_page_t * lru = &atlas.pages[0];
+    for(int32_t i = 0; i < ATLAS_PAGE_CNT; i++) {
+        ttf_atlas_page_t * page = &atlas.pages[i];
+        if(page->bitmap == NULL) {
+            page->bitmap = TTF_MALLOC(ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE);
+            if(page->bitmap == NULL) break;
+            stbrp_init_target(&page->packer, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, page->nodes, ATLAS_PAGE_SIZE);
+        }
+        stbrp_pack_rects(&page->packer, rect, 1);
+        if(rect->was_packed) return page;
+        if(page->last_used < lru->last_used) lru = page;
+    }
+
+    if(lru->bitmap == NULL) return NULL;
+
+    LV_LOG_TRACE("clear atlas page %d", (int)(lru - atlas.pages));
+    lru->generation++;
+    stbrp_init_target(&lru->packer, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, lru->nodes, ATLAS_PAGE_SIZE);
+    stbrp_pack_rects(&lru->packer, rect, 1);
+    return rect->was_packed ? lru : NULL;
+}
+
 static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t unicode_letter)
 {
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    const stbtt_fontinfo * info = (const stbtt_fontinfo *)&dsc->info;
-    int g1 = stbtt_FindGlyphIndex(info, (int)unicode_letter);
-    if(g1 == 0) {
+    const ttf_glyph_metrics_t * m = get_glyph_metrics(dsc, unicode_letter);
+    if(m->glyph == 0) {
         /* Glyph not found */
         return NULL;
     }
-    int x1, y1, x2, y2;
-    stbtt_GetGlyphBitmapBox(info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
-    int w, h;
-    w = x2 - x1 + 1;
-    h = y2 - y1 + 1;
-    uint32_t stride = w;
-    /*Try to load from cache*/
-    ttf_bitmap_cache_key_t cache_key;
-    lv_memset(&cache_key, 0, sizeof(cache_key)); /*Zero padding*/
-    cache_key.unicode_letter = unicode_letter;
-    cache_key.line_height = font->line_height;
-    uint8_t * buffer = NULL;
-    lv_lru_get(dsc->bitmap_cache, &cache_key, sizeof(cache_key), (void **)&buffer);
-    if(buffer) {
-        return buffer;
+    int w = m->box_w;
+    int h = m->box_h;
+    uint8_t * buf = get_atlas_buf(w * h);
+    if(buf == NULL) return NULL;
+
+    /*Glyphs larger than a page are not cached*/
+    if(ATLAS_PAGE_CNT == 0 || w > ATLAS_PAGE_SIZE || h > ATLAS_PAGE_SIZE) {
+        lv_memset(buf, 0, w * h);
+        stbtt_MakeGlyphBitmap(&dsc->info, buf, w, h, w, dsc->scale, dsc->scale, m->glyph);
+        return buf;
     }
-    LV_LOG_TRACE("cache miss for letter: %u", unicode_letter);
-    /*Prepare space in cache*/
-    size_t szb = h * stride;
-    buffer = lv_mem_alloc(szb);
-    if(!buffer) {
-        LV_LOG_ERROR("failed to allocate cache value");
-        return NULL;
+
+    /*Try to load from the atlas*/
+    uint32_t hash = atlas_hash(dsc->font_id, dsc->font_size, m->glyph);
+    ttf_atlas_glyph_t * g = NULL;
+    ttf_atlas_glyph_t * free_slot = NULL;
+    for(uint32_t i = 0; i < ATLAS_PROBE_CNT; i++) {
+        ttf_atlas_glyph_t * slot = &atlas.glyphs[(hash + i) & (atlas.glyph_cnt - 1)];
+        if(!atlas_glyph_is_valid(slot)) {
+            if(free_slot == NULL) free_slot = slot;
+        }
+        else if(slot->glyph == m->glyph && slot->font_id == dsc->font_id && slot->font_size == dsc->font_size) {
+            g = slot;
+            break;
+        }
     }
-    lv_memset(buffer, 0, szb);
-    if(LV_LRU_OK != lv_lru_set(dsc->bitmap_cache, &cache_key, sizeof(cache_key), buffer, szb)) {
-        LV_LOG_ERROR("failed to add cache value");
-        lv_mem_free(buffer);
-        return NULL;
+
+    if(g == NULL) {
+        LV_LOG_TRACE("cache miss for letter: %u", unicode_letter);
+        stbrp_rect rect;
+        lv_memset(&rect, 0, sizeof(rect));
+        rect.w = w;
+        rect.h = h;
+        ttf_atlas_page_t * page = atlas_pack(&rect);
+        if(page == NULL) {
+            lv_memset(buf, 0, w * h);
+            stbtt_MakeGlyphBitmap(&dsc->info, buf, w, h, w, dsc->scale, dsc->scale, m->glyph);
+            return buf;
+        }
+
+        /*Overwrite an other glyph if all slots are used. Its place in the page is lost until the page is cleared.*/
+        g = free_slot ? free_slot : &atlas.glyphs[hash];
+        g->font_id = dsc->font_id;
+        g->font_size = dsc->font_size;
+        g->glyph = m->glyph;
+        g->page = (uint8_t)(page - atlas.pages);
+        g->generation = page->generation;
+        g->x = (uint8_t)rect.x;
+        g->y = (uint8_t)rect.y;
+
+        /*Render into the atlas*/
+        uint8_t * dst = &page->bitmap[g->y * ATLAS_PAGE_SIZE + g->x];
+        for(int y = 0; y < h; y++) lv_memset(&dst[y * ATLAS_PAGE_SIZE], 0, w);
+        stbtt_MakeGlyphBitmap(&dsc->info, dst, w, h, ATLAS_PAGE_SIZE, dsc->scale, dsc->scale, m->glyph);
+    }
+
+    ttf_atlas_page_t * page = &atlas.pages[g->page];
+    page->last_used = ++atlas.use_cnt;
+
+    const uint8_t * src = &page->bitmap[g->y * ATLAS_PAGE_SIZE + g->x];
+    for(int y = 0; y < h; y++) {
+        lv_memcpy(&buf[y * w], &src[y * ATLAS_PAGE_SIZE], w);
+    }
+    return buf;
+}
+
+static bool atlas_init(void)
+{
+    if(atlas.ref_cnt == 0 && ATLAS_PAGE_CNT > 0) {
+        atlas.pages = TTF_MALLOC(sizeof(ttf_atlas_page_t) * ATLAS_PAGE_CNT);
+        uint32_t glyph_cnt_min = ATLAS_PAGE_CNT * ATLAS_GLYPHS_PER_PAGE;
+        atlas.glyph_cnt = 1;
+        while(atlas.glyph_cnt < glyph_cnt_min) atlas.glyph_cnt <<= 1;
+        atlas.glyphs = TTF_MALLOC(sizeof(ttf_atlas_glyph_t) * atlas.glyph_cnt);
+        if(atlas.pages == NULL || atlas.glyphs == NULL) {
+            TTF_FREE(atlas.pages);
+            TTF_FREE(atlas.glyphs);
+            return false;
+        }
+        lv_memset(atlas.pages, 0, sizeof(ttf_atlas_page_t) * ATLAS_PAGE_CNT);
+        for(uint32_t i = 0; i < atlas.glyph_cnt; i++) atlas.glyphs[i].page = ATLAS_PAGE_NONE;
     }
-    /*Render into cache*/
-    stbtt_MakeGlyphBitmap(info, buffer, w, h, stride, dsc->scale, dsc->scale, g1);
-    return buffer;
+    atlas.ref_cnt++;
+    atlas.next_font_id++;
+    return true;
+}
+
+static void atlas_release(uint32_t font_id)
+{
+    /*Remove the font's glyphs so that a new font can reuse the ID*/
+    for(uint32_t i = 0; i < atlas.glyph_cnt; i++) {
+        if(atlas.glyphs[i].font_id == font_id) atlas.glyphs[i].page = ATLAS_PAGE_NONE;
+    }
+
+    atlas.ref_cnt--;
+    if(atlas.ref_cnt > 0) return;
+
+    for(int32_t i = 0; i < ATLAS_PAGE_CNT; i++) TTF_FREE(atlas.pages[i].bitmap);
+    TTF_FREE(atlas.pages);
+    TTF_FREE(atlas.glyphs);
+    TTF_FREE(atlas.buf);
+    lv_memset(&atlas, 0, sizeof(atlas));
+}
+
+/*Check if the font has a kern table or pair adjustments in its GPOS table.
+ *Many CJK fonts have an empty GPOS table; they don't need a kerning cache.*/
+static bool font_has_kerning(const stbtt_fontinfo * info)
+{
+    if(info->gpos == 0) return info->kern != 0;
+    if(ttUSHORT(info->data, info->gpos) != 1 || ttUSHORT(info->data, info->gpos + 2) != 0) return false;
+
+    stbtt_uint32 lookup_list = info->gpos + ttUSHORT(info->data, info->gpos + 8);
+    uint32_t lookup_cnt = ttUSHORT(info->data, lookup_list);
+    for(uint32_t i = 0; i < lookup_cnt; i++) {
+        stbtt_uint32 lookup = lookup_list + ttUSHORT(info->data, lookup_list + 2 + 2 * i);
+        if(ttUSHORT(info->data, lookup) == 2) return true;  /*Pair adjustment*/
+    }
+    return false;
+}
+
+/*Round down to a power of 2 but at least 16*/
+static uint32_t cache_entry_cnt(size_t cache_size, size_t entry_size)
+{
+    uint32_t cnt = 16;
+    while(cnt * 2 * entry_size <= cache_size) cnt <<= 1;
+    return cnt;
 }
 
 static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size_t data_size, lv_coord_t font_size,
@@ -211,16 +447,30 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
     }
 #endif
 
-    dsc->bitmap_cache = lv_lru_create(cache_size, font_size * font_size, lv_mem_free, lv_mem_free);
-    if(dsc->bitmap_cache == NULL) {
-        LV_LOG_ERROR("failed to create lru cache");
-        goto err_after_dsc;
+    /*Half of the cache for the metrics and half for the kerning pairs (if the font has kerning)*/
+    bool has_kern = font_has_kerning(&dsc->info);
+    uint32_t metrics_cnt = cache_entry_cnt(has_kern ? cache_size / 2 : cache_size, sizeof(ttf_glyph_metrics_t));
+    uint32_t kern_cnt = has_kern ? cache_entry_cnt(cache_size / 2, sizeof(ttf_kern_pair_t)) : 0;
+    dsc->metrics_cache = TTF_MALLOC(metrics_cnt * sizeof(ttf_glyph_metrics_t));
+    dsc->metrics_cache_mask = metrics_cnt - 1;
+    dsc->kern_cache = has_kern ? TTF_MALLOC(kern_cnt * sizeof(ttf_kern_pair_t)) : NULL;
+    dsc->kern_cache_mask = kern_cnt - 1;
+    if(dsc->metrics_cache == NULL || (has_kern && dsc->kern_cache == NULL)) {
+        LV_LOG_ERROR("tiny_ttf: out of memory\n");
+        goto err_after_caches;
     }
+    if(dsc->kern_cache) lv_memset(dsc->kern_cache, 0, kern_cnt * sizeof(ttf_kern_pair_t));
+
+    if(!atlas_init()) {
+        LV_LOG_ERROR("tiny_ttf: out of memory\n");
+        goto err_after_caches;
+    }
+    dsc->font_id = atlas.next_font_id;
 
     lv_font_t * out_font = (lv_font_t *)TTF_MALLOC(sizeof(lv_font_t));
     if(out_font == NULL) {
         LV_LOG_ERROR("tiny_ttf: out of memory\n");
-        goto err_after_bitmap_cache;
+        goto err_after_atlas;
     }
     lv_memset(out_font, 0, sizeof(lv_font_t));
     out_font->get_glyph_dsc = ttf_get_glyph_dsc_cb;
@@ -228,8 +478,11 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
     out_font->dsc = dsc;
     lv_tiny_ttf_set_size(out_font, font_size);
     return out_font;
-err_after_bitmap_cache:
-    lv_lru_del(dsc->bitmap_cache);
+err_after_atlas:
+    atlas_release(dsc->font_id);
+err_after_caches:
+    TTF_FREE(dsc->metrics_cache);
+    TTF_FREE(dsc->kern_cache);
 err_after_dsc:
     TTF_FREE(dsc);
     return NULL;
@@ -264,6 +517,12 @@ void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size)
     stbtt_GetFontVMetrics(&dsc->info, &dsc->ascent, &dsc->descent, &line_gap);
     font->line_height = (lv_coord_t)(dsc->scale * (dsc->ascent - dsc->descent + line_gap));
     font->base_line = (lv_coord_t)(dsc->scale * (line_gap - dsc->descent));
+
+    /*The boxes of the glyphs depend on the size. The kerning and the atlas has the size in the keys.*/
+    dsc->font_size = (uint16_t)font_size;
+    for(uint32_t i = 0; i <= dsc->metrics_cache_mask; i++) {
+        dsc->metrics_cache[i].unicode_letter = UINT32_MAX;
+    }
 }
 void lv_tiny_ttf_destroy(lv_font_t * font)
 {
@@ -275,7 +534,9 @@ void lv_tiny_ttf_destroy(lv_font_t * font)
                 lv_fs_close(&ttf->file);
             }
 #endif
-            lv_lru_del(ttf->bitmap_cache);
+            atlas_release(ttf->font_id);
+            TTF_FREE(ttf->metrics_cache);
+            TTF_FREE(ttf->kern_cache);
             TTF_FREE(ttf);
         }
         TTF_FREE(font);
@@ -33,14 +33,18 @@ extern "C" {
 /* create a font from the specified file or path with the specified line height.*/
 lv_font_t * lv_tiny_ttf_create_file(const char * path, lv_coord_t font_size);
 
-/* create a font from the specified file or path with the specified line height with the specified cache size.*/
+/* create a font from the specified file or path with the specified line height with the specified cache size.
+ * cache_size is the memory in bytes used to cache the metrics and kerning of the glyphs.
+ * The rendered glyphs are cached in an atlas shared by all fonts (see LV_TINY_TTF_CACHE_SIZE).*/
 lv_font_t * lv_tiny_ttf_create_file_ex(const char * path, lv_coord_t font_size, size_t cache_size);
 #endif /*LV_TINY_TTF_FILE_SUPPORT*/
 
 /* create a font from the specified data pointer with the specified line height.*/
 lv_font_t * lv_tiny_ttf_create_data(const void * data, size_t data_size, lv_coord_t font_size);
 
-/* create a font from the specified data pointer with the specified line height and the specified cache size.*/
+/* create a font from the specified data pointer with the specified line height and the specified cache size.
+ * cache_size is the memory in bytes used to cache the metrics and kerning of the glyphs.
+ * The rendered glyphs are cached in an atlas shared by all fonts (see LV_TINY_TTF_CACHE_SIZE).*/
 lv_font_t * lv_tiny_ttf_create_data_ex(const void * data, size_t data_size, lv_coord_t font_size, size_t cache_size);
 
 /* set the size of the font to a new font_size*/
@@ -62,6 +62,10 @@ void lv_extra_init(void)
     lv_fs_posix_init();
 #endif
 
+#if LV_USE_FS_CACHED != '\0'
+    lv_fs_cached_init();
+#endif
+
 #if LV_USE_FS_WIN32 != '\0'
     lv_fs_win32_init();
 #endif
@@ -82,6 +86,14 @@ void lv_extra_init(void)
     lv_bmp_init();
 #endif
 
+#if LV_USE_RLZ
+    lv_rlz_init();
+#endif
+
+#if LV_USE_ASSET_PACK
+    lv_asset_pack_init();
+#endif
+
 #if LV_USE_FREETYPE
     /*Init freetype library*/
 #  if LV_FREETYPE_CACHE_SIZE >= 0
@@ -0,0 +1,529 @@
+/**
+ * @file lv_asset_pack.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_asset_pack.h"
+#if LV_USE_ASSET_PACK
+
+#include <string.h>
+#include "../../../misc/lv_mem.h"
+#include "../../../misc/lv_fs.h"
+#include "../../../misc/lv_assert.h"
+#include "../../../misc/lv_log.h"
+#include "../../../draw/lv_draw_img.h"
+#include "../../../draw/lv_img_decoder.h"
+#include "../../../draw/lv_img_cache.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define PACK_MAGIC          0x5041564C  /*"LVAP"*/
+#define PACK_VERSION        1
+#define PACK_FLAG_16_SWAP   0x01
+#define IMG_MAGIC           0x4941564C  /*"LVAI"*/
+
+/*Compression of the images*/
+#define COMP_NONE           0
+#define COMP_RLE            1           /*See `rle_read_row`*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t color_depth;
+    uint8_t flags;
+    uint32_t entry_cnt;
+    uint32_t index_ofs;
+} pack_header_t;
+
+/*The header of the image assets, followed by the pixels in LVGL's format for `color_depth`.
+ *Compressed images have a table with the offset of each row after the header.*/
+typedef struct {
+    uint32_t magic;
+    uint8_t cf;
+    uint8_t compression;
+    uint16_t w;
+    uint16_t h;
+    uint16_t reserved;
+} img_header_t;
+
+/*An asset opened with the file system driver*/
+typedef struct {
+    const uint8_t * data;
+    uint32_t size;
+    uint32_t pos;
+} file_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static int32_t entry_find(const lv_asset_pack_t * pack, const char * name);
+static uint32_t hash_calc(const char * str);
+static const lv_asset_pack_t * pack_find(const lv_img_dsc_t * img_dsc);
+static const img_header_t * img_header_get(const lv_img_dsc_t * img_dsc);
+static uint8_t px_size_get(uint8_t color_depth, lv_img_cf_t cf);
+static void px_convert(const lv_asset_pack_t * pack, bool alpha, const uint8_t * src, uint8_t * dst, uint32_t cnt);
+static lv_res_t rle_read_row(const lv_asset_pack_t * pack, const img_header_t * header, uint32_t size, lv_coord_t x,
+                             lv_coord_t y, lv_coord_t len, uint8_t * buf);
+static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
+static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf);
+#if LV_ASSET_PACK_LETTER != '\0'
+    static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
+    static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p);
+    static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+    static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
+    static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_asset_pack_t * pack_head;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_asset_pack_init(void)
+{
+    lv_img_decoder_t * dec = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(dec, decoder_info);
+    lv_img_decoder_set_open_cb(dec, decoder_open);
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+
+#if LV_ASSET_PACK_LETTER != '\0'
+    static lv_fs_drv_t fs_drv;
+    lv_fs_drv_init(&fs_drv);
+
+    fs_drv.letter = LV_ASSET_PACK_LETTER;
+    fs_drv.cache_size = 0;  /*The assets are in the memory anyway*/
+    fs_drv.open_cb = fs_open;
+    fs_drv.close_cb = fs_close;
+    fs_drv.read_cb = fs_read;
+    fs_drv.seek_cb = fs_seek;
+    fs_drv.tell_cb = fs_tell;
+
+    lv_fs_drv_register(&fs_drv);
+#endif
+}
+
+lv_res_t lv_asset_pack_open(lv_asset_pack_t * pack, const void * data, uint32_t size)
+{
+    lv_memset_00(pack, sizeof(lv_asset_pack_t));
+    LV_ASSERT_MSG(((lv_uintptr_t)data & 0x3) == 0, "the pack has to be 4 byte aligned");
+
+    const pack_header_t * header = data;
+    if(size < sizeof(pack_header_t) || header->magic != PACK_MAGIC || header->version != PACK_VERSION) {
+        LV_LOG_WARN("not an asset pack");
+        return LV_RES_INV;
+    }
+
+    if(header->color_depth != 16 && header->color_depth != 32) {
+        LV_LOG_WARN("unsupported color depth: %d", header->color_depth);
+        return LV_RES_INV;
+    }
+
+    if((header->index_ofs & 0x3) || header->index_ofs > size ||
+       header->entry_cnt > (size - header->index_ofs) / sizeof(lv_asset_pack_entry_t)) {
+        LV_LOG_WARN("invalid index");
+        return LV_RES_INV;
+    }
+
+    /*Check the entries once to use them without checks later*/
+    const uint8_t * bytes = data;
+    const lv_asset_pack_entry_t * entries = (const lv_asset_pack_entry_t *)(bytes + header->index_ofs);
+    uint32_t i;
+    for(i = 0; i < header->entry_cnt; i++) {
+        const lv_asset_pack_entry_t * e = &entries[i];
+        if(e->name_ofs >= size || memchr(bytes + e->name_ofs, '\0', size - e->name_ofs) == NULL ||
+           e->data_ofs > size || e->data_size > size - e->data_ofs || (e->data_ofs & 0x3) ||
+           (i > 0 && e->name_hash < entries[i - 1].name_hash)) {
+            LV_LOG_WARN("invalid entry: %d", (int)i);
+            return LV_RES_INV;
+        }
+    }
+
+    pack->data = data;
+    pack->size = size;
+    pack->entries = entries;
+    pack->entry_cnt = header->entry_cnt;
+    pack->color_depth = header->color_depth;
+    pack->color_16_swap = header->flags & PACK_FLAG_16_SWAP ? 1 : 0;
+
+    pack->next = pack_head;
+    pack_head = pack;
+
+    return LV_RES_OK;
+}
+
+void lv_asset_pack_close(lv_asset_pack_t * pack)
+{
+    lv_asset_pack_t ** p = &pack_head;
+    while(*p && *p != pack) p = &(*p)->next;
+    if(*p) *p = pack->next;
+
+    if(pack->img_dscs) {
+        uint32_t i;
+        for(i = 0; i < pack->entry_cnt; i++) {
+            if(pack->img_dscs[i].data) lv_img_cache_invalidate_src(&pack->img_dscs[i]);
+        }
+        lv_mem_free(pack->img_dscs);
+    }
+
+    lv_memset_00(pack, sizeof(lv_asset_pack_t));
+}
+
+const lv_img_dsc_t * lv_asset_pack_get_img(lv_asset_pack_t * pack, const char * name)
+{
+    int32_t i = entry_find(pack, name);
+    if(i < 0) return NULL;
+
+    if(pack->img_dscs == NULL) {
+        pack->img_dscs = lv_mem_alloc(pack->entry_cnt * sizeof(lv_img_dsc_t));
+        LV_ASSERT_MALLOC(pack->img_dscs);
+        if(pack->img_dscs == NULL) return NULL;
+        lv_memset_00(pack->img_dscs, pack->entry_cnt * sizeof(lv_img_dsc_t));
+    }
+
+    lv_img_dsc_t * dsc = &pack->img_dscs[i];
+    if(dsc->data) return dsc;
+
+    const lv_asset_pack_entry_t * e = &pack->entries[i];
+    const img_header_t * header = (const img_header_t *)(pack->data + e->data_ofs);
+    if(e->data_size < sizeof(img_header_t) || header->magic != IMG_MAGIC) {
+        LV_LOG_WARN("%s is not an image", name);
+        return NULL;
+    }
+
+    dsc->header.always_zero = 0;
+    dsc->header.w = header->w;
+    dsc->header.h = header->h;
+
+    bool native = header->compression == COMP_NONE && pack->color_depth == LV_COLOR_DEPTH &&
+                  (LV_COLOR_DEPTH != 16 || pack->color_16_swap == LV_COLOR_16_SWAP);
+    if(native) {
+        /*Zero copy: the built-in decoder draws the pixels from the mapped memory*/
+        dsc->header.cf = header->cf;
+        dsc->data = (const uint8_t *)(header + 1);
+        dsc->data_size = e->data_size - sizeof(img_header_t);
+    }
+    else {
+        dsc->header.cf = LV_ASSET_PACK_CF;
+        dsc->data = (const uint8_t *)header;
+        dsc->data_size = e->data_size;
+    }
+
+    return dsc;
+}
+
+const void * lv_asset_pack_get_data(const lv_asset_pack_t * pack, const char * name, uint32_t * size)
+{
+    int32_t i = entry_find(pack, name);
+    if(i < 0) return NULL;
+
+    if(size) *size = pack->entries[i].data_size;
+    return pack->data + pack->entries[i].data_ofs;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Binary search of a name
+ * @return index of the entry or -1 if not found
+ */
+static int32_t entry_find(const lv_asset_pack_t * pack, const char * name)
+{
+    uint32_t hash = hash_calc(name);
+
+    /*Find the first entry with the hash*/
+    uint32_t min = 0;
+    uint32_t max = pack->entry_cnt;
+    while(min < max) {
+        uint32_t mid = (min + max) / 2;
+        if(pack->entries[mid].name_hash < hash) min = mid + 1;
+        else max = mid;
+    }
+
+    for(; min < pack->entry_cnt && pack->entries[min].name_hash == hash; min++) {
+        if(strcmp((const char *)pack->data + pack->entries[min].name_ofs, name) == 0) return min;
+    }
+
+    return -1;
+}
+
+/**
+ * FNV-1a hash
+ */
+static uint32_t hash_calc(const char * str)
+{
+    uint32_t hash = 2166136261u;
+    while(*str) {
+        hash ^= (uint8_t) * str;
+        hash *= 16777619u;
+        str++;
+    }
+    return hash;
+}
+
+/**
+ * Find the pack of an image
+ */
+static const lv_asset_pack_t * pack_find(const lv_img_dsc_t * img_dsc)
+{
+    const lv_asset_pack_t * pack;
+    for(pack = pack_head; pack; pack = pack->next) {
+        if(img_dsc->data >= pack->data && img_dsc->data < pack->data + pack->size) return pack;
+    }
+    return NULL;
+}
+
+/**
+ * Get the header of an image which needs to be decoded
+ * @return the header or NULL if the image is not an asset of a pack
+ */
+static const img_header_t * img_header_get(const lv_img_dsc_t * img_dsc)
+{
+    if(img_dsc->header.cf != LV_ASSET_PACK_CF || img_dsc->data_size < sizeof(img_header_t)) return NULL;
+
+    const img_header_t * header = (const img_header_t *)img_dsc->data;
+    if(header->magic != IMG_MAGIC) return NULL;
+    return header;
+}
+
+/**
+ * Get the size of a pixel in a pack
+ */
+static uint8_t px_size_get(uint8_t color_depth, lv_img_cf_t cf)
+{
+    if(color_depth == 32) return 4;
+    return cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? 3 : 2;
+}
+
+/**
+ * Convert pixels of a pack to the current color format
+ */
+static void px_convert(const lv_asset_pack_t * pack, bool alpha, const uint8_t * src, uint8_t * dst, uint32_t cnt)
+{
+    uint8_t px_size = px_size_get(pack->color_depth, alpha ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_color_t c;
+        lv_opa_t a;
+        if(pack->color_depth == 32) {
+            c = lv_color_make(src[2], src[1], src[0]);
+            a = src[3];
+        }
+        else {
+            uint16_t v = pack->color_16_swap ? (src[0] << 8) | src[1] : src[0] | (src[1] << 8);
+            uint32_t r = v >> 11;
+            uint32_t g = (v >> 5) & 0x3F;
+            uint32_t b = v & 0x1F;
+            c = lv_color_make((r * 263 + 7) >> 5, (g * 259 + 3) >> 6, (b * 263 + 7) >> 5);
+            a = src[2];
+        }
+
+#if LV_COLOR_DEPTH == 32
+        if(alpha) c.ch.alpha = a;
+        lv_memcpy_small(dst, &c, sizeof(lv_color_t));
+        dst += sizeof(lv_color_t);
+#else
+        lv_memcpy_small(dst, &c, sizeof(lv_color_t));
+        dst += sizeof(lv_color_t);
+        if(alpha) *dst++ = a;
+#endif
+        src += px_size;
+    }
+}
+
+/**
+ * Decode a part of a row of an RLE compressed image.
+ * The rows are compressed separately. A row is a series of packets starting with a control byte `c`:
+ * - `c < 0x80`: `c + 1` literal pixels follow
+ * - `c >= 0x80`: a pixel follows which is repeated `(c & 0x7F) + 2` times
+ */
+static lv_res_t rle_read_row(const lv_asset_pack_t * pack, const img_header_t * header, uint32_t size, lv_coord_t x,
+                             lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    bool alpha = header->cf == LV_IMG_CF_TRUE_COLOR_ALPHA;
+    uint32_t px_size = px_size_get(pack->color_depth, header->cf);
+    uint32_t out_px_size = alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+
+    const uint32_t * row_ofs = (const uint32_t *)(header + 1);
+    const uint8_t * rows = (const uint8_t *)(row_ofs + header->h);
+    const uint8_t * end = (const uint8_t *)header + size;
+    if(row_ofs[y] >= (uint32_t)(end - rows)) return LV_RES_INV;
+    const uint8_t * p = rows + row_ofs[y];
+
+    uint32_t x_start = x;
+    uint32_t x_end = x + len;
+    uint32_t px_x = 0;
+    while(px_x < x_end) {
+        if(p >= end) return LV_RES_INV;
+        uint8_t c = *p++;
+        bool run = c & 0x80;
+        uint32_t cnt = run ? (c & 0x7F) + 2 : c + 1;
+        uint32_t data_size = run ? px_size : cnt * px_size;
+        if(data_size > (uint32_t)(end - p)) return LV_RES_INV;
+
+        /*The part of the packet in the requested area*/
+        uint32_t s = LV_MAX(px_x, x_start);
+        uint32_t e = LV_MIN(px_x + cnt, x_end);
+        if(s < e) {
+            uint8_t * out = buf + (s - x_start) * out_px_size;
+            if(run) {
+                px_convert(pack, alpha, p, out, 1);
+                uint32_t i;
+                for(i = 1; i < e - s; i++) lv_memcpy_small(out + i * out_px_size, out, out_px_size);
+            }
+            else {
+                px_convert(pack, alpha, p + (s - px_x) * px_size, out, e - s);
+            }
+        }
+
+        p += data_size;
+        px_x += cnt;
+    }
+
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return LV_RES_INV;
+
+    const img_header_t * img_header = img_header_get(src);
+    if(img_header == NULL) return LV_RES_INV;
+
+    header->always_zero = 0;
+    header->cf = img_header->cf;
+    header->w = img_header->w;
+    header->h = img_header->h;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    if(decoder_info(decoder, dsc->src, &dsc->header) != LV_RES_OK) return LV_RES_INV;
+
+    /*The pack has to be opened to know its color format*/
+    const lv_asset_pack_t * pack = pack_find(dsc->src);
+    if(pack == NULL) {
+        LV_LOG_WARN("the pack of the image is not opened");
+        return LV_RES_INV;
+    }
+
+    const lv_img_dsc_t * img_dsc = dsc->src;
+    const img_header_t * header = img_header_get(img_dsc);
+    uint64_t size_min = sizeof(img_header_t);
+    if(header->compression == COMP_RLE) size_min += (uint64_t)header->h * sizeof(uint32_t);
+    else size_min += (uint64_t)header->w * header->h * px_size_get(pack->color_depth, header->cf);
+    if(header->compression > COMP_RLE || img_dsc->data_size < size_min) {
+        LV_LOG_WARN("invalid image");
+        return LV_RES_INV;
+    }
+
+    dsc->user_data = (void *)pack;
+
+    /*Decoded line by line*/
+    dsc->img_data = NULL;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    const lv_asset_pack_t * pack = dsc->user_data;
+    const lv_img_dsc_t * img_dsc = dsc->src;
+    const img_header_t * header = img_header_get(img_dsc);
+
+    if(header->compression == COMP_RLE) return rle_read_row(pack, header, img_dsc->data_size, x, y, len, buf);
+
+    uint32_t px_size = px_size_get(pack->color_depth, header->cf);
+    const uint8_t * src = (const uint8_t *)(header + 1) + ((uint32_t)y * header->w + x) * px_size;
+    px_convert(pack, header->cf == LV_IMG_CF_TRUE_COLOR_ALPHA, src, buf, len);
+    return LV_RES_OK;
+}
+
+#if LV_ASSET_PACK_LETTER != '\0'
+
+static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+    if(mode != LV_FS_MODE_RD) return NULL;
+    if(path[0] == '/') path++;
+
+    const lv_asset_pack_t * pack;
+    for(pack = pack_head; pack; pack = pack->next) {
+        uint32_t size;
+        const uint8_t * data = lv_asset_pack_get_data(pack, path, &size);
+        if(data == NULL) continue;
+
+        file_t * file = lv_mem_alloc(sizeof(file_t));
+        LV_ASSERT_MALLOC(file);
+        if(file == NULL) return NULL;
+        file->data = data;
+        file->size = size;
+        file->pos = 0;
+        return file;
+    }
+
+    return NULL;
+}
+
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    lv_mem_free(file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+    file_t * file = file_p;
+    *br = LV_MIN(btr, file->size - file->pos);
+    lv_memcpy(buf, file->data + file->pos, *br);
+    file->pos += *br;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    file_t * file = file_p;
+    int64_t new_pos = pos;
+    if(whence == LV_FS_SEEK_CUR) new_pos += file->pos;
+    else if(whence == LV_FS_SEEK_END) new_pos += file->size;
+
+    if(new_pos > file->size) return LV_FS_RES_INV_PARAM;
+    file->pos = (uint32_t)new_pos;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+    file_t * file = file_p;
+    *pos_p = file->pos;
+    return LV_FS_RES_OK;
+}
+
+#endif /*LV_ASSET_PACK_LETTER != '\0'*/
+
+#endif /*LV_USE_ASSET_PACK*/
@@ -0,0 +1,111 @@
+/**
+ * @file lv_asset_pack.h
+ *
+ */
+
+#ifndef LV_ASSET_PACK_H
+#define LV_ASSET_PACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lv_conf_internal.h"
+#include "../../../draw/lv_img_buf.h"
+
+#if LV_USE_ASSET_PACK
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Color format of the images which need to be decoded (compressed or made for an other color depth)*/
+#define LV_ASSET_PACK_CF    LV_IMG_CF_USER_ENCODED_0
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * An asset in the index of a pack
+ */
+typedef struct {
+    uint32_t name_hash;     /*FNV-1a hash of the name*/
+    uint32_t name_ofs;      /*Offset of the zero terminated name*/
+    uint32_t data_ofs;      /*Offset of the data, 4 byte aligned*/
+    uint32_t data_size;
+} lv_asset_pack_entry_t;
+
+/**
+ * Pre-converted images and other files (e.g. fonts) made by `scripts/lv_asset_pack.py`,
+ * stored in one memory mapped blob, e.g. a flash partition.
+ * The index and the uncompressed images are used directly from the mapped memory.
+ */
+typedef struct _lv_asset_pack_t {
+    const uint8_t * data;                   /*The mapped pack*/
+    uint32_t size;
+    const lv_asset_pack_entry_t * entries;  /*Sorted by `name_hash`*/
+    uint32_t entry_cnt;
+    lv_img_dsc_t * img_dscs;                /*The images of the entries, created on demand*/
+    struct _lv_asset_pack_t * next;         /*The next opened pack*/
+    uint8_t color_depth;                    /*Color depth of the images: 16 or 32*/
+    uint8_t color_16_swap : 1;              /*The bytes of the RGB565 colors are swapped*/
+} lv_asset_pack_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Register the image decoder of the packs and the `LV_ASSET_PACK_LETTER` file system driver
+ */
+void lv_asset_pack_init(void);
+
+/**
+ * Open a pack from a memory mapped blob, e.g. from a flash partition mapped by `esp_partition_mmap()`
+ * @param pack      pointer to a pack
+ * @param data      the pack, 4 byte aligned. It has to remain valid until the pack is closed.
+ * @param size      size of the pack in bytes
+ * @return          LV_RES_OK: the pack is opened; LV_RES_INV: the pack is invalid
+ */
+lv_res_t lv_asset_pack_open(lv_asset_pack_t * pack, const void * data, uint32_t size);
+
+/**
+ * Close a pack. Set an other source on the images which use its images first.
+ * @param pack      pointer to an opened pack
+ */
+void lv_asset_pack_close(lv_asset_pack_t * pack);
+
+/**
+ * Get an image from a pack.
+ * Uncompressed images made for the current color depth are drawn from the mapped memory without copying.
+ * The others are decoded line by line while drawing.
+ * @param pack      pointer to an opened pack
+ * @param name      name of the image in the pack, e.g. "icons/wifi.png"
+ * @return          the image or NULL if not found. It's valid until the pack is closed.
+ */
+const lv_img_dsc_t * lv_asset_pack_get_img(lv_asset_pack_t * pack, const char * name);
+
+/**
+ * Get the data of an asset in a pack
+ * @param pack      pointer to an opened pack
+ * @param name      name of the asset in the pack, e.g. "fonts/montserrat_14.fnt"
+ * @param size      store the size of the data here (can be NULL)
+ * @return          pointer to the data in the mapped memory or NULL if not found
+ */
+const void * lv_asset_pack_get_data(const lv_asset_pack_t * pack, const char * name, uint32_t * size);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_ASSET_PACK*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_ASSET_PACK_H*/
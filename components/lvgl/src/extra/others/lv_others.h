@@ -20,6 +20,8 @@ extern "C" {
 #include "imgfont/lv_imgfont.h"
 #include "msg/lv_msg.h"
 #include "ime/lv_ime_pinyin.h"
+#include "thumb/lv_thumb.h"
+#include "asset_pack/lv_asset_pack.h"
 
 /*********************
  *      DEFINES
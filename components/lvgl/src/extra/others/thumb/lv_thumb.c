@@ -0,0 +1,798 @@
+/**
+ * @file lv_thumb.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_thumb.h"
+#if LV_USE_THUMB
+
+#include <string.h>
+#include "../../../misc/lv_mem.h"
+#include "../../../misc/lv_assert.h"
+#include "../../../misc/lv_log.h"
+#include "../../../draw/lv_img_cache.h"
+#if LV_USE_SJPG
+    #include "../../libs/sjpg/tjpgd.h"
+#endif
+#if LV_USE_PNG
+    #include "../../libs/png/lv_png_stream.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define PACK_MAGIC          0x504D4854  /*"THMP"*/
+#define PACK_VERSION        1
+#define JPG_POOL_SIZE       4096        /*Recommended by TJpgDec*/
+#define BMP_ROWS_PER_STEP   16
+#define PNG_ROWS_PER_STEP   16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    SRC_TYPE_UNKNOWN,
+    SRC_TYPE_JPG,
+    SRC_TYPE_PNG,
+    SRC_TYPE_BMP,
+} src_type_t;
+
+/*Pixel formats of the decoded source rows*/
+typedef enum {
+    PX_FORMAT_RGB888,
+    PX_FORMAT_BGR888,
+    PX_FORMAT_BGRX8888,
+    PX_FORMAT_RGBA8888,
+} px_format_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t max_size;
+    uint32_t entry_cnt;
+    uint32_t index_ofs;
+    uint32_t index_hash;
+} pack_header_t;
+
+#if LV_USE_SJPG
+typedef struct {
+    JDEC jd;
+    uint32_t band_y;        /*The first scaled row of the current MCU row*/
+    uint8_t pool[JPG_POOL_SIZE];
+} jpg_work_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static src_type_t get_src_type(const char * fn);
+static void thumb_size_calc(lv_thumb_gen_t * gen, uint32_t src_w, uint32_t src_h);
+static lv_res_t scaler_init(lv_thumb_gen_t * gen, uint32_t src_w, uint32_t src_h);
+static void scaler_push_row(lv_thumb_gen_t * gen, uint32_t y, const uint8_t * row, px_format_t format);
+static void scaler_flush(lv_thumb_gen_t * gen);
+static void gen_finish(lv_thumb_gen_t * gen);
+static void work_free(lv_thumb_gen_t * gen);
+#if LV_USE_SJPG
+    static lv_res_t jpg_start(lv_thumb_gen_t * gen);
+    static lv_res_t jpg_step(lv_thumb_gen_t * gen);
+    static size_t jpg_input(JDEC * jd, uint8_t * buf, size_t len);
+    static int jpg_output(JDEC * jd, void * data, JRECT * rect);
+#endif
+#if LV_USE_PNG
+    static lv_res_t png_start(lv_thumb_gen_t * gen, const char * path);
+    static lv_res_t png_step(lv_thumb_gen_t * gen);
+#endif
+static lv_res_t bmp_start(lv_thumb_gen_t * gen);
+static lv_res_t bmp_step(lv_thumb_gen_t * gen);
+static bool pack_load_index(lv_thumb_pack_t * pack);
+static int32_t pack_search(const lv_thumb_pack_t * pack, uint32_t hash);
+static uint32_t hash_calc(const void * data, uint32_t size);
+static uint32_t get_u32_le(const uint8_t * p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool lv_thumb_is_supported(const char * fn)
+{
+    return get_src_type(fn) != SRC_TYPE_UNKNOWN;
+}
+
+lv_res_t lv_thumb_gen_start(lv_thumb_gen_t * gen, const char * path, uint16_t max_size)
+{
+    LV_ASSERT_NULL(gen);
+    lv_memset_00(gen, sizeof(lv_thumb_gen_t));
+    gen->max_size = max_size;
+    gen->acc_y = -1;
+    gen->type = get_src_type(path);
+    if(gen->type == SRC_TYPE_UNKNOWN || max_size == 0) return LV_RES_INV;
+
+    /*The PNG stream opens the file itself*/
+    if(gen->type != SRC_TYPE_PNG) {
+        if(lv_fs_open(&gen->file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+        gen->file_opened = 1;
+    }
+
+    lv_res_t res = LV_RES_INV;
+    switch(gen->type) {
+#if LV_USE_SJPG
+        case SRC_TYPE_JPG:
+            res = jpg_start(gen);
+            break;
+#endif
+#if LV_USE_PNG
+        case SRC_TYPE_PNG:
+            res = png_start(gen, path);
+            break;
+#endif
+        case SRC_TYPE_BMP:
+            res = bmp_start(gen);
+            break;
+        default:
+            break;
+    }
+
+    if(res != LV_RES_OK) {
+        LV_LOG_WARN("Can't make a thumbnail of %s", path);
+        lv_thumb_gen_end(gen);
+    }
+    return res;
+}
+
+lv_res_t lv_thumb_gen_step(lv_thumb_gen_t * gen)
+{
+    LV_ASSERT_NULL(gen);
+    if(gen->done) return LV_RES_OK;
+    if(gen->buf == NULL) return LV_RES_INV;
+
+    switch(gen->type) {
+#if LV_USE_SJPG
+        case SRC_TYPE_JPG:
+            return jpg_step(gen);
+#endif
+#if LV_USE_PNG
+        case SRC_TYPE_PNG:
+            return png_step(gen);
+#endif
+        case SRC_TYPE_BMP:
+            return bmp_step(gen);
+        default:
+            return LV_RES_INV;
+    }
+}
+
+void lv_thumb_gen_end(lv_thumb_gen_t * gen)
+{
+    LV_ASSERT_NULL(gen);
+    if(gen->file_opened) lv_fs_close(&gen->file);
+    gen->file_opened = 0;
+    work_free(gen);
+    lv_mem_free(gen->buf);
+    lv_mem_free(gen->acc);
+    lv_mem_free(gen->row_buf);
+    gen->buf = NULL;
+    gen->acc = NULL;
+    gen->row_buf = NULL;
+}
+
+lv_res_t lv_thumb_generate(lv_thumb_gen_t * gen, const char * path, uint16_t max_size)
+{
+    if(lv_thumb_gen_start(gen, path, max_size) != LV_RES_OK) return LV_RES_INV;
+
+    while(!gen->done) {
+        if(lv_thumb_gen_step(gen) != LV_RES_OK) {
+            lv_thumb_gen_end(gen);
+            return LV_RES_INV;
+        }
+    }
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_thumb_pack_open(lv_thumb_pack_t * pack, const char * path, uint16_t max_size)
+{
+    LV_ASSERT_NULL(pack);
+    lv_memset_00(pack, sizeof(lv_thumb_pack_t));
+    pack->max_size = max_size;
+    pack->data_end = sizeof(pack_header_t);
+
+    lv_fs_res_t res = lv_fs_open(&pack->file, path, LV_FS_MODE_RD | LV_FS_MODE_WR);
+    if(res != LV_FS_RES_OK) {
+        /*Some drivers can't create a file in read-write mode*/
+        res = lv_fs_open(&pack->file, path, LV_FS_MODE_WR);
+        if(res == LV_FS_RES_OK) {
+            lv_fs_close(&pack->file);
+            res = lv_fs_open(&pack->file, path, LV_FS_MODE_RD | LV_FS_MODE_WR);
+        }
+    }
+
+    if(res == LV_FS_RES_OK) {
+        pack->writable = 1;
+    }
+    else {
+        /*E.g. read-only file system. The existing thumbnails can be still used.*/
+        res = lv_fs_open(&pack->file, path, LV_FS_MODE_RD);
+        if(res != LV_FS_RES_OK) return LV_RES_INV;
+    }
+    pack->opened = 1;
+
+    if(!pack_load_index(pack)) {
+        lv_mem_free(pack->entries);
+        pack->entries = NULL;
+        pack->entry_cnt = 0;
+        pack->data_end = sizeof(pack_header_t);
+    }
+
+    return LV_RES_OK;
+}
+
+void lv_thumb_pack_close(lv_thumb_pack_t * pack)
+{
+    LV_ASSERT_NULL(pack);
+    if(!pack->opened) return;
+
+    lv_thumb_pack_flush(pack);
+    lv_fs_close(&pack->file);
+    lv_mem_free(pack->entries);
+    pack->entries = NULL;
+    pack->entry_cnt = 0;
+    pack->opened = 0;
+}
+
+lv_res_t lv_thumb_pack_flush(lv_thumb_pack_t * pack)
+{
+    LV_ASSERT_NULL(pack);
+    if(!pack->opened || !pack->dirty) return LV_RES_OK;
+
+    /*Write the index after the data and the header at last. If the writing is interrupted
+     *the hash of the index won't match and the pack will be rebuilt.*/
+    uint32_t index_size = pack->entry_cnt * sizeof(lv_thumb_entry_t);
+    pack_header_t header;
+    header.magic = PACK_MAGIC;
+    header.version = PACK_VERSION;
+    header.max_size = pack->max_size;
+    header.entry_cnt = pack->entry_cnt;
+    header.index_ofs = pack->data_end;
+    header.index_hash = hash_calc(pack->entries, index_size);
+
+    uint32_t bw;
+    if(lv_fs_seek(&pack->file, pack->data_end, LV_FS_SEEK_SET) != LV_FS_RES_OK) return LV_RES_INV;
+    if(index_size) {
+        if(lv_fs_write(&pack->file, pack->entries, index_size, &bw) != LV_FS_RES_OK || bw != index_size) return LV_RES_INV;
+    }
+    if(lv_fs_seek(&pack->file, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK) return LV_RES_INV;
+    if(lv_fs_write(&pack->file, &header, sizeof(header), &bw) != LV_FS_RES_OK || bw != sizeof(header)) return LV_RES_INV;
+
+    pack->dirty = 0;
+    return LV_RES_OK;
+}
+
+const lv_thumb_entry_t * lv_thumb_pack_find(const lv_thumb_pack_t * pack, const char * name, uint32_t src_size)
+{
+    LV_ASSERT_NULL(pack);
+    int32_t i = pack_search(pack, hash_calc(name, strlen(name)));
+    if(i < 0 || pack->entries[i].src_size != src_size) return NULL;
+    return &pack->entries[i];
+}
+
+lv_img_dsc_t * lv_thumb_pack_load(lv_thumb_pack_t * pack, const lv_thumb_entry_t * entry)
+{
+    LV_ASSERT_NULL(pack);
+    LV_ASSERT_NULL(entry);
+    if(!pack->opened) return NULL;
+
+    uint32_t px_cnt = (uint32_t)entry->w * entry->h;
+    uint32_t data_size = px_cnt * sizeof(lv_color_t);
+    lv_img_dsc_t * dsc = lv_mem_alloc(sizeof(lv_img_dsc_t) + data_size);
+    LV_ASSERT_MALLOC(dsc);
+    if(dsc == NULL) return NULL;
+
+    lv_memset_00(&dsc->header, sizeof(dsc->header));
+    dsc->header.cf = LV_IMG_CF_TRUE_COLOR;
+    dsc->header.w = entry->w;
+    dsc->header.h = entry->h;
+    dsc->data_size = data_size;
+    dsc->data = (uint8_t *)dsc + sizeof(lv_img_dsc_t);
+
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+    uint16_t * px = (uint16_t *)dsc->data;
+#else
+    uint16_t * px = lv_mem_buf_get(px_cnt * sizeof(uint16_t));
+#endif
+
+    uint32_t br = 0;
+    lv_fs_res_t res = lv_fs_seek(&pack->file, entry->data_ofs, LV_FS_SEEK_SET);
+    if(res == LV_FS_RES_OK) res = lv_fs_read(&pack->file, px, px_cnt * sizeof(uint16_t), &br);
+
+#if !(LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0)
+    lv_color_t * dest = (lv_color_t *)dsc->data;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t c = px[i];
+        uint32_t r = (c >> 11) & 0x1F;
+        uint32_t g = (c >> 5) & 0x3F;
+        uint32_t b = c & 0x1F;
+        dest[i] = lv_color_make((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+    }
+    lv_mem_buf_release(px);
+#endif
+
+    if(res != LV_FS_RES_OK || br != px_cnt * sizeof(uint16_t)) {
+        lv_mem_free(dsc);
+        return NULL;
+    }
+
+    return dsc;
+}
+
+lv_res_t lv_thumb_pack_add(lv_thumb_pack_t * pack, const char * name, uint32_t src_size, const lv_thumb_gen_t * gen)
+{
+    LV_ASSERT_NULL(pack);
+    LV_ASSERT_NULL(gen);
+    if(!pack->opened || !pack->writable || !gen->done || gen->buf == NULL) return LV_RES_INV;
+
+    uint32_t hash = hash_calc(name, strlen(name));
+    int32_t i = pack_search(pack, hash);
+    lv_thumb_entry_t * entry;
+    if(i >= 0) {
+        entry = &pack->entries[i];
+    }
+    else {
+        /*Insert a new entry keeping the order of the hashes*/
+        lv_thumb_entry_t * entries = lv_mem_realloc(pack->entries, (pack->entry_cnt + 1) * sizeof(lv_thumb_entry_t));
+        LV_ASSERT_MALLOC(entries);
+        if(entries == NULL) return LV_RES_INV;
+        pack->entries = entries;
+
+        uint32_t pos = (uint32_t)(-i - 1);
+        uint32_t j;
+        for(j = pack->entry_cnt; j > pos; j--) entries[j] = entries[j - 1];
+        pack->entry_cnt++;
+        entry = &entries[pos];
+        entry->name_hash = hash;
+        entry->w = 0;
+        entry->h = 0;
+    }
+
+    /*Overwrite the old thumbnail if it has the same size, else append*/
+    if(entry->w != gen->w || entry->h != gen->h) {
+        entry->data_ofs = pack->data_end;
+        entry->w = gen->w;
+        entry->h = gen->h;
+        pack->data_end += (uint32_t)gen->w * gen->h * sizeof(uint16_t);
+    }
+    entry->src_size = src_size;
+    pack->dirty = 1;
+
+    uint32_t size = (uint32_t)gen->w * gen->h * sizeof(uint16_t);
+    uint32_t bw = 0;
+    lv_fs_res_t res = lv_fs_seek(&pack->file, entry->data_ofs, LV_FS_SEEK_SET);
+    if(res == LV_FS_RES_OK) res = lv_fs_write(&pack->file, gen->buf, size, &bw);
+    if(res != LV_FS_RES_OK || bw != size) {
+        /*Don't point to invalid data*/
+        entry->src_size = UINT32_MAX;
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+void lv_thumb_free(lv_img_dsc_t * dsc)
+{
+    if(dsc == NULL) return;
+    lv_img_cache_invalidate_src(dsc);
+    lv_mem_free(dsc);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static src_type_t get_src_type(const char * fn)
+{
+    const char * ext = lv_fs_get_ext(fn);
+    char lower[8];
+    uint32_t i;
+    for(i = 0; ext[i] != '\0'; i++) {
+        if(i == sizeof(lower) - 1) return SRC_TYPE_UNKNOWN;
+        lower[i] = ext[i] >= 'A' && ext[i] <= 'Z' ? ext[i] + ('a' - 'A') : ext[i];
+    }
+    lower[i] = '\0';
+
+#if LV_USE_SJPG
+    /*Videos are Motion JPEGs. TJpgDec skips the data before the first JPEG.*/
+    if(strcmp(lower, "jpg") == 0 || strcmp(lower, "jpeg") == 0 ||
+       strcmp(lower, "mjpg") == 0 || strcmp(lower, "mjpeg") == 0) return SRC_TYPE_JPG;
+#endif
+#if LV_USE_PNG
+    if(strcmp(lower, "png") == 0) return SRC_TYPE_PNG;
+#endif
+    if(strcmp(lower, "bmp") == 0) return SRC_TYPE_BMP;
+
+    return SRC_TYPE_UNKNOWN;
+}
+
+/**
+ * Calculate the size of the thumbnail. Keep the aspect ratio and don't scale up.
+ */
+static void thumb_size_calc(lv_thumb_gen_t * gen, uint32_t src_w, uint32_t src_h)
+{
+    if(src_w >= src_h) {
+        gen->w = LV_MIN(src_w, gen->max_size);
+        gen->h = LV_MAX((src_h * gen->w + src_w / 2) / src_w, 1);
+    }
+    else {
+        gen->h = LV_MIN(src_h, gen->max_size);
+        gen->w = LV_MAX((src_w * gen->h + src_h / 2) / src_h, 1);
+    }
+}
+
+/**
+ * Prepare the box filter. The source rows can be pushed from top to bottom or from bottom to top.
+ */
+static lv_res_t scaler_init(lv_thumb_gen_t * gen, uint32_t src_w, uint32_t src_h)
+{
+    gen->src_w = src_w;
+    gen->src_h = src_h;
+
+    uint32_t buf_size = (uint32_t)gen->w * gen->h * sizeof(uint16_t);
+    gen->buf = lv_mem_alloc(buf_size);
+    LV_ASSERT_MALLOC(gen->buf);
+    gen->acc = lv_mem_alloc(gen->w * 4 * sizeof(uint32_t));
+    LV_ASSERT_MALLOC(gen->acc);
+    if(gen->buf == NULL || gen->acc == NULL) return LV_RES_INV;
+
+    lv_memset_00(gen->buf, buf_size);
+    lv_memset_00(gen->acc, gen->w * 4 * sizeof(uint32_t));
+    gen->acc_y = -1;
+    return LV_RES_OK;
+}
+
+/**
+ * Add a source row to the thumbnail. Source pixel `x` is averaged into the thumbnail pixel `x * w / src_w`.
+ */
+static void scaler_push_row(lv_thumb_gen_t * gen, uint32_t y, const uint8_t * row, px_format_t format)
+{
+    int32_t dy = y * gen->h / gen->src_h;
+    if(dy != gen->acc_y) {
+        scaler_flush(gen);
+        gen->acc_y = dy;
+    }
+
+    uint32_t px_size = format == PX_FORMAT_RGB888 || format == PX_FORMAT_BGR888 ? 3 : 4;
+    uint32_t r_ofs = format == PX_FORMAT_RGB888 || format == PX_FORMAT_RGBA8888 ? 0 : 2;
+    uint32_t b_ofs = 2 - r_ofs;
+    uint32_t * acc = gen->acc;
+    const uint8_t * p = row;
+    uint32_t sx = 0;
+    uint32_t dx;
+    for(dx = 0; dx < gen->w; dx++) {
+        uint32_t sx_end = ((dx + 1) * gen->src_w + gen->w - 1) / gen->w;
+        uint32_t r = 0;
+        uint32_t g = 0;
+        uint32_t b = 0;
+        acc[3] += sx_end - sx;
+        if(format == PX_FORMAT_RGBA8888) {
+            /*Blend on black*/
+            for(; sx < sx_end; sx++) {
+                r += p[0] * p[3] / 255;
+                g += p[1] * p[3] / 255;
+                b += p[2] * p[3] / 255;
+                p += 4;
+            }
+        }
+        else {
+            for(; sx < sx_end; sx++) {
+                r += p[r_ofs];
+                g += p[1];
+                b += p[b_ofs];
+                p += px_size;
+            }
+        }
+        acc[0] += r;
+        acc[1] += g;
+        acc[2] += b;
+        acc += 4;
+    }
+}
+
+/**
+ * Write the averages of the accumulated row to the thumbnail as RGB565
+ */
+static void scaler_flush(lv_thumb_gen_t * gen)
+{
+    if(gen->acc_y < 0) return;
+
+    uint16_t * dest = &gen->buf[gen->acc_y * gen->w];
+    uint32_t * acc = gen->acc;
+    uint32_t dx;
+    for(dx = 0; dx < gen->w; dx++) {
+        uint32_t n = acc[3];
+        if(n) {
+            uint32_t r = (acc[0] + n / 2) / n;
+            uint32_t g = (acc[1] + n / 2) / n;
+            uint32_t b = (acc[2] + n / 2) / n;
+            dest[dx] = (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+        }
+        acc += 4;
+    }
+
+    lv_memset_00(gen->acc, gen->w * 4 * sizeof(uint32_t));
+    gen->acc_y = -1;
+}
+
+static void gen_finish(lv_thumb_gen_t * gen)
+{
+    scaler_flush(gen);
+    gen->done = 1;
+
+    /*Only the thumbnail is required from now*/
+    if(gen->file_opened) lv_fs_close(&gen->file);
+    gen->file_opened = 0;
+    work_free(gen);
+    lv_mem_free(gen->acc);
+    lv_mem_free(gen->row_buf);
+    gen->acc = NULL;
+    gen->row_buf = NULL;
+}
+
+/**
+ * Free the work buffer of the decoder
+ */
+static void work_free(lv_thumb_gen_t * gen)
+{
+    if(gen->work == NULL) return;
+#if LV_USE_PNG
+    if(gen->type == SRC_TYPE_PNG) lv_png_stream_close(gen->work);
+#endif
+    lv_mem_free(gen->work);
+    gen->work = NULL;
+}
+
+#if LV_USE_SJPG
+
+static lv_res_t jpg_start(lv_thumb_gen_t * gen)
+{
+    jpg_work_t * work = lv_mem_alloc(sizeof(jpg_work_t));
+    LV_ASSERT_MALLOC(work);
+    if(work == NULL) return LV_RES_INV;
+    gen->work = work;
+
+    JDEC * jd = &work->jd;
+    if(jd_prepare(jd, jpg_input, work->pool, JPG_POOL_SIZE, gen) != JDR_OK) return LV_RES_INV;
+
+    thumb_size_calc(gen, jd->width, jd->height);
+
+    /*Let TJpgDec scale down by 2, 4 or 8 while the image stays larger than the thumbnail.
+     *It makes the IDCT cheaper or even unnecessary (1/8: only the DC values are used).*/
+    uint8_t scale = 0;
+    while(scale < 3 && (jd->width >> (scale + 1)) >= gen->w && (jd->height >> (scale + 1)) >= gen->h) scale++;
+    jd->scale = scale;
+
+    uint32_t src_w = jd->width >> scale;
+    uint32_t band_h = (jd->msy * 8) >> scale;
+    gen->row_buf = lv_mem_alloc(src_w * band_h * 3);
+    LV_ASSERT_MALLOC(gen->row_buf);
+    if(gen->row_buf == NULL) return LV_RES_INV;
+
+    return scaler_init(gen, src_w, jd->height >> scale);
+}
+
+static lv_res_t jpg_step(lv_thumb_gen_t * gen)
+{
+    jpg_work_t * work = gen->work;
+    JDEC * jd = &work->jd;
+    uint32_t mcu_h = jd->msy * 8;
+    uint32_t y = gen->step_y * mcu_h;
+
+    /*Decode an MCU row into `row_buf`*/
+    work->band_y = y >> jd->scale;
+    if(jd_decomp_row(jd, jpg_output, y, 0, jd->width - 1) != JDR_OK) return LV_RES_INV;
+
+    uint32_t band_h = LV_MIN(mcu_h >> jd->scale, gen->src_h - LV_MIN(work->band_y, gen->src_h));
+    uint32_t i;
+    for(i = 0; i < band_h; i++) {
+        scaler_push_row(gen, work->band_y + i, gen->row_buf + i * gen->src_w * 3, PX_FORMAT_RGB888);
+    }
+
+    gen->step_y++;
+    if(y + mcu_h >= jd->height) gen_finish(gen);
+    return LV_RES_OK;
+}
+
+static size_t jpg_input(JDEC * jd, uint8_t * buf, size_t len)
+{
+    lv_thumb_gen_t * gen = jd->device;
+    if(buf == NULL) {
+        return lv_fs_seek(&gen->file, len, LV_FS_SEEK_CUR) == LV_FS_RES_OK ? len : 0;
+    }
+
+    uint32_t br = 0;
+    lv_fs_read(&gen->file, buf, len, &br);
+    return br;
+}
+
+static int jpg_output(JDEC * jd, void * data, JRECT * rect)
+{
+    lv_thumb_gen_t * gen = jd->device;
+    jpg_work_t * work = gen->work;
+    const uint8_t * src = data;
+    uint32_t w = (rect->right - rect->left + 1) * 3;
+    uint32_t y;
+    for(y = rect->top; y <= rect->bottom; y++) {
+        lv_memcpy(gen->row_buf + ((y - work->band_y) * gen->src_w + rect->left) * 3, src, w);
+        src += w;
+    }
+
+    return 1;
+}
+
+#endif /*LV_USE_SJPG*/
+
+#if LV_USE_PNG
+
+static lv_res_t png_start(lv_thumb_gen_t * gen, const char * path)
+{
+    lv_png_stream_t * stream = lv_mem_alloc(sizeof(lv_png_stream_t));
+    LV_ASSERT_MALLOC(stream);
+    if(stream == NULL) return LV_RES_INV;
+    if(lv_png_stream_open(stream, path) != LV_RES_OK) {
+        lv_mem_free(stream);
+        return LV_RES_INV;
+    }
+    gen->work = stream;
+
+    gen->row_buf = lv_mem_alloc(stream->w * 4);
+    LV_ASSERT_MALLOC(gen->row_buf);
+    if(gen->row_buf == NULL) return LV_RES_INV;
+
+    thumb_size_calc(gen, stream->w, stream->h);
+    return scaler_init(gen, stream->w, stream->h);
+}
+
+static lv_res_t png_step(lv_thumb_gen_t * gen)
+{
+    lv_png_stream_t * stream = gen->work;
+    uint32_t i;
+    for(i = 0; i < PNG_ROWS_PER_STEP && gen->step_y < gen->src_h; i++) {
+        if(lv_png_stream_read_row(stream, gen->step_y) != LV_RES_OK) return LV_RES_INV;
+        lv_png_stream_get_rgba(stream, 0, stream->w, gen->row_buf);
+        scaler_push_row(gen, gen->step_y, gen->row_buf, PX_FORMAT_RGBA8888);
+        gen->step_y++;
+    }
+
+    if(gen->step_y >= gen->src_h) gen_finish(gen);
+    return LV_RES_OK;
+}
+
+#endif /*LV_USE_PNG*/
+
+static lv_res_t bmp_start(lv_thumb_gen_t * gen)
+{
+    uint8_t head[54];
+    uint32_t br = 0;
+    lv_fs_read(&gen->file, head, sizeof(head), &br);
+    if(br != sizeof(head) || head[0] != 'B' || head[1] != 'M') return LV_RES_INV;
+
+    uint32_t data_ofs = get_u32_le(&head[10]);
+    int32_t src_w = (int32_t)get_u32_le(&head[18]);
+    int32_t src_h = (int32_t)get_u32_le(&head[22]);
+    uint32_t bpp = head[28] | (head[29] << 8);
+    uint32_t compression = get_u32_le(&head[30]);
+
+    /*Only uncompressed 24 and 32 bit images (32 bit bitfields are assumed to be BGRX)*/
+    if(bpp != 24 && bpp != 32) return LV_RES_INV;
+    if(compression != 0 && !(compression == 3 && bpp == 32)) return LV_RES_INV;
+    if(src_w <= 0 || src_h == 0 || src_w > UINT16_MAX || LV_ABS(src_h) > UINT16_MAX) return LV_RES_INV;
+
+    gen->bmp_bottom_up = src_h > 0;
+    if(src_h < 0) src_h = -src_h;
+    gen->bmp_px_size = bpp / 8;
+    gen->bmp_row_size = (src_w * gen->bmp_px_size + 3) & ~3;
+    gen->bmp_data_ofs = data_ofs;
+    if(lv_fs_seek(&gen->file, data_ofs, LV_FS_SEEK_SET) != LV_FS_RES_OK) return LV_RES_INV;
+
+    gen->row_buf = lv_mem_alloc(gen->bmp_row_size);
+    LV_ASSERT_MALLOC(gen->row_buf);
+    if(gen->row_buf == NULL) return LV_RES_INV;
+
+    thumb_size_calc(gen, src_w, src_h);
+    return scaler_init(gen, src_w, src_h);
+}
+
+static lv_res_t bmp_step(lv_thumb_gen_t * gen)
+{
+    px_format_t format = gen->bmp_px_size == 3 ? PX_FORMAT_BGR888 : PX_FORMAT_BGRX8888;
+    uint32_t i;
+    for(i = 0; i < BMP_ROWS_PER_STEP && gen->step_y < gen->src_h; i++) {
+        uint32_t br = 0;
+        lv_fs_read(&gen->file, gen->row_buf, gen->bmp_row_size, &br);
+        if(br != gen->bmp_row_size) return LV_RES_INV;
+
+        uint32_t y = gen->bmp_bottom_up ? gen->src_h - 1 - gen->step_y : gen->step_y;
+        scaler_push_row(gen, y, gen->row_buf, format);
+        gen->step_y++;
+    }
+
+    if(gen->step_y >= gen->src_h) gen_finish(gen);
+    return LV_RES_OK;
+}
+
+static bool pack_load_index(lv_thumb_pack_t * pack)
+{
+    pack_header_t header;
+    uint32_t br = 0;
+    lv_fs_read(&pack->file, &header, sizeof(header), &br);
+    if(br != sizeof(header)) return false;
+    if(header.magic != PACK_MAGIC || header.version != PACK_VERSION || header.max_size != pack->max_size) return false;
+    if(header.index_ofs < sizeof(header) || header.entry_cnt > UINT16_MAX) return false;
+
+    uint32_t index_size = header.entry_cnt * sizeof(lv_thumb_entry_t);
+    if(index_size) {
+        pack->entries = lv_mem_alloc(index_size);
+        LV_ASSERT_MALLOC(pack->entries);
+        if(pack->entries == NULL) return false;
+
+        if(lv_fs_seek(&pack->file, header.index_ofs, LV_FS_SEEK_SET) != LV_FS_RES_OK) return false;
+        lv_fs_read(&pack->file, pack->entries, index_size, &br);
+        if(br != index_size) return false;
+    }
+    if(hash_calc(pack->entries, index_size) != header.index_hash) return false;
+
+    pack->entry_cnt = header.entry_cnt;
+    pack->data_end = header.index_ofs;
+    return true;
+}
+
+/**
+ * Binary search of a name hash
+ * @return the index of the entry or `-(insert position) - 1` if not found
+ */
+static int32_t pack_search(const lv_thumb_pack_t * pack, uint32_t hash)
+{
+    int32_t min = 0;
+    int32_t max = (int32_t)pack->entry_cnt - 1;
+    while(min <= max) {
+        int32_t mid = (min + max) / 2;
+        uint32_t mid_hash = pack->entries[mid].name_hash;
+        if(mid_hash == hash) return mid;
+        if(mid_hash < hash) min = mid + 1;
+        else max = mid - 1;
+    }
+
+    return -min - 1;
+}
+
+/**
+ * FNV-1a hash
+ */
+static uint32_t hash_calc(const void * data, uint32_t size)
+{
+    const uint8_t * d = data;
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        hash ^= d[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static uint32_t get_u32_le(const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+#endif /*LV_USE_THUMB*/
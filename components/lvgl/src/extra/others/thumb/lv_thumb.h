@@ -0,0 +1,191 @@
+/**
+ * @file lv_thumb.h
+ *
+ */
+
+#ifndef LV_THUMB_H
+#define LV_THUMB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lv_conf_internal.h"
+#include "../../../misc/lv_fs.h"
+#include "../../../draw/lv_img_buf.h"
+
+#if LV_USE_THUMB
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A thumbnail in a pack file
+ */
+typedef struct {
+    uint32_t name_hash;     /*Hash of the file name*/
+    uint32_t src_size;      /*Size of the source file when the thumbnail was made*/
+    uint32_t data_ofs;      /*Offset of the RGB565 pixels in the pack file*/
+    uint16_t w;
+    uint16_t h;
+} lv_thumb_entry_t;
+
+/**
+ * The thumbnails of a directory stored in one file.
+ * The index of the thumbnails is kept in the RAM.
+ */
+typedef struct {
+    lv_fs_file_t file;
+    lv_thumb_entry_t * entries; /*Sorted by `name_hash`*/
+    uint32_t entry_cnt;
+    uint32_t data_end;          /*The end of the thumbnail data. The index is written here.*/
+    uint16_t max_size;
+    uint8_t opened : 1;
+    uint8_t writable : 1;
+    uint8_t dirty : 1;          /*The index needs to be written*/
+} lv_thumb_pack_t;
+
+/**
+ * Generate a thumbnail from an image file step by step
+ */
+typedef struct {
+    lv_fs_file_t file;
+    uint32_t src_w;             /*Size of the source image (after JPEG scaling)*/
+    uint32_t src_h;
+    uint16_t w;                 /*Size of the thumbnail*/
+    uint16_t h;
+    uint16_t max_size;
+    uint16_t * buf;             /*The RGB565 pixels of the thumbnail*/
+    uint32_t * acc;             /*R, G, B sums and pixel counts of a row of the thumbnail*/
+    int32_t acc_y;              /*The row of the thumbnail in `acc` or -1*/
+    uint8_t * row_buf;          /*Decoded source rows*/
+    void * work;                /*Work buffer of the decoder*/
+    uint32_t step_y;            /*The next source row or MCU row to process*/
+    uint32_t bmp_data_ofs;
+    uint32_t bmp_row_size;
+    uint8_t bmp_px_size;
+    uint8_t bmp_bottom_up : 1;
+    uint8_t type : 3;
+    uint8_t file_opened : 1;
+    uint8_t done : 1;
+} lv_thumb_gen_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Check whether a thumbnail can be generated from a file
+ * @param fn        name or path of the file
+ * @return          true: the file type is supported
+ */
+bool lv_thumb_is_supported(const char * fn);
+
+/**
+ * Start to generate a thumbnail. `gen->w` and `gen->h` are valid after this call.
+ * @param gen       pointer to a thumbnail generator
+ * @param path      path of the image file, e.g. "S:/photos/beach.jpg"
+ * @param max_size  the thumbnail will fit into a `max_size` x `max_size` square
+ * @return          LV_RES_OK: the generation has started; LV_RES_INV: the file can't be read
+ */
+lv_res_t lv_thumb_gen_start(lv_thumb_gen_t * gen, const char * path, uint16_t max_size);
+
+/**
+ * Do a small step of the thumbnail generation, e.g. decode an MCU row of a JPEG.
+ * `gen->done` is set when the thumbnail is ready.
+ * @param gen       pointer to a started thumbnail generator
+ * @return          LV_RES_OK: ok; LV_RES_INV: decoding error
+ */
+lv_res_t lv_thumb_gen_step(lv_thumb_gen_t * gen);
+
+/**
+ * Free the resources of a thumbnail generator
+ * @param gen       pointer to a thumbnail generator
+ */
+void lv_thumb_gen_end(lv_thumb_gen_t * gen);
+
+/**
+ * Generate a thumbnail in one go. Free it with `lv_thumb_gen_end`.
+ * @param gen       pointer to a thumbnail generator
+ * @param path      path of the image file
+ * @param max_size  the thumbnail will fit into a `max_size` x `max_size` square
+ * @return          LV_RES_OK: `gen->buf` contains the thumbnail; LV_RES_INV: error
+ */
+lv_res_t lv_thumb_generate(lv_thumb_gen_t * gen, const char * path, uint16_t max_size);
+
+/**
+ * Open or create a thumbnail pack file and load its index.
+ * If the file is invalid or was made for an other `max_size` the pack starts empty.
+ * @param pack      pointer to a thumbnail pack
+ * @param path      path of the pack file, e.g. "S:/photos/.thumbs"
+ * @param max_size  size of the thumbnails
+ * @return          LV_RES_OK: the pack is opened; LV_RES_INV: the file can't be opened
+ */
+lv_res_t lv_thumb_pack_open(lv_thumb_pack_t * pack, const char * path, uint16_t max_size);
+
+/**
+ * Write the index if changed and close the pack file
+ * @param pack      pointer to a thumbnail pack
+ */
+void lv_thumb_pack_close(lv_thumb_pack_t * pack);
+
+/**
+ * Write the index of the pack if it was changed
+ * @param pack      pointer to a thumbnail pack
+ * @return          LV_RES_OK: ok; LV_RES_INV: write error
+ */
+lv_res_t lv_thumb_pack_flush(lv_thumb_pack_t * pack);
+
+/**
+ * Find the thumbnail of a file
+ * @param pack      pointer to a thumbnail pack
+ * @param name      name of the file in the directory
+ * @param src_size  the current size of the file
+ * @return          the thumbnail or NULL if not found or the file has changed
+ */
+const lv_thumb_entry_t * lv_thumb_pack_find(const lv_thumb_pack_t * pack, const char * name, uint32_t src_size);
+
+/**
+ * Load a thumbnail from the pack as an image with `LV_IMG_CF_TRUE_COLOR` format
+ * @param pack      pointer to a thumbnail pack
+ * @param entry     a thumbnail returned by `lv_thumb_pack_find`
+ * @return          the image or NULL on error. Free it with `lv_thumb_free`.
+ */
+lv_img_dsc_t * lv_thumb_pack_load(lv_thumb_pack_t * pack, const lv_thumb_entry_t * entry);
+
+/**
+ * Add a generated thumbnail to the pack or replace the old thumbnail of the file
+ * @param pack      pointer to a thumbnail pack
+ * @param name      name of the file in the directory
+ * @param src_size  size of the file
+ * @param gen       a generator with a finished thumbnail
+ * @return          LV_RES_OK: ok; LV_RES_INV: write error
+ */
+lv_res_t lv_thumb_pack_add(lv_thumb_pack_t * pack, const char * name, uint32_t src_size, const lv_thumb_gen_t * gen);
+
+/**
+ * Free an image loaded by `lv_thumb_pack_load`.
+ * Set an other source on the images which use it first.
+ * @param dsc       pointer to the image
+ */
+void lv_thumb_free(lv_img_dsc_t * dsc);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_THUMB*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_THUMB_H*/
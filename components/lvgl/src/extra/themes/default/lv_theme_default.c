@@ -639,6 +639,15 @@ static void style_init(void)
     lv_style_set_shadow_color(&styles->led, lv_color_white());
     lv_style_set_shadow_spread(&styles->led, lv_disp_dpx(theme.disp, 5));
 #endif
+
+    /*All the styles are set: sort their properties for faster lookups.
+     *`my_theme_styles_t` contains only `lv_style_t`s so it can be handled as an array.
+     *A few styles are never initialized (they are zeroed on allocation) so skip them.*/
+    lv_style_t * style_array = (lv_style_t *)styles;
+    uint32_t i;
+    for(i = 0; i < sizeof(my_theme_styles_t) / sizeof(lv_style_t); i++) {
+        if(style_array[i].prop_cnt > 1) lv_style_freeze(&style_array[i]);
+    }
 }
 
 /**********************
@@ -656,6 +665,7 @@ lv_theme_t * lv_theme_default_init(lv_disp_t * disp, lv_color_t color_primary, l
         inited = false;
         LV_GC_ROOT(_lv_theme_default_styles) = lv_mem_alloc(sizeof(my_theme_styles_t));
         styles = (my_theme_styles_t *)LV_GC_ROOT(_lv_theme_default_styles);
+        lv_memset_00(styles, sizeof(my_theme_styles_t));
     }
 
     if(LV_HOR_RES <= 320) disp_size = DISP_SMALL;
@@ -50,6 +50,10 @@ const lv_obj_class_t lv_chart_class = {
     .constructor_cb = lv_chart_constructor,
     .destructor_cb = lv_chart_destructor,
     .event_cb = lv_chart_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) | LV_EVENT_BIT(LV_EVENT_GET_SELF_SIZE) |
+                  LV_EVENT_BIT(LV_EVENT_PRESSED) | LV_EVENT_BIT(LV_EVENT_REFR_EXT_DRAW_SIZE) |
+                  LV_EVENT_BIT(LV_EVENT_RELEASED) | LV_EVENT_BIT(LV_EVENT_SIZE_CHANGED) |
+                  LV_EVENT_BIT(LV_EVENT_VALUE_CHANGED),
     .width_def = LV_PCT(100),
     .height_def = LV_DPI_DEF * 2,
     .instance_size = sizeof(lv_chart_t),
@@ -54,6 +54,15 @@ static uint16_t get_angle(lv_obj_t * obj);
 const lv_obj_class_t lv_colorwheel_class = {.instance_size = sizeof(lv_colorwheel_t), .base_class = &lv_obj_class,
                                             .constructor_cb = lv_colorwheel_constructor,
                                             .event_cb = lv_colorwheel_event,
+                                            .event_mask = LV_EVENT_BIT(LV_EVENT_COVER_CHECK) |
+                                                          LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) |
+                                                          LV_EVENT_BIT(LV_EVENT_HIT_TEST) | LV_EVENT_BIT(LV_EVENT_KEY) |
+                                                          LV_EVENT_BIT(LV_EVENT_PRESSED) |
+                                                          LV_EVENT_BIT(LV_EVENT_PRESSING) |
+                                                          LV_EVENT_BIT(LV_EVENT_REFR_EXT_DRAW_SIZE) |
+                                                          LV_EVENT_BIT(LV_EVENT_SIZE_CHANGED) |
+                                                          LV_EVENT_BIT(LV_EVENT_STYLE_CHANGED) |
+                                                          LV_EVENT_BIT(LV_EVENT_VALUE_CHANGED),
                                             .width_def = LV_DPI_DEF * 2,
                                             .height_def = LV_DPI_DEF * 2,
                                             .editable = LV_OBJ_CLASS_EDITABLE_TRUE,
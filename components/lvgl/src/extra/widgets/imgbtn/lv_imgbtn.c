@@ -38,6 +38,10 @@ const lv_obj_class_t lv_imgbtn_class = {
     .instance_size = sizeof(lv_imgbtn_t),
     .constructor_cb = lv_imgbtn_constructor,
     .event_cb = lv_imgbtn_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_COVER_CHECK) | LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) |
+                  LV_EVENT_BIT(LV_EVENT_GET_SELF_SIZE) | LV_EVENT_BIT(LV_EVENT_PRESSED) |
+                  LV_EVENT_BIT(LV_EVENT_PRESS_LOST) | LV_EVENT_BIT(LV_EVENT_RELEASED) |
+                  LV_EVENT_BIT(LV_EVENT_VALUE_CHANGED),
 };
 
 /**********************
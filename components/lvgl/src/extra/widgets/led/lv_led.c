@@ -35,6 +35,8 @@ const lv_obj_class_t lv_led_class  = {
     .width_def = LV_DPI_DEF / 5,
     .height_def = LV_DPI_DEF / 5,
     .event_cb = lv_led_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) | LV_EVENT_BIT(LV_EVENT_DRAW_MAIN_END) |
+                  LV_EVENT_BIT(LV_EVENT_DRAW_PART_BEGIN) | LV_EVENT_BIT(LV_EVENT_DRAW_PART_END),
     .instance_size = sizeof(lv_led_t),
 };
 
@@ -73,6 +73,8 @@ const lv_obj_class_t lv_spangroup_class  = {
     .constructor_cb = lv_spangroup_constructor,
     .destructor_cb = lv_spangroup_destructor,
     .event_cb = lv_spangroup_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) | LV_EVENT_BIT(LV_EVENT_GET_SELF_SIZE) |
+                  LV_EVENT_BIT(LV_EVENT_SIZE_CHANGED) | LV_EVENT_BIT(LV_EVENT_STYLE_CHANGED),
     .instance_size = sizeof(lv_spangroup_t),
     .width_def = LV_SIZE_CONTENT,
     .height_def = LV_SIZE_CONTENT,
@@ -34,6 +34,7 @@ static void lv_spinbox_updatevalue(lv_obj_t * obj);
 const lv_obj_class_t lv_spinbox_class = {
     .constructor_cb = lv_spinbox_constructor,
     .event_cb = lv_spinbox_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_KEY) | LV_EVENT_BIT(LV_EVENT_RELEASED),
     .width_def = LV_DPI_DEF,
     .instance_size = sizeof(lv_spinbox_t),
     .editable = LV_OBJ_CLASS_EDITABLE_TRUE,
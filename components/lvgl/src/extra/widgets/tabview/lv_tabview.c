@@ -36,6 +36,7 @@ const lv_obj_class_t lv_tabview_class = {
     .constructor_cb = lv_tabview_constructor,
     .destructor_cb = lv_tabview_destructor,
     .event_cb = lv_tabview_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_SIZE_CHANGED),
     .width_def = LV_PCT(100),
     .height_def = LV_PCT(100),
     .base_class = &lv_obj_class,
@@ -8,6 +8,7 @@
  *********************/
 
 #include "lv_font.h"
+#include "lv_font_fmt_txt.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
@@ -141,6 +142,29 @@ uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32
     return g.adv_w;
 }
 
+/**
+ * Get the width of several glyphs with kerning.
+ * Faster than calling `lv_font_get_glyph_width()` for each letter.
+ * @param font      pointer to a font
+ * @param letters   `cnt` UNICODE letters followed by the letter after them (used for kerning)
+ * @param widths    store the widths of the `cnt` glyphs here
+ * @param cnt       number of glyphs
+ */
+void lv_font_get_glyph_widths(const lv_font_t * font, const uint32_t * letters, uint16_t * widths, uint32_t cnt)
+{
+    LV_ASSERT_NULL(font);
+
+    if(font->get_glyph_dsc == lv_font_get_glyph_dsc_fmt_txt) {
+        _lv_font_get_glyph_widths_fmt_txt(font, letters, widths, cnt);
+        return;
+    }
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        widths[i] = lv_font_get_glyph_width(font, letters[i], letters[i + 1]);
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
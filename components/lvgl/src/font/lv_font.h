@@ -116,6 +116,16 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
  */
 uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32_t letter_next);
 
+/**
+ * Get the width of several glyphs with kerning.
+ * Faster than calling `lv_font_get_glyph_width()` for each letter.
+ * @param font      pointer to a font
+ * @param letters   `cnt` UNICODE letters followed by the letter after them (used for kerning)
+ * @param widths    store the widths of the `cnt` glyphs here
+ * @param cnt       number of glyphs
+ */
+void lv_font_get_glyph_widths(const lv_font_t * font, const uint32_t * letters, uint16_t * widths, uint32_t cnt);
+
 /**
  * Get the line height of a font. All characters fit into this height
  * @param font_p pointer to a font
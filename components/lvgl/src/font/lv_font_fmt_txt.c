@@ -14,10 +14,13 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_mem.h"
+#include "../misc/lv_math.h"
 
 /*********************
  *      DEFINES
  *********************/
+/*Max number of glyphs measured at once by `_lv_font_get_glyph_widths_fmt_txt()`*/
+#define GLYPH_WIDTHS_CHUNK 32
 
 /**********************
  *      TYPEDEFS
@@ -32,8 +35,11 @@ typedef enum {
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+#if LV_FONT_FMT_TXT_ASCII_CACHE
+    static bool ascii_cache_ready(const lv_font_t * font);
+#endif
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
-static int32_t unicode_list_compare(const void * ref, const void * element);
+static inline int32_t unicode_list_find(const uint16_t * list, uint16_t list_length, uint32_t rcp);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
 
@@ -95,25 +101,8 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
         static size_t last_buf_size = 0;
         if(LV_GC_ROOT(_lv_font_decompr_buf) == NULL) last_buf_size = 0;
 
-        uint32_t gsize = gdsc->box_w * gdsc->box_h;
-        if(gsize == 0) return NULL;
-
-        uint32_t buf_size = gsize;
-        /*Compute memory size needed to hold decompressed glyph, rounding up*/
-        switch(fdsc->bpp) {
-            case 1:
-                buf_size = (gsize + 7) >> 3;
-                break;
-            case 2:
-                buf_size = (gsize + 3) >> 2;
-                break;
-            case 3:
-                buf_size = (gsize + 1) >> 1;
-                break;
-            case 4:
-                buf_size = (gsize + 1) >> 1;
-                break;
-        }
+        uint32_t buf_size = _lv_font_fmt_txt_get_decompressed_size(font, gdsc);
+        if(buf_size == 0) return NULL;
 
         if(last_buf_size < buf_size) {
             uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
@@ -123,9 +112,8 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
             last_buf_size = buf_size;
         }
 
-        bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
-                   (uint8_t)fdsc->bpp, prefilter);
+        _lv_font_fmt_txt_decompress_glyph(font, gdsc, &fdsc->glyph_bitmap[gdsc->bitmap_index],
+                                          LV_GC_ROOT(_lv_font_decompr_buf));
         return LV_GC_ROOT(_lv_font_decompr_buf);
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
@@ -189,6 +177,124 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+/**
+ * Get the width of several glyphs with kerning.
+ * Used by `lv_font_get_glyph_widths()` if the font is in LVGL's native format.
+ * @param font      pointer to font
+ * @param letters   `cnt` UNICODE letters followed by the letter after them (used for kerning)
+ * @param widths    store the widths of the `cnt` glyphs here
+ * @param cnt       number of glyphs
+ */
+void _lv_font_get_glyph_widths_fmt_txt(const lv_font_t * font, const uint32_t * letters, uint16_t * widths,
+                                       uint32_t cnt)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+#if LV_FONT_FMT_TXT_ASCII_CACHE
+    bool ascii_cache = ascii_cache_ready(font);
+#endif
+    uint32_t gids[GLYPH_WIDTHS_CHUNK + 1];
+    uint32_t adv_w[GLYPH_WIDTHS_CHUNK];
+
+    while(cnt > 0) {
+        uint32_t n = LV_MIN(cnt, GLYPH_WIDTHS_CHUNK);
+        uint32_t i;
+
+        /*Find the glyph of each letter only once (and not again as the next letter for kerning).
+         *The glyph of the letter after the last one is required only for kerning.*/
+        uint32_t gid_cnt = fdsc->kern_dsc ? n + 1 : n;
+        for(i = 0; i < gid_cnt; i++) {
+#if LV_FONT_FMT_TXT_ASCII_CACHE
+            uint32_t ascii_id = letters[i] - 0x20;
+            if(ascii_cache && ascii_id < LV_FONT_FMT_TXT_ASCII_CNT) {
+                gids[i] = fdsc->cache->ascii_glyph_id[ascii_id];
+                if(i < n) adv_w[i] = fdsc->cache->ascii_adv_w[ascii_id];
+                continue;
+            }
+#endif
+            gids[i] = get_glyph_dsc_id(font, letters[i]);
+            if(i < n && gids[i]) adv_w[i] = fdsc->glyph_dsc[gids[i]].adv_w;
+        }
+
+        /*Add the kerning in a second pass*/
+        if(fdsc->kern_dsc) {
+            for(i = 0; i < n; i++) {
+                if(gids[i] && gids[i + 1]) {
+                    int8_t kvalue = get_kern_value(font, gids[i], gids[i + 1]);
+                    adv_w[i] += ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
+                }
+            }
+        }
+
+        for(i = 0; i < n; i++) {
+            /*Let the fallback fonts or the placeholder handle the missing glyphs. Tabs are special too.*/
+            if(gids[i] == 0 || letters[i] == '\t') {
+                widths[i] = lv_font_get_glyph_width(font, letters[i], letters[i + 1]);
+            }
+            else {
+                widths[i] = (adv_w[i] + (1 << 3)) >> 4;
+            }
+        }
+
+        letters += n;
+        widths += n;
+        cnt -= n;
+    }
+}
+
+/**
+ * Get the glyph ID of a letter in a font in LVGL's native format.
+ * @param font      pointer to font
+ * @param letter    a UNICODE letter
+ * @return          index of the glyph in `glyph_dsc` or 0 if the font has no glyph for the letter
+ */
+uint32_t _lv_font_fmt_txt_get_glyph_id(const lv_font_t * font, uint32_t letter)
+{
+    return get_glyph_dsc_id(font, letter);
+}
+
+#if LV_USE_FONT_COMPRESSED
+/**
+ * Get the size of a glyph's bitmap after decompression.
+ * @param font      pointer to a compressed font
+ * @param gdsc      descriptor of the glyph
+ * @return          size of the decompressed bitmap in bytes
+ */
+uint32_t _lv_font_fmt_txt_get_decompressed_size(const lv_font_t * font, const lv_font_fmt_txt_glyph_dsc_t * gdsc)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    uint32_t gsize = gdsc->box_w * gdsc->box_h;
+
+    /*Compute memory size needed to hold decompressed glyph, rounding up*/
+    switch(fdsc->bpp) {
+        case 1:
+            return (gsize + 7) >> 3;
+        case 2:
+            return (gsize + 3) >> 2;
+        case 3:
+            return (gsize + 1) >> 1;
+        case 4:
+            return (gsize + 1) >> 1;
+        default:
+            return gsize;
+    }
+}
+
+/**
+ * Decompress the bitmap of a glyph.
+ * @param font      pointer to a compressed font
+ * @param gdsc      descriptor of the glyph
+ * @param in        the compressed bitmap
+ * @param out       store the decompressed bitmap here. Must have `_lv_font_fmt_txt_get_decompressed_size()` bytes.
+ */
+void _lv_font_fmt_txt_decompress_glyph(const lv_font_t * font, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                       const uint8_t * in, uint8_t * out)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+    decompress(in, out, gdsc->box_w, gdsc->box_h, (uint8_t)fdsc->bpp, prefilter);
+}
+#endif /*LV_USE_FONT_COMPRESSED*/
+
 /**
  * Free the allocated memories.
  */
@@ -230,22 +336,14 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_8[rcp];
         }
         else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
-            uint16_t key = rcp;
-            uint16_t * p = _lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                             sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
-
-            if(p) {
-                lv_uintptr_t ofs = p - fdsc->cmaps[i].unicode_list;
+            int32_t ofs = unicode_list_find(fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length, rcp);
+            if(ofs >= 0) {
                 glyph_id = fdsc->cmaps[i].glyph_id_start + ofs;
             }
         }
         else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
-            uint16_t key = rcp;
-            uint16_t * p = _lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
-                                             sizeof(fdsc->cmaps[i].unicode_list[0]), unicode_list_compare);
-
-            if(p) {
-                lv_uintptr_t ofs = p - fdsc->cmaps[i].unicode_list;
+            int32_t ofs = unicode_list_find(fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length, rcp);
+            if(ofs >= 0) {
                 const uint16_t * gid_ofs_16 = fdsc->cmaps[i].glyph_id_ofs_list;
                 glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_16[ofs];
             }
@@ -267,6 +365,36 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
 }
 
+#if LV_FONT_FMT_TXT_ASCII_CACHE
+/**
+ * Fill the ASCII glyph IDs and widths in the font's cache if not filled yet
+ * @param font      pointer to font
+ * @return          true: the ASCII cache can be used
+ */
+static bool ascii_cache_ready(const lv_font_t * font)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->cache;
+    if(cache == NULL) return false;
+
+    if(cache->ascii_state == 0) {
+        uint32_t i;
+        for(i = 0; i < LV_FONT_FMT_TXT_ASCII_CNT; i++) {
+            uint32_t gid = get_glyph_dsc_id(font, 0x20 + i);
+            if(gid > UINT16_MAX) {
+                cache->ascii_state = 2;
+                return false;
+            }
+            cache->ascii_glyph_id[i] = gid;
+            cache->ascii_adv_w[i] = gid ? fdsc->glyph_dsc[gid].adv_w : 0;
+        }
+        cache->ascii_state = 1;
+    }
+
+    return cache->ascii_state == 1;
+}
+#endif
+
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
@@ -575,20 +703,25 @@ static inline uint8_t rle_next(void)
 }
 #endif /*LV_USE_FONT_COMPRESSED*/
 
-/** Code Comparator.
- *
- *  Compares the value of both input arguments.
- *
- *  @param[in]  pRef        Pointer to the reference.
- *  @param[in]  pElement    Pointer to the element to compare.
- *
- *  @return Result of comparison.
- *  @retval < 0   Reference is less than element.
- *  @retval = 0   Reference is equal to element.
- *  @retval > 0   Reference is greater than element.
- *
+/**
+ * Find a relative code point in the sorted `unicode_list` of a sparse cmap.
+ * Called for every glyph lookup so it's done inline instead of `_lv_utils_bsearch()` with a compare callback.
+ * @param list          the unicode list of the cmap
+ * @param list_length   number of elements in the list
+ * @param rcp           the relative code point to find
+ * @return              index of `rcp` in the list or -1 if not found
  */
-static int32_t unicode_list_compare(const void * ref, const void * element)
+static inline int32_t unicode_list_find(const uint16_t * list, uint16_t list_length, uint32_t rcp)
 {
-    return ((int32_t)(*(uint16_t *)ref)) - ((int32_t)(*(uint16_t *)element));
+    if(rcp > UINT16_MAX) return -1;
+
+    int32_t min = 0;
+    int32_t max = (int32_t)list_length - 1;
+    while(min <= max) {
+        int32_t mid = (min + max) >> 1;
+        if(list[mid] < rcp) min = mid + 1;
+        else if(list[mid] > rcp) max = mid - 1;
+        else return mid;
+    }
+    return -1;
 }
@@ -22,6 +22,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Number of printable ASCII characters (0x20..0x7E)*/
+#define LV_FONT_FMT_TXT_ASCII_CNT 95
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -154,6 +157,13 @@ typedef enum {
 typedef struct {
     uint32_t last_letter;
     uint32_t last_glyph_id;
+#if LV_FONT_FMT_TXT_ASCII_CACHE
+    /*Glyph ID and advance width (12.4 format) of the printable ASCII characters (0x20..0x7E).
+     *Filled when a text is measured with the font first.*/
+    uint16_t ascii_glyph_id[LV_FONT_FMT_TXT_ASCII_CNT];
+    uint16_t ascii_adv_w[LV_FONT_FMT_TXT_ASCII_CNT];
+    uint8_t ascii_state;    /*0: not filled yet, 1: filled, 2: not used because of too large glyph IDs*/
+#endif
 } lv_font_fmt_txt_glyph_cache_t;
 
 /*Describe store additional data for fonts*/
@@ -220,6 +230,45 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t lett
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Get the width of several glyphs with kerning.
+ * Used by `lv_font_get_glyph_widths()` if the font is in LVGL's native format.
+ * @param font      pointer to font
+ * @param letters   `cnt` UNICODE letters followed by the letter after them (used for kerning)
+ * @param widths    store the widths of the `cnt` glyphs here
+ * @param cnt       number of glyphs
+ */
+void _lv_font_get_glyph_widths_fmt_txt(const lv_font_t * font, const uint32_t * letters, uint16_t * widths,
+                                       uint32_t cnt);
+
+/**
+ * Get the glyph ID of a letter in a font in LVGL's native format.
+ * @param font      pointer to font
+ * @param letter    a UNICODE letter
+ * @return          index of the glyph in `glyph_dsc` or 0 if the font has no glyph for the letter
+ */
+uint32_t _lv_font_fmt_txt_get_glyph_id(const lv_font_t * font, uint32_t letter);
+
+#if LV_USE_FONT_COMPRESSED
+/**
+ * Get the size of a glyph's bitmap after decompression.
+ * @param font      pointer to a compressed font
+ * @param gdsc      descriptor of the glyph
+ * @return          size of the decompressed bitmap in bytes
+ */
+uint32_t _lv_font_fmt_txt_get_decompressed_size(const lv_font_t * font, const lv_font_fmt_txt_glyph_dsc_t * gdsc);
+
+/**
+ * Decompress the bitmap of a glyph.
+ * @param font      pointer to a compressed font
+ * @param gdsc      descriptor of the glyph
+ * @param in        the compressed bitmap
+ * @param out       store the decompressed bitmap here. Must have `_lv_font_fmt_txt_get_decompressed_size()` bytes.
+ */
+void _lv_font_fmt_txt_decompress_glyph(const lv_font_t * font, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                       const uint8_t * in, uint8_t * out);
+#endif
+
 /**
  * Free the allocated memories.
  */
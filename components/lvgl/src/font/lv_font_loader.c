@@ -12,6 +12,7 @@
 
 #include "../lvgl.h"
 #include "../misc/lv_fs.h"
+#include "../misc/lv_lru.h"
 #include "lv_font_loader.h"
 
 /**********************
@@ -60,11 +61,29 @@ typedef struct cmap_table_bin {
     uint8_t padding;
 } cmap_table_bin_t;
 
+/*Descriptor of a font loaded by `lv_font_load_streamed()`*/
+typedef struct {
+    lv_font_fmt_txt_dsc_t fmt_dsc;              /*Must be the first to use the font as a font in LVGL's format*/
+    lv_font_fmt_txt_glyph_cache_t glyph_cache;
+    lv_fs_file_t file;                          /*The font file which is kept open to read the bitmaps*/
+    uint32_t glyf_start;                        /*Start of the "glyf" table in the file*/
+    uint32_t glyf_length;                       /*Length of the "glyf" table*/
+    uint32_t glyph_cnt;
+    uint8_t metrics_bits;                       /*Bits of the metrics before the bitmap of each glyph*/
+    lv_lru_t * bitmap_cache;                    /*Glyph ID -> bitmap*/
+} streamed_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool streamed);
+static bool read_glyph_bitmap(lv_fs_file_t * fp, uint32_t glyph_pos, uint32_t metrics_bits, uint32_t bmp_size,
+                              uint8_t * out);
+static const uint8_t * get_bitmap_streamed(const lv_font_t * font, uint32_t unicode_letter);
+static const uint8_t * load_glyph_bitmap(const lv_font_t * font, uint32_t gid);
+static uint32_t get_glyph_bitmap_size(const lv_font_t * font, uint32_t gid, uint32_t * file_size);
+static void prefetch_ascii(const lv_font_t * font);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
@@ -93,7 +112,7 @@ lv_font_t * lv_font_load(const char * font_name)
     lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
     if(font) {
         memset(font, 0, sizeof(lv_font_t));
-        if(!lvgl_load_font(&file, font)) {
+        if(!lvgl_load_font(&file, font, false)) {
             LV_LOG_WARN("Error loading font file: %s\n", font_name);
             /*
             * When `lvgl_load_font` fails it can leak some pointers.
@@ -111,7 +130,63 @@ lv_font_t * lv_font_load(const char * font_name)
 }
 
 /**
- * Frees the memory allocated by the `lv_font_load()` function
+ * Loads a `lv_font_t` object from a binary font file but keeps only the character maps,
+ * the metrics of the glyphs and the kerning in RAM.
+ * The bitmaps of the glyphs are read from the file when they are drawn and
+ * kept in an LRU cache. The bitmaps of the printable ASCII characters are loaded in advance while they fit.
+ * The file remains open until the font is freed with `lv_font_free()`.
+ * @param font_name filename where the font file is located
+ * @param cache_size max. size of the cached glyph bitmaps in bytes
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_streamed(const char * font_name, uint32_t cache_size)
+{
+    if(cache_size == 0) {
+        LV_LOG_WARN("The glyph cache size can't be 0");
+        return NULL;
+    }
+
+    lv_fs_file_t file;
+    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
+    if(res != LV_FS_RES_OK)
+        return NULL;
+
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    if(font == NULL) {
+        lv_fs_close(&file);
+        return NULL;
+    }
+
+    memset(font, 0, sizeof(lv_font_t));
+    if(!lvgl_load_font(&file, font, true)) {
+        LV_LOG_WARN("Error loading font file: %s\n", font_name);
+        lv_font_free(font);
+        lv_fs_close(&file);
+        return NULL;
+    }
+
+    /*Size the hash table of the cache for glyphs of about half of a square of the line height*/
+    streamed_dsc_t * dsc = (streamed_dsc_t *)font->dsc;
+    uint32_t avg_size = (font->line_height * font->line_height * dsc->fmt_dsc.bpp) / 16;
+    avg_size = LV_CLAMP(1, avg_size, cache_size);
+    dsc->bitmap_cache = lv_lru_create(cache_size, avg_size, lv_mem_free, lv_mem_free);
+    if(dsc->bitmap_cache == NULL) {
+        lv_font_free(font);
+        lv_fs_close(&file);
+        return NULL;
+    }
+
+    dsc->file = file;
+    dsc->fmt_dsc.cache = &dsc->glyph_cache;
+    font->get_glyph_bitmap = get_bitmap_streamed;
+
+    prefetch_ascii(font);
+
+    return font;
+}
+
+/**
+ * Frees the memory allocated by the `lv_font_load()` or `lv_font_load_streamed()` function
  * @param font lv_font_t object created by the lv_font_load function
  */
 void lv_font_free(lv_font_t * font)
@@ -119,6 +194,12 @@ void lv_font_free(lv_font_t * font)
     if(NULL != font) {
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+        if(NULL != dsc && font->get_glyph_bitmap == get_bitmap_streamed) {
+            streamed_dsc_t * streamed_dsc = (streamed_dsc_t *)dsc;
+            lv_lru_del(streamed_dsc->bitmap_cache);
+            lv_fs_close(&streamed_dsc->file);
+        }
+
         if(NULL != dsc) {
 
             if(dsc->kern_classes == 0) {
@@ -336,7 +417,8 @@ static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, u
 }
 
 static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
-                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header)
+                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header,
+                          bool streamed)
 {
     int32_t glyph_length = read_label(fp, start, "glyf");
     if(glyph_length < 0) {
@@ -408,12 +490,24 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             gdsc->ofs_y = 0;
         }
 
+        /*Streamed fonts read the bitmaps later so only store where the glyph is in the "glyf" table*/
+        if(streamed) {
+            gdsc->bitmap_index = glyph_offset[i];
+            if(gdsc->bitmap_index != glyph_offset[i]) {
+                LV_LOG_WARN("The glyphs are too large to stream. Enable LV_FONT_FMT_TXT_LARGE.");
+                return -1;
+            }
+            continue;
+        }
+
         gdsc->bitmap_index = cur_bmp_size;
         if(gdsc->box_w * gdsc->box_h != 0) {
             cur_bmp_size += bmp_size;
         }
     }
 
+    if(streamed) return glyph_length;
+
     uint8_t * glyph_bmp = (uint8_t *)lv_mem_alloc(sizeof(uint8_t) * cur_bmp_size);
 
     font_dsc->glyph_bitmap = glyph_bmp;
@@ -421,51 +515,173 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
     cur_bmp_size = 0;
 
     for(unsigned int i = 1; i < loca_count; ++i) {
-        lv_fs_res_t res = lv_fs_seek(fp, start + glyph_offset[i], LV_FS_SEEK_SET);
-        if(res != LV_FS_RES_OK) {
-            return -1;
+        if(glyph_dsc[i].box_w * glyph_dsc[i].box_h == 0) {
+            continue;
         }
-        bit_iterator_t bit_it = init_bit_iterator(fp);
 
         int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+        int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
+        int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
 
-        read_bits(&bit_it, nbits, &res);
-        if(res != LV_FS_RES_OK) {
+        if(!read_glyph_bitmap(fp, start + glyph_offset[i], nbits, bmp_size, &glyph_bmp[cur_bmp_size])) {
             return -1;
         }
 
-        if(glyph_dsc[i].box_w * glyph_dsc[i].box_h == 0) {
-            continue;
-        }
+        cur_bmp_size += bmp_size;
+    }
+    return glyph_length;
+}
 
-        int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
-        int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
+/**
+ * Read the bitmap of a glyph.
+ * @param fp the font file
+ * @param glyph_pos position of the glyph's data in the file
+ * @param metrics_bits number of bits before the bitmap
+ * @param bmp_size size of the bitmap in bytes
+ * @param out store the bitmap here
+ * @return true: success; false: read error
+ */
+static bool read_glyph_bitmap(lv_fs_file_t * fp, uint32_t glyph_pos, uint32_t metrics_bits, uint32_t bmp_size,
+                              uint8_t * out)
+{
+    if(lv_fs_seek(fp, glyph_pos + metrics_bits / 8, LV_FS_SEEK_SET) != LV_FS_RES_OK) {
+        return false;
+    }
 
-        if(nbits % 8 == 0) {  /*Fast path*/
-            if(lv_fs_read(fp, &glyph_bmp[cur_bmp_size], bmp_size, NULL) != LV_FS_RES_OK) {
-                return -1;
-            }
+    if(lv_fs_read(fp, out, bmp_size, NULL) != LV_FS_RES_OK) {
+        return false;
+    }
+
+    /*The metrics don't always end on a byte boundary. Shift the bitmap to the first bit.*/
+    uint32_t shift = metrics_bits % 8;
+    if(shift != 0) {
+        for(uint32_t k = 0; k + 1 < bmp_size; ++k) {
+            out[k] = (out[k] << shift) | (out[k + 1] >> (8 - shift));
         }
-        else {
-            for(int k = 0; k < bmp_size - 1; ++k) {
-                glyph_bmp[cur_bmp_size + k] = read_bits(&bit_it, 8, &res);
-                if(res != LV_FS_RES_OK) {
-                    return -1;
-                }
-            }
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = read_bits(&bit_it, 8 - nbits % 8, &res);
-            if(res != LV_FS_RES_OK) {
-                return -1;
-            }
+        out[bmp_size - 1] = out[bmp_size - 1] << shift;
+    }
 
-            /*The last fragment should be on the MSB but read_bits() will place it to the LSB*/
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = glyph_bmp[cur_bmp_size + bmp_size - 1] << (nbits % 8);
+    return true;
+}
 
-        }
+/**
+ * Used as `get_glyph_bitmap` callback of the streamed fonts.
+ * @param font pointer to font
+ * @param unicode_letter a unicode letter which bitmap should be get
+ * @return pointer to the bitmap or NULL if not found. Valid until the next bitmap is loaded.
+ */
+static const uint8_t * get_bitmap_streamed(const lv_font_t * font, uint32_t unicode_letter)
+{
+    if(unicode_letter == '\t') unicode_letter = ' ';
 
-        cur_bmp_size += bmp_size;
+    uint32_t gid = _lv_font_fmt_txt_get_glyph_id(font, unicode_letter);
+    if(gid == 0) return NULL;
+
+    return load_glyph_bitmap(font, gid);
+}
+
+/**
+ * Get a glyph's bitmap from the cache or read it from the file and add it to the cache.
+ * @param font pointer to a streamed font
+ * @param gid ID of the glyph
+ * @return pointer to the bitmap or NULL on error or if the glyph is empty
+ */
+static const uint8_t * load_glyph_bitmap(const lv_font_t * font, uint32_t gid)
+{
+    streamed_dsc_t * dsc = (streamed_dsc_t *)font->dsc;
+
+    uint8_t * bitmap = NULL;
+    lv_lru_get(dsc->bitmap_cache, &gid, sizeof(gid), (void **)&bitmap);
+    if(bitmap) return bitmap;
+
+    uint32_t file_size;
+    uint32_t size = get_glyph_bitmap_size(font, gid, &file_size);
+    if(size == 0) return NULL;
+
+    bitmap = lv_mem_alloc(size);
+    if(bitmap == NULL) {
+        LV_LOG_WARN("Couldn't allocate %"LV_PRIu32" bytes for a glyph", size);
+        return NULL;
+    }
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &dsc->fmt_dsc.glyph_dsc[gid];
+    uint32_t glyph_pos = dsc->glyf_start + gdsc->bitmap_index;
+    bool ok;
+    if(dsc->fmt_dsc.bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
+        ok = read_glyph_bitmap(&dsc->file, glyph_pos, dsc->metrics_bits, file_size, bitmap);
+    }
+    else {
+#if LV_USE_FONT_COMPRESSED
+        uint8_t * compressed = lv_mem_buf_get(file_size);
+        ok = compressed != NULL && read_glyph_bitmap(&dsc->file, glyph_pos, dsc->metrics_bits, file_size, compressed);
+        if(ok) _lv_font_fmt_txt_decompress_glyph(font, gdsc, compressed, bitmap);
+        if(compressed) lv_mem_buf_release(compressed);
+#else
+        ok = false;
+#endif
+    }
+
+    if(!ok) {
+        LV_LOG_WARN("Couldn't read the bitmap of glyph %"LV_PRIu32, gid);
+        lv_mem_free(bitmap);
+        return NULL;
+    }
+
+    if(lv_lru_set(dsc->bitmap_cache, &gid, sizeof(gid), bitmap, size) != LV_LRU_OK) {
+        LV_LOG_WARN("Couldn't cache the bitmap of glyph %"LV_PRIu32". Is the cache too small?", gid);
+        lv_mem_free(bitmap);
+        return NULL;
+    }
+
+    return bitmap;
+}
+
+/**
+ * Get the size of a glyph's bitmap in a streamed font.
+ * @param font pointer to a streamed font
+ * @param gid ID of the glyph
+ * @param file_size store the size of the bitmap in the file here
+ * @return size of the bitmap in RAM (after decompression) or 0 if the glyph is empty
+ *         or can't be decompressed
+ */
+static uint32_t get_glyph_bitmap_size(const lv_font_t * font, uint32_t gid, uint32_t * file_size)
+{
+    streamed_dsc_t * dsc = (streamed_dsc_t *)font->dsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &dsc->fmt_dsc.glyph_dsc[gid];
+    if(gdsc->box_w * gdsc->box_h == 0) return 0;
+
+    uint32_t next_offset = gid + 1 < dsc->glyph_cnt ? gdsc[1].bitmap_index : dsc->glyf_length;
+    *file_size = next_offset - gdsc->bitmap_index - dsc->metrics_bits / 8;
+
+    if(dsc->fmt_dsc.bitmap_format == LV_FONT_FMT_TXT_PLAIN) return *file_size;
+
+#if LV_USE_FONT_COMPRESSED
+    return _lv_font_fmt_txt_get_decompressed_size(font, gdsc);
+#else
+    LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
+    return 0;
+#endif
+}
+
+/**
+ * Load the bitmaps of the printable ASCII characters into the cache while they fit.
+ * They are stored in order in the file so they are read almost sequentially.
+ * @param font pointer to a streamed font
+ */
+static void prefetch_ascii(const lv_font_t * font)
+{
+    streamed_dsc_t * dsc = (streamed_dsc_t *)font->dsc;
+
+    for(uint32_t letter = 0x21; letter < 0x7F; ++letter) {
+        uint32_t gid = _lv_font_fmt_txt_get_glyph_id(font, letter);
+        if(gid == 0) continue;
+
+        uint32_t file_size;
+        uint32_t size = get_glyph_bitmap_size(font, gid, &file_size);
+        if(size > dsc->bitmap_cache->free_memory) break;
+
+        load_glyph_bitmap(font, gid);
     }
-    return glyph_length;
 }
 
 /*
@@ -480,12 +696,13 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  * `lv_font_free` will assume that all non-null pointers are allocated and
  * should be freed.
  */
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool streamed)
 {
-    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_mem_alloc(sizeof(lv_font_fmt_txt_dsc_t));
+    /*The streamed fonts have extra data after the font descriptor*/
+    size_t dsc_size = streamed ? sizeof(streamed_dsc_t) : sizeof(lv_font_fmt_txt_dsc_t);
+    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)lv_mem_alloc(dsc_size);
 
-    memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+    memset(font_dsc, 0, dsc_size);
 
     font->dsc = font_dsc;
 
@@ -562,7 +779,7 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     /*glyph*/
     uint32_t glyph_start = loca_start + loca_length;
     int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
+                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header, streamed);
 
     lv_mem_free(glyph_offset);
 
@@ -570,6 +787,14 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
         return false;
     }
 
+    if(streamed) {
+        streamed_dsc_t * streamed_dsc = (streamed_dsc_t *)font_dsc;
+        streamed_dsc->glyf_start = glyph_start;
+        streamed_dsc->glyf_length = glyph_length;
+        streamed_dsc->glyph_cnt = loca_count;
+        streamed_dsc->metrics_bits = font_header.advance_width_bits + 2 * font_header.xy_bits + 2 * font_header.wh_bits;
+    }
+
     if(font_header.tables_count < 4) {
         font_dsc->kern_dsc = NULL;
         font_dsc->kern_classes = 0;
@@ -157,6 +157,34 @@
         #endif
     #endif
 
+    /*1: Serve the small allocations (<= 96 bytes) from pages of fixed size slots in a reserved area of the heap.
+     *It keeps the many small objects created and deleted on screen changes away from the larger blocks
+     *and so reduces the fragmentation.*/
+    #ifndef LV_MEM_SLAB
+        #ifdef CONFIG_LV_MEM_SLAB
+            #define LV_MEM_SLAB CONFIG_LV_MEM_SLAB
+        #else
+            #define LV_MEM_SLAB 0
+        #endif
+    #endif
+    #if LV_MEM_SLAB
+        /*Reserved for the slabs from `LV_MEM_SIZE`. If it's full the small allocations go to the TLSF heap*/
+        #ifndef LV_MEM_SLAB_SIZE
+            #ifdef CONFIG_LV_MEM_SLAB_SIZE
+                #define LV_MEM_SLAB_SIZE CONFIG_LV_MEM_SLAB_SIZE
+            #else
+                #define LV_MEM_SLAB_SIZE (16U * 1024U)    /*[bytes]*/
+            #endif
+        #endif
+        #ifndef LV_MEM_SLAB_PAGE_SIZE
+            #ifdef CONFIG_LV_MEM_SLAB_PAGE_SIZE
+                #define LV_MEM_SLAB_PAGE_SIZE CONFIG_LV_MEM_SLAB_PAGE_SIZE
+            #else
+                #define LV_MEM_SLAB_PAGE_SIZE 512         /*[bytes] Must be a power of 2*/
+            #endif
+        #endif
+    #endif
+
 #else       /*LV_MEM_CUSTOM*/
     #ifndef LV_MEM_CUSTOM_INCLUDE
         #ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -198,6 +226,17 @@
     #endif
 #endif
 
+/*Size of a static arena for the temporary buffers of `lv_mem_buf_get()` (e.g. mask lines and label buffers while rendering).
+ *The buffers are taken from it like from a stack, so getting and releasing them needs no heap allocations.
+ *The buffers which don't fit into it are allocated on the heap into the `LV_MEM_BUF_MAX_NUM` slots. 0: not used*/
+#ifndef LV_MEM_BUF_ARENA_SIZE
+    #ifdef CONFIG_LV_MEM_BUF_ARENA_SIZE
+        #define LV_MEM_BUF_ARENA_SIZE CONFIG_LV_MEM_BUF_ARENA_SIZE
+    #else
+        #define LV_MEM_BUF_ARENA_SIZE 0    /*[bytes]*/
+    #endif
+#endif
+
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #ifndef LV_MEMCPY_MEMSET_STD
     #ifdef CONFIG_LV_MEMCPY_MEMSET_STD
@@ -356,6 +395,81 @@
     #endif
 #endif
 
+/*Maximal total size of the decoded images kept in the image cache [bytes].
+ *The least valuable images (large, fast to open and not used recently) are closed first to stay in the limit.
+ *0: only the number of images (LV_IMG_CACHE_DEF_SIZE) is limited*/
+#ifndef LV_IMG_CACHE_MEM_SIZE
+    #ifdef CONFIG_LV_IMG_CACHE_MEM_SIZE
+        #define LV_IMG_CACHE_MEM_SIZE CONFIG_LV_IMG_CACHE_MEM_SIZE
+    #else
+        #define LV_IMG_CACHE_MEM_SIZE 0
+    #endif
+#endif
+
+/*Maximal number of images in the image cache which keep their file open to read it line by line (e.g. SJPG).
+ *Keep it below the number of files the file system can open at once.
+ *0: not limited*/
+#ifndef LV_IMG_CACHE_FILE_MAX
+    #ifdef CONFIG_LV_IMG_CACHE_FILE_MAX
+        #define LV_IMG_CACHE_FILE_MAX CONFIG_LV_IMG_CACHE_FILE_MAX
+    #else
+        #define LV_IMG_CACHE_FILE_MAX 0
+    #endif
+#endif
+
+/*1: Allocate the decoded images with custom functions, e.g. in PSRAM or in a separate heap instead of `LV_MEM_SIZE`
+ *The image decoders use these through `lv_img_cache_mem_alloc()` and `lv_img_cache_mem_free()`*/
+#ifndef LV_IMG_CACHE_MEM_CUSTOM
+    #ifdef CONFIG_LV_IMG_CACHE_MEM_CUSTOM
+        #define LV_IMG_CACHE_MEM_CUSTOM CONFIG_LV_IMG_CACHE_MEM_CUSTOM
+    #else
+        #define LV_IMG_CACHE_MEM_CUSTOM 0
+    #endif
+#endif
+#if LV_IMG_CACHE_MEM_CUSTOM
+    #ifndef LV_IMG_CACHE_MEM_CUSTOM_INCLUDE
+        #ifdef CONFIG_LV_IMG_CACHE_MEM_CUSTOM_INCLUDE
+            #define LV_IMG_CACHE_MEM_CUSTOM_INCLUDE CONFIG_LV_IMG_CACHE_MEM_CUSTOM_INCLUDE
+        #else
+            #define LV_IMG_CACHE_MEM_CUSTOM_INCLUDE <stdlib.h>  /*Header for the memory functions*/
+        #endif
+    #endif
+    #ifndef LV_IMG_CACHE_MEM_CUSTOM_ALLOC
+        #ifdef CONFIG_LV_IMG_CACHE_MEM_CUSTOM_ALLOC
+            #define LV_IMG_CACHE_MEM_CUSTOM_ALLOC CONFIG_LV_IMG_CACHE_MEM_CUSTOM_ALLOC
+        #else
+            #define LV_IMG_CACHE_MEM_CUSTOM_ALLOC   malloc
+        #endif
+    #endif
+    #ifndef LV_IMG_CACHE_MEM_CUSTOM_FREE
+        #ifdef CONFIG_LV_IMG_CACHE_MEM_CUSTOM_FREE
+            #define LV_IMG_CACHE_MEM_CUSTOM_FREE CONFIG_LV_IMG_CACHE_MEM_CUSTOM_FREE
+        #else
+            #define LV_IMG_CACHE_MEM_CUSTOM_FREE    free
+        #endif
+    #endif
+#endif
+
+/*1: `lv_img_set_async(img, true)` makes an image widget decode its file in the background,
+ *in short steps between the display refreshes, instead of blocking the refresh. Requires LV_IMG_CACHE_DEF_SIZE > 0*/
+#ifndef LV_IMG_ASYNC
+    #ifdef CONFIG_LV_IMG_ASYNC
+        #define LV_IMG_ASYNC CONFIG_LV_IMG_ASYNC
+    #else
+        #define LV_IMG_ASYNC 0
+    #endif
+#endif
+#if LV_IMG_ASYNC
+    #ifndef LV_IMG_ASYNC_STEP_TIME
+        #ifdef CONFIG_LV_IMG_ASYNC_STEP_TIME
+            #define LV_IMG_ASYNC_STEP_TIME CONFIG_LV_IMG_ASYNC_STEP_TIME
+        #else
+            #define LV_IMG_ASYNC_STEP_TIME 5    /*[ms] Decode the images for this long in one step*/
+        #endif
+    #endif
+#endif
+
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -796,6 +910,60 @@
     #endif
 #endif
 
+/*1: Cache the resolved style properties of the objects to make `lv_obj_get_style_...()` O(1) while drawing.
+ *The cache is a shared table of (object, part, property) -> value entries, invalidated by every style change.
+ *It costs `LV_OBJ_STYLE_CACHE_SIZE * (sizeof(void *) + sizeof(lv_style_value_t) + 8)` bytes of static RAM*/
+#ifndef LV_OBJ_STYLE_CACHE
+    #ifdef CONFIG_LV_OBJ_STYLE_CACHE
+        #define LV_OBJ_STYLE_CACHE CONFIG_LV_OBJ_STYLE_CACHE
+    #else
+        #define LV_OBJ_STYLE_CACHE 0
+    #endif
+#endif
+#if LV_OBJ_STYLE_CACHE
+    #ifndef LV_OBJ_STYLE_CACHE_SIZE
+        #ifdef CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+            #define LV_OBJ_STYLE_CACHE_SIZE CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+        #else
+            #define LV_OBJ_STYLE_CACHE_SIZE 256     /*Number of cached values. Must be a power of 2*/
+        #endif
+    #endif
+#endif
+
+/*1: Make `lv_obj_enable_spatial_index()` available to index the children of an object by their position.
+ *Hit testing, redrawing and the scroll range calculation check only the children close to the point or area
+ *instead of all of them. Useful for objects with hundreds of children, e.g. long lists.
+ *It costs about 16 bytes (24 with `LV_USE_LARGE_COORD`) per child in the objects using it*/
+#ifndef LV_OBJ_SPATIAL_INDEX
+    #ifdef CONFIG_LV_OBJ_SPATIAL_INDEX
+        #define LV_OBJ_SPATIAL_INDEX CONFIG_LV_OBJ_SPATIAL_INDEX
+    #else
+        #define LV_OBJ_SPATIAL_INDEX 0
+    #endif
+#endif
+
+/*1: Make `LV_OBJ_FLAG_CACHE_BITMAP` work. The objects with this flag are rendered with their children
+ *once into an image which is drawn until the object or one of its children is invalidated.
+ *Useful for rarely changing, but expensive objects (shadows, rounded corners, texts) which are moved or redrawn often.
+ *The images take `w * h * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes (`sizeof(lv_color_t)` if fully opaque) from `lv_mem`*/
+#ifndef LV_OBJ_BITMAP_CACHE
+    #ifdef CONFIG_LV_OBJ_BITMAP_CACHE
+        #define LV_OBJ_BITMAP_CACHE CONFIG_LV_OBJ_BITMAP_CACHE
+    #else
+        #define LV_OBJ_BITMAP_CACHE 0
+    #endif
+#endif
+#if LV_OBJ_BITMAP_CACHE
+    #ifndef LV_OBJ_BITMAP_CACHE_SIZE
+        #ifdef CONFIG_LV_OBJ_BITMAP_CACHE_SIZE
+            #define LV_OBJ_BITMAP_CACHE_SIZE CONFIG_LV_OBJ_BITMAP_CACHE_SIZE
+        #else
+            #define LV_OBJ_BITMAP_CACHE_SIZE (32 * 1024U)   /*[bytes] Total size of the cached images. The least recently used are freed above it*/
+        #endif
+    #endif
+#endif
+
+
 /*Change the built in (v)snprintf functions*/
 #ifndef LV_SPRINTF_CUSTOM
     #ifdef CONFIG_LV_SPRINTF_CUSTOM
@@ -1261,6 +1429,20 @@
     #endif
 #endif
 
+/*Keep the glyph ID and width of the printable ASCII characters of the built-in fonts in RAM (~380 bytes per font)
+ *to measure and wrap texts faster*/
+#ifndef LV_FONT_FMT_TXT_ASCII_CACHE
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_FONT_FMT_TXT_ASCII_CACHE
+            #define LV_FONT_FMT_TXT_ASCII_CACHE CONFIG_LV_FONT_FMT_TXT_ASCII_CACHE
+        #else
+            #define LV_FONT_FMT_TXT_ASCII_CACHE 0
+        #endif
+    #else
+        #define LV_FONT_FMT_TXT_ASCII_CACHE 1
+    #endif
+#endif
+
 /*=================
  *  TEXT SETTINGS
  *=================*/
@@ -1497,6 +1679,17 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LINE_CACHE
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_LABEL_LINE_CACHE
+                #define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+            #else
+                #define LV_LABEL_LINE_CACHE 0
+            #endif
+        #else
+            #define LV_LABEL_LINE_CACHE 1     /*Cache the start and width of the lines of long texts to not wrap them again on every draw*/
+        #endif
+    #endif
 #endif
 
 #ifndef LV_USE_LINE
@@ -2042,6 +2235,52 @@
     #endif
 #endif
 
+/*API for open, read, etc with a block cache shared by the files. Useful for slow storages, e.g. SD cards.*/
+#ifndef LV_USE_FS_CACHED
+    #ifdef CONFIG_LV_USE_FS_CACHED
+        #define LV_USE_FS_CACHED CONFIG_LV_USE_FS_CACHED
+    #else
+        #define LV_USE_FS_CACHED 0
+    #endif
+#endif
+#if LV_USE_FS_CACHED
+    #ifndef LV_FS_CACHED_LETTER
+        #ifdef CONFIG_LV_FS_CACHED_LETTER
+            #define LV_FS_CACHED_LETTER CONFIG_LV_FS_CACHED_LETTER
+        #else
+            #define LV_FS_CACHED_LETTER '\0'        /*Set an upper cased letter on which the drive will accessible (e.g. 'A')*/
+        #endif
+    #endif
+    #ifndef LV_FS_CACHED_PATH
+        #ifdef CONFIG_LV_FS_CACHED_PATH
+            #define LV_FS_CACHED_PATH CONFIG_LV_FS_CACHED_PATH
+        #else
+            #define LV_FS_CACHED_PATH ""            /*Set the working directory. File/directory paths will be appended to it.*/
+        #endif
+    #endif
+    #ifndef LV_FS_CACHED_BLOCK_SIZE
+        #ifdef CONFIG_LV_FS_CACHED_BLOCK_SIZE
+            #define LV_FS_CACHED_BLOCK_SIZE CONFIG_LV_FS_CACHED_BLOCK_SIZE
+        #else
+            #define LV_FS_CACHED_BLOCK_SIZE 4096    /*Size of a cached block. Use the sector or cluster size of the storage.*/
+        #endif
+    #endif
+    #ifndef LV_FS_CACHED_SIZE
+        #ifdef CONFIG_LV_FS_CACHED_SIZE
+            #define LV_FS_CACHED_SIZE CONFIG_LV_FS_CACHED_SIZE
+        #else
+            #define LV_FS_CACHED_SIZE (32 * 1024)   /*Total size of the cached blocks*/
+        #endif
+    #endif
+    #ifndef LV_FS_CACHED_READ_AHEAD
+        #ifdef CONFIG_LV_FS_CACHED_READ_AHEAD
+            #define LV_FS_CACHED_READ_AHEAD CONFIG_LV_FS_CACHED_READ_AHEAD
+        #else
+            #define LV_FS_CACHED_READ_AHEAD 2       /*Number of blocks to read in advance when a file is read sequentially*/
+        #endif
+    #endif
+#endif
+
 /*API for CreateFile, ReadFile, etc*/
 #ifndef LV_USE_FS_WIN32
     #ifdef CONFIG_LV_USE_FS_WIN32
@@ -2161,6 +2400,16 @@
     #endif
 #endif
 
+/*RLZ decoder library: RLE + LZ compressed RGB565 images with optional 4 bit alpha for UI assets.
+ *Make them with scripts/lv_img_rlz.py or lv_rlz_encode()*/
+#ifndef LV_USE_RLZ
+    #ifdef CONFIG_LV_USE_RLZ
+        #define LV_USE_RLZ CONFIG_LV_USE_RLZ
+    #else
+        #define LV_USE_RLZ 0
+    #endif
+#endif
+
 /*QR code library*/
 #ifndef LV_USE_QRCODE
     #ifdef CONFIG_LV_USE_QRCODE
@@ -2234,6 +2483,15 @@
             #define LV_TINY_TTF_FILE_SUPPORT 0
         #endif
     #endif
+    /*Memory used by the glyph atlas shared by all Tiny TTF fonts [bytes].
+     *It's allocated in pages of 16 kB (128x128 px) when needed. 0: don't cache the glyphs*/
+    #ifndef LV_TINY_TTF_CACHE_SIZE
+        #ifdef CONFIG_LV_TINY_TTF_CACHE_SIZE
+            #define LV_TINY_TTF_CACHE_SIZE CONFIG_LV_TINY_TTF_CACHE_SIZE
+        #else
+            #define LV_TINY_TTF_CACHE_SIZE (16 * 1024)
+        #endif
+    #endif
 #endif
 
 /*Rlottie library*/
@@ -2379,6 +2637,36 @@
     #endif // LV_IME_PINYIN_USE_K9_MODE
 #endif
 
+/*1: Enable thumbnail generation and thumbnail pack files*/
+/*JPG thumbnails require LV_USE_SJPG and PNG thumbnails LV_USE_PNG*/
+#ifndef LV_USE_THUMB
+    #ifdef CONFIG_LV_USE_THUMB
+        #define LV_USE_THUMB CONFIG_LV_USE_THUMB
+    #else
+        #define LV_USE_THUMB 0
+    #endif
+#endif
+
+/*1: Enable asset packs: pre-converted images and other files in one memory mapped blob (e.g. a flash partition)*/
+/*Make the packs with scripts/lv_asset_pack.py*/
+#ifndef LV_USE_ASSET_PACK
+    #ifdef CONFIG_LV_USE_ASSET_PACK
+        #define LV_USE_ASSET_PACK CONFIG_LV_USE_ASSET_PACK
+    #else
+        #define LV_USE_ASSET_PACK 0
+    #endif
+#endif
+#if LV_USE_ASSET_PACK
+    /*Set an upper cased letter to read the assets with lv_fs too (e.g. to load fonts), '\0' to disable*/
+    #ifndef LV_ASSET_PACK_LETTER
+        #ifdef CONFIG_LV_ASSET_PACK_LETTER
+            #define LV_ASSET_PACK_LETTER CONFIG_LV_ASSET_PACK_LETTER
+        #else
+            #define LV_ASSET_PACK_LETTER '\0'
+        #endif
+    #endif
+#endif
+
 /*==================
 * EXAMPLES
 *==================*/
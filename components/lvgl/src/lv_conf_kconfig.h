@@ -37,8 +37,31 @@ extern "C" {
  * LV_MEM_SIZE
  *******************/
 
+/* `CONFIG_LV_MEM_SIZE_KILOBYTES` is the memory of the widgets, styles, etc.
+ * The areas reserved from the same heap are added to it here.*/
+
+#ifdef CONFIG_LV_MEM_SLAB_SIZE_KILOBYTES
+#  define CONFIG_LV_MEM_SLAB_SIZE (CONFIG_LV_MEM_SLAB_SIZE_KILOBYTES * 1024U)
+#  define LV_KCONFIG_MEM_SLAB_BUDGET CONFIG_LV_MEM_SLAB_SIZE
+#else
+#  define LV_KCONFIG_MEM_SLAB_BUDGET 0U
+#endif
+
+#ifdef CONFIG_LV_FS_CACHED_SIZE
+#  define LV_KCONFIG_MEM_FS_CACHED_BUDGET CONFIG_LV_FS_CACHED_SIZE
+#else
+#  define LV_KCONFIG_MEM_FS_CACHED_BUDGET 0U
+#endif
+
+#ifdef CONFIG_LV_OBJ_BITMAP_CACHE_SIZE
+#  define LV_KCONFIG_MEM_OBJ_BITMAP_CACHE_BUDGET CONFIG_LV_OBJ_BITMAP_CACHE_SIZE
+#else
+#  define LV_KCONFIG_MEM_OBJ_BITMAP_CACHE_BUDGET 0U
+#endif
+
 #ifdef CONFIG_LV_MEM_SIZE_KILOBYTES
-#  define CONFIG_LV_MEM_SIZE (CONFIG_LV_MEM_SIZE_KILOBYTES * 1024U)
+#  define CONFIG_LV_MEM_SIZE (CONFIG_LV_MEM_SIZE_KILOBYTES * 1024U + LV_KCONFIG_MEM_SLAB_BUDGET + \
+                              LV_KCONFIG_MEM_FS_CACHED_BUDGET + LV_KCONFIG_MEM_OBJ_BITMAP_CACHE_BUDGET)
 #endif
 
 /*------------------
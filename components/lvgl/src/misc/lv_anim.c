@@ -21,24 +21,60 @@
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
 
+/*Number of animation slots allocated at once*/
+#define ANIM_BLOCK_SIZE 8
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+struct _lv_anim_block_t;
+
+typedef struct {
+    lv_anim_t anim;         /*Must be the first to cast `lv_anim_t *` to the slot*/
+    struct _lv_anim_block_t * block;
+} lv_anim_slot_t;
+
+/*The animations are stored in blocks of slots so that their address doesn't change while they run.
+ *The free slots of a block are linked through their `var` field.
+ *The blocks with free slots are always in front of the full blocks.*/
+typedef struct _lv_anim_block_t {
+    struct _lv_anim_block_t * next;
+    struct _lv_anim_block_t * prev;
+    lv_anim_slot_t * free_slot;
+    uint32_t used_cnt;
+    lv_anim_slot_t slots[ANIM_BLOCK_SIZE];
+} lv_anim_block_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void anim_timer(lv_timer_t * param);
 static void anim_mark_list_change(void);
-static void anim_ready_handler(lv_anim_t * a);
+static bool anim_ready_handler(lv_anim_t * a, uint32_t i);
+static lv_anim_t * anim_slot_alloc(void);
+static void anim_slot_free(lv_anim_t * a);
+static void anim_block_unlink(lv_anim_block_t * block);
+static void anim_block_link_head(lv_anim_block_t * block);
+static void anim_block_link_tail(lv_anim_block_t * block);
+static void anim_remove(uint32_t i);
+static void anim_compact(void);
+static inline int32_t anim_path_value(const lv_anim_t * a);
+static inline int32_t anim_linear_value(const lv_anim_t * a);
+static inline int32_t anim_bezier_value(const lv_anim_t * a, int32_t u1, int32_t u2);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t last_timer_run;
-static bool anim_list_changed;
 static bool anim_run_round;
 static lv_timer_t * _lv_anim_tmr;
+static lv_anim_block_t * anim_block_tail;
+static uint32_t anim_cnt;           /*Number of running animations*/
+static uint32_t active_cnt;         /*Used elements in the active array, including the deleted (NULL) ones*/
+static uint32_t active_capacity;
+static bool active_has_holes;       /*Some animations were deleted but the array is not compacted yet*/
+static uint32_t anim_iter_depth;    /*>0 while the active array is iterated: it can't be compacted*/
 
 /**********************
  *      MACROS
@@ -56,10 +92,16 @@ static lv_timer_t * _lv_anim_tmr;
 
 void _lv_anim_core_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+    LV_GC_ROOT(_lv_anim_blocks) = NULL;
+    anim_block_tail = NULL;
+    LV_GC_ROOT(_lv_anim_active) = NULL;
+    anim_cnt = 0;
+    active_cnt = 0;
+    active_capacity = 0;
+    active_has_holes = false;
+    anim_iter_depth = 0;
     _lv_anim_tmr = lv_timer_create(anim_timer, LV_DISP_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
-    anim_list_changed = false;
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -80,15 +122,28 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
     if(a->exec_cb != NULL) lv_anim_del(a->var, a->exec_cb); /*exec_cb == NULL would delete all animations of var*/
 
-    /*If the list is empty the anim timer was suspended and it's last run measure is invalid*/
-    if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_anim_ll))) {
+    /*If there are no animations the anim timer was suspended and it's last run measure is invalid*/
+    if(anim_cnt == 0) {
         last_timer_run = lv_tick_get();
     }
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
+    /*Make room in the active array*/
+    if(active_cnt == active_capacity) {
+        uint32_t new_capacity = active_capacity == 0 ? ANIM_BLOCK_SIZE : active_capacity * 2;
+        lv_anim_t ** new_active = lv_mem_realloc(LV_GC_ROOT(_lv_anim_active), new_capacity * sizeof(lv_anim_t *));
+        LV_ASSERT_MALLOC(new_active);
+        if(new_active == NULL) return NULL;
+        LV_GC_ROOT(_lv_anim_active) = new_active;
+        active_capacity = new_capacity;
+    }
+
+    /*Add the new animation to the end of the active array*/
+    lv_anim_t * new_anim = anim_slot_alloc();
     LV_ASSERT_MALLOC(new_anim);
     if(new_anim == NULL) return NULL;
+    LV_GC_ROOT(_lv_anim_active)[active_cnt] = new_anim;
+    active_cnt++;
+    anim_cnt++;
 
     /*Initialize the animation descriptor*/
     lv_memcpy(new_anim, a, sizeof(lv_anim_t));
@@ -106,8 +161,6 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         if(new_anim->exec_cb && new_anim->var) new_anim->exec_cb(new_anim->var, new_anim->start_value);
     }
 
-    /*Creating an animation changed the linked list.
-     *It's important if it happens in a ready callback. (see `anim_timer`)*/
     anim_mark_list_change();
 
     TRACE_ANIM("finished");
@@ -137,24 +190,26 @@ uint32_t lv_anim_get_playtime(lv_anim_t * a)
 
 bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    lv_anim_t * a_next;
     bool del = false;
-    a        = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-    while(a != NULL) {
-        /*'a' might be deleted, so get the next object while 'a' is valid*/
-        a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+    uint32_t i;
+    /*Newest first. `deleted_cb` might start or delete animations so always read the array again*/
+    anim_iter_depth++;
+    for(i = active_cnt; i > 0; i--) {
+        lv_anim_t * a = LV_GC_ROOT(_lv_anim_active)[i - 1];
+        if(a == NULL) continue;
 
         if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
+            anim_remove(i - 1);
             if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_mem_free(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
+            anim_slot_free(a);
             del = true;
         }
+    }
+    anim_iter_depth--;
 
-        a = a_next;
+    if(del) {
+        anim_compact();
+        anim_mark_list_change();
     }
 
     return del;
@@ -162,15 +217,26 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 
 void lv_anim_del_all(void)
 {
-    _lv_ll_clear(&LV_GC_ROOT(_lv_anim_ll));
+    uint32_t i;
+    for(i = 0; i < active_cnt; i++) {
+        lv_anim_t * a = LV_GC_ROOT(_lv_anim_active)[i];
+        if(a) {
+            LV_GC_ROOT(_lv_anim_active)[i] = NULL;
+            anim_slot_free(a);
+        }
+    }
+    anim_cnt = 0;
+    active_has_holes = true;
+    anim_compact();
     anim_mark_list_change();
 }
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) {
-        if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+    uint32_t i;
+    for(i = active_cnt; i > 0; i--) {
+        lv_anim_t * a = LV_GC_ROOT(_lv_anim_active)[i - 1];
+        if(a && a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             return a;
         }
     }
@@ -185,11 +251,7 @@ struct _lv_timer_t * lv_anim_get_timer(void)
 
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) cnt++;
-
-    return cnt;
+    return (uint16_t)anim_cnt;
 }
 
 uint32_t lv_anim_speed_to_time(uint32_t speed, int32_t start, int32_t end)
@@ -211,73 +273,27 @@ void lv_anim_refr_now(void)
 
 int32_t lv_anim_path_linear(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    int32_t step = lv_map(a->act_time, 0, a->time, 0, LV_ANIM_RESOLUTION);
-
-    /*Get the new value which will be proportional to `step`
-     *and the `start` and `end` values*/
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_ANIM_RES_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_linear_value(a);
 }
 
 int32_t lv_anim_path_ease_in(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 50, 100, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_bezier_value(a, 50, 100);
 }
 
 int32_t lv_anim_path_ease_out(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 900, 950, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_bezier_value(a, 900, 950);
 }
 
 int32_t lv_anim_path_ease_in_out(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 50, 952, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_bezier_value(a, 50, 952);
 }
 
 int32_t lv_anim_path_overshoot(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 1000, 1300, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_bezier_value(a, 1000, 1300);
 }
 
 int32_t lv_anim_path_bounce(const lv_anim_t * a)
@@ -355,58 +371,59 @@ static void anim_timer(lv_timer_t * param)
 
     /*Flip the run round*/
     anim_run_round = anim_run_round ? false : true;
-
-    lv_anim_t * a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-
-    while(a != NULL) {
-        /*It can be set by `lv_anim_del()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_ready_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        anim_list_changed = false;
-
-        if(a->run_round != anim_run_round) {
-            a->run_round = anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
-
-            /*The animation will run now for the first time. Call `start_cb`*/
-            int32_t new_act_time = a->act_time + elaps;
-            if(!a->start_cb_called && a->act_time <= 0 && new_act_time >= 0) {
-                if(a->early_apply == 0 && a->get_value_cb) {
-                    int32_t v_ofs = a->get_value_cb(a);
-                    a->start_value += v_ofs;
-                    a->end_value += v_ofs;
-                }
-                if(a->start_cb) a->start_cb(a);
-                a->start_cb_called = 1;
+    anim_iter_depth++;
+
+    /*Go from the newest to the oldest animation. The animations started in the callbacks are added to
+     *the end of the array and deleted ones are only cleared, so the indices stay valid during the loop.
+     *The array is read in every iteration as it might be reallocated in a callback.*/
+    uint32_t i;
+    for(i = active_cnt; i > 0; i--) {
+        lv_anim_t * a = LV_GC_ROOT(_lv_anim_active)[i - 1];
+        if(a == NULL || a->run_round == anim_run_round) continue;
+
+        a->run_round = anim_run_round;
+
+        /*The animation will run now for the first time. Call `start_cb`*/
+        int32_t new_act_time = a->act_time + elaps;
+        if(!a->start_cb_called && a->act_time <= 0 && new_act_time >= 0) {
+            if(a->early_apply == 0 && a->get_value_cb) {
+                int32_t v_ofs = a->get_value_cb(a);
+                a->start_value += v_ofs;
+                a->end_value += v_ofs;
             }
-            a->act_time += elaps;
-            if(a->act_time >= 0) {
-                if(a->act_time > a->time) a->act_time = a->time;
-
-                int32_t new_value;
-                new_value = a->path_cb(a);
+            if(a->start_cb) a->start_cb(a);
+            a->start_cb_called = 1;
 
-                if(new_value != a->current_value) {
-                    a->current_value = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
+            /*The animation might be deleted in `start_cb`*/
+            if(LV_GC_ROOT(_lv_anim_active)[i - 1] != a) continue;
+        }
+        a->act_time += elaps;
+        if(a->act_time >= 0) {
+            if(a->act_time > a->time) a->act_time = a->time;
+
+            int32_t new_value = anim_path_value(a);
+
+            if(new_value != a->current_value) {
+                a->current_value = new_value;
+                /*Apply the calculated value*/
+                if(a->exec_cb) {
+                    a->exec_cb(a->var, new_value);
+                    /*The animation might be deleted in `exec_cb`*/
+                    if(LV_GC_ROOT(_lv_anim_active)[i - 1] != a) continue;
                 }
+            }
 
-                /*If the time is elapsed the animation is ready*/
-                if(a->act_time >= a->time) {
-                    anim_ready_handler(a);
-                }
+            /*If the time is elapsed the animation is ready*/
+            if(a->act_time >= a->time) {
+                anim_ready_handler(a, i - 1);
             }
         }
-
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(anim_list_changed)
-            a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-        else
-            a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
     }
 
+    anim_iter_depth--;
+    anim_compact();
+    anim_mark_list_change();
+
     last_timer_run = lv_tick_get();
 }
 
@@ -414,8 +431,10 @@ static void anim_timer(lv_timer_t * param)
  * Called when an animation is ready to do the necessary thinks
  * e.g. repeat, play back, delete etc.
  * @param a pointer to an animation descriptor
+ * @param i index of the animation in the active array
+ * @return true: the animation was deleted
  */
-static void anim_ready_handler(lv_anim_t * a)
+static bool anim_ready_handler(lv_anim_t * a, uint32_t i)
 {
     /*In the end of a forward anim decrement repeat cnt.*/
     if(a->playback_now == 0 && a->repeat_cnt > 0 && a->repeat_cnt != LV_ANIM_REPEAT_INFINITE) {
@@ -427,16 +446,15 @@ static void anim_ready_handler(lv_anim_t * a)
      * - no repeat, play back is enabled and play back is ready*/
     if(a->repeat_cnt == 0 && (a->playback_time == 0 || a->playback_now == 1)) {
 
-        /*Delete the animation from the list.
+        /*Remove the animation from the active ones.
          * This way the `ready_cb` will see the animations like it's animation is ready deleted*/
-        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-        /*Flag that the list has changed*/
-        anim_mark_list_change();
+        anim_remove(i);
 
         /*Call the callback function at the end*/
         if(a->ready_cb != NULL) a->ready_cb(a);
         if(a->deleted_cb != NULL) a->deleted_cb(a);
-        lv_mem_free(a);
+        anim_slot_free(a);
+        return true;
     }
     /*If the animation is not deleted then restart it*/
     else {
@@ -457,14 +475,189 @@ static void anim_ready_handler(lv_anim_t * a)
             a->time = a->playback_time;
             a->playback_time = tmp;
         }
+        return false;
     }
 }
 
 static void anim_mark_list_change(void)
 {
-    anim_list_changed = true;
-    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL)
+    if(anim_cnt == 0)
         lv_timer_pause(_lv_anim_tmr);
     else
         lv_timer_resume(_lv_anim_tmr);
 }
+
+/**
+ * Get a free animation slot. Allocate a new block only if all the blocks are full.
+ * @return pointer to a slot or NULL on out of memory
+ */
+static lv_anim_t * anim_slot_alloc(void)
+{
+    lv_anim_block_t * block = LV_GC_ROOT(_lv_anim_blocks);
+
+    /*If the first block is full all of them are full*/
+    if(block == NULL || block->free_slot == NULL) {
+        block = lv_mem_alloc(sizeof(lv_anim_block_t));
+        if(block == NULL) return NULL;
+
+        uint32_t i;
+        for(i = 0; i < ANIM_BLOCK_SIZE; i++) {
+            block->slots[i].block = block;
+            block->slots[i].anim.var = i + 1 < ANIM_BLOCK_SIZE ? &block->slots[i + 1] : NULL;
+        }
+        block->free_slot = &block->slots[0];
+        block->used_cnt = 0;
+        anim_block_link_head(block);
+    }
+
+    lv_anim_slot_t * slot = block->free_slot;
+    block->free_slot = slot->anim.var;
+    block->used_cnt++;
+
+    /*Move the full block behind the others*/
+    if(block->free_slot == NULL && block != anim_block_tail) {
+        anim_block_unlink(block);
+        anim_block_link_tail(block);
+    }
+
+    return &slot->anim;
+}
+
+/**
+ * Give back a slot to its block. Free the block if it's empty.
+ * @param a pointer to an animation slot
+ */
+static void anim_slot_free(lv_anim_t * a)
+{
+    lv_anim_slot_t * slot = (lv_anim_slot_t *)a;
+    lv_anim_block_t * block = slot->block;
+    bool was_full = block->free_slot == NULL;
+
+    a->var = block->free_slot;
+    block->free_slot = slot;
+    block->used_cnt--;
+
+    if(block->used_cnt == 0) {
+        anim_block_unlink(block);
+        lv_mem_free(block);
+    }
+    else if(was_full) {
+        /*Move it in front of the full blocks*/
+        anim_block_unlink(block);
+        anim_block_link_head(block);
+    }
+}
+
+static void anim_block_unlink(lv_anim_block_t * block)
+{
+    if(block->prev) block->prev->next = block->next;
+    else LV_GC_ROOT(_lv_anim_blocks) = block->next;
+
+    if(block->next) block->next->prev = block->prev;
+    else anim_block_tail = block->prev;
+}
+
+static void anim_block_link_head(lv_anim_block_t * block)
+{
+    block->prev = NULL;
+    block->next = LV_GC_ROOT(_lv_anim_blocks);
+    if(block->next) block->next->prev = block;
+    else anim_block_tail = block;
+    LV_GC_ROOT(_lv_anim_blocks) = block;
+}
+
+static void anim_block_link_tail(lv_anim_block_t * block)
+{
+    block->next = NULL;
+    block->prev = anim_block_tail;
+    if(block->prev) block->prev->next = block;
+    else LV_GC_ROOT(_lv_anim_blocks) = block;
+    anim_block_tail = block;
+}
+
+/**
+ * Remove an animation from the active array. The array is compacted later.
+ * @param i index of the animation in the active array
+ */
+static void anim_remove(uint32_t i)
+{
+    LV_GC_ROOT(_lv_anim_active)[i] = NULL;
+    active_has_holes = true;
+    anim_cnt--;
+}
+
+/**
+ * Remove the deleted animations from the active array keeping the order of the others.
+ * Free the array if there are no animations to not keep memory while idle.
+ */
+static void anim_compact(void)
+{
+    if(!active_has_holes || anim_iter_depth > 0) return;
+
+    lv_anim_t ** active = LV_GC_ROOT(_lv_anim_active);
+    uint32_t i;
+    uint32_t j = 0;
+    for(i = 0; i < active_cnt; i++) {
+        if(active[i]) active[j++] = active[i];
+    }
+    active_cnt = j;
+    active_has_holes = false;
+
+    if(active_cnt == 0) {
+        lv_mem_free(active);
+        LV_GC_ROOT(_lv_anim_active) = NULL;
+        active_capacity = 0;
+    }
+}
+
+/**
+ * Get the current value of an animation. The built-in paths are evaluated inline.
+ * @param a pointer to an animation
+ * @return the current value
+ */
+static inline int32_t anim_path_value(const lv_anim_t * a)
+{
+    lv_anim_path_cb_t path_cb = a->path_cb;
+    if(path_cb == lv_anim_path_linear) return anim_linear_value(a);
+    else if(path_cb == lv_anim_path_ease_out) return anim_bezier_value(a, 900, 950);
+    else if(path_cb == lv_anim_path_ease_in_out) return anim_bezier_value(a, 50, 952);
+    else if(path_cb == lv_anim_path_ease_in) return anim_bezier_value(a, 50, 100);
+    else if(path_cb == lv_anim_path_overshoot) return anim_bezier_value(a, 1000, 1300);
+    else return path_cb(a);
+}
+
+static inline int32_t anim_linear_value(const lv_anim_t * a)
+{
+    /*Calculate the current step*/
+    int32_t step = lv_map(a->act_time, 0, a->time, 0, LV_ANIM_RESOLUTION);
+
+    /*Get the new value which will be proportional to `step`
+     *and the `start` and `end` values*/
+    int32_t new_value;
+    new_value = step * (a->end_value - a->start_value);
+    new_value = new_value >> LV_ANIM_RES_SHIFT;
+    new_value += a->start_value;
+
+    return new_value;
+}
+
+/**
+ * Get the current value of an animation on a cubic Bezier path starting at 0 and ending at `LV_BEZIER_VAL_MAX`
+ * @param a     pointer to an animation
+ * @param u1    the first control point
+ * @param u2    the second control point
+ * @return the current value
+ */
+static inline int32_t anim_bezier_value(const lv_anim_t * a, int32_t u1, int32_t u2)
+{
+    /*Calculate the current step*/
+    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
+    int32_t step = lv_bezier3(t, 0, u1, u2, LV_BEZIER_VAL_MAX);
+
+    int32_t new_value;
+    new_value = step * (a->end_value - a->start_value);
+    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
+    new_value += a->start_value;
+
+    return new_value;
+}
@@ -40,7 +40,7 @@ static const char * lv_fs_get_real_path(const char * path);
 
 void _lv_fs_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_fsdrv_ll), sizeof(lv_fs_drv_t *));
+    lv_vec_init(&LV_GC_ROOT(_lv_fsdrv_list), sizeof(lv_fs_drv_t *));
 }
 
 bool lv_fs_is_ready(char letter)
@@ -157,6 +157,9 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
                 /*If remaining data chuck is bigger than buffer size, then do not use cache, instead read it directly from FS*/
                 res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (void *)(buf + buffer_remaining_length),
                                            btr - buffer_remaining_length, &bytes_read_to_buffer);
+                /*The cache has to end where the FS position is*/
+                file_p->cache->start = file_p->cache->end + bytes_read_to_buffer;
+                file_p->cache->end = file_p->cache->start;
             }
             else {
                 /*If remaining data chunk is smaller than buffer size, then read into cache buffer*/
@@ -175,6 +178,9 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
         if(btr > buffer_size) {
             /*If bigger data is requested, then do not use cache, instead read it directly*/
             res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (void *)buf, btr, br);
+            /*The cache has to end where the FS position is*/
+            file_p->cache->start = file_position + *br;
+            file_p->cache->end = file_p->cache->start;
         }
         else {
             /*If small data is requested, then read from FS into cache buffer*/
@@ -236,7 +242,22 @@ lv_fs_res_t lv_fs_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, u
     }
 
     uint32_t bw_tmp = 0;
-    lv_fs_res_t res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
+    lv_fs_res_t res;
+    if(file_p->drv->cache_size) {
+        /*The FS is at the end of the cache. Write to the position of the file and drop the cached data.*/
+        lv_fs_file_cache_t * cache = file_p->cache;
+        if(cache->file_position != cache->end) {
+            res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, cache->file_position, LV_FS_SEEK_SET);
+            if(res != LV_FS_RES_OK) return res;
+        }
+        res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
+        cache->file_position += bw_tmp;
+        cache->start = cache->file_position;
+        cache->end = cache->start;
+    }
+    else {
+        res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
+    }
     if(bw != NULL) *bw = bw_tmp;
 
     return res;
@@ -283,7 +304,10 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
                         res = file_p->drv->tell_cb(file_p->drv, file_p->file_d, &tmp_position);
 
                         if(res == LV_FS_RES_OK) {
+                            /*The cache has to end where the FS position is*/
                             file_p->cache->file_position = tmp_position;
+                            file_p->cache->start = tmp_position;
+                            file_p->cache->end = tmp_position;
                         }
                     }
                     break;
@@ -399,7 +423,7 @@ void lv_fs_drv_register(lv_fs_drv_t * drv_p)
 {
     /*Save the new driver*/
     lv_fs_drv_t ** new_drv;
-    new_drv = _lv_ll_ins_head(&LV_GC_ROOT(_lv_fsdrv_ll));
+    new_drv = lv_vec_push(&LV_GC_ROOT(_lv_fsdrv_list));
     LV_ASSERT_MALLOC(new_drv);
     if(new_drv == NULL) return;
 
@@ -408,11 +432,14 @@ void lv_fs_drv_register(lv_fs_drv_t * drv_p)
 
 lv_fs_drv_t * lv_fs_get_drv(char letter)
 {
-    lv_fs_drv_t ** drv;
-
-    _LV_LL_READ(&LV_GC_ROOT(_lv_fsdrv_ll), drv) {
-        if((*drv)->letter == letter) {
-            return *drv;
+    const lv_vec_t * list = &LV_GC_ROOT(_lv_fsdrv_list);
+    lv_fs_drv_t ** drv = (lv_fs_drv_t **)list->data;
+
+    /*The newest driver wins if a letter is registered more times*/
+    uint32_t i;
+    for(i = list->cnt; i > 0; i--) {
+        if(drv[i - 1]->letter == letter) {
+            return drv[i - 1];
         }
     }
 
@@ -421,11 +448,13 @@ lv_fs_drv_t * lv_fs_get_drv(char letter)
 
 char * lv_fs_get_letters(char * buf)
 {
-    lv_fs_drv_t ** drv;
+    const lv_vec_t * list = &LV_GC_ROOT(_lv_fsdrv_list);
+    lv_fs_drv_t ** drv = (lv_fs_drv_t **)list->data;
+    uint32_t d;
     uint8_t i = 0;
 
-    _LV_LL_READ(&LV_GC_ROOT(_lv_fsdrv_ll), drv) {
-        buf[i] = (*drv)->letter;
+    for(d = list->cnt; d > 0; d--) {
+        buf[i] = drv[d - 1]->letter;
         i++;
     }
 
@@ -17,7 +17,10 @@ extern "C" {
 #include <stdint.h>
 #include "lv_mem.h"
 #include "lv_ll.h"
+#include "lv_ilist.h"
+#include "lv_vec.h"
 #include "lv_timer.h"
+#include "lv_anim.h"
 #include "lv_types.h"
 #include "../draw/lv_img_cache.h"
 #include "../draw/lv_draw_mask.h"
@@ -32,6 +35,18 @@ extern "C" {
 #    define LV_IMG_CACHE_DEF            0
 #endif
 
+#if LV_IMG_ASYNC
+#    define LV_IMG_ASYNC_DEF            1
+#else
+#    define LV_IMG_ASYNC_DEF            0
+#endif
+
+#if LV_OBJ_BITMAP_CACHE
+#    define LV_OBJ_BITMAP_CACHE_DEF     1
+#else
+#    define LV_OBJ_BITMAP_CACHE_DEF     0
+#endif
+
 #define LV_DISPATCH(f, t, n)            f(t, n)
 #define LV_DISPATCH_COND(f, t, n, m, v) LV_CONCAT3(LV_DISPATCH, m, v)(f, t, n)
 
@@ -41,18 +56,23 @@ extern "C" {
 #define LV_DISPATCH11(f, t, n)          LV_DISPATCH(f, t, n)
 
 #define LV_ITERATE_ROOTS(f)                                                                            \
-    LV_DISPATCH(f, lv_ll_t, _lv_timer_ll) /*Linked list to store the lv_timers*/                       \
+    LV_DISPATCH(f, lv_ilist_t, _lv_timer_list) /*Intrusive list of the lv_timers*/                     \
     LV_DISPATCH(f, lv_ll_t, _lv_disp_ll)  /*Linked list of display device*/                            \
     LV_DISPATCH(f, lv_ll_t, _lv_indev_ll) /*Linked list of input device*/                              \
-    LV_DISPATCH(f, lv_ll_t, _lv_fsdrv_ll)                                                              \
-    LV_DISPATCH(f, lv_ll_t, _lv_anim_ll)                                                               \
-    LV_DISPATCH(f, lv_ll_t, _lv_group_ll)                                                              \
-    LV_DISPATCH(f, lv_ll_t, _lv_img_decoder_ll)                                                        \
+    LV_DISPATCH(f, lv_vec_t, _lv_fsdrv_list) /*Pointers to the registered drivers*/                    \
+    LV_DISPATCH(f, void *, _lv_anim_blocks) /*Blocks of animation slots*/                              \
+    LV_DISPATCH(f, lv_anim_t **, _lv_anim_active) /*Array of the running animations*/                  \
+    LV_DISPATCH(f, lv_ilist_t, _lv_group_list)                                                         \
+    LV_DISPATCH(f, lv_vec_t, _lv_img_decoder_list) /*Pointers to the decoders, the newest is the last*/\
     LV_DISPATCH(f, lv_ll_t, _lv_obj_style_trans_ll)                                                    \
     LV_DISPATCH(f, lv_layout_dsc_t *, _lv_layout_list)                                                 \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
-    LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
+    LV_DISPATCH_COND(f, lv_vec_t, _lv_img_cache_pins, LV_IMG_CACHE_DEF, 1) /*Pinned image sources*/    \
+    LV_DISPATCH(f, _lv_img_cache_entry_t, _lv_img_cache_single) /*The image which is not cached*/      \
+    LV_DISPATCH_COND(f, lv_vec_t, _lv_img_async_jobs, LV_IMG_ASYNC_DEF, 1) /*Background decodings*/    \
+    LV_DISPATCH_COND(f, lv_ilist_t, _lv_obj_bitmap_cache_list, LV_OBJ_BITMAP_CACHE_DEF, 1) /*Cached objects*/\
     LV_DISPATCH(f, lv_timer_t*, _lv_timer_act)                                                         \
+    LV_DISPATCH(f, lv_timer_t**, _lv_timer_heap) /*Min-heap of the running timers by deadline*/        \
     LV_DISPATCH(f, lv_mem_buf_arr_t , lv_mem_buf)                                                      \
     LV_DISPATCH_COND(f, _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
     LV_DISPATCH_COND(f, _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)            \
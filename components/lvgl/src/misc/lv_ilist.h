@@ -0,0 +1,193 @@
+/**
+ * @file lv_ilist.h
+ * Intrusive doubly linked list. The nodes are embedded into the items so
+ * the list doesn't allocate memory and reaching the item of a node costs nothing.
+ */
+
+#ifndef LV_ILIST_H
+#define LV_ILIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Node of an intrusive list. Add it to the item's struct, preferably as the first member
+ * so that a pointer to the node is a pointer to the item too (it's what a garbage collector sees).
+ */
+typedef struct _lv_ilist_node_t {
+    struct _lv_ilist_node_t * prev;
+    struct _lv_ilist_node_t * next;
+} lv_ilist_node_t;
+
+/** Description of an intrusive list*/
+typedef struct {
+    lv_ilist_node_t * head;
+    lv_ilist_node_t * tail;
+} lv_ilist_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an empty list
+ * @param list      pointer to an `lv_ilist_t` variable
+ */
+static inline void lv_ilist_init(lv_ilist_t * list)
+{
+    list->head = NULL;
+    list->tail = NULL;
+}
+
+/**
+ * Add a node as the new head of the list
+ * @param list      pointer to a list
+ * @param node      pointer to a node which is not in any list
+ */
+static inline void lv_ilist_ins_head(lv_ilist_t * list, lv_ilist_node_t * node)
+{
+    node->prev = NULL;
+    node->next = list->head;
+    if(list->head) list->head->prev = node;
+    else list->tail = node;
+    list->head = node;
+}
+
+/**
+ * Add a node as the new tail of the list
+ * @param list      pointer to a list
+ * @param node      pointer to a node which is not in any list
+ */
+static inline void lv_ilist_ins_tail(lv_ilist_t * list, lv_ilist_node_t * node)
+{
+    node->next = NULL;
+    node->prev = list->tail;
+    if(list->tail) list->tail->next = node;
+    else list->head = node;
+    list->tail = node;
+}
+
+/**
+ * Insert a node before an other one
+ * @param list      pointer to a list
+ * @param node_act  pointer to a node of the list
+ * @param node      pointer to a node which is not in any list
+ */
+static inline void lv_ilist_ins_prev(lv_ilist_t * list, lv_ilist_node_t * node_act, lv_ilist_node_t * node)
+{
+    node->next = node_act;
+    node->prev = node_act->prev;
+    if(node_act->prev) node_act->prev->next = node;
+    else list->head = node;
+    node_act->prev = node;
+}
+
+/**
+ * Remove a node from the list. The memory of the item is not freed.
+ * @param list      pointer to a list
+ * @param node      pointer to a node of the list
+ */
+static inline void lv_ilist_remove(lv_ilist_t * list, lv_ilist_node_t * node)
+{
+    if(node->prev) node->prev->next = node->next;
+    else list->head = node->next;
+    if(node->next) node->next->prev = node->prev;
+    else list->tail = node->prev;
+    node->prev = NULL;
+    node->next = NULL;
+}
+
+/**
+ * Get the first node of the list
+ * @param list      pointer to a list
+ * @return          pointer to the head or NULL if the list is empty
+ */
+static inline lv_ilist_node_t * lv_ilist_get_head(const lv_ilist_t * list)
+{
+    return list->head;
+}
+
+/**
+ * Get the last node of the list
+ * @param list      pointer to a list
+ * @return          pointer to the tail or NULL if the list is empty
+ */
+static inline lv_ilist_node_t * lv_ilist_get_tail(const lv_ilist_t * list)
+{
+    return list->tail;
+}
+
+/**
+ * Get the node after an other one
+ * @param node      pointer to a node of a list
+ * @return          pointer to the next node or NULL at the tail
+ */
+static inline lv_ilist_node_t * lv_ilist_get_next(const lv_ilist_node_t * node)
+{
+    return node->next;
+}
+
+/**
+ * Get the node before an other one
+ * @param node      pointer to a node of a list
+ * @return          pointer to the previous node or NULL at the head
+ */
+static inline lv_ilist_node_t * lv_ilist_get_prev(const lv_ilist_node_t * node)
+{
+    return node->prev;
+}
+
+/**
+ * Check if a list is empty
+ * @param list      pointer to a list
+ * @return          true: the list has no nodes
+ */
+static inline bool lv_ilist_is_empty(const lv_ilist_t * list)
+{
+    return list->head == NULL;
+}
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**
+ * Get the item which embeds a node
+ * @param node      pointer to a node (can't be NULL)
+ * @param type      type of the item, e.g. `lv_timer_t`
+ * @param member    name of the node in the item
+ */
+#define lv_ilist_entry(node, type, member) ((type *)((uint8_t *)(node) - offsetof(type, member)))
+
+/**
+ * Iterate over the nodes of a list from the head. The current node mustn't be removed in the loop.
+ */
+#define _LV_ILIST_READ(list, node) for(node = (list)->head; node != NULL; node = node->next)
+
+/**
+ * Iterate over the nodes of a list from the head. The current node can be removed in the loop.
+ */
+#define _LV_ILIST_READ_SAFE(list, node, node_next) \
+    for(node = (list)->head; node != NULL && ((node_next = node->next), 1); node = node_next)
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_ILIST_H*/
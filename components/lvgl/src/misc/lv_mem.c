@@ -9,6 +9,7 @@
  *********************/
 #include "lv_mem.h"
 #include "lv_tlsf.h"
+#include "lv_mem_slab.h"
 #include "lv_gc.h"
 #include "lv_assert.h"
 #include "lv_log.h"
@@ -39,9 +40,18 @@
 
 #define ZERO_MEM_SENTINEL  0xa1b2c3d4
 
+#define BUF_ARENA_NONE     UINT32_MAX
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_MEM_BUF_ARENA_SIZE
+/*Placed before every buffer of the arena*/
+typedef struct {
+    uint32_t prev;  /*Offset of the previous buffer's header or `BUF_ARENA_NONE`*/
+    uint32_t used;
+} lv_mem_buf_arena_hdr_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -49,6 +59,10 @@
 #if LV_MEM_CUSTOM == 0
     static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
 #endif
+#if LV_MEM_BUF_ARENA_SIZE
+    static void * buf_arena_get(uint32_t size);
+    static bool buf_arena_release(void * p);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -59,6 +73,19 @@
     static uint32_t max_used;
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    static lv_mem_slab_t slab;
+    static bool slab_en;
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+    static LV_ATTRIBUTE_LARGE_RAM_ARRAY MEM_UNIT buf_arena[(LV_MEM_BUF_ARENA_SIZE + 7) / sizeof(MEM_UNIT)];
+    static uint32_t buf_arena_top;                      /*The first free byte*/
+    static uint32_t buf_arena_last = BUF_ARENA_NONE;    /*Header of the last buffer*/
+#endif
+
+static lv_mem_buf_monitor_t buf_mon;
+
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
 
 /**********************
@@ -98,6 +125,12 @@ void lv_mem_init(void)
 #else
     tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
 #endif
+
+#if LV_MEM_SLAB
+    /*Reserve the area of the slabs first to have it at the beginning of the heap*/
+    slab_en = lv_mem_slab_init(&slab, tlsf, LV_MEM_SLAB_SIZE);
+    if(!slab_en) LV_LOG_WARN("couldn't reserve the memory of the slabs, using only the TLSF heap");
+#endif
 #endif
 
 #if LV_MEM_ADD_JUNK
@@ -131,7 +164,13 @@ void * lv_mem_alloc(size_t size)
     }
 
 #if LV_MEM_CUSTOM == 0
-    void * alloc = lv_tlsf_malloc(tlsf, size);
+    void * alloc = NULL;
+#if LV_MEM_SLAB
+    /*If the slabs are full use the TLSF heap*/
+    if(slab_en && size <= LV_MEM_SLAB_SIZE_MAX) alloc = lv_mem_slab_alloc(&slab, size);
+    if(alloc == NULL)
+#endif
+        alloc = lv_tlsf_malloc(tlsf, size);
 #else
     void * alloc = LV_MEM_CUSTOM_ALLOC(size);
 #endif
@@ -173,6 +212,17 @@ void lv_mem_free(void * data)
     if(data == NULL) return;
 
 #if LV_MEM_CUSTOM == 0
+#  if LV_MEM_SLAB
+    if(slab_en && lv_mem_slab_is_slot(&slab, data)) {
+#    if LV_MEM_ADD_JUNK
+        lv_memset(data, 0xbb, lv_mem_slab_get_slot_size(&slab, data));
+#    endif
+        size_t size = lv_mem_slab_free(&slab, data);
+        if(cur_used > size) cur_used -= size;
+        else cur_used = 0;
+        return;
+    }
+#  endif
 #  if LV_MEM_ADD_JUNK
     lv_memset(data, 0xbb, lv_tlsf_block_size(data));
 #  endif
@@ -200,9 +250,26 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
         return &zero_mem;
     }
 
-    if(data_p == &zero_mem) return lv_mem_alloc(new_size);
+    if(data_p == &zero_mem || data_p == NULL) return lv_mem_alloc(new_size);
 
 #if LV_MEM_CUSTOM == 0
+#if LV_MEM_SLAB
+    if(slab_en && lv_mem_slab_is_slot(&slab, data_p)) {
+        /*Keep the slot if the new size still fits, else move the data to a larger class or to the TLSF heap*/
+        size_t slot_size = lv_mem_slab_get_slot_size(&slab, data_p);
+        if(new_size <= slot_size) return data_p;
+
+        void * new_p = lv_mem_alloc(new_size);
+        if(new_p == NULL) {
+            LV_LOG_ERROR("couldn't allocate memory");
+            return NULL;
+        }
+        lv_memcpy(new_p, data_p, slot_size);
+        lv_mem_free(data_p);
+        MEM_TRACE("allocated at %p", new_p);
+        return new_p;
+    }
+#endif
     void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
 #else
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
@@ -252,6 +319,17 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
 
+#if LV_MEM_SLAB
+    /*The area of the slabs is a used block for TLSF. Its free slots are reported separately
+     *to keep `free_size` and `frag_pct` about the TLSF heap*/
+    if(slab_en) {
+        lv_mem_slab_monitor_t slab_mon;
+        lv_mem_slab_monitor(&slab, &slab_mon);
+        mon_p->slab_size = slab_mon.total_size;
+        mon_p->slab_free_size = slab_mon.free_size;
+    }
+#endif
+
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
     if(mon_p->free_size > 0) {
@@ -268,6 +346,18 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #endif
 }
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+/**
+ * Give information about the size classes of the slab allocator
+ * @param mon_p pointer to a lv_mem_slab_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_mem_monitor_slab(lv_mem_slab_monitor_t * mon_p)
+{
+    if(slab_en) lv_mem_slab_monitor(&slab, mon_p);
+    else lv_memset_00(mon_p, sizeof(lv_mem_slab_monitor_t));
+}
+#endif
 
 /**
  * Get a temporal buffer with the given size.
@@ -279,6 +369,13 @@ void * lv_mem_buf_get(uint32_t size)
 
     MEM_TRACE("begin, getting %d bytes", size);
 
+    buf_mon.get_cnt++;
+
+#if LV_MEM_BUF_ARENA_SIZE
+    void * arena_buf = buf_arena_get(size);
+    if(arena_buf) return arena_buf;
+#endif
+
     /*Try to find a free buffer with suitable size*/
     int8_t i_guess = -1;
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
@@ -315,6 +412,8 @@ void * lv_mem_buf_get(uint32_t size)
             LV_GC_ROOT(lv_mem_buf[i]).used = 1;
             LV_GC_ROOT(lv_mem_buf[i]).size = size;
             LV_GC_ROOT(lv_mem_buf[i]).p    = buf;
+            buf_mon.heap_alloc_cnt++;
+            buf_mon.heap_max_size = LV_MAX(buf_mon.heap_max_size, size);
             MEM_TRACE("allocated (buffer id: %d, address: %p)", i, LV_GC_ROOT(lv_mem_buf[i]).p);
             return LV_GC_ROOT(lv_mem_buf[i]).p;
         }
@@ -333,6 +432,10 @@ void lv_mem_buf_release(void * p)
 {
     MEM_TRACE("begin (address: %p)", p);
 
+#if LV_MEM_BUF_ARENA_SIZE
+    if(buf_arena_release(p)) return;
+#endif
+
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
         if(LV_GC_ROOT(lv_mem_buf[i]).p == p) {
             LV_GC_ROOT(lv_mem_buf[i]).used = 0;
@@ -348,6 +451,11 @@ void lv_mem_buf_release(void * p)
  */
 void lv_mem_buf_free_all(void)
 {
+#if LV_MEM_BUF_ARENA_SIZE
+    buf_arena_top = 0;
+    buf_arena_last = BUF_ARENA_NONE;
+#endif
+
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
         if(LV_GC_ROOT(lv_mem_buf[i]).p) {
             lv_mem_free(LV_GC_ROOT(lv_mem_buf[i]).p);
@@ -358,6 +466,31 @@ void lv_mem_buf_free_all(void)
     }
 }
 
+/**
+ * Give information about the temporary buffers
+ * @param mon_p pointer to a lv_mem_buf_monitor_t variable,
+ *              the result will be stored here
+ */
+void lv_mem_buf_monitor(lv_mem_buf_monitor_t * mon_p)
+{
+    *mon_p = buf_mon;
+#if LV_MEM_BUF_ARENA_SIZE
+    mon_p->arena_size = LV_MEM_BUF_ARENA_SIZE;
+    mon_p->arena_used = buf_arena_top;
+#endif
+}
+
+/**
+ * Reset the counters and the high-water marks of the temporary buffers
+ */
+void lv_mem_buf_monitor_reset(void)
+{
+    lv_memset_00(&buf_mon, sizeof(buf_mon));
+#if LV_MEM_BUF_ARENA_SIZE
+    buf_mon.arena_max_used = buf_arena_top;
+#endif
+}
+
 #if LV_MEMCPY_MEMSET_STD == 0
 /**
  * Same as `memcpy` but optimized for 4 byte operation.
@@ -547,6 +680,43 @@ void LV_ATTRIBUTE_FAST_MEM lv_memset_ff(void * dst, size_t len)
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_MEM_BUF_ARENA_SIZE
+static void * buf_arena_get(uint32_t size)
+{
+    uint32_t need = sizeof(lv_mem_buf_arena_hdr_t) + ((size + 7) & ~7U);
+    if(size > LV_MEM_BUF_ARENA_SIZE || need > LV_MEM_BUF_ARENA_SIZE - buf_arena_top) return NULL;
+
+    lv_mem_buf_arena_hdr_t * hdr = (lv_mem_buf_arena_hdr_t *)((uint8_t *)buf_arena + buf_arena_top);
+    hdr->prev = buf_arena_last;
+    hdr->used = 1;
+    buf_arena_last = buf_arena_top;
+    buf_arena_top += need;
+    buf_mon.arena_max_used = LV_MAX(buf_mon.arena_max_used, buf_arena_top);
+
+    return hdr + 1;
+}
+
+static bool buf_arena_release(void * p)
+{
+    uint8_t * arena = (uint8_t *)buf_arena;
+    if((uint8_t *)p < arena || (uint8_t *)p >= arena + sizeof(buf_arena)) return false;
+
+    lv_mem_buf_arena_hdr_t * hdr = (lv_mem_buf_arena_hdr_t *)p - 1;
+    hdr->used = 0;
+
+    /*Give back the space of the released buffers from the top.
+     *A buffer released out of order is given back when the ones above it are released too.*/
+    while(buf_arena_last != BUF_ARENA_NONE) {
+        hdr = (lv_mem_buf_arena_hdr_t *)(arena + buf_arena_last);
+        if(hdr->used) break;
+        buf_arena_top = buf_arena_last;
+        buf_arena_last = hdr->prev;
+    }
+
+    return true;
+}
+#endif
+
 #if LV_MEM_CUSTOM == 0
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
 {
@@ -20,6 +20,7 @@ extern "C" {
 #include <string.h>
 
 #include "lv_types.h"
+#include "lv_mem_slab.h"
 
 /*********************
  *      DEFINES
@@ -35,10 +36,12 @@ extern "C" {
 typedef struct {
     uint32_t total_size; /**< Total heap size*/
     uint32_t free_cnt;
-    uint32_t free_size; /**< Size of available memory*/
+    uint32_t free_size; /**< Size of available memory in the TLSF heap. The slab area counts as used*/
     uint32_t free_biggest_size;
     uint32_t used_cnt;
     uint32_t max_used; /**< Max size of Heap memory used*/
+    uint32_t slab_size; /**< Size of the area reserved for the slabs*/
+    uint32_t slab_free_size; /**< Free space in the slabs, available only for small allocations*/
     uint8_t used_pct; /**< Percentage used*/
     uint8_t frag_pct; /**< Amount of fragmentation*/
 } lv_mem_monitor_t;
@@ -51,6 +54,18 @@ typedef struct {
 
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
 
+/**
+ * Statistics of the temporary buffers
+ */
+typedef struct {
+    uint32_t arena_size; /**< Size of the static arena*/
+    uint32_t arena_used; /**< Currently used bytes of the arena*/
+    uint32_t arena_max_used; /**< High-water mark of the arena*/
+    uint32_t get_cnt; /**< Number of `lv_mem_buf_get()` calls*/
+    uint32_t heap_alloc_cnt; /**< Number of buffers (re)allocated on the heap because they didn't fit into the arena*/
+    uint32_t heap_max_size; /**< Size of the largest buffer allocated on the heap*/
+} lv_mem_buf_monitor_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -101,6 +116,15 @@ lv_res_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+/**
+ * Give information about the size classes of the slab allocator
+ * @param mon_p pointer to a lv_mem_slab_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_mem_monitor_slab(lv_mem_slab_monitor_t * mon_p);
+#endif
+
 
 /**
  * Get a temporal buffer with the given size.
@@ -119,6 +143,18 @@ void lv_mem_buf_release(void * p);
  */
 void lv_mem_buf_free_all(void);
 
+/**
+ * Give information about the temporary buffers
+ * @param mon_p pointer to a lv_mem_buf_monitor_t variable,
+ *              the result will be stored here
+ */
+void lv_mem_buf_monitor(lv_mem_buf_monitor_t * mon_p);
+
+/**
+ * Reset the counters and the high-water marks of the temporary buffers
+ */
+void lv_mem_buf_monitor_reset(void);
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
@@ -0,0 +1,212 @@
+/**
+ * @file lv_mem_slab.c
+ * Slab allocator for the small allocations in a reserved area of a TLSF heap.
+ * The pages are aligned to their size so the page of a slot is found by masking its address.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_mem_slab.h"
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+
+#include "lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define PAGE_MASK       (~((lv_uintptr_t)LV_MEM_SLAB_PAGE_SIZE - 1))
+#define PAGE_HDR_SIZE   ((sizeof(lv_mem_slab_page_t) + 7) & ~(size_t)7)
+#define SLOT_CNT(size)  ((LV_MEM_SLAB_PAGE_SIZE - PAGE_HDR_SIZE) / (size))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct _lv_mem_slab_page_t {
+    struct _lv_mem_slab_page_t * prev;
+    struct _lv_mem_slab_page_t * next;
+    void * free_list;       /*Freed slots, linked through their first word*/
+    uint16_t used_cnt;
+    uint16_t init_cnt;      /*Slots after this index were never used, they are not in `free_list`*/
+    uint8_t class_id;
+} lv_mem_slab_page_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_mem_slab_page_t * page_get(lv_mem_slab_t * slab);
+static void page_unlink(lv_mem_slab_class_t * cls, lv_mem_slab_page_t * page);
+static void page_link(lv_mem_slab_class_t * cls, lv_mem_slab_page_t * page);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint16_t class_size[LV_MEM_SLAB_CLASS_CNT] = {8, 16, 24, 32, 48, 64, 96};
+
+static const uint16_t class_slot_cnt[LV_MEM_SLAB_CLASS_CNT] = {
+    SLOT_CNT(8), SLOT_CNT(16), SLOT_CNT(24), SLOT_CNT(32), SLOT_CNT(48), SLOT_CNT(64), SLOT_CNT(96)
+};
+
+/*Size class of the sizes rounded up to 8 bytes (index: size / 8)*/
+static const uint8_t class_of_size8[LV_MEM_SLAB_SIZE_MAX / 8 + 1] = {0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool lv_mem_slab_init(lv_mem_slab_t * slab, lv_tlsf_t tlsf, size_t size)
+{
+    lv_memset_00(slab, sizeof(lv_mem_slab_t));
+    slab->tlsf = tlsf;
+
+    size &= PAGE_MASK;
+    if(size == 0) return false;
+
+    slab->area = lv_tlsf_memalign(tlsf, LV_MEM_SLAB_PAGE_SIZE, size);
+    if(slab->area == NULL) return false;
+
+    slab->page_cnt = size / LV_MEM_SLAB_PAGE_SIZE;
+    return true;
+}
+
+void lv_mem_slab_deinit(lv_mem_slab_t * slab)
+{
+    if(slab->area) lv_tlsf_free(slab->tlsf, slab->area);
+    lv_memset_00(slab, sizeof(lv_mem_slab_t));
+}
+
+void * lv_mem_slab_alloc(lv_mem_slab_t * slab, size_t size)
+{
+    uint32_t class_id = class_of_size8[(size + 7) >> 3];
+    lv_mem_slab_class_t * cls = &slab->classes[class_id];
+
+    lv_mem_slab_page_t * page = cls->partial;
+    if(page == NULL) {
+        page = page_get(slab);
+        if(page == NULL) return NULL;
+
+        page->free_list = NULL;
+        page->used_cnt = 0;
+        page->init_cnt = 0;
+        page->class_id = class_id;
+        page_link(cls, page);
+        cls->page_cnt++;
+    }
+
+    void * p;
+    if(page->free_list) {
+        p = page->free_list;
+        page->free_list = *((void **)p);
+    }
+    else {
+        p = (uint8_t *)page + PAGE_HDR_SIZE + page->init_cnt * class_size[class_id];
+        page->init_cnt++;
+    }
+
+    page->used_cnt++;
+    if(page->used_cnt == class_slot_cnt[class_id]) page_unlink(cls, page);
+
+    cls->used_cnt++;
+    cls->alloc_cnt++;
+    return p;
+}
+
+size_t lv_mem_slab_free(lv_mem_slab_t * slab, void * p)
+{
+    lv_mem_slab_page_t * page = (lv_mem_slab_page_t *)((lv_uintptr_t)p & PAGE_MASK);
+    uint32_t class_id = page->class_id;
+    lv_mem_slab_class_t * cls = &slab->classes[class_id];
+
+    /*A full page is not in the list of the class, add it as it gets a free slot now*/
+    if(page->used_cnt == class_slot_cnt[class_id]) page_link(cls, page);
+
+    *((void **)p) = page->free_list;
+    page->free_list = p;
+    page->used_cnt--;
+    cls->used_cnt--;
+
+    /*Give the empty page to any size class*/
+    if(page->used_cnt == 0) {
+        page_unlink(cls, page);
+        cls->page_cnt--;
+        page->next = slab->free_pages;
+        slab->free_pages = page;
+        slab->free_page_cnt++;
+    }
+
+    return class_size[class_id];
+}
+
+size_t lv_mem_slab_get_slot_size(const lv_mem_slab_t * slab, const void * p)
+{
+    LV_UNUSED(slab);
+    const lv_mem_slab_page_t * page = (const lv_mem_slab_page_t *)((lv_uintptr_t)p & PAGE_MASK);
+    return class_size[page->class_id];
+}
+
+void lv_mem_slab_monitor(const lv_mem_slab_t * slab, lv_mem_slab_monitor_t * mon_p)
+{
+    lv_memset_00(mon_p, sizeof(lv_mem_slab_monitor_t));
+
+    mon_p->total_size = slab->page_cnt * LV_MEM_SLAB_PAGE_SIZE;
+    mon_p->free_page_cnt = slab->free_page_cnt + slab->page_cnt - slab->page_init_cnt;
+    mon_p->free_size = mon_p->free_page_cnt * LV_MEM_SLAB_PAGE_SIZE;
+
+    uint32_t i;
+    for(i = 0; i < LV_MEM_SLAB_CLASS_CNT; i++) {
+        const lv_mem_slab_class_t * cls = &slab->classes[i];
+        lv_mem_slab_class_monitor_t * cls_mon = &mon_p->classes[i];
+        cls_mon->obj_size = class_size[i];
+        cls_mon->page_cnt = cls->page_cnt;
+        cls_mon->used_cnt = cls->used_cnt;
+        cls_mon->free_cnt = cls->page_cnt * class_slot_cnt[i] - cls->used_cnt;
+        cls_mon->alloc_cnt = cls->alloc_cnt;
+
+        mon_p->free_size += cls_mon->free_cnt * class_size[i];
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_mem_slab_page_t * page_get(lv_mem_slab_t * slab)
+{
+    lv_mem_slab_page_t * page = slab->free_pages;
+    if(page) {
+        slab->free_pages = page->next;
+        slab->free_page_cnt--;
+        return page;
+    }
+
+    if(slab->page_init_cnt < slab->page_cnt) {
+        page = (lv_mem_slab_page_t *)(slab->area + slab->page_init_cnt * LV_MEM_SLAB_PAGE_SIZE);
+        slab->page_init_cnt++;
+        return page;
+    }
+
+    return NULL;
+}
+
+static void page_unlink(lv_mem_slab_class_t * cls, lv_mem_slab_page_t * page)
+{
+    if(page->prev) page->prev->next = page->next;
+    else cls->partial = page->next;
+    if(page->next) page->next->prev = page->prev;
+    page->prev = NULL;
+    page->next = NULL;
+}
+
+static void page_link(lv_mem_slab_class_t * cls, lv_mem_slab_page_t * page)
+{
+    page->prev = NULL;
+    page->next = cls->partial;
+    if(cls->partial) cls->partial->prev = page;
+    cls->partial = page;
+}
+
+#endif /*LV_MEM_CUSTOM == 0 && LV_MEM_SLAB*/
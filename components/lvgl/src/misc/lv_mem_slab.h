@@ -0,0 +1,156 @@
+/**
+ * @file lv_mem_slab.h
+ * Slab allocator for the small allocations in a reserved area of a TLSF heap.
+ */
+
+#ifndef LV_MEM_SLAB_H
+#define LV_MEM_SLAB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "lv_tlsf.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Number of size classes: 8, 16, 24, 32, 48, 64 and 96 bytes*/
+#define LV_MEM_SLAB_CLASS_CNT   7
+
+/*Allocations larger than this are not served by the slabs*/
+#define LV_MEM_SLAB_SIZE_MAX    96
+
+#if (LV_MEM_SLAB_PAGE_SIZE & (LV_MEM_SLAB_PAGE_SIZE - 1)) != 0 || LV_MEM_SLAB_PAGE_SIZE < 256
+#error "LV_MEM_SLAB_PAGE_SIZE must be a power of 2 and at least 256"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_mem_slab_page_t;
+
+typedef struct {
+    struct _lv_mem_slab_page_t * partial;  /**< Pages having free slots*/
+    uint32_t page_cnt;
+    uint32_t used_cnt;
+    uint32_t alloc_cnt;
+} lv_mem_slab_class_t;
+
+/**
+ * A slab allocator. It reserves an area from a TLSF heap, splits it to pages of
+ * `LV_MEM_SLAB_PAGE_SIZE` bytes and cuts the pages into equal slots.
+ * The empty pages can be used by any size class.
+ */
+typedef struct {
+    lv_tlsf_t tlsf;
+    uint8_t * area;
+    uint32_t page_cnt;              /**< Number of pages in the area*/
+    uint32_t page_init_cnt;         /**< Pages after this index were never used*/
+    struct _lv_mem_slab_page_t * free_pages;
+    uint32_t free_page_cnt;
+    lv_mem_slab_class_t classes[LV_MEM_SLAB_CLASS_CNT];
+} lv_mem_slab_t;
+
+/**
+ * Statistics of a size class
+ */
+typedef struct {
+    uint16_t obj_size;      /**< Size of the slots*/
+    uint16_t page_cnt;      /**< Number of pages used by the class*/
+    uint32_t used_cnt;      /**< Number of allocated slots*/
+    uint32_t free_cnt;      /**< Number of free slots in the pages of the class*/
+    uint32_t alloc_cnt;     /**< Number of allocations since the initialization*/
+} lv_mem_slab_class_monitor_t;
+
+typedef struct {
+    lv_mem_slab_class_monitor_t classes[LV_MEM_SLAB_CLASS_CNT];
+    uint32_t total_size;    /**< Size of the reserved area*/
+    uint32_t free_size;     /**< Size of the free slots and free pages*/
+    uint32_t free_page_cnt; /**< Number of pages not used by any size class*/
+} lv_mem_slab_monitor_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a slab allocator and reserve its area from a TLSF heap
+ * @param slab      pointer to an `lv_mem_slab_t` variable to initialize
+ * @param tlsf      the TLSF heap to take the area from
+ * @param size      size of the area in bytes. It's rounded down to whole pages.
+ * @return          `true`: success; `false`: the area couldn't be allocated
+ */
+bool lv_mem_slab_init(lv_mem_slab_t * slab, lv_tlsf_t tlsf, size_t size);
+
+/**
+ * Give back the area of a slab allocator to its TLSF heap
+ * @param slab      pointer to a slab allocator
+ */
+void lv_mem_slab_deinit(lv_mem_slab_t * slab);
+
+/**
+ * Allocate a slot from the smallest size class which fits `size`
+ * @param slab      pointer to a slab allocator
+ * @param size      the required size. Must be `<= LV_MEM_SLAB_SIZE_MAX`
+ * @return          pointer to the allocated memory or NULL if the area is full
+ */
+void * lv_mem_slab_alloc(lv_mem_slab_t * slab, size_t size);
+
+/**
+ * Free a slot allocated by `lv_mem_slab_alloc`
+ * @param slab      pointer to a slab allocator
+ * @param p         pointer to the slot
+ * @return          the size of the freed slot
+ */
+size_t lv_mem_slab_free(lv_mem_slab_t * slab, void * p);
+
+/**
+ * Get the size of a slot
+ * @param slab      pointer to a slab allocator
+ * @param p         pointer to a slot
+ * @return          the size of the slot's size class
+ */
+size_t lv_mem_slab_get_slot_size(const lv_mem_slab_t * slab, const void * p);
+
+/**
+ * Collect the statistics of a slab allocator
+ * @param slab      pointer to a slab allocator
+ * @param mon_p     the result will be stored here
+ */
+void lv_mem_slab_monitor(const lv_mem_slab_t * slab, lv_mem_slab_monitor_t * mon_p);
+
+/**
+ * Check if a memory is a slot of the slab allocator
+ * @param slab      pointer to a slab allocator
+ * @param p         pointer to a memory allocated from the slab allocator or from its TLSF heap
+ * @return          `true`: `p` is a slab slot
+ */
+static inline bool lv_mem_slab_is_slot(const lv_mem_slab_t * slab, const void * p)
+{
+    return (const uint8_t *)p >= slab->area &&
+           (const uint8_t *)p < slab->area + slab->page_cnt * LV_MEM_SLAB_PAGE_SIZE;
+}
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_MEM_CUSTOM == 0 && LV_MEM_SLAB*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_MEM_SLAB_H*/
@@ -11,6 +11,7 @@ CSRCS += lv_log.c
 CSRCS += lv_lru.c
 CSRCS += lv_math.c
 CSRCS += lv_mem.c
+CSRCS += lv_mem_slab.c
 CSRCS += lv_printf.c
 CSRCS += lv_style.c
 CSRCS += lv_style_gen.c
@@ -19,6 +20,7 @@ CSRCS += lv_tlsf.c
 CSRCS += lv_txt.c
 CSRCS += lv_txt_ap.c
 CSRCS += lv_utils.c
+CSRCS += lv_vec.c
 
 DEPPATH += --dep-path $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/misc
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/misc
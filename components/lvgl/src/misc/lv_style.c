@@ -133,6 +133,11 @@ const uint8_t _lv_style_builtin_prop_flag_lookup_table[_LV_STYLE_NUM_BUILT_IN_PR
 
 uint32_t _lv_style_custom_prop_flag_lookup_table_size = 0;
 
+#if LV_OBJ_STYLE_CACHE
+/*Incremented on every change which can modify a resolved style value. See `_lv_style_cache_invalidate()`*/
+uint32_t _lv_style_cache_gen = 0;
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -160,6 +165,7 @@ void lv_style_init(lv_style_t * style)
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
+    _lv_style_cache_invalidate();
 }
 
 void lv_style_reset(lv_style_t * style)
@@ -176,6 +182,7 @@ void lv_style_reset(lv_style_t * style)
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
+    _lv_style_cache_invalidate();
 }
 
 lv_style_prop_t lv_style_register_prop(uint8_t flag)
@@ -230,6 +237,8 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 
     if(style->prop_cnt == 0)  return false;
 
+    _lv_style_cache_invalidate();
+
     if(style->prop_cnt == 1) {
         if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop) {
             style->prop1 = LV_STYLE_PROP_INV;
@@ -280,6 +289,34 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
     return false;
 }
 
+void lv_style_freeze(lv_style_t * style)
+{
+    LV_ASSERT_STYLE(style);
+
+    if(style->prop1 == LV_STYLE_PROP_ANY) return;
+    if(style->prop_cnt < 2 || style->prop1 == _LV_STYLE_PROP_FROZEN) return;
+
+    uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    uint16_t * props = (uint16_t *)tmp;
+    lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
+
+    /*Insertion sort as there are only a few props in a style*/
+    int32_t i;
+    for(i = 1; i < style->prop_cnt; i++) {
+        uint16_t prop = props[i];
+        lv_style_value_t value = values[i];
+        int32_t j;
+        for(j = i - 1; j >= 0 && LV_STYLE_PROP_ID_MASK(props[j]) > LV_STYLE_PROP_ID_MASK(prop); j--) {
+            props[j + 1] = props[j];
+            values[j + 1] = values[j];
+        }
+        props[j + 1] = prop;
+        values[j + 1] = value;
+    }
+
+    style->prop1 = _LV_STYLE_PROP_FROZEN;
+}
+
 void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
 {
     lv_style_set_prop_internal(style, prop, value, lv_style_set_prop_helper);
@@ -422,18 +459,18 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
         return;
     }
 
+    _lv_style_cache_invalidate();
+
     lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(prop_and_meta);
 
     if(style->prop_cnt > 1) {
         uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         uint16_t * props = (uint16_t *)tmp;
-        int32_t i;
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            if(LV_STYLE_PROP_ID_MASK(props[i]) == prop_id) {
-                lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
-                value_adjustment_helper(prop_and_meta, value, &props[i], &values[i]);
-                return;
-            }
+        int32_t i = _lv_style_find_prop(style, props, prop_id);
+        if(i >= 0) {
+            lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
+            value_adjustment_helper(prop_and_meta, value, &props[i], &values[i]);
+            return;
         }
 
         size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
@@ -454,8 +491,17 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
         props = (uint16_t *)tmp;
         lv_style_value_t * values = (lv_style_value_t *)values_and_props;
 
+        /*Frozen styles are kept sorted so insert the new property to its place*/
+        int32_t pos = style->prop_cnt - 1;
+        if(style->prop1 == _LV_STYLE_PROP_FROZEN) {
+            for(; pos > 0 && LV_STYLE_PROP_ID_MASK(props[pos - 1]) > prop_id; pos--) {
+                props[pos] = props[pos - 1];
+                values[pos] = values[pos - 1];
+            }
+        }
+
         /*Set the new property and value*/
-        value_adjustment_helper(prop_and_meta, value, &props[style->prop_cnt - 1], &values[style->prop_cnt - 1]);
+        value_adjustment_helper(prop_and_meta, value, &props[pos], &values[pos]);
     }
     else if(style->prop_cnt == 1) {
         if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop_id) {
@@ -281,7 +281,8 @@ typedef enum {
     _LV_STYLE_NUM_BUILT_IN_PROPS     = _LV_STYLE_LAST_BUILT_IN_PROP + 1,
 
     LV_STYLE_PROP_ANY                = 0xFFFF,
-    _LV_STYLE_PROP_CONST             = 0xFFFF /* magic value for const styles */
+    _LV_STYLE_PROP_CONST             = 0xFFFF, /* magic value for const styles */
+    _LV_STYLE_PROP_FROZEN            = 0xFFFE  /* magic value for frozen (sorted) styles */
 } lv_style_prop_t;
 
 enum {
@@ -330,7 +331,7 @@ typedef struct {
         const lv_style_const_prop_t * const_props;
     } v_p;
 
-    uint16_t prop1;
+    uint16_t prop1;     /*The single property, or `_LV_STYLE_PROP_FROZEN` if the props are sorted by ID*/
     uint8_t has_group;
     uint8_t prop_cnt;
 } lv_style_t;
@@ -383,6 +384,15 @@ lv_style_prop_t lv_style_get_num_custom_props(void);
  */
 bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop);
 
+/**
+ * Sort the properties of a style by their ID to find them by binary search instead of a linear scan.
+ * Call it when the style is fully set up, e.g. after creating the styles of the application.
+ * The style can still be modified: new properties are inserted to keep the order.
+ * @param style pointer to a style
+ * @note Constant styles and styles with less than 2 properties are not changed.
+ */
+void lv_style_freeze(lv_style_t * style);
+
 /**
  * Set the value of property in a style.
  * This function shouldn't be used directly by the user.
@@ -436,6 +446,35 @@ void lv_style_transition_dsc_init(lv_style_transition_dsc_t * tr, const lv_style
  */
 lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 
+/**
+ * Find the index of a property in the props array of a style with more than 1 property
+ * @param style pointer to a (non const) style with `prop_cnt > 1`
+ * @param props pointer to the props array of the style
+ * @param prop  the ID of a property
+ * @return the index of the property or -1 if it wasn't found
+ */
+static inline int32_t _lv_style_find_prop(const lv_style_t * style, const uint16_t * props, lv_style_prop_t prop)
+{
+    if(style->prop1 == _LV_STYLE_PROP_FROZEN) {
+        int32_t min = 0;
+        int32_t max = style->prop_cnt - 1;
+        while(min <= max) {
+            int32_t mid = (min + max) >> 1;
+            lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(props[mid]);
+            if(prop_id < prop) min = mid + 1;
+            else if(prop_id > prop) max = mid - 1;
+            else return mid;
+        }
+        return -1;
+    }
+
+    int32_t i;
+    for(i = 0; i < style->prop_cnt; i++) {
+        if(LV_STYLE_PROP_ID_MASK(props[i]) == prop) return i;
+    }
+    return -1;
+}
+
 /**
  * Get the value of a property
  * @param style pointer to a style
@@ -470,20 +509,17 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
     if(style->prop_cnt > 1) {
         uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         uint16_t * props = (uint16_t *)tmp;
-        uint32_t i;
-        for(i = 0; i < style->prop_cnt; i++) {
-            lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(props[i]);
-            if(prop_id == prop) {
-                if(props[i] & LV_STYLE_PROP_META_INHERIT)
-                    return LV_STYLE_RES_INHERIT;
-                if(props[i] & LV_STYLE_PROP_META_INITIAL)
-                    *value = lv_style_prop_get_default(prop_id);
-                else {
-                    lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
-                    *value = values[i];
-                }
-                return LV_STYLE_RES_FOUND;
+        int32_t i = _lv_style_find_prop(style, props, prop);
+        if(i >= 0) {
+            if(props[i] & LV_STYLE_PROP_META_INHERIT)
+                return LV_STYLE_RES_INHERIT;
+            if(props[i] & LV_STYLE_PROP_META_INITIAL)
+                *value = lv_style_prop_get_default(prop);
+            else {
+                lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
+                *value = values[i];
             }
+            return LV_STYLE_RES_FOUND;
         }
     }
     else if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop) {
@@ -519,6 +555,18 @@ uint8_t _lv_style_get_prop_group(lv_style_prop_t prop);
  */
 uint8_t _lv_style_prop_lookup_flags(lv_style_prop_t prop);
 
+/**
+ * Invalidate all the resolved style values cached by `LV_OBJ_STYLE_CACHE`.
+ * Called when a style or anything else the resolved values depend on is changed.
+ */
+static inline void _lv_style_cache_invalidate(void)
+{
+#if LV_OBJ_STYLE_CACHE
+    extern uint32_t _lv_style_cache_gen;
+    _lv_style_cache_gen++;
+#endif
+}
+
 #include "lv_style_gen.h"
 
 static inline void lv_style_set_size(lv_style_t * style, lv_coord_t value)
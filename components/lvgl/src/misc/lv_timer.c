@@ -9,14 +9,18 @@
 #include "../hal/lv_hal_tick.h"
 #include "lv_assert.h"
 #include "lv_mem.h"
-#include "lv_ll.h"
 #include "lv_gc.h"
+#include "lv_math.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_DEF_CAPACITY 8
+
+/*Deadlines are compared as signed differences so longer periods are clamped*/
+#define PERIOD_MAX ((uint32_t)INT32_MAX)
 
 /**********************
  *      TYPEDEFS
@@ -25,16 +29,26 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static uint32_t timer_get_deadline(const lv_timer_t * timer);
+static bool timer_is_before(const lv_timer_t * a, const lv_timer_t * b);
+static bool timer_heap_reserve(uint32_t cnt);
+static void timer_heap_insert(lv_timer_t * timer);
+static void timer_heap_remove(lv_timer_t * timer);
+static void timer_heap_reschedule(lv_timer_t * timer);
+static void timer_heap_sift_up(uint32_t i);
+static void timer_heap_sift_down(uint32_t i);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
-static bool timer_deleted;
-static bool timer_created;
+static uint32_t timer_cnt;      /*Number of all timers, including the paused ones*/
+static uint32_t heap_cnt;       /*Number of scheduled (not paused) timers in the heap*/
+static uint32_t heap_capacity;
+static uint32_t heap_seq;       /*Incremented on every insertion to break ties between equal deadlines*/
 
 /**********************
  *      MACROS
@@ -54,7 +68,12 @@ static bool timer_created;
  */
 void _lv_timer_core_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    lv_ilist_init(&LV_GC_ROOT(_lv_timer_list));
+    LV_GC_ROOT(_lv_timer_heap) = NULL;
+    timer_cnt = 0;
+    heap_cnt = 0;
+    heap_capacity = 0;
+    heap_seq = 0;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -95,41 +114,29 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
-
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
+    /*Run the timers which were due when the handler started in the order of their deadlines.
+     *The timers executed, created or rescheduled in this call get a newer sequence number and run in the next call.
+     *If such a timer is due (e.g. `lv_timer_ready()` was called in a callback) its deadline is moved to
+     *`handler_start` so that it gets behind the other due timers. If it gets to the top anyway
+     *all the due timers were handled.*/
+    uint32_t seq_start = heap_seq;
+    while(heap_cnt > 0) {
+        lv_timer_t * timer = LV_GC_ROOT(_lv_timer_heap)[0];
+        int32_t late = (int32_t)(handler_start - timer_get_deadline(timer));
+        if(late < 0) break;
+
+        if((int32_t)(timer->heap_seq - seq_start) >= 0) {
+            if(late == 0) break;
+            timer->last_run = handler_start - timer->period;
+            timer_heap_reschedule(timer);
+            continue;
         }
 
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+        lv_timer_exec(timer);
     }
 
+    uint32_t time_till_next = lv_timer_get_time_until_next();
+
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
     if(idle_period_time >= IDLE_MEAS_PERIOD) {
@@ -168,18 +175,23 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
-    new_timer = _lv_ll_ins_head(&LV_GC_ROOT(_lv_timer_ll));
+    /*Reserve place in the heap for the paused timers too so that resuming can't fail*/
+    if(!timer_heap_reserve(timer_cnt + 1)) return NULL;
+
+    new_timer = lv_mem_alloc(sizeof(lv_timer_t));
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
+    lv_ilist_ins_head(&LV_GC_ROOT(_lv_timer_list), &new_timer->node);
 
-    new_timer->period = period;
+    new_timer->period = LV_MIN(period, PERIOD_MAX);
     new_timer->timer_cb = timer_xcb;
     new_timer->repeat_count = -1;
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
 
-    timer_created = true;
+    timer_cnt++;
+    timer_heap_insert(new_timer);
 
     return new_timer;
 }
@@ -200,8 +212,12 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
  */
 void lv_timer_del(lv_timer_t * timer)
 {
-    _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
-    timer_deleted = true;
+    if(!timer->paused) timer_heap_remove(timer);
+    lv_ilist_remove(&LV_GC_ROOT(_lv_timer_list), &timer->node);
+    timer_cnt--;
+
+    /*Let the timer handler know that the running timer was deleted*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) LV_GC_ROOT(_lv_timer_act) = NULL;
 
     lv_mem_free(timer);
 }
@@ -212,12 +228,16 @@ void lv_timer_del(lv_timer_t * timer)
  */
 void lv_timer_pause(lv_timer_t * timer)
 {
+    if(timer->paused) return;
     timer->paused = true;
+    timer_heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
+    if(!timer->paused) return;
     timer->paused = false;
+    timer_heap_insert(timer);
 }
 
 /**
@@ -227,7 +247,8 @@ void lv_timer_resume(lv_timer_t * timer)
  */
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
-    timer->period = period;
+    timer->period = LV_MIN(period, PERIOD_MAX);
+    timer_heap_reschedule(timer);
 }
 
 /**
@@ -237,6 +258,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    timer_heap_reschedule(timer);
 }
 
 /**
@@ -247,6 +269,9 @@ void lv_timer_ready(lv_timer_t * timer)
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     timer->repeat_count = repeat_count;
+
+    /*Let the timer handler delete it in its next call*/
+    if(repeat_count == 0) lv_timer_ready(timer);
 }
 
 /**
@@ -257,6 +282,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    timer_heap_reschedule(timer);
 }
 
 /**
@@ -277,6 +303,16 @@ uint8_t lv_timer_get_idle(void)
     return idle_last;
 }
 
+/**
+ * Get the time remaining until the next timer will run
+ * @return the time remaining in ms or `LV_NO_TIMER_READY` if there are no running timers
+ */
+uint32_t lv_timer_get_time_until_next(void)
+{
+    if(heap_cnt == 0) return LV_NO_TIMER_READY;
+    return lv_timer_time_remaining(LV_GC_ROOT(_lv_timer_heap)[0]);
+}
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
@@ -284,8 +320,8 @@ uint8_t lv_timer_get_idle(void)
  */
 lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
 {
-    if(timer == NULL) return _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    else return _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), timer);
+    lv_ilist_node_t * node = timer ? timer->node.next : LV_GC_ROOT(_lv_timer_list).head;
+    return node ? lv_ilist_entry(node, lv_timer_t, node) : NULL;
 }
 
 /**********************
@@ -293,37 +329,33 @@ lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
+ * Execute a timer whose deadline has passed and schedule its next run
  * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(lv_timer_t * timer)
 {
-    if(timer->paused) return false;
-
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
-        TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
-    }
+    LV_GC_ROOT(_lv_timer_act) = timer;
+
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted in the callback the repeat count is zero
+     * and `lv_timer_del` clears `_lv_timer_act`*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    timer_heap_reschedule(timer);
+    TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
+    if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
+    TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
+    LV_ASSERT_MEM_INTEGRITY();
 
-    if(timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             TIMER_TRACE("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
             lv_timer_del(timer);
         }
     }
 
-    return exec;
+    LV_GC_ROOT(_lv_timer_act) = NULL;
 }
 
 /**
@@ -339,3 +371,115 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
         return 0;
     return timer->period - elp;
 }
+
+/**
+ * Get the tick when a timer needs to run next
+ * @param timer pointer to lv_timer
+ * @return the tick of the deadline. Compare it only as signed difference as it can overflow.
+ */
+static uint32_t timer_get_deadline(const lv_timer_t * timer)
+{
+    return timer->last_run + timer->period;
+}
+
+/**
+ * Tell if a timer needs to run before an other one
+ * @param a pointer to lv_timer
+ * @param b pointer to lv_timer
+ * @return true: `a` has earlier deadline, or the same deadline but was scheduled earlier
+ */
+static bool timer_is_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    int32_t diff = (int32_t)(timer_get_deadline(a) - timer_get_deadline(b));
+    if(diff != 0) return diff < 0;
+    return (int32_t)(a->heap_seq - b->heap_seq) < 0;
+}
+
+/**
+ * Make sure the heap can store a given number of timers
+ * @param cnt number of timers
+ * @return true: success; false: out of memory
+ */
+static bool timer_heap_reserve(uint32_t cnt)
+{
+    if(cnt <= heap_capacity) return true;
+
+    uint32_t new_capacity = heap_capacity == 0 ? HEAP_DEF_CAPACITY : heap_capacity * 2;
+    lv_timer_t ** new_heap = lv_mem_realloc(LV_GC_ROOT(_lv_timer_heap), new_capacity * sizeof(lv_timer_t *));
+    LV_ASSERT_MALLOC(new_heap);
+    if(new_heap == NULL) return false;
+
+    LV_GC_ROOT(_lv_timer_heap) = new_heap;
+    heap_capacity = new_capacity;
+    return true;
+}
+
+static void timer_heap_insert(lv_timer_t * timer)
+{
+    LV_ASSERT(heap_cnt < heap_capacity);
+
+    timer->heap_seq = heap_seq++;
+    timer->heap_index = heap_cnt;
+    LV_GC_ROOT(_lv_timer_heap)[heap_cnt] = timer;
+    heap_cnt++;
+    timer_heap_sift_up(timer->heap_index);
+}
+
+static void timer_heap_remove(lv_timer_t * timer)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    uint32_t i = timer->heap_index;
+    LV_ASSERT(i < heap_cnt && heap[i] == timer);
+
+    heap_cnt--;
+    if(i == heap_cnt) return;
+
+    /*Move the last timer to the place of the removed one and restore the heap property*/
+    heap[i] = heap[heap_cnt];
+    heap[i]->heap_index = i;
+    if(i > 0 && timer_is_before(heap[i], heap[(i - 1) / 2])) timer_heap_sift_up(i);
+    else timer_heap_sift_down(i);
+}
+
+/**
+ * Update the place of a timer in the heap after its deadline has changed
+ * @param timer pointer to lv_timer
+ */
+static void timer_heap_reschedule(lv_timer_t * timer)
+{
+    if(timer->paused) return;
+    timer_heap_remove(timer);
+    timer_heap_insert(timer);
+}
+
+static void timer_heap_sift_up(uint32_t i)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!timer_is_before(timer, heap[parent])) break;
+        heap[i] = heap[parent];
+        heap[i]->heap_index = i;
+        i = parent;
+    }
+    heap[i] = timer;
+    timer->heap_index = i;
+}
+
+static void timer_heap_sift_down(uint32_t i)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[i];
+    while(1) {
+        uint32_t child = 2 * i + 1;
+        if(child >= heap_cnt) break;
+        if(child + 1 < heap_cnt && timer_is_before(heap[child + 1], heap[child])) child++;
+        if(!timer_is_before(heap[child], timer)) break;
+        heap[i] = heap[child];
+        heap[i]->heap_index = i;
+        i = child;
+    }
+    heap[i] = timer;
+    timer->heap_index = i;
+}
@@ -14,6 +14,7 @@ extern "C" {
  *********************/
 #include "../lv_conf_internal.h"
 #include "../hal/lv_hal_tick.h"
+#include "lv_ilist.h"
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -42,11 +43,14 @@ typedef void (*lv_timer_cb_t)(struct _lv_timer_t *);
  * Descriptor of a lv_timer
  */
 typedef struct _lv_timer_t {
+    lv_ilist_node_t node; /**< Links the timers to each other (keep it the first member)*/
     uint32_t period; /**< How often the timer should run*/
     uint32_t last_run; /**< Last time the timer ran*/
     lv_timer_cb_t timer_cb; /**< Timer function*/
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
+    uint32_t heap_index; /**< Position in the scheduler's heap (only if not paused)*/
+    uint32_t heap_seq; /**< Order of scheduling among the timers with the same deadline*/
     uint32_t paused : 1;
 } lv_timer_t;
 
@@ -165,6 +169,13 @@ void lv_timer_enable(bool en);
  */
 uint8_t lv_timer_get_idle(void);
 
+/**
+ * Get the time remaining until the next timer will run.
+ * It's the same value that `lv_timer_handler()` returns, but it can be queried any time in O(1).
+ * @return the time remaining in ms or `LV_NO_TIMER_READY` if there are no running timers
+ */
+uint32_t lv_timer_get_time_until_next(void);
+
 /**
  * Iterate through the timers
  * @param timer NULL to start iteration or the previous return value to get the next timer
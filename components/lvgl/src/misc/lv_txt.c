@@ -19,13 +19,37 @@
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
 
+/*Number of letters decoded and measured at once*/
+#define LETTER_BUF_SIZE 16
+
+/*To check `sizeof(size_t)` ASCII characters at once*/
+#define WORD_SIZE       sizeof(size_t)
+#define WORD_ONES       ((size_t)-1 / 0xFF)                             /*0x0101...*/
+#define WORD_HIGH_BITS  (WORD_ONES * 0x80)                              /*0x8080...*/
+#define WORD_HAS_ZERO(w) ((((w) - WORD_ONES) & ~(w) & WORD_HIGH_BITS) != 0)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*Letters decoded and measured in advance to wrap a text faster*/
+typedef struct {
+    const char * txt;
+    uint32_t len;                           /*Length of `txt` or UINT32_MAX if unknown*/
+    const lv_font_t * font;
+    uint32_t cnt;                           /*Number of letters in the buffer*/
+    uint32_t act;                           /*Index of the next letter to read*/
+    uint32_t letters[LETTER_BUF_SIZE + 1];  /*The last is the letter after the buffered ones*/
+    uint32_t ofs[LETTER_BUF_SIZE + 1];      /*Byte index of the letters in `txt`*/
+    uint16_t widths[LETTER_BUF_SIZE];
+} letter_buf_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static uint32_t get_next_line(const char * txt, uint32_t len, const lv_font_t * font, lv_coord_t letter_space,
+                              lv_coord_t max_width, lv_coord_t * used_width, lv_text_flag_t flag);
+static void letter_buf_seek(letter_buf_t * buf, uint32_t byte_id);
 
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
     static uint8_t lv_txt_utf8_size(const char * str);
@@ -101,11 +125,12 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
 
     uint32_t line_start     = 0;
     uint32_t new_line_start = 0;
+    uint32_t len = strlen(text);
     uint16_t letter_height = lv_font_get_line_height(font);
 
     /*Calc. the height and longest line*/
     while(text[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
+        new_line_start += get_next_line(&text[line_start], len - line_start, font, letter_space, max_width, NULL, flag);
 
         if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
             LV_LOG_WARN("lv_txt_get_size: integer overflow while calculating text height");
@@ -158,8 +183,8 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
  * TODO: Returned word_w_ptr may overestimate the returned word's width when
  * max_width is reached. In current usage, this has no impact.
  *
- * @param txt a '\0' terminated string
- * @param font pointer to a font
+ * @param buf the letters of the text in which the word is
+ * @param start byte index of the word in the text
  * @param letter_space letter space
  * @param max_width max width of the text (break the lines to fit this size). Set COORD_MAX to avoid line breaks
  * @param flags settings for the text from 'txt_flag_type' enum
@@ -168,16 +193,16 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
  * @param force Force return the fraction of the word that can fit in the provided space.
  * @return the index of the first char of the next word (in byte index not letter index. With UTF-8 they are different)
  */
-static uint32_t lv_txt_get_next_word(const char * txt, const lv_font_t * font,
+static uint32_t lv_txt_get_next_word(letter_buf_t * buf, uint32_t start,
                                      lv_coord_t letter_space, lv_coord_t max_width,
                                      lv_text_flag_t flag, uint32_t * word_w_ptr, lv_text_cmd_state_t * cmd_state, bool force)
 {
-    if(txt == NULL || txt[0] == '\0') return 0;
-    if(font == NULL) return 0;
+    const char * txt = &buf->txt[start];
+    if(txt[0] == '\0') return 0;
 
     if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
 
-    uint32_t i = 0, i_next = 0, i_next_next = 0;  /*Iterating index into txt*/
+    uint32_t i = 0, i_next = 0;  /*Iterating index into txt*/
     uint32_t letter = 0;      /*Letter at i*/
     uint32_t letter_next = 0; /*Letter at i_next*/
     lv_coord_t letter_w;
@@ -186,25 +211,27 @@ static uint32_t lv_txt_get_next_word(const char * txt, const lv_font_t * font,
     uint32_t break_index = NO_BREAK_FOUND; /*only used for "long" words*/
     uint32_t break_letter_count = 0; /*Number of characters up to the long word break point*/
 
-    letter = _lv_txt_encoded_next(txt, &i_next);
-    i_next_next = i_next;
+    letter_buf_seek(buf, start);
 
     /*Obtain the full word, regardless if it fits or not in max_width*/
     while(txt[i] != '\0') {
-        letter_next = _lv_txt_encoded_next(txt, &i_next_next);
+        /*Get the letter at `i`, the one after it and its width from the buffer*/
+        if(buf->act >= buf->cnt) letter_buf_seek(buf, buf->ofs[buf->cnt]);
+        letter = buf->letters[buf->act];
+        letter_next = buf->letters[buf->act + 1];
+        letter_w = buf->widths[buf->act];
+        i_next = buf->ofs[buf->act + 1] - start;
+        buf->act++;
         word_len++;
 
         /*Handle the recolor command*/
         if((flag & LV_TEXT_FLAG_RECOLOR) != 0) {
             if(_lv_txt_is_cmd(cmd_state, letter) != false) {
                 i = i_next;
-                i_next = i_next_next;
-                letter = letter_next;
                 continue;   /*Skip the letter if it is part of a command*/
             }
         }
 
-        letter_w = lv_font_get_glyph_width(font, letter, letter_next);
         cur_w += letter_w;
 
         if(letter_w > 0) {
@@ -231,8 +258,6 @@ static uint32_t lv_txt_get_next_word(const char * txt, const lv_font_t * font,
         if(word_w_ptr != NULL && break_index == NO_BREAK_FOUND) *word_w_ptr = cur_w;
 
         i = i_next;
-        i_next = i_next_next;
-        letter = letter_next;
     }
 
     /*Entire Word fits in the provided space*/
@@ -276,9 +301,12 @@ static uint32_t lv_txt_get_next_word(const char * txt, const lv_font_t * font,
 #endif
 }
 
-uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font,
-                               lv_coord_t letter_space, lv_coord_t max_width,
-                               lv_coord_t * used_width, lv_text_flag_t flag)
+/**
+ * Get the next line of text. See `_lv_txt_get_next_line()`.
+ * @param len length of `txt` or UINT32_MAX if unknown
+ */
+static uint32_t get_next_line(const char * txt, uint32_t len, const lv_font_t * font, lv_coord_t letter_space,
+                              lv_coord_t max_width, lv_coord_t * used_width, lv_text_flag_t flag)
 {
     if(used_width) *used_width = 0;
 
@@ -304,9 +332,18 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font,
     lv_text_cmd_state_t cmd_state = LV_TEXT_CMD_STATE_WAIT;
     uint32_t i = 0;                                        /*Iterating index into txt*/
 
+    /*The letters are decoded and measured in advance for the words*/
+    letter_buf_t buf;
+    buf.txt = txt;
+    buf.len = len;
+    buf.font = font;
+    buf.cnt = 0;
+    buf.act = 0;
+    buf.ofs[0] = 0;
+
     while(txt[i] != '\0' && max_width > 0) {
         uint32_t word_w = 0;
-        uint32_t advance = lv_txt_get_next_word(&txt[i], font, letter_space, max_width, flag, &word_w, &cmd_state, i == 0);
+        uint32_t advance = lv_txt_get_next_word(&buf, i, letter_space, max_width, flag, &word_w, &cmd_state, i == 0);
         max_width -= word_w;
         line_w += word_w;
 
@@ -340,6 +377,20 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font,
     return i;
 }
 
+uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font,
+                               lv_coord_t letter_space, lv_coord_t max_width,
+                               lv_coord_t * used_width, lv_text_flag_t flag)
+{
+    return get_next_line(txt, UINT32_MAX, font, letter_space, max_width, used_width, flag);
+}
+
+uint32_t _lv_txt_get_next_line_len(const char * txt, uint32_t len, const lv_font_t * font,
+                                   lv_coord_t letter_space, lv_coord_t max_width,
+                                   lv_coord_t * used_width, lv_text_flag_t flag)
+{
+    return get_next_line(txt, len, font, letter_space, max_width, used_width, flag);
+}
+
 lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t * font, lv_coord_t letter_space,
                             lv_text_flag_t flag)
 {
@@ -350,24 +401,30 @@ lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t *
     uint32_t i                   = 0;
     lv_coord_t width             = 0;
     lv_text_cmd_state_t cmd_state = LV_TEXT_CMD_STATE_WAIT;
+    uint32_t letters[LETTER_BUF_SIZE + 1];
+    uint32_t ofs[LETTER_BUF_SIZE + 1];
+    uint16_t widths[LETTER_BUF_SIZE];
 
     if(length != 0) {
         while(i < length) {
-            uint32_t letter;
-            uint32_t letter_next;
-            _lv_txt_encoded_letter_next_2(txt, &letter, &letter_next, &i);
-
-            if((flag & LV_TEXT_FLAG_RECOLOR) != 0) {
-                if(_lv_txt_is_cmd(&cmd_state, letter) != false) {
-                    continue;
+            uint32_t cnt = _lv_txt_encoded_next_n(&txt[i], length - i, letters, ofs, LETTER_BUF_SIZE);
+            if(cnt == 0) break;
+            lv_font_get_glyph_widths(font, letters, widths, cnt);
+
+            uint32_t k;
+            for(k = 0; k < cnt; k++) {
+                if((flag & LV_TEXT_FLAG_RECOLOR) != 0) {
+                    if(_lv_txt_is_cmd(&cmd_state, letters[k]) != false) {
+                        continue;
+                    }
                 }
-            }
 
-            lv_coord_t char_width = lv_font_get_glyph_width(font, letter, letter_next);
-            if(char_width > 0) {
-                width += char_width;
-                width += letter_space;
+                if(widths[k] > 0) {
+                    width += widths[k];
+                    width += letter_space;
+                }
             }
+            i += ofs[cnt];
         }
 
         if(width > 0) {
@@ -496,6 +553,86 @@ void _lv_txt_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_t
     *letter_next = *letter != '\0' ? _lv_txt_encoded_next(&txt[*ofs], NULL) : 0;
 }
 
+uint32_t _lv_txt_encoded_next_n(const char * txt, uint32_t len, uint32_t * letters, uint32_t * ofs, uint32_t max_cnt)
+{
+    uint32_t i = 0;
+    uint32_t cnt = 0;
+
+    while(cnt < max_cnt && i < len && txt[i] != '\0') {
+#if LV_TXT_ENC == LV_TXT_ENC_UTF8
+        /*Take a whole word of ASCII letters at once. Only if the length is known
+         *as the word can't be read after the closing '\0'.*/
+        if(LV_IS_ASCII(txt[i]) && len != UINT32_MAX && len - i >= WORD_SIZE && max_cnt - cnt >= WORD_SIZE) {
+            size_t w;
+            lv_memcpy_small(&w, &txt[i], WORD_SIZE);
+            if((w & WORD_HIGH_BITS) == 0 && !WORD_HAS_ZERO(w)) {
+                uint32_t k;
+                for(k = 0; k < WORD_SIZE; k++) {
+                    letters[cnt] = (uint8_t)txt[i];
+                    ofs[cnt] = i;
+                    cnt++;
+                    i++;
+                }
+                continue;
+            }
+        }
+
+        ofs[cnt] = i;
+        if(LV_IS_ASCII(txt[i])) {
+            letters[cnt] = (uint8_t)txt[i];
+            i++;
+        }
+        else {
+            letters[cnt] = lv_txt_utf8_next(txt, &i);
+        }
+#else
+        ofs[cnt] = i;
+        letters[cnt] = _lv_txt_encoded_next(txt, &i);
+#endif
+        cnt++;
+    }
+
+    /*Peek the next letter too, e.g. for kerning*/
+    ofs[cnt] = i;
+    letters[cnt] = _lv_txt_encoded_next(&txt[i], NULL);
+
+    return cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Fill the buffer with the letters from a byte index unless it's already there
+ * and make it the next letter to read.
+ * @param buf pointer to a letter buffer
+ * @param byte_id byte index of a letter in the buffer's text
+ */
+static void letter_buf_seek(letter_buf_t * buf, uint32_t byte_id)
+{
+    /*Usually the next letter is required*/
+    if(buf->act < buf->cnt && buf->ofs[buf->act] == byte_id) return;
+
+    uint32_t k;
+    for(k = 0; k < buf->cnt; k++) {
+        if(buf->ofs[k] == byte_id) {
+            buf->act = k;
+            return;
+        }
+    }
+
+    uint32_t len = UINT32_MAX;
+    if(buf->len != UINT32_MAX) len = byte_id < buf->len ? buf->len - byte_id : 0;
+
+    buf->cnt = _lv_txt_encoded_next_n(&buf->txt[byte_id], len, buf->letters, buf->ofs, LETTER_BUF_SIZE);
+    for(k = 0; k <= buf->cnt; k++) {
+        buf->ofs[k] += byte_id;
+    }
+    lv_font_get_glyph_widths(buf->font, buf->letters, buf->widths, buf->cnt);
+    buf->act = 0;
+}
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
@@ -701,7 +838,11 @@ static uint32_t lv_txt_utf8_get_byte_id(const char * txt, uint32_t utf8_id)
     uint32_t i;
     uint32_t byte_cnt = 0;
     for(i = 0; i < utf8_id && txt[byte_cnt] != '\0'; i++) {
-        uint8_t c_size = _lv_txt_encoded_size(&txt[byte_cnt]);
+        if(LV_IS_ASCII(txt[byte_cnt])) {
+            byte_cnt++;
+            continue;
+        }
+        uint8_t c_size = lv_txt_utf8_size(&txt[byte_cnt]);
         /* If the char was invalid tell it's 1 byte long*/
         byte_cnt += c_size ? c_size : 1;
     }
@@ -722,7 +863,19 @@ static uint32_t lv_txt_utf8_get_char_id(const char * txt, uint32_t byte_id)
     uint32_t char_cnt = 0;
 
     while(i < byte_id) {
-        _lv_txt_encoded_next(txt, &i); /*'i' points to the next letter so use the prev. value*/
+        /*Skip a word of ASCII letters at once*/
+        if(byte_id - i >= WORD_SIZE) {
+            size_t w;
+            lv_memcpy_small(&w, &txt[i], WORD_SIZE);
+            if((w & WORD_HIGH_BITS) == 0) {
+                i += WORD_SIZE;
+                char_cnt += WORD_SIZE;
+                continue;
+            }
+        }
+
+        if(LV_IS_ASCII(txt[i])) i++;
+        else lv_txt_utf8_next(txt, &i); /*'i' points to the next letter so use the prev. value*/
         char_cnt++;
     }
 
@@ -739,9 +892,22 @@ static uint32_t lv_txt_utf8_get_length(const char * txt)
 {
     uint32_t len = 0;
     uint32_t i   = 0;
+    uint32_t byte_len = strlen(txt);
+
+    while(i < byte_len) {
+        /*Count a word of ASCII letters at once*/
+        if(byte_len - i >= WORD_SIZE) {
+            size_t w;
+            lv_memcpy_small(&w, &txt[i], WORD_SIZE);
+            if((w & WORD_HIGH_BITS) == 0) {
+                i += WORD_SIZE;
+                len += WORD_SIZE;
+                continue;
+            }
+        }
 
-    while(txt[i] != '\0') {
-        _lv_txt_encoded_next(txt, &i);
+        if(LV_IS_ASCII(txt[i])) i++;
+        else lv_txt_utf8_next(txt, &i);
         len++;
     }
 
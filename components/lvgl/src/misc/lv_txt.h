@@ -99,6 +99,24 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
 uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font, lv_coord_t letter_space,
                                lv_coord_t max_width, lv_coord_t * used_width, lv_text_flag_t flag);
 
+/**
+ * Same as `_lv_txt_get_next_line()` but the length of the text is known
+ * which makes processing a text faster.
+ * @param txt a '\0' terminated string
+ * @param len length of `txt` in bytes
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max width of the text (break the lines to fit this size). Set COORD_MAX to avoid
+ * line breaks
+ * @param used_width When used_width != NULL, save the width of this line if
+ * flag == LV_TEXT_FLAG_NONE, otherwise save -1.
+ * @param flags settings for the text from 'txt_flag_type' enum
+ * @return the index of the first char of the new line (in byte index not letter index. With UTF-8
+ * they are different)
+ */
+uint32_t _lv_txt_get_next_line_len(const char * txt, uint32_t len, const lv_font_t * font, lv_coord_t letter_space,
+                                   lv_coord_t max_width, lv_coord_t * used_width, lv_text_flag_t flag);
+
 /**
  * Give the length of a text with a given font
  * @param txt a '\0' terminate string
@@ -157,6 +175,21 @@ char * _lv_txt_set_text_vfmt(const char * fmt, va_list ap) LV_FORMAT_ATTRIBUTE(1
  */
 void _lv_txt_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_t * letter_next, uint32_t * ofs);
 
+/**
+ * Decode several encoded characters from a string at once.
+ * With UTF-8 the ASCII characters are processed a machine word at once where possible.
+ * @param txt pointer to a string
+ * @param len number of bytes to decode or UINT32_MAX to decode until the closing '\0'
+ * @param letters store the decoded Unicode characters here. `letters[return value]` will be
+ *                the character after the decoded ones (or 0 at the end of the string) e.g. for kerning.
+ *                Must have room for `max_cnt + 1` elements.
+ * @param ofs store the byte index of the characters here. `ofs[return value]` will be the byte index
+ *            after the last decoded character. Must have room for `max_cnt + 1` elements.
+ * @param max_cnt decode at most this many characters
+ * @return number of decoded characters
+ */
+uint32_t _lv_txt_encoded_next_n(const char * txt, uint32_t len, uint32_t * letters, uint32_t * ofs, uint32_t max_cnt);
+
 /**
  * Test if char is break char or not (a text can broken here or not)
  * @param letter a letter
@@ -0,0 +1,130 @@
+/**
+ * @file lv_vec.c
+ * Growable array of equal sized elements stored in one block of the 'lv_mem' module.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_vec.h"
+#include "lv_mem.h"
+#include "lv_assert.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define VEC_CAP_MIN     4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool vec_grow(lv_vec_t * vec);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_vec_init(lv_vec_t * vec, uint32_t elem_size)
+{
+    vec->data = NULL;
+    vec->elem_size = elem_size;
+    vec->cnt = 0;
+    vec->cap = 0;
+    vec->free_head = LV_VEC_NONE;
+}
+
+void lv_vec_clear(lv_vec_t * vec)
+{
+    lv_mem_free(vec->data);
+    lv_vec_init(vec, vec->elem_size);
+}
+
+bool lv_vec_reserve(lv_vec_t * vec, uint32_t cap)
+{
+    if(cap <= vec->cap) return true;
+
+    uint8_t * data = lv_mem_realloc(vec->data, (size_t)cap * vec->elem_size);
+    LV_ASSERT_MALLOC(data);
+    if(data == NULL) return false;
+
+    vec->data = data;
+    vec->cap = cap;
+    return true;
+}
+
+void * lv_vec_push(lv_vec_t * vec)
+{
+    if(vec->cnt == vec->cap && !vec_grow(vec)) return NULL;
+
+    vec->cnt++;
+    return lv_vec_at(vec, vec->cnt - 1);
+}
+
+void * lv_vec_insert(lv_vec_t * vec, uint32_t idx)
+{
+    LV_ASSERT(idx <= vec->cnt);
+    if(vec->cnt == vec->cap && !vec_grow(vec)) return NULL;
+
+    uint8_t * p = lv_vec_at(vec, idx);
+    memmove(p + vec->elem_size, p, (size_t)(vec->cnt - idx) * vec->elem_size);
+    vec->cnt++;
+    return p;
+}
+
+void lv_vec_remove(lv_vec_t * vec, uint32_t idx)
+{
+    LV_ASSERT(idx < vec->cnt);
+    uint8_t * p = lv_vec_at(vec, idx);
+    memmove(p, p + vec->elem_size, (size_t)(vec->cnt - idx - 1) * vec->elem_size);
+    vec->cnt--;
+}
+
+void lv_vec_remove_swap(lv_vec_t * vec, uint32_t idx)
+{
+    LV_ASSERT(idx < vec->cnt);
+    vec->cnt--;
+    if(idx != vec->cnt) lv_memcpy(lv_vec_at(vec, idx), lv_vec_at(vec, vec->cnt), vec->elem_size);
+}
+
+uint32_t lv_vec_slot_get(lv_vec_t * vec)
+{
+    LV_ASSERT(vec->elem_size >= sizeof(uint32_t));
+
+    uint32_t idx = vec->free_head;
+    if(idx != LV_VEC_NONE) {
+        lv_memcpy(&vec->free_head, lv_vec_at(vec, idx), sizeof(uint32_t));
+        return idx;
+    }
+
+    if(lv_vec_push(vec) == NULL) return LV_VEC_NONE;
+    return vec->cnt - 1;
+}
+
+void lv_vec_slot_put(lv_vec_t * vec, uint32_t idx)
+{
+    LV_ASSERT(idx < vec->cnt);
+    lv_memcpy(lv_vec_at(vec, idx), &vec->free_head, sizeof(uint32_t));
+    vec->free_head = idx;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool vec_grow(lv_vec_t * vec)
+{
+    return lv_vec_reserve(vec, vec->cap < VEC_CAP_MIN ? VEC_CAP_MIN : vec->cap * 2);
+}
@@ -0,0 +1,151 @@
+/**
+ * @file lv_vec.h
+ * Growable array of equal sized elements stored in one block of the 'lv_mem' module.
+ */
+
+#ifndef LV_VEC_H
+#define LV_VEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/** Invalid index, e.g. the end of the slot freelist*/
+#define LV_VEC_NONE     UINT32_MAX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Description of a vector.
+ * The elements can be used as a plain array (push, insert, remove)
+ * or as a pool of slots (`lv_vec_slot_get/put`) with stable indices. Don't mix the two on the same vector.
+ */
+typedef struct {
+    uint8_t * data;
+    uint32_t elem_size;
+    uint32_t cnt;           /**< Number of elements (including the released slots)*/
+    uint32_t cap;           /**< Number of elements which fit into `data`*/
+    uint32_t free_head;     /**< Index of the first released slot or `LV_VEC_NONE`*/
+} lv_vec_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an empty vector. It doesn't allocate memory.
+ * @param vec           pointer to an `lv_vec_t` variable
+ * @param elem_size     size of an element in bytes
+ */
+void lv_vec_init(lv_vec_t * vec, uint32_t elem_size);
+
+/**
+ * Free the memory of a vector and make it empty
+ * @param vec           pointer to a vector
+ */
+void lv_vec_clear(lv_vec_t * vec);
+
+/**
+ * Remove all the elements but keep the memory for reuse
+ * @param vec           pointer to a vector
+ */
+static inline void lv_vec_reset(lv_vec_t * vec)
+{
+    vec->cnt = 0;
+    vec->free_head = LV_VEC_NONE;
+}
+
+/**
+ * Make sure that a given number of elements fit into the vector without reallocation
+ * @param vec           pointer to a vector
+ * @param cap           the required capacity
+ * @return              true: success; false: out of memory
+ */
+bool lv_vec_reserve(lv_vec_t * vec, uint32_t cap);
+
+/**
+ * Add a new element to the end of the vector
+ * @param vec           pointer to a vector
+ * @return              pointer to the new (uninitialized) element or NULL if out of memory
+ */
+void * lv_vec_push(lv_vec_t * vec);
+
+/**
+ * Insert a new element and move the next elements up
+ * @param vec           pointer to a vector
+ * @param idx           index of the new element, `<= cnt`
+ * @return              pointer to the new (uninitialized) element or NULL if out of memory
+ */
+void * lv_vec_insert(lv_vec_t * vec, uint32_t idx);
+
+/**
+ * Remove an element and move the next elements down to keep the order
+ * @param vec           pointer to a vector
+ * @param idx           index of the element to remove
+ */
+void lv_vec_remove(lv_vec_t * vec, uint32_t idx);
+
+/**
+ * Remove an element by moving the last element to its place. O(1) but it changes the order.
+ * @param vec           pointer to a vector
+ * @param idx           index of the element to remove
+ */
+void lv_vec_remove_swap(lv_vec_t * vec, uint32_t idx);
+
+/**
+ * Get a slot from the vector: reuse a released slot or add a new one to the end.
+ * The index of the slot remains valid until `lv_vec_slot_put`, even if the vector grows.
+ * @param vec           pointer to a vector with `elem_size >= 4`
+ * @return              index of the slot or `LV_VEC_NONE` if out of memory
+ */
+uint32_t lv_vec_slot_get(lv_vec_t * vec);
+
+/**
+ * Release a slot. Its first 4 bytes are used to link it into the freelist.
+ * @param vec           pointer to a vector
+ * @param idx           index of a slot returned by `lv_vec_slot_get`
+ */
+void lv_vec_slot_put(lv_vec_t * vec, uint32_t idx);
+
+/**
+ * Get an element of the vector. The pointer is valid until the vector is reallocated.
+ * @param vec           pointer to a vector
+ * @param idx           index of the element, `< cnt`
+ * @return              pointer to the element
+ */
+static inline void * lv_vec_at(const lv_vec_t * vec, uint32_t idx)
+{
+    return vec->data + (size_t)idx * vec->elem_size;
+}
+
+/**
+ * Get the number of elements in the vector
+ * @param vec           pointer to a vector
+ * @return              number of elements
+ */
+static inline uint32_t lv_vec_get_cnt(const lv_vec_t * vec)
+{
+    return vec->cnt;
+}
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_VEC_H*/
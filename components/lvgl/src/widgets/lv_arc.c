@@ -52,6 +52,10 @@ static bool lv_arc_angle_within_bg_bounds(lv_obj_t * obj, const uint32_t angle,
 const lv_obj_class_t lv_arc_class  = {
     .constructor_cb = lv_arc_constructor,
     .event_cb = lv_arc_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) | LV_EVENT_BIT(LV_EVENT_HIT_TEST) | LV_EVENT_BIT(LV_EVENT_KEY) |
+                  LV_EVENT_BIT(LV_EVENT_PRESSING) | LV_EVENT_BIT(LV_EVENT_PRESS_LOST) |
+                  LV_EVENT_BIT(LV_EVENT_REFR_EXT_DRAW_SIZE) | LV_EVENT_BIT(LV_EVENT_RELEASED) |
+                  LV_EVENT_BIT(LV_EVENT_VALUE_CHANGED),
     .instance_size = sizeof(lv_arc_t),
     .editable = LV_OBJ_CLASS_EDITABLE_TRUE,
     .base_class = &lv_obj_class
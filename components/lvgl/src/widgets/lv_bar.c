@@ -61,6 +61,8 @@ const lv_obj_class_t lv_bar_class = {
     .constructor_cb = lv_bar_constructor,
     .destructor_cb = lv_bar_destructor,
     .event_cb = lv_bar_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) | LV_EVENT_BIT(LV_EVENT_PRESSED) |
+                  LV_EVENT_BIT(LV_EVENT_REFR_EXT_DRAW_SIZE) | LV_EVENT_BIT(LV_EVENT_RELEASED),
     .width_def = LV_DPI_DEF * 2,
     .height_def = LV_DPI_DEF / 10,
     .instance_size = sizeof(lv_bar_t),
@@ -62,6 +62,13 @@ const lv_obj_class_t lv_btnmatrix_class = {
     .constructor_cb = lv_btnmatrix_constructor,
     .destructor_cb = lv_btnmatrix_destructor,
     .event_cb = lv_btnmatrix_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_DEFOCUSED) | LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) | LV_EVENT_BIT(LV_EVENT_FOCUSED) |
+                  LV_EVENT_BIT(LV_EVENT_KEY) | LV_EVENT_BIT(LV_EVENT_LEAVE) |
+                  LV_EVENT_BIT(LV_EVENT_LONG_PRESSED_REPEAT) | LV_EVENT_BIT(LV_EVENT_PRESSED) |
+                  LV_EVENT_BIT(LV_EVENT_PRESSING) | LV_EVENT_BIT(LV_EVENT_PRESS_LOST) |
+                  LV_EVENT_BIT(LV_EVENT_REFR_EXT_DRAW_SIZE) | LV_EVENT_BIT(LV_EVENT_RELEASED) |
+                  LV_EVENT_BIT(LV_EVENT_SIZE_CHANGED) | LV_EVENT_BIT(LV_EVENT_STYLE_CHANGED) |
+                  LV_EVENT_BIT(LV_EVENT_VALUE_CHANGED),
     .width_def = LV_DPI_DEF * 2,
     .height_def = LV_DPI_DEF,
     .instance_size = sizeof(lv_btnmatrix_t),
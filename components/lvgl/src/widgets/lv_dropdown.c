@@ -63,6 +63,10 @@ const lv_obj_class_t lv_dropdown_class = {
     .constructor_cb = lv_dropdown_constructor,
     .destructor_cb = lv_dropdown_destructor,
     .event_cb = lv_dropdown_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_DEFOCUSED) | LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) | LV_EVENT_BIT(LV_EVENT_FOCUSED) |
+                  LV_EVENT_BIT(LV_EVENT_GET_SELF_SIZE) | LV_EVENT_BIT(LV_EVENT_KEY) | LV_EVENT_BIT(LV_EVENT_LEAVE) |
+                  LV_EVENT_BIT(LV_EVENT_RELEASED) | LV_EVENT_BIT(LV_EVENT_SIZE_CHANGED) |
+                  LV_EVENT_BIT(LV_EVENT_STYLE_CHANGED),
     .width_def = LV_DPI_DEF,
     .height_def = LV_SIZE_CONTENT,
     .instance_size = sizeof(lv_dropdown_t),
@@ -75,6 +79,8 @@ const lv_obj_class_t lv_dropdownlist_class = {
     .constructor_cb = lv_dropdownlist_constructor,
     .destructor_cb = lv_dropdownlist_destructor,
     .event_cb = lv_dropdown_list_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_DRAW_POST) | LV_EVENT_BIT(LV_EVENT_PRESSED) | LV_EVENT_BIT(LV_EVENT_RELEASED) |
+                  LV_EVENT_BIT(LV_EVENT_SCROLL_BEGIN),
     .instance_size = sizeof(lv_dropdown_list_t),
     .base_class = &lv_obj_class
 };
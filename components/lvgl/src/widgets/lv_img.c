@@ -33,6 +33,11 @@ static void lv_img_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_img_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_img_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_img(lv_event_t * e);
+#if LV_IMG_ASYNC
+    static bool async_is_waiting(lv_obj_t * obj);
+    static void draw_placeholder(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_draw_img_dsc_t * img_dsc,
+                                 const lv_area_t * img_area);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -41,6 +46,10 @@ const lv_obj_class_t lv_img_class = {
     .constructor_cb = lv_img_constructor,
     .destructor_cb = lv_img_destructor,
     .event_cb = lv_img_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_COVER_CHECK) | LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) |
+                  LV_EVENT_BIT(LV_EVENT_DRAW_POST) | LV_EVENT_BIT(LV_EVENT_GET_SELF_SIZE) |
+                  LV_EVENT_BIT(LV_EVENT_HIT_TEST) | LV_EVENT_BIT(LV_EVENT_REFR_EXT_DRAW_SIZE) |
+                  LV_EVENT_BIT(LV_EVENT_STYLE_CHANGED) | LV_EVENT_BIT(LV_EVENT_READY),
     .width_def = LV_SIZE_CONTENT,
     .height_def = LV_SIZE_CONTENT,
     .instance_size = sizeof(lv_img_t),
@@ -95,6 +104,9 @@ void lv_img_set_src(lv_obj_t * obj, const void * src)
     /*If the new source type is unknown free the memories of the old source*/
     if(src_type == LV_IMG_SRC_UNKNOWN) {
         LV_LOG_WARN("lv_img_set_src: unknown image type");
+#if LV_IMG_ASYNC
+        _lv_img_async_cancel(obj);
+#endif
         if(img->src_type == LV_IMG_SRC_SYMBOL || img->src_type == LV_IMG_SRC_FILE) {
             lv_mem_free((void *)img->src);
         }
@@ -145,6 +157,12 @@ void lv_img_set_src(lv_obj_t * obj, const void * src)
         header.h = size.y;
     }
 
+#if LV_IMG_ASYNC
+    /*Start decoding the new image right away*/
+    _lv_img_async_cancel(obj);
+    img->async_failed = 0;
+#endif
+
     img->src_type = src_type;
     img->w        = header.w;
     img->h        = header.h;
@@ -157,6 +175,10 @@ void lv_img_set_src(lv_obj_t * obj, const void * src)
     /*Provide enough room for the rotated corners*/
     if(img->angle || img->zoom != LV_IMG_ZOOM_NONE) lv_obj_refresh_ext_draw_size(obj);
 
+#if LV_IMG_ASYNC
+    async_is_waiting(obj);
+#endif
+
     lv_obj_invalidate(obj);
 }
 
@@ -304,6 +326,31 @@ void lv_img_set_size_mode(lv_obj_t * obj, lv_img_size_mode_t mode)
     lv_obj_invalidate(obj);
 }
 
+#if LV_IMG_ASYNC
+void lv_img_set_async(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_img_t * img = (lv_img_t *)obj;
+    if(en == img->async) return;
+
+    img->async = en;
+    img->async_failed = 0;
+    if(en) async_is_waiting(obj);
+    else _lv_img_async_cancel(obj);
+    lv_obj_invalidate(obj);
+}
+
+void lv_img_set_placeholder(lv_obj_t * obj, const lv_img_dsc_t * src)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_img_t * img = (lv_img_t *)obj;
+    if(src == img->placeholder) return;
+
+    img->placeholder = src;
+    if(_lv_img_async_is_pending(obj)) lv_obj_invalidate(obj);
+}
+#endif
+
 /*=====================
  * Getter functions
  *====================*/
@@ -378,6 +425,21 @@ lv_img_size_mode_t lv_img_get_size_mode(lv_obj_t * obj)
     return img->obj_size_mode;
 }
 
+#if LV_IMG_ASYNC
+bool lv_img_get_async(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_img_t * img = (lv_img_t *)obj;
+    return img->async ? true : false;
+}
+
+bool lv_img_is_pending(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    return _lv_img_async_is_pending(obj);
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -402,6 +464,11 @@ static void lv_img_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     img->pivot.x = 0;
     img->pivot.y = 0;
     img->obj_size_mode = LV_IMG_SIZE_MODE_VIRTUAL;
+#if LV_IMG_ASYNC
+    img->placeholder = NULL;
+    img->async = 0;
+    img->async_failed = 0;
+#endif
 
     lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
     lv_obj_add_flag(obj, LV_OBJ_FLAG_ADV_HITTEST);
@@ -413,6 +480,9 @@ static void lv_img_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 {
     LV_UNUSED(class_p);
     lv_img_t * img = (lv_img_t *)obj;
+#if LV_IMG_ASYNC
+    _lv_img_async_cancel(obj);
+#endif
     if(img->src_type == LV_IMG_SRC_FILE || img->src_type == LV_IMG_SRC_SYMBOL) {
         lv_mem_free((void *)img->src);
         img->src      = NULL;
@@ -511,6 +581,13 @@ static void lv_img_event(const lv_obj_class_t * class_p, lv_event_t * e)
             p->y = img->h;
         }
     }
+#if LV_IMG_ASYNC
+    else if(code == LV_EVENT_READY) {
+        /*Draw the image directly if it couldn't be decoded in the background*/
+        lv_res_t * res = lv_event_get_param(e);
+        if(res && *res != LV_RES_OK) img->async_failed = 1;
+    }
+#endif
     else if(code == LV_EVENT_DRAW_MAIN || code == LV_EVENT_DRAW_POST || code == LV_EVENT_COVER_CHECK) {
         draw_img(e);
     }
@@ -529,6 +606,14 @@ static void draw_img(lv_event_t * e)
             return;
         }
 
+#if LV_IMG_ASYNC
+        /*The placeholder might be smaller or transparent*/
+        if(async_is_waiting(obj)) {
+            info->res = LV_COVER_RES_NOT_COVER;
+            return;
+        }
+#endif
+
         /*Non true color format might have "holes"*/
         if(img->cf != LV_IMG_CF_TRUE_COLOR && img->cf != LV_IMG_CF_RAW) {
             info->res = LV_COVER_RES_NOT_COVER;
@@ -655,6 +740,14 @@ static void draw_img(lv_event_t * e)
                 if(!_lv_area_intersect(&img_clip_area, draw_ctx->clip_area, &img_clip_area)) return;
                 draw_ctx->clip_area = &img_clip_area;
 
+#if LV_IMG_ASYNC
+                if(async_is_waiting(obj)) {
+                    draw_placeholder(obj, draw_ctx, &img_dsc, &img_max_area);
+                    draw_ctx->clip_area = clip_area_ori;
+                    return;
+                }
+#endif
+
                 lv_area_t coords_tmp;
                 lv_coord_t offset_x = img->offset.x % img->w;
                 lv_coord_t offset_y = img->offset.y % img->h;
@@ -689,4 +782,63 @@ static void draw_img(lv_event_t * e)
     }
 }
 
+#if LV_IMG_ASYNC
+/**
+ * Check if the image file has to be decoded in the background and request it if it's not cached yet
+ * @return true: the image is not in the cache yet, the placeholder should be drawn
+ */
+static bool async_is_waiting(lv_obj_t * obj)
+{
+    lv_img_t * img = (lv_img_t *)obj;
+    if(!img->async || img->async_failed || img->src_type != LV_IMG_SRC_FILE) return false;
+
+    /*Use the same color as `lv_draw_img` to find the image in the cache*/
+    lv_color_t color = lv_color_black();
+    if(lv_obj_get_style_img_recolor_opa(obj, LV_PART_MAIN) > 0) {
+        color = lv_obj_get_style_img_recolor_filtered(obj, LV_PART_MAIN);
+    }
+
+    /*Draw the images directly which couldn't be cached anyway*/
+    if(!_lv_img_cache_can_fit(lv_img_buf_get_img_size(img->w, img->h, img->cf))) {
+        img->async_failed = 1;
+        return false;
+    }
+
+    /*Images opened for reading line by line are decoded too*/
+    _lv_img_cache_entry_t * entry = _lv_img_cache_find(img->src, color, 0);
+    if(entry && entry->dec_dsc.img_data) return false;
+
+    _lv_img_async_request(obj, img->src, color);
+    return true;
+}
+
+/**
+ * Draw the placeholder zoomed to fit and centered on the area of the image
+ */
+static void draw_placeholder(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_draw_img_dsc_t * img_dsc,
+                             const lv_area_t * img_area)
+{
+    lv_img_t * img = (lv_img_t *)obj;
+    const lv_img_dsc_t * ph = img->placeholder;
+    if(ph == NULL || ph->header.w == 0 || ph->header.h == 0) return;
+
+    uint32_t zoom_x = ((uint32_t)img->w << 8) / ph->header.w;
+    uint32_t zoom_y = ((uint32_t)img->h << 8) / ph->header.h;
+    uint32_t zoom = LV_MIN(zoom_x, zoom_y);
+    zoom = LV_CLAMP(1, zoom, UINT16_MAX);
+
+    lv_area_t coords;
+    coords.x1 = img_area->x1 + (img->w - (lv_coord_t)((ph->header.w * zoom) >> 8)) / 2;
+    coords.y1 = img_area->y1 + (img->h - (lv_coord_t)((ph->header.h * zoom) >> 8)) / 2;
+    coords.x2 = coords.x1 + ph->header.w - 1;
+    coords.y2 = coords.y1 + ph->header.h - 1;
+
+    img_dsc->zoom = zoom;
+    img_dsc->angle = 0;
+    img_dsc->pivot.x = 0;
+    img_dsc->pivot.y = 0;
+    lv_draw_img(draw_ctx, img_dsc, &coords, ph);
+}
+#endif
+
 #endif
@@ -50,6 +50,11 @@ typedef struct {
     uint8_t cf : 5;        /*Color format from `lv_img_color_format_t`*/
     uint8_t antialias : 1; /*Apply anti-aliasing in transformations (rotate, zoom)*/
     uint8_t obj_size_mode: 2; /*Image size mode when image size and object size is different.*/
+#if LV_IMG_ASYNC
+    const lv_img_dsc_t * placeholder; /*Drawn while the image file is decoded in the background*/
+    uint8_t async : 1;        /*Decode the image file in the background*/
+    uint8_t async_failed : 1; /*The image couldn't be decoded in the background, draw it directly*/
+#endif
 } lv_img_t;
 
 extern const lv_obj_class_t lv_img_class;
@@ -158,6 +163,26 @@ void lv_img_set_antialias(lv_obj_t * obj, bool antialias);
  * @param mode      the new size mode.
  */
 void lv_img_set_size_mode(lv_obj_t * obj, lv_img_size_mode_t mode);
+
+#if LV_IMG_ASYNC
+/**
+ * Decode the image files of the object in the background instead of blocking the drawing.
+ * Until the decoded image lands in the image cache the placeholder (if any) is drawn.
+ * `LV_EVENT_READY` is sent when the decoding is finished.
+ * @param obj       pointer to an image object
+ * @param en        true: decode in the background; false: decode while drawing
+ */
+void lv_img_set_async(lv_obj_t * obj, bool en);
+
+/**
+ * Set an image to draw while the image file is decoded in the background.
+ * It's zoomed to fit the size of the image, so a small thumbnail can be used as a low resolution preview.
+ * @param obj       pointer to an image object
+ * @param src       pointer to an `lv_img_dsc_t` variable. Only its pointer is saved. NULL to draw nothing.
+ */
+void lv_img_set_placeholder(lv_obj_t * obj, const lv_img_dsc_t * src);
+#endif
+
 /*=====================
  * Getter functions
  *====================*/
@@ -218,6 +243,22 @@ bool lv_img_get_antialias(lv_obj_t * obj);
  */
 lv_img_size_mode_t lv_img_get_size_mode(lv_obj_t * obj);
 
+#if LV_IMG_ASYNC
+/**
+ * Get whether the image files are decoded in the background
+ * @param obj       pointer to an image object
+ * @return          true: decoded in the background; false: decoded while drawing
+ */
+bool lv_img_get_async(lv_obj_t * obj);
+
+/**
+ * Check if the image of the object is being decoded in the background
+ * @param obj       pointer to an image object
+ * @return          true: the placeholder is drawn until the decoding is finished
+ */
+bool lv_img_is_pending(lv_obj_t * obj);
+#endif
+
 /**********************
  *      MACROS
  **********************/
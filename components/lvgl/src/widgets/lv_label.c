@@ -27,6 +27,8 @@
 #define LV_LABEL_SCROLL_DELAY       300
 #define LV_LABEL_DOT_END_INV 0xFFFFFFFF
 #define LV_LABEL_HINT_HEIGHT_LIMIT 1024 /*Enable "hint" to buffer info about labels larger than this. (Speed up drawing)*/
+#define LV_LABEL_LINE_CACHE_MIN_LEN 256 /*Cache the lines of texts longer than this. Wrapping shorter texts is cheap.*/
+#define LV_LABEL_EDIT_LINES_MAX 32  /*Rewrap at most this many lines around an edit, else the whole text*/
 
 /**********************
  *      TYPEDEFS
@@ -41,7 +43,22 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_main(lv_event_t * e);
 
 static void lv_label_refr_text(lv_obj_t * obj);
+static void lv_label_refr_text_layout(lv_obj_t * obj);
 static void lv_label_revert_dots(lv_obj_t * label);
+static void get_txt_size(lv_obj_t * obj, lv_point_t * size_res, const lv_font_t * font, lv_coord_t letter_space,
+                         lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag);
+static size_t get_txt_buf_size(size_t size);
+static void txt_edited(lv_obj_t * obj, uint32_t byte_pos, uint32_t del_len, uint32_t ins_len);
+#if LV_LABEL_LINE_CACHE
+static const lv_draw_label_line_t * get_lines(lv_obj_t * obj, const lv_font_t * font, lv_coord_t letter_space,
+                                              lv_coord_t max_w, lv_text_flag_t flag);
+static uint32_t get_line_of_byte(const lv_obj_t * obj, uint32_t byte_id);
+static uint32_t get_line_on_y(const lv_obj_t * obj, lv_coord_t y, lv_coord_t letter_height, lv_coord_t line_space);
+static void lines_invalidate(lv_obj_t * obj);
+static bool lines_edit(lv_obj_t * obj, uint32_t byte_pos, uint32_t del_len, uint32_t ins_len, uint32_t * first,
+                       uint32_t * last);
+static void invalidate_lines(lv_obj_t * obj, uint32_t first, uint32_t last);
+#endif
 
 static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
@@ -56,6 +73,9 @@ const lv_obj_class_t lv_label_class = {
     .constructor_cb = lv_label_constructor,
     .destructor_cb = lv_label_destructor,
     .event_cb = lv_label_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) | LV_EVENT_BIT(LV_EVENT_GET_SELF_SIZE) |
+                  LV_EVENT_BIT(LV_EVENT_REFR_EXT_DRAW_SIZE) | LV_EVENT_BIT(LV_EVENT_SIZE_CHANGED) |
+                  LV_EVENT_BIT(LV_EVENT_STYLE_CHANGED),
     .width_def = LV_SIZE_CONTENT,
     .height_def = LV_SIZE_CONTENT,
     .instance_size = sizeof(lv_label_t),
@@ -88,6 +108,9 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
     lv_label_t * label = (lv_label_t *)obj;
 
     lv_obj_invalidate(obj);
+#if LV_LABEL_LINE_CACHE
+    lines_invalidate(obj);
+#endif
 
     /*If text is NULL then just refresh with the current text*/
     if(text == NULL) text = label->text;
@@ -151,6 +174,9 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
 
     lv_obj_invalidate(obj);
     lv_label_t * label = (lv_label_t *)obj;
+#if LV_LABEL_LINE_CACHE
+    lines_invalidate(obj);
+#endif
 
     /*If text is NULL then refresh*/
     if(fmt == NULL) {
@@ -176,6 +202,9 @@ void lv_label_set_text_static(lv_obj_t * obj, const char * text)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_label_t * label = (lv_label_t *)obj;
+#if LV_LABEL_LINE_CACHE
+    lines_invalidate(obj);
+#endif
 
     if(label->static_txt == 0 && label->text != NULL) {
         lv_mem_free(label->text);
@@ -327,14 +356,26 @@ void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t
 
     uint32_t byte_id = _lv_txt_encoded_get_byte_id(txt, char_id);
 
-    /*Search the line of the index letter*/;
-    while(txt[new_line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+#if LV_LABEL_LINE_CACHE
+    const lv_draw_label_line_t * lines = get_lines((lv_obj_t *)obj, font, letter_space, max_w, flag);
+    if(lines) {
+        uint32_t line_i = get_line_of_byte(obj, byte_id);
+        line_start = lines[line_i].start;
+        new_line_start = lines[line_i + 1].start;
+        y = line_i * (letter_height + line_space);
+    }
+    else
+#endif
+    {
+        /*Search the line of the index letter*/;
+        while(txt[new_line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-        y += letter_height + line_space;
-        line_start = new_line_start;
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -428,22 +469,45 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in)
 
     lv_text_align_t align = lv_obj_calculate_style_text_align(obj, LV_PART_MAIN, label->text);
 
-    /*Search the line of the index letter*/;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+#if LV_LABEL_LINE_CACHE
+    const lv_draw_label_line_t * lines = get_lines((lv_obj_t *)obj, font, letter_space, max_w, flag);
+    if(lines) {
+        uint32_t line_i = get_line_on_y(obj, pos.y, letter_height, line_space);
+        if(line_i < label->line_cnt) {
+            line_start = lines[line_i].start;
+            new_line_start = lines[line_i + 1].start;
 
-        if(pos.y <= y + letter_height) {
-            /*The line is found (stored in 'line_start')*/
             /*Include the NULL terminator in the last line*/
             uint32_t tmp = new_line_start;
             uint32_t letter;
             letter = _lv_txt_encoded_prev(txt, &tmp);
             if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
-            break;
         }
-        y += letter_height + line_space;
+        else {
+            line_start = lines[line_i].start;
+            new_line_start = line_start;
+        }
+    }
+    else
+#endif
+    {
+        /*Search the line of the index letter*/;
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+
+            if(pos.y <= y + letter_height) {
+                /*The line is found (stored in 'line_start')*/
+                /*Include the NULL terminator in the last line*/
+                uint32_t tmp = new_line_start;
+                uint32_t letter;
+                letter = _lv_txt_encoded_prev(txt, &tmp);
+                if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
+                break;
+            }
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
 #if LV_USE_BIDI
@@ -546,14 +610,25 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    /*Search the line of the index letter*/;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+#if LV_LABEL_LINE_CACHE
+    const lv_draw_label_line_t * lines = get_lines((lv_obj_t *)obj, font, letter_space, max_w, flag);
+    if(lines) {
+        uint32_t line_i = get_line_on_y(obj, pos->y, letter_height, line_space);
+        line_start = lines[line_i].start;
+        new_line_start = line_i < label->line_cnt ? lines[line_i + 1].start : line_start;
+    }
+    else
+#endif
+    {
+        /*Search the line of the index letter*/;
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
 
-        if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
-        y += letter_height + line_space;
+            if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
     /*Calculate the x coordinate*/
@@ -645,22 +720,29 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt)
     /*Can not append to static text*/
     if(label->static_txt != 0) return;
 
-    lv_obj_invalidate(obj);
-
-    /*Allocate space for the new text*/
+    /*Allocate space for the new text. Keep some spare space for the next insertions.*/
     size_t old_len = strlen(label->text);
     size_t ins_len = strlen(txt);
     size_t new_len = ins_len + old_len;
-    label->text        = lv_mem_realloc(label->text, new_len + 1);
+    label->text        = lv_mem_realloc(label->text, get_txt_buf_size(new_len + 1));
     LV_ASSERT_MALLOC(label->text);
     if(label->text == NULL) return;
 
-    if(pos == LV_LABEL_POS_LAST) {
-        pos = _lv_txt_get_encoded_length(label->text);
+    uint32_t byte_pos = pos == LV_LABEL_POS_LAST ? old_len : _lv_txt_encoded_get_byte_id(label->text, pos);
+
+    /*Make place for the new text (with the '\0') and copy it there*/
+    memmove(&label->text[byte_pos + ins_len], &label->text[byte_pos], old_len - byte_pos + 1);
+    lv_memcpy(&label->text[byte_pos], txt, ins_len);
+
+#if LV_USE_ARABIC_PERSIAN_CHARS
+    /*The rest of the text is already processed, so only a new Arabic or Persian text needs to be processed*/
+    if(_lv_txt_ap_calc_bytes_cnt(txt) != ins_len + 1) {
+        lv_label_set_text(obj, NULL);
+        return;
     }
+#endif
 
-    _lv_txt_ins(label->text, pos, txt);
-    lv_label_set_text(obj, NULL);
+    txt_edited(obj, byte_pos, 0, ins_len);
 }
 
 void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
@@ -671,14 +753,16 @@ void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
     /*Can not append to static text*/
     if(label->static_txt != 0) return;
 
-    lv_obj_invalidate(obj);
-
     char * label_txt = lv_label_get_text(obj);
+    size_t old_len = strlen(label_txt);
+    uint32_t byte_pos = _lv_txt_encoded_get_byte_id(label_txt, pos);
+    uint32_t del_len = _lv_txt_encoded_get_byte_id(&label_txt[byte_pos], cnt);
+
     /*Delete the characters*/
-    _lv_txt_cut(label_txt, pos, cnt);
+    memmove(&label_txt[byte_pos], &label_txt[byte_pos + del_len], old_len - byte_pos - del_len + 1);
 
     /*Refresh the label*/
-    lv_label_refr_text(obj);
+    txt_edited(obj, byte_pos, del_len, 0);
 }
 
 /**********************
@@ -704,6 +788,13 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->hint.line_start = -1;
     label->hint.coord_y    = 0;
     label->hint.y          = 0;
+    label->hint.lines      = NULL;
+    label->hint.line_cnt   = 0;
+#endif
+
+#if LV_LABEL_LINE_CACHE
+    label->lines = NULL;
+    label->line_cnt = 0;
 #endif
 
 #if LV_LABEL_TEXT_SELECTION
@@ -727,6 +818,9 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_t * label = (lv_label_t *)obj;
 
     lv_label_dot_tmp_free(obj);
+#if LV_LABEL_LINE_CACHE
+    lines_invalidate(obj);
+#endif
     if(!label->static_txt) lv_mem_free(label->text);
     label->text = NULL;
 }
@@ -773,10 +867,14 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
         if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
 
         lv_coord_t w = lv_obj_get_content_width(obj);
-        if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) w = LV_COORD_MAX;
+        if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) {
+            /*Wrap only at the new lines, the same as the text is wrapped in `lv_label_refr_text()`*/
+            w = LV_COORD_MAX;
+            flag |= LV_TEXT_FLAG_FIT;
+        }
         else w = lv_obj_get_content_width(obj);
 
-        lv_txt_get_size(&size, label->text, font, letter_space, line_space, w, flag);
+        get_txt_size(obj, &size, font, letter_space, line_space, w, flag);
 
         lv_point_t * self_size = lv_event_get_param(e);
         self_size->x = LV_MAX(self_size->x, size.x);
@@ -824,20 +922,29 @@ static void draw_main(lv_event_t * e)
     if((label->long_mode == LV_LABEL_LONG_SCROLL || label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) &&
        (label_draw_dsc.align == LV_TEXT_ALIGN_CENTER || label_draw_dsc.align == LV_TEXT_ALIGN_RIGHT)) {
         lv_point_t size;
-        lv_txt_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                        LV_COORD_MAX, flag);
+        get_txt_size(obj, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                     LV_COORD_MAX, flag);
         if(size.x > lv_area_get_width(&txt_coords)) {
             label_draw_dsc.align = LV_TEXT_ALIGN_LEFT;
         }
     }
-#if LV_LABEL_LONG_TXT_HINT
-    lv_draw_label_hint_t * hint = &label->hint;
-    if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
-        hint = NULL;
-
-#else
-    /*Just for compatibility*/
     lv_draw_label_hint_t * hint = NULL;
+#if LV_LABEL_LINE_CACHE
+    /*Draw the already wrapped lines*/
+    lv_draw_label_hint_t lines_hint;
+    lines_hint.lines = get_lines(obj, label_draw_dsc.font, label_draw_dsc.letter_space, lv_area_get_width(&txt_coords),
+                                 flag);
+    if(lines_hint.lines) {
+        lines_hint.line_cnt = label->line_cnt;
+        hint = &lines_hint;
+    }
+#endif
+
+#if LV_LABEL_LONG_TXT_HINT
+    if(hint == NULL && label->long_mode != LV_LABEL_LONG_SCROLL_CIRCULAR &&
+       lv_area_get_height(&txt_coords) >= LV_LABEL_HINT_HEIGHT_LIMIT) {
+        hint = &label->hint;
+    }
 #endif
 
     lv_area_t txt_clip;
@@ -864,8 +971,8 @@ static void draw_main(lv_event_t * e)
 
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) {
         lv_point_t size;
-        lv_txt_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                        LV_COORD_MAX, flag);
+        get_txt_size(obj, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                     LV_COORD_MAX, flag);
 
         /*Draw the text again on label to the original to make a circular effect */
         if(size.x > lv_area_get_width(&txt_coords)) {
@@ -896,6 +1003,18 @@ static void lv_label_refr_text(lv_obj_t * obj)
 {
     lv_label_t * label = (lv_label_t *)obj;
     if(label->text == NULL) return;
+
+    lv_label_refr_text_layout(obj);
+    lv_obj_invalidate(obj);
+}
+
+/**
+ * Update the size, the long mode animations and the dots of the label but don't invalidate it
+ * @param obj pointer to a label object with a not NULL text
+ */
+static void lv_label_refr_text_layout(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
 #if LV_LABEL_LONG_TXT_HINT
     label->hint.line_start = -1; /*The hint is invalid if the text changes*/
 #endif
@@ -914,7 +1033,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    lv_txt_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    get_txt_size(obj, &size, font, letter_space, line_space, max_w, flag);
 
     lv_obj_refresh_self_size(obj);
 
@@ -1158,14 +1277,15 @@ static void lv_label_refr_text(lv_obj_t * obj)
                 }
                 label->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 label->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+#if LV_LABEL_LINE_CACHE
+                lines_invalidate(obj);
+#endif
             }
         }
     }
     else if(label->long_mode == LV_LABEL_LONG_CLIP) {
         /*Do nothing*/
     }
-
-    lv_obj_invalidate(obj);
 }
 
 
@@ -1188,6 +1308,9 @@ static void lv_label_revert_dots(lv_obj_t * obj)
     }
     label->text[byte_i + i] = dot_tmp[i];
     lv_label_dot_tmp_free(obj);
+#if LV_LABEL_LINE_CACHE
+    lines_invalidate(obj);
+#endif
 
     label->dot_end = LV_LABEL_DOT_END_INV;
 }
@@ -1256,6 +1379,331 @@ static void lv_label_dot_tmp_free(lv_obj_t * obj)
 }
 
 
+/**
+ * Get the size of the label's text like `lv_txt_get_size()` but use the cached lines if possible
+ */
+static void get_txt_size(lv_obj_t * obj, lv_point_t * size_res, const lv_font_t * font, lv_coord_t letter_space,
+                         lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag)
+{
+#if LV_LABEL_LINE_CACHE
+    lv_label_t * label = (lv_label_t *)obj;
+    const lv_draw_label_line_t * lines = get_lines(obj, font, letter_space, max_w, flag);
+    if(lines) {
+        int32_t line_cnt = label->line_cnt;
+
+        /*Make the text one line taller if the last character is '\n' or '\r'*/
+        uint32_t len = lines[label->line_cnt].start;
+        if(label->text[len - 1] == '\n' || label->text[len - 1] == '\r') line_cnt++;
+
+        int32_t h = line_cnt * (lv_font_get_line_height(font) + line_space) - line_space;
+        /*Let `lv_txt_get_size()` handle the overflow*/
+        if(h <= (int32_t)LV_MAX_OF(lv_coord_t)) {
+            size_res->x = label->lines_w;
+            size_res->y = h;
+            return;
+        }
+    }
+#endif
+
+    lv_txt_get_size(size_res, lv_label_get_text(obj), font, letter_space, line_space, max_w, flag);
+}
+
+/**
+ * Round up the size of an edited text's buffer to not reallocate it on every inserted character.
+ * The same rounded size can be reallocated in place.
+ */
+static size_t get_txt_buf_size(size_t size)
+{
+    size_t step = 16;
+    while(step < 1024 && step < size / 16) step <<= 1;
+
+    return (size + step - 1) & ~(step - 1);
+}
+
+/**
+ * Refresh the label after some bytes of its text were replaced.
+ * Only the lines around the edit are wrapped again and redrawn if possible.
+ * @param byte_pos  byte index of the edit
+ * @param del_len   number of bytes deleted from `byte_pos`
+ * @param ins_len   number of bytes inserted to `byte_pos`
+ */
+static void txt_edited(lv_obj_t * obj, uint32_t byte_pos, uint32_t del_len, uint32_t ins_len)
+{
+#if LV_LABEL_LINE_CACHE
+    lv_label_t * label = (lv_label_t *)obj;
+    uint32_t line_cnt_ori = label->line_cnt;
+    uint32_t first;
+    uint32_t last;
+    if(lines_edit(obj, byte_pos, del_len, ins_len, &first, &last)) {
+        lv_label_refr_text_layout(obj);
+        /*If the number of lines has changed the lines below are moved too*/
+        invalidate_lines(obj, first, label->line_cnt == line_cnt_ori ? last : label->line_cnt + 1);
+        return;
+    }
+#else
+    LV_UNUSED(byte_pos);
+    LV_UNUSED(del_len);
+    LV_UNUSED(ins_len);
+#endif
+
+    lv_label_refr_text(obj);
+}
+
+#if LV_LABEL_LINE_CACHE
+/**
+ * Get the start and width of the wrapped lines of the label's text.
+ * Wrap the text only if it has changed or it was wrapped with different parameters.
+ * @return the `line_cnt + 1` lines (the last is the end of the text) or NULL if the text is short or out of memory
+ */
+static const lv_draw_label_line_t * get_lines(lv_obj_t * obj, const lv_font_t * font, lv_coord_t letter_space,
+                                              lv_coord_t max_w, lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    /*The width doesn't matter in these cases*/
+    if(flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) max_w = LV_COORD_MAX;
+
+    if(label->lines) {
+        if(label->lines_font == font && label->lines_letter_space == letter_space && label->lines_max_w == max_w &&
+           label->lines_flag == flag) {
+            return label->lines;
+        }
+        lines_invalidate(obj);
+    }
+
+    const char * txt = label->text;
+    if(txt == NULL || font == NULL) return NULL;
+    uint32_t len = strlen(txt);
+    if(len < LV_LABEL_LINE_CACHE_MIN_LEN) return NULL;
+
+    uint32_t size = 64;
+    lv_draw_label_line_t * lines = lv_mem_alloc(size * sizeof(lv_draw_label_line_t));
+    if(lines == NULL) return NULL;
+
+    uint32_t line_cnt = 0;
+    uint32_t line_start = 0;
+    lv_coord_t lines_w = 0;
+    while(txt[line_start] != '\0') {
+        /*Keep one more item for the end of the text*/
+        if(line_cnt + 1 >= size) {
+            size *= 2;
+            lv_draw_label_line_t * new_lines = lv_mem_realloc(lines, size * sizeof(lv_draw_label_line_t));
+            if(new_lines == NULL) {
+                lv_mem_free(lines);
+                return NULL;
+            }
+            lines = new_lines;
+        }
+
+        uint32_t line_end = line_start + _lv_txt_get_next_line_len(&txt[line_start], len - line_start, font, letter_space,
+                                                                   max_w, NULL, flag);
+        lines[line_cnt].start = line_start;
+        lines[line_cnt].w = lv_txt_get_width(&txt[line_start], line_end - line_start, font, letter_space, flag);
+        lines_w = LV_MAX(lines_w, lines[line_cnt].w);
+        line_cnt++;
+        line_start = line_end;
+    }
+    lines[line_cnt].start = line_start;
+    lines[line_cnt].w = 0;
+
+    /*Free the unused items*/
+    label->lines = lv_mem_realloc(lines, (line_cnt + 1) * sizeof(lv_draw_label_line_t));
+    if(label->lines == NULL) label->lines = lines;
+
+    label->line_cnt = line_cnt;
+    label->lines_w = lines_w;
+    label->lines_font = font;
+    label->lines_letter_space = letter_space;
+    label->lines_max_w = max_w;
+    label->lines_flag = flag;
+
+    return label->lines;
+}
+
+/**
+ * Get the index of the cached line containing a byte of the text. Used only if the lines are cached.
+ * @return the index of the last line starting before `byte_id`
+ */
+static uint32_t get_line_of_byte(const lv_obj_t * obj, uint32_t byte_id)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    uint32_t min = 0;
+    uint32_t max = label->line_cnt - 1;
+    while(min < max) {
+        uint32_t mid = (min + max + 1) / 2;
+        if(label->lines[mid].start <= byte_id) min = mid;
+        else max = mid - 1;
+    }
+
+    return min;
+}
+
+/**
+ * Get the index of the cached line on a y coordinate. Used only if the lines are cached.
+ * @return the index of the first line whose bottom is below `y` or `line_cnt` if `y` is below the text
+ */
+static uint32_t get_line_on_y(const lv_obj_t * obj, lv_coord_t y, lv_coord_t letter_height, lv_coord_t line_space)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    if(y <= letter_height) return 0;
+
+    int32_t line_height = letter_height + line_space;
+    if(line_height <= 0) return label->line_cnt;
+
+    uint32_t line_i = (y - letter_height + line_height - 1) / line_height;
+    return LV_MIN(line_i, label->line_cnt);
+}
+
+static void lines_invalidate(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    lv_mem_free(label->lines);
+    label->lines = NULL;
+    label->line_cnt = 0;
+}
+
+/**
+ * Update the cached lines after some bytes of the text were replaced.
+ * Wrap the text again from the line before the edit until a line starts where an old line has started
+ * because from there the lines are the same, only moved by the length change.
+ * @param byte_pos  byte index of the edit
+ * @param del_len   number of bytes deleted from `byte_pos`
+ * @param ins_len   number of bytes inserted to `byte_pos`
+ * @param first     store the index of the first changed line here
+ * @param last      store the index after the last changed line here
+ * @return          true: the lines are updated; false: there were no cached lines or they are dropped
+ */
+static bool lines_edit(lv_obj_t * obj, uint32_t byte_pos, uint32_t del_len, uint32_t ins_len, uint32_t * first,
+                       uint32_t * last)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    if(label->lines == NULL) return false;
+
+    /*The dots are written into the text and the short texts are not cached*/
+    const char * txt = label->text;
+    uint32_t len = label->lines[label->line_cnt].start + ins_len - del_len;
+    if(label->long_mode == LV_LABEL_LONG_DOT || label->line_cnt == 0 || len < LV_LABEL_LINE_CACHE_MIN_LEN) {
+        lines_invalidate(obj);
+        return false;
+    }
+
+    /*The previous line can change too, e.g. if the first word of the line gets shorter*/
+    uint32_t first_i = get_line_of_byte(obj, byte_pos);
+    if(first_i > 0) first_i--;
+
+    lv_draw_label_line_t new_lines[LV_LABEL_EDIT_LINES_MAX];
+    uint32_t new_cnt = 0;
+    lv_coord_t new_w = 0;
+    uint32_t old_i = first_i + 1;
+    uint32_t line_start = label->lines[first_i].start;
+    while(txt[line_start] != '\0') {
+        /*The text after the edit is the same, so the lines are the same from an old line start*/
+        if(line_start >= byte_pos + ins_len) {
+            uint32_t old_start = line_start - ins_len + del_len;
+            while(old_i < label->line_cnt && label->lines[old_i].start < old_start) old_i++;
+            if(old_i < label->line_cnt && label->lines[old_i].start == old_start) break;
+        }
+
+        /*Too many lines have changed (e.g. a long text was inserted), wrap the whole text on the next use*/
+        if(new_cnt == LV_LABEL_EDIT_LINES_MAX) {
+            lines_invalidate(obj);
+            return false;
+        }
+
+        uint32_t line_end = line_start + _lv_txt_get_next_line_len(&txt[line_start], len - line_start, label->lines_font,
+                                                                   label->lines_letter_space, label->lines_max_w, NULL,
+                                                                   label->lines_flag);
+        new_lines[new_cnt].start = line_start;
+        new_lines[new_cnt].w = lv_txt_get_width(&txt[line_start], line_end - line_start, label->lines_font,
+                                                label->lines_letter_space, label->lines_flag);
+        new_w = LV_MAX(new_w, new_lines[new_cnt].w);
+        new_cnt++;
+        line_start = line_end;
+    }
+
+    /*Reached the end of the text: replace all the lines from `first_i`*/
+    if(txt[line_start] == '\0') old_i = label->line_cnt;
+
+    /*Was the longest line replaced?*/
+    bool longest_removed = false;
+    uint32_t i;
+    for(i = first_i; i < old_i; i++) {
+        if(label->lines[i].w == label->lines_w) longest_removed = true;
+    }
+
+    /*Replace the `first_i..old_i` lines with the new ones and move the next lines with the end of the text*/
+    uint32_t line_cnt = label->line_cnt - (old_i - first_i) + new_cnt;
+    uint32_t move_cnt = label->line_cnt - old_i + 1;
+    if(line_cnt > label->line_cnt) {
+        lv_draw_label_line_t * lines = lv_mem_realloc(label->lines, (line_cnt + 1) * sizeof(lv_draw_label_line_t));
+        if(lines == NULL) {
+            lines_invalidate(obj);
+            return false;
+        }
+        label->lines = lines;
+    }
+
+    memmove(&label->lines[first_i + new_cnt], &label->lines[old_i], move_cnt * sizeof(lv_draw_label_line_t));
+    lv_memcpy(&label->lines[first_i], new_lines, new_cnt * sizeof(lv_draw_label_line_t));
+    for(i = first_i + new_cnt; i <= line_cnt; i++) {
+        label->lines[i].start = label->lines[i].start + ins_len - del_len;
+    }
+
+    if(line_cnt < label->line_cnt) {
+        lv_draw_label_line_t * lines = lv_mem_realloc(label->lines, (line_cnt + 1) * sizeof(lv_draw_label_line_t));
+        if(lines) label->lines = lines;
+    }
+    label->line_cnt = line_cnt;
+
+    if(new_w >= label->lines_w) {
+        label->lines_w = new_w;
+    }
+    else if(longest_removed) {
+        label->lines_w = 0;
+        for(i = 0; i < line_cnt; i++) {
+            label->lines_w = LV_MAX(label->lines_w, label->lines[i].w);
+        }
+    }
+
+    *first = first_i;
+    *last = first_i + new_cnt;
+    return true;
+}
+
+/**
+ * Invalidate the area of some cached lines
+ * @param first     index of the first line
+ * @param last      index after the last line
+ */
+static void invalidate_lines(lv_obj_t * obj, uint32_t first, uint32_t last)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    /*The lines are moved in the other modes*/
+    if(label->long_mode != LV_LABEL_LONG_WRAP) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_coord_t font_h = lv_font_get_line_height(label->lines_font);
+    lv_coord_t line_height = font_h + lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+    lv_coord_t ext = _lv_obj_get_ext_draw_size(obj);
+
+    lv_area_t area;
+    lv_obj_get_content_coords(obj, &area);
+    lv_coord_t y = area.y1 - lv_obj_get_scroll_top(obj);
+
+    area.x1 = obj->coords.x1 - ext;
+    area.x2 = obj->coords.x2 + ext;
+    area.y1 = y + (int32_t)first * line_height - ext;
+    area.y2 = last > label->line_cnt ? obj->coords.y2 + ext : y + (int32_t)last * line_height + font_h + ext;
+    lv_obj_invalidate_area(obj, &area);
+}
+#endif
+
 static void set_ofs_x_anim(void * obj, int32_t v)
 {
     lv_label_t * label = (lv_label_t *)obj;
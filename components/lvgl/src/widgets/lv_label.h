@@ -63,6 +63,16 @@ typedef struct {
     lv_draw_label_hint_t hint;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_draw_label_line_t * lines;       /*Start and width of the wrapped lines and the end of the text. NULL if not cached*/
+    uint32_t line_cnt;
+    const lv_font_t * lines_font;       /*The lines were wrapped with these parameters*/
+    lv_coord_t lines_max_w;
+    lv_coord_t lines_letter_space;
+    lv_coord_t lines_w;                 /*Width of the longest line*/
+    lv_text_flag_t lines_flag;
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
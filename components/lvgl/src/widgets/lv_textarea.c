@@ -68,6 +68,9 @@ const lv_obj_class_t lv_textarea_class = {
     .constructor_cb = lv_textarea_constructor,
     .destructor_cb = lv_textarea_destructor,
     .event_cb = lv_textarea_event,
+    .event_mask = LV_EVENT_BIT(LV_EVENT_DRAW_MAIN) | LV_EVENT_BIT(LV_EVENT_DRAW_POST) | LV_EVENT_BIT(LV_EVENT_FOCUSED) |
+                  LV_EVENT_BIT(LV_EVENT_KEY) | LV_EVENT_BIT(LV_EVENT_PRESSED) | LV_EVENT_BIT(LV_EVENT_PRESSING) |
+                  LV_EVENT_BIT(LV_EVENT_PRESS_LOST) | LV_EVENT_BIT(LV_EVENT_READY) | LV_EVENT_BIT(LV_EVENT_RELEASED),
     .group_def = LV_OBJ_CLASS_GROUP_DEF_TRUE,
     .width_def = LV_DPI_DEF * 2,
     .height_def = LV_DPI_DEF,
@@ -222,13 +225,8 @@ void lv_textarea_del_char(lv_obj_t * obj)
     lv_res_t res = insert_handler(obj, del_buf);
     if(res != LV_RES_OK) return;
 
-    char * label_txt = lv_label_get_text(ta->label);
-
     /*Delete a character*/
-    _lv_txt_cut(label_txt, ta->cursor.pos - 1, 1);
-
-    /*Refresh the label*/
-    lv_label_set_text(ta->label, label_txt);
+    lv_label_cut_text(ta->label, ta->cursor.pos - 1, 1);
     lv_textarea_clear_selection(obj);
 
     /*If the textarea became empty, invalidate it to hide the placeholder*/
@@ -798,6 +796,35 @@ void lv_textarea_cursor_up(lv_obj_t * obj)
     ta->cursor.valid_x = cur_valid_x_tmp;
 }
 
+lv_fs_res_t lv_textarea_save(const lv_obj_t * obj, const char * path)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_ASSERT_NULL(path);
+
+    const char * txt = lv_textarea_get_text(obj);
+    uint32_t len = strlen(txt);
+
+    lv_fs_file_t f;
+    lv_fs_res_t res = lv_fs_open(&f, path, LV_FS_MODE_WR);
+    if(res != LV_FS_RES_OK) return res;
+
+    /*The driver might write less than requested, so write until everything is written*/
+    uint32_t written = 0;
+    while(written < len) {
+        uint32_t bw = 0;
+        res = lv_fs_write(&f, &txt[written], len - written, &bw);
+        if(res != LV_FS_RES_OK) break;
+        if(bw == 0) {
+            res = LV_FS_RES_FULL;
+            break;
+        }
+        written += bw;
+    }
+
+    lv_fs_res_t close_res = lv_fs_close(&f);
+    return res != LV_FS_RES_OK ? res : close_res;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -916,7 +943,11 @@ static void label_event_cb(lv_event_t * e)
     lv_obj_t * ta = lv_obj_get_parent(label);
 
     if(code == LV_EVENT_STYLE_CHANGED || code == LV_EVENT_SIZE_CHANGED) {
-        lv_label_set_text(label, NULL);
+        /*The text needs to be wrapped again only if the width has changed, not if a new line was added*/
+        const lv_area_t * coords_ori = code == LV_EVENT_SIZE_CHANGED ? lv_event_get_param(e) : NULL;
+        if(coords_ori == NULL || lv_area_get_width(coords_ori) != lv_obj_get_width(label)) {
+            lv_label_set_text(label, NULL);
+        }
         refr_cursor_area(ta);
         start_cursor_blink(ta);
     }
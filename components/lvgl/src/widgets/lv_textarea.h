@@ -23,6 +23,7 @@ extern "C" {
 #endif
 
 #include "../core/lv_obj.h"
+#include "../misc/lv_fs.h"
 #include "lv_label.h"
 
 /*********************
@@ -345,6 +346,17 @@ void lv_textarea_cursor_down(lv_obj_t * obj);
  */
 void lv_textarea_cursor_up(lv_obj_t * obj);
 
+/**
+ * Write the text of a text area into a file.
+ * The text is written directly from the text area's buffer, without copying it.
+ * The file is truncated only if the driver does it when opening files for writing
+ * (e.g. STDIO and the block cached POSIX driver, but not FatFs and POSIX).
+ * @param obj       pointer to a text area object
+ * @param path      path of the file, e.g. "S:/config.txt"
+ * @return          LV_FS_RES_OK or an error code from the file system driver
+ */
+lv_fs_res_t lv_textarea_save(const lv_obj_t * obj, const char * path);
+
 /**********************
  *      MACROS
  **********************/
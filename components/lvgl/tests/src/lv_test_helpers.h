@@ -1,6 +1,9 @@
 #ifndef LV_TEST_HELPERS_H
 #define LV_TEST_HELPERS_H
 
+#include <stdint.h>
+#include <sys/time.h>
+
 #ifdef LVGL_CI_USING_SYS_HEAP
 /* Skip checking heap as we don't have the info available */
 #define LV_HEAP_CHECK(x) do {} while(0)
@@ -13,10 +16,19 @@ static inline uint32_t lv_test_get_free_mem(void)
 {
     lv_mem_monitor_t m1;
     lv_mem_monitor(&m1);
-    return m1.free_size;
+    /*Count the free slots too to see the leaks of small allocations*/
+    return m1.free_size + m1.slab_free_size;
 }
 #endif /* LVGL_CI_USING_SYS_HEAP */
 
+/* Wall clock time in microseconds to measure the benchmark-like test cases */
+static inline uint64_t lv_test_get_time_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
 
 #endif /*LV_TEST_HELPERS_H*/
 
@@ -0,0 +1,256 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+static int32_t var1;
+static int32_t var2;
+static uint32_t ready_cnt;
+static uint32_t deleted_cnt;
+
+static void exec_cb(void * var, int32_t v)
+{
+    *((int32_t *)var) = v;
+}
+
+static void exec2_cb(void * var, int32_t v)
+{
+    *((int32_t *)var) = -v;
+}
+
+static void ready_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    ready_cnt++;
+}
+
+static void deleted_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    deleted_cnt++;
+}
+
+/*Start an other animation on `var2` when ready*/
+static void ready_start_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    lv_anim_t a2;
+    lv_anim_init(&a2);
+    lv_anim_set_var(&a2, &var2);
+    lv_anim_set_exec_cb(&a2, exec_cb);
+    lv_anim_set_values(&a2, 0, 100);
+    lv_anim_set_time(&a2, 100);
+    lv_anim_start(&a2);
+}
+
+/*Delete the animation of `var2` while running*/
+static void exec_del_cb(void * var, int32_t v)
+{
+    *((int32_t *)var) = v;
+    lv_anim_del(&var2, NULL);
+}
+
+static void anim_create(int32_t * var, lv_anim_exec_xcb_t cb, uint32_t time)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, var);
+    lv_anim_set_exec_cb(&a, cb);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_time(&a, time);
+    lv_anim_set_ready_cb(&a, ready_cb);
+    lv_anim_set_deleted_cb(&a, deleted_cb);
+    lv_anim_start(&a);
+}
+
+static void anim_step(uint32_t ms)
+{
+    lv_tick_inc(ms);
+    lv_anim_refr_now();
+}
+
+void setUp(void)
+{
+    lv_anim_del_all();
+    var1 = 0;
+    var2 = 0;
+    ready_cnt = 0;
+    deleted_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_anim_del_all();
+}
+
+void test_anim_run_to_the_end(void)
+{
+    anim_create(&var1, exec_cb, 100);
+    anim_create(&var2, exec_cb, 200);
+    TEST_ASSERT_EQUAL(2, lv_anim_count_running());
+
+    anim_step(50);
+    TEST_ASSERT_EQUAL(50, var1);
+    TEST_ASSERT_EQUAL(25, var2);
+
+    anim_step(50);
+    TEST_ASSERT_EQUAL(100, var1);
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+    TEST_ASSERT_EQUAL(1, deleted_cnt);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+    TEST_ASSERT_NULL(lv_anim_get(&var1, NULL));
+    TEST_ASSERT_NOT_NULL(lv_anim_get(&var2, exec_cb));
+
+    anim_step(100);
+    TEST_ASSERT_EQUAL(100, var2);
+    TEST_ASSERT_EQUAL(2, ready_cnt);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_TRUE(lv_anim_get_timer()->paused);
+}
+
+void test_anim_del(void)
+{
+    anim_create(&var1, exec_cb, 100);
+    anim_create(&var1, exec2_cb, 100);
+    anim_create(&var2, exec_cb, 100);
+    TEST_ASSERT_EQUAL(3, lv_anim_count_running());
+
+    TEST_ASSERT_TRUE(lv_anim_del(&var1, exec2_cb));
+    TEST_ASSERT_EQUAL(2, lv_anim_count_running());
+    TEST_ASSERT_EQUAL(1, deleted_cnt);
+    TEST_ASSERT_EQUAL(0, ready_cnt);
+
+    TEST_ASSERT_TRUE(lv_anim_del(NULL, exec_cb));
+    TEST_ASSERT_FALSE(lv_anim_del(&var1, NULL));
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_EQUAL(3, deleted_cnt);
+}
+
+void test_anim_start_replaces_the_same_anim(void)
+{
+    anim_create(&var1, exec_cb, 100);
+    anim_step(50);
+    anim_create(&var1, exec_cb, 100);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+    anim_step(50);
+    TEST_ASSERT_EQUAL(50, var1);
+}
+
+void test_anim_start_and_del_in_callbacks(void)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &var1);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_time(&a, 100);
+    lv_anim_set_ready_cb(&a, ready_start_cb);
+    lv_anim_start(&a);
+
+    anim_step(100);
+    TEST_ASSERT_EQUAL(100, var1);
+    /*Started in the ready callback but it runs only from the next round*/
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+    TEST_ASSERT_EQUAL(0, var2);
+    anim_step(50);
+    TEST_ASSERT_EQUAL(50, var2);
+
+    /*Delete the animation of `var2` from an animation started later*/
+    anim_create(&var1, exec_del_cb, 100);
+    anim_step(25);
+    TEST_ASSERT_EQUAL(25, var1);
+    TEST_ASSERT_EQUAL(50, var2);
+    TEST_ASSERT_NULL(lv_anim_get(&var2, NULL));
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+}
+
+void test_anim_playback_and_repeat(void)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &var1);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_time(&a, 100);
+    lv_anim_set_playback_time(&a, 100);
+    lv_anim_set_repeat_count(&a, 2);
+    lv_anim_set_ready_cb(&a, ready_cb);
+    lv_anim_start(&a);
+
+    anim_step(100);
+    TEST_ASSERT_EQUAL(100, var1);
+    anim_step(50);
+    TEST_ASSERT_EQUAL(50, var1);
+    anim_step(50);
+    TEST_ASSERT_EQUAL(0, var1);
+    TEST_ASSERT_EQUAL(0, ready_cnt);
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) anim_step(50);
+    TEST_ASSERT_EQUAL(0, var1);
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
+void test_anim_slots_are_reused(void)
+{
+    static int32_t vars[40];
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    uint32_t round;
+    for(round = 0; round < 10; round++) {
+        uint32_t i;
+        for(i = 0; i < 40; i++) anim_create(&vars[i], exec_cb, 10 + i);
+        TEST_ASSERT_EQUAL(40, lv_anim_count_running());
+        for(i = 0; i < 50; i++) anim_step(1);
+        TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+        for(i = 0; i < 40; i++) TEST_ASSERT_EQUAL(100, vars[i]);
+    }
+
+    /*All the memory is released when there are no animations*/
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    TEST_ASSERT_EQUAL(mon_start.free_size, mon_end.free_size);
+}
+
+void test_anim_benchmark(void)
+{
+    const uint32_t anim_cnt = 500;
+    const uint32_t frames = 200;
+    static int32_t vars[500];
+    static const lv_anim_path_cb_t paths[] = {
+        lv_anim_path_linear, lv_anim_path_ease_in, lv_anim_path_ease_out, lv_anim_path_ease_in_out, lv_anim_path_overshoot
+    };
+
+    uint32_t i;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < anim_cnt; i++) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &vars[i]);
+        lv_anim_set_exec_cb(&a, exec_cb);
+        lv_anim_set_values(&a, 0, 1000 + i);
+        lv_anim_set_time(&a, 300 + (i % 7) * 100);
+        lv_anim_set_path_cb(&a, paths[i % 5]);
+        lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+        lv_anim_set_playback_time(&a, 300);
+        lv_anim_start(&a);
+    }
+    uint64_t t_create = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < frames; i++) anim_step(LV_DISP_DEF_REFR_PERIOD);
+    uint64_t t_run = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < anim_cnt; i++) lv_anim_del(&vars[i], NULL);
+    uint64_t t_del = lv_test_get_time_us() - t_start;
+
+    printf("%u animations: start %.2f us/anim, %.1f us/frame, del %.2f us/anim\n", (unsigned)anim_cnt,
+           (double)t_create / anim_cnt, (double)t_run / frames, (double)t_del / anim_cnt);
+}
+
+#endif
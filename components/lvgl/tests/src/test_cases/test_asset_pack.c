@@ -0,0 +1,383 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if LV_USE_ASSET_PACK
+
+/*The packs are made by
+ *  cd tests
+ *  python3 ../scripts/lv_asset_pack.py -o src/test_files/assets_32.pack --depth 32 \
+ *      ../examples/assets/img_cogwheel_argb.png ../examples/assets/img_cogwheel_rgb.png \
+ *      ../examples/assets/img_star.png src/test_fonts/font_1.fnt
+ *  python3 ../scripts/lv_asset_pack.py -o src/test_files/assets_16.pack --depth 16 --rle (same files)
+ */
+#define PACK_32     "src/test_files/assets_32.pack"
+#define PACK_16     "src/test_files/assets_16.pack"
+#define PNG_ARGB    "A:../examples/assets/img_cogwheel_argb.png"
+#define PNG_RGB     "A:../examples/assets/img_cogwheel_rgb.png"
+
+extern lv_color_t test_fb[];
+
+typedef struct {
+    void * data;
+    uint32_t size;
+} mapping_t;
+
+static mapping_t map_32;
+static mapping_t map_16;
+static lv_asset_pack_t pack_32;
+static lv_asset_pack_t pack_16;
+
+/*Map a pack as `esp_partition_mmap()` does on the device*/
+static void map_file(mapping_t * m, const char * path)
+{
+    int fd = open(path, O_RDONLY);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd);
+    struct stat st;
+    fstat(fd, &st);
+    m->size = (uint32_t)st.st_size;
+    m->data = mmap(NULL, m->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    TEST_ASSERT_TRUE(m->data != MAP_FAILED);
+}
+
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Expected result of a pixel stored in RGB565 and expanded to 32 bit again*/
+static uint32_t px_565(const uint8_t * px)
+{
+    uint32_t r = px[2] >> 3;
+    uint32_t g = px[1] >> 2;
+    uint32_t b = px[0] >> 3;
+    return ((uint32_t)px[3] << 24) | (((r * 263 + 7) >> 5) << 16) | (((g * 259 + 3) >> 6) << 8) | ((b * 263 + 7) >> 5);
+}
+
+void setUp(void)
+{
+    map_file(&map_32, PACK_32);
+    map_file(&map_16, PACK_16);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_asset_pack_open(&pack_32, map_32.data, map_32.size));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_asset_pack_open(&pack_16, map_16.data, map_16.size));
+    lv_img_cache_set_size(8);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+    lv_asset_pack_close(&pack_32);
+    lv_asset_pack_close(&pack_16);
+    munmap(map_32.data, map_32.size);
+    munmap(map_16.data, map_16.size);
+}
+
+void test_asset_pack_native_img_is_zero_copy(void)
+{
+    const lv_img_dsc_t * dsc = lv_asset_pack_get_img(&pack_32, "img_cogwheel_argb.png");
+    TEST_ASSERT_NOT_NULL(dsc);
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA, dsc->header.cf);
+    TEST_ASSERT_EQUAL(100, dsc->header.w);
+    TEST_ASSERT_EQUAL(100, dsc->header.h);
+    TEST_ASSERT_EQUAL(100 * 100 * 4, dsc->data_size);
+
+    /*The pixels are used from the mapped pack*/
+    TEST_ASSERT_TRUE(dsc->data > (uint8_t *)map_32.data);
+    TEST_ASSERT_TRUE(dsc->data + dsc->data_size <= (uint8_t *)map_32.data + map_32.size);
+    TEST_ASSERT_EQUAL_PTR(dsc, lv_asset_pack_get_img(&pack_32, "img_cogwheel_argb.png"));
+
+    lv_img_decoder_dsc_t png;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&png, PNG_ARGB, lv_color_black(), 0));
+    uint32_t png_row[100];
+    lv_coord_t y;
+    for(y = 0; y < 100; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&png, 0, y, 100, (uint8_t *)png_row));
+        TEST_ASSERT_EQUAL_MEMORY(png_row, dsc->data + y * 100 * 4, sizeof(png_row));
+    }
+    lv_img_decoder_close(&png);
+
+    /*Opaque images have no alpha channel*/
+    dsc = lv_asset_pack_get_img(&pack_32, "img_cogwheel_rgb.png");
+    TEST_ASSERT_NOT_NULL(dsc);
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR, dsc->header.cf);
+
+    lv_img_decoder_dsc_t dec;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dec, dsc, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL_PTR(dsc->data, dec.img_data);
+    lv_img_decoder_close(&dec);
+}
+
+void test_asset_pack_decode_rle_16bit(void)
+{
+    const char * pngs[] = {PNG_ARGB, PNG_RGB};
+    const char * names[] = {"img_cogwheel_argb.png", "img_cogwheel_rgb.png"};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        const lv_img_dsc_t * dsc = lv_asset_pack_get_img(&pack_16, names[i]);
+        TEST_ASSERT_NOT_NULL(dsc);
+        TEST_ASSERT_EQUAL(LV_ASSET_PACK_CF, dsc->header.cf);
+
+        lv_img_decoder_dsc_t dec;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dec, dsc, lv_color_black(), 0));
+        TEST_ASSERT_NULL(dec.img_data);
+        TEST_ASSERT_EQUAL(i == 0 ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR, dec.header.cf);
+        TEST_ASSERT_EQUAL(100, dec.header.w);
+
+        lv_img_decoder_dsc_t png;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&png, pngs[i], lv_color_black(), 0));
+
+        /*Read whole rows and parts of rows starting in the middle of the RLE packets*/
+        uint32_t buf[100];
+        uint32_t png_row[100];
+        lv_coord_t y;
+        for(y = 0; y < 100; y++) {
+            lv_coord_t x = (y % 3) * 17;
+            lv_coord_t len = 100 - x - (y % 5) * 7;
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dec, x, y, len, (uint8_t *)buf));
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&png, 0, y, 100, (uint8_t *)png_row));
+
+            lv_coord_t j;
+            for(j = 0; j < len; j++) {
+                uint32_t exp = px_565((uint8_t *)&png_row[x + j]);
+                if(i == 1) exp |= 0xff000000;
+                TEST_ASSERT_EQUAL_HEX32(exp, buf[j]);
+            }
+        }
+
+        lv_img_decoder_close(&png);
+        lv_img_decoder_close(&dec);
+    }
+}
+
+void test_asset_pack_lookup(void)
+{
+    TEST_ASSERT_NULL(lv_asset_pack_get_img(&pack_32, "no_such_img.png"));
+    TEST_ASSERT_NULL(lv_asset_pack_get_img(&pack_32, ""));
+    TEST_ASSERT_NULL(lv_asset_pack_get_img(&pack_32, "IMG_STAR.PNG"));
+
+    /*Only images can be got as images*/
+    TEST_ASSERT_NULL(lv_asset_pack_get_img(&pack_32, "font_1.fnt"));
+
+    uint32_t size = 0;
+    const uint8_t * fnt = lv_asset_pack_get_data(&pack_32, "font_1.fnt", &size);
+    TEST_ASSERT_NOT_NULL(fnt);
+    TEST_ASSERT_EQUAL(6876, size);
+    TEST_ASSERT_EQUAL(0, (lv_uintptr_t)fnt & 0x3);
+    TEST_ASSERT_NULL(lv_asset_pack_get_data(&pack_32, "font_2.fnt", &size));
+
+    const lv_img_dsc_t * star = lv_asset_pack_get_img(&pack_16, "img_star.png");
+    TEST_ASSERT_NOT_NULL(star);
+    TEST_ASSERT_EQUAL(30, star->header.w);
+    TEST_ASSERT_EQUAL(29, star->header.h);
+}
+
+void test_asset_pack_reject_invalid(void)
+{
+    lv_asset_pack_t pack;
+    uint32_t * buf = lv_mem_alloc(map_32.size);
+    uint32_t * header = buf;
+    uint32_t index_ofs = ((uint32_t *)map_32.data)[3];
+
+    /*Not a pack*/
+    lv_memcpy(buf, map_32.data, map_32.size);
+    header[0] = 0x12345678;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_asset_pack_open(&pack, buf, map_32.size));
+
+    /*Truncated*/
+    lv_memcpy(buf, map_32.data, map_32.size);
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_asset_pack_open(&pack, buf, 8));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_asset_pack_open(&pack, buf, map_32.size - 4));
+
+    /*Too many entries*/
+    header[2] = 1000;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_asset_pack_open(&pack, buf, map_32.size));
+
+    /*Data out of the pack*/
+    lv_memcpy(buf, map_32.data, map_32.size);
+    lv_asset_pack_entry_t * entries = (lv_asset_pack_entry_t *)((uint8_t *)buf + index_ofs);
+    entries[1].data_size = map_32.size;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_asset_pack_open(&pack, buf, map_32.size));
+
+    /*Not sorted*/
+    lv_memcpy(buf, map_32.data, map_32.size);
+    entries[1].name_hash = 0;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_asset_pack_open(&pack, buf, map_32.size));
+
+    /*A valid copy works*/
+    lv_memcpy(buf, map_32.data, map_32.size);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_asset_pack_open(&pack, buf, map_32.size));
+    TEST_ASSERT_NOT_NULL(lv_asset_pack_get_img(&pack, "img_star.png"));
+    lv_asset_pack_close(&pack);
+
+    lv_mem_free(buf);
+}
+
+void test_asset_pack_load_font(void)
+{
+    extern lv_font_t font_1;
+    lv_font_t * font = lv_font_load("P:font_1.fnt");
+    TEST_ASSERT_NOT_NULL(font);
+    TEST_ASSERT_EQUAL(font_1.line_height, font->line_height);
+    TEST_ASSERT_EQUAL(font_1.base_line, font->base_line);
+
+    lv_font_glyph_dsc_t g1;
+    lv_font_glyph_dsc_t g2;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&font_1, &g1, 'A', 'V'));
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g2, 'A', 'V'));
+    TEST_ASSERT_EQUAL(g1.adv_w, g2.adv_w);
+    TEST_ASSERT_EQUAL(g1.box_w, g2.box_w);
+    TEST_ASSERT_EQUAL(g1.box_h, g2.box_h);
+    lv_font_free(font);
+
+    /*Only existing assets can be opened and only for reading*/
+    lv_fs_file_t f;
+    TEST_ASSERT_NOT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "P:font_2.fnt", LV_FS_MODE_RD));
+    TEST_ASSERT_NOT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "P:font_1.fnt", LV_FS_MODE_WR));
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "P:/font_1.fnt", LV_FS_MODE_RD));
+    uint32_t pos;
+    uint32_t br;
+    uint8_t buf[8];
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_END));
+    lv_fs_tell(&f, &pos);
+    TEST_ASSERT_EQUAL(6876, pos);
+    TEST_ASSERT_NOT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 8, LV_FS_SEEK_END));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 6872, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, sizeof(buf), &br));
+    TEST_ASSERT_EQUAL(4, br);
+    lv_fs_tell(&f, &pos);
+    TEST_ASSERT_EQUAL(6876, pos);
+    lv_fs_close(&f);
+}
+
+void test_asset_pack_draw_and_close(void)
+{
+    lv_obj_t * img_32 = lv_img_create(lv_scr_act());
+    lv_img_set_src(img_32, lv_asset_pack_get_img(&pack_32, "img_cogwheel_rgb.png"));
+    lv_obj_t * img_16 = lv_img_create(lv_scr_act());
+    lv_img_set_src(img_16, lv_asset_pack_get_img(&pack_16, "img_cogwheel_rgb.png"));
+    lv_obj_set_x(img_16, 200);
+    refr_screen();
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < 100; y += 9) {
+        for(x = 0; x < 100; x += 7) {
+            uint32_t c32 = lv_color_to32(test_fb[y * LV_HOR_RES + x]);
+            uint32_t c16 = lv_color_to32(test_fb[y * LV_HOR_RES + x + 200]);
+            TEST_ASSERT_UINT32_WITHIN(0x080808, c32, c16);
+        }
+    }
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.entry_cnt);
+
+    /*The images of the closed pack are removed from the cache*/
+    lv_img_dsc_t star = *lv_asset_pack_get_img(&pack_16, "img_star.png");
+    lv_obj_del(img_16);
+    lv_asset_pack_close(&pack_16);
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+
+    /*The images are not decoded without their pack*/
+    lv_img_decoder_dsc_t dec;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_open(&dec, &star, lv_color_black(), 0));
+}
+
+/*Show a screen of images without cache as after a screen change: from the packs and from PNG files*/
+void test_asset_pack_benchmark(void)
+{
+    const uint32_t img_cnt = 12;
+    const uint32_t frame_cnt = 5;
+    const char * names[] = {"pack 32 bit (zero copy)", "pack 16 bit RLE", "PNG file"};
+    uint32_t t_res[3];
+
+    lv_img_cache_set_size(0);
+    printf("%u images of 100x100 px without cache:\n", (unsigned)img_cnt);
+
+    uint32_t s;
+    for(s = 0; s < 3; s++) {
+        lv_obj_clean(lv_scr_act());
+        uint32_t i;
+        for(i = 0; i < img_cnt; i++) {
+            lv_obj_t * img = lv_img_create(lv_scr_act());
+            lv_obj_set_pos(img, (i % 6) * 120, (i / 6) * 120);
+            if(s == 0) lv_img_set_src(img, lv_asset_pack_get_img(&pack_32, "img_cogwheel_argb.png"));
+            else if(s == 1) lv_img_set_src(img, lv_asset_pack_get_img(&pack_16, "img_cogwheel_argb.png"));
+            else lv_img_set_src(img, PNG_ARGB);
+        }
+
+        uint64_t t_start = lv_test_get_time_us();
+        uint32_t f;
+        for(f = 0; f < frame_cnt; f++) refr_screen();
+        t_res[s] = (uint32_t)((lv_test_get_time_us() - t_start) / frame_cnt);
+
+        printf("  %-24s %7.2f ms/frame\n", names[s], (double)t_res[s] / 1000);
+    }
+
+    /*Reading the pixels from the memory is faster than reading and decoding a file*/
+    TEST_ASSERT_LESS_THAN(t_res[2], t_res[0]);
+    TEST_ASSERT_LESS_THAN(t_res[2], t_res[1]);
+}
+
+#else /*LV_USE_ASSET_PACK*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_asset_pack_native_img_is_zero_copy(void)
+{
+
+}
+
+void test_asset_pack_decode_rle_16bit(void)
+{
+
+}
+
+void test_asset_pack_lookup(void)
+{
+
+}
+
+void test_asset_pack_reject_invalid(void)
+{
+
+}
+
+void test_asset_pack_load_font(void)
+{
+
+}
+
+void test_asset_pack_draw_and_close(void)
+{
+
+}
+
+void test_asset_pack_benchmark(void)
+{
+
+}
+
+#endif
+
+#endif
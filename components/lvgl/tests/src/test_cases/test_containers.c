@@ -0,0 +1,262 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../src/misc/lv_gc.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+typedef struct {
+    lv_ilist_node_t node;
+    uint32_t value;
+    uint32_t payload[3];
+} item_t;
+
+static void ilist_check(const lv_ilist_t * list, const uint32_t * values, uint32_t cnt)
+{
+    uint32_t i = 0;
+    lv_ilist_node_t * node;
+    _LV_ILIST_READ(list, node) {
+        TEST_ASSERT_LESS_THAN(cnt, i);
+        TEST_ASSERT_EQUAL(values[i], lv_ilist_entry(node, item_t, node)->value);
+        i++;
+    }
+    TEST_ASSERT_EQUAL(cnt, i);
+
+    /*The backward links must match too*/
+    node = lv_ilist_get_tail(list);
+    while(node) {
+        i--;
+        TEST_ASSERT_EQUAL(values[i], lv_ilist_entry(node, item_t, node)->value);
+        node = lv_ilist_get_prev(node);
+    }
+    TEST_ASSERT_EQUAL(0, i);
+}
+
+void test_ilist_insert_and_remove(void)
+{
+    item_t items[4];
+    uint32_t i;
+    for(i = 0; i < 4; i++) items[i].value = i;
+
+    lv_ilist_t list;
+    lv_ilist_init(&list);
+    TEST_ASSERT_TRUE(lv_ilist_is_empty(&list));
+
+    lv_ilist_ins_tail(&list, &items[1].node);
+    lv_ilist_ins_head(&list, &items[0].node);
+    lv_ilist_ins_tail(&list, &items[3].node);
+    lv_ilist_ins_prev(&list, &items[3].node, &items[2].node);
+    ilist_check(&list, (const uint32_t[]) {0, 1, 2, 3}, 4);
+
+    lv_ilist_remove(&list, &items[0].node);
+    lv_ilist_remove(&list, &items[2].node);
+    ilist_check(&list, (const uint32_t[]) {1, 3}, 2);
+
+    lv_ilist_remove(&list, &items[3].node);
+    ilist_check(&list, (const uint32_t[]) {1}, 1);
+
+    /*Remove everything while iterating*/
+    lv_ilist_ins_head(&list, &items[2].node);
+    lv_ilist_node_t * node;
+    lv_ilist_node_t * node_next;
+    _LV_ILIST_READ_SAFE(&list, node, node_next) {
+        lv_ilist_remove(&list, node);
+    }
+    TEST_ASSERT_TRUE(lv_ilist_is_empty(&list));
+    TEST_ASSERT_NULL(lv_ilist_get_tail(&list));
+}
+
+void test_vec_push_insert_remove(void)
+{
+    lv_vec_t vec;
+    lv_vec_init(&vec, sizeof(uint16_t));
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) *(uint16_t *)lv_vec_push(&vec) = i;
+    *(uint16_t *)lv_vec_insert(&vec, 0) = 100;
+    *(uint16_t *)lv_vec_insert(&vec, 5) = 105;
+    *(uint16_t *)lv_vec_insert(&vec, lv_vec_get_cnt(&vec)) = 112;
+    TEST_ASSERT_EQUAL(13, lv_vec_get_cnt(&vec));
+
+    static const uint16_t ref1[] = {100, 0, 1, 2, 3, 105, 4, 5, 6, 7, 8, 9, 112};
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(ref1, vec.data, 13);
+
+    lv_vec_remove(&vec, 0);
+    lv_vec_remove(&vec, 4);
+    lv_vec_remove_swap(&vec, 1);
+    lv_vec_remove_swap(&vec, lv_vec_get_cnt(&vec) - 1);
+    static const uint16_t ref2[] = {0, 112, 2, 3, 4, 5, 6, 7, 8};
+    TEST_ASSERT_EQUAL(9, lv_vec_get_cnt(&vec));
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(ref2, vec.data, 9);
+
+    TEST_ASSERT_TRUE(lv_vec_reserve(&vec, 100));
+    TEST_ASSERT_EQUAL(100, vec.cap);
+    TEST_ASSERT_EQUAL(3, *(uint16_t *)lv_vec_at(&vec, 3));
+
+    lv_vec_clear(&vec);
+    TEST_ASSERT_EQUAL(0, lv_vec_get_cnt(&vec));
+    TEST_ASSERT_NULL(vec.data);
+}
+
+void test_vec_slots_are_reused(void)
+{
+    lv_vec_t vec;
+    lv_vec_init(&vec, sizeof(item_t));
+
+    uint32_t idx[8];
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        idx[i] = lv_vec_slot_get(&vec);
+        TEST_ASSERT_EQUAL(i, idx[i]);
+        ((item_t *)lv_vec_at(&vec, idx[i]))->value = i;
+    }
+
+    lv_vec_slot_put(&vec, idx[2]);
+    lv_vec_slot_put(&vec, idx[6]);
+
+    /*The released slots come back in LIFO order and the vector doesn't grow*/
+    TEST_ASSERT_EQUAL(6, lv_vec_slot_get(&vec));
+    TEST_ASSERT_EQUAL(2, lv_vec_slot_get(&vec));
+    TEST_ASSERT_EQUAL(8, lv_vec_get_cnt(&vec));
+    TEST_ASSERT_EQUAL(8, lv_vec_slot_get(&vec));
+    TEST_ASSERT_EQUAL(7, ((item_t *)lv_vec_at(&vec, 7))->value);
+
+    lv_vec_clear(&vec);
+}
+
+void test_img_decoder_get_next(void)
+{
+    uint32_t cnt = 0;
+    lv_img_decoder_t * d = NULL;
+    while((d = lv_img_decoder_get_next(d)) != NULL) cnt++;
+    TEST_ASSERT_GREATER_THAN(0, cnt);
+
+    /*The newest decoder is tried first*/
+    lv_img_decoder_t * dec = lv_img_decoder_create();
+    TEST_ASSERT_EQUAL_PTR(dec, lv_img_decoder_get_next(NULL));
+
+    lv_img_decoder_delete(dec);
+    d = NULL;
+    while((d = lv_img_decoder_get_next(d)) != NULL) {
+        TEST_ASSERT_NOT_EQUAL(dec, d);
+        cnt--;
+    }
+    TEST_ASSERT_EQUAL(0, cnt);
+}
+
+/*A timer and a group are reachable through the new lists*/
+void test_timer_and_group_lists(void)
+{
+    lv_timer_t * t = lv_timer_create(NULL, 1000, NULL);
+    TEST_ASSERT_EQUAL_PTR(t, lv_timer_get_next(NULL));
+    lv_timer_del(t);
+    TEST_ASSERT_NOT_EQUAL(t, lv_timer_get_next(NULL));
+
+    lv_group_t * g1 = lv_group_create();
+    lv_group_t * g2 = lv_group_create();
+    TEST_ASSERT_EQUAL_PTR(g2, lv_ilist_entry(LV_GC_ROOT(_lv_group_list).head, lv_group_t, node));
+    lv_group_del(g2);
+    TEST_ASSERT_EQUAL_PTR(g1, lv_ilist_entry(LV_GC_ROOT(_lv_group_list).head, lv_group_t, node));
+    lv_group_del(g1);
+}
+
+/*Compare lv_ll, the intrusive list and the vector on timer/decoder like workloads.
+ *Other allocations are interleaved with the list items as it happens in the UI's heap.*/
+void test_containers_benchmark(void)
+{
+#define BENCH_ITEM_CNT  300
+#define BENCH_ROUNDS    1000
+    static void * filler[BENCH_ITEM_CNT];
+    static item_t * items[BENCH_ITEM_CNT];
+    volatile uint32_t sink = 0;
+    uint32_t i;
+    uint32_t r;
+
+    /*lv_ll*/
+    lv_ll_t ll;
+    _lv_ll_init(&ll, sizeof(item_t));
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_ITEM_CNT; i++) {
+        items[i] = _lv_ll_ins_tail(&ll);
+        items[i]->value = i;
+        filler[i] = lv_mem_alloc(32);
+    }
+    uint64_t t_ll_ins = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    for(r = 0; r < BENCH_ROUNDS; r++) {
+        item_t * it;
+        _LV_LL_READ(&ll, it) sink += it->value;
+    }
+    uint64_t t_ll_iter = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_ITEM_CNT; i++) {
+        item_t * it = items[(i * 7) % BENCH_ITEM_CNT];
+        _lv_ll_remove(&ll, it);
+        lv_mem_free(it);
+    }
+    uint64_t t_ll_rem = lv_test_get_time_us() - t_start;
+    for(i = 0; i < BENCH_ITEM_CNT; i++) lv_mem_free(filler[i]);
+
+    /*Intrusive list*/
+    lv_ilist_t list;
+    lv_ilist_init(&list);
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_ITEM_CNT; i++) {
+        items[i] = lv_mem_alloc(sizeof(item_t));
+        items[i]->value = i;
+        lv_ilist_ins_tail(&list, &items[i]->node);
+        filler[i] = lv_mem_alloc(32);
+    }
+    uint64_t t_il_ins = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    for(r = 0; r < BENCH_ROUNDS; r++) {
+        lv_ilist_node_t * node;
+        _LV_ILIST_READ(&list, node) sink += lv_ilist_entry(node, item_t, node)->value;
+    }
+    uint64_t t_il_iter = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_ITEM_CNT; i++) {
+        item_t * it = items[(i * 7) % BENCH_ITEM_CNT];
+        lv_ilist_remove(&list, &it->node);
+        lv_mem_free(it);
+    }
+    uint64_t t_il_rem = lv_test_get_time_us() - t_start;
+    for(i = 0; i < BENCH_ITEM_CNT; i++) lv_mem_free(filler[i]);
+
+    /*Vector of the items themselves (ordered remove)*/
+    lv_vec_t vec;
+    lv_vec_init(&vec, sizeof(item_t));
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_ITEM_CNT; i++) {
+        item_t * it = lv_vec_push(&vec);
+        it->value = i;
+        filler[i] = lv_mem_alloc(32);
+    }
+    uint64_t t_vec_ins = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    for(r = 0; r < BENCH_ROUNDS; r++) {
+        item_t * it = (item_t *)vec.data;
+        for(i = 0; i < vec.cnt; i++) sink += it[i].value;
+    }
+    uint64_t t_vec_iter = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    while(vec.cnt) lv_vec_remove(&vec, vec.cnt / 2);
+    uint64_t t_vec_rem = lv_test_get_time_us() - t_start;
+    lv_vec_clear(&vec);
+    for(i = 0; i < BENCH_ITEM_CNT; i++) lv_mem_free(filler[i]);
+    LV_UNUSED(sink);
+
+    printf("%u items, insert / %u iterations / remove (us):\n", BENCH_ITEM_CNT, BENCH_ROUNDS);
+    printf("  lv_ll:    %6.1f / %8.1f / %6.1f\n", (double)t_ll_ins, (double)t_ll_iter, (double)t_ll_rem);
+    printf("  lv_ilist: %6.1f / %8.1f / %6.1f\n", (double)t_il_ins, (double)t_il_iter, (double)t_il_rem);
+    printf("  lv_vec:   %6.1f / %8.1f / %6.1f\n", (double)t_vec_ins, (double)t_vec_iter, (double)t_vec_rem);
+}
+
+#endif
@@ -2,6 +2,8 @@
 #include "../lvgl.h"
 
 #include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
 
 static void event_object_deletion_cb(const lv_obj_class_t * cls, lv_event_t * e)
 {
@@ -24,4 +26,152 @@ void test_event_object_deletion(void)
     lv_event_send(obj, LV_EVENT_VALUE_CHANGED, NULL);
 }
 
+static uint32_t cb_cnt;
+
+static void count_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    cb_cnt++;
+}
+
+static uint32_t skipped_on_send(lv_obj_t * obj, lv_event_code_t code, void * param)
+{
+    lv_event_monitor_t mon;
+    lv_event_monitor_reset();
+    lv_event_send(obj, code, param);
+    lv_event_monitor(&mon);
+    return mon.skip_cnt;
+}
+
+void test_event_mask_of_callbacks(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    cb_cnt = 0;
+
+    /*Neither the label nor lv_obj handles these*/
+    TEST_ASSERT_EQUAL(1, skipped_on_send(label, LV_EVENT_DRAW_PART_BEGIN, NULL));
+    TEST_ASSERT_EQUAL(1, skipped_on_send(label, LV_EVENT_READY, NULL));
+
+    lv_obj_add_event_cb(label, count_cb, LV_EVENT_DRAW_PART_BEGIN, NULL);
+    TEST_ASSERT_EQUAL(0, skipped_on_send(label, LV_EVENT_DRAW_PART_BEGIN, NULL));
+    TEST_ASSERT_EQUAL(1, cb_cnt);
+    TEST_ASSERT_EQUAL(1, skipped_on_send(label, LV_EVENT_READY, NULL));
+
+    lv_obj_add_event_cb(label, count_cb, LV_EVENT_READY | LV_EVENT_PREPROCESS, NULL);
+    TEST_ASSERT_EQUAL(0, skipped_on_send(label, LV_EVENT_READY, NULL));
+    TEST_ASSERT_EQUAL(2, cb_cnt);
+
+    /*Removing a callback recalculates the mask*/
+    lv_obj_remove_event_cb(label, count_cb);
+    TEST_ASSERT_EQUAL(1, skipped_on_send(label, LV_EVENT_DRAW_PART_BEGIN, NULL));
+    TEST_ASSERT_EQUAL(0, skipped_on_send(label, LV_EVENT_READY, NULL));
+    TEST_ASSERT_EQUAL(3, cb_cnt);
+
+    lv_obj_add_event_cb(label, count_cb, LV_EVENT_ALL, NULL);
+    TEST_ASSERT_EQUAL(0, skipped_on_send(label, LV_EVENT_DRAW_PART_BEGIN, NULL));
+    TEST_ASSERT_EQUAL(4, cb_cnt);
+
+    /*Registered codes share a bit*/
+    uint32_t my_code = lv_event_register_id();
+    TEST_ASSERT_EQUAL(0, skipped_on_send(label, my_code, NULL));
+    lv_obj_remove_event_cb(label, NULL);
+    lv_obj_remove_event_cb(label, NULL);
+    TEST_ASSERT_EQUAL(1, skipped_on_send(label, my_code, NULL));
+
+    lv_obj_del(label);
+}
+
+void test_event_mask_of_classes(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "Hello");
+
+    /*Handled by the label class*/
+    lv_point_t p = {0, 0};
+    TEST_ASSERT_EQUAL(0, skipped_on_send(label, LV_EVENT_GET_SELF_SIZE, &p));
+    TEST_ASSERT_GREATER_THAN(0, p.x);
+
+    /*Handled only by the base class*/
+    TEST_ASSERT_EQUAL(0, skipped_on_send(label, LV_EVENT_PRESSED, NULL));
+    TEST_ASSERT_TRUE(lv_obj_has_state(label, LV_STATE_PRESSED));
+
+    /*A class without `event_mask` gets every code*/
+    lv_obj_t * obj = lv_obj_class_create_obj(&event_object_deletion_class, lv_scr_act());
+    lv_obj_class_init_obj(obj);
+    TEST_ASSERT_EQUAL(0, skipped_on_send(obj, LV_EVENT_DRAW_PART_BEGIN, NULL));
+
+    lv_obj_del(obj);
+    lv_obj_del(label);
+}
+
+void test_event_bubbling(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_scr_act());
+    lv_obj_t * child = lv_obj_create(parent);
+    lv_obj_add_flag(child, LV_OBJ_FLAG_EVENT_BUBBLE);
+    lv_obj_add_event_cb(parent, count_cb, LV_EVENT_CLICKED, NULL);
+    cb_cnt = 0;
+
+    lv_event_monitor_t mon;
+    lv_event_monitor_reset();
+    lv_event_send(child, LV_EVENT_CLICKED, NULL);
+    lv_event_monitor(&mon);
+    TEST_ASSERT_EQUAL(1, cb_cnt);
+    TEST_ASSERT_EQUAL(1, mon.send_cnt);
+    TEST_ASSERT_EQUAL(2, mon.dispatch_cnt);
+    TEST_ASSERT_EQUAL(1, mon.skip_cnt);
+
+    /*Drawing events don't bubble*/
+    lv_obj_add_event_cb(parent, count_cb, LV_EVENT_DRAW_PART_BEGIN, NULL);
+    lv_event_send(child, LV_EVENT_DRAW_PART_BEGIN, NULL);
+    TEST_ASSERT_EQUAL(1, cb_cnt);
+
+    lv_obj_del(parent);
+}
+
+void test_event_benchmark_frame(void)
+{
+    const uint32_t frames = 50;
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+
+    uint32_t i;
+    for(i = 0; i < 24; i++) {
+        lv_obj_t * btn = lv_btn_create(cont);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Item %d", (int)i);
+        if(i % 4 == 0) lv_slider_create(cont);
+        if(i % 6 == 0) lv_switch_create(cont);
+    }
+    lv_refr_now(NULL);
+
+    lv_event_monitor_reset();
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < frames; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+    uint64_t t_frames = lv_test_get_time_us() - t_start;
+
+    lv_event_monitor_t mon;
+    lv_event_monitor(&mon);
+    printf("Full redraw: %.1f us/frame, %u events/frame (%u dispatches, %u skipped)\n",
+           (double)t_frames / frames, (unsigned)(mon.send_cnt / frames), (unsigned)(mon.dispatch_cnt / frames),
+           (unsigned)(mon.skip_cnt / frames));
+
+    /*The drawing hooks sent to every object, usually without any handler*/
+    static const lv_event_code_t hooks[] = {
+        LV_EVENT_DRAW_MAIN_BEGIN, LV_EVENT_DRAW_MAIN_END, LV_EVENT_DRAW_POST_BEGIN, LV_EVENT_DRAW_POST_END,
+        LV_EVENT_DRAW_PART_BEGIN, LV_EVENT_DRAW_PART_END
+    };
+    lv_obj_t * label = lv_obj_get_child(lv_obj_get_child(cont, 0), 0);
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < 100000; i++) lv_event_send(label, hooks[i % 6], NULL);
+    uint64_t t_hooks = lv_test_get_time_us() - t_start;
+    printf("Unhandled event: %.1f ns/event\n", (double)t_hooks / 100);
+
+    lv_obj_del(cont);
+}
+
 #endif
@@ -11,26 +11,56 @@
 #include "../../lvgl.h"
 
 #include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
 
 /*********************
  *      DEFINES
  *********************/
 
+#define SIMSUN_FNT "src/test_files/simsun_16_cjk.fnt"
+
+/*The ASCII, the kana and the first 200 CJK glyphs of SimSun. It's quick to write and compare.*/
+#define SIMSUN_GLYPH_CNT 448
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_FONT_SIMSUN_16_CJK
+typedef struct {
+    uint8_t * data;
+    uint32_t len;
+    uint32_t cap;
+    uint32_t bit_len;
+} bin_writer_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
+static void compare_glyphs(const lv_font_t * f1, const lv_font_t * f2);
+static void compare_letter(const lv_font_t * f1, const lv_font_t * f2, uint32_t letter);
+#if LV_FONT_SIMSUN_16_CJK
+static const lv_font_t * get_simsun_subset(uint32_t glyph_cnt);
+static void write_fnt(const lv_font_t * font, const char * path);
+static void writer_free(bin_writer_t * w);
+static void bench_font(const char * name, const char * path, uint32_t cache_size);
+#endif
 void test_font_loader(void);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 
+#if LV_FONT_SIMSUN_16_CJK
+/*Freed in `tearDown()` too as a failed assertion leaves `write_fnt()`*/
+static bin_writer_t fnt_writer;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -43,6 +73,18 @@ extern lv_font_t font_1;
 extern lv_font_t font_2;
 extern lv_font_t font_3;
 
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+#if LV_FONT_SIMSUN_16_CJK
+    writer_free(&fnt_writer);
+    remove(SIMSUN_FNT);
+#endif
+}
+
 void test_font_loader(void)
 {
     /*Test with cahce ('A' has cache)*/
@@ -72,6 +114,72 @@ void test_font_loader(void)
     lv_font_free(font_3_bin);
 }
 
+void test_font_loader_streamed(void)
+{
+    const char * drives[] = {"A", "B", "C"};
+    uint32_t cache_sizes[] = {256, 2048, 100000};
+
+    for(uint32_t i = 0; i < 3; i++) {
+        char path[64];
+        lv_snprintf(path, sizeof(path), "%s:src/test_fonts/font_1.fnt", drives[i]);
+        lv_font_t * font_1_bin = lv_font_load_streamed(path, cache_sizes[i]);
+        lv_snprintf(path, sizeof(path), "%s:src/test_fonts/font_2.fnt", drives[i]);
+        lv_font_t * font_2_bin = lv_font_load_streamed(path, cache_sizes[i]);
+        lv_snprintf(path, sizeof(path), "%s:src/test_fonts/font_3.fnt", drives[i]);
+        lv_font_t * font_3_bin = lv_font_load_streamed(path, cache_sizes[i]);
+
+        /*Only the metrics are in RAM so compare the glyphs through the font API*/
+        compare_glyphs(&font_1, font_1_bin);
+        compare_glyphs(&font_2, font_2_bin);
+        compare_glyphs(&font_3, font_3_bin);
+
+        /*Again in a different order to hit and miss the cache*/
+        compare_glyphs(&font_3, font_3_bin);
+        compare_glyphs(&font_1, font_1_bin);
+
+        lv_font_free(font_1_bin);
+        lv_font_free(font_2_bin);
+        lv_font_free(font_3_bin);
+    }
+
+    TEST_ASSERT_NULL(lv_font_load_streamed("A:src/test_fonts/font_1.fnt", 0));
+    TEST_ASSERT_NULL(lv_font_load_streamed("A:src/test_fonts/not_exists.fnt", 1024));
+}
+
+void test_font_loader_unaligned(void)
+{
+#if LV_FONT_SIMSUN_16_CJK
+    /*The metrics of the glyphs take 44 bits so the bitmaps don't start on a byte boundary*/
+    const lv_font_t * simsun = get_simsun_subset(SIMSUN_GLYPH_CNT);
+    write_fnt(simsun, SIMSUN_FNT);
+
+    lv_font_t * font_bin = lv_font_load("B:" SIMSUN_FNT);
+    compare_glyphs(simsun, font_bin);
+    lv_font_free(font_bin);
+
+    font_bin = lv_font_load_streamed("C:" SIMSUN_FNT, 4096);
+    compare_glyphs(simsun, font_bin);
+    lv_font_free(font_bin);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_font_loader_streamed_benchmark(void)
+{
+#if LV_FONT_SIMSUN_16_CJK
+    write_fnt(get_simsun_subset(SIMSUN_GLYPH_CNT), SIMSUN_FNT);
+
+    printf("Font loading (%s, %d glyphs):\n", SIMSUN_FNT, SIMSUN_GLYPH_CNT);
+    bench_font("lv_font_load", "B:" SIMSUN_FNT, 0);
+    bench_font("streamed, 4 kB cache", "B:" SIMSUN_FNT, 4 * 1024);
+    bench_font("streamed, 16 kB cache", "B:" SIMSUN_FNT, 16 * 1024);
+    bench_font("streamed, 16 kB cache, C:", "C:" SIMSUN_FNT, 16 * 1024);
+#else
+    TEST_PASS();
+#endif
+}
+
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(f1, "font not null");
@@ -216,5 +324,349 @@ static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
  *   STATIC FUNCTIONS
  **********************/
 
+/*Compare the glyphs of every letter of `f1` through the font API*/
+static void compare_glyphs(const lv_font_t * f1, const lv_font_t * f2)
+{
+    TEST_ASSERT_NOT_NULL_MESSAGE(f1, "font not null");
+    TEST_ASSERT_NOT_NULL_MESSAGE(f2, "font not null");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(f1->line_height, f2->line_height, "line_height");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(f1->base_line, f2->base_line, "base_line");
+
+    const lv_font_fmt_txt_dsc_t * dsc = f1->dsc;
+    for(uint32_t i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc->cmaps[i];
+        if(cmap->unicode_list) {
+            for(uint32_t k = 0; k < cmap->list_length; k++) {
+                compare_letter(f1, f2, cmap->range_start + cmap->unicode_list[k]);
+            }
+        }
+        else {
+            for(uint32_t k = 0; k < cmap->range_length; k++) {
+                compare_letter(f1, f2, cmap->range_start + k);
+            }
+        }
+    }
+
+    /*Not existing letters*/
+    compare_letter(f1, f2, 0x01);
+    compare_letter(f1, f2, 0x1F600);
+}
+
+static void compare_letter(const lv_font_t * f1, const lv_font_t * f2, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g1;
+    lv_font_glyph_dsc_t g2;
+    bool found1 = lv_font_get_glyph_dsc(f1, &g1, letter, 0);
+    bool found2 = lv_font_get_glyph_dsc(f2, &g2, letter, 0);
+    TEST_ASSERT_EQUAL_MESSAGE(found1, found2, "glyph found");
+    if(!found1) return;
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(g1.adv_w, g2.adv_w, "adv_w");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(g1.box_w, g2.box_w, "box_w");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(g1.box_h, g2.box_h, "box_h");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(g1.ofs_x, g2.ofs_x, "ofs_x");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(g1.ofs_y, g2.ofs_y, "ofs_y");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(g1.bpp, g2.bpp, "bpp");
+    if(g1.box_w * g1.box_h == 0) return;
+
+    /*The bitmap of the compiled font is valid only until the next call so copy it*/
+    static uint8_t bmp1[4096];
+    uint32_t bits = g1.box_w * g1.box_h * (g1.bpp == 3 ? 4 : g1.bpp);
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(bmp1) * 8, bits);
+    const uint8_t * bmp = lv_font_get_glyph_bitmap(f1, letter);
+    TEST_ASSERT_NOT_NULL(bmp);
+    memcpy(bmp1, bmp, (bits + 7) / 8);
+
+    const uint8_t * bmp2 = lv_font_get_glyph_bitmap(f2, letter);
+    TEST_ASSERT_NOT_NULL_MESSAGE(bmp2, "glyph_bitmap");
+    if(bits >= 8) TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(bmp1, bmp2, bits / 8, "glyph_bitmap");
+
+    /*The padding bits of the last byte can be anything*/
+    if(bits % 8) {
+        uint8_t mask = 0xFF << (8 - bits % 8);
+        TEST_ASSERT_EQUAL_HEX8_MESSAGE(bmp1[bits / 8] & mask, bmp2[bits / 8] & mask, "glyph_bitmap");
+    }
+}
+
+#if LV_FONT_SIMSUN_16_CJK
+
+/**
+ * Get a copy of SimSun which has only the glyphs with lower ID than `glyph_cnt`.
+ * The glyph descriptors and the bitmaps are shared with the original font.
+ */
+static const lv_font_t * get_simsun_subset(uint32_t glyph_cnt)
+{
+    static lv_font_t font;
+    static lv_font_fmt_txt_dsc_t dsc;
+    static lv_font_fmt_txt_cmap_t cmaps[8];
+    static lv_font_fmt_txt_glyph_cache_t cache;
+
+    const lv_font_fmt_txt_dsc_t * src = lv_font_simsun_16_cjk.dsc;
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(cmaps) / sizeof(cmaps[0]), src->cmap_num);
+
+    dsc = *src;
+    dsc.cmaps = cmaps;
+    dsc.cmap_num = 0;
+    dsc.cache = &cache;     /*The glyph ID of the last letter can't be cached together with the original font*/
+    lv_memset_00(&cache, sizeof(cache));
+
+    for(uint32_t i = 0; i < src->cmap_num && src->cmaps[i].glyph_id_start < glyph_cnt; i++) {
+        lv_font_fmt_txt_cmap_t * cmap = &cmaps[dsc.cmap_num];
+        *cmap = src->cmaps[i];
+        dsc.cmap_num++;
+
+        /*Only the cmaps with consecutive glyph IDs can be cut*/
+        uint32_t max_len = glyph_cnt - cmap->glyph_id_start;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+            cmap->range_length = LV_MIN(cmap->range_length, max_len);
+        }
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
+            if(cmap->list_length > max_len) {
+                cmap->list_length = max_len;
+                cmap->range_length = cmap->unicode_list[max_len - 1] + 1;
+            }
+        }
+        else {
+            TEST_ASSERT_TRUE(i + 1 == src->cmap_num || src->cmaps[i + 1].glyph_id_start <= glyph_cnt);
+        }
+    }
+
+    font = lv_font_simsun_16_cjk;
+    font.dsc = &dsc;
+    return &font;
+}
+
+static void write_u8(bin_writer_t * w, uint32_t v)
+{
+    if(w->len == w->cap) {
+        uint32_t cap = w->cap ? w->cap * 2 : 4096;
+        uint8_t * data = realloc(w->data, cap);
+        TEST_ASSERT_NOT_NULL(data);
+        w->data = data;
+        w->cap = cap;
+    }
+    w->data[w->len++] = v;
+}
+
+static void writer_free(bin_writer_t * w)
+{
+    free(w->data);
+    lv_memset_00(w, sizeof(bin_writer_t));
+}
+
+static void write_u16(bin_writer_t * w, uint32_t v)
+{
+    write_u8(w, v & 0xFF);
+    write_u8(w, v >> 8);
+}
+
+static void write_u32(bin_writer_t * w, uint32_t v)
+{
+    write_u16(w, v & 0xFFFF);
+    write_u16(w, v >> 16);
+}
+
+static void set_u32(bin_writer_t * w, uint32_t pos, uint32_t v)
+{
+    for(uint32_t i = 0; i < 4; i++) w->data[pos + i] = (v >> (i * 8)) & 0xFF;
+}
+
+/*Write bits MSB first and append a byte when the last one is full*/
+static void write_bits(bin_writer_t * w, uint32_t v, uint32_t n)
+{
+    while(n) {
+        n--;
+        if(w->bit_len % 8 == 0) write_u8(w, 0);
+        if((v >> n) & 1) w->data[w->len - 1] |= 0x80 >> (w->bit_len % 8);
+        w->bit_len++;
+    }
+}
+
+/*Start a table and return where its length should be written*/
+static uint32_t write_label(bin_writer_t * w, const char * label)
+{
+    uint32_t pos = w->len;
+    write_u32(w, 0);
+    for(uint32_t i = 0; i < 4; i++) write_u8(w, label[i]);
+    return pos;
+}
+
+/**
+ * Save a plain, compiled font without kerning in the binary format of `lv_font_conv`.
+ * The metrics are stored on 12 + 4 * 8 bits so the bitmaps are not aligned to bytes.
+ */
+static void write_fnt(const lv_font_t * font, const char * path)
+{
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    TEST_ASSERT_EQUAL(LV_FONT_FMT_TXT_PLAIN, dsc->bitmap_format);
+    TEST_ASSERT_NULL(dsc->kern_dsc);
+
+    bin_writer_t * w = &fnt_writer;
+    writer_free(w);
+
+    uint32_t pos = write_label(w, "head");
+    write_u32(w, 1);                                   /*version*/
+    write_u16(w, 3);                                   /*tables_count*/
+    write_u16(w, font->line_height);                   /*font_size*/
+    write_u16(w, font->line_height - font->base_line); /*ascent*/
+    write_u16(w, -font->base_line);                    /*descent*/
+    write_u16(w, font->line_height - font->base_line); /*typo_ascent*/
+    write_u16(w, -font->base_line);                    /*typo_descent*/
+    write_u16(w, 0);                                   /*typo_line_gap*/
+    write_u16(w, -font->base_line);                    /*min_y*/
+    write_u16(w, font->line_height - font->base_line); /*max_y*/
+    write_u16(w, 0);                                   /*default_advance_width*/
+    write_u16(w, 0);                                   /*kerning_scale*/
+    write_u8(w, 1);                                    /*index_to_loc_format*/
+    write_u8(w, 1);                                    /*glyph_id_format*/
+    write_u8(w, 1);                                    /*advance_width_format*/
+    write_u8(w, dsc->bpp);                             /*bits_per_pixel*/
+    write_u8(w, 8);                                    /*xy_bits*/
+    write_u8(w, 8);                                    /*wh_bits*/
+    write_u8(w, 12);                                   /*advance_width_bits*/
+    write_u8(w, 0);                                    /*compression_id*/
+    write_u8(w, 0);                                    /*subpixels_mode*/
+    write_u8(w, 0);                                    /*padding*/
+    write_u16(w, font->underline_position);
+    write_u16(w, font->underline_thickness);
+    set_u32(w, pos, w->len - pos);
+
+    uint32_t cmaps_start = write_label(w, "cmap");
+    write_u32(w, dsc->cmap_num);
+    uint32_t tables_pos = w->len;
+    for(uint32_t i = 0; i < dsc->cmap_num * 16; i++) write_u8(w, 0);
+
+    uint32_t glyph_cnt = 1;
+    for(uint32_t i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc->cmaps[i];
+        uint32_t entries = cmap->list_length;
+        uint32_t t = tables_pos + i * 16;
+        set_u32(w, t, w->len - cmaps_start);
+        set_u32(w, t + 4, cmap->range_start);
+        w->data[t + 8] = cmap->range_length & 0xFF;
+        w->data[t + 9] = cmap->range_length >> 8;
+        w->data[t + 10] = cmap->glyph_id_start & 0xFF;
+        w->data[t + 11] = cmap->glyph_id_start >> 8;
+        w->data[t + 12] = entries & 0xFF;
+        w->data[t + 13] = entries >> 8;
+        w->data[t + 14] = cmap->type;
+
+        uint32_t last_id = cmap->glyph_id_start;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+            last_id += cmap->range_length - 1;
+        }
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            const uint8_t * ofs = cmap->glyph_id_ofs_list;
+            for(uint32_t k = 0; k < entries; k++) {
+                write_u8(w, ofs[k]);
+                last_id = LV_MAX(last_id, cmap->glyph_id_start + ofs[k]);
+            }
+        }
+        else {
+            for(uint32_t k = 0; k < entries; k++) write_u16(w, cmap->unicode_list[k]);
+            if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+                const uint16_t * ofs = cmap->glyph_id_ofs_list;
+                for(uint32_t k = 0; k < entries; k++) {
+                    write_u16(w, ofs[k]);
+                    last_id = LV_MAX(last_id, cmap->glyph_id_start + ofs[k]);
+                }
+            }
+            else {
+                last_id += entries - 1;
+            }
+        }
+        glyph_cnt = LV_MAX(glyph_cnt, last_id + 1);
+    }
+    set_u32(w, cmaps_start, w->len - cmaps_start);
+
+    pos = write_label(w, "loca");
+    write_u32(w, glyph_cnt);
+    uint32_t loca_pos = w->len;
+    for(uint32_t i = 0; i < glyph_cnt; i++) write_u32(w, 0);
+    set_u32(w, pos, w->len - pos);
+
+    uint32_t glyf_start = write_label(w, "glyf");
+    for(uint32_t i = 0; i < glyph_cnt; i++) {
+        const lv_font_fmt_txt_glyph_dsc_t * gdsc = &dsc->glyph_dsc[i];
+        set_u32(w, loca_pos + i * 4, w->len - glyf_start);
+        w->bit_len = 0;
+        write_bits(w, gdsc->adv_w, 12);
+        write_bits(w, gdsc->ofs_x & 0xFF, 8);
+        write_bits(w, gdsc->ofs_y & 0xFF, 8);
+        write_bits(w, gdsc->box_w, 8);
+        write_bits(w, gdsc->box_h, 8);
+        if(i == 0) continue;
+
+        uint32_t bmp_size = (gdsc->box_w * gdsc->box_h * dsc->bpp + 7) / 8;
+        const uint8_t * bmp = &dsc->glyph_bitmap[gdsc->bitmap_index];
+        for(uint32_t k = 0; k < bmp_size; k++) write_bits(w, bmp[k], 8);
+    }
+    set_u32(w, glyf_start, w->len - glyf_start);
+
+    FILE * f = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(w->len, fwrite(w->data, 1, w->len, f));
+    fclose(f);
+    writer_free(w);
+}
+
+/*Measure loading a font and drawing a CJK and an ASCII paragraph with it*/
+static void bench_font(const char * name, const char * path, uint32_t cache_size)
+{
+    static const char * ascii_txt =
+        "The quick brown fox jumps over the lazy dog. 0123456789 (a+b) = [c*d] / {e-f}; \"ok\"!";
+
+    /*80 different letters from the CJK part of the font. About 10 kB of bitmaps.*/
+    static char cjk_txt[80 * 3 + 1];
+    const lv_font_fmt_txt_cmap_t * cmap = &((const lv_font_fmt_txt_dsc_t *)lv_font_simsun_16_cjk.dsc)->cmaps[5];
+    for(uint32_t i = 0; i < 80; i++) {
+        uint32_t letter = cmap->range_start + cmap->unicode_list[i % cmap->list_length];
+        cjk_txt[i * 3] = 0xE0 | (letter >> 12);
+        cjk_txt[i * 3 + 1] = 0x80 | ((letter >> 6) & 0x3F);
+        cjk_txt[i * 3 + 2] = 0x80 | (letter & 0x3F);
+    }
+    cjk_txt[80 * 3] = '\0';
+
+    uint32_t free_before = lv_test_get_free_mem();
+    uint64_t t = lv_test_get_time_us();
+    lv_font_t * font = cache_size ? lv_font_load_streamed(path, cache_size) : lv_font_load(path);
+    uint64_t t_load = lv_test_get_time_us() - t;
+    TEST_ASSERT_NOT_NULL(font);
+    uint32_t ram_load = free_before - lv_test_get_free_mem();
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 400);
+    lv_obj_set_style_text_font(label, font, 0);
+
+    /*The first round loads the glyphs, the others should find most of them in the cache*/
+    uint64_t t_render[2] = {0, 0};
+    const char * txts[] = {cjk_txt, ascii_txt};
+    for(uint32_t round = 0; round < 4; round++) {
+        for(uint32_t i = 0; i < 2; i++) {
+            t = lv_test_get_time_us();
+            lv_label_set_text_static(label, txts[i]);
+            lv_obj_invalidate(label);
+            lv_refr_now(NULL);
+            if(round > 0) t_render[i] += lv_test_get_time_us() - t;
+        }
+    }
+    uint32_t ram_used = free_before - lv_test_get_free_mem();
+
+    lv_obj_del(label);
+    lv_font_free(font);
+
+#ifdef LVGL_CI_USING_SYS_HEAP
+    /*The RAM usage can't be measured on the system heap*/
+    LV_UNUSED(ram_load);
+    LV_UNUSED(ram_used);
+    printf("  %-28s load %6d us, draw CJK %6d us, ASCII %6d us\n",
+           name, (int)t_load, (int)(t_render[0] / 3), (int)(t_render[1] / 3));
+#else
+    printf("  %-28s load %6d us, RAM after load %7d B, after drawing %7d B, draw CJK %6d us, ASCII %6d us\n",
+           name, (int)t_load, (int)ram_load, (int)ram_used, (int)(t_render[0] / 3), (int)(t_render[1] / 3));
+#endif
+}
+#endif /*LV_FONT_SIMSUN_16_CJK*/
+
 #endif // LV_BUILD_TEST
 
@@ -0,0 +1,350 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if LV_USE_FS_CACHED
+
+#define DATA_FILE       "src/test_files/fs_cached.bin"
+#define DATA_FILE_SIZE  100000
+
+static uint8_t * ref;
+
+static uint32_t rnd_next(uint32_t * seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+/*Write the reference data in odd sized chunks through the driver*/
+static void create_test_file(void)
+{
+    lv_fs_file_t f;
+    remove(DATA_FILE);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "C:" DATA_FILE, LV_FS_MODE_WR));
+    uint32_t pos = 0;
+    while(pos < DATA_FILE_SIZE) {
+        uint32_t bw;
+        uint32_t n = LV_MIN(777, DATA_FILE_SIZE - pos);
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, ref + pos, n, &bw));
+        TEST_ASSERT_EQUAL(n, bw);
+        pos += n;
+    }
+    lv_fs_close(&f);
+}
+
+static void read_all(const char * path, uint32_t chunk)
+{
+    lv_fs_file_t f;
+    uint8_t buf[128];
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+    uint32_t br = 1;
+    while(br) {
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, chunk, &br));
+    }
+    lv_fs_close(&f);
+}
+
+void setUp(void)
+{
+    uint32_t seed = 7;
+    uint32_t i;
+    ref = malloc(DATA_FILE_SIZE);
+    for(i = 0; i < DATA_FILE_SIZE; i++) ref[i] = rnd_next(&seed) & 0xff;
+    create_test_file();
+    lv_fs_cached_invalidate(NULL);
+    lv_fs_cached_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_fs_cached_invalidate(NULL);
+    remove(DATA_FILE);
+    free(ref);
+}
+
+void test_fs_cached_random_access(void)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "C:" DATA_FILE, LV_FS_MODE_RD));
+
+    uint8_t * buf = malloc(20000);
+    uint32_t seed = 1;
+    uint32_t i;
+    for(i = 0; i < 2000; i++) {
+        uint32_t pos = rnd_next(&seed) % (DATA_FILE_SIZE + 1000);
+        uint32_t len = rnd_next(&seed) % (i % 10 == 0 ? 20000 : 300);
+        uint32_t whence = rnd_next(&seed) % 3;
+        uint32_t tell;
+        if(whence == 0 || pos >= DATA_FILE_SIZE) {
+            TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, pos, LV_FS_SEEK_SET));
+        }
+        else if(whence == 1) {
+            TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_SET));
+            TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, pos, LV_FS_SEEK_CUR));
+        }
+        else {
+            pos = DATA_FILE_SIZE - pos % 5000;
+            TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_END));
+            TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_SET));
+            TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, pos, LV_FS_SEEK_SET));
+        }
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, &tell));
+        TEST_ASSERT_EQUAL(pos, tell);
+
+        /*Continue sequentially sometimes*/
+        uint32_t rep = i % 3 == 0 ? 4 : 1;
+        while(rep--) {
+            uint32_t br;
+            uint32_t exp_br = pos >= DATA_FILE_SIZE ? 0 : LV_MIN(len, DATA_FILE_SIZE - pos);
+            TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, len, &br));
+            TEST_ASSERT_EQUAL(exp_br, br);
+            if(br) TEST_ASSERT_EQUAL_MEMORY(ref + pos, buf, br);
+            pos += br;
+            TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, &tell));
+            TEST_ASSERT_EQUAL(pos, tell);
+        }
+    }
+
+    lv_fs_close(&f);
+    free(buf);
+
+    lv_fs_cached_stats_t stats;
+    lv_fs_cached_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.hit_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.seek_back_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.seek_far_cnt);
+    TEST_ASSERT_LESS_THAN(stats.seek_cnt, stats.dev_seek_cnt);
+}
+
+void test_fs_cached_sequential_read_ahead(void)
+{
+    read_all("C:" DATA_FILE, 100);
+
+    /*Every block is read only once, in one go without seeking*/
+    uint32_t block_cnt = (DATA_FILE_SIZE + LV_FS_CACHED_BLOCK_SIZE - 1) / LV_FS_CACHED_BLOCK_SIZE;
+    lv_fs_cached_stats_t stats;
+    lv_fs_cached_get_stats(&stats);
+    TEST_ASSERT_EQUAL(block_cnt, stats.miss_cnt + stats.read_ahead_cnt);
+    TEST_ASSERT_EQUAL(block_cnt, stats.dev_read_cnt);
+    TEST_ASSERT_EQUAL(0, stats.dev_seek_cnt);
+    TEST_ASSERT_EQUAL(DATA_FILE_SIZE, stats.dev_read_bytes);
+    TEST_ASSERT_GREATER_THAN(block_cnt / 2, stats.read_ahead_cnt);
+    TEST_ASSERT_EQUAL(stats.read_cnt - 1, stats.seq_read_cnt);
+
+    /*Large aligned reads go directly to the destination*/
+    lv_fs_cached_invalidate(NULL);
+    lv_fs_cached_reset_stats();
+    lv_fs_file_t f;
+    uint8_t * buf = malloc(DATA_FILE_SIZE);
+    uint32_t br;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "C:" DATA_FILE, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, DATA_FILE_SIZE, &br));
+    TEST_ASSERT_EQUAL(DATA_FILE_SIZE, br);
+    TEST_ASSERT_EQUAL_MEMORY(ref, buf, DATA_FILE_SIZE);
+    lv_fs_close(&f);
+    free(buf);
+
+    lv_fs_cached_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.dev_read_cnt);   /*The whole blocks and the last partial block*/
+}
+
+void test_fs_cached_keep_blocks_after_close(void)
+{
+    read_all("C:src/test_fonts/font_1.fnt", 37);
+    lv_fs_cached_stats_t stats;
+    lv_fs_cached_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.dev_read_cnt);
+
+    lv_fs_cached_reset_stats();
+    read_all("C:src/test_fonts/font_1.fnt", 37);
+    lv_fs_cached_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.dev_read_cnt);
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.hit_cnt);
+
+    /*The least recently used blocks are reused for other files*/
+    read_all("C:" DATA_FILE, 100);
+    lv_fs_cached_reset_stats();
+    read_all("C:src/test_fonts/font_1.fnt", 37);
+    lv_fs_cached_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.dev_read_cnt);
+}
+
+void test_fs_cached_write(void)
+{
+    lv_fs_file_t fr;
+    lv_fs_file_t fw;
+    uint8_t buf[256];
+    uint32_t br;
+    uint32_t bw;
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&fr, "C:" DATA_FILE, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&fr, 8000, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&fr, buf, sizeof(buf), &br));
+
+    /*Overwrite a range crossing a block boundary while the reader has it in the cache*/
+    uint8_t data[300];
+    lv_memset(data, 0xa5, sizeof(data));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&fw, "C:" DATA_FILE, LV_FS_MODE_WR | LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&fw, 8100, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&fw, data, sizeof(data), &bw));
+    lv_memset(ref + 8100, 0xa5, sizeof(data));
+
+    /*Append to the end*/
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&fw, 0, LV_FS_SEEK_END));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&fw, data, 100, &bw));
+    lv_fs_close(&fw);
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&fr, 8000, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&fr, buf, sizeof(buf), &br));
+    TEST_ASSERT_EQUAL_MEMORY(ref + 8000, buf, sizeof(buf));
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&fr, DATA_FILE_SIZE - 50, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&fr, buf, sizeof(buf), &br));
+    TEST_ASSERT_EQUAL(150, br);
+    TEST_ASSERT_EQUAL_MEMORY(ref + DATA_FILE_SIZE - 50, buf, 50);
+    TEST_ASSERT_EQUAL_MEMORY(data, buf + 50, 100);
+    lv_fs_close(&fr);
+
+    /*Change the file bypassing the driver. The size is different so the blocks are dropped on the next open.*/
+    FILE * f = fopen(DATA_FILE, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    fwrite(ref + 1, 1, 5000, f);
+    fclose(f);
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&fr, "C:" DATA_FILE, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&fr, 4000, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&fr, buf, sizeof(buf), &br));
+    TEST_ASSERT_EQUAL(sizeof(buf), br);
+    TEST_ASSERT_EQUAL_MEMORY(ref + 4001, buf, sizeof(buf));
+    lv_fs_close(&fr);
+}
+
+static void load_fonts(char letter)
+{
+    const char * names[] = {"font_1.fnt", "font_2.fnt", "font_3.fnt"};
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        char path[64];
+        lv_snprintf(path, sizeof(path), "%c:src/test_fonts/%s", letter, names[i]);
+        lv_font_t * font = lv_font_load(path);
+        TEST_ASSERT_NOT_NULL(font);
+        lv_font_free(font);
+    }
+}
+
+static void decode_areas(char letter)
+{
+    const char * names[] = {"photo.sjpg", "photo.jpg"};
+    uint32_t i;
+    lv_color_t * buf = malloc(sizeof(lv_color_t) * 200 * 40);
+    for(i = 0; i < 2; i++) {
+        char path[64];
+        lv_snprintf(path, sizeof(path), "%c:src/test_files/%s", letter, names[i]);
+        lv_img_decoder_dsc_t dsc;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, path, lv_color_black(), 0));
+
+        /*Scroll a 200x40 window around the image*/
+        uint32_t seed = 1;
+        uint32_t j;
+        for(j = 0; j < 40; j++) {
+            lv_area_t a;
+            a.x1 = rnd_next(&seed) % (dsc.header.w - 200);
+            a.y1 = rnd_next(&seed) % (dsc.header.h - 40);
+            a.x2 = a.x1 + 199;
+            a.y2 = a.y1 + 39;
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_area(&dsc, &a, (uint8_t *)buf));
+        }
+        lv_img_decoder_close(&dsc);
+    }
+    free(buf);
+}
+
+static void benchmark(const char * name, void (*cb)(char letter))
+{
+    const uint32_t rep = 20;
+    lv_fs_cached_stats_t stats;
+    uint32_t i;
+
+    /*The posix driver has no cache so its reads and seeks are the same as the reads and seeks of the cached driver*/
+    uint64_t t = lv_test_get_time_us();
+    for(i = 0; i < rep; i++) cb('B');
+    double t_posix = (double)(lv_test_get_time_us() - t) / rep / 1000;
+
+    /*Start with an empty cache*/
+    lv_fs_cached_invalidate(NULL);
+    lv_fs_cached_reset_stats();
+    t = lv_test_get_time_us();
+    cb('C');
+    double t_cold = (double)(lv_test_get_time_us() - t) / 1000;
+    lv_fs_cached_get_stats(&stats);
+    printf("  %-14s posix: %6.2f ms, %5u reads, %5u seeks\n", name, t_posix, (unsigned)stats.read_cnt,
+           (unsigned)stats.seek_cnt);
+    printf("  %-14s cold:  %6.2f ms, %5u reads, %5u seeks, %5u kB read, %u%% hits, %u%% sequential, %u read ahead\n", "",
+           t_cold, (unsigned)stats.dev_read_cnt, (unsigned)stats.dev_seek_cnt, (unsigned)stats.dev_read_bytes / 1024,
+           (unsigned)(stats.hit_cnt * 100 / LV_MAX(stats.hit_cnt + stats.miss_cnt, 1)),
+           (unsigned)(stats.seq_read_cnt * 100 / LV_MAX(stats.read_cnt, 1)), (unsigned)stats.read_ahead_cnt);
+
+    lv_fs_cached_reset_stats();
+    t = lv_test_get_time_us();
+    for(i = 0; i < rep; i++) cb('C');
+    double t_warm = (double)(lv_test_get_time_us() - t) / rep / 1000;
+    lv_fs_cached_get_stats(&stats);
+    printf("  %-14s warm:  %6.2f ms, %5u reads, %5u seeks, %5u kB read, %u%% hits\n", "",
+           t_warm, (unsigned)(stats.dev_read_cnt / rep), (unsigned)(stats.dev_seek_cnt / rep),
+           (unsigned)(stats.dev_read_bytes / rep / 1024),
+           (unsigned)(stats.hit_cnt * 100 / LV_MAX(stats.hit_cnt + stats.miss_cnt, 1)));
+}
+
+void test_fs_cached_benchmark(void)
+{
+    printf("Device accesses of the posix driver and the block cached driver (%d kB cache, %d kB blocks):\n",
+           LV_FS_CACHED_SIZE / 1024, LV_FS_CACHED_BLOCK_SIZE / 1024);
+    benchmark("font loader", load_fonts);
+    benchmark("sjpg decoder", decode_areas);
+}
+
+#else /*LV_USE_FS_CACHED*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_fs_cached_random_access(void)
+{
+
+}
+
+void test_fs_cached_sequential_read_ahead(void)
+{
+
+}
+
+void test_fs_cached_keep_blocks_after_close(void)
+{
+
+}
+
+void test_fs_cached_write(void)
+{
+
+}
+
+void test_fs_cached_benchmark(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,517 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define GIF_FILE    "src/test_files/gif_test.gif"
+#define PX_SIZE     LV_IMG_PX_SIZE_ALPHA_BYTE
+
+typedef struct {
+    uint16_t x, y, w, h;
+    uint8_t disposal;
+    bool transparent;
+    uint8_t tindex;
+    bool lct;
+    bool interlace;
+    const uint8_t * px;     /*w * h color indices*/
+} frame_t;
+
+typedef struct {
+    uint8_t * data;
+    uint32_t size;
+    uint32_t cap;
+    /*LZW bit packer*/
+    uint32_t bits;
+    uint32_t bit_cnt;
+    uint8_t block[256];
+} gif_buf_t;
+
+static uint32_t rnd_seed;
+
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 16) & 0x7FFF;
+}
+
+static void put(gif_buf_t * b, const void * data, uint32_t n)
+{
+    if(b->size + n > b->cap) {
+        b->cap = (b->size + n) * 2;
+        b->data = realloc(b->data, b->cap);
+        TEST_ASSERT_NOT_NULL(b->data);
+    }
+    memcpy(b->data + b->size, data, n);
+    b->size += n;
+}
+
+static void put_u8(gif_buf_t * b, uint8_t v)
+{
+    put(b, &v, 1);
+}
+
+static void put_u16(gif_buf_t * b, uint16_t v)
+{
+    put_u8(b, v & 0xFF);
+    put_u8(b, v >> 8);
+}
+
+static void put_block_byte(gif_buf_t * b, uint8_t v)
+{
+    b->block[1 + b->block[0]++] = v;
+    if(b->block[0] == 255) {
+        put(b, b->block, 256);
+        b->block[0] = 0;
+    }
+}
+
+static void put_code(gif_buf_t * b, uint32_t code, uint32_t size)
+{
+    b->bits |= code << b->bit_cnt;
+    b->bit_cnt += size;
+    while(b->bit_cnt >= 8) {
+        put_block_byte(b, b->bits & 0xFF);
+        b->bits >>= 8;
+        b->bit_cnt -= 8;
+    }
+}
+
+/*The LZW encoder of lecram/gifenc with a child-sibling dictionary*/
+static void put_lzw(gif_buf_t * b, const uint8_t * px, uint32_t n, uint32_t depth)
+{
+    static uint16_t child[4096];
+    static uint16_t sibling[4096];
+    static uint8_t suffix[4096];
+
+    uint32_t min_size = depth < 2 ? 2 : depth;
+    uint32_t clear = 1 << min_size;
+    uint32_t key_size = min_size + 1;
+    uint32_t nkeys = clear + 2;
+    put_u8(b, min_size);
+    b->bits = 0;
+    b->bit_cnt = 0;
+    b->block[0] = 0;
+    memset(child, 0, sizeof(child));
+    put_code(b, clear, key_size);
+
+    uint32_t prefix = px[0];
+    uint32_t i;
+    for(i = 1; i < n; i++) {
+        uint8_t k = px[i];
+        uint32_t c = child[prefix];
+        while(c && suffix[c] != k) c = sibling[c];
+        if(c) {
+            prefix = c;
+            continue;
+        }
+        put_code(b, prefix, key_size);
+        if(nkeys < 0x1000) {
+            if(nkeys == (1u << key_size)) key_size++;
+            suffix[nkeys] = k;
+            child[nkeys] = 0;
+            sibling[nkeys] = child[prefix];
+            child[prefix] = nkeys;
+            nkeys++;
+        }
+        else {
+            put_code(b, clear, key_size);
+            memset(child, 0, sizeof(child));
+            key_size = min_size + 1;
+            nkeys = clear + 2;
+        }
+        prefix = k;
+    }
+    put_code(b, prefix, key_size);
+    put_code(b, clear + 1, key_size);
+    if(b->bit_cnt) put_code(b, 0, 8 - b->bit_cnt);
+    if(b->block[0]) put(b, b->block, b->block[0] + 1);
+    put_u8(b, 0);
+}
+
+static void palette_make(uint8_t * pal, uint32_t cnt, uint32_t seed)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        pal[i * 3 + 0] = (uint8_t)(i * 37 + seed);
+        pal[i * 3 + 1] = (uint8_t)(i * 91 + seed * 3);
+        pal[i * 3 + 2] = (uint8_t)(255 - i * 13);
+    }
+}
+
+/**
+ * Encode an animated GIF. The local color tables are `palette_make(.., 1 + frame index)`.
+ */
+static uint8_t * encode_gif(uint16_t w, uint16_t h, uint32_t depth, uint8_t bgindex,
+                            const frame_t * frames, uint32_t frame_cnt, uint32_t * size)
+{
+    gif_buf_t b;
+    memset(&b, 0, sizeof(b));
+    put(&b, "GIF89a", 6);
+    put_u16(&b, w);
+    put_u16(&b, h);
+    put_u8(&b, 0x80 | ((depth - 1) << 4) | (depth - 1));
+    put_u8(&b, bgindex);
+    put_u8(&b, 0);
+    uint8_t pal[256 * 3];
+    palette_make(pal, 1 << depth, 0);
+    put(&b, pal, 3 << depth);
+
+    uint32_t f;
+    for(f = 0; f < frame_cnt; f++) {
+        const frame_t * fr = &frames[f];
+        /*Graphic control extension*/
+        put_u8(&b, '!');
+        put_u8(&b, 0xF9);
+        put_u8(&b, 4);
+        put_u8(&b, (fr->disposal << 2) | (fr->transparent ? 1 : 0));
+        put_u16(&b, 2);
+        put_u8(&b, fr->tindex);
+        put_u8(&b, 0);
+        /*A comment to skip*/
+        if(f == 1) {
+            put(&b, "!\xFE\x05hello\x00", 9);
+        }
+
+        put_u8(&b, ',');
+        put_u16(&b, fr->x);
+        put_u16(&b, fr->y);
+        put_u16(&b, fr->w);
+        put_u16(&b, fr->h);
+        put_u8(&b, (fr->lct ? 0x80 | (depth - 1) : 0) | (fr->interlace ? 0x40 : 0));
+        if(fr->lct) {
+            palette_make(pal, 1 << depth, 1 + f);
+            put(&b, pal, 3 << depth);
+        }
+
+        /*Interlaced images store the rows in 4 passes*/
+        const uint8_t * px = fr->px;
+        uint8_t * tmp = NULL;
+        if(fr->interlace) {
+            tmp = malloc(fr->w * fr->h);
+            const uint8_t start[4] = {0, 4, 2, 1};
+            const uint8_t step[4] = {8, 8, 4, 2};
+            uint32_t pass, y, row = 0;
+            for(pass = 0; pass < 4; pass++) {
+                for(y = start[pass]; y < fr->h; y += step[pass]) {
+                    memcpy(tmp + row * fr->w, px + y * fr->w, fr->w);
+                    row++;
+                }
+            }
+            px = tmp;
+        }
+        put_lzw(&b, px, fr->w * fr->h, depth);
+        free(tmp);
+    }
+    put_u8(&b, ';');
+    *size = b.size;
+    return b.data;
+}
+
+static void px_set(uint8_t * p, const uint8_t * rgb, uint8_t opa)
+{
+    lv_color_t c = lv_color_make(rgb[0], rgb[1], rgb[2]);
+    memcpy(p, &c, PX_SIZE - 1);
+    p[PX_SIZE - 1] = opa;
+}
+
+/**
+ * The reference: compose the frames as the disposal methods describe
+ * and check the canvas and the changed area after each frame.
+ */
+static void check_frames(gd_GIF * gif, uint16_t w, uint16_t h, uint32_t depth, uint8_t bgindex,
+                         const frame_t * frames, uint32_t frame_cnt)
+{
+    uint8_t * canvas = malloc(w * h * PX_SIZE);
+    uint8_t * saved = malloc(w * h * PX_SIZE);
+    uint8_t gct[256 * 3];
+    uint8_t pal[256 * 3];
+    palette_make(gct, 1 << depth, 0);
+
+    uint32_t i;
+    for(i = 0; i < (uint32_t)w * h; i++) px_set(canvas + i * PX_SIZE, gct + bgindex * 3, 0xFF);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(canvas, gif->canvas, w * h * PX_SIZE);
+
+    uint32_t f;
+    for(f = 0; f < frame_cnt; f++) {
+        const frame_t * fr = &frames[f];
+        lv_area_t dirty = {0, 0, -1, -1};
+        int32_t x, y;
+
+        /*Dispose the previous frame*/
+        if(f > 0) {
+            const frame_t * prev = &frames[f - 1];
+            lv_area_t a = {prev->x, prev->y, LV_MIN(prev->x + prev->w, w) - 1, LV_MIN(prev->y + prev->h, h) - 1};
+            if(prev->disposal == 2) {
+                if(prev->lct) palette_make(pal, 1 << depth, f);
+                const uint8_t * p = prev->lct ? pal : gct;
+                for(y = a.y1; y <= a.y2; y++) {
+                    for(x = a.x1; x <= a.x2; x++) {
+                        px_set(canvas + (y * w + x) * PX_SIZE, p + bgindex * 3, prev->transparent ? 0x00 : 0xFF);
+                    }
+                }
+                dirty = a;
+            }
+            else if(prev->disposal == 3) {
+                memcpy(canvas, saved, w * h * PX_SIZE);
+                dirty = a;
+            }
+        }
+
+        if(fr->disposal == 3) memcpy(saved, canvas, w * h * PX_SIZE);
+
+        if(fr->lct) palette_make(pal, 1 << depth, 1 + f);
+        const uint8_t * p = fr->lct ? pal : gct;
+        for(y = 0; y < fr->h && fr->y + y < h; y++) {
+            for(x = 0; x < fr->w && fr->x + x < w; x++) {
+                uint8_t idx = fr->px[y * fr->w + x];
+                if(fr->transparent && idx == fr->tindex) continue;
+                px_set(canvas + ((fr->y + y) * w + fr->x + x) * PX_SIZE, p + idx * 3, 0xFF);
+            }
+        }
+        lv_area_t a = {fr->x, fr->y, LV_MIN(fr->x + fr->w, w) - 1, LV_MIN(fr->y + fr->h, h) - 1};
+        if(dirty.x2 < dirty.x1) dirty = a;
+        else _lv_area_join(&dirty, &dirty, &a);
+
+        TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(canvas, gif->canvas, w * h * PX_SIZE);
+        TEST_ASSERT_EQUAL(dirty.x1, gif->dirty.x);
+        TEST_ASSERT_EQUAL(dirty.y1, gif->dirty.y);
+        TEST_ASSERT_EQUAL(lv_area_get_width(&dirty), gif->dirty.w);
+        TEST_ASSERT_EQUAL(lv_area_get_height(&dirty), gif->dirty.h);
+    }
+
+    /*The end of the animation: nothing changes*/
+    TEST_ASSERT_EQUAL(0, gd_get_frame(gif));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(canvas, gif->canvas, w * h * PX_SIZE);
+    TEST_ASSERT_EQUAL(0, gif->dirty.w);
+
+    free(canvas);
+    free(saved);
+}
+
+/*Smooth areas with noise: long and short LZW strings*/
+static uint8_t * pixels_make(uint32_t w, uint32_t h, uint32_t depth)
+{
+    uint8_t * px = malloc(w * h);
+    uint32_t i;
+    for(i = 0; i < w * h; i++) {
+        uint32_t v = (i % w) / 3 + (i / w) / 5 + ((rnd() & 7) == 0 ? rnd() : 0);
+        px[i] = v & ((1 << depth) - 1);
+    }
+    return px;
+}
+
+/*All disposal methods, transparency, local color tables, interlacing and clipping*/
+static uint8_t * test_gif_make(uint32_t * size, frame_t * frames, uint32_t * frame_cnt)
+{
+    static const frame_t desc[] = {
+        {0, 0, 53, 37, 1, false, 0, false, false, NULL},
+        {5, 3, 20, 17, 2, true, 3, false, false, NULL},
+        {10, 8, 30, 21, 3, true, 5, true, true, NULL},
+        {0, 20, 53, 17, 0, false, 0, true, false, NULL},
+        {40, 30, 20, 10, 2, false, 0, false, true, NULL},     /*Partly out of the canvas*/
+        {1, 1, 1, 1, 1, true, 7, false, false, NULL},
+    };
+    uint32_t i;
+    *frame_cnt = sizeof(desc) / sizeof(desc[0]);
+    for(i = 0; i < *frame_cnt; i++) {
+        frames[i] = desc[i];
+        frames[i].px = pixels_make(desc[i].w, desc[i].h, 5);
+    }
+    return encode_gif(53, 37, 5, 2, frames, *frame_cnt, size);
+}
+
+void setUp(void)
+{
+    rnd_seed = 1234;
+}
+
+void tearDown(void)
+{
+    remove(GIF_FILE);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_gif_frames(void)
+{
+    frame_t frames[8];
+    uint32_t frame_cnt;
+    uint32_t size;
+    uint8_t * data = test_gif_make(&size, frames, &frame_cnt);
+
+    gd_GIF * gif = gd_open_gif_data(data);
+    TEST_ASSERT_NOT_NULL(gif);
+    check_frames(gif, 53, 37, 5, 2, frames, frame_cnt);
+
+    /*Again from the beginning: the last frame's disposal doesn't affect the first frame*/
+    gd_rewind(gif);
+    TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+    gd_close_gif(gif);
+
+    /*Different color depths and a large frame to fill the LZW table*/
+    uint32_t depth;
+    for(depth = 1; depth <= 8; depth++) {
+        frame_t fr = {0, 0, 150, 120, 1, false, 0, false, false, NULL};
+        fr.px = pixels_make(fr.w, fr.h, depth);
+        uint8_t * d = encode_gif(150, 120, depth, 0, &fr, 1, &size);
+        gif = gd_open_gif_data(d);
+        TEST_ASSERT_NOT_NULL(gif);
+        check_frames(gif, 150, 120, depth, 0, &fr, 1);
+        gd_close_gif(gif);
+        free((void *)fr.px);
+        free(d);
+    }
+
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) free((void *)frames[i].px);
+    free(data);
+}
+
+void test_gif_file(void)
+{
+    frame_t frames[8];
+    uint32_t frame_cnt;
+    uint32_t size;
+    uint8_t * data = test_gif_make(&size, frames, &frame_cnt);
+    FILE * f = fopen(GIF_FILE, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(size, fwrite(data, 1, size, f));
+    fclose(f);
+
+    gd_GIF * gif = gd_open_gif_file("A:" GIF_FILE);
+    TEST_ASSERT_NOT_NULL(gif);
+    check_frames(gif, 53, 37, 5, 2, frames, frame_cnt);
+    gd_close_gif(gif);
+
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) free((void *)frames[i].px);
+    free(data);
+}
+
+void test_gif_invalidate_changed_area(void)
+{
+    frame_t frames[8];
+    uint32_t frame_cnt;
+    uint32_t size;
+    uint8_t * data = test_gif_make(&size, frames, &frame_cnt);
+    lv_img_dsc_t src;
+    lv_memset_00(&src, sizeof(src));
+    src.data = data;
+    src.data_size = size;
+
+    lv_obj_t * obj = lv_gif_create(lv_scr_act());
+    lv_obj_set_pos(obj, 100, 50);
+    lv_gif_set_src(obj, &src);
+    lv_refr_now(NULL);
+
+    /*Run only the timer of the GIF and check what is invalidated*/
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_timer_pause(disp->refr_timer);
+    lv_tick_inc(100);
+    lv_timer_handler();
+    lv_timer_resume(disp->refr_timer);
+
+    /*Frame 1 is drawn: frame 0 is not disposed. (The invalidated areas are 5 px larger.)*/
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_EQUAL(100 + 5 - 5, disp->inv_areas[0].x1);
+    TEST_ASSERT_EQUAL(50 + 3 - 5, disp->inv_areas[0].y1);
+    TEST_ASSERT_EQUAL(100 + 5 + 20 - 1 + 5, disp->inv_areas[0].x2);
+    TEST_ASSERT_EQUAL(50 + 3 + 17 - 1 + 5, disp->inv_areas[0].y2);
+    lv_refr_now(NULL);
+
+    /*Zoomed: the whole widget is invalidated*/
+    lv_img_set_zoom(obj, 512);
+    lv_refr_now(NULL);
+    lv_timer_pause(disp->refr_timer);
+    lv_tick_inc(100);
+    lv_timer_handler();
+    lv_timer_resume(disp->refr_timer);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    lv_area_t a;
+    lv_obj_get_coords(obj, &a);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&a, &disp->inv_areas[0], 0));
+    lv_refr_now(NULL);
+
+    lv_obj_del(obj);
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) free((void *)frames[i].px);
+    free(data);
+}
+
+void test_gif_benchmark(void)
+{
+    /*A 320x240 background and a 48x48 sprite moving on it*/
+    const uint32_t sprite_cnt = 40;
+    frame_t * frames = malloc(sizeof(frame_t) * (sprite_cnt + 1));
+    frame_t bg = {0, 0, 320, 240, 1, false, 0, false, false, NULL};
+    bg.px = pixels_make(320, 240, 8);
+    frames[0] = bg;
+    uint8_t * sprite = pixels_make(48, 48, 8);
+    uint32_t i;
+    for(i = 0; i < 48 * 48; i++) {
+        int32_t dx = (int32_t)(i % 48) - 24;
+        int32_t dy = (int32_t)(i / 48) - 24;
+        if(dx * dx + dy * dy > 24 * 24) sprite[i] = 255;
+    }
+    for(i = 1; i <= sprite_cnt; i++) {
+        frame_t fr = {(uint16_t)(i * 6), (uint16_t)(100 + (i % 10) * 4), 48, 48, 1, true, 255, false, false, NULL};
+        fr.px = sprite;
+        frames[i] = fr;
+    }
+    uint32_t size;
+    uint8_t * data = encode_gif(320, 240, 8, 0, frames, sprite_cnt + 1, &size);
+    FILE * f = fopen(GIF_FILE, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(size, fwrite(data, 1, size, f));
+    fclose(f);
+
+    const char * names[] = {"C array", "file"};
+    uint32_t s;
+    for(s = 0; s < 2; s++) {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        uint32_t used_start = mon.total_size - mon.free_size;
+
+        gd_GIF * gif = s == 0 ? gd_open_gif_data(data) : gd_open_gif_file("A:" GIF_FILE);
+        TEST_ASSERT_NOT_NULL(gif);
+        lv_mem_monitor(&mon);
+        uint32_t used_open = mon.total_size - mon.free_size - used_start;
+
+        const uint32_t repeat = 5;
+        uint64_t t_full = 0;
+        uint64_t t_sprites = 0;
+        uint64_t dirty_px = 0;
+        uint32_t r;
+        for(r = 0; r < repeat; r++) {
+            gd_rewind(gif);
+            uint64_t t_start = lv_test_get_time_us();
+            TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+            t_full += lv_test_get_time_us() - t_start;
+
+            t_start = lv_test_get_time_us();
+            for(i = 1; i <= sprite_cnt; i++) {
+                TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+                dirty_px += gif->dirty.w * gif->dirty.h;
+            }
+            t_sprites += lv_test_get_time_us() - t_start;
+        }
+        gd_close_gif(gif);
+        dirty_px /= repeat;
+
+        printf("GIF 320x240 from %s (%u bytes), %u bytes while open:\n", names[s], (unsigned)size, (unsigned)used_open);
+        printf("  full frame: %6.3f ms\n", (double)t_full / repeat / 1000);
+        printf("  48x48 sprite frames: %6.3f ms / frame, changed area: %4.1f%% of the canvas\n",
+               (double)t_sprites / repeat / sprite_cnt / 1000, (double)dirty_px * 100 / sprite_cnt / (320 * 240));
+        TEST_ASSERT_LESS_THAN(320 * 240 / 10 * sprite_cnt, dirty_px);
+    }
+
+    free((void *)bg.px);
+    free(sprite);
+    free(frames);
+    free(data);
+}
+
+#endif
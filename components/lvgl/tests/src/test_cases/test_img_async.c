@@ -0,0 +1,406 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+#if LV_IMG_ASYNC
+
+#define IMG_SIZE    64
+#define ROW_TIME_US 250     /*Decoding a 64x64 image takes 16 ms*/
+#define SCR_W       800
+
+extern lv_color_t test_fb[];
+
+static lv_img_decoder_t * dec;
+static uint32_t open_cnt;
+static uint32_t close_cnt;
+static uint32_t row_cnt;
+static uint32_t tick_us;
+static lv_obj_t * ready_objs[8];
+static lv_res_t ready_res[8];
+static uint32_t ready_cnt;
+static uint32_t ready_open_cnt;     /*`open_cnt` when the last LV_EVENT_READY was sent*/
+
+static lv_color_t ph_map[4 * 4];
+static lv_img_dsc_t ph_dsc = {
+    .header.always_zero = 0,
+    .header.w = 4,
+    .header.h = 4,
+    .header.cf = LV_IMG_CF_TRUE_COLOR,
+    .data_size = sizeof(ph_map),
+    .data = (const uint8_t *)ph_map,
+};
+
+/*A decoder of fake ".slow" files which are green and decoded slowly line by line*/
+static lv_res_t slow_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+    if(strcmp(lv_fs_get_ext(src), "slow") != 0) return LV_RES_INV;
+
+    header->always_zero = 0;
+    header->cf = LV_IMG_CF_TRUE_COLOR;
+    header->w = IMG_SIZE;
+    header->h = IMG_SIZE;
+    return LV_RES_OK;
+}
+
+static lv_res_t slow_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    if(slow_info(decoder, dsc->src, &dsc->header) != LV_RES_OK) return LV_RES_INV;
+    dsc->img_data = NULL;
+    open_cnt++;
+    return LV_RES_OK;
+}
+
+static lv_res_t slow_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                               lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    LV_UNUSED(dsc);
+    LV_UNUSED(x);
+    LV_UNUSED(y);
+
+    uint64_t t_start = lv_test_get_time_us();
+    while(lv_test_get_time_us() - t_start < ROW_TIME_US);
+
+    /*The tick is not running in the tests, so advance it as a tick interrupt would*/
+    tick_us += ROW_TIME_US;
+    lv_tick_inc(tick_us / 1000);
+    tick_us %= 1000;
+
+    lv_color_t * px = (lv_color_t *)buf;
+    lv_coord_t i;
+    for(i = 0; i < len; i++) px[i] = lv_color_hex(0x00ff00);
+    row_cnt++;
+    return LV_RES_OK;
+}
+
+static void slow_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    LV_UNUSED(dsc);
+    close_cnt++;
+}
+
+static void ready_event_cb(lv_event_t * e)
+{
+    lv_res_t * res = lv_event_get_param(e);
+    if(ready_cnt < sizeof(ready_objs) / sizeof(ready_objs[0])) {
+        ready_objs[ready_cnt] = lv_event_get_target(e);
+        ready_res[ready_cnt] = *res;
+    }
+    ready_cnt++;
+    ready_open_cnt = open_cnt;
+}
+
+void setUp(void)
+{
+    dec = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(dec, slow_info);
+    lv_img_decoder_set_open_cb(dec, slow_open);
+    lv_img_decoder_set_read_line_cb(dec, slow_read_line);
+    lv_img_decoder_set_close_cb(dec, slow_close);
+
+    uint32_t i;
+    for(i = 0; i < 16; i++) ph_map[i] = lv_color_hex(0xff0000);
+
+    lv_img_cache_set_size(8);
+    lv_img_cache_set_mem_budget(0);
+    open_cnt = 0;
+    close_cnt = 0;
+    row_cnt = 0;
+    ready_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_cache_set_mem_budget(LV_IMG_CACHE_MEM_SIZE);
+    lv_img_decoder_delete(dec);
+}
+
+static lv_obj_t * async_img_create(const char * src, lv_coord_t x, lv_coord_t y)
+{
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_obj_set_pos(img, x, y);
+    lv_img_set_async(img, true);
+    lv_obj_add_event_cb(img, ready_event_cb, LV_EVENT_READY, NULL);
+    lv_img_set_src(img, src);
+    return img;
+}
+
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static uint32_t px_get(lv_coord_t x, lv_coord_t y)
+{
+    return lv_color_to32(test_fb[y * SCR_W + x]) & 0xffffff;
+}
+
+/**
+ * Run the timers until the image is decoded
+ * @param img       the image to wait for
+ * @param max_time  store the longest `lv_timer_handler` call here [us], only to print it. Can be `NULL`
+ * @return          the most rows decoded in one `lv_timer_handler` call
+ */
+static uint32_t run_until_ready(lv_obj_t * img, uint32_t * max_time)
+{
+    uint32_t max_rows = 0;
+    uint32_t step_cnt = 0;
+    if(max_time) *max_time = 0;
+    while(lv_img_is_pending(img)) {
+        TEST_ASSERT_LESS_THAN(10000, step_cnt);
+        step_cnt++;
+        uint32_t row_start = row_cnt;
+        uint64_t t = lv_test_get_time_us();
+        lv_timer_handler();
+        if(max_time) *max_time = LV_MAX(*max_time, (uint32_t)(lv_test_get_time_us() - t));
+        max_rows = LV_MAX(max_rows, row_cnt - row_start);
+    }
+    return max_rows;
+}
+
+void test_img_async_decode_in_the_background(void)
+{
+    lv_obj_t * img = async_img_create("A:a.slow", 10, 10);
+    TEST_ASSERT_TRUE(lv_img_get_async(img));
+    TEST_ASSERT_TRUE(lv_img_is_pending(img));
+    lv_obj_update_layout(img);
+    TEST_ASSERT_EQUAL(IMG_SIZE, lv_obj_get_width(img));
+
+    /*Nothing is decoded while drawing*/
+    refr_screen();
+    TEST_ASSERT_EQUAL(0, row_cnt);
+    TEST_ASSERT_EQUAL_HEX32(px_get(5, 5), px_get(10 + IMG_SIZE / 2, 10 + IMG_SIZE / 2));
+
+    /*Never blocked for the time of decoding the whole image*/
+    uint32_t max_rows = run_until_ready(img, NULL);
+    TEST_ASSERT_LESS_THAN(IMG_SIZE, max_rows);
+    TEST_ASSERT_EQUAL(IMG_SIZE, row_cnt);
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+    TEST_ASSERT_EQUAL_PTR(img, ready_objs[0]);
+    TEST_ASSERT_EQUAL(LV_RES_OK, ready_res[0]);
+
+    /*The line reading was closed and only the pixels are cached*/
+    TEST_ASSERT_EQUAL(1, open_cnt);
+    TEST_ASSERT_EQUAL(1, close_cnt);
+    _lv_img_cache_entry_t * entry = _lv_img_cache_find("A:a.slow", lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_NOT_NULL(entry->dec_dsc.img_data);
+
+    refr_screen();
+    TEST_ASSERT_EQUAL(1, open_cnt);
+    TEST_ASSERT_EQUAL_HEX32(0x00ff00, px_get(10 + IMG_SIZE / 2, 10 + IMG_SIZE / 2));
+
+    /*An other image with the same source is drawn from the cache right away*/
+    lv_obj_t * img2 = async_img_create("A:a.slow", 100, 10);
+    TEST_ASSERT_FALSE(lv_img_is_pending(img2));
+    refr_screen();
+    TEST_ASSERT_EQUAL_HEX32(0x00ff00, px_get(100 + IMG_SIZE / 2, 10 + IMG_SIZE / 2));
+    TEST_ASSERT_EQUAL(1, open_cnt);
+}
+
+void test_img_async_placeholder(void)
+{
+    lv_obj_t * img = async_img_create("A:a.slow", 10, 10);
+    lv_img_set_placeholder(img, &ph_dsc);
+
+    /*The placeholder is zoomed to the size of the image*/
+    refr_screen();
+    TEST_ASSERT_EQUAL_HEX32(0xff0000, px_get(10 + IMG_SIZE / 2, 10 + IMG_SIZE / 2));
+    TEST_ASSERT_UINT32_WITHIN(0x020000, 0xff0000, px_get(10 + IMG_SIZE / 4, 10 + IMG_SIZE * 3 / 4));
+
+    run_until_ready(img, NULL);
+    refr_screen();
+    TEST_ASSERT_EQUAL_HEX32(0x00ff00, px_get(10 + IMG_SIZE / 2, 10 + IMG_SIZE / 2));
+    TEST_ASSERT_EQUAL_HEX32(0x00ff00, px_get(10 + IMG_SIZE / 4, 10 + IMG_SIZE * 3 / 4));
+}
+
+void test_img_async_visible_images_first(void)
+{
+    lv_obj_t * img_hidden = async_img_create("A:hidden.slow", 10, 10);
+    lv_obj_add_flag(img_hidden, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_t * img_out = async_img_create("A:out.slow", 10, 1000);
+    lv_obj_t * img_visible = async_img_create("A:visible.slow", 10, 100);
+    lv_obj_update_layout(lv_scr_act());
+
+    run_until_ready(img_visible, NULL);
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+    TEST_ASSERT_EQUAL_PTR(img_visible, ready_objs[0]);
+
+    /*The hidden images are decoded later too*/
+    run_until_ready(img_hidden, NULL);
+    run_until_ready(img_out, NULL);
+    TEST_ASSERT_EQUAL(3, ready_cnt);
+    TEST_ASSERT_EQUAL(3, open_cnt);
+    TEST_ASSERT_EQUAL(3, close_cnt);
+}
+
+void test_img_async_cancel_on_delete(void)
+{
+    lv_obj_t * img1 = async_img_create("A:a.slow", 10, 10);
+    lv_obj_t * img2 = async_img_create("A:a.slow", 100, 10);
+    lv_obj_t * img3 = async_img_create("A:b.slow", 200, 10);
+
+    /*Decode a part of the images*/
+    while(row_cnt < IMG_SIZE / 2) lv_timer_handler();
+    TEST_ASSERT_EQUAL(1, open_cnt);
+
+    /*The decoding goes on for the remaining image*/
+    lv_obj_del(img1);
+    TEST_ASSERT_TRUE(lv_img_is_pending(img2));
+    TEST_ASSERT_EQUAL(0, close_cnt);
+
+    /*No one needs the image anymore*/
+    lv_obj_del(img2);
+    TEST_ASSERT_EQUAL(1, close_cnt);
+    TEST_ASSERT_NULL(_lv_img_cache_find("A:a.slow", lv_color_black(), 0));
+
+    run_until_ready(img3, NULL);
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+    TEST_ASSERT_EQUAL_PTR(img3, ready_objs[0]);
+    TEST_ASSERT_EQUAL(2, open_cnt);
+    TEST_ASSERT_EQUAL(2, close_cnt);
+
+    /*Changing the source cancels the old request*/
+    uint32_t row_start = row_cnt;
+    lv_img_set_src(img3, "A:c.slow");
+    while(row_cnt < row_start + IMG_SIZE / 2) lv_timer_handler();
+    lv_img_set_src(img3, "A:d.slow");
+    run_until_ready(img3, NULL);
+    TEST_ASSERT_EQUAL(4, open_cnt);
+    TEST_ASSERT_EQUAL(4, close_cnt);
+    TEST_ASSERT_NULL(_lv_img_cache_find("A:c.slow", lv_color_black(), 0));
+    TEST_ASSERT_NOT_NULL(_lv_img_cache_find("A:d.slow", lv_color_black(), 0));
+}
+
+void test_img_async_draw_directly_if_not_cached(void)
+{
+    /*The decoded image doesn't fit into the cache, so it's not decoded in the background*/
+    lv_img_cache_set_mem_budget(1024);
+    lv_obj_t * img = async_img_create("A:a.slow", 10, 10);
+    TEST_ASSERT_FALSE(lv_img_is_pending(img));
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(0, open_cnt);
+    TEST_ASSERT_EQUAL(0, ready_cnt);
+
+    refr_screen();
+    TEST_ASSERT_EQUAL_HEX32(0x00ff00, px_get(10 + IMG_SIZE / 2, 10 + IMG_SIZE / 2));
+    TEST_ASSERT_FALSE(lv_img_is_pending(img));
+
+    /*The budget is lowered after the request: it's not opened either*/
+    lv_img_cache_set_mem_budget(0);
+    lv_obj_t * img2 = async_img_create("A:c.slow", 100, 10);
+    TEST_ASSERT_TRUE(lv_img_is_pending(img2));
+    lv_img_cache_set_mem_budget(1024);
+    open_cnt = 0;
+    run_until_ready(img2, NULL);
+    TEST_ASSERT_EQUAL(1, ready_cnt);
+    TEST_ASSERT_EQUAL(0, ready_open_cnt);
+    TEST_ASSERT_EQUAL(LV_RES_INV, ready_res[0]);
+
+    /*Images which are not async are drawn directly*/
+    lv_img_set_async(img, false);
+    lv_img_set_src(img, "A:b.slow");
+    TEST_ASSERT_FALSE(lv_img_is_pending(img));
+    refr_screen();
+    TEST_ASSERT_EQUAL_HEX32(0x00ff00, px_get(10 + IMG_SIZE / 2, 10 + IMG_SIZE / 2));
+}
+
+/*Open a screen of slow images and measure the longest stall of the UI*/
+void test_img_async_benchmark_stall(void)
+{
+    const uint32_t img_cnt = 8;
+    lv_img_cache_set_size(16);
+
+    printf("%u images of %dx%d px decoded in %u ms each:\n", (unsigned)img_cnt, IMG_SIZE, IMG_SIZE,
+           (unsigned)(IMG_SIZE * ROW_TIME_US / 1000));
+
+    uint32_t a;
+    for(a = 0; a < 2; a++) {
+        lv_img_cache_set_size(16);
+        lv_obj_clean(lv_scr_act());
+        uint32_t i;
+        lv_obj_t * last = NULL;
+        for(i = 0; i < img_cnt; i++) {
+            char path[16];
+            lv_snprintf(path, sizeof(path), "A:%d.slow", (int)i);
+            last = lv_img_create(lv_scr_act());
+            lv_obj_set_pos(last, (i % 8) * (IMG_SIZE + 4), (i / 8) * (IMG_SIZE + 4));
+            lv_img_set_async(last, a == 1);
+            lv_img_set_src(last, path);
+        }
+
+        uint64_t t_start = lv_test_get_time_us();
+        uint32_t row_start = row_cnt;
+        refr_screen();
+        uint32_t max_time = (uint32_t)(lv_test_get_time_us() - t_start);
+        uint32_t max_rows = row_cnt - row_start;
+        uint32_t max_time_run;
+        uint32_t max_rows_run = run_until_ready(last, &max_time_run);
+        max_time = LV_MAX(max_time, max_time_run);
+        max_rows = LV_MAX(max_rows, max_rows_run);
+        uint32_t total = (uint32_t)(lv_test_get_time_us() - t_start);
+
+        printf("  %-6s longest stall: %6.2f ms (%3u rows), all images shown after %6.2f ms\n", a ? "async" : "sync",
+               (double)max_time / 1000, (unsigned)max_rows, (double)total / 1000);
+
+        /*Never blocked for the time of decoding an image. The rows are counted instead of
+         *measuring the time which depends on the load of the machine*/
+        if(a) TEST_ASSERT_LESS_THAN(IMG_SIZE, max_rows);
+        else TEST_ASSERT_GREATER_OR_EQUAL(IMG_SIZE, max_rows);
+    }
+}
+
+#else /*LV_IMG_ASYNC*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_img_async_decode_in_the_background(void)
+{
+
+}
+
+void test_img_async_placeholder(void)
+{
+
+}
+
+void test_img_async_visible_images_first(void)
+{
+
+}
+
+void test_img_async_cancel_on_delete(void)
+{
+
+}
+
+void test_img_async_draw_directly_if_not_cached(void)
+{
+
+}
+
+void test_img_async_benchmark_stall(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,485 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+#define ICON_SIZE   32
+#define MID_SIZE    64
+#define BIG_SIZE    128
+#define STREAM_MEM_SIZE 1000    /*Buffers of the decoder for "A:str..." images*/
+
+static lv_img_decoder_t * dec;
+static uint32_t open_cnt;
+static uint32_t close_cnt;
+static uint32_t time_to_open;   /*Report this time to open if not 0*/
+static uint32_t decode_rounds;  /*Make decoding slower*/
+
+/*A decoder of fake ".icn" files which are not read. "A:mid..." and "A:big..." images are larger.
+ *"A:str..." images are read line by line from an open file.*/
+static lv_res_t icn_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+    if(strcmp(lv_fs_get_ext(src), "icn") != 0) return LV_RES_INV;
+
+    header->always_zero = 0;
+    header->cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    if(strncmp(src, "A:big", 5) == 0) header->w = BIG_SIZE;
+    else if(strncmp(src, "A:mid", 5) == 0) header->w = MID_SIZE;
+    else header->w = ICON_SIZE;
+    header->h = header->w;
+    return LV_RES_OK;
+}
+
+static lv_res_t icn_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    if(icn_info(decoder, dsc->src, &dsc->header) != LV_RES_OK) return LV_RES_INV;
+
+    if(strncmp(dsc->src, "A:str", 5) == 0) {
+        dsc->mem_size = STREAM_MEM_SIZE;
+        dsc->file_open = 1;
+        dsc->time_to_open = time_to_open;
+        open_cnt++;
+        return LV_RES_OK;
+    }
+
+    uint32_t size = lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+    uint8_t * buf = lv_img_cache_mem_alloc(size);
+    TEST_ASSERT_NOT_NULL(buf);
+
+    uint32_t seed = 0;
+    const char * p;
+    for(p = dsc->src; *p; p++) seed = seed * 31 + *p;
+
+    uint32_t r;
+    uint32_t i;
+    for(r = 0; r <= decode_rounds; r++) {
+        for(i = 0; i < size; i++) {
+            seed = seed * 1103515245 + 12345;
+            buf[i] = (uint8_t)(seed >> 16);
+        }
+    }
+
+    dsc->img_data = buf;
+    dsc->time_to_open = time_to_open;
+    open_cnt++;
+    return LV_RES_OK;
+}
+
+static void icn_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    lv_img_cache_mem_free((void *)dsc->img_data);
+    dsc->img_data = NULL;
+    close_cnt++;
+}
+
+void setUp(void)
+{
+    dec = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(dec, icn_info);
+    lv_img_decoder_set_open_cb(dec, icn_open);
+    lv_img_decoder_set_close_cb(dec, icn_close);
+
+    lv_img_cache_set_size(8);
+    lv_img_cache_set_mem_budget(0);
+    lv_img_cache_set_file_max(0);
+    lv_img_cache_reset_stats();
+    _lv_img_cache_next_frame();
+    open_cnt = 0;
+    close_cnt = 0;
+    time_to_open = 10;
+    decode_rounds = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_cache_set_mem_budget(LV_IMG_CACHE_MEM_SIZE);
+    lv_img_cache_set_file_max(LV_IMG_CACHE_FILE_MAX);
+    lv_img_decoder_delete(dec);
+}
+
+static uint32_t icon_size(void)
+{
+    return lv_img_buf_get_img_size(ICON_SIZE, ICON_SIZE, LV_IMG_CF_TRUE_COLOR_ALPHA);
+}
+
+/*Open and release an image in a new refresh*/
+static _lv_img_cache_entry_t * open_in_new_frame(const char * src)
+{
+    _lv_img_cache_next_frame();
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open(src, lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(entry);
+    _lv_img_cache_release(entry);
+    return entry;
+}
+
+static bool is_cached(const char * src)
+{
+    lv_img_cache_stats_t stats_ori;
+    lv_img_cache_get_stats(&stats_ori);
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open(src, lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(entry);
+    _lv_img_cache_release(entry);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    return stats.hit_cnt > stats_ori.hit_cnt;
+}
+
+void test_img_cache_hit_and_miss(void)
+{
+    _lv_img_cache_entry_t * entry = open_in_new_frame("A:a.icn");
+    TEST_ASSERT_TRUE(entry->cached);
+    TEST_ASSERT_EQUAL(icon_size(), entry->size);
+
+    /*An other path with the same content and an other color is a different image*/
+    char path[16];
+    strcpy(path, "A:a.icn");
+    TEST_ASSERT_EQUAL_PTR(entry, open_in_new_frame(path));
+    _lv_img_cache_entry_t * entry_red = _lv_img_cache_open(path, lv_palette_main(LV_PALETTE_RED), 0);
+    TEST_ASSERT_NOT_EQUAL(entry, entry_red);
+    _lv_img_cache_release(entry_red);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(2, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(2, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(8, stats.entry_max);
+    TEST_ASSERT_EQUAL(2 * icon_size(), stats.mem_used);
+    TEST_ASSERT_EQUAL(2, open_cnt);
+
+    /*Not existing images are not cached*/
+    TEST_ASSERT_NULL(_lv_img_cache_open("A:a.xyz", lv_color_black(), 0));
+}
+
+void test_img_cache_entry_limit(void)
+{
+    lv_img_cache_set_size(4);
+    char path[16];
+    uint32_t i;
+    for(i = 0; i < 6; i++) {
+        lv_snprintf(path, sizeof(path), "A:%d.icn", (int)i);
+        open_in_new_frame(path);
+    }
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(4, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(2, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(2, close_cnt);
+    TEST_ASSERT_EQUAL(4 * icon_size(), stats.mem_used);
+
+    /*The oldest ones were closed*/
+    TEST_ASSERT_FALSE(is_cached("A:0.icn"));
+    TEST_ASSERT_TRUE(is_cached("A:5.icn"));
+}
+
+void test_img_cache_slow_and_small_images_live_longer(void)
+{
+    lv_img_cache_set_mem_budget(3 * icon_size());
+
+    time_to_open = 50;
+    open_in_new_frame("A:slow.icn");
+    time_to_open = 1;
+    open_in_new_frame("A:fast1.icn");
+    open_in_new_frame("A:fast2.icn");
+    open_in_new_frame("A:fast3.icn");
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.evict_cnt);
+
+    /*Check the cached ones first as checking an image opens it*/
+    TEST_ASSERT_TRUE(is_cached("A:slow.icn"));
+    TEST_ASSERT_FALSE(is_cached("A:fast1.icn"));
+
+    /*A large image is less valuable than a small one with the same time to open*/
+    lv_img_cache_set_mem_budget(icon_size() + lv_img_buf_get_img_size(BIG_SIZE, BIG_SIZE, LV_IMG_CF_TRUE_COLOR_ALPHA));
+    time_to_open = 50;
+    open_in_new_frame("A:big.icn");
+    open_in_new_frame("A:small.icn");
+    open_in_new_frame("A:small2.icn");
+    TEST_ASSERT_TRUE(is_cached("A:small.icn"));
+    TEST_ASSERT_FALSE(is_cached("A:big.icn"));
+}
+
+void test_img_cache_too_large_image_is_not_cached(void)
+{
+    lv_img_cache_set_mem_budget(2 * icon_size());
+    _lv_img_cache_next_frame();
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open("A:big.icn", lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_FALSE(entry->cached);
+    TEST_ASSERT_NOT_NULL(entry->dec_dsc.img_data);
+    _lv_img_cache_release(entry);
+    TEST_ASSERT_EQUAL(1, close_cnt);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.uncached_cnt);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_used);
+}
+
+void test_img_cache_open_files(void)
+{
+    /*The buffers of the decoder are counted in the budget*/
+    _lv_img_cache_entry_t * entry = open_in_new_frame("A:str1.icn");
+    TEST_ASSERT_TRUE(entry->cached);
+    TEST_ASSERT_EQUAL(STREAM_MEM_SIZE, entry->size);
+
+    /*Another open file closes an open file, but not a decoded image*/
+    lv_img_cache_set_file_max(2);
+    open_in_new_frame("A:a.icn");
+    open_in_new_frame("A:str2.icn");
+    open_in_new_frame("A:str3.icn");
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(3, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(2, stats.file_cnt);
+    TEST_ASSERT_EQUAL(1, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(icon_size() + 2 * STREAM_MEM_SIZE, stats.mem_used);
+    TEST_ASSERT_TRUE(is_cached("A:a.icn"));
+    TEST_ASSERT_TRUE(is_cached("A:str3.icn"));
+
+    /*The open files of the current refresh are kept and the new one is not cached*/
+    _lv_img_cache_next_frame();
+    const char * srcs[] = {"A:str4.icn", "A:str5.icn", "A:str6.icn"};
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        entry = _lv_img_cache_open(srcs[i], lv_color_black(), 0);
+        TEST_ASSERT_EQUAL(i < 2, entry->cached);
+        _lv_img_cache_release(entry);
+    }
+
+    /*Lowering the limit closes the open files right away*/
+    _lv_img_cache_next_frame();
+    lv_img_cache_set_file_max(1);
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.file_cnt);
+    TEST_ASSERT_EQUAL(4, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(1, stats.uncached_cnt);
+}
+
+void test_img_cache_images_of_the_same_refresh_are_kept(void)
+{
+    lv_img_cache_set_mem_budget(2 * icon_size());
+
+    /*The 3rd image of a refresh doesn't close the first two*/
+    _lv_img_cache_next_frame();
+    const char * srcs[] = {"A:1.icn", "A:2.icn", "A:3.icn"};
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        _lv_img_cache_entry_t * entry = _lv_img_cache_open(srcs[i], lv_color_black(), 0);
+        TEST_ASSERT_EQUAL(i < 2, entry->cached);
+        _lv_img_cache_release(entry);
+    }
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(1, stats.uncached_cnt);
+
+    /*In the next refresh it can close an old image*/
+    TEST_ASSERT_TRUE(open_in_new_frame("A:3.icn")->cached);
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.evict_cnt);
+}
+
+void test_img_cache_pin(void)
+{
+    lv_img_cache_set_size(2);
+
+    /*Pin before opening. The path is copied.*/
+    char path[16];
+    strcpy(path, "A:pinned.icn");
+    lv_img_cache_pin(path);
+    lv_img_cache_pin(path);
+    strcpy(path, "A:other.icn");
+
+    open_in_new_frame("A:pinned.icn");
+    open_in_new_frame("A:1.icn");
+    open_in_new_frame("A:2.icn");
+    open_in_new_frame("A:3.icn");
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.pinned_cnt);
+    TEST_ASSERT_TRUE(is_cached("A:pinned.icn"));
+
+    /*If everything is pinned the new images are not cached*/
+    lv_img_cache_pin("A:3.icn");
+    _lv_img_cache_next_frame();
+    TEST_ASSERT_FALSE(is_cached("A:4.icn"));
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.uncached_cnt);
+
+    /*The pins are counted*/
+    lv_img_cache_unpin("A:pinned.icn");
+    open_in_new_frame("A:5.icn");
+    TEST_ASSERT_TRUE(is_cached("A:pinned.icn"));
+    lv_img_cache_unpin("A:pinned.icn");
+    open_in_new_frame("A:6.icn");
+    _lv_img_cache_next_frame();
+    TEST_ASSERT_FALSE(is_cached("A:pinned.icn"));
+
+    lv_img_cache_unpin("A:3.icn");
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.pinned_cnt);
+}
+
+void test_img_cache_invalidate_path(void)
+{
+    lv_img_cache_set_size(32);
+    _lv_img_cache_next_frame();
+    _lv_img_cache_release(_lv_img_cache_open("A:a.icn", lv_color_black(), 0));
+    _lv_img_cache_release(_lv_img_cache_open("A:a.icn", lv_color_black(), 1));
+    _lv_img_cache_release(_lv_img_cache_open("A:b.icn", lv_color_black(), 0));
+
+    char path[16];
+    strcpy(path, "A:a.icn");
+    lv_img_cache_invalidate_src(path);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(2, close_cnt);
+    TEST_ASSERT_TRUE(is_cached("A:b.icn"));
+    TEST_ASSERT_FALSE(is_cached("A:a.icn"));
+
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_used);
+}
+
+/*Compare the cache with a simple model while adding and invalidating many images*/
+void test_img_cache_random_operations(void)
+{
+    lv_img_cache_set_size(64);
+    bool model[200];
+    lv_memset_00(model, sizeof(model));
+
+    uint32_t seed = 1;
+    uint32_t i;
+    for(i = 0; i < 3000; i++) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t id = (seed >> 8) % 200;
+        char path[16];
+        lv_snprintf(path, sizeof(path), "A:%d.icn", (int)id);
+
+        if((seed >> 20) % 4 == 0) {
+            lv_img_cache_invalidate_src(path);
+            model[id] = false;
+        }
+        else {
+            _lv_img_cache_next_frame();
+            TEST_ASSERT_EQUAL(model[id], is_cached(path));
+            model[id] = true;
+        }
+
+        /*Keep the model in the size of the cache*/
+        lv_img_cache_stats_t stats;
+        lv_img_cache_get_stats(&stats);
+        if(stats.evict_cnt) {
+            lv_img_cache_invalidate_src(NULL);
+            lv_memset_00(model, sizeof(model));
+            lv_img_cache_reset_stats();
+        }
+    }
+}
+
+void test_img_cache_draw(void)
+{
+    lv_img_cache_set_size(32);
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_obj_t * img = lv_img_create(lv_scr_act());
+        char path[16];
+        lv_snprintf(path, sizeof(path), "A:%d.icn", (int)i);
+        lv_img_set_src(img, path);
+        lv_obj_set_pos(img, i * 40, 10);
+    }
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(10, open_cnt);
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(10, open_cnt);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(10, stats.entry_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(10, stats.hit_cnt);
+}
+
+/*Redraw a home screen with a grid of icons with different cache settings*/
+void test_img_cache_benchmark_icon_grid(void)
+{
+    const uint32_t col_cnt = 8;
+    const uint32_t row_cnt = 4;
+    const uint32_t frame_cnt = 20;
+    decode_rounds = 8;
+    time_to_open = 0;   /*Measure it*/
+
+    lv_obj_t * grid = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(grid, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(grid, LV_FLEX_FLOW_ROW_WRAP);
+    uint32_t i;
+    for(i = 0; i < col_cnt * row_cnt; i++) {
+        lv_obj_t * img = lv_img_create(grid);
+        char path[16];
+        lv_snprintf(path, sizeof(path), "A:mid%d.icn", (int)i);
+        lv_img_set_src(img, path);
+    }
+
+    struct {
+        const char * name;
+        uint16_t entry_cnt;
+        uint32_t budget;
+    } configs[] = {
+        {"no cache", 0, 0},
+        {"all icons fit", 64, 0},
+        {"half of the icons fit", 64, col_cnt * row_cnt / 2 * lv_img_buf_get_img_size(MID_SIZE, MID_SIZE, LV_IMG_CF_TRUE_COLOR_ALPHA)},
+    };
+
+    printf("%u icons of %dx%d px, %u full screen refreshes:\n", (unsigned)(col_cnt * row_cnt), MID_SIZE, MID_SIZE,
+           (unsigned)frame_cnt);
+    uint32_t c;
+    for(c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        lv_img_cache_set_size(configs[c].entry_cnt);
+        lv_img_cache_set_mem_budget(configs[c].budget);
+        lv_img_cache_reset_stats();
+        open_cnt = 0;
+
+        uint64_t t_start = lv_test_get_time_us();
+        for(i = 0; i < frame_cnt; i++) {
+            lv_obj_invalidate(lv_scr_act());
+            lv_refr_now(NULL);
+        }
+        uint64_t t = lv_test_get_time_us() - t_start;
+
+        lv_img_cache_stats_t stats;
+        lv_img_cache_get_stats(&stats);
+        printf("  %-22s %7.2f ms/frame, decoded: %4u, hit: %4u, miss: %4u, evict: %4u, uncached: %4u, %u kB\n",
+               configs[c].name, (double)t / frame_cnt / 1000, (unsigned)open_cnt, (unsigned)stats.hit_cnt,
+               (unsigned)stats.miss_cnt, (unsigned)stats.evict_cnt, (unsigned)stats.uncached_cnt,
+               (unsigned)(stats.mem_used / 1024));
+    }
+
+    /*Half of the icons stay in the cache, the others are decoded in every refresh*/
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(col_cnt * row_cnt / 2, stats.entry_cnt);
+}
+
+#endif
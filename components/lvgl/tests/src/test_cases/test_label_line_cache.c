@@ -0,0 +1,334 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+#define HOR_RES 800
+#define VER_RES 480
+#define TXT_SIZE (32 * 1024)
+
+extern lv_color_t test_fb[];
+
+static lv_obj_t * cont;
+static lv_obj_t * label;
+static lv_obj_t * ref;
+static char * txt;
+static lv_draw_label_dsc_t ref_dsc;
+static lv_draw_label_hint_t ref_hint;
+static bool ref_use_hint;
+
+/*Draw the label's text directly, without the cached lines*/
+static void ref_event_cb(lv_event_t * e)
+{
+    if(lv_event_get_code(e) == LV_EVENT_REFR_EXT_DRAW_SIZE) {
+        lv_event_set_ext_draw_size(e, _lv_obj_get_ext_draw_size(label));
+        return;
+    }
+
+    lv_area_t coords;
+    lv_obj_get_content_coords(label, &coords);
+    coords.y2 = label->coords.y2;
+    lv_draw_label(lv_event_get_draw_ctx(e), &ref_dsc, &coords, lv_label_get_text(label),
+                  ref_use_hint ? &ref_hint : NULL);
+}
+
+/*Make the reference draw like the label*/
+static void ref_update(void)
+{
+    lv_obj_update_layout(cont);
+    lv_obj_set_size(ref, lv_obj_get_width(label), lv_obj_get_height(label));
+    lv_obj_refresh_ext_draw_size(ref);
+
+    lv_draw_label_dsc_init(&ref_dsc);
+    lv_obj_init_draw_label_dsc(label, LV_PART_MAIN, &ref_dsc);
+    if(lv_label_get_recolor(label)) ref_dsc.flag |= LV_TEXT_FLAG_RECOLOR;
+}
+
+static uint32_t render_hash(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    uint32_t hash = 2166136261u;
+    const uint8_t * p = (const uint8_t *)test_fb;
+    uint32_t i;
+    for(i = 0; i < HOR_RES * VER_RES * sizeof(lv_color_t); i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/*Render the label and the reference and compare them*/
+static void check_draw(void)
+{
+    ref_update();
+
+    lv_obj_set_style_text_opa(label, LV_OPA_COVER, 0);
+    lv_obj_add_flag(ref, LV_OBJ_FLAG_HIDDEN);
+    uint32_t label_hash = render_hash();
+
+    lv_obj_set_style_text_opa(label, LV_OPA_TRANSP, 0);
+    lv_obj_clear_flag(ref, LV_OBJ_FLAG_HIDDEN);
+    uint32_t ref_hash = render_hash();
+
+    lv_obj_set_style_text_opa(label, LV_OPA_COVER, 0);
+    lv_obj_add_flag(ref, LV_OBJ_FLAG_HIDDEN);
+
+    TEST_ASSERT_EQUAL_HEX32(ref_hash, label_hash);
+}
+
+/*Check the size and the letter positions with the text wrapped again*/
+static void check_layout(void)
+{
+    lv_obj_update_layout(cont);
+
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(label, LV_PART_MAIN);
+    lv_coord_t line_space = lv_obj_get_style_text_line_space(label, LV_PART_MAIN);
+    lv_coord_t line_height = lv_font_get_line_height(font) + line_space;
+    lv_coord_t max_w = lv_obj_get_content_width(label);
+    lv_text_flag_t flag = lv_label_get_recolor(label) ? LV_TEXT_FLAG_RECOLOR : LV_TEXT_FLAG_NONE;
+    const char * label_txt = lv_label_get_text(label);
+
+    lv_point_t size;
+    lv_txt_get_size(&size, label_txt, font, letter_space, line_space, max_w, flag);
+    TEST_ASSERT_EQUAL(size.y, lv_obj_get_content_height(label));
+
+    uint32_t line_start = 0;
+    uint32_t char_id = 0;
+    lv_coord_t y = 0;
+    bool in_cmd = false;
+    while(label_txt[line_start] != '\0') {
+        uint32_t line_end = line_start + _lv_txt_get_next_line(&label_txt[line_start], font, letter_space, max_w, NULL,
+                                                               flag);
+        /*Finding the letters doesn't skip the recolor commands exactly, so check it only on the other lines*/
+        bool has_cmd = memchr(&label_txt[line_start], '#', line_end - line_start) != NULL;
+        uint32_t i = line_start;
+        while(i < line_end) {
+            uint32_t letter = _lv_txt_encoded_next(label_txt, &i);
+            /*Check some letters on the line, but not the recolor commands*/
+            if(letter == '#') in_cmd = !in_cmd;
+            else if((char_id % 13) == 0 && letter > ' ' && !in_cmd) {
+                lv_point_t pos;
+                lv_label_get_letter_pos(label, char_id, &pos);
+                TEST_ASSERT_EQUAL(y, pos.y);
+                if(has_cmd) {
+                    char_id++;
+                    continue;
+                }
+
+                pos.x += lv_obj_get_style_pad_left(label, LV_PART_MAIN) + 1;
+                pos.y += lv_obj_get_style_pad_top(label, LV_PART_MAIN) + 1;
+                TEST_ASSERT_EQUAL(char_id, lv_label_get_letter_on(label, &pos));
+                TEST_ASSERT_TRUE(lv_label_is_char_under_pos(label, &pos));
+            }
+            char_id++;
+        }
+        line_start = line_end;
+        y += line_height;
+    }
+
+    /*Below the text*/
+    lv_point_t pos = {0, lv_obj_get_height(label) + 100};
+    TEST_ASSERT_EQUAL(char_id, lv_label_get_letter_on(label, &pos));
+}
+
+static void check_scrolled(void)
+{
+    lv_coord_t scroll_ends[] = {0, 333, 2000, 7777, LV_COORD_MAX};
+    uint32_t i;
+    for(i = 0; i < sizeof(scroll_ends) / sizeof(scroll_ends[0]); i++) {
+        lv_coord_t y = LV_MIN(scroll_ends[i], lv_obj_get_scroll_bottom(cont) + lv_obj_get_scroll_y(cont));
+        lv_obj_scroll_to_y(cont, y, LV_ANIM_OFF);
+        check_draw();
+    }
+}
+
+void setUp(void)
+{
+    /*A long text with paragraphs, recolored words and a long word which needs to be broken*/
+    static const char * words[] = {"Lorem", "ipsum", "dolor", "sit", "amet,", "consectetur", "adipiscing", "elit",
+                                   "#ff0000 sed#", "do", "eiusmod", "tempor", "incididunt", "ut", "labore", "et"
+                                  };
+    txt = lv_mem_alloc(TXT_SIZE + 1);
+    uint32_t len = 0;
+    uint32_t i = 0;
+    while(true) {
+        const char * w = words[(i * 7) % (sizeof(words) / sizeof(words[0]))];
+        if(i == 100) w = "Averyveryveryveryveryveryveryveryveryveryveryveryveryveryveryverylongword";
+        if(len + strlen(w) + 1 > TXT_SIZE) break;
+        lv_memcpy(&txt[len], w, strlen(w));
+        len += strlen(w);
+        txt[len] = (i % 37) == 36 ? '\n' : ' ';
+        len++;
+        i++;
+    }
+    txt[len] = '\0';
+
+    cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 400, 440);
+
+    label = lv_label_create(cont);
+    lv_obj_set_width(label, 300);
+    lv_label_set_text(label, txt);
+    lv_label_set_recolor(label, true);
+
+    ref = lv_obj_create(cont);
+    lv_obj_remove_style_all(ref);
+    lv_obj_add_flag(ref, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(ref, ref_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(ref, ref_event_cb, LV_EVENT_REFR_EXT_DRAW_SIZE, NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_mem_free(txt);
+}
+
+void test_label_line_cache_draw(void)
+{
+    check_scrolled();
+
+    /*The cached widths of the lines are used for aligning*/
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    check_scrolled();
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_RIGHT, 0);
+    check_scrolled();
+
+    lv_obj_set_style_text_letter_space(label, 3, 0);
+    lv_obj_set_style_text_line_space(label, -4, 0);
+    check_scrolled();
+}
+
+void test_label_line_cache_layout(void)
+{
+    check_layout();
+
+    lv_obj_set_style_text_letter_space(label, 2, 0);
+    lv_obj_set_style_text_line_space(label, 5, 0);
+#if LV_FONT_MONTSERRAT_18
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_18, 0);
+#endif
+    lv_obj_set_style_pad_all(label, 7, 0);
+    lv_obj_update_layout(cont);
+    check_layout();
+
+    lv_obj_set_width(label, 150);
+    lv_obj_update_layout(cont);
+    check_layout();
+}
+
+void test_label_line_cache_text_change(void)
+{
+    lv_obj_scroll_to_y(cont, 1000, LV_ANIM_OFF);
+    check_draw();
+
+    /*Replace the text in place*/
+    char * label_txt = lv_label_get_text(label);
+    label_txt[1000] = '\n';
+    label_txt[2000] = '\0';
+    lv_label_set_text(label, NULL);
+    lv_obj_update_layout(cont);
+    check_layout();
+    check_scrolled();
+
+    lv_label_ins_text(label, 10, "Inserted\nlines\n");
+    lv_label_cut_text(label, 300, 20);
+    lv_obj_update_layout(cont);
+    check_layout();
+    check_scrolled();
+
+    lv_label_set_text_static(label, txt);
+    lv_obj_update_layout(cont);
+    check_layout();
+    check_scrolled();
+
+    /*A text ending with a new line is one line taller*/
+    lv_label_set_text_fmt(label, "%s\n", txt + TXT_SIZE / 2);
+    lv_obj_update_layout(cont);
+    check_layout();
+}
+
+void test_label_line_cache_dot(void)
+{
+    lv_obj_set_height(label, 200);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_DOT);
+    lv_obj_update_layout(cont);
+
+    const char * label_txt = lv_label_get_text(label);
+    size_t len = strlen(label_txt);
+    TEST_ASSERT_LESS_THAN(strlen(txt), len);
+    TEST_ASSERT_EQUAL_STRING("...", &label_txt[len - 3]);
+    check_draw();
+
+    /*The original text is restored*/
+    lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
+    lv_obj_set_height(label, LV_SIZE_CONTENT);
+    TEST_ASSERT_EQUAL_STRING(txt, lv_label_get_text(label));
+    lv_obj_update_layout(cont);
+    check_layout();
+    check_scrolled();
+}
+
+void test_label_line_cache_size_content(void)
+{
+    /*Wrapped only at the new lines*/
+    lv_obj_set_width(label, LV_SIZE_CONTENT);
+    lv_obj_update_layout(cont);
+
+    lv_point_t size;
+    lv_txt_get_size(&size, txt, lv_obj_get_style_text_font(label, LV_PART_MAIN), 0, 0, LV_COORD_MAX,
+                    LV_TEXT_FLAG_RECOLOR);
+    TEST_ASSERT_EQUAL(size.x, lv_obj_get_content_width(label));
+    TEST_ASSERT_EQUAL(size.y, lv_obj_get_content_height(label));
+}
+
+/*Frame time of scrolling a long label*/
+void test_label_line_cache_benchmark(void)
+{
+    const uint32_t frame_cnt = 60;
+    uint64_t t_draw[3];
+
+    ref_update();
+
+    uint32_t r;
+    for(r = 0; r < 3; r++) {
+        /*0: wrap the text from the beginning, 1: from the last saved position, 2: cached lines*/
+        ref_use_hint = r == 1;
+        ref_hint.line_start = -1;
+        ref_hint.lines = NULL;
+        lv_obj_set_style_text_opa(label, r == 2 ? LV_OPA_COVER : LV_OPA_TRANSP, 0);
+        if(r == 2) lv_obj_add_flag(ref, LV_OBJ_FLAG_HIDDEN);
+        else lv_obj_clear_flag(ref, LV_OBJ_FLAG_HIDDEN);
+
+        lv_obj_scroll_to_y(cont, lv_obj_get_height(label) / 2, LV_ANIM_OFF);
+        lv_refr_now(NULL);
+
+        uint32_t i;
+        uint64_t t_start = lv_test_get_time_us();
+        for(i = 0; i < frame_cnt; i++) {
+            lv_obj_scroll_by(cont, 0, i < frame_cnt / 2 ? -17 : 17, LV_ANIM_OFF);
+            lv_refr_now(NULL);
+        }
+        t_draw[r] = lv_test_get_time_us() - t_start;
+    }
+    ref_use_hint = false;
+
+    uint64_t t_start = lv_test_get_time_us();
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_point_t pos = {100, lv_obj_get_height(label) - 50};
+        lv_label_get_letter_on(label, &pos);
+    }
+    uint64_t t_letter = lv_test_get_time_us() - t_start;
+
+    printf("Scrolling a %d kB label, without / with hint / with cached lines:\n", TXT_SIZE / 1024);
+    printf("  scroll+redraw: %8.2f / %8.2f / %8.2f ms/frame\n", (double)t_draw[0] / frame_cnt / 1000,
+           (double)t_draw[1] / frame_cnt / 1000, (double)t_draw[2] / frame_cnt / 1000);
+    printf("  letter on the last line: %8.2f us\n", (double)t_letter / 100);
+}
+
+#endif
@@ -0,0 +1,235 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+static lv_obj_t * cont;
+
+void setUp(void)
+{
+    cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 300, 400);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_row(cont, 5, 0);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+static lv_obj_t * row_create(lv_coord_t h)
+{
+    lv_obj_t * row = lv_obj_create(cont);
+    lv_obj_set_size(row, lv_pct(100), h);
+    return row;
+}
+
+/*Check that the visible children are placed below each other as a full layout update would do*/
+static void column_check(void)
+{
+    lv_coord_t y = cont->coords.y1 + lv_obj_get_style_pad_top(cont, 0) + lv_obj_get_style_border_width(cont, 0) -
+                   lv_obj_get_scroll_y(cont);
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(cont); i++) {
+        lv_obj_t * child = lv_obj_get_child(cont, i);
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+        TEST_ASSERT_EQUAL_MESSAGE(y, child->coords.y1, "child y");
+        y += lv_obj_get_height(child) + lv_obj_get_style_pad_row(cont, 0);
+    }
+}
+
+/*Shift the children horizontally behind the layout's back, update the layout and
+ *count the children it has moved back. Then move back the others too.*/
+static uint32_t update_and_count_repositioned(void)
+{
+    const lv_coord_t shift = 1000;
+    uint32_t child_cnt = lv_obj_get_child_cnt(cont);
+    uint32_t i;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = lv_obj_get_child(cont, i);
+        child->coords.x1 += shift;
+        child->coords.x2 += shift;
+    }
+
+    lv_obj_update_layout(cont);
+
+    uint32_t cnt = 0;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = lv_obj_get_child(cont, i);
+        if(child->coords.x1 < cont->coords.x1 + shift) {
+            cnt++;
+        }
+        else {
+            child->coords.x1 -= shift;
+            child->coords.x2 -= shift;
+        }
+    }
+    return cnt;
+}
+
+void test_flex_append_rows_one_by_one(void)
+{
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        row_create(10 + i);
+        lv_obj_update_layout(cont);
+        column_check();
+        TEST_ASSERT_EQUAL(lv_obj_get_child_cnt(cont), cont->spec_attr->layout_clean_cnt);
+    }
+}
+
+void test_flex_resize_and_hide_a_middle_row(void)
+{
+    uint32_t i;
+    for(i = 0; i < 10; i++) row_create(20);
+    lv_obj_update_layout(cont);
+
+    /*Only the rows after the changed one are affected*/
+    lv_obj_set_height(lv_obj_get_child(cont, 4), 50);
+    lv_obj_update_layout(cont);
+    column_check();
+
+    lv_obj_add_flag(lv_obj_get_child(cont, 2), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_update_layout(cont);
+    column_check();
+
+    lv_obj_clear_flag(lv_obj_get_child(cont, 2), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_set_style_translate_y(lv_obj_get_child(cont, 6), 7, 0);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL(lv_obj_get_y(lv_obj_get_child(cont, 5)) + 20 + 5 + 7, lv_obj_get_y(lv_obj_get_child(cont, 6)));
+    TEST_ASSERT_EQUAL(lv_obj_get_y(lv_obj_get_child(cont, 5)) + 2 * (20 + 5), lv_obj_get_y(lv_obj_get_child(cont, 7)));
+}
+
+void test_flex_delete_and_move_rows(void)
+{
+    uint32_t i;
+    for(i = 0; i < 10; i++) row_create(10 + i);
+    lv_obj_update_layout(cont);
+
+    lv_obj_del(lv_obj_get_child(cont, 3));
+    lv_obj_update_layout(cont);
+    column_check();
+
+    lv_obj_move_to_index(lv_obj_get_child(cont, 7), 1);
+    lv_obj_update_layout(cont);
+    column_check();
+
+    lv_obj_t * cont2 = lv_obj_create(lv_scr_act());
+    lv_obj_set_parent(lv_obj_get_child(cont, 0), cont2);
+    lv_obj_update_layout(cont);
+    column_check();
+}
+
+void test_flex_delete_late_row_repositions_only_the_next_ones(void)
+{
+    uint32_t i;
+    for(i = 0; i < 10; i++) row_create(10 + i);
+    lv_obj_update_layout(cont);
+
+    lv_obj_del(lv_obj_get_child(cont, 7));
+    TEST_ASSERT_EQUAL(7, cont->spec_attr->layout_clean_cnt);
+    TEST_ASSERT_EQUAL(2, update_and_count_repositioned());
+    column_check();
+
+    /*Deleting the last row moves nothing*/
+    lv_obj_del(lv_obj_get_child(cont, 8));
+    TEST_ASSERT_EQUAL(0, update_and_count_repositioned());
+    column_check();
+
+    /*Moving a row to an other index repositions from the lower index*/
+    lv_obj_move_to_index(lv_obj_get_child(cont, 7), 5);
+    TEST_ASSERT_EQUAL(3, update_and_count_repositioned());
+    column_check();
+}
+
+void test_flex_grow_row_added_later(void)
+{
+    uint32_t i;
+    for(i = 0; i < 5; i++) row_create(20);
+    lv_obj_update_layout(cont);
+
+    /*A grow item changes the size of the others' track so everything is recalculated*/
+    lv_obj_t * row = row_create(20);
+    lv_obj_set_flex_grow(row, 1);
+    row_create(20);
+    lv_obj_update_layout(cont);
+    column_check();
+    TEST_ASSERT_EQUAL(0, cont->spec_attr->layout_clean_cnt);
+    TEST_ASSERT_GREATER_THAN(20, lv_obj_get_height(row));
+
+    lv_obj_set_flex_grow(row, 0);
+    lv_obj_update_layout(cont);
+    column_check();
+    TEST_ASSERT_EQUAL(lv_obj_get_child_cnt(cont), cont->spec_attr->layout_clean_cnt);
+}
+
+void test_flex_centered_rows_are_updated_fully(void)
+{
+    lv_obj_set_flex_align(cont, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
+    lv_obj_t * row1 = row_create(20);
+    lv_obj_t * row2 = row_create(20);
+    lv_obj_update_layout(cont);
+    lv_coord_t y1 = lv_obj_get_y(row1);
+
+    lv_obj_set_height(row2, 60);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL(y1 - 20, lv_obj_get_y(row1));
+    TEST_ASSERT_EQUAL(0, cont->spec_attr->layout_clean_cnt);
+}
+
+/*A size change deep in the tree has to reach the layout of all the ancestors*/
+void test_layout_nested_content_size_change(void)
+{
+    lv_obj_t * row1 = row_create(LV_SIZE_CONTENT);
+    lv_obj_t * row2 = row_create(20);
+    lv_obj_t * wrapper = lv_obj_create(row1);
+    lv_obj_set_size(wrapper, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_t * leaf = lv_obj_create(wrapper);
+    lv_obj_set_size(leaf, 50, 10);
+    lv_obj_update_layout(cont);
+    lv_coord_t h1 = lv_obj_get_height(row1);
+    column_check();
+
+    lv_obj_set_height(leaf, 30);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_GREATER_THAN(h1, lv_obj_get_height(row1));
+    TEST_ASSERT_EQUAL(row1->coords.y2 + 1 + 5, row2->coords.y1);
+    column_check();
+
+    /*Nothing is dirty after the update*/
+    TEST_ASSERT_FALSE(lv_scr_act()->scr_layout_inv);
+    TEST_ASSERT_FALSE(lv_scr_act()->child_layout_inv);
+    TEST_ASSERT_FALSE(cont->child_layout_inv);
+    TEST_ASSERT_FALSE(row1->child_layout_inv);
+}
+
+void test_layout_benchmark_flex_append(void)
+{
+    const uint32_t row_cnt = 1000;
+    lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
+    lv_obj_set_style_pad_row(cont, 0, 0);
+
+    uint64_t t_layout = 0;
+    uint64_t t_start_all = lv_test_get_time_us();
+    uint32_t i;
+    for(i = 0; i < row_cnt; i++) {
+        lv_obj_t * row = lv_obj_create(cont);
+        lv_obj_set_size(row, lv_pct(100), LV_SIZE_CONTENT);
+        lv_obj_t * label = lv_label_create(row);
+        lv_label_set_text_fmt(label, "Row %d", (int)i);
+
+        uint64_t t_start = lv_test_get_time_us();
+        lv_obj_update_layout(cont);
+        t_layout += lv_test_get_time_us() - t_start;
+    }
+    uint64_t t_all = lv_test_get_time_us() - t_start_all;
+    column_check();
+
+    printf("Append %u flex rows: layout %.1f ms total (%.1f us/row), all %.1f ms\n", (unsigned)row_cnt,
+           (double)t_layout / 1000, (double)t_layout / row_cnt, (double)t_all / 1000);
+}
+
+#endif
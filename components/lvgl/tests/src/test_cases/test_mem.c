@@ -2,6 +2,8 @@
 #include "../lvgl.h"
 
 #include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
 
 void setUp(void)
 {
@@ -23,4 +25,363 @@ void test_mem_buf_realloc(void)
 #endif
 }
 
+void test_mem_buf_arena(void)
+{
+#if LV_MEM_BUF_ARENA_SIZE
+    lv_mem_buf_monitor_reset();
+    lv_mem_buf_monitor_t mon;
+
+    uint8_t * a = lv_mem_buf_get(10);
+    uint8_t * b = lv_mem_buf_get(100);
+    uint8_t * c = lv_mem_buf_get(30);
+    lv_mem_buf_monitor(&mon);
+    uint32_t used_a = (uint32_t)(b - a);
+    uint32_t used_ab = (uint32_t)(c - a);
+    TEST_ASSERT_EQUAL(3, mon.get_cnt);
+    TEST_ASSERT_EQUAL(0, mon.heap_alloc_cnt);
+    TEST_ASSERT_GREATER_THAN(used_ab, mon.arena_used);
+
+    /*Released out of order: kept until the buffers above it are released too*/
+    lv_mem_buf_release(b);
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN(used_ab, mon.arena_used);
+    lv_mem_buf_release(c);
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_EQUAL(used_a, mon.arena_used);
+
+    /*The space is reused*/
+    uint8_t * d = lv_mem_buf_get(50);
+    TEST_ASSERT_EQUAL_PTR(b, d);
+    lv_mem_buf_release(d);
+    lv_mem_buf_release(a);
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_EQUAL(0, mon.arena_used);
+    TEST_ASSERT_GREATER_THAN(used_ab, mon.arena_max_used);
+
+    /*Too large for the arena: allocated on the heap*/
+    uint8_t * e = lv_mem_buf_get(LV_MEM_BUF_ARENA_SIZE);
+    TEST_ASSERT_NOT_NULL(e);
+    lv_mem_buf_monitor(&mon);
+    TEST_ASSERT_EQUAL(1, mon.heap_alloc_cnt);
+    TEST_ASSERT_EQUAL(LV_MEM_BUF_ARENA_SIZE, mon.heap_max_size);
+    lv_mem_buf_release(e);
+    lv_mem_buf_free_all();
+#endif
+}
+
+void test_mem_buf_benchmark_frame(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * btn = lv_btn_create(scr);
+        lv_obj_set_size(btn, 140, 60);
+        lv_obj_set_pos(btn, 10 + (i % 4) * 160, 10 + (i / 4) * 90);
+        lv_obj_set_style_radius(btn, 15, 0);
+        lv_obj_set_style_shadow_width(btn, 20, 0);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text(label, LV_SYMBOL_DIRECTORY " Files");
+        lv_obj_center(label);
+    }
+    lv_obj_t * arc = lv_arc_create(scr);
+    lv_obj_set_pos(arc, 10, 200);
+    lv_obj_t * slider = lv_slider_create(scr);
+    lv_obj_set_pos(slider, 200, 250);
+    lv_obj_t * ta = lv_textarea_create(scr);
+    lv_obj_set_pos(ta, 400, 200);
+    lv_textarea_set_text(ta, "Lorem ipsum dolor sit amet, consectetur adipiscing elit");
+    lv_refr_now(NULL);
+
+    const uint32_t frames = 50;
+    lv_mem_buf_monitor_reset();
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < frames; i++) {
+        lv_obj_invalidate(scr);
+        lv_refr_now(NULL);
+    }
+    uint64_t t_frames = lv_test_get_time_us() - t_start;
+
+    lv_mem_buf_monitor_t mon;
+    lv_mem_buf_monitor(&mon);
+    printf("scratch buffers per frame: %.1f get, %.1f heap (re)alloc, arena high-water %u/%u bytes, "
+           "largest heap buffer %u bytes, %.1f us/frame\n",
+           (double)mon.get_cnt / frames, (double)mon.heap_alloc_cnt / frames, (unsigned)mon.arena_max_used,
+           (unsigned)mon.arena_size, (unsigned)mon.heap_max_size, (double)t_frames / frames);
+
+    lv_obj_clean(scr);
+}
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+
+/**
+ * Replay the allocations of switching between the apps of the tablet on a 64 kB heap:
+ * the next app is created before the previous one is deleted and a few blocks of every app
+ * (e.g. cached texts and images) live longer.
+ */
+
+#define TRACE_HEAP_SIZE     (64U * 1024U)
+#define TRACE_APP_ALLOC_MAX 1200
+#define TRACE_KEEP_MAX      32
+
+typedef struct {
+    lv_tlsf_t tlsf;
+    lv_mem_slab_t * slab;
+    uint32_t fail_cnt;
+    uint32_t frag_pct_max;
+    uint32_t biggest_free_min;
+} trace_heap_t;
+
+typedef struct {
+    void * p[TRACE_APP_ALLOC_MAX];
+    uint32_t cnt;
+} trace_app_t;
+
+static uint32_t trace_rnd;
+
+static uint32_t trace_rand(uint32_t max)
+{
+    trace_rnd = trace_rnd * 1103515245 + 12345;
+    return (trace_rnd >> 16) % max;
+}
+
+static void * trace_alloc(trace_heap_t * heap, size_t size)
+{
+    void * p = NULL;
+    if(heap->slab && size <= LV_MEM_SLAB_SIZE_MAX) p = lv_mem_slab_alloc(heap->slab, size);
+    if(p == NULL) p = lv_tlsf_malloc(heap->tlsf, size);
+    if(p == NULL) heap->fail_cnt++;
+    return p;
+}
+
+static void trace_free(trace_heap_t * heap, void * p)
+{
+    if(p == NULL) return;
+    if(heap->slab && lv_mem_slab_is_slot(heap->slab, p)) lv_mem_slab_free(heap->slab, p);
+    else lv_tlsf_free(heap->tlsf, p);
+}
+
+static void trace_walker(void * ptr, size_t size, int used, void * user)
+{
+    LV_UNUSED(ptr);
+    if(used) return;
+    uint32_t * res = user;
+    res[0] += size;
+    if(size > res[1]) res[1] = size;
+}
+
+static void trace_measure(trace_heap_t * heap)
+{
+    uint32_t res[2] = {0, 0};
+    /*Only the TLSF heap, like `lv_mem_monitor`. The slab area is a used block*/
+    lv_tlsf_walk_pool(lv_tlsf_get_pool(heap->tlsf), trace_walker, res);
+    uint32_t frag_pct = res[0] ? 100 - res[1] * 100U / res[0] : 0;
+    heap->frag_pct_max = LV_MAX(heap->frag_pct_max, frag_pct);
+    heap->biggest_free_min = LV_MIN(heap->biggest_free_min, res[1]);
+}
+
+/*Typical sizes on the ESP32: objects, `spec_attr`, style arrays, event descriptors, `lv_ll` nodes, texts*/
+static size_t trace_small_size(void)
+{
+    static const uint8_t sizes[] = {12, 16, 20, 24, 36, 40, 44, 52, 64, 8, 12, 16, 36, 40, 80, 96};
+    return sizes[trace_rand(sizeof(sizes))];
+}
+
+static void trace_create_app(trace_heap_t * heap, trace_app_t * app, uint32_t obj_cnt)
+{
+    app->cnt = 0;
+    uint32_t i;
+    for(i = 0; i < obj_cnt && app->cnt + 8 < TRACE_APP_ALLOC_MAX; i++) {
+        uint32_t alloc_cnt = 3 + trace_rand(4);
+        uint32_t j;
+        for(j = 0; j < alloc_cnt; j++) app->p[app->cnt++] = trace_alloc(heap, trace_small_size());
+        /*Sometimes a larger buffer: label text, image descriptor, table cells*/
+        if(trace_rand(8) == 0) app->p[app->cnt++] = trace_alloc(heap, 100 + trace_rand(700));
+    }
+}
+
+static void trace_delete_app(trace_heap_t * heap, trace_app_t * app, void ** keep, uint32_t * keep_cnt)
+{
+    uint32_t i;
+    for(i = 0; i < app->cnt; i++) {
+        /*Some blocks survive the app, replacing older ones*/
+        if(app->p[i] && trace_rand(64) == 0) {
+            uint32_t k;
+            if(*keep_cnt < TRACE_KEEP_MAX) {
+                k = (*keep_cnt)++;
+            }
+            else {
+                k = trace_rand(TRACE_KEEP_MAX);
+                trace_free(heap, keep[k]);
+            }
+            keep[k] = app->p[i];
+        }
+        else {
+            trace_free(heap, app->p[i]);
+        }
+    }
+    app->cnt = 0;
+}
+
+static uint64_t trace_replay(trace_heap_t * heap, uint32_t switch_cnt)
+{
+    static trace_app_t apps[2];
+    static void * keep[TRACE_KEEP_MAX];
+    uint32_t keep_cnt = 0;
+    lv_memset_00(keep, sizeof(keep));
+    heap->fail_cnt = 0;
+    heap->frag_pct_max = 0;
+    heap->biggest_free_min = UINT32_MAX;
+    trace_rnd = 1;
+
+    uint64_t t_start = lv_test_get_time_us();
+    uint32_t cur = 0;
+    trace_create_app(heap, &apps[cur], 60);
+    uint32_t i;
+    for(i = 0; i < switch_cnt; i++) {
+        uint32_t next = cur ^ 1;
+        trace_create_app(heap, &apps[next], 30 + trace_rand(50));
+        trace_delete_app(heap, &apps[cur], keep, &keep_cnt);
+        cur = next;
+        trace_measure(heap);
+    }
+    trace_delete_app(heap, &apps[cur], keep, &keep_cnt);
+    for(i = 0; i < keep_cnt; i++) trace_free(heap, keep[i]);
+    return lv_test_get_time_us() - t_start;
+}
+
+#endif
+
+void test_mem_slab_alloc_free_realloc(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+    lv_mem_slab_monitor_t slab_mon_start;
+    lv_mem_monitor_slab(&slab_mon_start);
+
+    static uint8_t * bufs[LV_MEM_SLAB_SIZE_MAX + 1];
+    uint32_t i;
+    for(i = 1; i <= LV_MEM_SLAB_SIZE_MAX; i++) {
+        bufs[i] = lv_mem_alloc(i);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+        TEST_ASSERT_EQUAL(0, (lv_uintptr_t)bufs[i] & (sizeof(void *) - 1));
+        lv_memset(bufs[i], i, i);
+    }
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN(0, mon.slab_size);
+    lv_mem_slab_monitor_t slab_mon;
+    lv_mem_monitor_slab(&slab_mon);
+    uint32_t used_cnt = 0;
+    for(i = 0; i < LV_MEM_SLAB_CLASS_CNT; i++) {
+        used_cnt += slab_mon.classes[i].used_cnt - slab_mon_start.classes[i].used_cnt;
+    }
+    TEST_ASSERT_EQUAL(LV_MEM_SLAB_SIZE_MAX, used_cnt);
+    /*9..16 bytes*/
+    TEST_ASSERT_EQUAL(16, slab_mon.classes[1].obj_size);
+    TEST_ASSERT_EQUAL(8, slab_mon.classes[1].used_cnt - slab_mon_start.classes[1].used_cnt);
+
+    /*Grow in place, move to a larger class, then to the TLSF heap*/
+    uint8_t * p = bufs[10];
+    p = lv_mem_realloc(p, 16);
+    TEST_ASSERT_EQUAL_PTR(bufs[10], p);
+    p = lv_mem_realloc(p, 40);
+    p = lv_mem_realloc(p, 300);
+    TEST_ASSERT_NOT_NULL(p);
+    for(i = 0; i < 10; i++) TEST_ASSERT_EQUAL(10, p[i]);
+    bufs[10] = p;
+
+    for(i = 1; i <= LV_MEM_SLAB_SIZE_MAX; i++) {
+        uint32_t j;
+        for(j = 0; j < i && i != 10; j++) TEST_ASSERT_EQUAL(i, bufs[i][j]);
+        lv_mem_free(bufs[i]);
+    }
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_mem_test());
+
+    /*The empty pages are kept in the slab area as free pages for any size class. The area isn't given back to TLSF.*/
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL(mon_start.free_size, mon.free_size);
+    TEST_ASSERT_EQUAL(mon_start.slab_size, mon.slab_size);
+    lv_mem_monitor_slab(&slab_mon);
+    TEST_ASSERT_EQUAL(slab_mon_start.total_size, slab_mon.total_size);
+    TEST_ASSERT_EQUAL(slab_mon_start.free_page_cnt, slab_mon.free_page_cnt);
+    for(i = 0; i < LV_MEM_SLAB_CLASS_CNT; i++) {
+        TEST_ASSERT_EQUAL(slab_mon_start.classes[i].page_cnt, slab_mon.classes[i].page_cnt);
+    }
+#endif
+}
+
+void test_mem_slab_app_switch_trace(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    static uint64_t pool_tlsf[TRACE_HEAP_SIZE / sizeof(uint64_t)];
+    static uint64_t pool_slab[TRACE_HEAP_SIZE / sizeof(uint64_t)];
+    static lv_mem_slab_t slab;
+    const uint32_t switch_cnt = 300;
+
+    trace_heap_t heap_tlsf = {0};
+    heap_tlsf.tlsf = lv_tlsf_create_with_pool(pool_tlsf, TRACE_HEAP_SIZE);
+    uint64_t t_tlsf = trace_replay(&heap_tlsf, switch_cnt);
+
+    trace_heap_t heap_slab = {0};
+    heap_slab.tlsf = lv_tlsf_create_with_pool(pool_slab, TRACE_HEAP_SIZE);
+    TEST_ASSERT_TRUE(lv_mem_slab_init(&slab, heap_slab.tlsf, TRACE_HEAP_SIZE / 4));
+    heap_slab.slab = &slab;
+    uint64_t t_slab = trace_replay(&heap_slab, switch_cnt);
+
+    printf("app switch trace (%u switches on %u kB): TLSF: %u%% frag max, %u B min biggest free, %u failed, %.1f us/switch;"
+           " slab+TLSF: %u%% frag max, %u B min biggest free, %u failed, %.1f us/switch\n",
+           (unsigned)switch_cnt, TRACE_HEAP_SIZE / 1024,
+           (unsigned)heap_tlsf.frag_pct_max, (unsigned)heap_tlsf.biggest_free_min, (unsigned)heap_tlsf.fail_cnt,
+           (double)t_tlsf / switch_cnt,
+           (unsigned)heap_slab.frag_pct_max, (unsigned)heap_slab.biggest_free_min, (unsigned)heap_slab.fail_cnt,
+           (double)t_slab / switch_cnt);
+
+    TEST_ASSERT_EQUAL(0, heap_slab.fail_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(heap_tlsf.frag_pct_max, heap_slab.frag_pct_max);
+
+    /*Everything is freed*/
+    lv_mem_slab_monitor_t slab_mon;
+    lv_mem_slab_monitor(&slab, &slab_mon);
+    TEST_ASSERT_EQUAL(slab_mon.total_size, slab_mon.free_size);
+    lv_mem_slab_deinit(&slab);
+    TEST_ASSERT_EQUAL(0, lv_tlsf_check(heap_slab.tlsf));
+    TEST_ASSERT_EQUAL(0, lv_tlsf_check_pool(lv_tlsf_get_pool(heap_slab.tlsf)));
+#endif
+}
+
+/**
+ * The 64 kB heap of the tablet: 40 kB for the widgets, 16 kB slab area and 8 kB file cache.
+ * No allocation may fail after a long use.
+ */
+void test_mem_slab_app_switch_trace_fs_cache(void)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB
+    static uint64_t pool[TRACE_HEAP_SIZE / sizeof(uint64_t)];
+    static lv_mem_slab_t slab;
+    const uint32_t switch_cnt = 1000;
+
+    trace_heap_t heap = {0};
+    heap.tlsf = lv_tlsf_create_with_pool(pool, TRACE_HEAP_SIZE);
+    TEST_ASSERT_TRUE(lv_mem_slab_init(&slab, heap.tlsf, 16U * 1024U));
+    heap.slab = &slab;
+    /*The file cache is allocated once in `lv_init()`*/
+    void * fs_cache = lv_tlsf_malloc(heap.tlsf, 8U * 1024U);
+    TEST_ASSERT_NOT_NULL(fs_cache);
+    trace_replay(&heap, switch_cnt);
+
+    printf("app switch trace with the file cache (%u switches on %u kB): %u%% frag max, %u B min biggest free, %u failed\n",
+           (unsigned)switch_cnt, TRACE_HEAP_SIZE / 1024,
+           (unsigned)heap.frag_pct_max, (unsigned)heap.biggest_free_min, (unsigned)heap.fail_cnt);
+
+    TEST_ASSERT_EQUAL(0, heap.fail_cnt);
+
+    lv_tlsf_free(heap.tlsf, fs_cache);
+    lv_mem_slab_deinit(&slab);
+    TEST_ASSERT_EQUAL(0, lv_tlsf_check(heap.tlsf));
+    TEST_ASSERT_EQUAL(0, lv_tlsf_check_pool(lv_tlsf_get_pool(heap.tlsf)));
+#endif
+}
+
 #endif
@@ -0,0 +1,564 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if LV_OBJ_BITMAP_CACHE
+
+#define HOR_RES 800
+#define VER_RES 480
+#define CARD_CNT 16
+
+extern lv_color_t test_fb[];
+
+static lv_obj_t * cont;
+static lv_obj_t * cards[CARD_CNT];
+static lv_color_t * ref_fb;
+
+static lv_obj_t * card_create(lv_obj_t * parent, uint32_t i)
+{
+    lv_obj_t * card = lv_obj_create(parent);
+    lv_obj_set_size(card, 200, 90);
+    lv_obj_set_style_radius(card, 16, 0);
+    lv_obj_set_style_border_width(card, 0, 0);
+    lv_obj_set_style_shadow_width(card, 24, 0);
+    lv_obj_set_style_shadow_ofs_y(card, 4, 0);
+    lv_obj_set_style_shadow_opa(card, LV_OPA_40, 0);
+    lv_obj_set_style_bg_grad_color(card, lv_palette_lighten(LV_PALETTE_BLUE, 4), 0);
+    lv_obj_set_style_bg_grad_dir(card, LV_GRAD_DIR_VER, 0);
+    lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t * title = lv_label_create(card);
+    lv_label_set_text_fmt(title, "Card %d", (int)i);
+    lv_obj_set_style_text_font(title, &lv_font_montserrat_18, 0);
+
+    lv_obj_t * body = lv_label_create(card);
+    lv_label_set_text(body, "Rarely changing content\nwith a shadow");
+    lv_obj_set_style_text_font(body, &lv_font_montserrat_14, 0);
+    lv_obj_align(body, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+
+    lv_obj_t * btn = lv_btn_create(card);
+    lv_obj_set_size(btn, 44, 44);
+    lv_obj_set_style_radius(btn, LV_RADIUS_CIRCLE, 0);
+    lv_obj_align(btn, LV_ALIGN_RIGHT_MID, 0, 0);
+    lv_obj_t * icon = lv_label_create(btn);
+    lv_label_set_text(icon, LV_SYMBOL_SETTINGS);
+    lv_obj_center(icon);
+
+    return card;
+}
+
+static void cards_set_cached(bool en)
+{
+    uint32_t i;
+    for(i = 0; i < CARD_CNT; i++) {
+        if(en) lv_obj_add_flag(cards[i], LV_OBJ_FLAG_CACHE_BITMAP);
+        else lv_obj_clear_flag(cards[i], LV_OBJ_FLAG_CACHE_BITMAP);
+    }
+}
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Render the screen without the bitmap cache into `ref_fb`.
+ *Clear the flag directly to keep the bitmaps and the statistics.*/
+static void render_ref(void)
+{
+    bool cached[CARD_CNT];
+    bool cont_cached = lv_obj_has_flag(cont, LV_OBJ_FLAG_CACHE_BITMAP);
+    uint32_t i;
+    for(i = 0; i < CARD_CNT; i++) {
+        cached[i] = lv_obj_has_flag(cards[i], LV_OBJ_FLAG_CACHE_BITMAP);
+        cards[i]->flags &= ~LV_OBJ_FLAG_CACHE_BITMAP;
+    }
+    cont->flags &= ~LV_OBJ_FLAG_CACHE_BITMAP;
+
+    render();
+    lv_memcpy(ref_fb, test_fb, HOR_RES * VER_RES * sizeof(lv_color_t));
+
+    for(i = 0; i < CARD_CNT; i++) {
+        if(cached[i]) cards[i]->flags |= LV_OBJ_FLAG_CACHE_BITMAP;
+    }
+    if(cont_cached) cont->flags |= LV_OBJ_FLAG_CACHE_BITMAP;
+}
+
+/*The largest difference of a color channel between the screen and `ref_fb`*/
+static uint32_t ref_max_diff(void)
+{
+    uint32_t max_diff = 0;
+    uint32_t i;
+    for(i = 0; i < HOR_RES * VER_RES; i++) {
+        int32_t d[3] = {
+            (int32_t)LV_COLOR_GET_R(test_fb[i]) - LV_COLOR_GET_R(ref_fb[i]),
+            (int32_t)LV_COLOR_GET_G(test_fb[i]) - LV_COLOR_GET_G(ref_fb[i]),
+            (int32_t)LV_COLOR_GET_B(test_fb[i]) - LV_COLOR_GET_B(ref_fb[i]),
+        };
+        uint32_t c;
+        for(c = 0; c < 3; c++) {
+            uint32_t ad = LV_ABS(d[c]);
+            if(ad > max_diff) max_diff = ad;
+        }
+    }
+    return max_diff;
+}
+
+static void check_look(void)
+{
+    lv_color_t * cached_fb = malloc(HOR_RES * VER_RES * sizeof(lv_color_t));
+    lv_memcpy(cached_fb, test_fb, HOR_RES * VER_RES * sizeof(lv_color_t));
+    render_ref();
+    lv_memcpy(test_fb, cached_fb, HOR_RES * VER_RES * sizeof(lv_color_t));
+    free(cached_fb);
+
+    /*Blending the shadow onto the transparent bitmap and then onto the screen can round differently*/
+    TEST_ASSERT_LESS_OR_EQUAL(4, ref_max_diff());
+}
+
+static lv_obj_bitmap_cache_stats_t stats_get(void)
+{
+    lv_obj_bitmap_cache_stats_t stats;
+    lv_obj_bitmap_cache_get_stats(&stats);
+    return stats;
+}
+
+void setUp(void)
+{
+    ref_fb = malloc(HOR_RES * VER_RES * sizeof(lv_color_t));
+
+    cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 480, 320);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_all(cont, 16, 0);
+    lv_obj_set_style_pad_gap(cont, 16, 0);
+
+    uint32_t i;
+    for(i = 0; i < CARD_CNT; i++) cards[i] = card_create(cont, i);
+    lv_obj_update_layout(cont);
+
+    lv_obj_bitmap_cache_set_size(1536 * 1024);
+    lv_obj_bitmap_cache_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    free(ref_fb);
+    lv_obj_bitmap_cache_set_size(LV_OBJ_BITMAP_CACHE_SIZE);
+
+    lv_obj_bitmap_cache_stats_t stats = stats_get();
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_used);
+}
+
+void test_obj_bitmap_cache_draw(void)
+{
+    cards_set_cached(true);
+    render();
+
+    /*Only the visible cards are rendered*/
+    lv_obj_bitmap_cache_stats_t stats = stats_get();
+    TEST_ASSERT_GREATER_THAN(0, stats.entry_cnt);
+    TEST_ASSERT_LESS_THAN(CARD_CNT, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(stats.entry_cnt, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(0, stats.evict_cnt);
+    check_look();
+
+    /*Drawn from the bitmaps*/
+    lv_obj_bitmap_cache_reset_stats();
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(stats.entry_cnt, stats.hit_cnt);
+    check_look();
+
+    /*The shadow needs an alpha channel*/
+    lv_coord_t ext = _lv_obj_get_ext_draw_size(cards[0]);
+    uint32_t card_size = (lv_obj_get_width(cards[0]) + 2 * ext) * (lv_obj_get_height(cards[0]) + 2 * ext) *
+                         LV_IMG_PX_SIZE_ALPHA_BYTE;
+    TEST_ASSERT_EQUAL(stats.entry_cnt * card_size, stats.mem_used);
+}
+
+void test_obj_bitmap_cache_opaque(void)
+{
+    lv_obj_set_style_radius(cards[0], 0, 0);
+    lv_obj_set_style_shadow_width(cards[0], 0, 0);
+    lv_obj_set_style_shadow_ofs_y(cards[0], 0, 0);
+    lv_obj_add_flag(cards[0], LV_OBJ_FLAG_CACHE_BITMAP);
+    render();
+
+    /*Fully covering objects are cached without alpha channel*/
+    lv_obj_bitmap_cache_stats_t stats = stats_get();
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(lv_obj_get_width(cards[0]) * lv_obj_get_height(cards[0]) * sizeof(lv_color_t), stats.mem_used);
+    check_look();
+}
+
+void test_obj_bitmap_cache_invalidate_child(void)
+{
+    cards_set_cached(true);
+    render();
+    lv_obj_bitmap_cache_reset_stats();
+
+    /*Change a grandchild of a card*/
+    lv_obj_t * icon = lv_obj_get_child(lv_obj_get_child(cards[1], 2), 0);
+    lv_label_set_text(icon, LV_SYMBOL_OK);
+    render();
+    lv_obj_bitmap_cache_stats_t stats = stats_get();
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+    check_look();
+
+    /*Changing the state of a child changes its style*/
+    lv_obj_bitmap_cache_reset_stats();
+    lv_obj_add_state(lv_obj_get_child(cards[2], 2), LV_STATE_PRESSED);
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+    check_look();
+
+    /*Hiding, adding and deleting children*/
+    lv_obj_bitmap_cache_reset_stats();
+    lv_obj_add_flag(lv_obj_get_child(cards[0], 0), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_del(lv_obj_get_child(cards[1], 1));
+    lv_obj_t * label = lv_label_create(cards[2]);
+    lv_label_set_text(label, "New");
+    lv_obj_center(label);
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(3, stats.miss_cnt);
+    check_look();
+
+    /*Hidden cards are not drawn but their bitmap is rendered again when they are visible.
+     *The layout moves the other cards and might show new cards.*/
+    lv_obj_bitmap_cache_reset_stats();
+    uint32_t entry_cnt = stats.entry_cnt;
+    lv_obj_add_flag(cards[0], LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(lv_obj_get_child(cards[0], 0), LV_OBJ_FLAG_HIDDEN);
+    render();
+    lv_obj_clear_flag(cards[0], LV_OBJ_FLAG_HIDDEN);
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(1 + stats.entry_cnt - entry_cnt, stats.miss_cnt);
+    check_look();
+}
+
+void test_obj_bitmap_cache_inherited_style(void)
+{
+    cards_set_cached(true);
+    render();
+    uint32_t entry_cnt = stats_get().entry_cnt;
+    lv_obj_bitmap_cache_reset_stats();
+
+    /*The labels of all the cards inherit the text color*/
+    lv_obj_set_style_text_color(cont, lv_palette_main(LV_PALETTE_RED), 0);
+    render();
+    TEST_ASSERT_EQUAL(entry_cnt, stats_get().miss_cnt);
+    check_look();
+
+    /*Not inherited styles of the parent don't matter*/
+    lv_obj_bitmap_cache_reset_stats();
+    lv_obj_set_style_bg_color(cont, lv_palette_main(LV_PALETTE_GREEN), 0);
+    render();
+    TEST_ASSERT_EQUAL(0, stats_get().miss_cnt);
+    check_look();
+}
+
+void test_obj_bitmap_cache_move(void)
+{
+    cards_set_cached(true);
+    render();
+    lv_obj_bitmap_cache_stats_t stats = stats_get();
+    uint32_t entry_cnt = stats.entry_cnt;
+
+    /*Scrolling only renders the cards which become visible*/
+    lv_obj_scroll_by(cont, 0, -150, LV_ANIM_OFF);
+    render();
+    stats = stats_get();
+    TEST_ASSERT_GREATER_THAN(entry_cnt, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(stats.entry_cnt, stats.miss_cnt);
+    check_look();
+
+    /*Moving a card doesn't render it again but the parent's layout is updated*/
+    lv_obj_bitmap_cache_reset_stats();
+    entry_cnt = stats.entry_cnt;
+    lv_obj_add_flag(cards[0], LV_OBJ_FLAG_IGNORE_LAYOUT);
+    lv_obj_set_pos(cards[0], 300, 150);
+    lv_obj_set_style_translate_x(cards[1], 20, 0);
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(stats.entry_cnt - entry_cnt, stats.miss_cnt);
+    check_look();
+
+    /*Resizing renders it again*/
+    lv_obj_bitmap_cache_reset_stats();
+    lv_obj_set_width(cards[0], 180);
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+    check_look();
+}
+
+void test_obj_bitmap_cache_layer(void)
+{
+    cards_set_cached(true);
+    render();
+    lv_obj_bitmap_cache_reset_stats();
+    uint32_t entry_cnt = stats_get().entry_cnt;
+
+    /*The layer's opacity is applied on the bitmap*/
+    lv_obj_set_style_opa_layered(cards[0], LV_OPA_50, 0);
+    lv_obj_move_foreground(cards[0]);
+    render();
+    lv_obj_bitmap_cache_stats_t stats = stats_get();
+    TEST_ASSERT_EQUAL(stats.entry_cnt - entry_cnt, stats.miss_cnt);
+    check_look();
+
+    /*The transformation too. Without LV_COLOR_SCREEN_TRANSP only the cached cards can be transformed,
+     *so there is no reference to compare with.*/
+    lv_obj_bitmap_cache_reset_stats();
+    entry_cnt = stats.entry_cnt;
+    lv_obj_set_style_transform_zoom(cards[1], 300, 0);
+    lv_obj_set_style_transform_angle(cards[2], 150, 0);
+    lv_obj_set_style_transform_pivot_x(cards[2], lv_pct(50), 0);
+    lv_obj_set_style_transform_pivot_y(cards[2], lv_pct(50), 0);
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(stats.entry_cnt - entry_cnt, stats.miss_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(2, stats.hit_cnt);
+}
+
+void test_obj_bitmap_cache_fade(void)
+{
+    cards_set_cached(true);
+    render();
+    lv_obj_bitmap_cache_reset_stats();
+
+    /*The bitmaps are faded as a whole with the parent, not rendered again*/
+    lv_obj_set_style_opa(cont, LV_OPA_50, 0);
+    render();
+    lv_obj_bitmap_cache_stats_t stats = stats_get();
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(stats.entry_cnt, stats.hit_cnt);
+
+    /*Don't render the bitmaps with semi transparent parents, it's probably an animation*/
+    lv_obj_del(cards[0]);
+    cards[0] = card_create(cont, 0);
+    lv_obj_move_to_index(cards[0], 0);
+    lv_obj_add_flag(cards[0], LV_OBJ_FLAG_CACHE_BITMAP);
+    lv_obj_bitmap_cache_reset_stats();
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+
+    lv_obj_set_style_opa(cont, LV_OPA_COVER, 0);
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+    check_look();
+}
+
+void test_obj_bitmap_cache_budget(void)
+{
+    lv_coord_t ext = _lv_obj_get_ext_draw_size(cards[0]);
+    uint32_t card_size = (lv_obj_get_width(cards[0]) + 2 * ext) * (lv_obj_get_height(cards[0]) + 2 * ext) *
+                         LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+    /*Only the last 2 drawn cards are kept*/
+    lv_obj_bitmap_cache_set_size(card_size * 2 + card_size / 2);
+    cards_set_cached(true);
+    render();
+    lv_obj_bitmap_cache_stats_t stats = stats_get();
+    TEST_ASSERT_EQUAL(2, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(2 * card_size, stats.mem_used);
+    TEST_ASSERT_EQUAL(stats.miss_cnt - 2, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(0, stats.uncached_cnt);
+    check_look();
+
+    /*Too large to cache*/
+    lv_obj_bitmap_cache_reset_stats();
+    lv_obj_bitmap_cache_set_size(card_size - 1);
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_used);
+    TEST_ASSERT_EQUAL(2, stats.evict_cnt);
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.uncached_cnt);
+    check_look();
+
+    /*Disabled*/
+    lv_obj_bitmap_cache_set_size(0);
+    lv_obj_bitmap_cache_reset_stats();
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(0, stats.miss_cnt);
+}
+
+void test_obj_bitmap_cache_free(void)
+{
+    cards_set_cached(true);
+    render();
+    lv_obj_bitmap_cache_stats_t stats = stats_get();
+    uint32_t entry_cnt = stats.entry_cnt;
+    uint32_t mem_used = stats.mem_used;
+
+    lv_obj_del(cards[0]);
+    lv_obj_clear_flag(cards[1], LV_OBJ_FLAG_CACHE_BITMAP);
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(entry_cnt - 2, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(mem_used / entry_cnt * (entry_cnt - 2), stats.mem_used);
+    cards[0] = card_create(cont, 0);
+
+    /*Nested cached objects*/
+    lv_obj_add_flag(cont, LV_OBJ_FLAG_CACHE_BITMAP);
+    render();
+    TEST_ASSERT_TRUE(_lv_obj_bitmap_cache_is_valid(cont));
+    lv_obj_bitmap_cache_reset_stats();
+    lv_label_set_text(lv_obj_get_child(cards[2], 0), "Changed");
+    render();
+    stats = stats_get();
+    TEST_ASSERT_EQUAL(2, stats.miss_cnt);
+    check_look();
+}
+
+static uint64_t scroll_anim(uint32_t frame_cnt)
+{
+    uint64_t t_start = lv_test_get_time_us();
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        lv_obj_scroll_by(cont, 0, i < frame_cnt / 2 ? -13 : 13, LV_ANIM_OFF);
+        lv_refr_now(NULL);
+    }
+    return lv_test_get_time_us() - t_start;
+}
+
+/*Like a screen load animation*/
+static uint64_t move_anim(uint32_t frame_cnt)
+{
+    uint64_t t_start = lv_test_get_time_us();
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        lv_obj_set_x(cont, (HOR_RES * (frame_cnt - 1 - i)) / frame_cnt);
+        lv_refr_now(NULL);
+    }
+    return lv_test_get_time_us() - t_start;
+}
+
+static uint64_t fade_anim(uint32_t frame_cnt)
+{
+    uint64_t t_start = lv_test_get_time_us();
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        lv_obj_set_style_opa(cont, LV_OPA_COVER - (LV_OPA_COVER * i) / frame_cnt, 0);
+        lv_refr_now(NULL);
+    }
+    lv_obj_set_style_opa(cont, LV_OPA_COVER, 0);
+    return lv_test_get_time_us() - t_start;
+}
+
+/*Frame time of scrolling, moving and fading the cards, with and without caching them*/
+void test_obj_bitmap_cache_benchmark(void)
+{
+    const uint32_t frame_cnt = 30;
+    uint64_t t_scroll[2];
+    uint64_t t_move[2];
+    uint64_t t_fade[2];
+
+    uint32_t r;
+    for(r = 0; r < 2; r++) {
+        cards_set_cached(r == 1);
+
+        /*Measure the second run, when the bitmaps of all the shown cards are rendered*/
+        scroll_anim(frame_cnt);
+        t_scroll[r] = scroll_anim(frame_cnt);
+        move_anim(frame_cnt);
+        t_move[r] = move_anim(frame_cnt);
+        fade_anim(frame_cnt);
+        t_fade[r] = fade_anim(frame_cnt);
+    }
+
+    lv_obj_bitmap_cache_stats_t stats = stats_get();
+    printf("%d cards, without / with bitmap cache (%u kB):\n", CARD_CNT, (unsigned)(stats.mem_used / 1024));
+    printf("  scroll: %8.2f / %8.2f ms/frame\n", (double)t_scroll[0] / frame_cnt / 1000,
+           (double)t_scroll[1] / frame_cnt / 1000);
+    printf("  move:   %8.2f / %8.2f ms/frame\n", (double)t_move[0] / frame_cnt / 1000,
+           (double)t_move[1] / frame_cnt / 1000);
+    printf("  fade:   %8.2f / %8.2f ms/frame\n", (double)t_fade[0] / frame_cnt / 1000,
+           (double)t_fade[1] / frame_cnt / 1000);
+
+    TEST_ASSERT_GREATER_THAN(0, stats.hit_cnt);
+}
+
+#else /*LV_OBJ_BITMAP_CACHE*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_obj_bitmap_cache_draw(void)
+{
+
+}
+
+void test_obj_bitmap_cache_opaque(void)
+{
+
+}
+
+void test_obj_bitmap_cache_invalidate_child(void)
+{
+
+}
+
+void test_obj_bitmap_cache_inherited_style(void)
+{
+
+}
+
+void test_obj_bitmap_cache_move(void)
+{
+
+}
+
+void test_obj_bitmap_cache_layer(void)
+{
+
+}
+
+void test_obj_bitmap_cache_fade(void)
+{
+
+}
+
+void test_obj_bitmap_cache_budget(void)
+{
+
+}
+
+void test_obj_bitmap_cache_free(void)
+{
+
+}
+
+void test_obj_bitmap_cache_benchmark(void)
+{
+
+}
+
+#endif
+
+#endif
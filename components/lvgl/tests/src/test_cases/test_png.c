@@ -0,0 +1,360 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/extra/libs/png/lodepng.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PNG_FILE    "src/test_files/png_stream.png"
+
+extern lv_color_t test_fb[];
+
+typedef struct {
+    LodePNGColorType ct;
+    uint32_t bd;
+} png_format_t;
+
+static const png_format_t formats[] = {
+    {LCT_GREY, 1}, {LCT_GREY, 2}, {LCT_GREY, 4}, {LCT_GREY, 8}, {LCT_GREY, 16},
+    {LCT_RGB, 8}, {LCT_RGB, 16},
+    {LCT_PALETTE, 1}, {LCT_PALETTE, 2}, {LCT_PALETTE, 4}, {LCT_PALETTE, 8},
+    {LCT_GREY_ALPHA, 8}, {LCT_GREY_ALPHA, 16},
+    {LCT_RGBA, 8}, {LCT_RGBA, 16},
+};
+
+static uint32_t rnd_seed;
+
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 16) & 0x7FFF;
+}
+
+/**
+ * Encode a PNG with the given color format and compression settings.
+ * The raw data is a smooth gradient with some noise to have repeated strings and all kinds of filters.
+ * `key` adds a tRNS chunk with the color of the first pixel.
+ */
+static uint8_t * encode_png(uint32_t w, uint32_t h, const png_format_t * f, bool key, bool interlace,
+                            uint32_t btype, uint32_t window, LodePNGFilterStrategy filter, size_t * size)
+{
+    LodePNGState state;
+    lodepng_state_init(&state);
+    state.info_raw.colortype = f->ct;
+    state.info_raw.bitdepth = f->bd;
+
+    size_t raw_size = lodepng_get_raw_size(w, h, &state.info_raw);
+    uint8_t * raw = malloc(raw_size);
+    TEST_ASSERT_NOT_NULL(raw);
+    size_t i;
+    for(i = 0; i < raw_size; i++) raw[i] = (uint8_t)(i / 5 + (rnd() & 0x0F));
+
+    if(f->ct == LCT_PALETTE) {
+        uint32_t n = 1 << f->bd;
+        for(i = 0; i < n; i++) {
+            uint8_t a = i % 3 == 0 ? (uint8_t)(i * 37) : 0xFF;
+            lodepng_palette_add(&state.info_raw, (uint8_t)(i * 53), (uint8_t)(i * 91 + 7), (uint8_t)(255 - i), a);
+        }
+    }
+
+    if(key) {
+        state.info_raw.key_defined = 1;
+        if(f->bd < 8) {
+            state.info_raw.key_r = raw[0] >> (8 - f->bd);
+        }
+        else if(f->bd == 8) {
+            state.info_raw.key_r = raw[0];
+            if(f->ct == LCT_RGB) {
+                state.info_raw.key_g = raw[1];
+                state.info_raw.key_b = raw[2];
+            }
+        }
+        else {
+            state.info_raw.key_r = (raw[0] << 8) | raw[1];
+            if(f->ct == LCT_RGB) {
+                state.info_raw.key_g = (raw[2] << 8) | raw[3];
+                state.info_raw.key_b = (raw[4] << 8) | raw[5];
+            }
+        }
+        if(f->ct == LCT_GREY) state.info_raw.key_g = state.info_raw.key_b = state.info_raw.key_r;
+    }
+
+    lodepng_color_mode_copy(&state.info_png.color, &state.info_raw);
+    state.info_png.interlace_method = interlace ? 1 : 0;
+    state.encoder.auto_convert = 0;
+    state.encoder.filter_palette_zero = 0;
+    state.encoder.filter_strategy = filter;
+    state.encoder.zlibsettings.btype = btype;
+    state.encoder.zlibsettings.windowsize = window;
+
+    uint8_t * png = NULL;
+    TEST_ASSERT_EQUAL(0, lodepng_encode(&png, size, raw, w, h, &state));
+    lodepng_state_cleanup(&state);
+    free(raw);
+    return png;
+}
+
+/*Expected pixels in the `LV_IMG_CF_TRUE_COLOR_ALPHA` format of the 32 bit color depth*/
+static uint8_t * ref_decode(const uint8_t * png, size_t size, uint32_t * w, uint32_t * h)
+{
+    uint8_t * px = NULL;
+    TEST_ASSERT_EQUAL(0, lodepng_decode32(&px, w, h, png, size));
+    uint32_t i;
+    for(i = 0; i < *w * *h; i++) {
+        uint8_t r = px[i * 4];
+        px[i * 4] = px[i * 4 + 2];
+        px[i * 4 + 2] = r;
+    }
+    return px;
+}
+
+/*Read rows in order, some rows again (rewind) and some parts of rows*/
+static void check_decoder(const void * src, const uint8_t * ref, uint32_t w, uint32_t h, bool streamed)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(w, dsc.header.w);
+    TEST_ASSERT_EQUAL(h, dsc.header.h);
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA, dsc.header.cf);
+
+    if(!streamed) {
+        TEST_ASSERT_NOT_NULL(dsc.img_data);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, dsc.img_data, w * h * 4);
+        lv_img_decoder_close(&dsc);
+        return;
+    }
+
+    TEST_ASSERT_NULL(dsc.img_data);
+    uint8_t * buf = malloc(w * 4);
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, w, buf));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(ref + y * w * 4, buf, w * 4);
+    }
+
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        uint32_t x = rnd() % w;
+        uint32_t len = 1 + rnd() % (w - x);
+        y = rnd() % h;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, x, y, len, buf));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(ref + (y * w + x) * 4, buf, len * 4);
+    }
+
+    /*Out of the image*/
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_read_line(&dsc, 0, h, w, buf));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_read_line(&dsc, 1, 0, w, buf));
+
+    free(buf);
+    lv_img_decoder_close(&dsc);
+}
+
+static lv_img_dsc_t png_dsc(const uint8_t * png, size_t size)
+{
+    lv_img_dsc_t dsc;
+    lv_memset_00(&dsc, sizeof(dsc));
+    dsc.data = png;
+    dsc.data_size = size;
+    return dsc;
+}
+
+void setUp(void)
+{
+    rnd_seed = 1234;
+}
+
+void tearDown(void)
+{
+    remove(PNG_FILE);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_png_all_color_formats(void)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        uint32_t key;
+        for(key = 0; key < 2; key++) {
+            if(key && (formats[i].ct != LCT_GREY && formats[i].ct != LCT_RGB)) continue;
+
+            size_t size;
+            uint8_t * png = encode_png(37, 23, &formats[i], key, false, 2, 2048, LFS_MINSUM, &size);
+            uint32_t w, h;
+            uint8_t * ref = ref_decode(png, size, &w, &h);
+
+            lv_img_dsc_t dsc = png_dsc(png, size);
+            check_decoder(&dsc, ref, w, h, true);
+
+            lv_mem_free(ref);
+            lv_mem_free(png);
+        }
+    }
+}
+
+void test_png_filters_and_blocks(void)
+{
+    const LodePNGFilterStrategy filters[] = {LFS_ZERO, LFS_ONE, LFS_TWO, LFS_THREE, LFS_FOUR, LFS_MINSUM, LFS_ENTROPY};
+    const png_format_t f_rgba = {LCT_RGBA, 8};
+    const png_format_t f_gray = {LCT_GREY, 4};
+    uint32_t i;
+    for(i = 0; i < sizeof(filters) / sizeof(filters[0]); i++) {
+        uint32_t btype;
+        for(btype = 0; btype < 3; btype++) {
+            const png_format_t * f = i & 1 ? &f_gray : &f_rgba;
+            size_t size;
+            /*With large window the distances can be longer than the image data*/
+            uint8_t * png = encode_png(61, 40, f, false, false, btype, btype == 2 ? 32768 : 256, filters[i], &size);
+            uint32_t w, h;
+            uint8_t * ref = ref_decode(png, size, &w, &h);
+
+            lv_img_dsc_t dsc = png_dsc(png, size);
+            check_decoder(&dsc, ref, w, h, true);
+
+            lv_mem_free(ref);
+            lv_mem_free(png);
+        }
+    }
+}
+
+void test_png_file(void)
+{
+    const png_format_t f = {LCT_RGB, 8};
+    size_t size;
+    /*A large image to have more IDAT chunks*/
+    uint8_t * png = encode_png(200, 150, &f, false, false, 2, 32768, LFS_MINSUM, &size);
+    FILE * file = fopen(PNG_FILE, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL(size, fwrite(png, 1, size, file));
+    fclose(file);
+
+    uint32_t w, h;
+    uint8_t * ref = ref_decode(png, size, &w, &h);
+    check_decoder("A:" PNG_FILE, ref, w, h, true);
+
+    /*Draw it: the image is drawn line by line from the decoder*/
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, "A:" PNG_FILE);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    uint32_t x, y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            const uint8_t * p = ref + (y * w + x) * 4;
+            lv_color_t exp = lv_color_make(p[2], p[1], p[0]);
+            TEST_ASSERT_EQUAL_HEX32(exp.full, test_fb[y * LV_HOR_RES + x].full);
+        }
+    }
+
+    lv_mem_free(ref);
+    lv_mem_free(png);
+}
+
+void test_png_interlaced(void)
+{
+    /*Interlaced images are decoded by LodePNG in one go*/
+    const png_format_t f = {LCT_RGBA, 8};
+    size_t size;
+    uint8_t * png = encode_png(37, 23, &f, false, true, 2, 2048, LFS_MINSUM, &size);
+    uint32_t w, h;
+    uint8_t * ref = ref_decode(png, size, &w, &h);
+
+    lv_img_dsc_t dsc = png_dsc(png, size);
+    check_decoder(&dsc, ref, w, h, false);
+
+    lv_mem_free(ref);
+    lv_mem_free(png);
+}
+
+void test_png_invalid_data(void)
+{
+    const png_format_t f = {LCT_RGBA, 8};
+    size_t size;
+    uint8_t * png = encode_png(37, 23, &f, false, false, 2, 2048, LFS_MINSUM, &size);
+
+    /*Find the zlib header*/
+    uint32_t idat;
+    for(idat = 8; idat + 4 < size; idat++) {
+        if(memcmp(png + idat, "IDAT", 4) == 0) break;
+    }
+    TEST_ASSERT_LESS_THAN(size, idat + 4);
+    uint32_t idat_len = (png[idat - 4] << 24) | (png[idat - 3] << 16) | (png[idat - 2] << 8) | png[idat - 1];
+
+    lv_png_stream_t * s = malloc(sizeof(lv_png_stream_t));
+
+    /*Truncated image data: the first rows can be decoded, the last can't*/
+    lv_img_dsc_t dsc = png_dsc(png, idat + 4 + idat_len / 2);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_png_stream_open(s, &dsc));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_png_stream_read_row(s, 0));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_png_stream_read_row(s, 22));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_png_stream_read_row(s, 22));
+    /*Can start again after an error*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_png_stream_read_row(s, 0));
+    lv_png_stream_close(s);
+
+    /*Invalid zlib header*/
+    png[idat + 4] = 0x0F;
+    dsc = png_dsc(png, size);
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_png_stream_open(s, &dsc));
+
+    /*Not a PNG*/
+    png[1] = 'X';
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_png_stream_open(s, &dsc));
+
+    free(s);
+    lv_mem_free(png);
+}
+
+void test_png_benchmark(void)
+{
+    const png_format_t f = {LCT_RGBA, 8};
+    size_t size;
+    uint8_t * png = encode_png(320, 240, &f, false, false, 2, 32768, LFS_MINSUM, &size);
+    lv_img_dsc_t src = png_dsc(png, size);
+    const uint32_t repeat = 10;
+    uint8_t * buf = malloc(320 * 4);
+
+    /*Streamed: open and read all rows. The memory used while the image is open is measured.*/
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t used_start = mon.total_size - mon.free_size;
+    uint32_t used_stream = 0;
+    uint64_t t_start = lv_test_get_time_us();
+    uint32_t r, y;
+    for(r = 0; r < repeat; r++) {
+        lv_img_decoder_dsc_t dsc;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &src, lv_color_black(), 0));
+        for(y = 0; y < 240; y++) {
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, 320, buf));
+        }
+        lv_mem_monitor(&mon);
+        used_stream = mon.total_size - mon.free_size - used_start;
+        lv_img_decoder_close(&dsc);
+    }
+    uint64_t t_stream = lv_test_get_time_us() - t_start;
+
+    /*The whole image decoded in one go as before*/
+    uint32_t used_full = 0;
+    t_start = lv_test_get_time_us();
+    for(r = 0; r < repeat; r++) {
+        uint32_t w, h;
+        uint8_t * px = ref_decode(png, size, &w, &h);
+        lv_mem_monitor(&mon);
+        used_full = mon.total_size - mon.free_size - used_start;
+        lv_mem_free(px);
+    }
+    uint64_t t_full = lv_test_get_time_us() - t_start;
+
+    printf("PNG 320x240 RGBA (%u bytes):\n", (unsigned)size);
+    printf("  row by row: %7.3f ms, %6u bytes while open\n", (double)t_stream / repeat / 1000, (unsigned)used_stream);
+    printf("  whole image: %7.3f ms, %6u bytes while open\n", (double)t_full / repeat / 1000, (unsigned)used_full);
+
+    LV_HEAP_CHECK(TEST_ASSERT_LESS_THAN(used_full / 4, used_stream));
+
+    free(buf);
+    lv_mem_free(png);
+}
+
+#endif
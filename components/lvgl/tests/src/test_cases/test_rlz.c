@@ -0,0 +1,503 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+#if LV_USE_RLZ
+
+/*The .rlz files are made by
+ *  cd tests
+ *  python3 ../scripts/lv_img_rlz.py --bin -o src/test_files \
+ *      ../examples/assets/img_cogwheel_argb.png ../examples/assets/img_cogwheel_rgb.png
+ */
+#define RLZ_ARGB    "A:src/test_files/img_cogwheel_argb.rlz"
+#define RLZ_RGB     "A:src/test_files/img_cogwheel_rgb.rlz"
+#define PNG_ARGB    "A:../examples/assets/img_cogwheel_argb.png"
+#define PNG_RGB     "A:../examples/assets/img_cogwheel_rgb.png"
+
+extern lv_color_t test_fb[];
+
+LV_IMG_DECLARE(img_cogwheel_argb)
+LV_IMG_DECLARE(img_cogwheel_rgb)
+LV_IMG_DECLARE(img_star)
+LV_IMG_DECLARE(img_caret_down)
+LV_IMG_DECLARE(img_skew_strip)
+LV_IMG_DECLARE(imgbtn_left)
+LV_IMG_DECLARE(imgbtn_mid)
+LV_IMG_DECLARE(animimg001)
+LV_IMG_DECLARE(img_hand)
+
+static void refr_screen(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Expected result of an ARGB8888 pixel stored as RGB565 and A4, then decoded to 32 bit again*/
+static uint32_t px_expected(uint32_t px, bool alpha)
+{
+    uint32_t r = ((px >> 16) & 0xFF) >> 3;
+    uint32_t g = ((px >> 8) & 0xFF) >> 2;
+    uint32_t b = (px & 0xFF) >> 3;
+    uint32_t a = alpha ? ((px >> 24) * 15 + 127) / 255 * 17 : 0xFF;
+    return (a << 24) | (((r * 263 + 7) >> 5) << 16) | (((g * 259 + 3) >> 6) << 8) | ((b * 263 + 7) >> 5);
+}
+
+/*Compare the decoded pixels with the expected ones. The color of the transparent pixels is not stored.*/
+static void px_check(const uint32_t * exp, const uint32_t * act, uint32_t len, bool alpha)
+{
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        uint32_t e = px_expected(exp[i], alpha);
+        if((e >> 24) == 0) TEST_ASSERT_EQUAL_HEX32(0, act[i] >> 24);
+        else TEST_ASSERT_EQUAL_HEX32(e, act[i]);
+    }
+}
+
+/*Decode a PNG into an ARGB8888 image*/
+static lv_img_dsc_t * png_load(const char * path)
+{
+    lv_img_decoder_dsc_t dec;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dec, path, lv_color_black(), 0));
+    uint32_t w = dec.header.w;
+    uint32_t h = dec.header.h;
+    lv_img_dsc_t * img = lv_mem_alloc(sizeof(lv_img_dsc_t) + w * h * 4);
+    img->header = dec.header;
+    img->header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    img->data_size = w * h * 4;
+    img->data = (uint8_t *)(img + 1);
+
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dec, 0, y, w, (uint8_t *)img->data + y * w * 4));
+    }
+    lv_img_decoder_close(&dec);
+    return img;
+}
+
+/*Read the image in parts of rows and in random order as the drawing does*/
+static void rlz_check(const void * src, const lv_img_dsc_t * orig, bool alpha)
+{
+    lv_img_decoder_dsc_t dec;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dec, src, lv_color_black(), 0));
+    TEST_ASSERT_NULL(dec.img_data);
+    TEST_ASSERT_EQUAL(alpha ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR, dec.header.cf);
+    TEST_ASSERT_EQUAL(orig->header.w, dec.header.w);
+    TEST_ASSERT_EQUAL(orig->header.h, dec.header.h);
+
+    lv_coord_t w = orig->header.w;
+    lv_coord_t h = orig->header.h;
+    uint32_t * buf = lv_mem_alloc(w * sizeof(uint32_t));
+    const uint32_t * px = (const uint32_t *)orig->data;
+    lv_coord_t i;
+    for(i = 0; i < h * 2; i++) {
+        lv_coord_t y = (i * 7) % h;
+        lv_coord_t x = i < h ? 0 : (i * 13) % w;
+        lv_coord_t len = i < h ? w : LV_MAX(1, (w - x) / 2);
+
+        /*The second part of the row continues the decoding*/
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dec, x, y, len, (uint8_t *)buf));
+        px_check(px + y * w + x, buf, len, alpha);
+        if(x + len < w) {
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dec, x + len, y, w - x - len, (uint8_t *)buf));
+            px_check(px + y * w + x + len, buf, w - x - len, alpha);
+        }
+    }
+
+    lv_mem_free(buf);
+    lv_img_decoder_close(&dec);
+}
+
+void setUp(void)
+{
+    lv_img_cache_set_size(8);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+}
+
+void test_rlz_decode_files(void)
+{
+    lv_img_dsc_t * argb = png_load(PNG_ARGB);
+    rlz_check(RLZ_ARGB, argb, true);
+    lv_mem_free(argb);
+
+    /*Opaque images have no alpha channel*/
+    lv_img_dsc_t * rgb = png_load(PNG_RGB);
+    rlz_check(RLZ_RGB, rgb, false);
+    lv_mem_free(rgb);
+}
+
+void test_rlz_encode_same_as_the_tool(void)
+{
+    const char * pngs[] = {PNG_ARGB, PNG_RGB};
+    const char * rlzs[] = {RLZ_ARGB + 2, RLZ_RGB + 2};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_img_dsc_t * img = png_load(pngs[i]);
+        lv_img_dsc_t * rlz = lv_rlz_encode(img);
+        TEST_ASSERT_NOT_NULL(rlz);
+        TEST_ASSERT_EQUAL(LV_RLZ_CF, rlz->header.cf);
+
+        FILE * f = fopen(rlzs[i], "rb");
+        TEST_ASSERT_NOT_NULL(f);
+        uint8_t * file = lv_mem_alloc(rlz->data_size + 1);
+        size_t size = fread(file, 1, rlz->data_size + 1, f);
+        fclose(f);
+
+        TEST_ASSERT_EQUAL(rlz->data_size, size);
+        TEST_ASSERT_EQUAL_MEMORY(file, rlz->data, size);
+
+        lv_mem_free(file);
+        lv_rlz_free(rlz);
+        lv_mem_free(img);
+    }
+}
+
+void test_rlz_round_trip(void)
+{
+    const lv_img_dsc_t * imgs[] = {&img_cogwheel_argb, &img_star, &img_caret_down, &img_skew_strip, &imgbtn_left, &img_hand};
+    uint32_t i;
+    for(i = 0; i < sizeof(imgs) / sizeof(imgs[0]); i++) {
+        lv_img_dsc_t * rlz = lv_rlz_encode(imgs[i]);
+        TEST_ASSERT_NOT_NULL(rlz);
+        rlz_check(rlz, imgs[i], true);
+        lv_rlz_free(rlz);
+    }
+
+    /*Only true color images are supported*/
+    lv_img_dsc_t img = img_star;
+    img.header.cf = LV_IMG_CF_ALPHA_8BIT;
+    TEST_ASSERT_NULL(lv_rlz_encode(&img));
+}
+
+void test_rlz_opaque_has_no_alpha(void)
+{
+    /*A 300x200 opaque image with gradients, repeated patterns and flat areas*/
+    lv_coord_t w = 300;
+    lv_coord_t h = 200;
+    lv_img_dsc_t * img = lv_mem_alloc(sizeof(lv_img_dsc_t) + w * h * 4);
+    img->header.always_zero = 0;
+    img->header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    img->header.w = w;
+    img->header.h = h;
+    img->data_size = w * h * 4;
+    img->data = (uint8_t *)(img + 1);
+    uint32_t * px = (uint32_t *)img->data;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            if(x < 100) px[y * w + x] = 0xff000000 | (x * 2) << 16 | y;
+            else if(x < 200) px[y * w + x] = (x / 3) % 2 ? 0xff112233 : 0xffaabbcc;
+            else px[y * w + x] = 0xff00ff00;
+        }
+    }
+
+    lv_img_dsc_t * rlz = lv_rlz_encode(img);
+    TEST_ASSERT_NOT_NULL(rlz);
+    rlz_check(rlz, img, false);
+    TEST_ASSERT_LESS_THAN(w * h * 2 / 4, rlz->data_size);
+    lv_rlz_free(rlz);
+
+    /*Noise can't be compressed and needs 32 bit offsets for more than 64 kB*/
+    for(x = 0; x < w * h; x++) px[x] = 0xff000000 | lv_rand(0, 0xffffff);
+    rlz = lv_rlz_encode(img);
+    TEST_ASSERT_NOT_NULL(rlz);
+    rlz_check(rlz, img, false);
+    TEST_ASSERT_GREATER_THAN(0xffff, rlz->data_size);
+    lv_rlz_free(rlz);
+
+    lv_mem_free(img);
+}
+
+void test_rlz_invalid_data(void)
+{
+    lv_img_dsc_t * rlz = lv_rlz_encode(&img_cogwheel_argb);
+    TEST_ASSERT_NOT_NULL(rlz);
+    lv_img_dsc_t img = *rlz;
+    uint8_t * data = lv_mem_alloc(rlz->data_size);
+    img.data = data;
+
+    /*Bad header*/
+    lv_memcpy(data, rlz->data, rlz->data_size);
+    data[0] = 'X';
+    lv_img_decoder_dsc_t dec;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_open(&dec, &img, lv_color_black(), 0));
+
+    /*The offset tables don't fit*/
+    lv_memcpy(data, rlz->data, rlz->data_size);
+    img.data_size = 100;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_open(&dec, &img, lv_color_black(), 0));
+
+    /*Truncated streams and random garbage are rejected without reading out of the image*/
+    uint32_t buf[100];
+    uint32_t i;
+    for(i = 0; i < 50; i++) {
+        lv_memcpy(data, rlz->data, rlz->data_size);
+        img.data_size = rlz->data_size;
+        if(i % 2) img.data_size = 12 + 200 * 2 + (lv_rand(0, 10000) % (rlz->data_size - 12 - 400));
+        else {
+            uint32_t k;
+            for(k = 0; k < 20; k++) data[lv_rand(12, rlz->data_size - 1)] = lv_rand(0, 255);
+        }
+
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dec, &img, lv_color_black(), 0));
+        lv_coord_t y;
+        for(y = 0; y < 100; y++) lv_img_decoder_read_line(&dec, 0, y, 100, (uint8_t *)buf);
+        lv_img_decoder_close(&dec);
+    }
+
+    /*Out of the image*/
+    img = *rlz;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dec, &img, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_read_line(&dec, 0, 100, 10, (uint8_t *)buf));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_read_line(&dec, 95, 0, 10, (uint8_t *)buf));
+    lv_img_decoder_close(&dec);
+
+    lv_mem_free(data);
+    lv_rlz_free(rlz);
+}
+
+void test_rlz_draw(void)
+{
+    lv_img_dsc_t * rlz = lv_rlz_encode(&img_cogwheel_argb);
+    lv_obj_t * img_orig = lv_img_create(lv_scr_act());
+    lv_img_set_src(img_orig, &img_cogwheel_argb);
+    lv_obj_t * img_rlz = lv_img_create(lv_scr_act());
+    lv_img_set_src(img_rlz, rlz);
+    lv_obj_set_x(img_rlz, 200);
+
+    /*Also transformed*/
+    lv_obj_t * img_rot = lv_img_create(lv_scr_act());
+    lv_img_set_src(img_rot, rlz);
+    lv_img_set_angle(img_rot, 450);
+    lv_obj_set_x(img_rot, 400);
+    refr_screen();
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < 100; y += 3) {
+        for(x = 0; x < 100; x += 3) {
+            uint32_t c_orig = lv_color_to32(test_fb[y * LV_HOR_RES + x]);
+            uint32_t c_rlz = lv_color_to32(test_fb[y * LV_HOR_RES + x + 200]);
+            TEST_ASSERT_UINT32_WITHIN(0x121212, c_orig, c_rlz);
+        }
+    }
+
+    /*The decoded image is not kept, only the row buffer of the decoder*/
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.mem_used);
+    TEST_ASSERT_LESS_THAN(lv_img_buf_get_img_size(100, 100, LV_IMG_CF_TRUE_COLOR_ALPHA) / 10, stats.mem_used);
+
+    lv_obj_clean(lv_scr_act());
+    lv_rlz_free(rlz);
+}
+
+static uint32_t decode_time_us(const void * src, uint32_t repeat)
+{
+    lv_img_decoder_dsc_t dec;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dec, src, lv_color_black(), 0));
+    lv_coord_t w = dec.header.w;
+    lv_coord_t h = dec.header.h;
+    lv_img_decoder_close(&dec);
+
+    uint8_t * buf = lv_mem_alloc(w * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    uint64_t t_start = lv_test_get_time_us();
+    uint32_t r;
+    for(r = 0; r < repeat; r++) {
+        lv_img_decoder_open(&dec, src, lv_color_black(), 0);
+        lv_coord_t y;
+        for(y = 0; y < h; y++) {
+            if(dec.img_data) lv_memcpy(buf, dec.img_data + y * w * LV_IMG_PX_SIZE_ALPHA_BYTE, w * LV_IMG_PX_SIZE_ALPHA_BYTE);
+            else lv_img_decoder_read_line(&dec, 0, y, w, buf);
+        }
+        lv_img_decoder_close(&dec);
+    }
+
+    lv_mem_free(buf);
+    return (uint32_t)(lv_test_get_time_us() - t_start) / repeat;
+}
+
+static uint32_t file_size(const char * path)
+{
+    lv_fs_file_t f;
+    uint32_t size = 0;
+    if(lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) return 0;
+    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    lv_fs_tell(&f, &size);
+    lv_fs_close(&f);
+    return size;
+}
+
+/*Render a symbol of the built-in font into an ARGB image as an icon*/
+static lv_obj_t * symbol_render(const char * txt)
+{
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act());
+    lv_coord_t size = 32;
+    void * cbuf = lv_mem_alloc(LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(size, size));
+    lv_canvas_set_buffer(canvas, cbuf, size, size, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_TRANSP);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = &lv_font_montserrat_24;
+    dsc.color = lv_palette_main(LV_PALETTE_BLUE);
+    lv_canvas_draw_text(canvas, 0, 0, size, &dsc, txt);
+
+    return canvas;
+}
+
+/*Compression ratio and decode speed of the example images and the symbols as icons compared to
+ *the built-in RGB565 (+A8) format and PNG*/
+void test_rlz_benchmark(void)
+{
+    static const char * symbols[] = {
+        LV_SYMBOL_AUDIO, LV_SYMBOL_VIDEO, LV_SYMBOL_LIST, LV_SYMBOL_OK, LV_SYMBOL_CLOSE, LV_SYMBOL_POWER,
+        LV_SYMBOL_SETTINGS, LV_SYMBOL_HOME, LV_SYMBOL_DOWNLOAD, LV_SYMBOL_DRIVE, LV_SYMBOL_REFRESH,
+        LV_SYMBOL_MUTE, LV_SYMBOL_VOLUME_MAX, LV_SYMBOL_IMAGE, LV_SYMBOL_EDIT, LV_SYMBOL_PREV, LV_SYMBOL_PLAY,
+        LV_SYMBOL_PAUSE, LV_SYMBOL_STOP, LV_SYMBOL_NEXT, LV_SYMBOL_EYE_OPEN, LV_SYMBOL_WARNING, LV_SYMBOL_BELL,
+        LV_SYMBOL_FILE, LV_SYMBOL_WIFI, LV_SYMBOL_BATTERY_FULL, LV_SYMBOL_BLUETOOTH, LV_SYMBOL_GPS,
+        LV_SYMBOL_SD_CARD, LV_SYMBOL_KEYBOARD, LV_SYMBOL_TRASH, LV_SYMBOL_USB, LV_SYMBOL_NEW_LINE,
+    };
+
+    static const struct {
+        const char * name;
+        const lv_img_dsc_t * img;
+        const char * png;
+    } examples[] = {
+        {"img_cogwheel_argb", &img_cogwheel_argb, "A:../examples/assets/img_cogwheel_argb.png"},
+        {"img_cogwheel_rgb", &img_cogwheel_rgb, "A:../examples/assets/img_cogwheel_rgb.png"},
+        {"img_star", &img_star, "A:../examples/assets/img_star.png"},
+        {"img_caret_down", &img_caret_down, "A:../examples/assets/img_caret_down.png"},
+        {"img_skew_strip", &img_skew_strip, "A:../examples/assets/img_skew_strip.png"},
+        {"imgbtn_left", &imgbtn_left, "A:../examples/assets/imgbtn_left.png"},
+        {"imgbtn_mid", &imgbtn_mid, "A:../examples/assets/imgbtn_mid.png"},
+        {"animimg001", &animimg001, "A:../examples/assets/animimg001.png"},
+        {"img_hand", &img_hand, NULL},
+    };
+
+    const uint32_t repeat = 20;
+    uint32_t raw_sum = 0;
+    uint32_t rlz_sum = 0;
+    uint32_t png_sum = 0;
+    uint32_t t_rlz_sum = 0;
+    uint32_t t_png_sum = 0;
+
+    printf("%-18s %8s %8s %6s %8s %10s %10s %10s\n", "image", "RGB565", "RLZ", "ratio", "PNG", "RGB565 us", "RLZ us",
+           "PNG us");
+
+    uint32_t i;
+    for(i = 0; i < sizeof(examples) / sizeof(examples[0]); i++) {
+        const lv_img_dsc_t * img = examples[i].img;
+        lv_img_dsc_t * rlz = lv_rlz_encode(img);
+        TEST_ASSERT_NOT_NULL(rlz);
+
+        /*The image as it would be stored in the built-in format of the device*/
+        lv_img_header_t header;
+        lv_img_decoder_get_info(rlz, &header);
+        uint32_t raw = img->header.w * img->header.h * (header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? 3 : 2);
+        uint32_t t_raw = decode_time_us(img, repeat);
+        uint32_t t_rlz = decode_time_us(rlz, repeat);
+
+        uint32_t png = 0;
+        uint32_t t_png = 0;
+        if(examples[i].png) {
+            png = file_size(examples[i].png);
+            t_png = decode_time_us(examples[i].png, repeat);
+            png_sum += png;
+            t_png_sum += t_png;
+            t_rlz_sum += t_rlz;
+        }
+
+        printf("%-18s %8u %8u %5u%% %8u %10u %10u %10u\n", examples[i].name, (unsigned)raw, (unsigned)rlz->data_size,
+               (unsigned)(rlz->data_size * 100 / raw), (unsigned)png, (unsigned)t_raw, (unsigned)t_rlz, (unsigned)t_png);
+        raw_sum += raw;
+        rlz_sum += rlz->data_size;
+        lv_rlz_free(rlz);
+    }
+
+    uint32_t sym_raw = 0;
+    uint32_t sym_rlz = 0;
+    uint32_t t_sym = 0;
+    for(i = 0; i < sizeof(symbols) / sizeof(symbols[0]); i++) {
+        lv_obj_t * canvas = symbol_render(symbols[i]);
+        lv_img_dsc_t * img = lv_canvas_get_img(canvas);
+        lv_img_dsc_t * rlz = lv_rlz_encode(img);
+        TEST_ASSERT_NOT_NULL(rlz);
+        rlz_check(rlz, img, true);
+        sym_raw += img->header.w * img->header.h * 3;
+        sym_rlz += rlz->data_size;
+        t_sym += decode_time_us(rlz, repeat);
+        lv_rlz_free(rlz);
+        lv_mem_free((void *)img->data);
+        lv_obj_del(canvas);
+    }
+
+    printf("%-18s %8u %8u %5u%% %8s %10s %10u\n", "33 symbols 32x32", (unsigned)sym_raw, (unsigned)sym_rlz,
+           (unsigned)(sym_rlz * 100 / sym_raw), "-", "-", (unsigned)t_sym);
+    printf("%-18s %8u %8u %5u%% %8u\n", "total", (unsigned)(raw_sum + sym_raw), (unsigned)(rlz_sum + sym_rlz),
+           (unsigned)((rlz_sum + sym_rlz) * 100 / (raw_sum + sym_raw)), (unsigned)png_sum);
+
+    /*Much smaller than the built-in format and much faster to decode than PNG*/
+    TEST_ASSERT_LESS_THAN(raw_sum / 2, rlz_sum);
+    TEST_ASSERT_LESS_THAN(sym_raw / 4, sym_rlz);
+    TEST_ASSERT_LESS_THAN(t_png_sum / 2, t_rlz_sum);
+}
+
+#else /*LV_USE_RLZ*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_rlz_decode_files(void)
+{
+
+}
+
+void test_rlz_encode_same_as_the_tool(void)
+{
+
+}
+
+void test_rlz_round_trip(void)
+{
+
+}
+
+void test_rlz_opaque_has_no_alpha(void)
+{
+
+}
+
+void test_rlz_invalid_data(void)
+{
+
+}
+
+void test_rlz_draw(void)
+{
+
+}
+
+void test_rlz_benchmark(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,326 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/extra/libs/sjpg/tjpgd.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if LV_USE_SJPG
+
+#define VIEW_W  320
+#define VIEW_H  240
+
+extern lv_color_t test_fb[];
+
+typedef struct {
+    const uint8_t * data;
+    uint32_t size;
+    uint32_t pos;
+    lv_color_t * out;
+    uint32_t w;
+} ref_io_t;
+
+static uint8_t * load_file(const char * path, uint32_t * size)
+{
+    FILE * f = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    fseek(f, 0, SEEK_END);
+    *size = (uint32_t)ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t * data = malloc(*size);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_EQUAL(*size, fread(data, 1, *size, f));
+    fclose(f);
+    return data;
+}
+
+static size_t ref_in(JDEC * jd, uint8_t * buf, size_t n)
+{
+    ref_io_t * io = jd->device;
+    if(n > io->size - io->pos) n = io->size - io->pos;
+    if(buf) memcpy(buf, io->data + io->pos, n);
+    io->pos += n;
+    return n;
+}
+
+static int ref_out(JDEC * jd, void * data, JRECT * rect)
+{
+    ref_io_t * io = jd->device;
+    const uint8_t * rgb = data;
+    uint32_t x, y;
+    for(y = rect->top; y <= rect->bottom; y++) {
+        for(x = rect->left; x <= rect->right; x++) {
+            io->out[y * io->w + x] = lv_color_make(rgb[0], rgb[1], rgb[2]);
+            rgb += 3;
+        }
+    }
+    return 1;
+}
+
+/*Decode a whole JPG in one go with TJpgDec as reference*/
+static lv_color_t * ref_decode(const uint8_t * data, uint32_t size, uint32_t * w, uint32_t * h)
+{
+    JDEC jd;
+    ref_io_t io = {data, size, 0, NULL, 0};
+    void * work = malloc(4096);
+    TEST_ASSERT_EQUAL(JDR_OK, jd_prepare(&jd, ref_in, work, 4096, &io));
+    io.w = jd.width;
+    io.out = malloc(sizeof(lv_color_t) * jd.width * jd.height);
+    TEST_ASSERT_EQUAL(JDR_OK, jd_decomp(&jd, ref_out, 0));
+    free(work);
+    *w = jd.width;
+    *h = jd.height;
+    return io.out;
+}
+
+/*Read the whole image line by line from top to bottom*/
+static lv_color_t * sequential_decode(const void * src, uint32_t * w, uint32_t * h)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+    TEST_ASSERT_NULL(dsc.img_data);
+    *w = dsc.header.w;
+    *h = dsc.header.h;
+    lv_color_t * out = malloc(sizeof(lv_color_t) * *w * *h);
+    uint32_t y;
+    for(y = 0; y < *h; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, *w, (uint8_t *)&out[y * *w]));
+    }
+    lv_img_decoder_close(&dsc);
+    return out;
+}
+
+/*Read random areas (also backwards) and compare them with the reference*/
+static void check_random_areas(const void * src, const lv_color_t * ref, uint32_t ref_w, uint32_t ref_h)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(ref_w, dsc.header.w);
+    TEST_ASSERT_EQUAL(ref_h, dsc.header.h);
+
+    lv_color_t * buf = malloc(sizeof(lv_color_t) * ref_w * 64);
+    uint32_t seed = 1;
+    uint32_t i;
+    for(i = 0; i < 60; i++) {
+        seed = seed * 1103515245 + 12345;
+        lv_area_t a;
+        a.x1 = (seed >> 8) % ref_w;
+        a.y1 = (seed >> 4) % ref_h;
+        seed = seed * 1103515245 + 12345;
+        a.x2 = LV_MIN(a.x1 + (int32_t)((seed >> 8) % 400), (int32_t)ref_w - 1);
+        a.y2 = LV_MIN(a.y1 + (int32_t)((seed >> 20) % 64), (int32_t)ref_h - 1);
+        if(i % 4 == 0) a.y2 = a.y1;     /*Also a few single lines*/
+
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_area(&dsc, &a, (uint8_t *)buf));
+        int32_t x, y;
+        lv_color_t * px = buf;
+        for(y = a.y1; y <= a.y2; y++) {
+            for(x = a.x1; x <= a.x2; x++) {
+                if(px->full != ref[y * ref_w + x].full) {
+                    char msg[64];
+                    lv_snprintf(msg, sizeof(msg), "Pixel mismatch at %d;%d (area %d)", (int)x, (int)y, (int)i);
+                    TEST_FAIL_MESSAGE(msg);
+                }
+                px++;
+            }
+        }
+    }
+
+    /*Outside of the image*/
+    lv_area_t out = {(lv_coord_t)ref_w - 10, 0, (lv_coord_t)ref_w, 0};
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_read_area(&dsc, &out, (uint8_t *)buf));
+
+    free(buf);
+    lv_img_decoder_close(&dsc);
+}
+
+static lv_obj_t * viewport_create(const void * src)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, VIEW_W, VIEW_H);
+    lv_obj_set_scrollbar_mode(cont, LV_SCROLLBAR_MODE_OFF);
+
+    lv_obj_t * img = lv_img_create(cont);
+    lv_img_set_src(img, src);
+    return cont;
+}
+
+void setUp(void)
+{
+    lv_img_cache_invalidate_src(NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+}
+
+void test_sjpg_jpg_areas(void)
+{
+    const char * paths[] = {"src/test_files/photo.jpg", "src/test_files/photo_444_rst.jpg"};
+    const char * lv_paths[] = {"A:src/test_files/photo.jpg", "A:src/test_files/photo_444_rst.jpg"};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        uint32_t size;
+        uint8_t * data = load_file(paths[i], &size);
+        uint32_t w, h;
+        lv_color_t * ref = ref_decode(data, size, &w, &h);
+
+        lv_img_dsc_t img_dsc;
+        lv_memset_00(&img_dsc, sizeof(img_dsc));
+        img_dsc.header.cf = LV_IMG_CF_RAW;
+        img_dsc.header.w = w;
+        img_dsc.header.h = h;
+        img_dsc.data = data;
+        img_dsc.data_size = size;
+
+        check_random_areas(&img_dsc, ref, w, h);
+        check_random_areas(lv_paths[i], ref, w, h);
+
+        /*Reading the lines one by one gives the same result*/
+        uint32_t w2, h2;
+        lv_color_t * seq = sequential_decode(lv_paths[i], &w2, &h2);
+        TEST_ASSERT_EQUAL_MEMORY(ref, seq, sizeof(lv_color_t) * w * h);
+
+        free(seq);
+        free(ref);
+        free(data);
+    }
+}
+
+void test_sjpg_sjpg_areas(void)
+{
+    uint32_t w, h;
+    lv_color_t * ref = sequential_decode("A:src/test_files/photo.sjpg", &w, &h);
+    TEST_ASSERT_EQUAL(1024, w);
+    TEST_ASSERT_EQUAL(768, h);
+    check_random_areas("A:src/test_files/photo.sjpg", ref, w, h);
+
+    uint32_t size;
+    uint8_t * data = load_file("src/test_files/photo.sjpg", &size);
+    lv_img_dsc_t img_dsc;
+    lv_memset_00(&img_dsc, sizeof(img_dsc));
+    img_dsc.header.cf = LV_IMG_CF_RAW;
+    img_dsc.header.w = w;
+    img_dsc.header.h = h;
+    img_dsc.data = data;
+    img_dsc.data_size = size;
+    check_random_areas(&img_dsc, ref, w, h);
+
+    free(data);
+    free(ref);
+}
+
+void test_sjpg_draw_scrolled(void)
+{
+    uint32_t size;
+    uint8_t * data = load_file("src/test_files/photo.jpg", &size);
+    uint32_t w, h;
+    lv_color_t * ref = ref_decode(data, size, &w, &h);
+
+    lv_obj_t * cont = viewport_create("A:src/test_files/photo.jpg");
+    const lv_coord_t scroll[][2] = {{0, 0}, {301, 203}, {704, 528}, {13, 500}};
+    uint32_t i;
+    for(i = 0; i < sizeof(scroll) / sizeof(scroll[0]); i++) {
+        lv_obj_scroll_to(cont, scroll[i][0], scroll[i][1], LV_ANIM_OFF);
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+
+        int32_t x, y;
+        for(y = 0; y < VIEW_H; y++) {
+            for(x = 0; x < VIEW_W; x++) {
+                uint32_t ref_i = (y + scroll[i][1]) * w + x + scroll[i][0];
+                TEST_ASSERT_EQUAL_HEX32(ref[ref_i].full, test_fb[y * LV_HOR_RES + x].full);
+            }
+        }
+    }
+
+    free(ref);
+    free(data);
+}
+
+void test_sjpg_benchmark_viewport(void)
+{
+    const char * srcs[] = {"A:src/test_files/photo.jpg", "A:src/test_files/photo.sjpg", "A:src/test_files/photo_444_rst.jpg"};
+    const uint32_t step = 8;
+    const uint32_t frame_cnt = 48;
+
+    printf("Scroll large photos in a %dx%d viewport, %u refreshes with %u px steps:\n", VIEW_W, VIEW_H,
+           (unsigned)frame_cnt, (unsigned)step);
+    uint32_t s;
+    for(s = 0; s < sizeof(srcs) / sizeof(srcs[0]); s++) {
+        lv_obj_t * cont = viewport_create(srcs[s]);
+
+        uint64_t t_start = lv_test_get_time_us();
+        lv_refr_now(NULL);
+        uint64_t t_first = lv_test_get_time_us() - t_start;
+
+        /*Scroll down, right, up and left*/
+        t_start = lv_test_get_time_us();
+        uint32_t i;
+        for(i = 0; i < frame_cnt; i++) {
+            lv_coord_t d = i < frame_cnt / 2 ? (lv_coord_t)step : -(lv_coord_t)step;
+            if(i % 2) lv_obj_scroll_by(cont, 0, -d, LV_ANIM_OFF);
+            else lv_obj_scroll_by(cont, -d, 0, LV_ANIM_OFF);
+            lv_refr_now(NULL);
+        }
+        uint64_t t_scroll = lv_test_get_time_us() - t_start;
+
+        /*Redraw the whole viewport at random positions*/
+        t_start = lv_test_get_time_us();
+        uint32_t seed = 1;
+        for(i = 0; i < frame_cnt; i++) {
+            seed = seed * 1103515245 + 12345;
+            lv_obj_scroll_to(cont, (seed >> 8) % 600, (seed >> 16) % 500, LV_ANIM_OFF);
+            lv_obj_invalidate(cont);
+            lv_refr_now(NULL);
+        }
+        uint64_t t_jump = lv_test_get_time_us() - t_start;
+
+        printf("  %-36s first: %7.2f ms, scroll: %6.2f ms/frame, jump: %6.2f ms/frame\n", srcs[s],
+               (double)t_first / 1000, (double)t_scroll / frame_cnt / 1000, (double)t_jump / frame_cnt / 1000);
+
+        lv_obj_del(cont);
+        lv_img_cache_invalidate_src(NULL);
+    }
+}
+
+#else /*LV_USE_SJPG*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_sjpg_jpg_areas(void)
+{
+
+}
+
+void test_sjpg_sjpg_areas(void)
+{
+
+}
+
+void test_sjpg_draw_scrolled(void)
+{
+
+}
+
+void test_sjpg_benchmark_viewport(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,313 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+#define HOR_RES 800
+#define VER_RES 480
+#define PROBE_STEP  7
+
+extern lv_color_t test_fb[];
+
+static lv_obj_t * cont;
+static uint32_t seed;
+
+void setUp(void)
+{
+    cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 300, 400);
+    lv_obj_enable_spatial_index(cont, true);
+    seed = 1;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+/*Deterministic random numbers not to depend on `lv_rand`'s state*/
+static int32_t rnd(int32_t min, int32_t max)
+{
+    seed = seed * 1103515245 + 12345;
+    return min + (int32_t)((seed >> 8) % (uint32_t)(max - min + 1));
+}
+
+static uint32_t render_hash(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    uint32_t hash = 2166136261u;
+    const uint8_t * p = (const uint8_t *)test_fb;
+    uint32_t i;
+    for(i = 0; i < HOR_RES * VER_RES * sizeof(lv_color_t); i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+typedef struct {
+    lv_obj_t * found[(HOR_RES / PROBE_STEP + 1) * (VER_RES / PROBE_STEP + 1)];
+    lv_coord_t scroll_bottom;
+    lv_coord_t scroll_right;
+    uint32_t hash;
+} probe_t;
+
+static void probe(probe_t * res)
+{
+    uint32_t i = 0;
+    lv_point_t p;
+    for(p.y = 0; p.y < VER_RES; p.y += PROBE_STEP) {
+        for(p.x = 0; p.x < HOR_RES; p.x += PROBE_STEP) {
+            res->found[i] = lv_indev_search_obj(lv_scr_act(), &p);
+            i++;
+        }
+    }
+    res->scroll_bottom = lv_obj_get_scroll_bottom(cont);
+    res->scroll_right = lv_obj_get_scroll_right(cont);
+    res->hash = render_hash();
+}
+
+/*Compare the results of the incrementally updated index with checking all the children*/
+static void check_index(void)
+{
+    static probe_t with_index;
+    static probe_t without_index;
+
+    lv_obj_update_layout(lv_scr_act());
+    probe(&with_index);
+    lv_obj_enable_spatial_index(cont, false);
+    probe(&without_index);
+    lv_obj_enable_spatial_index(cont, true);
+
+    TEST_ASSERT_EQUAL_PTR_ARRAY(without_index.found, with_index.found, sizeof(with_index.found) / sizeof(lv_obj_t *));
+    TEST_ASSERT_EQUAL(without_index.scroll_bottom, with_index.scroll_bottom);
+    TEST_ASSERT_EQUAL(without_index.scroll_right, with_index.scroll_right);
+    TEST_ASSERT_EQUAL_HEX32(without_index.hash, with_index.hash);
+}
+
+static lv_obj_t * row_create(lv_coord_t h)
+{
+    lv_obj_t * row = lv_btn_create(cont);
+    lv_obj_set_size(row, lv_pct(100), h);
+    lv_obj_t * label = lv_label_create(row);
+    lv_label_set_text_fmt(label, "Row %d", (int)lv_obj_get_index(row));
+    return row;
+}
+
+void test_spatial_index_enable(void)
+{
+#if LV_OBJ_SPATIAL_INDEX
+    TEST_ASSERT_TRUE(lv_obj_is_spatial_index_enabled(cont));
+    lv_obj_enable_spatial_index(cont, false);
+    TEST_ASSERT_FALSE(lv_obj_is_spatial_index_enabled(cont));
+#else
+    TEST_ASSERT_FALSE(lv_obj_is_spatial_index_enabled(cont));
+#endif
+}
+
+void test_spatial_index_list(void)
+{
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+    uint32_t i;
+    for(i = 0; i < 60; i++) row_create(30 + i % 3 * 5);
+    check_index();
+
+    lv_obj_scroll_to_y(cont, 700, LV_ANIM_OFF);
+    check_index();
+
+    /*Resize, hide and delete rows in the middle*/
+    lv_obj_set_height(lv_obj_get_child(cont, 25), 80);
+    lv_obj_add_flag(lv_obj_get_child(cont, 27), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_del(lv_obj_get_child(cont, 30));
+    check_index();
+
+    lv_obj_clear_flag(lv_obj_get_child(cont, 27), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_move_to_index(lv_obj_get_child(cont, 40), 24);
+    lv_obj_set_style_translate_x(lv_obj_get_child(cont, 26), 20, 0);
+    lv_obj_scroll_by(cont, 0, 133, LV_ANIM_OFF);
+    check_index();
+
+    /*The rows can be appended to the end while scrolled*/
+    for(i = 0; i < 10; i++) row_create(40);
+    lv_obj_scroll_to_y(cont, LV_COORD_MAX, LV_ANIM_OFF);
+    check_index();
+}
+
+void test_spatial_index_horizontal_list(void)
+{
+    lv_obj_set_size(cont, 400, 150);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW);
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        lv_obj_t * item = lv_btn_create(cont);
+        lv_obj_set_size(item, 50 + i % 4 * 10, lv_pct(80));
+    }
+    check_index();
+
+    lv_obj_scroll_to_x(cont, 900, LV_ANIM_OFF);
+    lv_obj_set_width(lv_obj_get_child(cont, 20), 120);
+    check_index();
+}
+
+void test_spatial_index_free_layout(void)
+{
+    lv_obj_set_size(cont, 600, 400);
+
+    /*Overlapping children with ext. click and draw size and children which can't be indexed*/
+    uint32_t i;
+    for(i = 0; i < 80; i++) {
+        lv_obj_t * obj = lv_obj_create(cont);
+        lv_obj_set_pos(obj, rnd(-20, 700), rnd(-20, 600));
+        lv_obj_set_size(obj, rnd(5, 120), rnd(5, 120));
+        if(i % 9 == 0) lv_obj_set_ext_click_area(obj, 10);
+        if(i % 11 == 0) lv_obj_set_style_shadow_width(obj, 20, 0);
+    }
+
+    lv_obj_t * floating = lv_obj_get_child(cont, 5);
+    lv_obj_add_flag(floating, LV_OBJ_FLAG_FLOATING);
+
+    lv_obj_t * overflow = lv_obj_get_child(cont, 7);
+    lv_obj_add_flag(overflow, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    lv_obj_t * out = lv_obj_create(overflow);
+    lv_obj_set_pos(out, 150, 150);
+
+    lv_obj_t * rotated = lv_obj_get_child(cont, 9);
+    lv_obj_set_style_transform_angle(rotated, 300, 0);
+    check_index();
+
+    lv_obj_scroll_to(cont, 40, 120, LV_ANIM_OFF);
+    check_index();
+
+    /*Move, resize, hide, reorder, add and delete random children*/
+    uint32_t round;
+    for(round = 0; round < 8; round++) {
+        for(i = 0; i < 10; i++) {
+            lv_obj_t * obj = lv_obj_get_child(cont, rnd(0, lv_obj_get_child_cnt(cont) - 1));
+            switch(rnd(0, 6)) {
+                case 0:
+                    lv_obj_set_pos(obj, rnd(-20, 700), rnd(-20, 600));
+                    break;
+                case 1:
+                    lv_obj_set_size(obj, rnd(5, 120), rnd(5, 120));
+                    break;
+                case 2:
+                    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+                    else lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+                    break;
+                case 3:
+                    lv_obj_move_to_index(obj, rnd(0, lv_obj_get_child_cnt(cont) - 1));
+                    break;
+                case 4:
+                    obj = lv_obj_create(cont);
+                    lv_obj_set_pos(obj, rnd(-20, 700), rnd(-20, 600));
+                    break;
+                case 5:
+                    if(obj != floating && obj != overflow && obj != rotated) lv_obj_del(obj);
+                    break;
+                case 6:
+                    lv_obj_set_style_outline_width(obj, rnd(0, 15), 0);
+                    break;
+            }
+        }
+        lv_obj_scroll_by(cont, rnd(-50, 50), rnd(-50, 50), LV_ANIM_OFF);
+        check_index();
+    }
+
+    lv_obj_set_style_transform_angle(rotated, 0, 0);
+    lv_obj_clear_flag(floating, LV_OBJ_FLAG_FLOATING);
+    check_index();
+}
+
+void test_spatial_index_reparent(void)
+{
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+    uint32_t i;
+    for(i = 0; i < 20; i++) row_create(30);
+
+    lv_obj_t * cont2 = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(cont2, 400, 0);
+    lv_obj_set_parent(lv_obj_get_child(cont, 3), cont2);
+    lv_obj_set_parent(lv_obj_get_child(cont2, 0), cont);
+    lv_obj_swap(lv_obj_get_child(cont, 1), lv_obj_get_child(cont, 10));
+    check_index();
+
+    lv_obj_clean(cont);
+    check_index();
+    row_create(30);
+    check_index();
+}
+
+/*Hit test, scroll range and redraw of a list with 10k rows with and without index*/
+void test_spatial_index_benchmark(void)
+{
+    const uint32_t row_cnt = 10000;
+    const uint32_t query_cnt = 1000;
+    const uint32_t frame_cnt = 30;
+
+    lv_obj_enable_spatial_index(cont, false);
+    lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_row(cont, 0, 0);
+
+    static lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_bg_color(&style, lv_palette_main(LV_PALETTE_BLUE));
+    lv_style_set_bg_opa(&style, LV_OPA_COVER);
+    lv_style_set_border_width(&style, 1);
+    lv_style_set_height(&style, 24);
+    lv_style_set_width(&style, lv_pct(100));
+
+    uint32_t i;
+    for(i = 0; i < row_cnt; i++) {
+        lv_obj_t * row = lv_obj_create(cont);
+        lv_obj_remove_style_all(row);
+        lv_obj_add_style(row, &style, 0);
+    }
+    lv_obj_update_layout(cont);
+    lv_obj_scroll_to_y(cont, 24 * row_cnt / 2, LV_ANIM_OFF);
+
+    uint64_t t_hit[2];
+    uint64_t t_scroll[2];
+    uint64_t t_draw[2];
+    lv_obj_t * found[2] = {NULL, NULL};
+    uint32_t r;
+    for(r = 0; r < 2; r++) {
+        lv_obj_enable_spatial_index(cont, r == 1);
+
+        seed = 1;
+        uint64_t t_start = lv_test_get_time_us();
+        for(i = 0; i < query_cnt; i++) {
+            lv_point_t p = {rnd(0, HOR_RES - 1), rnd(0, VER_RES - 1)};
+            lv_obj_t * obj = lv_indev_search_obj(lv_scr_act(), &p);
+            if(i == query_cnt / 2) found[r] = obj;
+        }
+        t_hit[r] = lv_test_get_time_us() - t_start;
+
+        t_start = lv_test_get_time_us();
+        volatile lv_coord_t sink = 0;
+        for(i = 0; i < query_cnt; i++) sink += lv_obj_get_scroll_bottom(cont);
+        t_scroll[r] = lv_test_get_time_us() - t_start;
+
+        t_start = lv_test_get_time_us();
+        for(i = 0; i < frame_cnt; i++) {
+            lv_obj_scroll_by(cont, 0, i % 2 ? 7 : -7, LV_ANIM_OFF);
+            lv_obj_invalidate(cont);
+            lv_refr_now(NULL);
+        }
+        t_draw[r] = lv_test_get_time_us() - t_start;
+    }
+
+    TEST_ASSERT_NOT_NULL(found[0]);
+    TEST_ASSERT_EQUAL_PTR(found[0], found[1]);
+
+    printf("%u rows, without / with spatial index:\n", (unsigned)row_cnt);
+    printf("  hit test:      %8.2f / %8.2f us\n", (double)t_hit[0] / query_cnt, (double)t_hit[1] / query_cnt);
+    printf("  scroll bottom: %8.2f / %8.2f us\n", (double)t_scroll[0] / query_cnt, (double)t_scroll[1] / query_cnt);
+    printf("  scroll+redraw: %8.2f / %8.2f ms/frame\n", (double)t_draw[0] / frame_cnt / 1000,
+           (double)t_draw[1] / frame_cnt / 1000);
+}
+
+#endif
@@ -2,7 +2,9 @@
 #include "../lvgl.h"
 
 #include "unity/unity.h"
+#include "lv_test_helpers.h"
 #include <unistd.h>
+#include <stdio.h>
 
 static void obj_set_height_helper(void * obj, int32_t height)
 {
@@ -106,4 +108,150 @@ void test_inherit_meta_with_lower_precedence_style(void)
     TEST_ASSERT_EQUAL_HEX(lv_color_hex(0xff0000).full, lv_obj_get_style_text_color(grandchild, LV_PART_MAIN).full);
 }
 
+/*Add the props in reverse order to have a fully unsorted style*/
+static void style_set_many_props(lv_style_t * style, uint32_t prop_cnt)
+{
+    uint32_t i;
+    for(i = prop_cnt; i > 0; i--) {
+        lv_style_value_t v = {.num = (int32_t)i * 10};
+        lv_style_set_prop(style, (lv_style_prop_t)(i * 3), v);
+    }
+}
+
+void test_style_freeze_keeps_the_values(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    style_set_many_props(&style, 30);
+    lv_style_set_prop_meta(&style, LV_STYLE_WIDTH, LV_STYLE_PROP_META_INHERIT);
+
+    lv_style_freeze(&style);
+    TEST_ASSERT_EQUAL(_LV_STYLE_PROP_FROZEN, style.prop1);
+
+    uint32_t i;
+    lv_style_value_t v;
+    for(i = 1; i <= 30; i++) {
+        TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, (lv_style_prop_t)(i * 3), &v));
+        TEST_ASSERT_EQUAL(i * 10, v.num);
+        TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, (lv_style_prop_t)(i * 3 + 1), &v));
+    }
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_INHERIT, lv_style_get_prop(&style, LV_STYLE_WIDTH, &v));
+
+    lv_style_reset(&style);
+}
+
+void test_style_freeze_allows_modifications(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    style_set_many_props(&style, 10);
+    lv_style_freeze(&style);
+
+    lv_style_value_t v;
+    /*Overwrite an existing prop*/
+    lv_style_set_prop(&style, 9, (lv_style_value_t) {
+        .num = 1234
+    });
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, 9, &v));
+    TEST_ASSERT_EQUAL(1234, v.num);
+
+    /*Add new props to the beginning, middle and end*/
+    lv_style_set_prop(&style, 1, (lv_style_value_t) {
+        .num = 1
+    });
+    lv_style_set_prop(&style, 16, (lv_style_value_t) {
+        .num = 16
+    });
+    lv_style_set_prop(&style, 100, (lv_style_value_t) {
+        .num = 100
+    });
+    TEST_ASSERT_EQUAL(_LV_STYLE_PROP_FROZEN, style.prop1);
+    TEST_ASSERT_EQUAL(13, style.prop_cnt);
+
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, 1, &v));
+    TEST_ASSERT_EQUAL(1, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, 16, &v));
+    TEST_ASSERT_EQUAL(16, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, 100, &v));
+    TEST_ASSERT_EQUAL(100, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, 30, &v));
+    TEST_ASSERT_EQUAL(100, v.num);
+
+    /*Remove props*/
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, 16));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, 16, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, 18, &v));
+    TEST_ASSERT_EQUAL(60, v.num);
+
+    lv_style_reset(&style);
+    TEST_ASSERT_EQUAL(0, style.prop_cnt);
+    TEST_ASSERT_NOT_EQUAL(_LV_STYLE_PROP_FROZEN, style.prop1);
+}
+
+void test_style_freeze_on_objects(void)
+{
+    static lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_bg_color(&style, lv_color_hex(0x00ff00));
+    lv_style_set_radius(&style, 5);
+    lv_style_set_text_color(&style, lv_color_hex(0x0000ff));
+    lv_style_set_width(&style, 50);
+    lv_style_freeze(&style);
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_add_style(obj, &style, 0);
+    lv_obj_t * label = lv_label_create(obj);
+    lv_obj_update_layout(obj);
+    TEST_ASSERT_EQUAL_HEX(lv_color_hex(0x00ff00).full, lv_obj_get_style_bg_color(obj, LV_PART_MAIN).full);
+    TEST_ASSERT_EQUAL(5, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(50, lv_obj_get_width(obj));
+    TEST_ASSERT_EQUAL_HEX(lv_color_hex(0x0000ff).full, lv_obj_get_style_text_color(label, LV_PART_MAIN).full);
+
+    lv_obj_del(obj);
+    lv_style_reset(&style);
+}
+
+void test_style_freeze_benchmark(void)
+{
+    const uint32_t prop_cnt = 24;   /*Similar to the larger styles of the default theme*/
+    const uint32_t rounds = 20000;
+    lv_style_t style;
+    lv_style_init(&style);
+    style_set_many_props(&style, prop_cnt);
+
+    uint32_t f;
+    uint64_t t_hit[2];
+    uint64_t t_miss[2];
+    volatile int32_t sink = 0;
+    for(f = 0; f < 2; f++) {
+        if(f == 1) lv_style_freeze(&style);
+
+        uint32_t i, j;
+        lv_style_value_t v;
+        uint64_t t_start = lv_test_get_time_us();
+        for(i = 0; i < rounds; i++) {
+            for(j = 1; j <= prop_cnt; j++) {
+                if(lv_style_get_prop(&style, (lv_style_prop_t)(j * 3), &v) == LV_STYLE_RES_FOUND) sink += v.num;
+            }
+        }
+        t_hit[f] = lv_test_get_time_us() - t_start;
+
+        t_start = lv_test_get_time_us();
+        for(i = 0; i < rounds; i++) {
+            for(j = 1; j <= prop_cnt; j++) {
+                if(lv_style_get_prop(&style, (lv_style_prop_t)(j * 3 + 1), &v) == LV_STYLE_RES_FOUND) sink += v.num;
+            }
+        }
+        t_miss[f] = lv_test_get_time_us() - t_start;
+    }
+    LV_UNUSED(sink);
+
+    lv_style_reset(&style);
+
+    double n = (double)rounds * prop_cnt;
+    printf("style with %u props: hit %.1f -> %.1f ns, miss %.1f -> %.1f ns (linear -> frozen)\n", (unsigned)prop_cnt,
+           (double)t_hit[0] * 1000.0 / n, (double)t_hit[1] * 1000.0 / n,
+           (double)t_miss[0] * 1000.0 / n, (double)t_miss[1] * 1000.0 / n);
+}
+
 #endif
@@ -0,0 +1,238 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+static lv_style_t style_btn;
+static lv_style_t style_pr;
+
+void setUp(void)
+{
+    lv_style_init(&style_btn);
+    lv_style_set_bg_color(&style_btn, lv_color_hex(0x2196F3));
+    lv_style_set_radius(&style_btn, 8);
+    lv_style_set_text_color(&style_btn, lv_color_hex(0xffffff));
+
+    lv_style_init(&style_pr);
+    lv_style_set_bg_color(&style_pr, lv_color_hex(0xff0000));
+    lv_style_set_text_color(&style_pr, lv_color_hex(0x00ff00));
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_style_reset(&style_btn);
+    lv_style_reset(&style_pr);
+}
+
+void test_style_cache_follows_local_style_changes(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_radius(obj, 3, 0);
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    lv_obj_set_style_radius(obj, 7, 0);
+    TEST_ASSERT_EQUAL(7, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    lv_obj_set_style_radius(obj, 9, LV_PART_SCROLLBAR);
+    TEST_ASSERT_EQUAL(7, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(9, lv_obj_get_style_radius(obj, LV_PART_SCROLLBAR));
+
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_RADIUS, 0);
+    TEST_ASSERT_NOT_EQUAL(7, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+}
+
+void test_style_cache_follows_shared_style_changes(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style_btn, 0);
+    TEST_ASSERT_EQUAL(8, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    /*Modify the style without notifying the objects*/
+    lv_style_set_radius(&style_btn, 12);
+    TEST_ASSERT_EQUAL(12, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    lv_style_remove_prop(&style_btn, LV_STYLE_RADIUS);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+
+    lv_obj_remove_style(obj, &style_btn, 0);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_white(), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+}
+
+void test_style_cache_follows_state_changes(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style_btn, 0);
+    lv_obj_add_style(obj, &style_pr, LV_STATE_PRESSED);
+    lv_obj_t * label = lv_label_create(obj);
+
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x2196F3), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xffffff), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    /*The inherited value depends on the parent's state too*/
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x2196F3), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xffffff), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+}
+
+void test_style_cache_follows_parent_changes(void)
+{
+    lv_obj_t * parent1 = lv_obj_create(lv_scr_act());
+    lv_obj_t * parent2 = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0x112233), 0);
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x445566), 0);
+
+    lv_obj_t * label = lv_label_create(parent1);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x112233), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+
+    lv_obj_set_parent(label, parent2);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x445566), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+}
+
+void test_style_cache_is_not_reused_by_new_objects(void)
+{
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_scr_act());
+        TEST_ASSERT_EQUAL(0, lv_obj_get_style_translate_x(obj, LV_PART_MAIN));
+        lv_obj_set_style_translate_x(obj, i + 1, 0);
+        TEST_ASSERT_EQUAL(i + 1, lv_obj_get_style_translate_x(obj, LV_PART_MAIN));
+        lv_obj_del(obj);
+    }
+}
+
+void test_style_cache_with_transitions(void)
+{
+    static const lv_style_prop_t props[] = {LV_STYLE_BG_COLOR, 0};
+    static lv_style_transition_dsc_t tr;
+    lv_style_transition_dsc_init(&tr, props, lv_anim_path_linear, 100, 0, NULL);
+    lv_style_set_transition(&style_pr, &tr);
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style_btn, 0);
+    lv_obj_add_style(obj, &style_pr, LV_STATE_PRESSED);
+
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    /*The transition starts from the released color*/
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x2196F3), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_tick_inc(10);
+        lv_timer_handler();
+    }
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+}
+
+/*Similar to the home screen of the tablet: a status bar and a grid of app buttons with icons and labels*/
+static lv_obj_t * create_home_screen_like(lv_obj_t * parent, uint32_t btn_cnt)
+{
+    lv_obj_t * cont = lv_obj_create(parent);
+    lv_obj_set_size(cont, 320, 240);
+    lv_obj_set_style_bg_color(cont, lv_color_hex(0x121212), 0);
+    lv_obj_set_style_pad_all(cont, 0, 0);
+
+    lv_obj_t * status_bar = lv_obj_create(cont);
+    lv_obj_set_size(status_bar, lv_pct(100), 25);
+    lv_obj_set_style_radius(status_bar, 0, 0);
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_t * label = lv_label_create(status_bar);
+        lv_label_set_text(label, LV_SYMBOL_WIFI " WiFi");
+        lv_obj_align(label, LV_ALIGN_LEFT_MID, i * 100, 0);
+    }
+
+    for(i = 0; i < btn_cnt; i++) {
+        lv_obj_t * btn = lv_btn_create(cont);
+        lv_obj_add_style(btn, &style_btn, 0);
+        lv_obj_add_style(btn, &style_pr, LV_STATE_PRESSED);
+        lv_obj_set_size(btn, 140, 80);
+        lv_obj_set_style_radius(btn, 15, 0);
+        lv_obj_set_pos(btn, 10 + (i % 2) * 160, 30 + (i / 2) * 100);
+
+        lv_obj_t * icon = lv_label_create(btn);
+        lv_label_set_text(icon, LV_SYMBOL_DIRECTORY);
+        lv_obj_align(icon, LV_ALIGN_CENTER, 0, -10);
+
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text(label, "Files");
+        lv_obj_align(label, LV_ALIGN_CENTER, 0, 15);
+    }
+
+    return cont;
+}
+
+void test_style_cache_benchmark_lookups(void)
+{
+    static const lv_style_prop_t props[] = {
+        LV_STYLE_BG_COLOR, LV_STYLE_BG_OPA, LV_STYLE_BG_GRAD_DIR, LV_STYLE_RADIUS, LV_STYLE_BORDER_WIDTH,
+        LV_STYLE_BORDER_OPA, LV_STYLE_OUTLINE_WIDTH, LV_STYLE_SHADOW_WIDTH, LV_STYLE_SHADOW_OPA, LV_STYLE_PAD_TOP,
+        LV_STYLE_PAD_LEFT, LV_STYLE_TEXT_COLOR, LV_STYLE_TEXT_FONT, LV_STYLE_TEXT_OPA, LV_STYLE_OPA, LV_STYLE_BLEND_MODE,
+    };
+    const uint32_t prop_cnt = sizeof(props) / sizeof(props[0]);
+
+    lv_obj_t * cont = create_home_screen_like(lv_scr_act(), 4);
+    lv_obj_t * label = lv_obj_get_child(lv_obj_get_child(cont, 1), 1);
+
+    const uint32_t rounds = 20000;
+    uint32_t i, j;
+    volatile int32_t sink = 0;
+
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < rounds; i++) {
+        _lv_style_cache_invalidate();
+        for(j = 0; j < prop_cnt; j++) sink += lv_obj_get_style_prop(label, LV_PART_MAIN, props[j]).num;
+    }
+    uint64_t t_miss = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < rounds; i++) {
+        for(j = 0; j < prop_cnt; j++) sink += lv_obj_get_style_prop(label, LV_PART_MAIN, props[j]).num;
+    }
+    uint64_t t_hit = lv_test_get_time_us() - t_start;
+    LV_UNUSED(sink);
+
+    printf("style lookup of a label in a button: %.1f ns/lookup invalidated, %.1f ns/lookup repeated\n",
+           (double)t_miss * 1000.0 / (rounds * prop_cnt), (double)t_hit * 1000.0 / (rounds * prop_cnt));
+}
+
+void test_style_cache_benchmark_redraw(void)
+{
+    lv_obj_t * cont = create_home_screen_like(lv_scr_act(), 8);
+    lv_refr_now(NULL);
+
+    const uint32_t frames = 50;
+    uint32_t i;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < frames; i++) {
+        lv_obj_invalidate(cont);
+        lv_refr_now(NULL);
+    }
+    uint64_t t_full = lv_test_get_time_us() - t_start;
+
+    /*Press/release a button on every frame: it invalidates the cache*/
+    lv_obj_t * btn = lv_obj_get_child(cont, 1);
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < frames; i++) {
+        if(i & 1) lv_obj_clear_state(btn, LV_STATE_PRESSED);
+        else lv_obj_add_state(btn, LV_STATE_PRESSED);
+        lv_obj_invalidate(cont);
+        lv_refr_now(NULL);
+    }
+    uint64_t t_state = lv_test_get_time_us() - t_start;
+
+    printf("home screen like redraw: %.1f us/frame static, %.1f us/frame with state changes\n",
+           (double)t_full / frames, (double)t_state / frames);
+}
+
+#endif
@@ -0,0 +1,265 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HOR_RES 800
+#define VER_RES 480
+#define DOC_SIZE (20 * 1024)
+#define SAVE_FILE "src/test_files/textarea_save.txt"
+
+static lv_obj_t * ta;
+static char * ref;      /*The expected text*/
+static uint32_t seed;
+static lv_color_t screen[HOR_RES * VER_RES];
+
+/*The test display copies only full screen refreshes to its frame buffer.
+ *Copy the redrawn areas to their place to see the result of partial refreshes too.*/
+static void screen_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&screen[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(disp_drv);
+}
+
+static uint32_t rnd(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+static void ref_ins(uint32_t pos, const char * txt)
+{
+    size_t len = strlen(ref);
+    size_t ins_len = strlen(txt);
+    memmove(&ref[pos + ins_len], &ref[pos], len - pos + 1);
+    memcpy(&ref[pos], txt, ins_len);
+}
+
+static void ref_cut(uint32_t pos, uint32_t cnt)
+{
+    size_t len = strlen(ref);
+    memmove(&ref[pos], &ref[pos + cnt], len - pos - cnt + 1);
+}
+
+static uint32_t render_hash(void)
+{
+    lv_refr_now(NULL);
+
+    uint32_t hash = 2166136261u;
+    const uint8_t * p = (const uint8_t *)screen;
+    uint32_t i;
+    for(i = 0; i < HOR_RES * VER_RES * sizeof(lv_color_t); i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/*The cached lines of the edited text should be the same as the lines of the text wrapped again*/
+static void check_lines(void)
+{
+    lv_obj_update_layout(ta);
+    lv_label_t * label = (lv_label_t *)lv_textarea_get_label(ta);
+    TEST_ASSERT_EQUAL_STRING(ref, label->text);
+    TEST_ASSERT_NOT_NULL(label->lines);
+    TEST_ASSERT_EQUAL(lv_obj_get_content_width(&label->obj), label->lines_max_w);
+
+    uint32_t line_start = 0;
+    uint32_t i = 0;
+    lv_coord_t w = 0;
+    while(ref[line_start] != '\0') {
+        uint32_t line_end = line_start + _lv_txt_get_next_line(&ref[line_start], label->lines_font,
+                                                               label->lines_letter_space, label->lines_max_w,
+                                                               NULL, label->lines_flag);
+        TEST_ASSERT_LESS_THAN(label->line_cnt, i);
+        TEST_ASSERT_EQUAL(line_start, label->lines[i].start);
+        TEST_ASSERT_EQUAL(lv_txt_get_width(&ref[line_start], line_end - line_start, label->lines_font,
+                                           label->lines_letter_space, label->lines_flag), label->lines[i].w);
+        w = LV_MAX(w, label->lines[i].w);
+        line_start = line_end;
+        i++;
+    }
+    TEST_ASSERT_EQUAL(i, label->line_cnt);
+    TEST_ASSERT_EQUAL(strlen(ref), label->lines[i].start);
+    TEST_ASSERT_EQUAL(w, label->lines_w);
+}
+
+/*Type, delete and paste at random places*/
+static void random_edits(uint32_t cnt, bool draw)
+{
+    static const char * pastes[] = {"\n", "wifi_ssid = home\n", "Averyveryveryveryveryveryveryveryverylongword ", " # comment"};
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        uint32_t len = strlen(ref);
+        /*Stay around the same place for a while like when typing*/
+        if(i % 20 == 0) {
+            /*Edit the visible lines when the result is drawn*/
+            uint32_t range = draw ? LV_MIN(len, 400) : len;
+            lv_textarea_set_cursor_pos(ta, rnd() % (range + 1));
+        }
+        uint32_t pos = lv_textarea_get_cursor_pos(ta);
+
+        uint32_t op = rnd() % 10;
+        if(op < 5) {
+            char c = (rnd() % 8) == 0 ? ' ' : 'a' + rnd() % 26;
+            lv_textarea_add_char(ta, c);
+            char buf[2] = {c, '\0'};
+            ref_ins(pos, buf);
+        }
+        else if(op < 7) {
+            const char * txt = pastes[rnd() % 4];
+            lv_textarea_add_text(ta, txt);
+            ref_ins(pos, txt);
+        }
+        else if(op < 9) {
+            lv_textarea_del_char(ta);
+            if(pos > 0) ref_cut(pos - 1, 1);
+        }
+        else {
+            lv_textarea_del_char_forward(ta);
+            if(pos < len) ref_cut(pos, 1);
+        }
+
+        TEST_ASSERT_EQUAL_STRING(ref, lv_textarea_get_text(ta));
+        if(i % 50 == 0) check_lines();
+
+        /*Only the edited lines are redrawn. It should look the same as redrawing everything.*/
+        if(draw && i % 10 == 0) {
+            uint32_t hash = render_hash();
+            lv_obj_invalidate(lv_scr_act());
+            TEST_ASSERT_EQUAL_HEX32(render_hash(), hash);
+        }
+    }
+    check_lines();
+}
+
+void setUp(void)
+{
+    /*A config file with some long lines which are wrapped*/
+    ref = lv_mem_alloc(DOC_SIZE * 3);
+    uint32_t len = 0;
+    uint32_t i = 0;
+    while(len < DOC_SIZE - 200) {
+        if(i % 7 == 6) {
+            len += lv_snprintf(&ref[len], 200, "# Section %d: the values below are read on startup, "
+                               "the changes are applied after restarting the device\n", (int)i);
+        }
+        else {
+            len += lv_snprintf(&ref[len], 200, "option_%d = %d\n", (int)i, (int)(i * 7919));
+        }
+        i++;
+    }
+
+    ta = lv_textarea_create(lv_scr_act());
+    lv_obj_set_size(ta, 400, 300);
+    lv_textarea_set_text(ta, ref);
+    lv_textarea_set_cursor_pos(ta, 0);
+    seed = 1;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_mem_free(ref);
+}
+
+void test_textarea_edit_random(void)
+{
+    check_lines();
+    random_edits(2000, false);
+
+    /*Edit with wider and narrower lines*/
+    lv_obj_set_width(ta, 250);
+    random_edits(500, false);
+#if LV_FONT_MONTSERRAT_18
+    lv_obj_set_style_text_font(ta, &lv_font_montserrat_18, 0);
+#endif
+    lv_obj_set_style_text_letter_space(ta, 2, 0);
+    random_edits(500, false);
+}
+
+void test_textarea_edit_draw(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    void (*flush_cb)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = drv->flush_cb;
+    drv->flush_cb = screen_flush_cb;
+
+    lv_obj_set_style_text_align(ta, LV_TEXT_ALIGN_CENTER, 0);
+    random_edits(300, true);
+
+    lv_obj_set_style_text_align(ta, LV_TEXT_ALIGN_LEFT, 0);
+    lv_obj_set_style_text_line_space(ta, -3, 0);
+    random_edits(300, true);
+
+    drv->flush_cb = flush_cb;
+}
+
+void test_textarea_edit_save(void)
+{
+    lv_textarea_add_text(ta, "wifi_ssid = home\n");
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_textarea_save(ta, "C:" SAVE_FILE));
+
+    FILE * f = fopen(SAVE_FILE, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    char * buf = malloc(DOC_SIZE * 2);
+    size_t len = fread(buf, 1, DOC_SIZE * 2, f);
+    fclose(f);
+    TEST_ASSERT_EQUAL(strlen(lv_textarea_get_text(ta)), len);
+    TEST_ASSERT_EQUAL_MEMORY(lv_textarea_get_text(ta), buf, len);
+
+    /*A shorter text replaces the whole file*/
+    lv_textarea_set_text(ta, "option_1 = 1\n");
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_textarea_save(ta, "C:" SAVE_FILE));
+
+    f = fopen(SAVE_FILE, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    len = fread(buf, 1, DOC_SIZE * 2, f);
+    fclose(f);
+    buf[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("option_1 = 1\n", buf);
+
+    free(buf);
+    remove(SAVE_FILE);
+}
+
+/*Type 10k characters into the middle of a 20 kB document*/
+void test_textarea_edit_benchmark(void)
+{
+    const uint32_t char_cnt = 10000;
+    const uint32_t chars_per_frame = 10;
+
+    lv_textarea_set_cursor_pos(ta, DOC_SIZE / 2);
+    lv_refr_now(NULL);
+
+    uint64_t t_type = 0;
+    uint64_t t_draw = 0;
+    uint32_t i;
+    for(i = 0; i < char_cnt; i++) {
+        uint64_t t_start = lv_test_get_time_us();
+        lv_textarea_add_char(ta, (i % 40) == 39 ? '\n' : (i % 6) == 5 ? ' ' : 'a' + i % 26);
+        t_type += lv_test_get_time_us() - t_start;
+
+        if(i % chars_per_frame == chars_per_frame - 1) {
+            t_start = lv_test_get_time_us();
+            lv_refr_now(NULL);
+            t_draw += lv_test_get_time_us() - t_start;
+        }
+    }
+
+    uint32_t len = strlen(lv_textarea_get_text(ta));
+    TEST_ASSERT_GREATER_OR_EQUAL(DOC_SIZE - 200 + char_cnt, len);
+
+    printf("Typing %d characters into a %d kB text:\n", (int)char_cnt, DOC_SIZE / 1024);
+    printf("  add_char: %8.2f us/char\n", (double)t_type / char_cnt);
+    printf("  redraw:   %8.2f ms/frame (%d characters per frame)\n",
+           (double)t_draw / (char_cnt / chars_per_frame) / 1000, (int)chars_per_frame);
+}
+
+#endif
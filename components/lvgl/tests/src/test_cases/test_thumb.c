@@ -0,0 +1,523 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/extra/libs/sjpg/tjpgd.h"
+#include "../src/extra/libs/png/lodepng.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if LV_USE_THUMB && LV_USE_SJPG && LV_USE_PNG
+
+#define THUMB_SIZE  40
+#define GALLERY     "src/test_files/gallery"
+#define PACK_PATH   "A:" GALLERY "/.thumbs"
+
+extern lv_color_t test_fb[];
+
+typedef struct {
+    const uint8_t * data;
+    uint32_t size;
+    uint32_t pos;
+    uint8_t * out;
+    uint32_t w;
+} ref_io_t;
+
+static uint8_t * load_file(const char * path, uint32_t * size)
+{
+    FILE * f = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    fseek(f, 0, SEEK_END);
+    *size = (uint32_t)ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t * data = malloc(*size);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_EQUAL(*size, fread(data, 1, *size, f));
+    fclose(f);
+    return data;
+}
+
+static size_t ref_in(JDEC * jd, uint8_t * buf, size_t n)
+{
+    ref_io_t * io = jd->device;
+    if(n > io->size - io->pos) n = io->size - io->pos;
+    if(buf) memcpy(buf, io->data + io->pos, n);
+    io->pos += n;
+    return n;
+}
+
+static int ref_out(JDEC * jd, void * data, JRECT * rect)
+{
+    ref_io_t * io = jd->device;
+    uint32_t w = (rect->right - rect->left + 1) * 3;
+    uint32_t y;
+    for(y = rect->top; y <= rect->bottom; y++) {
+        memcpy(io->out + (y * io->w + rect->left) * 3, (uint8_t *)data + (y - rect->top) * w, w);
+    }
+    return 1;
+}
+
+/*Decode a JPG in full size as RGB888*/
+static uint8_t * ref_decode_jpg(const char * path, uint32_t * w, uint32_t * h)
+{
+    uint32_t size;
+    uint8_t * data = load_file(path, &size);
+    JDEC jd;
+    ref_io_t io = {data, size, 0, NULL, 0};
+    void * work = malloc(4096);
+    TEST_ASSERT_EQUAL(JDR_OK, jd_prepare(&jd, ref_in, work, 4096, &io));
+    io.w = jd.width;
+    io.out = malloc(jd.width * jd.height * 3);
+    TEST_ASSERT_EQUAL(JDR_OK, jd_decomp(&jd, ref_out, 0));
+    *w = jd.width;
+    *h = jd.height;
+    free(work);
+    free(data);
+    return io.out;
+}
+
+/*Decode a PNG as RGB888 blended on black*/
+static uint8_t * ref_decode_png(const char * path, uint32_t * w, uint32_t * h)
+{
+    uint32_t size;
+    uint8_t * data = load_file(path, &size);
+    uint8_t * rgba;
+    TEST_ASSERT_EQUAL(0, lodepng_decode32(&rgba, w, h, data, size));
+    uint8_t * out = malloc(*w * *h * 3);
+    uint32_t i;
+    for(i = 0; i < *w * *h; i++) {
+        out[i * 3 + 0] = rgba[i * 4 + 0] * rgba[i * 4 + 3] / 255;
+        out[i * 3 + 1] = rgba[i * 4 + 1] * rgba[i * 4 + 3] / 255;
+        out[i * 3 + 2] = rgba[i * 4 + 2] * rgba[i * 4 + 3] / 255;
+    }
+    lv_mem_free(rgba);
+    free(data);
+    return out;
+}
+
+/*Read a bottom-up 24 bit BMP as RGB888*/
+static uint8_t * ref_decode_bmp(const char * path, uint32_t * w, uint32_t * h)
+{
+    uint32_t size;
+    uint8_t * data = load_file(path, &size);
+    TEST_ASSERT_EQUAL(24, data[28]);
+    uint32_t ofs = data[10] | (data[11] << 8);
+    *w = data[18] | (data[19] << 8);
+    *h = data[22] | (data[23] << 8);
+    uint32_t row_size = (*w * 3 + 3) & ~3;
+    uint8_t * out = malloc(*w * *h * 3);
+    uint32_t x, y;
+    for(y = 0; y < *h; y++) {
+        const uint8_t * src = data + ofs + (*h - 1 - y) * row_size;
+        for(x = 0; x < *w; x++) {
+            out[(y * *w + x) * 3 + 0] = src[x * 3 + 2];
+            out[(y * *w + x) * 3 + 1] = src[x * 3 + 1];
+            out[(y * *w + x) * 3 + 2] = src[x * 3 + 0];
+        }
+    }
+    free(data);
+    return out;
+}
+
+/*Average the RGB888 pixels in the boxes of the thumbnail pixels*/
+static uint16_t * ref_box_filter(const uint8_t * px, uint32_t w, uint32_t h, uint32_t tw, uint32_t th)
+{
+    uint32_t * acc = calloc(tw * th * 4, sizeof(uint32_t));
+    uint32_t x, y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            uint32_t * a = &acc[((y * th / h) * tw + x * tw / w) * 4];
+            a[0] += px[(y * w + x) * 3 + 0];
+            a[1] += px[(y * w + x) * 3 + 1];
+            a[2] += px[(y * w + x) * 3 + 2];
+            a[3]++;
+        }
+    }
+
+    uint16_t * out = malloc(tw * th * sizeof(uint16_t));
+    uint32_t i;
+    for(i = 0; i < tw * th; i++) {
+        uint32_t * a = &acc[i * 4];
+        uint32_t r = (a[0] + a[3] / 2) / a[3];
+        uint32_t g = (a[1] + a[3] / 2) / a[3];
+        uint32_t b = (a[2] + a[3] / 2) / a[3];
+        out[i] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+    free(acc);
+    return out;
+}
+
+/*Mean absolute difference of the 8 bit channels*/
+static uint32_t rgb565_diff(const uint16_t * a, const uint16_t * b, uint32_t px_cnt)
+{
+    uint64_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        sum += LV_ABS((a[i] >> 11) - (b[i] >> 11)) << 3;
+        sum += LV_ABS(((a[i] >> 5) & 0x3F) - ((b[i] >> 5) & 0x3F)) << 2;
+        sum += LV_ABS((a[i] & 0x1F) - (b[i] & 0x1F)) << 3;
+    }
+    return (uint32_t)(sum / (px_cnt * 3));
+}
+
+/*List the supported images of the gallery*/
+static uint32_t gallery_list(char names[][64], uint32_t max_cnt)
+{
+    lv_fs_dir_t dir;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_dir_open(&dir, "A:" GALLERY));
+    uint32_t cnt = 0;
+    char fn[256];
+    while(lv_fs_dir_read(&dir, fn) == LV_FS_RES_OK && fn[0] != '\0') {
+        if(fn[0] == '.' || fn[0] == '/') continue;
+        if(!lv_thumb_is_supported(fn)) continue;
+        TEST_ASSERT_LESS_THAN(max_cnt, cnt);
+        lv_snprintf(names[cnt], 64, "%s", fn);
+        cnt++;
+    }
+    lv_fs_dir_close(&dir);
+    return cnt;
+}
+
+static uint32_t file_size(const char * name)
+{
+    char path[128];
+    lv_snprintf(path, sizeof(path), GALLERY "/%s", name);
+    FILE * f = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    fseek(f, 0, SEEK_END);
+    uint32_t size = (uint32_t)ftell(f);
+    fclose(f);
+    return size;
+}
+
+void setUp(void)
+{
+    remove(GALLERY "/.thumbs");
+}
+
+void tearDown(void)
+{
+    remove(GALLERY "/.thumbs");
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_thumb_supported_files(void)
+{
+    TEST_ASSERT_TRUE(lv_thumb_is_supported("A:dir/a.jpg"));
+    TEST_ASSERT_TRUE(lv_thumb_is_supported("photo.JPEG"));
+    TEST_ASSERT_TRUE(lv_thumb_is_supported("clip.mjpeg"));
+    TEST_ASSERT_TRUE(lv_thumb_is_supported("logo.png"));
+    TEST_ASSERT_TRUE(lv_thumb_is_supported("banner.Bmp"));
+    TEST_ASSERT_FALSE(lv_thumb_is_supported("notes.txt"));
+    TEST_ASSERT_FALSE(lv_thumb_is_supported("anim.gif"));
+    TEST_ASSERT_FALSE(lv_thumb_is_supported("jpg"));
+
+    char names[16][64];
+    TEST_ASSERT_EQUAL(6, gallery_list(names, 16));
+}
+
+void test_thumb_bmp_png_exact(void)
+{
+    const char * names[] = {"banner.bmp", "logo.png"};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        char path[128];
+        char lv_path[128];
+        lv_snprintf(path, sizeof(path), GALLERY "/%s", names[i]);
+        lv_snprintf(lv_path, sizeof(lv_path), "A:%s", path);
+
+        uint32_t w, h;
+        uint8_t * px = i == 0 ? ref_decode_bmp(path, &w, &h) : ref_decode_png(path, &w, &h);
+
+        lv_thumb_gen_t gen;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_generate(&gen, lv_path, THUMB_SIZE));
+        TEST_ASSERT_EQUAL(THUMB_SIZE, LV_MAX(gen.w, gen.h));
+        TEST_ASSERT_EQUAL((LV_MIN(w, h) * THUMB_SIZE + LV_MAX(w, h) / 2) / LV_MAX(w, h), LV_MIN(gen.w, gen.h));
+
+        uint16_t * ref = ref_box_filter(px, w, h, gen.w, gen.h);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(ref, gen.buf, gen.w * gen.h);
+
+        free(ref);
+        free(px);
+        lv_thumb_gen_end(&gen);
+    }
+}
+
+void test_thumb_jpg_scaled(void)
+{
+    /*TJpgDec scales down the JPGs and the boxes of the filter don't cover the same source pixels
+     *(e.g. 75 -> 40 instead of 300 -> 40 columns) so compare only the averages with the full size reference*/
+    const char * names[] = {"beach.jpg", "tower.jpg", "gray.jpg"};
+    const uint32_t min_steps[] = {960 / 16, 720 / 8, 200 / 8};
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        char path[128];
+        char lv_path[128];
+        lv_snprintf(path, sizeof(path), GALLERY "/%s", names[i]);
+        lv_snprintf(lv_path, sizeof(lv_path), "A:%s", path);
+
+        uint32_t w, h;
+        uint8_t * px = ref_decode_jpg(path, &w, &h);
+
+        /*One MCU row in a step*/
+        lv_thumb_gen_t gen;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_gen_start(&gen, lv_path, THUMB_SIZE));
+        uint32_t steps = 0;
+        while(!gen.done) {
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_gen_step(&gen));
+            steps++;
+        }
+        TEST_ASSERT_EQUAL(min_steps[i], steps);
+        TEST_ASSERT_EQUAL(THUMB_SIZE, LV_MAX(gen.w, gen.h));
+
+        uint16_t * ref = ref_box_filter(px, w, h, gen.w, gen.h);
+        uint32_t diff = rgb565_diff(ref, gen.buf, gen.w * gen.h);
+        if(diff > 6) {
+            char msg[64];
+            lv_snprintf(msg, sizeof(msg), "%s: mean difference %d", names[i], (int)diff);
+            TEST_FAIL_MESSAGE(msg);
+        }
+
+        free(ref);
+        free(px);
+        lv_thumb_gen_end(&gen);
+    }
+}
+
+void test_thumb_mjpeg_first_frame(void)
+{
+    /*Header (16 bytes), the size of the first frame (4 bytes) and the frame itself*/
+    uint32_t size;
+    uint8_t * data = load_file(GALLERY "/clip.mjpeg", &size);
+    FILE * f = fopen("src/test_files/thumb_frame.jpg", "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    uint32_t frame_size = data[16] | (data[17] << 8) | (data[18] << 16) | ((uint32_t)data[19] << 24);
+    fwrite(data + 20, 1, frame_size, f);
+    fclose(f);
+    free(data);
+
+    lv_thumb_gen_t gen_clip;
+    lv_thumb_gen_t gen_frame;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_generate(&gen_clip, "A:" GALLERY "/clip.mjpeg", THUMB_SIZE));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_generate(&gen_frame, "A:src/test_files/thumb_frame.jpg", THUMB_SIZE));
+    remove("src/test_files/thumb_frame.jpg");
+
+    TEST_ASSERT_EQUAL(40, gen_clip.w);
+    TEST_ASSERT_EQUAL(30, gen_clip.h);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(gen_frame.buf, gen_clip.buf, gen_clip.w * gen_clip.h);
+
+    lv_thumb_gen_end(&gen_clip);
+    lv_thumb_gen_end(&gen_frame);
+}
+
+void test_thumb_invalid_files(void)
+{
+    lv_thumb_gen_t gen;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_thumb_generate(&gen, "A:" GALLERY "/notes.txt", THUMB_SIZE));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_thumb_generate(&gen, "A:" GALLERY "/missing.jpg", THUMB_SIZE));
+    /*Not a JPG*/
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_thumb_generate(&gen, "A:src/test_files/readtest.txt", THUMB_SIZE));
+    TEST_ASSERT_NULL(gen.buf);
+}
+
+void test_thumb_pack(void)
+{
+    char names[16][64];
+    uint32_t cnt = gallery_list(names, 16);
+    lv_thumb_gen_t gens[16];
+
+    lv_thumb_pack_t pack;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_pack_open(&pack, PACK_PATH, THUMB_SIZE));
+    TEST_ASSERT_EQUAL(0, pack.entry_cnt);
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        char path[128];
+        lv_snprintf(path, sizeof(path), "A:" GALLERY "/%s", names[i]);
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_generate(&gens[i], path, THUMB_SIZE));
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_pack_add(&pack, names[i], file_size(names[i]), &gens[i]));
+    }
+    lv_thumb_pack_close(&pack);
+
+    /*A later visit: all thumbnails are in the pack*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_pack_open(&pack, PACK_PATH, THUMB_SIZE));
+    TEST_ASSERT_EQUAL(cnt, pack.entry_cnt);
+    uint32_t data_end = pack.data_end;
+    for(i = 0; i < cnt; i++) {
+        const lv_thumb_entry_t * e = lv_thumb_pack_find(&pack, names[i], file_size(names[i]));
+        TEST_ASSERT_NOT_NULL(e);
+        TEST_ASSERT_NULL(lv_thumb_pack_find(&pack, names[i], file_size(names[i]) + 1));
+
+        lv_img_dsc_t * dsc = lv_thumb_pack_load(&pack, e);
+        TEST_ASSERT_NOT_NULL(dsc);
+        TEST_ASSERT_EQUAL(gens[i].w, dsc->header.w);
+        TEST_ASSERT_EQUAL(gens[i].h, dsc->header.h);
+
+        /*Draw it and check the pixels*/
+        lv_obj_t * img = lv_img_create(lv_scr_act());
+        lv_img_set_src(img, dsc);
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+
+        uint32_t x, y;
+        for(y = 0; y < gens[i].h; y++) {
+            for(x = 0; x < gens[i].w; x++) {
+                uint16_t c = gens[i].buf[y * gens[i].w + x];
+                uint8_t r = (c >> 11) & 0x1F;
+                uint8_t g = (c >> 5) & 0x3F;
+                uint8_t b = c & 0x1F;
+                lv_color_t exp = lv_color_make((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+                TEST_ASSERT_EQUAL_HEX32(exp.full, test_fb[y * LV_HOR_RES + x].full);
+            }
+        }
+
+        lv_obj_del(img);
+        lv_thumb_free(dsc);
+    }
+    TEST_ASSERT_NULL(lv_thumb_pack_find(&pack, "notes.txt", file_size("notes.txt")));
+
+    /*A changed file with the same thumbnail size is overwritten in place*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_pack_add(&pack, names[0], 123, &gens[1]));
+    const lv_thumb_entry_t * e = lv_thumb_pack_find(&pack, names[0], 123);
+    TEST_ASSERT_NOT_NULL(e);
+    if(gens[0].w == gens[1].w && gens[0].h == gens[1].h) TEST_ASSERT_EQUAL(data_end, pack.data_end);
+    else TEST_ASSERT_EQUAL(data_end + gens[1].w * gens[1].h * 2, pack.data_end);
+    lv_thumb_pack_close(&pack);
+
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_pack_open(&pack, PACK_PATH, THUMB_SIZE));
+    TEST_ASSERT_EQUAL(cnt, pack.entry_cnt);
+    TEST_ASSERT_NULL(lv_thumb_pack_find(&pack, names[0], file_size(names[0])));
+    e = lv_thumb_pack_find(&pack, names[0], 123);
+    TEST_ASSERT_NOT_NULL(e);
+    lv_img_dsc_t * dsc = lv_thumb_pack_load(&pack, e);
+    TEST_ASSERT_NOT_NULL(dsc);
+    TEST_ASSERT_EQUAL(gens[1].w, dsc->header.w);
+    lv_thumb_free(dsc);
+    lv_thumb_pack_close(&pack);
+
+    /*The thumbnails of an other size are dropped*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_pack_open(&pack, PACK_PATH, THUMB_SIZE * 2));
+    TEST_ASSERT_EQUAL(0, pack.entry_cnt);
+    lv_thumb_pack_close(&pack);
+
+    /*A corrupted index is detected*/
+    FILE * f = fopen(GALLERY "/.thumbs", "rb+");
+    TEST_ASSERT_NOT_NULL(f);
+    fseek(f, -3, SEEK_END);
+    fputc(0x55, f);
+    fclose(f);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_pack_open(&pack, PACK_PATH, THUMB_SIZE));
+    TEST_ASSERT_EQUAL(0, pack.entry_cnt);
+    lv_thumb_pack_close(&pack);
+
+    for(i = 0; i < cnt; i++) lv_thumb_gen_end(&gens[i]);
+}
+
+void test_thumb_benchmark_gallery(void)
+{
+    char names[16][64];
+    uint32_t cnt = gallery_list(names, 16);
+    const uint32_t repeat = 10;
+
+    /*First visit: generate the thumbnails and build the pack. Measure the longest step too.*/
+    uint64_t t_gen = 0;
+    uint64_t t_step_max = 0;
+    uint32_t r, i;
+    for(r = 0; r < repeat; r++) {
+        remove(GALLERY "/.thumbs");
+        uint64_t t_start = lv_test_get_time_us();
+        lv_thumb_pack_t pack;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_pack_open(&pack, PACK_PATH, THUMB_SIZE));
+        for(i = 0; i < cnt; i++) {
+            char path[128];
+            lv_snprintf(path, sizeof(path), "A:" GALLERY "/%s", names[i]);
+            lv_thumb_gen_t gen;
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_gen_start(&gen, path, THUMB_SIZE));
+            while(!gen.done) {
+                uint64_t t_step = lv_test_get_time_us();
+                TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_gen_step(&gen));
+                t_step = lv_test_get_time_us() - t_step;
+                if(t_step > t_step_max && r > 0) t_step_max = t_step;
+            }
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_pack_add(&pack, names[i], file_size(names[i]), &gen));
+            lv_thumb_gen_end(&gen);
+        }
+        lv_thumb_pack_close(&pack);
+        t_gen += lv_test_get_time_us() - t_start;
+    }
+
+    /*Later visits: open the pack and load all thumbnails*/
+    uint64_t t_start = lv_test_get_time_us();
+    for(r = 0; r < repeat; r++) {
+        lv_thumb_pack_t pack;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_thumb_pack_open(&pack, PACK_PATH, THUMB_SIZE));
+        for(i = 0; i < cnt; i++) {
+            const lv_thumb_entry_t * e = lv_thumb_pack_find(&pack, names[i], file_size(names[i]));
+            TEST_ASSERT_NOT_NULL(e);
+            lv_img_dsc_t * dsc = lv_thumb_pack_load(&pack, e);
+            TEST_ASSERT_NOT_NULL(dsc);
+            lv_thumb_free(dsc);
+        }
+        lv_thumb_pack_close(&pack);
+    }
+    uint64_t t_load = lv_test_get_time_us() - t_start;
+
+    printf("Thumbnails of %u images (%dx%d):\n", (unsigned)cnt, THUMB_SIZE, THUMB_SIZE);
+    printf("  first visit (generate + pack): %7.3f ms, longest step: %6.3f ms\n",
+           (double)t_gen / repeat / 1000, (double)t_step_max / 1000);
+    printf("  later visit (open pack + load): %7.3f ms\n", (double)t_load / repeat / 1000);
+
+    TEST_ASSERT_LESS_THAN(t_gen, t_load);
+}
+
+#else /*LV_USE_THUMB && LV_USE_SJPG && LV_USE_PNG*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_thumb_supported_files(void)
+{
+
+}
+
+void test_thumb_bmp_png_exact(void)
+{
+
+}
+
+void test_thumb_jpg_scaled(void)
+{
+
+}
+
+void test_thumb_mjpeg_first_frame(void)
+{
+
+}
+
+void test_thumb_invalid_files(void)
+{
+
+}
+
+void test_thumb_pack(void)
+{
+
+}
+
+void test_thumb_benchmark_gallery(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,283 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+#define ORDER_MAX 16
+
+static uint32_t order[ORDER_MAX];
+static uint32_t order_cnt;
+static uint32_t call_cnt;
+
+static void order_cb(lv_timer_t * timer)
+{
+    if(order_cnt < ORDER_MAX) order[order_cnt] = (uint32_t)(uintptr_t)timer->user_data;
+    order_cnt++;
+}
+
+static void count_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    call_cnt++;
+}
+
+static void del_self_cb(lv_timer_t * timer)
+{
+    call_cnt++;
+    lv_timer_del(timer);
+}
+
+static void del_other_cb(lv_timer_t * timer)
+{
+    call_cnt++;
+    lv_timer_del(timer->user_data);
+}
+
+static void ready_self_cb(lv_timer_t * timer)
+{
+    order_cb(timer);
+    if(order_cnt == 1) lv_timer_ready(timer);
+}
+
+static void create_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    lv_timer_t * t = lv_timer_create(count_cb, 0, NULL);
+    lv_timer_set_repeat_count(t, 1);
+}
+
+/*Delete the test's timers but keep the ones of LVGL (refresh, indev, anim)*/
+static lv_timer_t * keep[8];
+static uint32_t keep_cnt;
+
+static uint32_t get_timer_cnt(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        cnt++;
+        t = lv_timer_get_next(t);
+    }
+    return cnt;
+}
+
+void setUp(void)
+{
+    order_cnt = 0;
+    call_cnt = 0;
+    keep_cnt = 0;
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t && keep_cnt < 8) {
+        keep[keep_cnt++] = t;
+        t = lv_timer_get_next(t);
+    }
+}
+
+void tearDown(void)
+{
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        lv_timer_t * t_next = lv_timer_get_next(t);
+        bool lvgl_timer = false;
+        uint32_t i;
+        for(i = 0; i < keep_cnt; i++) {
+            if(keep[i] == t) lvgl_timer = true;
+        }
+        if(!lvgl_timer) lv_timer_del(t);
+        t = t_next;
+    }
+}
+
+void test_timer_runs_in_order_of_deadlines(void)
+{
+    lv_timer_create(order_cb, 30, (void *)(uintptr_t)3);
+    lv_timer_create(order_cb, 10, (void *)(uintptr_t)1);
+    lv_timer_create(order_cb, 20, (void *)(uintptr_t)2);
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_tick_inc(10);
+        lv_timer_handler();
+    }
+
+    /*With the same deadline the timer scheduled earlier runs first*/
+    TEST_ASSERT_EQUAL(5, order_cnt);
+    TEST_ASSERT_EQUAL(1, order[0]);
+    TEST_ASSERT_EQUAL(2, order[1]);
+    TEST_ASSERT_EQUAL(1, order[2]);
+    TEST_ASSERT_EQUAL(3, order[3]);
+    TEST_ASSERT_EQUAL(1, order[4]);
+}
+
+void test_timer_repeat_count_and_zero_period(void)
+{
+    uint32_t timer_cnt = get_timer_cnt();
+    lv_timer_t * t = lv_timer_create(count_cb, 0, NULL);
+    lv_timer_set_repeat_count(t, 3);
+
+    /*A timer with 0 period runs only once per handler call*/
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(1, call_cnt);
+    lv_timer_handler();
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(3, call_cnt);
+
+    /*Deleted by the handler after the last run*/
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(3, call_cnt);
+    TEST_ASSERT_EQUAL(timer_cnt, get_timer_cnt());
+}
+
+void test_timer_pause_resume_and_ready(void)
+{
+    lv_timer_t * t = lv_timer_create(count_cb, 100, NULL);
+    lv_timer_pause(t);
+    lv_tick_inc(200);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(0, call_cnt);
+
+    lv_timer_resume(t);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(1, call_cnt);
+
+    lv_timer_ready(t);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, call_cnt);
+
+    lv_timer_set_period(t, 10);
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(3, call_cnt);
+
+    lv_tick_inc(5);
+    lv_timer_reset(t);
+    lv_tick_inc(5);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(3, call_cnt);
+}
+
+void test_timer_ready_in_callback(void)
+{
+    lv_timer_create(ready_self_cb, 10, (void *)(uintptr_t)1);
+    lv_timer_create(order_cb, 20, (void *)(uintptr_t)2);
+    lv_tick_inc(20);
+    lv_timer_handler();
+
+    /*The other due timer still runs in the same call, the ready one in the next call*/
+    TEST_ASSERT_EQUAL(2, order_cnt);
+    TEST_ASSERT_EQUAL(1, order[0]);
+    TEST_ASSERT_EQUAL(2, order[1]);
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_until_next());
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(3, order_cnt);
+    TEST_ASSERT_EQUAL(1, order[2]);
+}
+
+void test_timer_time_until_next(void)
+{
+    lv_timer_t * t1 = lv_timer_create(count_cb, 1000, NULL);
+    lv_timer_t * t2 = lv_timer_create(count_cb, 700, NULL);
+
+    /*Pause LVGL's own timers to see only the test's ones*/
+    uint32_t i;
+    for(i = 0; i < keep_cnt; i++) lv_timer_pause(keep[i]);
+
+    TEST_ASSERT_EQUAL(700, lv_timer_get_time_until_next());
+    lv_tick_inc(200);
+    TEST_ASSERT_EQUAL(500, lv_timer_get_time_until_next());
+    TEST_ASSERT_EQUAL(500, lv_timer_handler());
+
+    lv_timer_pause(t2);
+    TEST_ASSERT_EQUAL(800, lv_timer_get_time_until_next());
+    lv_timer_del(t1);
+    TEST_ASSERT_EQUAL(LV_NO_TIMER_READY, lv_timer_get_time_until_next());
+
+    lv_timer_resume(t2);
+    lv_tick_inc(500);
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_until_next());
+    TEST_ASSERT_EQUAL(700, lv_timer_handler());
+
+    for(i = 0; i < keep_cnt; i++) lv_timer_resume(keep[i]);
+}
+
+void test_timer_del_in_callbacks(void)
+{
+    lv_timer_t * victim = lv_timer_create(count_cb, 10, NULL);
+    lv_timer_t * t = lv_timer_create(del_other_cb, 5, victim);
+    lv_timer_set_repeat_count(t, 1);
+    lv_timer_create(del_self_cb, 5, NULL);
+    uint32_t timer_cnt = get_timer_cnt();
+
+    lv_tick_inc(10);
+    lv_timer_handler();
+    /*`victim` was deleted before it could run*/
+    TEST_ASSERT_EQUAL(2, call_cnt);
+    TEST_ASSERT_EQUAL(timer_cnt - 3, get_timer_cnt());
+
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, call_cnt);
+}
+
+void test_timer_create_in_callback(void)
+{
+    lv_timer_create(create_cb, 10, NULL);
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(0, call_cnt);
+
+    /*The new timer has 0 period and runs in the next call*/
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_until_next());
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(1, call_cnt);
+}
+
+void test_timer_benchmark(void)
+{
+    const uint32_t timer_cnt = 500;
+    const uint32_t calls = 2000;
+    uint32_t i;
+    for(i = 0; i < timer_cnt; i++) {
+        lv_timer_create(count_cb, 20 + (i % 50) * 10, NULL);
+    }
+
+    /*Run the handler as often as the UI task: only a few timers are due in each call*/
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < calls; i++) {
+        lv_tick_inc(5);
+        lv_timer_handler();
+    }
+    uint64_t t_handler = lv_test_get_time_us() - t_start;
+
+    /*The cost of the previous implementation to find the next deadline: walk all the timers*/
+    volatile uint32_t sink = 0;
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < calls; i++) {
+        uint32_t min = LV_NO_TIMER_READY;
+        lv_timer_t * t = lv_timer_get_next(NULL);
+        while(t) {
+            uint32_t elp = lv_tick_elaps(t->last_run);
+            uint32_t rem = elp >= t->period ? 0 : t->period - elp;
+            if(rem < min) min = rem;
+            t = lv_timer_get_next(t);
+        }
+        sink += min;
+    }
+    uint64_t t_scan = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < calls; i++) {
+        sink += lv_timer_get_time_until_next();
+    }
+    uint64_t t_next = lv_test_get_time_us() - t_start;
+    LV_UNUSED(sink);
+
+    printf("%u timers: %.2f us/handler call (%u timer calls), next deadline: %.3f us list scan, %.3f us heap\n",
+           (unsigned)timer_cnt, (double)t_handler / calls, (unsigned)call_cnt,
+           (double)t_scan / calls, (double)t_next / calls);
+}
+
+#endif
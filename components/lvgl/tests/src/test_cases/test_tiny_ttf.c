@@ -2,6 +2,9 @@
 #include "../lvgl.h"
 
 #include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
 
 void setUp(void)
 {
@@ -46,4 +49,175 @@ void test_tiny_ttf_rendering_test(void)
 #endif
 }
 
+#if LV_USE_TINY_TTF
+
+#define KOREAN_TTF "../src/font/korean.ttf"
+
+static const char * latin_txt =
+    "The quick brown fox jumps over the lazy dog. Typography, AVATAR and Wave show the kerning of the letters. "
+    "0123456789 (a+b) = [c*d] / {e-f}; \"Quotes\" and 'apostrophes' with accents: ÁÉÍÓÖŐÜŰ áéíóöőüű.";
+
+static const char * korean_txt =
+    "다람쥐 헌 쳇바퀴에 타고파. 키스의 고유조건은 입술끼리 만나야 하고 특별한 기술은 필요치 않다. "
+    "한국어는 한글로 적으며 음절 단위로 모아 쓴다. 동해 물과 백두산이 마르고 닳도록 하느님이 보우하사 우리나라 만세. "
+    "무궁화 삼천리 화려 강산 대한 사람 대한으로 길이 보전하세.";
+
+/*Read a whole file. Return NULL if it doesn't exist.*/
+static uint8_t * read_file(const char * path, size_t * size)
+{
+    FILE * f = fopen(path, "rb");
+    if(f == NULL) return NULL;
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t * data = malloc(*size);
+    TEST_ASSERT_EQUAL(*size, fread(data, 1, *size, f));
+    fclose(f);
+    return data;
+}
+
+static uint32_t glyph_checksum(const lv_font_t * font, uint32_t letter, uint32_t letter_next)
+{
+    lv_font_glyph_dsc_t g;
+    if(!lv_font_get_glyph_dsc(font, &g, letter, letter_next)) return 0;
+
+    uint32_t h = 2166136261u;
+    int32_t values[] = {g.adv_w, g.box_w, g.box_h, g.ofs_x, g.ofs_y};
+    for(uint32_t i = 0; i < 5; i++) h = (h ^ (uint32_t)values[i]) * 16777619u;
+
+    const uint8_t * bmp = lv_font_get_glyph_bitmap(font, letter);
+    if(g.box_w * g.box_h > 0) TEST_ASSERT_NOT_NULL(bmp);
+    for(uint32_t i = 0; i < (uint32_t)g.box_w * g.box_h; i++) h = (h ^ bmp[i]) * 16777619u;
+    return h;
+}
+
+static uint32_t test_letter(uint32_t i, bool korean)
+{
+    if(!korean || i % 4 == 0) return 0x21 + (i * 7) % 94;
+    return 0xAC00 + (i * 37) % 11172;   /*Hangul syllables*/
+}
+
+void test_tiny_ttf_glyph_cache(void)
+{
+    size_t korean_size;
+    uint8_t * korean = read_file(KOREAN_TTF, &korean_size);
+    TEST_ASSERT_NOT_NULL(korean);
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+
+    /*Fonts sharing the atlas. The largest glyphs don't fit into the atlas' pages.*/
+    lv_font_t * fonts[] = {
+        lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 12),
+        lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 30),
+        lv_tiny_ttf_create_data_ex(ubuntu_font, ubuntu_font_size, 90, 256),
+        lv_tiny_ttf_create_data(korean, korean_size, 24),
+        lv_tiny_ttf_create_data(korean, korean_size, 48),
+        lv_tiny_ttf_create_data(korean, korean_size, 160),
+    };
+    const uint32_t font_cnt = sizeof(fonts) / sizeof(fonts[0]);
+    const uint32_t letter_cnt = 200;
+    static uint32_t checksums[6][200];
+
+    /*Render the glyphs once. It's more than the atlas can hold so the pages are cleared on the way.*/
+    for(uint32_t f = 0; f < font_cnt; f++) {
+        TEST_ASSERT_NOT_NULL(fonts[f]);
+        for(uint32_t i = 0; i < letter_cnt; i++) {
+            checksums[f][i] = glyph_checksum(fonts[f], test_letter(i, f >= 3), test_letter(i + 1, f >= 3));
+        }
+    }
+
+    /*The glyphs from the atlas and the rendered again glyphs should be the same*/
+    for(uint32_t round = 0; round < 2; round++) {
+        for(uint32_t f = 0; f < font_cnt; f++) {
+            for(uint32_t k = 0; k < letter_cnt; k++) {
+                uint32_t i = round == 0 ? letter_cnt - 1 - k : (k * 13) % letter_cnt;
+                TEST_ASSERT_EQUAL_HEX32(checksums[f][i],
+                                        glyph_checksum(fonts[f], test_letter(i, f >= 3), test_letter(i + 1, f >= 3)));
+            }
+        }
+    }
+
+    /*The glyphs of a font shouldn't be found after changing its size*/
+    uint32_t checksum_a = glyph_checksum(fonts[1], 'A', 0);
+    lv_tiny_ttf_set_size(fonts[1], 31);
+    TEST_ASSERT_NOT_EQUAL(checksum_a, glyph_checksum(fonts[1], 'A', 0));
+    lv_tiny_ttf_set_size(fonts[1], 30);
+    TEST_ASSERT_EQUAL_HEX32(checksum_a, glyph_checksum(fonts[1], 'A', 0));
+
+    /*A new font at the place of a destroyed one shouldn't get its glyphs*/
+    lv_tiny_ttf_destroy(fonts[3]);
+    fonts[3] = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 24);
+    lv_font_t * ref = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 24);
+    for(uint32_t i = 0; i < letter_cnt; i++) {
+        uint32_t letter = test_letter(i, true);
+        TEST_ASSERT_EQUAL_HEX32(glyph_checksum(ref, letter, 0), glyph_checksum(fonts[3], letter, 0));
+    }
+    lv_tiny_ttf_destroy(ref);
+
+    for(uint32_t f = 0; f < font_cnt; f++) lv_tiny_ttf_destroy(fonts[f]);
+    free(korean);
+}
+
+static void bench_paragraph(const char * name, lv_font_t * font, const char * txt)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 700);
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text_static(label, txt);
+
+    /*The first draw renders the glyphs, the others should take them from the atlas*/
+    uint64_t t = lv_test_get_time_us();
+    lv_refr_now(NULL);
+    uint64_t t_first = lv_test_get_time_us() - t;
+
+    uint32_t rep = 10;
+    t = lv_test_get_time_us();
+    for(uint32_t i = 0; i < rep; i++) {
+        lv_obj_invalidate(label);
+        lv_refr_now(NULL);
+    }
+    uint64_t t_redraw = (lv_test_get_time_us() - t) / rep;
+
+    /*Scrolling a list mostly measures the texts*/
+    t = lv_test_get_time_us();
+    for(uint32_t i = 0; i < rep; i++) {
+        lv_point_t size;
+        lv_txt_get_size(&size, txt, font, 0, 0, 700, LV_TEXT_FLAG_NONE);
+    }
+    uint64_t t_measure = (lv_test_get_time_us() - t) / rep;
+
+    printf("  %-14s first draw %7d us, redraw %7d us, measure %6d us\n", name, (int)t_first, (int)t_redraw,
+           (int)t_measure);
+
+    lv_obj_del(label);
+}
+
+void test_tiny_ttf_benchmark(void)
+{
+    size_t korean_size;
+    uint8_t * korean = read_file(KOREAN_TTF, &korean_size);
+    TEST_ASSERT_NOT_NULL(korean);
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+
+    printf("Tiny TTF paragraphs:\n");
+    lv_coord_t sizes[] = {16, 24, 32, 48};
+    for(uint32_t i = 0; i < 4; i++) {
+        char name[32];
+        lv_font_t * font = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, sizes[i]);
+        lv_snprintf(name, sizeof(name), "Ubuntu %d", sizes[i]);
+        bench_paragraph(name, font, latin_txt);
+        lv_tiny_ttf_destroy(font);
+
+        font = lv_tiny_ttf_create_data(korean, korean_size, sizes[i]);
+        lv_snprintf(name, sizeof(name), "Korean %d", sizes[i]);
+        bench_paragraph(name, font, korean_txt);
+        lv_tiny_ttf_destroy(font);
+    }
+
+    free(korean);
+}
+
+#endif /*LV_USE_TINY_TTF*/
+
 #endif
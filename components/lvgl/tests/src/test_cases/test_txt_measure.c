@@ -0,0 +1,294 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <stdio.h>
+
+#if LV_FONT_MONTSERRAT_18 && LV_FONT_SIMSUN_16_CJK
+
+#define TXT_SIZE (64 * 1024)
+
+static const char * english_words[] = {
+    "The", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog.", "Typography", "AVATAR", "Wave", "kerning",
+    "of", "letters", "like", "To", "Ya", "and", "LT", "is", "visible", "when", "text", "wraps", "into", "lines,", "(e.g.",
+    "\"quotes\")", "12.34", "ffi", "Very", "long", "words", "are", "broken", "too:", "Pneumonoultramicroscopicsilicovolcanoconiosis"
+};
+
+static const char * cjk_words[] = {
+    "的", "一是", "不了", "人", "我在", "有他", "这中", "大来上", "国", "个到", "说们", "为子", "和你", "地出", "道也", "时年",
+    "，", "。", "LVGL"
+};
+
+static char * txt;
+
+/*Build a text from random words separated by spaces and sometimes new lines*/
+static void build_text(const char ** words, uint32_t word_cnt, bool spaces)
+{
+    uint32_t seed = 1;
+    uint32_t len = 0;
+    while(1) {
+        seed = seed * 1103515245 + 12345;
+        const char * w = words[(seed >> 8) % word_cnt];
+        uint32_t w_len = strlen(w);
+        if(len + w_len + 2 >= TXT_SIZE) break;
+        memcpy(&txt[len], w, w_len);
+        len += w_len;
+        if(((seed >> 20) % 16) == 0) txt[len++] = '\n';
+        else if(spaces) txt[len++] = ' ';
+    }
+    txt[len] = '\0';
+}
+
+/*Measure a text letter by letter*/
+static lv_coord_t ref_get_width(const char * t, uint32_t len, const lv_font_t * font, lv_coord_t letter_space,
+                                lv_text_flag_t flag)
+{
+    lv_coord_t w = 0;
+    lv_text_cmd_state_t cmd_state = LV_TEXT_CMD_STATE_WAIT;
+    uint32_t i = 0;
+    while(i < len) {
+        uint32_t letter = _lv_txt_encoded_next(t, &i);
+        uint32_t letter_next = _lv_txt_encoded_next(&t[i], NULL);
+        if((flag & LV_TEXT_FLAG_RECOLOR) && _lv_txt_is_cmd(&cmd_state, letter)) continue;
+        lv_coord_t letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+        if(letter_w > 0) w += letter_w + letter_space;
+    }
+    return w > 0 ? w - letter_space : 0;
+}
+
+static void bench(const char * name, const lv_font_t * font)
+{
+    uint32_t len = strlen(txt);
+    uint32_t rep = 20;
+    uint32_t i;
+    lv_point_t size;
+
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < rep; i++) {
+        lv_txt_get_size(&size, txt, font, 0, 0, 300, LV_TEXT_FLAG_NONE);
+    }
+    uint64_t t_size = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    lv_coord_t w = 0;
+    for(i = 0; i < rep; i++) {
+        w += lv_txt_get_width(txt, len, font, 0, LV_TEXT_FLAG_NONE);
+    }
+    uint64_t t_width = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    lv_coord_t w_ref = 0;
+    for(i = 0; i < rep; i++) {
+        w_ref += ref_get_width(txt, len, font, 0, LV_TEXT_FLAG_NONE);
+    }
+    uint64_t t_ref = lv_test_get_time_us() - t_start;
+    TEST_ASSERT_EQUAL(w_ref, w);
+
+    t_start = lv_test_get_time_us();
+    uint32_t letter_cnt = 0;
+    for(i = 0; i < rep; i++) {
+        letter_cnt += _lv_txt_get_encoded_length(txt);
+    }
+    uint64_t t_length = lv_test_get_time_us() - t_start;
+    TEST_ASSERT_GREATER_THAN(0, letter_cnt);
+
+    double mb = (double)len * rep / (1024 * 1024);
+    printf("%s text (%d kB, %d lines at 300 px):\n", name, (int)(len / 1024),
+           (int)(size.y / lv_font_get_line_height(font)));
+    printf("  lv_txt_get_size:            %8.2f MB/s\n", mb / ((double)t_size / 1000000));
+    printf("  lv_txt_get_width:           %8.2f MB/s\n", mb / ((double)t_width / 1000000));
+    printf("  letter by letter:           %8.2f MB/s\n", mb / ((double)t_ref / 1000000));
+    printf("  _lv_txt_get_encoded_length: %8.2f MB/s\n", mb / ((double)t_length / 1000000));
+}
+
+/*Random text with multi-byte, invalid and recolored letters, tabs and line breaks*/
+static void build_mixed_text(uint32_t seed, uint32_t len_max)
+{
+    static const char * parts[] = {
+        "Wave", "AVATAR", "lazy", "Ta", "Ünïcödé", "的一是", "LVGL", " ", " ", " ", "\t", "\n", "\r\n", "-", "#ff0000 red#",
+        "##", "\xC3(", "\xE4\xB8", "\xF0\x9F\x98\x80", "\xFF", "Pneumonoultramicroscopicsilicovolcanoconiosis"
+    };
+    uint32_t part_cnt = sizeof(parts) / sizeof(parts[0]);
+    uint32_t len = 0;
+    while(1) {
+        seed = seed * 1103515245 + 12345;
+        const char * p = parts[(seed >> 8) % part_cnt];
+        uint32_t p_len = strlen(p);
+        if(len + p_len + 1 >= len_max) break;
+        memcpy(&txt[len], p, p_len);
+        len += p_len;
+    }
+    txt[len] = '\0';
+}
+
+void setUp(void)
+{
+    txt = lv_mem_alloc(TXT_SIZE);
+}
+
+void tearDown(void)
+{
+    lv_mem_free(txt);
+}
+
+void test_txt_measure_width(void)
+{
+    /*A font with kerning and a fallback font for the CJK letters*/
+    lv_font_t font_fallback = lv_font_montserrat_14;
+    font_fallback.fallback = &lv_font_simsun_16_cjk;
+    const lv_font_t * fonts[] = {&lv_font_montserrat_14, &lv_font_montserrat_18, &font_fallback, &lv_font_simsun_16_cjk};
+    lv_text_flag_t flags[] = {LV_TEXT_FLAG_NONE, LV_TEXT_FLAG_RECOLOR};
+
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        build_mixed_text(i + 1, 1 + i * 7);
+        uint32_t len = strlen(txt);
+        const lv_font_t * font = fonts[i % 4];
+        lv_text_flag_t flag = flags[(i / 4) % 2];
+        lv_coord_t letter_space = i % 3;
+
+        /*The whole text and parts of it*/
+        TEST_ASSERT_EQUAL(ref_get_width(txt, len, font, letter_space, flag),
+                          lv_txt_get_width(txt, len, font, letter_space, flag));
+        uint32_t part_len = (i * 13) % (len + 1);
+        TEST_ASSERT_EQUAL(ref_get_width(txt, part_len, font, letter_space, flag),
+                          lv_txt_get_width(txt, part_len, font, letter_space, flag));
+        uint32_t start = (i * 31) % (len + 1);
+        TEST_ASSERT_EQUAL(ref_get_width(&txt[start], len - start, font, letter_space, flag),
+                          lv_txt_get_width(&txt[start], len - start, font, letter_space, flag));
+    }
+}
+
+void test_txt_measure_next_line(void)
+{
+    const lv_font_t * fonts[] = {&lv_font_montserrat_14, &lv_font_montserrat_18, &lv_font_simsun_16_cjk};
+    lv_text_flag_t flags[] = {LV_TEXT_FLAG_NONE, LV_TEXT_FLAG_RECOLOR, LV_TEXT_FLAG_EXPAND};
+
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        build_mixed_text(i + 1, 1 + i * 20);
+        uint32_t len = strlen(txt);
+        const lv_font_t * font = fonts[i % 3];
+        lv_text_flag_t flag = flags[(i / 3) % 3];
+        lv_coord_t letter_space = i % 3;
+        lv_coord_t max_w = 5 + (i * 37) % 300;
+
+        /*Knowing the length of the text should result in the same lines*/
+        uint32_t line_start = 0;
+        uint32_t line_cnt = 0;
+        while(txt[line_start] != '\0') {
+            lv_coord_t w;
+            lv_coord_t w_len;
+            uint32_t line_len = _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, &w, flag);
+            TEST_ASSERT_EQUAL(line_len, _lv_txt_get_next_line_len(&txt[line_start], len - line_start, font, letter_space,
+                                                                  max_w, &w_len, flag));
+            TEST_ASSERT_EQUAL(w, w_len);
+            TEST_ASSERT_GREATER_THAN(0, line_len);
+            line_start += line_len;
+            line_cnt++;
+        }
+
+        /*A closing line break adds an empty line*/
+        if(len > 0 && (txt[len - 1] == '\n' || txt[len - 1] == '\r')) line_cnt++;
+        lv_point_t size;
+        lv_txt_get_size(&size, txt, font, letter_space, 0, max_w, flag);
+        TEST_ASSERT_EQUAL(LV_MAX(line_cnt, 1) * lv_font_get_line_height(font), size.y);
+    }
+}
+
+void test_txt_measure_letter_index(void)
+{
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        build_mixed_text(i + 1, 1 + i * 5);
+
+        /*Decode letter by letter to get the reference*/
+        uint32_t byte_ids[512];
+        uint32_t letter_cnt = 0;
+        uint32_t byte_id = 0;
+        while(txt[byte_id] != '\0') {
+            byte_ids[letter_cnt++] = byte_id;
+            _lv_txt_encoded_next(txt, &byte_id);
+        }
+        byte_ids[letter_cnt] = byte_id;
+
+        TEST_ASSERT_EQUAL(letter_cnt, _lv_txt_get_encoded_length(txt));
+
+        uint32_t k;
+        for(k = 0; k <= letter_cnt; k++) {
+            TEST_ASSERT_EQUAL(k, _lv_txt_encoded_get_char_id(txt, byte_ids[k]));
+        }
+
+        /*The byte index is calculated from the size of the letters (not from decoding them)*/
+        byte_id = 0;
+        for(k = 0; k <= letter_cnt; k++) {
+            TEST_ASSERT_EQUAL(byte_id, _lv_txt_encoded_get_byte_id(txt, k));
+            if(txt[byte_id] != '\0') byte_id += LV_MAX(_lv_txt_encoded_size(&txt[byte_id]), 1);
+        }
+
+        /*Decoding in batches should give the same letters*/
+        uint32_t letters[17];
+        uint32_t ofs[17];
+        uint32_t cnt = _lv_txt_encoded_next_n(txt, strlen(txt), letters, ofs, 16);
+        TEST_ASSERT_EQUAL(LV_MIN(letter_cnt, 16), cnt);
+        for(k = 0; k <= cnt; k++) {
+            uint32_t ref_ofs = byte_ids[k];
+            TEST_ASSERT_EQUAL(ref_ofs, ofs[k]);
+            TEST_ASSERT_EQUAL(_lv_txt_encoded_next(txt, &ref_ofs), letters[k]);
+        }
+    }
+}
+
+void test_txt_measure_benchmark_english(void)
+{
+    build_text(english_words, sizeof(english_words) / sizeof(english_words[0]), true);
+    bench("English", &lv_font_montserrat_14);
+}
+
+void test_txt_measure_benchmark_cjk(void)
+{
+    build_text(cjk_words, sizeof(cjk_words) / sizeof(cjk_words[0]), false);
+    bench("CJK", &lv_font_simsun_16_cjk);
+}
+
+#else /*LV_FONT_MONTSERRAT_18 && LV_FONT_SIMSUN_16_CJK*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_txt_measure_width(void)
+{
+
+}
+
+void test_txt_measure_next_line(void)
+{
+
+}
+
+void test_txt_measure_letter_index(void)
+{
+
+}
+
+void test_txt_measure_benchmark_english(void)
+{
+
+}
+
+void test_txt_measure_benchmark_cjk(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -146,6 +146,12 @@ size_t free_after = esp_get_free_heap_size();
     ESP_LOGI("MEMORY", "Free heap AFTER: %zu bytes", free_after);
     ESP_LOGI("MEMORY", "Memory change: %+d bytes", (int)(free_after - free_before));
     ESP_LOGI("MEMORY", "Minimum free ever: %zu bytes", min_free);
+
+    lv_mem_monitor_t lv_mon;
+    lv_mem_monitor(&lv_mon);
+    ESP_LOGI("MEMORY", "LVGL heap: %d%% used, %d%% frag, biggest free: %u bytes, slabs: %u/%u bytes free",
+             lv_mon.used_pct, lv_mon.frag_pct, (unsigned)lv_mon.free_biggest_size,
+             (unsigned)lv_mon.slab_free_size, (unsigned)lv_mon.slab_size);
     ESP_LOGI("MEMORY", "=== SWITCH COMPLETE ===");
 }
 
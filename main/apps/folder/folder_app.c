@@ -21,11 +21,28 @@ static lv_obj_t *file_list = NULL;
 static lv_obj_t *status_label = NULL;
 static lv_obj_t *sd_status_label = NULL;
 
+// Thumbnails of the images and videos in the list
+#define THUMB_SIZE          40      // Thumbnails fit into a 40x40 square
+#define THUMB_ROW_PITCH     55      // Distance of the list rows
+#define THUMB_STEP_BUDGET   8       // ms of thumbnail generation in a timer run
+#define THUMB_KEEP_ROWS     16      // Thumbnails this far from the visible rows are freed
+
+typedef enum {
+    THUMB_NONE,       // Not an image or video, or not visible yet
+    THUMB_QUEUED,     // Visible, waiting for generation
+    THUMB_LOADED,
+    THUMB_FAILED,
+} thumb_state_t;
+
 // Dynamic file structure
 typedef struct {
     char name[64];
     bool is_folder;
     size_t size;  // Add file size
+    bool has_thumb;         // Image or video which can have a thumbnail
+    thumb_state_t thumb_state;
+    lv_obj_t *thumb_img;
+    lv_img_dsc_t *thumb;
 } file_item_t;
 
 // Current directory path
@@ -35,6 +52,14 @@ static char current_path[256] = "/sdcard";
 static file_item_t *files = NULL;
 static int file_count = 0;
 
+#if LV_USE_THUMB
+// Thumbnail pack of the current directory and the thumbnail being generated
+static lv_thumb_pack_t thumb_pack;
+static lv_thumb_gen_t thumb_gen;
+static int thumb_gen_index = -1;
+static lv_timer_t *thumb_timer = NULL;
+#endif
+
 // Forward declarations
 static void create_file_list(void);
 static void file_item_event_cb(lv_event_t *e);
@@ -44,6 +69,8 @@ static int load_directory_contents(const char *path);
 static void update_sd_status(void);
 static const char* format_file_size(size_t bytes);
 static bool is_text_file(const char* filename);
+static void thumbs_open(void);
+static void thumbs_close(void);
 
 // New: Get appropriate LVGL symbol based on file type
 static const char* get_file_symbol(const char* filename, bool is_folder) {
@@ -136,6 +163,9 @@ static int load_directory_contents(const char *path) {
     
     ESP_LOGI("FOLDER_APP", "Attempting to load directory: %s", path);
     
+    // The thumbnails refer to the old file list
+    thumbs_close();
+    
     // Check if SD card is mounted
     if (!sd_is_mounted()) {
         ESP_LOGW("FOLDER_APP", "SD card is not mounted yet");
@@ -222,6 +252,15 @@ static int load_directory_contents(const char *path) {
             ESP_LOGW("FOLDER_APP", "stat() failed for %s, defaulting to file", full_path);
         }
         
+#if LV_USE_THUMB
+        files[index].has_thumb = !files[index].is_folder && lv_thumb_is_supported(files[index].name);
+#else
+        files[index].has_thumb = false;
+#endif
+        files[index].thumb_state = THUMB_NONE;
+        files[index].thumb_img = NULL;
+        files[index].thumb = NULL;
+        
         index++;
     }
     
@@ -385,6 +424,16 @@ static void create_file_list(void) {
         lv_obj_set_style_radius(item_btn, 5, 0);
         lv_obj_add_event_cb(item_btn, file_item_event_cb, LV_EVENT_CLICKED, (void*)(uintptr_t)i);
         
+        // Images and videos get a thumbnail on the left when they are scrolled into view
+        lv_coord_t text_x = 10;
+        if (files[i].has_thumb) {
+            files[i].thumb_img = lv_img_create(item_btn);
+            lv_obj_set_size(files[i].thumb_img, THUMB_SIZE, THUMB_SIZE);
+            lv_obj_align(files[i].thumb_img, LV_ALIGN_LEFT_MID, 0, 0);
+            lv_obj_clear_flag(files[i].thumb_img, LV_OBJ_FLAG_CLICKABLE);
+            text_x = THUMB_SIZE + 12;
+        }
+        
         // Create main label with file/folder name using appropriate symbol
         lv_obj_t *item_label = lv_label_create(item_btn);
         char label_text[80];
@@ -393,7 +442,7 @@ static void create_file_list(void) {
                 files[i].name);
         lv_label_set_text(item_label, label_text);
         lv_obj_set_style_text_color(item_label, lv_color_hex(UI_COLOR_TEXT_PRIMARY), 0);
-        lv_obj_align(item_label, LV_ALIGN_TOP_LEFT, 10, 5);
+        lv_obj_align(item_label, LV_ALIGN_TOP_LEFT, text_x, 5);
         
         // Create size label for files
         if (!files[i].is_folder && files[i].size > 0) {
@@ -401,7 +450,7 @@ static void create_file_list(void) {
             lv_label_set_text(size_label, format_file_size(files[i].size));
             lv_obj_set_style_text_color(size_label, lv_color_hex(UI_COLOR_TEXT_SECONDARY), 0);
             lv_obj_set_style_text_font(size_label, &lv_font_montserrat_10, 0);
-            lv_obj_align(size_label, LV_ALIGN_BOTTOM_LEFT, 10, -5);
+            lv_obj_align(size_label, LV_ALIGN_BOTTOM_LEFT, text_x, -5);
         }
         
         // Add type indicators for special files
@@ -429,7 +478,164 @@ static void create_file_list(void) {
         lv_obj_set_style_text_color(empty_label, lv_color_hex(UI_COLOR_TEXT_SECONDARY), 0);
         lv_obj_center(empty_label);
     }
+    
+    thumbs_open();
+}
+
+#if LV_USE_THUMB
+// Show a thumbnail loaded from the pack
+static void thumb_show(file_item_t *item, const lv_thumb_entry_t *entry) {
+    item->thumb = lv_thumb_pack_load(&thumb_pack, entry);
+    if (!item->thumb) {
+        item->thumb_state = THUMB_FAILED;
+        return;
+    }
+    lv_img_set_src(item->thumb_img, item->thumb);
+    item->thumb_state = THUMB_LOADED;
+}
+
+// Free the thumbnail of a row which is far from the visible rows
+static void thumb_unload(file_item_t *item) {
+    if (item->thumb) {
+        lv_img_set_src(item->thumb_img, NULL);
+        lv_thumb_free(item->thumb);
+        item->thumb = NULL;
+    }
+    if (item->thumb_state != THUMB_FAILED) item->thumb_state = THUMB_NONE;
+}
+
+// Load the thumbnails of the visible rows from the pack or queue them for generation
+static void thumbs_update_visible(void) {
+    if (!file_list || !files) return;
+
+    lv_coord_t scroll_y = lv_obj_get_scroll_y(file_list) - lv_obj_get_style_pad_top(file_list, 0);
+    lv_coord_t view_h = lv_obj_get_content_height(file_list);
+    int first = LV_MAX(scroll_y / THUMB_ROW_PITCH, 0);
+    int last = LV_MIN((scroll_y + view_h) / THUMB_ROW_PITCH, file_count - 1);
+
+    bool queued = false;
+    for (int i = 0; i < file_count; i++) {
+        file_item_t *item = &files[i];
+        if (!item->has_thumb) continue;
+
+        if (i < first - THUMB_KEEP_ROWS || i > last + THUMB_KEEP_ROWS) {
+            if (i != thumb_gen_index) thumb_unload(item);
+        } else if (i >= first && i <= last && item->thumb_state == THUMB_NONE) {
+            const lv_thumb_entry_t *entry = lv_thumb_pack_find(&thumb_pack, item->name, item->size);
+            if (entry) {
+                thumb_show(item, entry);
+            } else {
+                item->thumb_state = THUMB_QUEUED;
+                queued = true;
+            }
+        }
+    }
+
+    if (queued) lv_timer_resume(thumb_timer);
+}
+
+static void file_list_scroll_event_cb(lv_event_t *e) {
+    thumbs_update_visible();
+}
+
+// Generate the queued thumbnails in small steps on the UI task (LVGL is not thread-safe)
+static void thumb_timer_cb(lv_timer_t *timer) {
+    uint32_t start = lv_tick_get();
+    while (lv_tick_elaps(start) < THUMB_STEP_BUDGET) {
+        if (thumb_gen_index < 0) {
+            // Take the next queued row
+            for (int i = 0; i < file_count; i++) {
+                if (files[i].thumb_state == THUMB_QUEUED) {
+                    thumb_gen_index = i;
+                    break;
+                }
+            }
+            if (thumb_gen_index < 0) {
+                // Nothing to do: save the index of the new thumbnails and sleep
+                lv_thumb_pack_flush(&thumb_pack);
+                lv_timer_pause(timer);
+                return;
+            }
+
+            file_item_t *item = &files[thumb_gen_index];
+            char path[320];
+            snprintf(path, sizeof(path), "S:%s/%s", current_path, item->name);
+            if (lv_thumb_gen_start(&thumb_gen, path, THUMB_SIZE) != LV_RES_OK) {
+                item->thumb_state = THUMB_FAILED;
+                thumb_gen_index = -1;
+            }
+            continue;
+        }
+
+        file_item_t *item = &files[thumb_gen_index];
+        if (lv_thumb_gen_step(&thumb_gen) != LV_RES_OK) {
+            ESP_LOGW("FOLDER_APP", "Can't make a thumbnail of %s", item->name);
+            item->thumb_state = THUMB_FAILED;
+        } else if (thumb_gen.done) {
+            const lv_thumb_entry_t *entry = NULL;
+            if (lv_thumb_pack_add(&thumb_pack, item->name, item->size, &thumb_gen) == LV_RES_OK) {
+                entry = lv_thumb_pack_find(&thumb_pack, item->name, item->size);
+            }
+            if (entry && item->thumb_state == THUMB_QUEUED) {
+                thumb_show(item, entry);
+            } else if (!entry) {
+                item->thumb_state = THUMB_FAILED;
+            }
+        } else {
+            continue;
+        }
+
+        lv_thumb_gen_end(&thumb_gen);
+        thumb_gen_index = -1;
+    }
+}
+
+// Open the thumbnail pack of the current directory, e.g. "/sdcard/photos/.thumbs"
+static void thumbs_open(void) {
+    bool any = false;
+    for (int i = 0; i < file_count; i++) any |= files[i].has_thumb;
+    if (!any || !file_list) return;
+
+    char pack_path[300];
+    snprintf(pack_path, sizeof(pack_path), "S:%s/.thumbs", current_path);
+    if (lv_thumb_pack_open(&thumb_pack, pack_path, THUMB_SIZE) != LV_RES_OK) {
+        ESP_LOGW("FOLDER_APP", "Can't open the thumbnail pack %s", pack_path);
+        return;
+    }
+    ESP_LOGI("FOLDER_APP", "%u thumbnails in %s", (unsigned)thumb_pack.entry_cnt, pack_path);
+
+    thumb_timer = lv_timer_create(thumb_timer_cb, 10, NULL);
+    lv_timer_pause(thumb_timer);
+    lv_obj_add_event_cb(file_list, file_list_scroll_event_cb, LV_EVENT_SCROLL, NULL);
+
+    lv_obj_update_layout(file_list);
+    thumbs_update_visible();
+}
+
+// Stop the generation and free the thumbnails of the list
+static void thumbs_close(void) {
+    if (!thumb_timer) return;
+
+    lv_timer_del(thumb_timer);
+    thumb_timer = NULL;
+    if (thumb_gen_index >= 0) {
+        lv_thumb_gen_end(&thumb_gen);
+        thumb_gen_index = -1;
+    }
+
+    for (int i = 0; i < file_count; i++) {
+        if (files[i].thumb_img) thumb_unload(&files[i]);
+    }
+    if (file_list) lv_obj_remove_event_cb(file_list, file_list_scroll_event_cb);
+    lv_thumb_pack_close(&thumb_pack);
+}
+#else
+static void thumbs_open(void) {
+}
+
+static void thumbs_close(void) {
 }
+#endif
 
 void create_folder_app(void) {
     if (folder_screen) return; // already created
@@ -521,6 +727,7 @@ void destroy_folder_app(void) {
         ESP_LOGI("FOLDER_APP", "Folder app destroyed");
         
         // Free allocated memory
+        thumbs_close();
         if (files) {
             free(files);
             files = NULL;
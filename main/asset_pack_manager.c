@@ -0,0 +1,71 @@
+/**
+ * @file asset_pack_manager.c
+ * @brief Memory maps the "assets" partition and opens it as an LVGL asset pack
+ */
+
+#include "asset_pack_manager.h"
+#include "esp_partition.h"
+#include "esp_log.h"
+
+/* ==========================================================================
+ * PRIVATE VARIABLES
+ * ========================================================================== */
+
+static const char *TAG = "asset_pack_manager";
+static esp_partition_mmap_handle_t s_mmap_handle;
+static lv_asset_pack_t s_pack;
+static bool s_pack_ready = false;
+
+/* ==========================================================================
+ * PUBLIC FUNCTION IMPLEMENTATIONS
+ * ========================================================================== */
+
+esp_err_t asset_pack_init(void)
+{
+    if (s_pack_ready) {
+        ESP_LOGW(TAG, "Asset pack already opened");
+        return ESP_OK;
+    }
+
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                           ASSET_PARTITION_LABEL);
+    if (part == NULL) {
+        ESP_LOGW(TAG, "No \"%s\" partition", ASSET_PARTITION_LABEL);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // Map the whole partition into the data address space. The MMU serves it from the flash cache,
+    // so nothing is copied into the RAM.
+    const void *data;
+    esp_err_t ret = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &data, &s_mmap_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to map the asset partition: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    if (lv_asset_pack_open(&s_pack, data, part->size) != LV_RES_OK) {
+        ESP_LOGW(TAG, "No valid asset pack in the \"%s\" partition", ASSET_PARTITION_LABEL);
+        esp_partition_munmap(s_mmap_handle);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_pack_ready = true;
+    ESP_LOGI(TAG, "Asset pack opened: %u assets", (unsigned)s_pack.entry_cnt);
+    return ESP_OK;
+}
+
+const lv_img_dsc_t *asset_pack_get_img(const char *name)
+{
+    if (!s_pack_ready) return NULL;
+
+    const lv_img_dsc_t *img = lv_asset_pack_get_img(&s_pack, name);
+    if (img == NULL) {
+        ESP_LOGW(TAG, "Image not found: %s", name);
+    }
+    return img;
+}
+
+bool asset_pack_is_ready(void)
+{
+    return s_pack_ready;
+}
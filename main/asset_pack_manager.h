@@ -0,0 +1,62 @@
+/**
+ * @file asset_pack_manager.h
+ * @brief UI assets (images, fonts) in the "assets" flash partition
+ *
+ * The partition holds an asset pack made by components/lvgl/scripts/lv_asset_pack.py
+ * from the files of main/assets. It's generated and flashed by the build if main/assets exists,
+ * and only then is it opened at startup (APP_HAS_ASSET_PACK). Without it asset_pack_get_img() returns NULL.
+ * The partition is memory mapped, so uncompressed images are drawn right from the flash
+ * and fonts can be loaded from the "P:" LVGL drive, e.g. lv_font_load("P:fonts/big.fnt").
+ */
+
+#ifndef ASSET_PACK_MANAGER_H
+#define ASSET_PACK_MANAGER_H
+
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==========================================================================
+ * CONFIGURATION DEFINES
+ * ========================================================================== */
+
+/** Label of the asset partition in partitions.csv */
+#define ASSET_PARTITION_LABEL "assets"
+
+/* ==========================================================================
+ * PUBLIC FUNCTION DECLARATIONS
+ * ========================================================================== */
+
+/**
+ * @brief Map the asset partition and open its pack
+ *
+ * Call it once after lv_init().
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if there is no partition,
+ *         ESP_ERR_INVALID_STATE if the partition doesn't contain a valid pack
+ */
+esp_err_t asset_pack_init(void);
+
+/**
+ * @brief Get an image from the asset pack
+ *
+ * @param name Path of the image relative to main/assets (e.g., "icons/wifi.png")
+ * @return Image source for lv_img_set_src() or NULL if not found
+ */
+const lv_img_dsc_t *asset_pack_get_img(const char *name);
+
+/**
+ * @brief Check if the asset pack is opened
+ *
+ * @return true if the assets are available, false otherwise
+ */
+bool asset_pack_is_ready(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASSET_PACK_MANAGER_H */
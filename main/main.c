@@ -16,9 +16,13 @@
 #include "app_manager.h"
 #include "ui_styles.h"
 #include "sd_card_manager.h"
+#include "asset_pack_manager.h"
 
 static const char *TAG = "CYD_TABLET";
 
+// Upper limit for the UI task's sleep between two lv_task_handler() calls
+#define UI_TASK_MAX_SLEEP_MS 50
+
 static TaskHandle_t ui_task_handle = NULL;
 static TaskHandle_t app_manager_task_handle = NULL;
 
@@ -92,6 +96,12 @@ void ui_task(void *arg) {
     lv_port_disp_init();
     lv_port_indev_init();
 
+#ifdef APP_HAS_ASSET_PACK
+    if (asset_pack_init() != ESP_OK) {
+        ESP_LOGW(TAG, "UI assets are not available");
+    }
+#endif
+
     ui_init_styles();
 
     if (app_manager_task_handle != NULL) {
@@ -108,10 +118,15 @@ void ui_task(void *arg) {
     
     ui_command_t cmd;
     while(1) {
-        lv_task_handler();
-        vTaskDelay(pdMS_TO_TICKS(5));
-        
-        if (xQueueReceive(ui_cmd_queue, &cmd, 0)) {
+        uint32_t time_till_next = lv_task_handler();
+
+        // Sleep until the next LVGL timer is due, but wake up on UI commands.
+        // Other tasks can also touch LVGL, so never sleep longer than UI_TASK_MAX_SLEEP_MS.
+        if (time_till_next > UI_TASK_MAX_SLEEP_MS) time_till_next = UI_TASK_MAX_SLEEP_MS;
+        TickType_t ticks_to_wait = pdMS_TO_TICKS(time_till_next);
+        if (ticks_to_wait == 0) ticks_to_wait = 1; // Let the lower priority tasks run too
+
+        if (xQueueReceive(ui_cmd_queue, &cmd, ticks_to_wait)) {
             // Process commands here
         }
     }
@@ -16,6 +16,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "ff.h"
+#include "lvgl.h"
 
 /* ==========================================================================
  * PRIVATE VARIABLES
@@ -150,6 +151,11 @@ esp_err_t sd_card_deinit(void)
         return ESP_OK;
     }
 
+    // Forget the cached blocks of the files on the card
+#if LV_USE_FS_CACHED
+    lv_fs_cached_invalidate(NULL);
+#endif
+
     // Unmount filesystem
     esp_err_t ret = esp_vfs_fat_sdcard_unmount(SD_MOUNT_POINT, s_card);
     if (ret != ESP_OK) {
@@ -275,6 +281,10 @@ esp_err_t sd_format_card(void)
     
     ESP_LOGW(TAG, "Formatting SD card - ALL DATA WILL BE LOST!");
     
+#if LV_USE_FS_CACHED
+    lv_fs_cached_invalidate(NULL);
+#endif
+
     esp_err_t ret = esp_vfs_fat_sdcard_format(SD_MOUNT_POINT, s_card);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to format SD card: %s", esp_err_to_name(ret));
@@ -67,6 +67,15 @@ void ui_init_styles(void) {
     lv_style_set_text_color(&style_caption, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
     lv_style_set_text_font(&style_caption, &lv_font_montserrat_12);
 
+    // The styles are complete: sort their properties for faster lookups while drawing
+    lv_style_freeze(&style_card);
+    lv_style_freeze(&style_button);
+    lv_style_freeze(&style_button_pressed);
+    lv_style_freeze(&style_title);
+    lv_style_freeze(&style_subtitle);
+    lv_style_freeze(&style_body);
+    lv_style_freeze(&style_caption);
+
     ESP_LOGI(TAG, "UI styles initialized");
 }
 